@@ -172,6 +172,7 @@ BrowsingDataRemover::BrowsingDataRemover(Profile* profile,
       waiting_for_clear_plugin_data_(false),
       waiting_for_clear_pnacl_cache_(false),
       waiting_for_clear_quota_managed_data_(false),
+      waiting_for_clear_sdch_dictionaries_(false),
       waiting_for_clear_server_bound_certs_(false),
       waiting_for_clear_session_storage_(false),
       waiting_for_clear_shader_cache_(false),
@@ -540,6 +541,18 @@ void BrowsingDataRemover::RemoveImpl(int remove_mask,
                    base::Unretained(this), delete_begin_, delete_end_));
 #endif
 
+    // SDCH dictionaries are cached responses too.  They are shared by all
+    // profiles, and we don't track which sites they came from, so all of them
+    // are cleared.
+    if (g_browser_process->io_thread()) {
+      waiting_for_clear_sdch_dictionaries_ = true;
+      BrowserThread::PostTask(
+          BrowserThread::IO, FROM_HERE,
+          base::Bind(&BrowsingDataRemover::ClearSdchDictionariesOnIOThread,
+                     base::Unretained(this),
+                     g_browser_process->io_thread()));
+    }
+
     // The PrerenderManager may have a page actively being prerendered, which
     // is essentially a preemptively cached page.
     prerender::PrerenderManager* prerender_manager =
@@ -646,6 +659,7 @@ bool BrowsingDataRemover::AllDone() {
          !waiting_for_clear_plugin_data_ &&
          !waiting_for_clear_pnacl_cache_ &&
          !waiting_for_clear_quota_managed_data_ &&
+         !waiting_for_clear_sdch_dictionaries_ &&
          !waiting_for_clear_content_licenses_ && !waiting_for_clear_form_ &&
          !waiting_for_clear_hostname_resolution_cache_ &&
          !waiting_for_clear_network_predictor_ &&
@@ -710,6 +724,26 @@ void BrowsingDataRemover::ClearHostnameResolutionCacheOnIOThread(
                  base::Unretained(this)));
 }
 
+void BrowsingDataRemover::OnClearedSdchDictionaries() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  waiting_for_clear_sdch_dictionaries_ = false;
+  NotifyAndDeleteIfDone();
+}
+
+void BrowsingDataRemover::ClearSdchDictionariesOnIOThread(
+    IOThread* io_thread) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  io_thread->ClearSdchDictionaries();
+
+  // Notify the UI thread that we are done.
+  BrowserThread::PostTask(
+      BrowserThread::UI,
+      FROM_HERE,
+      base::Bind(&BrowsingDataRemover::OnClearedSdchDictionaries,
+                 base::Unretained(this)));
+}
+
 void BrowsingDataRemover::OnClearedLoggedInPredictor() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
   DCHECK(waiting_for_clear_logged_in_predictor_);
@@ -250,6 +250,13 @@ class BrowsingDataRemover : public content::NotificationObserver
   // Invoked on the IO thread to clear the hostname resolution cache.
   void ClearHostnameResolutionCacheOnIOThread(IOThread* io_thread);
 
+  // Callback when the SDCH dictionaries have been cleared.
+  // Clears the respective waiting flag and invokes NotifyAndDeleteIfDone.
+  void OnClearedSdchDictionaries();
+
+  // Invoked on the IO thread to clear the SDCH dictionaries.
+  void ClearSdchDictionariesOnIOThread(IOThread* io_thread);
+
   // Callback when the LoggedIn Predictor has been cleared.
   // Clears the respective waiting flag and invokes NotifyAndDeleteIfDone.
   void OnClearedLoggedInPredictor();
@@ -436,6 +443,7 @@ class BrowsingDataRemover : public content::NotificationObserver
   bool waiting_for_clear_plugin_data_;
   bool waiting_for_clear_pnacl_cache_;
   bool waiting_for_clear_quota_managed_data_;
+  bool waiting_for_clear_sdch_dictionaries_;
   bool waiting_for_clear_server_bound_certs_;
   bool waiting_for_clear_session_storage_;
   bool waiting_for_clear_shader_cache_;
@@ -14,6 +14,7 @@
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
+#include "base/path_service.h"
 #include "base/prefs/pref_registry_simple.h"
 #include "base/prefs/pref_service.h"
 #include "base/stl_util.h"
@@ -28,18 +29,22 @@
 #include "chrome/browser/extensions/event_router_forwarder.h"
 #include "chrome/browser/net/async_dns_field_trial.h"
 #include "chrome/browser/net/basic_http_user_agent_settings.h"
+#include "chrome/browser/net/cert_verifier_cache_persister.h"
 #include "chrome/browser/net/chrome_net_log.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "chrome/browser/net/chrome_url_request_context.h"
 #include "chrome/browser/net/connect_interceptor.h"
 #include "chrome/browser/net/dns_probe_service.h"
+#include "chrome/browser/net/host_cache_persister.h"
 #include "chrome/browser/net/http_pipelining_compatibility_client.h"
 #include "chrome/browser/net/load_time_stats.h"
 #include "chrome/browser/net/pref_proxy_config_tracker.h"
 #include "chrome/browser/net/proxy_service_factory.h"
 #include "chrome/browser/net/sdch_dictionary_fetcher.h"
+#include "chrome/browser/net/sdch_dictionary_persister.h"
 #include "chrome/browser/net/spdyproxy/http_auth_handler_spdyproxy.h"
 #include "chrome/browser/policy/policy_service.h"
+#include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/common/url_constants.h"
@@ -49,6 +54,8 @@
 #include "net/base/network_time_notifier.h"
 #include "net/base/sdch_manager.h"
 #include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verify_proc.h"
+#include "net/cert/multi_threaded_cert_verifier.h"
 #include "net/cookies/cookie_monster.h"
 #include "net/dns/host_cache.h"
 #include "net/dns/host_resolver.h"
@@ -159,6 +166,19 @@ scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
     }
   }
 
+  // Serve stale cache entries while refreshing them, if asked to.
+  if (command_line.HasSwitch(switches::kHostResolverMaxStaleness)) {
+    std::string s =
+        command_line.GetSwitchValueASCII(switches::kHostResolverMaxStaleness);
+    // Parse the switch (it should be a non-negative number of seconds).
+    int n;
+    if (base::StringToInt(s, &n) && n >= 0) {
+      options.max_staleness = base::TimeDelta::FromSeconds(n);
+    } else {
+      LOG(ERROR) << "Invalid switch for host resolver max staleness: " << s;
+    }
+  }
+
   scoped_ptr<net::HostResolver> global_host_resolver(
       net::HostResolver::CreateSystemResolver(options, net_log));
 
@@ -515,7 +535,27 @@ void IOThread::InitAsync() {
   globals_->system_network_delegate.reset(network_delegate);
   globals_->host_resolver = CreateGlobalHostResolver(net_log_);
   UpdateDnsClientEnabled();
-  globals_->cert_verifier.reset(net::CertVerifier::CreateDefault());
+  base::FilePath user_data_dir;
+  if (command_line.HasSwitch(switches::kEnableHostCachePersistence) &&
+      PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    host_cache_persister_.reset(
+        new HostCachePersister(globals_->host_resolver.get(), user_data_dir));
+  }
+  net::MultiThreadedCertVerifier* cert_verifier =
+      new net::MultiThreadedCertVerifier(net::CertVerifyProc::CreateDefault());
+  globals_->cert_verifier.reset(cert_verifier);
+  size_t max_concurrent_cert_verifications = 0;
+  if (base::StringToSizeT(
+          command_line.GetSwitchValueASCII(
+              switches::kCertVerifierMaxConcurrentJobs),
+          &max_concurrent_cert_verifications)) {
+    cert_verifier->SetMaxConcurrentJobs(max_concurrent_cert_verifications);
+  }
+  if (command_line.HasSwitch(switches::kEnableCertVerifierCachePersistence) &&
+      PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    cert_verifier_cache_persister_.reset(
+        new CertVerifierCachePersister(cert_verifier, user_data_dir));
+  }
   globals_->transport_security_state.reset(new net::TransportSecurityState());
   globals_->ssl_config_service = GetSSLConfigService();
   if (command_line.HasSwitch(switches::kSpdyProxyAuthOrigin)) {
@@ -620,6 +660,11 @@ void IOThread::InitAsync() {
           scoped_ptr<base::TickClock>(new base::DefaultTickClock())));
 
   sdch_manager_ = new net::SdchManager();
+  if (command_line.HasSwitch(switches::kEnableSdchPersistence) &&
+      PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    sdch_dictionary_persister_.reset(
+        new SdchDictionaryPersister(sdch_manager_, user_data_dir));
+  }
 
 #if defined(OS_MACOSX) && !defined(OS_IOS)
   // Start observing Keychain events. This needs to be done on the UI thread,
@@ -648,9 +693,15 @@ void IOThread::InitAsync() {
 void IOThread::CleanUp() {
   base::debug::LeakTracker<SafeBrowsingURLRequestContext>::CheckForLeaks();
 
+  sdch_dictionary_persister_.reset();
   delete sdch_manager_;
   sdch_manager_ = NULL;
 
+  // These must be reset before the CertVerifier and HostResolver in
+  // |globals_| are destroyed.
+  cert_verifier_cache_persister_.reset();
+  host_cache_persister_.reset();
+
 #if defined(USE_NSS) || defined(OS_IOS)
   net::ShutdownNSSHttpIO();
 #endif
@@ -873,6 +924,13 @@ void IOThread::ClearHostCache() {
     host_cache->clear();
 }
 
+void IOThread::ClearSdchDictionaries() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (sdch_manager_)
+    sdch_manager_->ClearDictionaries();
+}
+
 void IOThread::InitializeNetworkSessionParams(
     net::HttpNetworkSession::Params* params) {
   params->host_resolver = globals_->host_resolver.get();
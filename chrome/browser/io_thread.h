@@ -20,11 +20,14 @@
 #include "net/http/http_network_session.h"
 #include "net/socket/next_proto.h"
 
+class CertVerifierCachePersister;
 class ChromeNetLog;
 class CommandLine;
+class HostCachePersister;
 class PrefProxyConfigTracker;
 class PrefService;
 class PrefRegistrySimple;
+class SdchDictionaryPersister;
 class SystemURLRequestContextGetter;
 
 namespace chrome_browser_net {
@@ -205,6 +208,10 @@ class IOThread : public content::BrowserThreadDelegate {
   // called on the IO thread.
   void ClearHostCache();
 
+  // Clears the SDCH dictionaries, in memory and on disk.  Must be called on
+  // the IO thread.
+  void ClearSdchDictionaries();
+
   void InitializeNetworkSessionParams(net::HttpNetworkSession::Params* params);
 
  private:
@@ -316,6 +323,15 @@ class IOThread : public content::BrowserThreadDelegate {
 
   net::SdchManager* sdch_manager_;
 
+  // Saves |sdch_manager_|'s dictionaries across restarts, when enabled.
+  scoped_ptr<SdchDictionaryPersister> sdch_dictionary_persister_;
+
+  // Saves the CertVerifier's cached results across restarts, when enabled.
+  scoped_ptr<CertVerifierCachePersister> cert_verifier_cache_persister_;
+
+  // Saves the HostResolver's cache across restarts, when enabled.
+  scoped_ptr<HostCachePersister> host_cache_persister_;
+
   // True if SPDY is disabled by policy.
   bool is_spdy_disabled_by_policy_;
 
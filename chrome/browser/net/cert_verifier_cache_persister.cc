@@ -0,0 +1,110 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/cert_verifier_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace {
+
+const base::FilePath::CharType kCertVerifierCacheFilename[] =
+    FILE_PATH_LITERAL("CertVerifierCache");
+
+}  // namespace
+
+class CertVerifierCachePersister::Loader {
+ public:
+  Loader(const base::WeakPtr<CertVerifierCachePersister>& persister,
+         const base::FilePath& path)
+      : persister_(persister),
+        path_(path),
+        serialized_valid_(false) {
+  }
+
+  void Load() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+    serialized_valid_ = file_util::ReadFileToString(path_, &serialized_);
+  }
+
+  void CompleteLoad() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+    // Make sure we're deleted.
+    scoped_ptr<Loader> deleter(this);
+
+    if (!persister_.get() || !serialized_valid_)
+      return;
+    persister_->CompleteLoad(serialized_);
+  }
+
+ private:
+  base::WeakPtr<CertVerifierCachePersister> persister_;
+
+  base::FilePath path_;
+
+  std::string serialized_;
+  bool serialized_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(Loader);
+};
+
+CertVerifierCachePersister::CertVerifierCachePersister(
+    net::MultiThreadedCertVerifier* cert_verifier,
+    const base::FilePath& user_data_dir)
+    : cert_verifier_(cert_verifier),
+      writer_(user_data_dir.Append(kCertVerifierCacheFilename),
+              BrowserThread::GetMessageLoopProxyForThread(BrowserThread::FILE)
+                  .get()),
+      weak_ptr_factory_(this) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  cert_verifier_->SetDelegate(this);
+
+  Loader* loader = new Loader(weak_ptr_factory_.GetWeakPtr(), writer_.path());
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&Loader::Load, base::Unretained(loader)),
+      base::Bind(&Loader::CompleteLoad, base::Unretained(loader)));
+}
+
+CertVerifierCachePersister::~CertVerifierCachePersister() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+
+  cert_verifier_->SetDelegate(NULL);
+}
+
+void CertVerifierCachePersister::CacheChanged(
+    net::MultiThreadedCertVerifier* cert_verifier) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  DCHECK_EQ(cert_verifier_, cert_verifier);
+
+  writer_.ScheduleWrite(this);
+}
+
+bool CertVerifierCachePersister::SerializeData(std::string* output) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  cert_verifier_->SaveCache(output);
+  return true;
+}
+
+bool CertVerifierCachePersister::LoadEntries(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  return cert_verifier_->RestoreCache(serialized);
+}
+
+void CertVerifierCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (!LoadEntries(serialized))
+    LOG(ERROR) << "Failed to deserialize the certificate verification cache";
+}
@@ -0,0 +1,72 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// MultiThreadedCertVerifier caches verification results in memory, so every
+// restart verifies the certificate chain of each site again on its first
+// connection, which can take hundreds of milliseconds when it involves
+// fetching intermediates or revocation information.  This object writes the
+// cached results out to disk as they are added, and adds them back to the
+// verifier at startup.
+//
+// As with SdchDictionaryPersister, startup isn't delayed for the load: a Task
+// on the file thread reads the file, and the results are restored on the IO
+// thread once it is done.  Connections made before then simply verify as
+// usual.
+//
+// The results are only used for the same certificate chain, hostname, flags,
+// CRLSet and additional trust anchors they were verified with, and for no
+// longer than the verifier would have used them without the restart.
+
+#ifndef CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
+#define CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/weak_ptr.h"
+#include "net/cert/multi_threaded_cert_verifier.h"
+
+// Reads and updates the on-disk certificate verification results.
+// Must be created, used and destroyed only on the IO thread.
+class CertVerifierCachePersister
+    : public net::MultiThreadedCertVerifier::Delegate,
+      public base::ImportantFileWriter::DataSerializer {
+ public:
+  // The results are kept in a file in |user_data_dir|, since the
+  // CertVerifier is shared by all profiles.
+  CertVerifierCachePersister(net::MultiThreadedCertVerifier* cert_verifier,
+                             const base::FilePath& user_data_dir);
+  virtual ~CertVerifierCachePersister();
+
+  // net::MultiThreadedCertVerifier::Delegate:
+  virtual void CacheChanged(
+      net::MultiThreadedCertVerifier* cert_verifier) OVERRIDE;
+
+  // ImportantFileWriter::DataSerializer:
+  //
+  // Serializes the cached results of |cert_verifier_| into |*output|, in the
+  // format of MultiThreadedCertVerifier::SaveCache().
+  virtual bool SerializeData(std::string* output) OVERRIDE;
+
+  // Restores the results in |serialized| to |cert_verifier_|.  Returns false
+  // if |serialized| could not be parsed.
+  bool LoadEntries(const std::string& serialized);
+
+ private:
+  class Loader;
+
+  void CompleteLoad(const std::string& serialized);
+
+  net::MultiThreadedCertVerifier* cert_verifier_;
+
+  // Helper for safely writing the data.
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<CertVerifierCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(CertVerifierCachePersister);
+};
+
+#endif  // CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
@@ -0,0 +1,176 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/cert_verifier_cache_persister.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "content/public/test/test_browser_thread.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/base/test_data_directory.h"
+#include "net/cert/cert_verify_proc.h"
+#include "net/cert/cert_verify_result.h"
+#include "net/cert/x509_certificate.h"
+#include "net/test/cert_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const char kHostname[] = "www.example.com";
+
+// Counts the verifications, and fails them all with the same error.
+class CountingCertVerifyProc : public net::CertVerifyProc {
+ public:
+  CountingCertVerifyProc() : verifications_(0) {}
+
+  int verifications() const { return verifications_; }
+
+ private:
+  virtual ~CountingCertVerifyProc() {}
+
+  // net::CertVerifyProc:
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual int VerifyInternal(
+      net::X509Certificate* cert,
+      const std::string& hostname,
+      int flags,
+      net::CRLSet* crl_set,
+      const net::CertificateList& additional_trust_anchors,
+      net::CertVerifyResult* verify_result) OVERRIDE {
+    ++verifications_;
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    verify_result->cert_status = net::CERT_STATUS_COMMON_NAME_INVALID;
+    return net::ERR_CERT_COMMON_NAME_INVALID;
+  }
+
+  int verifications_;
+};
+
+}  // namespace
+
+class CertVerifierCachePersisterTest : public testing::Test {
+ public:
+  CertVerifierCachePersisterTest()
+      : message_loop_(base::MessageLoop::TYPE_IO),
+        test_file_thread_(content::BrowserThread::FILE, &message_loop_),
+        test_io_thread_(content::BrowserThread::IO, &message_loop_) {
+  }
+
+  virtual ~CertVerifierCachePersisterTest() {
+    message_loop_.RunUntilIdle();
+  }
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    test_cert_ = net::ImportCertFromFile(net::GetTestCertsDirectory(),
+                                         "ok_cert.pem");
+    ASSERT_TRUE(test_cert_.get());
+    CreateCertVerifier();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    persister_.reset();
+    cert_verifier_.reset();
+  }
+
+ protected:
+  // Simulates a restart, discarding the cached results.
+  void CreateCertVerifier() {
+    persister_.reset();
+    verify_proc_ = new CountingCertVerifyProc;
+    cert_verifier_.reset(new net::MultiThreadedCertVerifier(verify_proc_.get()));
+  }
+
+  void CreatePersister() {
+    persister_.reset(
+        new CertVerifierCachePersister(cert_verifier_.get(),
+                                       temp_dir_.path()));
+  }
+
+  // Verifies |test_cert_| for |kHostname| and returns the result.
+  int Verify() {
+    net::CertVerifyResult verify_result;
+    net::TestCompletionCallback callback;
+    net::CertVerifier::RequestHandle request_handle;
+    int error = cert_verifier_->Verify(test_cert_.get(), kHostname, 0, NULL,
+                                       &verify_result, callback.callback(),
+                                       &request_handle, net::BoundNetLog());
+    return callback.GetResult(error);
+  }
+
+  // Ordering is important here. If member variables are not destroyed in the
+  // right order, then DCHECKs will fail all over the place.
+  base::MessageLoop message_loop_;
+
+  // Needed for ImportantFileWriter, which CertVerifierCachePersister uses.
+  content::TestBrowserThread test_file_thread_;
+
+  // CertVerifierCachePersister runs on the IO thread.
+  content::TestBrowserThread test_io_thread_;
+
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<net::X509Certificate> test_cert_;
+  scoped_refptr<CountingCertVerifyProc> verify_proc_;
+  scoped_ptr<net::MultiThreadedCertVerifier> cert_verifier_;
+  scoped_ptr<CertVerifierCachePersister> persister_;
+};
+
+TEST_F(CertVerifierCachePersisterTest, SerializeEmpty) {
+  CreatePersister();
+  std::string output;
+  EXPECT_TRUE(persister_->SerializeData(&output));
+  EXPECT_TRUE(persister_->LoadEntries(output));
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+  EXPECT_EQ(1, verify_proc_->verifications());
+}
+
+TEST_F(CertVerifierCachePersisterTest, SerializeAndRestore) {
+  CreatePersister();
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+  EXPECT_EQ(1, verify_proc_->verifications());
+
+  std::string output;
+  EXPECT_TRUE(persister_->SerializeData(&output));
+
+  CreateCertVerifier();
+  CreatePersister();
+  EXPECT_TRUE(persister_->LoadEntries(output));
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+  EXPECT_EQ(0, verify_proc_->verifications());
+}
+
+TEST_F(CertVerifierCachePersisterTest, LoadsAtStartup) {
+  CreatePersister();
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+
+  // Destroying the persister writes out the pending change.
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(temp_dir_.path().AppendASCII(
+      "CertVerifierCache")));
+
+  CreateCertVerifier();
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+  EXPECT_EQ(0, verify_proc_->verifications());
+}
+
+TEST_F(CertVerifierCachePersisterTest, RejectsBadData) {
+  CreatePersister();
+  EXPECT_FALSE(persister_->LoadEntries(std::string()));
+  EXPECT_FALSE(persister_->LoadEntries("not a saved cache"));
+  EXPECT_EQ(net::ERR_CERT_COMMON_NAME_INVALID, Verify());
+  EXPECT_EQ(1, verify_proc_->verifications());
+}
@@ -485,6 +485,7 @@ ChromeNetworkDelegate::ChromeNetworkDelegate(
     BooleanPrefMember* enable_referrers)
     : event_router_(event_router),
       profile_(NULL),
+      incognito_(false),
       enable_referrers_(enable_referrers),
       enable_do_not_track_(NULL),
       force_google_safe_search_(NULL),
@@ -885,6 +886,11 @@ bool ChromeNetworkDelegate::OnCanEnablePrivacyMode(
   return privacy_mode;
 }
 
+bool ChromeNetworkDelegate::OnCanPersistSdchDictionary(
+    const net::URLRequest& request) const {
+  return !incognito_;
+}
+
 int ChromeNetworkDelegate::OnBeforeSocketStreamConnect(
     net::SocketStream* socket,
     const net::CompletionCallback& callback) {
@@ -68,6 +68,12 @@ class ChromeNetworkDelegate : public net::NetworkDelegate {
     profile_ = profile;
   }
 
+  // If |incognito| is true, SDCH dictionaries which requests ask for are not
+  // saved to disk.
+  void set_incognito(bool incognito) {
+    incognito_ = incognito;
+  }
+
   // If |cookie_settings| is NULL or not set, all cookies are enabled,
   // otherwise the settings are enforced on all observed network requests.
   // Not inlined because we assign a scoped_refptr, which requires us to include
@@ -160,6 +166,8 @@ class ChromeNetworkDelegate : public net::NetworkDelegate {
   virtual bool OnCanEnablePrivacyMode(
       const GURL& url,
       const GURL& first_party_for_cookies) const OVERRIDE;
+  virtual bool OnCanPersistSdchDictionary(
+      const net::URLRequest& request) const OVERRIDE;
   virtual int OnBeforeSocketStreamConnect(
       net::SocketStream* stream,
       const net::CompletionCallback& callback) OVERRIDE;
@@ -172,6 +180,7 @@ class ChromeNetworkDelegate : public net::NetworkDelegate {
 
   scoped_refptr<extensions::EventRouterForwarder> event_router_;
   void* profile_;
+  bool incognito_;
   scoped_refptr<CookieSettings> cookie_settings_;
 
   scoped_refptr<ExtensionInfoMap> extension_info_map_;
@@ -0,0 +1,145 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/host_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/dns/host_resolver.h"
+
+using content::BrowserThread;
+
+namespace {
+
+const base::FilePath::CharType kHostCacheFilename[] =
+    FILE_PATH_LITERAL("HostCache");
+
+const int kVersion = 1;
+
+const char kVersionKey[] = "version";
+const char kEntriesKey[] = "entries";
+
+// How many of the restored hosts are resolved again right away.  The rest are
+// resolved when they are next requested.
+const size_t kMaxHostsToRefresh = 20;
+
+}  // namespace
+
+class HostCachePersister::Loader {
+ public:
+  Loader(const base::WeakPtr<HostCachePersister>& persister,
+         const base::FilePath& path)
+      : persister_(persister),
+        path_(path),
+        serialized_valid_(false) {
+  }
+
+  void Load() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+    serialized_valid_ = file_util::ReadFileToString(path_, &serialized_);
+  }
+
+  void CompleteLoad() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+    // Make sure we're deleted.
+    scoped_ptr<Loader> deleter(this);
+
+    if (!persister_.get() || !serialized_valid_)
+      return;
+    persister_->CompleteLoad(serialized_);
+  }
+
+ private:
+  base::WeakPtr<HostCachePersister> persister_;
+
+  base::FilePath path_;
+
+  std::string serialized_;
+  bool serialized_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(Loader);
+};
+
+HostCachePersister::HostCachePersister(net::HostResolver* host_resolver,
+                                       const base::FilePath& user_data_dir)
+    : host_resolver_(host_resolver),
+      cache_(host_resolver->GetHostCache()),
+      writer_(user_data_dir.Append(kHostCacheFilename),
+              BrowserThread::GetMessageLoopProxyForThread(BrowserThread::FILE)
+                  .get()),
+      weak_ptr_factory_(this) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (!cache_)
+    return;
+
+  cache_->SetDelegate(this);
+
+  Loader* loader = new Loader(weak_ptr_factory_.GetWeakPtr(), writer_.path());
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&Loader::Load, base::Unretained(loader)),
+      base::Bind(&Loader::CompleteLoad, base::Unretained(loader)));
+}
+
+HostCachePersister::~HostCachePersister() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (!cache_)
+    return;
+
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+
+  cache_->SetDelegate(NULL);
+}
+
+void HostCachePersister::CacheChanged(net::HostCache* cache) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  DCHECK_EQ(cache_, cache);
+
+  writer_.ScheduleWrite(this);
+}
+
+bool HostCachePersister::SerializeData(std::string* output) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  base::ListValue* entries = new base::ListValue;
+  cache_->GetAsListValue(entries);
+
+  base::DictionaryValue toplevel;
+  toplevel.SetInteger(kVersionKey, kVersion);
+  toplevel.Set(kEntriesKey, entries);
+  base::JSONWriter::Write(&toplevel, output);
+  return true;
+}
+
+bool HostCachePersister::LoadEntries(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  scoped_ptr<base::Value> value(base::JSONReader::Read(serialized));
+  base::DictionaryValue* toplevel = NULL;
+  int version = 0;
+  const base::ListValue* entries = NULL;
+  if (!value.get() || !value->GetAsDictionary(&toplevel) ||
+      !toplevel->GetInteger(kVersionKey, &version) || version != kVersion ||
+      !toplevel->GetList(kEntriesKey, &entries)) {
+    return false;
+  }
+  return cache_->RestoreFromListValue(*entries);
+}
+
+void HostCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (!LoadEntries(serialized))
+    LOG(ERROR) << "Failed to deserialize the host cache";
+
+  host_resolver_->RefreshStaleCacheEntries(kMaxHostsToRefresh);
+}
@@ -0,0 +1,74 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The HostCache only lives in memory, so after a restart the first request to
+// each host waits for a DNS lookup, which on a slow network can dominate the
+// time to first byte.  This object writes the cached addresses out to disk as
+// they change, and adds them back to the cache at startup.
+//
+// As with CertVerifierCachePersister, startup isn't delayed for the load: a
+// Task on the file thread reads the file, and the entries are restored on the
+// IO thread once it is done.  Requests made before then simply resolve as
+// usual.
+//
+// Restored entries keep their original expiration time, so most of them have
+// expired by the time they are loaded.  The most recently used of them are
+// refreshed in the background right away, and when the HostResolver is
+// allowed to serve stale entries, they are used in the meantime.
+
+#ifndef CHROME_BROWSER_NET_HOST_CACHE_PERSISTER_H_
+#define CHROME_BROWSER_NET_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/weak_ptr.h"
+#include "net/dns/host_cache.h"
+
+namespace net {
+class HostResolver;
+}
+
+// Reads and updates the on-disk host cache.
+// Must be created, used and destroyed only on the IO thread.
+class HostCachePersister
+    : public net::HostCache::Delegate,
+      public base::ImportantFileWriter::DataSerializer {
+ public:
+  // The entries are kept in a file in |user_data_dir|, since the HostResolver
+  // is shared by all profiles.  Does nothing if |host_resolver| has no cache.
+  HostCachePersister(net::HostResolver* host_resolver,
+                     const base::FilePath& user_data_dir);
+  virtual ~HostCachePersister();
+
+  // net::HostCache::Delegate:
+  virtual void CacheChanged(net::HostCache* cache) OVERRIDE;
+
+  // ImportantFileWriter::DataSerializer:
+  //
+  // Serializes the successful entries of the host cache into |*output|.
+  virtual bool SerializeData(std::string* output) OVERRIDE;
+
+  // Restores the entries in |serialized| to the host cache.  Returns false if
+  // |serialized| could not be parsed, or held a malformed entry.
+  bool LoadEntries(const std::string& serialized);
+
+ private:
+  class Loader;
+
+  void CompleteLoad(const std::string& serialized);
+
+  net::HostResolver* host_resolver_;
+  net::HostCache* cache_;
+
+  // Helper for safely writing the data.
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<HostCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+#endif  // CHROME_BROWSER_NET_HOST_CACHE_PERSISTER_H_
@@ -0,0 +1,170 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/host_cache_persister.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "content/public/test/test_browser_thread.h"
+#include "net/base/address_list.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/mock_host_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const char kHostname[] = "www.example.com";
+
+// Records the refreshes it is asked to start, instead of starting them.
+class RefreshRecordingHostResolver : public net::MockCachingHostResolver {
+ public:
+  RefreshRecordingHostResolver() : max_hosts_refreshed_(0) {}
+
+  size_t max_hosts_refreshed() const { return max_hosts_refreshed_; }
+
+  virtual size_t RefreshStaleCacheEntries(size_t max_hosts) OVERRIDE {
+    max_hosts_refreshed_ = max_hosts;
+    return 0;
+  }
+
+ private:
+  size_t max_hosts_refreshed_;
+};
+
+}  // namespace
+
+class HostCachePersisterTest : public testing::Test {
+ public:
+  HostCachePersisterTest()
+      : message_loop_(base::MessageLoop::TYPE_IO),
+        test_file_thread_(content::BrowserThread::FILE, &message_loop_),
+        test_io_thread_(content::BrowserThread::IO, &message_loop_) {
+  }
+
+  virtual ~HostCachePersisterTest() {
+    message_loop_.RunUntilIdle();
+  }
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    CreateHostResolver();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    persister_.reset();
+    host_resolver_.reset();
+  }
+
+ protected:
+  // Simulates a restart, discarding the cached entries.
+  void CreateHostResolver() {
+    persister_.reset();
+    host_resolver_.reset(new RefreshRecordingHostResolver);
+  }
+
+  void CreatePersister() {
+    persister_.reset(
+        new HostCachePersister(host_resolver_.get(), temp_dir_.path()));
+  }
+
+  // Resolves |kHostname|, adding it to the cache.
+  int Resolve() {
+    net::HostResolver::RequestInfo info(net::HostPortPair(kHostname, 80));
+    net::AddressList addresses;
+    net::TestCompletionCallback callback;
+    int rv = host_resolver_->Resolve(info, &addresses, callback.callback(),
+                                     NULL, net::BoundNetLog());
+    return callback.GetResult(rv);
+  }
+
+  // Looks up |kHostname| in the cache only.
+  int ResolveFromCache() {
+    net::HostResolver::RequestInfo info(net::HostPortPair(kHostname, 80));
+    net::AddressList addresses;
+    return host_resolver_->ResolveFromCache(info, &addresses,
+                                            net::BoundNetLog());
+  }
+
+  // Ordering is important here. If member variables are not destroyed in the
+  // right order, then DCHECKs will fail all over the place.
+  base::MessageLoop message_loop_;
+
+  // Needed for ImportantFileWriter, which HostCachePersister uses.
+  content::TestBrowserThread test_file_thread_;
+
+  // HostCachePersister runs on the IO thread.
+  content::TestBrowserThread test_io_thread_;
+
+  base::ScopedTempDir temp_dir_;
+  scoped_ptr<RefreshRecordingHostResolver> host_resolver_;
+  scoped_ptr<HostCachePersister> persister_;
+};
+
+TEST_F(HostCachePersisterTest, SerializeEmpty) {
+  CreatePersister();
+  std::string output;
+  EXPECT_TRUE(persister_->SerializeData(&output));
+  EXPECT_TRUE(persister_->LoadEntries(output));
+  EXPECT_EQ(0u, host_resolver_->GetHostCache()->size());
+}
+
+TEST_F(HostCachePersisterTest, SerializeAndRestore) {
+  CreatePersister();
+  EXPECT_EQ(net::OK, Resolve());
+
+  std::string output;
+  EXPECT_TRUE(persister_->SerializeData(&output));
+
+  CreateHostResolver();
+  CreatePersister();
+  EXPECT_EQ(net::ERR_DNS_CACHE_MISS, ResolveFromCache());
+  EXPECT_TRUE(persister_->LoadEntries(output));
+  EXPECT_EQ(net::OK, ResolveFromCache());
+}
+
+TEST_F(HostCachePersisterTest, LoadsAndRefreshesAtStartup) {
+  CreatePersister();
+  EXPECT_EQ(net::OK, Resolve());
+
+  // Destroying the persister writes out the pending change.
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(temp_dir_.path().AppendASCII("HostCache")));
+
+  CreateHostResolver();
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(net::OK, ResolveFromCache());
+  EXPECT_GT(host_resolver_->max_hosts_refreshed(), 0u);
+}
+
+TEST_F(HostCachePersisterTest, ClearedEntriesAreNotRestored) {
+  CreatePersister();
+  EXPECT_EQ(net::OK, Resolve());
+  host_resolver_->GetHostCache()->clear();
+
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+
+  CreateHostResolver();
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(net::ERR_DNS_CACHE_MISS, ResolveFromCache());
+}
+
+TEST_F(HostCachePersisterTest, RejectsBadData) {
+  CreatePersister();
+  EXPECT_FALSE(persister_->LoadEntries(std::string()));
+  EXPECT_FALSE(persister_->LoadEntries("not a saved cache"));
+  EXPECT_FALSE(persister_->LoadEntries("{\"version\": 2, \"entries\": []}"));
+  EXPECT_EQ(0u, host_resolver_->GetHostCache()->size());
+}
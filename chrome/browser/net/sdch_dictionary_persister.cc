@@ -0,0 +1,202 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/sdch_dictionary_persister.h"
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/metrics/histogram.h"
+#include "base/values.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace {
+
+const base::FilePath::CharType kSdchDictionariesFilename[] =
+    FILE_PATH_LITERAL("SdchDictionaries");
+
+const int kVersion = 1;
+
+// How long to wait after a change before writing, as ImportantFileWriter does.
+const int kCommitIntervalMs = 10000;
+
+const char kVersionKey[] = "version";
+const char kDictionariesKey[] = "dictionaries";
+const char kUrlKey[] = "url";
+const char kAddedKey[] = "added";
+const char kTextKey[] = "text";
+
+void SerializeAndWrite(
+    const base::FilePath& path,
+    const net::SdchManager::SavedDictionaryList* dictionaries) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+
+  std::string data;
+  SdchDictionaryPersister::SerializeData(*dictionaries, &data);
+  base::ImportantFileWriter::WriteFileAtomically(path, data);
+}
+
+}  // namespace
+
+class SdchDictionaryPersister::Loader {
+ public:
+  Loader(const base::WeakPtr<SdchDictionaryPersister>& persister,
+         const base::FilePath& path)
+      : persister_(persister),
+        path_(path),
+        serialized_valid_(false) {
+  }
+
+  void Load() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+    serialized_valid_ = file_util::ReadFileToString(path_, &serialized_);
+  }
+
+  void CompleteLoad() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+    // Make sure we're deleted.
+    scoped_ptr<Loader> deleter(this);
+
+    if (!persister_.get() || !serialized_valid_)
+      return;
+    persister_->CompleteLoad(serialized_);
+  }
+
+ private:
+  base::WeakPtr<SdchDictionaryPersister> persister_;
+
+  base::FilePath path_;
+
+  std::string serialized_;
+  bool serialized_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(Loader);
+};
+
+SdchDictionaryPersister::SdchDictionaryPersister(
+    net::SdchManager* sdch_manager,
+    const base::FilePath& user_data_dir)
+    : sdch_manager_(sdch_manager),
+      path_(user_data_dir.Append(kSdchDictionariesFilename)),
+      weak_ptr_factory_(this) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  sdch_manager_->SetDelegate(this);
+
+  Loader* loader = new Loader(weak_ptr_factory_.GetWeakPtr(), path_);
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&Loader::Load, base::Unretained(loader)),
+      base::Bind(&Loader::CompleteLoad, base::Unretained(loader)));
+}
+
+SdchDictionaryPersister::~SdchDictionaryPersister() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (timer_.IsRunning()) {
+    timer_.Stop();
+    WriteNow();
+  }
+
+  sdch_manager_->SetDelegate(NULL);
+}
+
+void SdchDictionaryPersister::DictionariesChanged(
+    net::SdchManager* sdch_manager) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  DCHECK_EQ(sdch_manager_, sdch_manager);
+
+  if (timer_.IsRunning())
+    return;
+  timer_.Start(FROM_HERE,
+               base::TimeDelta::FromMilliseconds(kCommitIntervalMs),
+               this, &SdchDictionaryPersister::WriteNow);
+}
+
+// static
+void SdchDictionaryPersister::SerializeData(
+    const net::SdchManager::SavedDictionaryList& dictionaries,
+    std::string* output) {
+  ListValue* list = new ListValue;
+  for (size_t i = 0; i < dictionaries.size(); ++i) {
+    // Dictionaries are arbitrary bytes, which JSON strings can't hold.
+    std::string text;
+    if (!base::Base64Encode(dictionaries[i].text, &text))
+      continue;
+    DictionaryValue* serialized = new DictionaryValue;
+    serialized->SetString(kUrlKey, dictionaries[i].url.spec());
+    serialized->SetDouble(kAddedKey, dictionaries[i].added.ToDoubleT());
+    serialized->SetString(kTextKey, text);
+    list->Append(serialized);
+  }
+
+  DictionaryValue toplevel;
+  toplevel.SetInteger(kVersionKey, kVersion);
+  toplevel.Set(kDictionariesKey, list);
+  base::JSONWriter::Write(&toplevel, output);
+}
+
+bool SdchDictionaryPersister::LoadEntries(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  scoped_ptr<Value> value(base::JSONReader::Read(serialized));
+  DictionaryValue* toplevel = NULL;
+  int version = 0;
+  const ListValue* list = NULL;
+  if (!value.get() || !value->GetAsDictionary(&toplevel) ||
+      !toplevel->GetInteger(kVersionKey, &version) || version != kVersion ||
+      !toplevel->GetList(kDictionariesKey, &list)) {
+    return false;
+  }
+
+  int restored = 0;
+  for (size_t i = 0; i < list->GetSize(); ++i) {
+    const DictionaryValue* parsed = NULL;
+    std::string url;
+    double added = 0.0;
+    std::string text;
+    net::SdchManager::SavedDictionary dictionary;
+    if (!list->GetDictionary(i, &parsed) ||
+        !parsed->GetString(kUrlKey, &url) ||
+        !parsed->GetDouble(kAddedKey, &added) ||
+        !parsed->GetString(kTextKey, &text) ||
+        !base::Base64Decode(text, &dictionary.text)) {
+      LOG(WARNING) << "Could not parse SDCH dictionary " << i
+                   << "; skipping entry";
+      continue;
+    }
+    dictionary.url = GURL(url);
+    dictionary.added = base::Time::FromDoubleT(added);
+    // Dictionaries which have expired since they were written are dropped
+    // here, and from the file with the next write.
+    if (sdch_manager_->RestoreSdchDictionary(dictionary))
+      ++restored;
+  }
+  UMA_HISTOGRAM_COUNTS_100("Sdch3.Dictionaries_Restored", restored);
+  return true;
+}
+
+void SdchDictionaryPersister::WriteNow() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  net::SdchManager::SavedDictionaryList* dictionaries =
+      new net::SdchManager::SavedDictionaryList;
+  sdch_manager_->GetSavedDictionaries(dictionaries);
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&SerializeAndWrite, path_, base::Owned(dictionaries)));
+}
+
+void SdchDictionaryPersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (!LoadEntries(serialized))
+    LOG(ERROR) << "Failed to deserialize SDCH dictionaries";
+}
@@ -0,0 +1,87 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// SdchManager keeps its dictionaries in memory, so without this object every
+// restart forgets them, and the first pages from each SDCH server are fetched
+// without SDCH while the dictionaries are downloaded again.  This object
+// writes the dictionaries out to disk as they are added, and adds them back
+// to the SdchManager at startup.
+//
+// As with TransportSecurityPersister, startup isn't delayed for the load: a
+// Task on the file thread reads the file, and the dictionaries are restored
+// on the IO thread once it is done.  Pages loaded before then simply don't
+// advertise the dictionaries yet.
+//
+// SdchManager calls SdchDictionaryPersister::DictionariesChanged when a
+// dictionary is added or removed, which schedules a write after a short
+// delay, so that several dictionaries arriving together are written once.
+// The write takes a copy of the dictionaries on the IO thread, and encodes
+// and writes them on the file thread: all of them together can be several
+// megabytes.
+//
+// Dictionaries which only off the record requests asked for are never
+// written, and the browsing data remover clears the file along with the
+// cache.
+
+#ifndef CHROME_BROWSER_NET_SDCH_DICTIONARY_PERSISTER_H_
+#define CHROME_BROWSER_NET_SDCH_DICTIONARY_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "net/base/sdch_manager.h"
+
+// Reads and updates the on-disk SDCH dictionaries.
+// Must be created, used and destroyed only on the IO thread.
+class SdchDictionaryPersister : public net::SdchManager::Delegate {
+ public:
+  // The dictionaries are kept in a file in |user_data_dir|, since SdchManager
+  // is shared by all profiles.
+  SdchDictionaryPersister(net::SdchManager* sdch_manager,
+                          const base::FilePath& user_data_dir);
+  virtual ~SdchDictionaryPersister();
+
+  // net::SdchManager::Delegate:
+  virtual void DictionariesChanged(net::SdchManager* sdch_manager) OVERRIDE;
+
+  // Serializes |dictionaries| into |*output|.  Called on the file thread.
+  //
+  // The serialization format is JSON: a dictionary with a "version" of 1 and
+  // a "dictionaries" list, each entry of which is a dictionary with the keys:
+  //
+  //     "url": string, the URL the dictionary was fetched from
+  //     "added": double, when it was fetched
+  //     "text": string, Base64 of the dictionary including its headers
+  static void SerializeData(
+      const net::SdchManager::SavedDictionaryList& dictionaries,
+      std::string* output);
+
+  // Restores the dictionaries in |serialized| to |sdch_manager_|.  Returns
+  // false if |serialized| could not be parsed at all.
+  bool LoadEntries(const std::string& serialized);
+
+ private:
+  class Loader;
+
+  void CompleteLoad(const std::string& serialized);
+
+  // Copies the dictionaries of |sdch_manager_| and posts a task to write them
+  // out on the file thread.
+  void WriteNow();
+
+  net::SdchManager* sdch_manager_;
+
+  const base::FilePath path_;
+
+  // Delays writes after a change, so that several changes are written once.
+  base::OneShotTimer<SdchDictionaryPersister> timer_;
+
+  base::WeakPtrFactory<SdchDictionaryPersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SdchDictionaryPersister);
+};
+
+#endif  // CHROME_BROWSER_NET_SDCH_DICTIONARY_PERSISTER_H_
@@ -0,0 +1,167 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/sdch_dictionary_persister.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "content/public/test/test_browser_thread.h"
+#include "net/base/sdch_manager.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const char kDictionaryUrl[] = "http://example.com/dictionary";
+
+std::string NewSdchDictionary(const std::string& body) {
+  return "Domain: example.com\n\n" + body;
+}
+
+}  // namespace
+
+class SdchDictionaryPersisterTest : public testing::Test {
+ public:
+  SdchDictionaryPersisterTest()
+      : message_loop_(base::MessageLoop::TYPE_IO),
+        test_file_thread_(content::BrowserThread::FILE, &message_loop_),
+        test_io_thread_(content::BrowserThread::IO, &message_loop_) {
+  }
+
+  virtual ~SdchDictionaryPersisterTest() {
+    message_loop_.RunUntilIdle();
+  }
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    sdch_manager_.reset(new net::SdchManager);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    persister_.reset();
+    sdch_manager_.reset();
+  }
+
+ protected:
+  void CreatePersister() {
+    persister_.reset(
+        new SdchDictionaryPersister(sdch_manager_.get(), temp_dir_.path()));
+  }
+
+  std::string Serialize() {
+    net::SdchManager::SavedDictionaryList dictionaries;
+    sdch_manager_->GetSavedDictionaries(&dictionaries);
+    std::string output;
+    SdchDictionaryPersister::SerializeData(dictionaries, &output);
+    return output;
+  }
+
+  // Returns the client hashes advertised for |kDictionaryUrl|.
+  std::string AvailableDictionaries() {
+    std::string list;
+    sdch_manager_->GetAvailDictionaryList(GURL(kDictionaryUrl), &list);
+    return list;
+  }
+
+  // Ordering is important here. If member variables are not destroyed in the
+  // right order, then DCHECKs will fail all over the place.
+  base::MessageLoop message_loop_;
+
+  // SdchDictionaryPersister loads and writes on the file thread.
+  content::TestBrowserThread test_file_thread_;
+
+  // SdchDictionaryPersister runs on the IO thread.
+  content::TestBrowserThread test_io_thread_;
+
+  base::ScopedTempDir temp_dir_;
+  scoped_ptr<net::SdchManager> sdch_manager_;
+  scoped_ptr<SdchDictionaryPersister> persister_;
+};
+
+TEST_F(SdchDictionaryPersisterTest, SerializeEmpty) {
+  CreatePersister();
+  EXPECT_TRUE(persister_->LoadEntries(Serialize()));
+  EXPECT_EQ(std::string(), AvailableDictionaries());
+}
+
+TEST_F(SdchDictionaryPersisterTest, SerializeAndRestore) {
+  CreatePersister();
+  // Include bytes which aren't valid in JSON strings.
+  std::string dictionary(NewSdchDictionary(std::string("\0\377text", 6)));
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(dictionary,
+                                               GURL(kDictionaryUrl)));
+  std::string expected(AvailableDictionaries());
+  EXPECT_FALSE(expected.empty());
+
+  std::string output(Serialize());
+
+  // Simulate a restart.
+  persister_.reset();
+  sdch_manager_.reset();
+  sdch_manager_.reset(new net::SdchManager);
+  CreatePersister();
+  EXPECT_EQ(std::string(), AvailableDictionaries());
+  EXPECT_TRUE(persister_->LoadEntries(output));
+  EXPECT_EQ(expected, AvailableDictionaries());
+}
+
+TEST_F(SdchDictionaryPersisterTest, LoadsAtStartup) {
+  CreatePersister();
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(NewSdchDictionary("text"),
+                                               GURL(kDictionaryUrl)));
+  std::string expected(AvailableDictionaries());
+
+  // Destroying the persister writes out the pending change.
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(temp_dir_.path().AppendASCII(
+      "SdchDictionaries")));
+
+  sdch_manager_.reset();
+  sdch_manager_.reset(new net::SdchManager);
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(expected, AvailableDictionaries());
+}
+
+TEST_F(SdchDictionaryPersisterTest, ClearedDictionariesAreNotLoaded) {
+  CreatePersister();
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(NewSdchDictionary("text"),
+                                               GURL(kDictionaryUrl)));
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+
+  sdch_manager_.reset();
+  sdch_manager_.reset(new net::SdchManager);
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_NE(std::string(), AvailableDictionaries());
+
+  // As when the user clears their cache.
+  sdch_manager_->ClearDictionaries();
+  EXPECT_EQ(std::string(), AvailableDictionaries());
+  persister_.reset();
+  message_loop_.RunUntilIdle();
+
+  sdch_manager_.reset();
+  sdch_manager_.reset(new net::SdchManager);
+  CreatePersister();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(std::string(), AvailableDictionaries());
+}
+
+TEST_F(SdchDictionaryPersisterTest, RejectsBadData) {
+  CreatePersister();
+  EXPECT_FALSE(persister_->LoadEntries("not json"));
+  EXPECT_FALSE(
+      persister_->LoadEntries("{\"version\": 2, \"dictionaries\": []}"));
+
+  // Entries which can't be parsed are skipped.
+  EXPECT_TRUE(persister_->LoadEntries(
+      "{\"version\": 1, \"dictionaries\": [{\"url\": \"http://a.com/\"}]}"));
+  EXPECT_EQ(std::string(), AvailableDictionaries());
+}
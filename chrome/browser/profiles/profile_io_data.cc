@@ -758,6 +758,7 @@ void ProfileIOData::Init(content::ProtocolHandlerMap* protocol_handlers) const {
       profile_params_->extension_info_map.get());
   network_delegate->set_url_blacklist_manager(url_blacklist_manager_.get());
   network_delegate->set_profile(profile_params_->profile);
+  network_delegate->set_incognito(is_incognito());
   network_delegate->set_cookie_settings(profile_params_->cookie_settings.get());
   network_delegate->set_enable_do_not_track(&enable_do_not_track_);
   network_delegate->set_force_google_safe_search(&force_safesearch_);
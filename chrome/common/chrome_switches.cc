@@ -149,6 +149,12 @@ const char kAutomationReinitializeOnChannelError[] =
 // will not occur in subsequent runs either.
 const char kCancelFirstRun[]                = "cancel-first-run";
 
+// Limits how many certificate verifications run at once.  The others wait
+// for one to finish, and verifications sharing intermediates which haven't
+// been verified yet wait for the first of them.
+const char kCertVerifierMaxConcurrentJobs[] =
+    "cert-verifier-max-concurrent-jobs";
+
 // How often (in seconds) to check for updates. Should only be used for testing
 // purposes.
 const char kCheckForUpdateIntervalSec[]     = "check-for-update-interval";
@@ -536,6 +542,11 @@ const char kEnableAutologin[]               = "enable-autologin";
 // Enables the benchmarking extensions.
 const char kEnableBenchmarking[]            = "enable-benchmarking";
 
+// Keeps certificate verification results on disk across restarts, instead of
+// verifying each site's certificate again after each one.
+const char kEnableCertVerifierCachePersistence[] =
+    "enable-cert-verifier-cache-persistence";
+
 // Enables pushing cloud policy to Chrome using an invalidation service.
 const char kEnableCloudPolicyPush[]         = "enable-cloud-policy-push";
 
@@ -589,6 +600,11 @@ const char kEnableFileCookies[]             = "enable-file-cookies";
 // Enables Google Now integration.
 const char kEnableGoogleNowIntegration[]    = "enable-google-now-integration";
 
+// Keeps the host cache on disk across restarts, and resolves the most recently
+// used hosts again at startup, instead of waiting for DNS on the first request
+// to each host.
+const char kEnableHostCachePersistence[] = "enable-host-cache-persistence";
+
 // Enable HTTP/2 draft 04. This is a temporary testing flag.
 const char kEnableHttp2Draft04[]            = "enable-http2-draft-04";
 
@@ -695,6 +711,10 @@ const char kEnableSavePasswordBubble[]      = "enable-save-password-bubble";
 // supported server-side for searches on google.com.
 const char kEnableSdch[]                    = "enable-sdch";
 
+// Keeps SDCH dictionaries on disk across restarts, instead of fetching them
+// again after each one.
+const char kEnableSdchPersistence[]         = "enable-sdch-persistence";
+
 // Enables support of sticky keys.
 const char kEnableStickyKeys[]              = "enable-sticky-keys";
 
@@ -874,6 +894,11 @@ const char kHomePage[]                      = "homepage";
 // proxy connection, and the endpoint host in a SOCKS proxy connection).
 const char kHostRules[]                     = "host-rules";
 
+// How many seconds after they expire cached host addresses may still be used,
+// while they are resolved again in the background.  Stale addresses aren't
+// used by default.
+const char kHostResolverMaxStaleness[]      = "host-resolver-max-staleness";
+
 // The maximum number of concurrent host resolve requests (i.e. DNS) to allow
 // (not counting backup attempts which would also consume threads).
 // --host-resolver-retry-attempts must be set to zero for this to be exact.
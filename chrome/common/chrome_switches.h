@@ -57,6 +57,7 @@ extern const char kAutoLaunchAtStartup[];
 extern const char kAutomationClientChannelID[];
 extern const char kAutomationReinitializeOnChannelError[];
 extern const char kCancelFirstRun[];
+extern const char kCertVerifierMaxConcurrentJobs[];
 extern const char kCheckForUpdateIntervalSec[];
 extern const char kCheckCloudPrintConnectorPolicy[];
 extern const char kChromeFrame[];
@@ -159,6 +160,7 @@ extern const char kEnableAsyncDns[];
 extern const char kEnableAuthNegotiatePort[];
 extern const char kEnableAutologin[];
 extern const char kEnableBenchmarking[];
+extern const char kEnableCertVerifierCachePersistence[];
 extern const char kEnableCloudPolicyPush[];
 extern const char kEnableCloudPrintProxy[];
 extern const char kEnableComponentCloudPolicy[];
@@ -171,6 +173,7 @@ extern const char kEnableExtensionActivityLogTesting[];
 extern const char kEnableFastUnload[];
 extern const char kEnableFileCookies[];
 extern const char kEnableGoogleNowIntegration[];
+extern const char kEnableHostCachePersistence[];
 extern const char kEnableHttp2Draft04[];
 extern const char kEnableInstantExtendedAPI[];
 extern const char kEnableIPCFuzzing[];
@@ -198,6 +201,7 @@ extern const char kEnableResetProfileSettings[];
 extern const char kEnableResourceContentSettings[];
 extern const char kEnableSavePasswordBubble[];
 extern const char kEnableSdch[];
+extern const char kEnableSdchPersistence[];
 extern const char kEnableStickyKeys[];
 extern const char kDisableStickyKeys[];
 extern const char kDisableSpdy31[];
@@ -243,6 +247,7 @@ extern const char kHistoryEnableGroupByDomain[];
 extern const char kHistoryWebHistoryUrl[];
 extern const char kHomePage[];
 extern const char kHostRules[];
+extern const char kHostResolverMaxStaleness[];
 extern const char kHostResolverParallelism[];
 extern const char kHostResolverRetryAttempts[];
 extern const char kIgnoreUrlFetcherCertRequests[];
@@ -0,0 +1,846 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/net/log_persistent_cookie_store.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/metrics/histogram.h"
+#include "base/pickle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_constants.h"
+#include "net/cookies/cookie_util.h"
+#include "url/gurl.h"
+#include "webkit/browser/quota/special_storage_policy.h"
+
+using base::Time;
+
+namespace content {
+
+// This class is designed to be shared between any client thread and the
+// background task runner.  As in SQLitePersistentCookieStore, operations are
+// batched and committed on a timer, but as a commit only appends to the log
+// it is done much sooner.
+//
+// The first load, whether of all cookies or of a single domain key (eTLD+1),
+// reads the whole log on the background runner and replays it into
+// |cookies_by_creation_|, the cookies the log describes.  The background
+// runner keeps these up to date as it commits operations, which is what lets
+// it write out a compacted log without reading the old one again.
+class LogPersistentCookieStore::Backend
+    : public base::RefCountedThreadSafe<LogPersistentCookieStore::Backend> {
+ public:
+  Backend(
+      const base::FilePath& path,
+      const scoped_refptr<base::SequencedTaskRunner>& client_task_runner,
+      const scoped_refptr<base::SequencedTaskRunner>& background_task_runner,
+      bool restore_old_session_cookies,
+      quota::SpecialStoragePolicy* special_storage_policy)
+      : path_(path),
+        num_pending_(0),
+        force_keep_session_state_(false),
+        initialized_(false),
+        num_records_(0),
+        needs_compaction_(false),
+        restore_old_session_cookies_(restore_old_session_cookies),
+        special_storage_policy_(special_storage_policy),
+        client_task_runner_(client_task_runner),
+        background_task_runner_(background_task_runner) {}
+
+  // Reads the log and loads all cookies.
+  void Load(const LoadedCallback& loaded_callback);
+
+  // Loads cookies for the domain key (eTLD+1).
+  void LoadCookiesForKey(const std::string& key,
+                         const LoadedCallback& loaded_callback);
+
+  // Batch a cookie addition.
+  void AddCookie(const net::CanonicalCookie& cc);
+
+  // Batch a cookie access time update.
+  void UpdateCookieAccessTime(const net::CanonicalCookie& cc);
+
+  // Batch a cookie deletion.
+  void DeleteCookie(const net::CanonicalCookie& cc);
+
+  // Commit pending operations as soon as possible.
+  void Flush(const base::Closure& callback);
+
+  // Commit any pending operations and close the log.  This must be called
+  // before the object is destructed.
+  void Close();
+
+  void SetForceKeepSessionState();
+
+ private:
+  friend class base::RefCountedThreadSafe<LogPersistentCookieStore::Backend>;
+
+  // The cookies described by the log, by creation time, which is unique.
+  typedef std::map<int64, net::CanonicalCookie> CookiesByCreationMap;
+
+  // You should call Close() before destructing this object.
+  ~Backend() {
+    DCHECK(!file_.get()) << "Close should have already been called.";
+    DCHECK(num_pending_ == 0 && pending_.empty());
+  }
+
+  class PendingOperation {
+   public:
+    typedef enum {
+      COOKIE_ADD,
+      COOKIE_UPDATEACCESS,
+      COOKIE_DELETE,
+    } OperationType;
+
+    PendingOperation(OperationType op, const net::CanonicalCookie& cc)
+        : op_(op), cc_(cc) { }
+
+    OperationType op() const { return op_; }
+    const net::CanonicalCookie& cc() const { return cc_; }
+
+   private:
+    OperationType op_;
+    net::CanonicalCookie cc_;
+  };
+
+  // Reads the log on the background runner and notifies the client runner
+  // once all cookies are loaded.
+  void LoadAndNotifyInBackground(const LoadedCallback& loaded_callback);
+
+  // Reads the log if necessary and notifies the client runner once the
+  // cookies for the domain key |key| are loaded.
+  void LoadKeyAndNotifyInBackground(const std::string& key,
+                                    const LoadedCallback& loaded_callback);
+
+  // Passes all cookies loaded since the last notification to
+  // |loaded_callback|.
+  void Notify(const LoadedCallback& loaded_callback, bool load_success);
+
+  // Reads the log into |cookies_by_creation_| and groups the cookies to be
+  // loaded by domain key.  Returns false if the log cannot be used at all.
+  bool InitializeLog();
+
+  // Replays the records of the log |data| into |cookies_by_creation_|.
+  // Returns false if the log is not in the expected format, or if any of it
+  // had to be skipped.
+  bool ReplayLog(const std::string& data);
+
+  // Copies the cookies created at |creation_times| to |cookies_|, from which
+  // they are passed to the next load callback.
+  void LoadCookies(const std::vector<int64>& creation_times);
+
+  // Batch a cookie operation (add or delete)
+  void BatchOperation(PendingOperation::OperationType op,
+                      const net::CanonicalCookie& cc);
+  // Commit our pending operations to the log.
+  void Commit();
+  // Writes |records| at the end of the log.
+  void AppendToLog(const std::string& records);
+  // Whether enough of the log is out of date to be worth compacting.
+  bool ShouldCompact() const;
+  // Replaces the log with one which only adds |cookies_by_creation_|.
+  void Compact();
+  // Close() executed on the background runner.
+  void InternalBackgroundClose();
+
+  void DeleteSessionCookiesOnShutdown();
+
+  void PostBackgroundTask(const tracked_objects::Location& origin,
+                          const base::Closure& task);
+  void PostClientTask(const tracked_objects::Location& origin,
+                      const base::Closure& task);
+
+  base::FilePath path_;
+
+  typedef std::list<PendingOperation*> PendingOperationsList;
+  PendingOperationsList pending_;
+  PendingOperationsList::size_type num_pending_;
+  // True if the persistent store should skip delete on exit rules.
+  bool force_keep_session_state_;
+  // Guard |cookies_|, |pending_|, |num_pending_|, |force_keep_session_state_|
+  base::Lock lock_;
+
+  // Temporary buffer for cookies loaded from the log.  Sent back in response
+  // to individual load requests for domain keys or when all loading
+  // completes.
+  std::vector<net::CanonicalCookie*> cookies_;
+
+  // The following are only accessed on the background runner.
+
+  // Indicates if the log has been read.
+  bool initialized_;
+
+  // The log, open for appending records, or NULL if it hasn't been opened
+  // since it was last written out or if writing to it failed.
+  file_util::ScopedFILE file_;
+
+  CookiesByCreationMap cookies_by_creation_;
+
+  // Map of domain keys (eTLD+1) to the creation times of their cookies which
+  // are still to be loaded.
+  std::map<std::string, std::vector<int64> > keys_to_load_;
+
+  // The number of records in the log, not counting its header.
+  size_t num_records_;
+
+  // Set when the log on disk can't simply be appended to, because it holds
+  // records which must be dropped or it could not be read or written.
+  bool needs_compaction_;
+
+  // If false, we should filter out session cookies when reading the log.
+  bool restore_old_session_cookies_;
+
+  // Policy defining what data is deleted on shutdown.
+  scoped_refptr<quota::SpecialStoragePolicy> special_storage_policy_;
+
+  scoped_refptr<base::SequencedTaskRunner> client_task_runner_;
+  scoped_refptr<base::SequencedTaskRunner> background_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(Backend);
+};
+
+namespace {
+
+// The log begins with a header record holding these, and is followed by one
+// record per operation.  Every record is a uint32 holding the size of a
+// Pickle, followed by the Pickle.
+//
+// The Pickle of a record starts with its RecordType and the creation time of
+// the cookie, which identifies it; RECORD_UPDATE_ACCESS adds the new last
+// access time, and RECORD_ADD the rest of the cookie: its domain, name,
+// value, path, expiry time, last access time, whether it is secure and
+// whether it is HTTP only, and its priority.
+const uint32 kLogMagic = 0x436b4c67;  // "CkLg"
+const int kLogVersion = 1;
+
+enum RecordType {
+  RECORD_ADD = 1,
+  RECORD_UPDATE_ACCESS = 2,
+  RECORD_DELETE = 3,
+};
+
+// Commit after this long, or right away once there are this many operations
+// pending.  Committing is cheap, so the interval is much shorter than that of
+// SQLitePersistentCookieStore.
+const int kCommitIntervalMs = 2 * 1000;
+const size_t kCommitAfterBatchSize = 512;
+
+// The log is compacted once it has more out of date records than both this
+// and the number of cookies it describes.
+const size_t kMinRecordsToCompact = 1024;
+
+void AppendRecord(const Pickle& pickle, std::string* out) {
+  uint32 size = static_cast<uint32>(pickle.size());
+  out->append(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->append(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+void AppendHeaderRecord(std::string* out) {
+  Pickle pickle;
+  pickle.WriteUInt32(kLogMagic);
+  pickle.WriteInt(kLogVersion);
+  AppendRecord(pickle, out);
+}
+
+void AppendAddRecord(const net::CanonicalCookie& cc, std::string* out) {
+  Pickle pickle;
+  pickle.WriteInt(RECORD_ADD);
+  pickle.WriteInt64(cc.CreationDate().ToInternalValue());
+  pickle.WriteString(cc.Domain());
+  pickle.WriteString(cc.Name());
+  pickle.WriteString(cc.Value());
+  pickle.WriteString(cc.Path());
+  pickle.WriteInt64(cc.ExpiryDate().ToInternalValue());
+  pickle.WriteInt64(cc.LastAccessDate().ToInternalValue());
+  pickle.WriteBool(cc.IsSecure());
+  pickle.WriteBool(cc.IsHttpOnly());
+  pickle.WriteInt(cc.Priority());
+  AppendRecord(pickle, out);
+}
+
+void AppendUpdateAccessRecord(const net::CanonicalCookie& cc,
+                              std::string* out) {
+  Pickle pickle;
+  pickle.WriteInt(RECORD_UPDATE_ACCESS);
+  pickle.WriteInt64(cc.CreationDate().ToInternalValue());
+  pickle.WriteInt64(cc.LastAccessDate().ToInternalValue());
+  AppendRecord(pickle, out);
+}
+
+void AppendDeleteRecord(const net::CanonicalCookie& cc, std::string* out) {
+  Pickle pickle;
+  pickle.WriteInt(RECORD_DELETE);
+  pickle.WriteInt64(cc.CreationDate().ToInternalValue());
+  AppendRecord(pickle, out);
+}
+
+// Reads the record at |*offset| of |data| into |pickle|, and moves |*offset|
+// past it.  Returns false if |data| ends before the record does.
+bool ReadRecord(const std::string& data,
+                size_t* offset,
+                scoped_ptr<Pickle>* pickle) {
+  uint32 size;
+  if (data.size() - *offset < sizeof(size))
+    return false;
+  memcpy(&size, data.data() + *offset, sizeof(size));
+  if (data.size() - *offset - sizeof(size) < size)
+    return false;
+  pickle->reset(new Pickle(data.data() + *offset + sizeof(size), size));
+  *offset += sizeof(size) + size;
+  return true;
+}
+
+// Reads the rest of a RECORD_ADD record, whose cookie was created at
+// |creation_utc|.
+bool ReadCookie(const Pickle& pickle,
+                PickleIterator* iter,
+                int64 creation_utc,
+                net::CanonicalCookie* cc) {
+  std::string domain, name, value, path;
+  int64 expires_utc, last_access_utc;
+  bool secure, httponly;
+  int priority;
+  if (!pickle.ReadString(iter, &domain) ||
+      !pickle.ReadString(iter, &name) ||
+      !pickle.ReadString(iter, &value) ||
+      !pickle.ReadString(iter, &path) ||
+      !pickle.ReadInt64(iter, &expires_utc) ||
+      !pickle.ReadInt64(iter, &last_access_utc) ||
+      !pickle.ReadBool(iter, &secure) ||
+      !pickle.ReadBool(iter, &httponly) ||
+      !pickle.ReadInt(iter, &priority) ||
+      priority < net::COOKIE_PRIORITY_LOW ||
+      priority > net::COOKIE_PRIORITY_HIGH) {
+    return false;
+  }
+  *cc = net::CanonicalCookie(
+      // The "source" URL is not used with persisted cookies.
+      GURL(), name, value, domain, path,
+      Time::FromInternalValue(creation_utc),
+      Time::FromInternalValue(expires_utc),
+      Time::FromInternalValue(last_access_utc),
+      secure, httponly, static_cast<net::CookiePriority>(priority));
+  return true;
+}
+
+}  // namespace
+
+void LogPersistentCookieStore::Backend::Load(
+    const LoadedCallback& loaded_callback) {
+  PostBackgroundTask(FROM_HERE, base::Bind(
+      &Backend::LoadAndNotifyInBackground, this, loaded_callback));
+}
+
+void LogPersistentCookieStore::Backend::LoadCookiesForKey(
+    const std::string& key,
+    const LoadedCallback& loaded_callback) {
+  PostBackgroundTask(FROM_HERE, base::Bind(
+      &Backend::LoadKeyAndNotifyInBackground, this, key, loaded_callback));
+}
+
+void LogPersistentCookieStore::Backend::LoadAndNotifyInBackground(
+    const LoadedCallback& loaded_callback) {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  bool success = InitializeLog();
+  if (success) {
+    for (std::map<std::string, std::vector<int64> >::const_iterator it =
+             keys_to_load_.begin();
+         it != keys_to_load_.end(); ++it) {
+      LoadCookies(it->second);
+    }
+    keys_to_load_.clear();
+    UMA_HISTOGRAM_TIMES("Cookie.LogTimeLoad",
+                        base::TimeTicks::Now() - start);
+  }
+
+  PostClientTask(FROM_HERE, base::Bind(
+      &Backend::Notify, this, loaded_callback, success));
+
+  // Drop whatever was skipped while reading the log from the file now, rather
+  // than on the next commit.
+  if (success && needs_compaction_)
+    Compact();
+}
+
+void LogPersistentCookieStore::Backend::LoadKeyAndNotifyInBackground(
+    const std::string& key,
+    const LoadedCallback& loaded_callback) {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  bool success = InitializeLog();
+  if (success) {
+    std::map<std::string, std::vector<int64> >::iterator it =
+        keys_to_load_.find(key);
+    if (it != keys_to_load_.end()) {
+      LoadCookies(it->second);
+      keys_to_load_.erase(it);
+    }
+  }
+
+  PostClientTask(FROM_HERE, base::Bind(
+      &Backend::Notify, this, loaded_callback, success));
+}
+
+void LogPersistentCookieStore::Backend::Notify(
+    const LoadedCallback& loaded_callback,
+    bool load_success) {
+  DCHECK(client_task_runner_->RunsTasksOnCurrentThread());
+
+  std::vector<net::CanonicalCookie*> cookies;
+  {
+    base::AutoLock locked(lock_);
+    cookies.swap(cookies_);
+  }
+
+  loaded_callback.Run(cookies);
+}
+
+bool LogPersistentCookieStore::Backend::InitializeLog() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  if (initialized_)
+    return true;
+
+  const base::FilePath dir = path_.DirName();
+  if (!base::PathExists(dir) && !file_util::CreateDirectory(dir))
+    return false;
+
+  std::string data;
+  if (base::PathExists(path_)) {
+    if (!file_util::ReadFileToString(path_, &data)) {
+      LOG(WARNING) << "Unable to read the cookie log.";
+      return false;
+    }
+    UMA_HISTOGRAM_COUNTS("Cookie.LogSizeInKB", data.size() / 1024);
+  }
+  if (!ReplayLog(data))
+    needs_compaction_ = true;
+
+  // Build a map of domain keys (always eTLD+1) to cookies.
+  for (CookiesByCreationMap::iterator it = cookies_by_creation_.begin();
+       it != cookies_by_creation_.end(); ) {
+    const net::CanonicalCookie& cc = it->second;
+    if (!cc.IsPersistent() && !restore_old_session_cookies_) {
+      cookies_by_creation_.erase(it++);
+      needs_compaction_ = true;
+      continue;
+    }
+    std::string key =
+        net::registry_controlled_domains::GetDomainAndRegistry(
+            cc.Domain(),
+            net::registry_controlled_domains::EXCLUDE_PRIVATE_REGISTRIES);
+    keys_to_load_[key].push_back(it->first);
+    ++it;
+  }
+
+  initialized_ = true;
+  return true;
+}
+
+bool LogPersistentCookieStore::Backend::ReplayLog(const std::string& data) {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  // A new log.
+  if (data.empty())
+    return false;
+
+  size_t offset = 0;
+  scoped_ptr<Pickle> pickle;
+  uint32 magic;
+  int version;
+  if (!ReadRecord(data, &offset, &pickle))
+    return false;
+  PickleIterator header_iter(*pickle);
+  if (!pickle->ReadUInt32(&header_iter, &magic) || magic != kLogMagic ||
+      !pickle->ReadInt(&header_iter, &version) || version != kLogVersion) {
+    LOG(WARNING) << "Unrecognized cookie log; starting a new one.";
+    return false;
+  }
+
+  while (offset < data.size()) {
+    // A record cut short can only be at the end of the log, if writing it
+    // was interrupted, so everything before it is fine.
+    if (!ReadRecord(data, &offset, &pickle)) {
+      LOG(WARNING) << "Truncated cookie log.";
+      return false;
+    }
+    ++num_records_;
+
+    PickleIterator iter(*pickle);
+    int type;
+    int64 creation_utc;
+    if (!pickle->ReadInt(&iter, &type) ||
+        !pickle->ReadInt64(&iter, &creation_utc)) {
+      LOG(WARNING) << "Skipping unreadable cookie log record.";
+      continue;
+    }
+    switch (type) {
+      case RECORD_ADD: {
+        net::CanonicalCookie cc;
+        if (!ReadCookie(*pickle, &iter, creation_utc, &cc)) {
+          LOG(WARNING) << "Skipping unreadable cookie log record.";
+          continue;
+        }
+        cookies_by_creation_[creation_utc] = cc;
+        break;
+      }
+      case RECORD_UPDATE_ACCESS: {
+        int64 last_access_utc;
+        CookiesByCreationMap::iterator it =
+            cookies_by_creation_.find(creation_utc);
+        if (it != cookies_by_creation_.end() &&
+            pickle->ReadInt64(&iter, &last_access_utc)) {
+          it->second.SetLastAccessDate(
+              Time::FromInternalValue(last_access_utc));
+        }
+        break;
+      }
+      case RECORD_DELETE:
+        cookies_by_creation_.erase(creation_utc);
+        break;
+      default:
+        LOG(WARNING) << "Skipping unknown cookie log record.";
+        break;
+    }
+  }
+  return true;
+}
+
+void LogPersistentCookieStore::Backend::LoadCookies(
+    const std::vector<int64>& creation_times) {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  std::vector<net::CanonicalCookie*> cookies;
+  for (std::vector<int64>::const_iterator it = creation_times.begin();
+       it != creation_times.end(); ++it) {
+    CookiesByCreationMap::const_iterator cookie_it =
+        cookies_by_creation_.find(*it);
+    if (cookie_it == cookies_by_creation_.end())
+      continue;
+    DLOG_IF(WARNING, cookie_it->second.CreationDate() > Time::Now())
+        << "CreationDate too recent";
+    cookies.push_back(new net::CanonicalCookie(cookie_it->second));
+  }
+  {
+    base::AutoLock locked(lock_);
+    cookies_.insert(cookies_.end(), cookies.begin(), cookies.end());
+  }
+}
+
+void LogPersistentCookieStore::Backend::AddCookie(
+    const net::CanonicalCookie& cc) {
+  BatchOperation(PendingOperation::COOKIE_ADD, cc);
+}
+
+void LogPersistentCookieStore::Backend::UpdateCookieAccessTime(
+    const net::CanonicalCookie& cc) {
+  BatchOperation(PendingOperation::COOKIE_UPDATEACCESS, cc);
+}
+
+void LogPersistentCookieStore::Backend::DeleteCookie(
+    const net::CanonicalCookie& cc) {
+  BatchOperation(PendingOperation::COOKIE_DELETE, cc);
+}
+
+void LogPersistentCookieStore::Backend::BatchOperation(
+    PendingOperation::OperationType op,
+    const net::CanonicalCookie& cc) {
+  DCHECK(!background_task_runner_->RunsTasksOnCurrentThread());
+
+  // We do a full copy of the cookie here, and hopefully just here.
+  scoped_ptr<PendingOperation> po(new PendingOperation(op, cc));
+
+  PendingOperationsList::size_type num_pending;
+  {
+    base::AutoLock locked(lock_);
+    pending_.push_back(po.release());
+    num_pending = ++num_pending_;
+  }
+
+  if (num_pending == 1) {
+    // We've gotten our first entry for this batch, fire off the timer.
+    if (!background_task_runner_->PostDelayedTask(
+            FROM_HERE, base::Bind(&Backend::Commit, this),
+            base::TimeDelta::FromMilliseconds(kCommitIntervalMs))) {
+      NOTREACHED() << "background_task_runner_ is not running.";
+    }
+  } else if (num_pending == kCommitAfterBatchSize) {
+    // We've reached a big enough batch, fire off a commit now.
+    PostBackgroundTask(FROM_HERE, base::Bind(&Backend::Commit, this));
+  }
+}
+
+void LogPersistentCookieStore::Backend::Commit() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  PendingOperationsList ops;
+  {
+    base::AutoLock locked(lock_);
+    pending_.swap(ops);
+    num_pending_ = 0;
+  }
+
+  // As with SQLitePersistentCookieStore, operations which arrive before the
+  // cookies have been loaded are dropped.
+  if (!initialized_ || ops.empty()) {
+    STLDeleteElements(&ops);
+    return;
+  }
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::string records;
+  for (PendingOperationsList::iterator it = ops.begin();
+       it != ops.end(); ++it) {
+    // Free the cookies as we commit them to the log.
+    scoped_ptr<PendingOperation> po(*it);
+    const int64 creation_utc = po->cc().CreationDate().ToInternalValue();
+    switch (po->op()) {
+      case PendingOperation::COOKIE_ADD:
+        cookies_by_creation_[creation_utc] = po->cc();
+        AppendAddRecord(po->cc(), &records);
+        break;
+
+      case PendingOperation::COOKIE_UPDATEACCESS: {
+        CookiesByCreationMap::iterator cookie_it =
+            cookies_by_creation_.find(creation_utc);
+        if (cookie_it == cookies_by_creation_.end())
+          continue;
+        cookie_it->second.SetLastAccessDate(po->cc().LastAccessDate());
+        AppendUpdateAccessRecord(po->cc(), &records);
+        break;
+      }
+
+      case PendingOperation::COOKIE_DELETE:
+        if (!cookies_by_creation_.erase(creation_utc))
+          continue;
+        AppendDeleteRecord(po->cc(), &records);
+        break;
+
+      default:
+        NOTREACHED();
+        continue;
+    }
+    ++num_records_;
+  }
+
+  if (needs_compaction_ || ShouldCompact())
+    Compact();
+  else
+    AppendToLog(records);
+  UMA_HISTOGRAM_TIMES("Cookie.LogTimeCommit", base::TimeTicks::Now() - start);
+}
+
+void LogPersistentCookieStore::Backend::AppendToLog(
+    const std::string& records) {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+  DCHECK(!needs_compaction_);
+
+  if (records.empty())
+    return;
+
+  if (!file_.get())
+    file_.reset(file_util::OpenFile(path_, "ab"));
+  if (!file_.get() ||
+      fwrite(records.data(), 1, records.size(), file_.get()) !=
+          records.size() ||
+      fflush(file_.get()) != 0) {
+    // Part of |records| may have been written, so write the whole log out
+    // again with the next commit.
+    LOG(WARNING) << "Unable to append to the cookie log.";
+    file_.reset();
+    needs_compaction_ = true;
+  }
+}
+
+bool LogPersistentCookieStore::Backend::ShouldCompact() const {
+  size_t out_of_date = num_records_ - cookies_by_creation_.size();
+  return out_of_date > std::max(kMinRecordsToCompact,
+                                cookies_by_creation_.size());
+}
+
+void LogPersistentCookieStore::Backend::Compact() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::string data;
+  AppendHeaderRecord(&data);
+  for (CookiesByCreationMap::const_iterator it = cookies_by_creation_.begin();
+       it != cookies_by_creation_.end(); ++it) {
+    AppendAddRecord(it->second, &data);
+  }
+
+  file_.reset();
+  if (!base::ImportantFileWriter::WriteFileAtomically(path_, data)) {
+    LOG(WARNING) << "Unable to write the cookie log.";
+    needs_compaction_ = true;
+    return;
+  }
+  num_records_ = cookies_by_creation_.size();
+  needs_compaction_ = false;
+  UMA_HISTOGRAM_TIMES("Cookie.LogTimeCompact", base::TimeTicks::Now() - start);
+}
+
+void LogPersistentCookieStore::Backend::Flush(const base::Closure& callback) {
+  DCHECK(!background_task_runner_->RunsTasksOnCurrentThread());
+  PostBackgroundTask(FROM_HERE, base::Bind(&Backend::Commit, this));
+
+  if (!callback.is_null()) {
+    // We want the completion task to run immediately after Commit() returns.
+    // Posting it from here means there is less chance of another task getting
+    // onto the message queue first, than if we posted it from Commit() itself.
+    PostBackgroundTask(FROM_HERE, callback);
+  }
+}
+
+// Fire off a close message to the background runner.  We could still have a
+// pending commit timer or Load operations holding references on us, but
+// if/when this fires we will already have been cleaned up and it will be
+// ignored.
+void LogPersistentCookieStore::Backend::Close() {
+  if (background_task_runner_->RunsTasksOnCurrentThread()) {
+    InternalBackgroundClose();
+  } else {
+    // Must close the backend on the background runner.
+    PostBackgroundTask(FROM_HERE,
+                       base::Bind(&Backend::InternalBackgroundClose, this));
+  }
+}
+
+void LogPersistentCookieStore::Backend::InternalBackgroundClose() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+  // Commit any pending operations
+  Commit();
+
+  bool force_keep_session_state;
+  {
+    base::AutoLock locked(lock_);
+    force_keep_session_state = force_keep_session_state_;
+  }
+  if (!force_keep_session_state && special_storage_policy_.get() &&
+      special_storage_policy_->HasSessionOnlyOrigins()) {
+    DeleteSessionCookiesOnShutdown();
+  }
+
+  file_.reset();
+  // Later commits, which can only come from an old timer, are dropped.
+  initialized_ = false;
+}
+
+void LogPersistentCookieStore::Backend::DeleteSessionCookiesOnShutdown() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+
+  if (!initialized_)
+    return;
+
+  std::string records;
+  for (CookiesByCreationMap::iterator it = cookies_by_creation_.begin();
+       it != cookies_by_creation_.end(); ) {
+    const net::CanonicalCookie& cc = it->second;
+    const GURL url(net::cookie_util::CookieOriginToURL(cc.Domain(),
+                                                       cc.IsSecure()));
+    if (!url.is_valid() || !special_storage_policy_->IsStorageSessionOnly(url)) {
+      ++it;
+      continue;
+    }
+    AppendDeleteRecord(cc, &records);
+    ++num_records_;
+    cookies_by_creation_.erase(it++);
+  }
+
+  if (needs_compaction_ || ShouldCompact())
+    Compact();
+  else
+    AppendToLog(records);
+}
+
+void LogPersistentCookieStore::Backend::SetForceKeepSessionState() {
+  base::AutoLock locked(lock_);
+  force_keep_session_state_ = true;
+}
+
+void LogPersistentCookieStore::Backend::PostBackgroundTask(
+    const tracked_objects::Location& origin, const base::Closure& task) {
+  if (!background_task_runner_->PostTask(origin, task)) {
+    LOG(WARNING) << "Failed to post task from " << origin.ToString()
+                 << " to background_task_runner_.";
+  }
+}
+
+void LogPersistentCookieStore::Backend::PostClientTask(
+    const tracked_objects::Location& origin, const base::Closure& task) {
+  if (!client_task_runner_->PostTask(origin, task)) {
+    LOG(WARNING) << "Failed to post task from " << origin.ToString()
+                 << " to client_task_runner_.";
+  }
+}
+
+LogPersistentCookieStore::LogPersistentCookieStore(
+    const base::FilePath& path,
+    const scoped_refptr<base::SequencedTaskRunner>& client_task_runner,
+    const scoped_refptr<base::SequencedTaskRunner>& background_task_runner,
+    bool restore_old_session_cookies,
+    quota::SpecialStoragePolicy* special_storage_policy)
+    : backend_(new Backend(path,
+                           client_task_runner,
+                           background_task_runner,
+                           restore_old_session_cookies,
+                           special_storage_policy)) {
+}
+
+void LogPersistentCookieStore::Load(const LoadedCallback& loaded_callback) {
+  backend_->Load(loaded_callback);
+}
+
+void LogPersistentCookieStore::LoadCookiesForKey(
+    const std::string& key,
+    const LoadedCallback& loaded_callback) {
+  backend_->LoadCookiesForKey(key, loaded_callback);
+}
+
+void LogPersistentCookieStore::AddCookie(const net::CanonicalCookie& cc) {
+  backend_->AddCookie(cc);
+}
+
+void LogPersistentCookieStore::UpdateCookieAccessTime(
+    const net::CanonicalCookie& cc) {
+  backend_->UpdateCookieAccessTime(cc);
+}
+
+void LogPersistentCookieStore::DeleteCookie(const net::CanonicalCookie& cc) {
+  backend_->DeleteCookie(cc);
+}
+
+void LogPersistentCookieStore::SetForceKeepSessionState() {
+  backend_->SetForceKeepSessionState();
+}
+
+void LogPersistentCookieStore::Flush(const base::Closure& callback) {
+  backend_->Flush(callback);
+}
+
+LogPersistentCookieStore::~LogPersistentCookieStore() {
+  backend_->Close();
+  // We release our reference to the Backend, though it will probably still have
+  // a reference if the background runner has not run Close() yet.
+}
+
+}  // namespace content
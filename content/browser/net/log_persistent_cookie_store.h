@@ -0,0 +1,79 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A cookie monster persistent store which keeps the cookies in an append-only
+// log of binary records, rather than in a SQLite database.
+
+#ifndef CONTENT_BROWSER_NET_LOG_PERSISTENT_COOKIE_STORE_H_
+#define CONTENT_BROWSER_NET_LOG_PERSISTENT_COOKIE_STORE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback_forward.h"
+#include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "content/common/content_export.h"
+#include "net/cookies/cookie_monster.h"
+
+namespace base {
+class FilePath;
+class SequencedTaskRunner;
+}
+
+namespace net {
+class CanonicalCookie;
+}
+
+namespace quota {
+class SpecialStoragePolicy;
+}
+
+namespace content {
+
+// Implements the PersistentCookieStore interface in terms of a log file to
+// which each addition, access time update and deletion of a cookie is
+// appended as a record.  Committing a batch of operations is a single write
+// at the end of the file, and loading reads the file in one go, so both are
+// much cheaper than with SQLitePersistentCookieStore.  Once most of the log
+// describes cookies which have since been deleted or updated, it is
+// compacted by writing out the current cookies to a new file.
+//
+// The constructor arguments and the member functions behave as those of
+// SQLitePersistentCookieStore; see also the documentation of the parent class
+// |net::CookieMonster::PersistentCookieStore|.
+class CONTENT_EXPORT LogPersistentCookieStore
+    : public net::CookieMonster::PersistentCookieStore {
+ public:
+  LogPersistentCookieStore(
+      const base::FilePath& path,
+      const scoped_refptr<base::SequencedTaskRunner>& client_task_runner,
+      const scoped_refptr<base::SequencedTaskRunner>& background_task_runner,
+      bool restore_old_session_cookies,
+      quota::SpecialStoragePolicy* special_storage_policy);
+
+  // net::CookieMonster::PersistentCookieStore:
+  virtual void Load(const LoadedCallback& loaded_callback) OVERRIDE;
+  virtual void LoadCookiesForKey(const std::string& key,
+      const LoadedCallback& callback) OVERRIDE;
+  virtual void AddCookie(const net::CanonicalCookie& cc) OVERRIDE;
+  virtual void UpdateCookieAccessTime(const net::CanonicalCookie& cc) OVERRIDE;
+  virtual void DeleteCookie(const net::CanonicalCookie& cc) OVERRIDE;
+  virtual void SetForceKeepSessionState() OVERRIDE;
+  virtual void Flush(const base::Closure& callback) OVERRIDE;
+
+ protected:
+  virtual ~LogPersistentCookieStore();
+
+ private:
+  class Backend;
+
+  scoped_refptr<Backend> backend_;
+
+  DISALLOW_COPY_AND_ASSIGN(LogPersistentCookieStore);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_NET_LOG_PERSISTENT_COOKIE_STORE_H_
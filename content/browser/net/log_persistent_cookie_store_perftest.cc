@@ -0,0 +1,160 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/net/log_persistent_cookie_store.h"
+
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/perftimer.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/sequenced_worker_pool_owner.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace content {
+
+namespace {
+
+const base::FilePath::CharType cookie_filename[] =
+    FILE_PATH_LITERAL("Cookies.log");
+
+}  // namespace
+
+class LogPersistentCookieStorePerfTest : public testing::Test {
+ public:
+  LogPersistentCookieStorePerfTest()
+      : pool_owner_(new base::SequencedWorkerPoolOwner(1, "Background Pool")),
+        loaded_event_(false, false),
+        key_loaded_event_(false, false) {
+  }
+
+  void OnLoaded(const std::vector<net::CanonicalCookie*>& cookies) {
+    cookies_ = cookies;
+    loaded_event_.Signal();
+  }
+
+  void OnKeyLoaded(const std::vector<net::CanonicalCookie*>& cookies) {
+    cookies_ = cookies;
+    key_loaded_event_.Signal();
+  }
+
+  void Load() {
+    store_->Load(base::Bind(&LogPersistentCookieStorePerfTest::OnLoaded,
+                                base::Unretained(this)));
+    loaded_event_.Wait();
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> background_task_runner() {
+    return pool_owner_->pool()->GetSequencedTaskRunner(
+        pool_owner_->pool()->GetNamedSequenceToken("background"));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> client_task_runner() {
+    return pool_owner_->pool()->GetSequencedTaskRunner(
+        pool_owner_->pool()->GetNamedSequenceToken("client"));
+  }
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    store_ = new LogPersistentCookieStore(
+        temp_dir_.path().Append(cookie_filename),
+        client_task_runner(),
+        background_task_runner(),
+        false, NULL);
+    std::vector<net::CanonicalCookie*> cookies;
+    Load();
+    ASSERT_EQ(0u, cookies_.size());
+    // Creates 15000 cookies from 300 eTLD+1s.
+    base::Time t = base::Time::Now();
+    for (int domain_num = 0; domain_num < 300; domain_num++) {
+      std::string domain_name(base::StringPrintf(".domain_%d.com", domain_num));
+      GURL gurl("www" + domain_name);
+      for (int cookie_num = 0; cookie_num < 50; ++cookie_num) {
+        t += base::TimeDelta::FromInternalValue(10);
+        store_->AddCookie(
+            net::CanonicalCookie(gurl,
+                base::StringPrintf("Cookie_%d", cookie_num), "1",
+                domain_name, "/", t, t, t, false, false,
+                net::COOKIE_PRIORITY_DEFAULT));
+      }
+    }
+    // Replace the store effectively destroying the current one and forcing it
+    // to write its data to disk.
+    store_ = NULL;
+
+    // Shut down the pool, causing deferred (no-op) commits to be discarded.
+    pool_owner_->pool()->Shutdown();
+    // ~SequencedWorkerPoolOwner blocks on pool shutdown.
+    pool_owner_.reset(new base::SequencedWorkerPoolOwner(1, "pool"));
+
+    store_ = new LogPersistentCookieStore(
+        temp_dir_.path().Append(cookie_filename),
+        client_task_runner(),
+        background_task_runner(),
+        false, NULL);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    store_ = NULL;
+    pool_owner_->pool()->Shutdown();
+  }
+
+ protected:
+  scoped_ptr<base::SequencedWorkerPoolOwner> pool_owner_;
+  base::WaitableEvent loaded_event_;
+  base::WaitableEvent key_loaded_event_;
+  std::vector<net::CanonicalCookie*> cookies_;
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<LogPersistentCookieStore> store_;
+};
+
+// Test the performance of priority load of cookies for a specfic domain key
+TEST_F(LogPersistentCookieStorePerfTest, TestLoadForKeyPerformance) {
+  for (int domain_num = 0; domain_num < 3; ++domain_num) {
+    std::string domain_name(base::StringPrintf("domain_%d.com", domain_num));
+    PerfTimeLogger timer(
+      ("Load cookies for the eTLD+1 " + domain_name).c_str());
+    store_->LoadCookiesForKey(domain_name,
+      base::Bind(&LogPersistentCookieStorePerfTest::OnKeyLoaded,
+                 base::Unretained(this)));
+    key_loaded_event_.Wait();
+    timer.Done();
+
+    ASSERT_EQ(50U, cookies_.size());
+  }
+}
+
+// Test the performance of load
+TEST_F(LogPersistentCookieStorePerfTest, TestLoadPerformance) {
+  PerfTimeLogger timer("Load all cookies");
+  Load();
+  timer.Done();
+
+  ASSERT_EQ(15000U, cookies_.size());
+}
+
+// Test the performance of committing a batch of access time updates.
+TEST_F(LogPersistentCookieStorePerfTest, TestCommitPerformance) {
+  Load();
+  ASSERT_EQ(15000U, cookies_.size());
+
+  base::WaitableEvent flushed_event(false, false);
+  PerfTimeLogger timer("Commit 15000 access time updates");
+  for (size_t i = 0; i < cookies_.size(); ++i) {
+    cookies_[i]->SetLastAccessDate(base::Time::Now());
+    store_->UpdateCookieAccessTime(*cookies_[i]);
+  }
+  store_->Flush(base::Bind(&base::WaitableEvent::Signal,
+                           base::Unretained(&flushed_event)));
+  flushed_event.Wait();
+  timer.Done();
+}
+
+}  // namespace content
@@ -0,0 +1,451 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/net/log_persistent_cookie_store.h"
+
+#include <map>
+#include <set>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/sequenced_worker_pool_owner.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "base/time/time.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace content {
+
+namespace {
+
+const base::FilePath::CharType kCookieFilename[] =
+    FILE_PATH_LITERAL("Cookies.log");
+
+}  // namespace
+
+typedef std::vector<net::CanonicalCookie*> CanonicalCookieVector;
+
+class LogPersistentCookieStoreTest : public testing::Test {
+ public:
+  LogPersistentCookieStoreTest()
+      : pool_owner_(new base::SequencedWorkerPoolOwner(3, "Background Pool")),
+        loaded_event_(false, false),
+        key_loaded_event_(false, false),
+        db_thread_event_(false, false) {
+  }
+
+  void OnLoaded(const CanonicalCookieVector& cookies) {
+    cookies_ = cookies;
+    loaded_event_.Signal();
+  }
+
+  void OnKeyLoaded(const CanonicalCookieVector& cookies) {
+    cookies_ = cookies;
+    key_loaded_event_.Signal();
+  }
+
+  void Load(CanonicalCookieVector* cookies) {
+    EXPECT_FALSE(loaded_event_.IsSignaled());
+    store_->Load(base::Bind(&LogPersistentCookieStoreTest::OnLoaded,
+                            base::Unretained(this)));
+    loaded_event_.Wait();
+    *cookies = cookies_;
+  }
+
+  void Flush() {
+    base::WaitableEvent event(false, false);
+    store_->Flush(base::Bind(&base::WaitableEvent::Signal,
+                             base::Unretained(&event)));
+    event.Wait();
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> background_task_runner() {
+    return pool_owner_->pool()->GetSequencedTaskRunner(
+        pool_owner_->pool()->GetNamedSequenceToken("background"));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> client_task_runner() {
+    return pool_owner_->pool()->GetSequencedTaskRunner(
+        pool_owner_->pool()->GetNamedSequenceToken("client"));
+  }
+
+  base::FilePath log_path() const {
+    return temp_dir_.path().Append(kCookieFilename);
+  }
+
+  int64 LogSize() {
+    int64 size = 0;
+    EXPECT_TRUE(file_util::GetFileSize(log_path(), &size));
+    return size;
+  }
+
+  void DestroyStore() {
+    store_ = NULL;
+    // Make sure we wait until the destructor has run by shutting down the pool
+    // resetting the owner (whose destructor blocks on the pool completion).
+    pool_owner_->pool()->Shutdown();
+    // Create a new pool for the few tests that create multiple stores. In other
+    // cases this is wasted but harmless.
+    pool_owner_.reset(new base::SequencedWorkerPoolOwner(3, "Background Pool"));
+  }
+
+  void CreateAndLoad(bool restore_old_session_cookies,
+                     CanonicalCookieVector* cookies) {
+    store_ = new LogPersistentCookieStore(
+        log_path(),
+        client_task_runner(),
+        background_task_runner(),
+        restore_old_session_cookies,
+        NULL);
+    Load(cookies);
+  }
+
+  void InitializeStore(bool restore_old_session_cookies) {
+    CanonicalCookieVector cookies;
+    CreateAndLoad(restore_old_session_cookies, &cookies);
+    EXPECT_EQ(0U, cookies.size());
+  }
+
+  // We have to create this method to wrap WaitableEvent::Wait, since we cannot
+  // bind a non-void returning method as a Closure.
+  void WaitOnDBEvent() {
+    db_thread_event_.Wait();
+  }
+
+  // Adds a persistent cookie to store_.
+  void AddCookie(const std::string& name,
+                 const std::string& value,
+                 const std::string& domain,
+                 const std::string& path,
+                 const base::Time& creation) {
+    store_->AddCookie(
+        net::CanonicalCookie(GURL(), name, value, domain, path, creation,
+                             creation, creation, false, false,
+                             net::COOKIE_PRIORITY_DEFAULT));
+  }
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  virtual void TearDown() OVERRIDE {
+    DestroyStore();
+    pool_owner_->pool()->Shutdown();
+  }
+
+ protected:
+  base::MessageLoop main_loop_;
+  scoped_ptr<base::SequencedWorkerPoolOwner> pool_owner_;
+  base::WaitableEvent loaded_event_;
+  base::WaitableEvent key_loaded_event_;
+  base::WaitableEvent db_thread_event_;
+  CanonicalCookieVector cookies_;
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<LogPersistentCookieStore> store_;
+};
+
+// Test if data is stored as expected in the log.
+TEST_F(LogPersistentCookieStoreTest, TestPersistance) {
+  InitializeStore(false);
+  AddCookie("A", "B", "foo.bar", "/", base::Time::Now());
+  // Replace the store effectively destroying the current one and forcing it
+  // to write its data to disk. Then we can see if after loading it again it
+  // is still there.
+  DestroyStore();
+  // Reload and test for persistence
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  ASSERT_STREQ("foo.bar", cookies[0]->Domain().c_str());
+  ASSERT_STREQ("A", cookies[0]->Name().c_str());
+  ASSERT_STREQ("B", cookies[0]->Value().c_str());
+
+  // Update its access time, and check that it's persisted.
+  base::Time last_access =
+      cookies[0]->LastAccessDate() + base::TimeDelta::FromMinutes(1);
+  cookies[0]->SetLastAccessDate(last_access);
+  store_->UpdateCookieAccessTime(*cookies[0]);
+  DestroyStore();
+  STLDeleteElements(&cookies);
+
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(last_access, cookies[0]->LastAccessDate());
+
+  // Now delete the cookie and check persistence again.
+  store_->DeleteCookie(*cookies[0]);
+  DestroyStore();
+  STLDeleteElements(&cookies);
+
+  // Reload and check if the cookie has been removed.
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(0U, cookies.size());
+}
+
+// Test that priority load of cookies for a specfic domain key is completed
+// before the rest of the store is.
+TEST_F(LogPersistentCookieStoreTest, TestLoadCookiesForKey) {
+  InitializeStore(false);
+  base::Time t = base::Time::Now();
+  AddCookie("A", "B", "foo.bar", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  AddCookie("A", "B", "www.aaa.com", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  AddCookie("A", "B", "travel.aaa.com", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  AddCookie("A", "B", "www.bbb.com", "/", t);
+  DestroyStore();
+
+  store_ = new LogPersistentCookieStore(
+      log_path(), client_task_runner(), background_task_runner(), false, NULL);
+  // Posting a blocking task to db_thread_ makes sure that the DB thread waits
+  // until LoadCookiesForKey has been posted to its task queue.
+  background_task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(&LogPersistentCookieStoreTest::WaitOnDBEvent,
+                 base::Unretained(this)));
+  store_->LoadCookiesForKey("aaa.com",
+    base::Bind(&LogPersistentCookieStoreTest::OnKeyLoaded,
+               base::Unretained(this)));
+  db_thread_event_.Signal();
+  key_loaded_event_.Wait();
+  std::set<std::string> cookies_loaded;
+  for (CanonicalCookieVector::const_iterator it = cookies_.begin();
+       it != cookies_.end();
+       ++it) {
+    cookies_loaded.insert((*it)->Domain().c_str());
+  }
+  STLDeleteElements(&cookies_);
+  ASSERT_EQ(2U, cookies_loaded.size());
+  ASSERT_EQ(true, cookies_loaded.find("www.aaa.com") != cookies_loaded.end());
+  ASSERT_EQ(true,
+            cookies_loaded.find("travel.aaa.com") != cookies_loaded.end());
+
+  // Load only passes the cookies which haven't been loaded yet.
+  CanonicalCookieVector cookies;
+  Load(&cookies);
+  ASSERT_EQ(2U, cookies.size());
+  for (CanonicalCookieVector::const_iterator it = cookies.begin();
+       it != cookies.end();
+       ++it) {
+    cookies_loaded.insert((*it)->Domain().c_str());
+  }
+  ASSERT_EQ(4U, cookies_loaded.size());
+  ASSERT_EQ(cookies_loaded.find("foo.bar") != cookies_loaded.end(),
+            true);
+  ASSERT_EQ(cookies_loaded.find("www.bbb.com") != cookies_loaded.end(), true);
+  STLDeleteElements(&cookies);
+}
+
+// Test that we can force the log to be written by calling Flush().
+TEST_F(LogPersistentCookieStoreTest, TestFlush) {
+  InitializeStore(false);
+  Flush();
+  int64 base_size = LogSize();
+
+  // Write some large cookies, so the log will grow by several KB.
+  for (char c = 'a'; c < 'z'; ++c) {
+    // Each cookie needs a unique creation time, which identifies it.
+    base::Time t = base::Time::Now() + base::TimeDelta::FromMicroseconds(c);
+    std::string name(1, c);
+    std::string value(1000, c);
+    AddCookie(name, value, "foo.bar", "/", t);
+  }
+
+  Flush();
+
+  // We forced a write, so now the file will be bigger.
+  ASSERT_GT(LogSize(), base_size);
+}
+
+// Test that once most of the log describes deleted cookies, it's compacted.
+TEST_F(LogPersistentCookieStoreTest, TestCompaction) {
+  InitializeStore(false);
+  base::Time t = base::Time::Now();
+  AddCookie("A", "B", "foo.bar", "/", t);
+  Flush();
+  int64 one_cookie_size = LogSize();
+
+  // Measure the records for adding and deleting a cookie.
+  net::CanonicalCookie cc(GURL(), "C", "D", "foo.bar", "/",
+                          t + base::TimeDelta::FromMicroseconds(1), t, t,
+                          false, false, net::COOKIE_PRIORITY_DEFAULT);
+  store_->AddCookie(cc);
+  store_->DeleteCookie(cc);
+  Flush();
+  int64 pair_size = LogSize() - one_cookie_size;
+  ASSERT_GT(pair_size, 0);
+
+  const int kPairs = 2000;
+  for (int i = 2; i < kPairs; ++i) {
+    net::CanonicalCookie cc(GURL(), "C", "D", "foo.bar", "/",
+                            t + base::TimeDelta::FromMicroseconds(i), t, t,
+                            false, false, net::COOKIE_PRIORITY_DEFAULT);
+    store_->AddCookie(cc);
+    store_->DeleteCookie(cc);
+  }
+  Flush();
+  // Without compaction the log would hold every pair; with it, at most the
+  // last kMinRecordsToCompact records remain.
+  EXPECT_LT(LogSize(), one_cookie_size + pair_size * kPairs / 2);
+
+  DestroyStore();
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  ASSERT_STREQ("A", cookies[0]->Name().c_str());
+  STLDeleteElements(&cookies);
+}
+
+// Test that a record cut short, such as by a crash while it was written, only
+// loses that record.
+TEST_F(LogPersistentCookieStoreTest, TestTruncatedLog) {
+  InitializeStore(false);
+  base::Time t = base::Time::Now();
+  AddCookie("A", "B", "foo.bar", "/", t);
+  Flush();
+  int64 one_cookie_size = LogSize();
+  AddCookie("C", "D", "foo.bar", "/", t + base::TimeDelta::FromMicroseconds(1));
+  DestroyStore();
+
+  std::string data;
+  ASSERT_TRUE(file_util::ReadFileToString(log_path(), &data));
+  data.resize(data.size() - 1);
+  ASSERT_EQ(static_cast<int>(data.size()),
+            file_util::WriteFile(log_path(), data.data(), data.size()));
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  ASSERT_STREQ("A", cookies[0]->Name().c_str());
+  STLDeleteElements(&cookies);
+
+  // The partial record is dropped from the log, so records can be appended
+  // to it again.
+  Flush();
+  EXPECT_EQ(one_cookie_size, LogSize());
+  AddCookie("E", "F", "foo.bar", "/", t + base::TimeDelta::FromMicroseconds(2));
+  DestroyStore();
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(2U, cookies.size());
+  STLDeleteElements(&cookies);
+}
+
+// Test that a file which isn't a cookie log is replaced by an empty log.
+TEST_F(LogPersistentCookieStoreTest, TestUnrecognizedLog) {
+  const char kGarbage[] = "This is not a cookie log.";
+  ASSERT_EQ(static_cast<int>(arraysize(kGarbage)),
+            file_util::WriteFile(log_path(), kGarbage, arraysize(kGarbage)));
+
+  InitializeStore(false);
+  AddCookie("A", "B", "foo.bar", "/", base::Time::Now());
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  ASSERT_STREQ("A", cookies[0]->Name().c_str());
+  STLDeleteElements(&cookies);
+}
+
+// Test loading old session cookies from the disk.
+TEST_F(LogPersistentCookieStoreTest, TestLoadOldSessionCookies) {
+  InitializeStore(true);
+
+  // Add a session cookie.
+  store_->AddCookie(
+      net::CanonicalCookie(
+          GURL(), "C", "D", "sessioncookie.com", "/", base::Time::Now(),
+          base::Time(), base::Time::Now(), false, false,
+          net::COOKIE_PRIORITY_DEFAULT));
+
+  // Force the store to write its data to the disk.
+  DestroyStore();
+
+  // Create a store that loads session cookies and test that the session cookie
+  // was loaded.
+  CanonicalCookieVector cookies;
+  CreateAndLoad(true, &cookies);
+
+  ASSERT_EQ(1U, cookies.size());
+  ASSERT_STREQ("sessioncookie.com", cookies[0]->Domain().c_str());
+  ASSERT_STREQ("C", cookies[0]->Name().c_str());
+  ASSERT_STREQ("D", cookies[0]->Value().c_str());
+  ASSERT_FALSE(cookies[0]->IsPersistent());
+
+  STLDeleteElements(&cookies);
+}
+
+// Test not loading old session cookies from the disk.
+TEST_F(LogPersistentCookieStoreTest, TestDontLoadOldSessionCookies) {
+  InitializeStore(true);
+
+  // Add a session cookie.
+  store_->AddCookie(
+      net::CanonicalCookie(
+          GURL(), "C", "D", "sessioncookie.com", "/", base::Time::Now(),
+          base::Time(), base::Time::Now(), false, false,
+          net::COOKIE_PRIORITY_DEFAULT));
+
+  // Force the store to write its data to the disk.
+  DestroyStore();
+
+  // Create a store that doesn't load old session cookies and test that the
+  // session cookie was not loaded.
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(0U, cookies.size());
+
+  // The store should also delete the session cookie. Wait until that has been
+  // done.
+  DestroyStore();
+
+  // Create a store that loads old session cookies and test that the session
+  // cookie is gone.
+  CreateAndLoad(true, &cookies);
+  ASSERT_EQ(0U, cookies.size());
+}
+
+TEST_F(LogPersistentCookieStoreTest, AttributesArePersistent) {
+  InitializeStore(true);
+  base::Time creation = base::Time::Now() - base::TimeDelta::FromMinutes(1);
+  base::Time expiry = base::Time::Now() + base::TimeDelta::FromDays(1);
+  base::Time last_access = base::Time::Now();
+  store_->AddCookie(
+      net::CanonicalCookie(
+          GURL(), "name", "value", ".example.com", "/path", creation, expiry,
+          last_access, true, true, net::COOKIE_PRIORITY_HIGH));
+
+  // Force the store to write its data to the disk.
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(true, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  const net::CanonicalCookie* cc = cookies[0];
+  EXPECT_EQ("name", cc->Name());
+  EXPECT_EQ("value", cc->Value());
+  EXPECT_EQ(".example.com", cc->Domain());
+  EXPECT_EQ("/path", cc->Path());
+  EXPECT_EQ(creation, cc->CreationDate());
+  EXPECT_EQ(expiry, cc->ExpiryDate());
+  EXPECT_EQ(last_access, cc->LastAccessDate());
+  EXPECT_TRUE(cc->IsSecure());
+  EXPECT_TRUE(cc->IsHttpOnly());
+  EXPECT_EQ(net::COOKIE_PRIORITY_HIGH, cc->Priority());
+
+  STLDeleteElements(&cookies);
+}
+
+}  // namespace content
@@ -88,6 +88,28 @@ void AddressList::SetDefaultCanonicalName() {
   set_canonical_name(front().ToStringWithoutPort());
 }
 
+void AddressList::InterleaveAddressFamilies() {
+  if (size() < 3)
+    return;
+  AddressFamily first_family = front().GetFamily();
+  std::vector<IPEndPoint> first;
+  std::vector<IPEndPoint> second;
+  for (const_iterator it = begin(); it != end(); ++it) {
+    if (it->GetFamily() == first_family)
+      first.push_back(*it);
+    else
+      second.push_back(*it);
+  }
+
+  clear();
+  for (size_t i = 0; i < first.size() || i < second.size(); ++i) {
+    if (i < first.size())
+      push_back(first[i]);
+    if (i < second.size())
+      push_back(second[i]);
+  }
+}
+
 NetLog::ParametersCallback AddressList::CreateNetLogCallback() const {
   return base::Bind(&NetLogAddressListCallback, this);
 }
@@ -53,6 +53,12 @@ class NET_EXPORT AddressList
   // Sets canonical name to the literal of the first IP address on the list.
   void SetDefaultCanonicalName();
 
+  // Reorders the list so that address families alternate, starting with the
+  // family of the first address, while preserving the relative order within
+  // each family. Used to spread connection attempts across families as
+  // described in RFC 6555 ("Happy Eyeballs").
+  void InterleaveAddressFamilies();
+
   // Creates a callback for use with the NetLog that returns a Value
   // representation of the address list.  The callback must be destroyed before
   // |this| is.
@@ -4,6 +4,8 @@
 
 #include "net/base/address_list.h"
 
+#include <algorithm>
+
 #include "base/strings/string_util.h"
 #include "base/sys_byteorder.h"
 #include "net/base/net_util.h"
@@ -134,5 +136,39 @@ TEST(AddressListTest, CreateFromIPAddressList) {
   EXPECT_EQ(ARRAYSIZE_UNSAFE(tests), test_list.size());
 }
 
+TEST(AddressListTest, InterleaveAddressFamilies) {
+  const char* const kAddresses[] = {
+    "2001:db8::1", "2001:db8::2", "2001:db8::3", "192.168.1.1", "192.168.1.2",
+  };
+  // Indices into |kAddresses| in the expected order.
+  const size_t kExpectedOrder[] = { 0, 3, 1, 4, 2 };
+
+  AddressList list;
+  for (size_t i = 0; i < arraysize(kAddresses); ++i) {
+    IPAddressNumber ip_number;
+    ASSERT_TRUE(ParseIPLiteralToNumber(kAddresses[i], &ip_number));
+    list.push_back(IPEndPoint(ip_number, 80));
+  }
+  list.set_canonical_name("canonical.example.com");
+
+  list.InterleaveAddressFamilies();
+  ASSERT_EQ(arraysize(kExpectedOrder), list.size());
+  for (size_t i = 0; i < arraysize(kExpectedOrder); ++i) {
+    EXPECT_EQ(kAddresses[kExpectedOrder[i]], list[i].ToStringWithoutPort())
+        << i;
+    EXPECT_EQ(80, list[i].port());
+  }
+  EXPECT_EQ("canonical.example.com", list.canonical_name());
+
+  // A list which starts with IPv4 stays IPv4 first.
+  std::rotate(list.begin(), list.begin() + 1, list.end());
+  list.InterleaveAddressFamilies();
+  EXPECT_EQ("192.168.1.1", list[0].ToStringWithoutPort());
+  EXPECT_EQ("2001:db8::2", list[1].ToStringWithoutPort());
+  EXPECT_EQ("192.168.1.2", list[2].ToStringWithoutPort());
+  EXPECT_EQ("2001:db8::3", list[3].ToStringWithoutPort());
+  EXPECT_EQ("2001:db8::1", list[4].ToStringWithoutPort());
+}
+
 }  // namespace
 }  // namespace net
@@ -8,6 +8,7 @@
 #include "base/strings/string_util.h"
 #include "net/base/gzip_filter.h"
 #include "net/base/io_buffer.h"
+#include "net/base/lzma_filter.h"
 #include "net/base/mime_util.h"
 #include "net/base/sdch_filter.h"
 
@@ -18,6 +19,7 @@ const char kDeflate[]      = "deflate";
 const char kGZip[]         = "gzip";
 const char kXGZip[]        = "x-gzip";
 const char kSdch[]         = "sdch";
+const char kLzma[]         = "lzma";
 // compress and x-compress are currently not supported.  If we decide to support
 // them, we'll need the same mime type compatibility hack we have for gzip.  For
 // more information, see Firefox's nsHttpChannel::ProcessNormal.
@@ -41,6 +43,9 @@ const int kFilterBufSize = 32 * 1024;
 
 namespace net {
 
+// static
+bool Filter::g_lzma_encoding_enabled_ = false;
+
 FilterContext::~FilterContext() {
 }
 
@@ -148,6 +153,8 @@ Filter::FilterType Filter::ConvertEncodingToType(
     type_id = FILTER_TYPE_GZIP;
   } else if (LowerCaseEqualsASCII(filter_type, kSdch)) {
     type_id = FILTER_TYPE_SDCH;
+  } else if (LowerCaseEqualsASCII(filter_type, kLzma)) {
+    type_id = FILTER_TYPE_LZMA;
   } else {
     // Note we also consider "identity" and "uncompressed" UNSUPPORTED as
     // filter should be disabled in such cases.
@@ -317,6 +324,11 @@ void Filter::FixupEncodingTypes(
   return;
 }
 
+// static
+void Filter::EnableLzmaEncoding(bool enabled) {
+  g_lzma_encoding_enabled_ = enabled;
+}
+
 Filter::Filter()
     : stream_buffer_(NULL),
       stream_buffer_size_(0),
@@ -361,6 +373,13 @@ Filter* Filter::InitSdchFilter(FilterType type_id,
   return sdch_filter->InitDecoding(type_id) ? sdch_filter.release() : NULL;
 }
 
+// static
+Filter* Filter::InitLzmaFilter(FilterType type_id, int buffer_size) {
+  scoped_ptr<LzmaFilter> lzma_filter(new LzmaFilter());
+  lzma_filter->InitBuffer(buffer_size);
+  return lzma_filter->InitDecoding(type_id) ? lzma_filter.release() : NULL;
+}
+
 // static
 Filter* Filter::PrependNewFilter(FilterType type_id,
                                  const FilterContext& filter_context,
@@ -377,6 +396,9 @@ Filter* Filter::PrependNewFilter(FilterType type_id,
     case FILTER_TYPE_SDCH_POSSIBLE:
       first_filter.reset(InitSdchFilter(type_id, filter_context, buffer_size));
       break;
+    case FILTER_TYPE_LZMA:
+      first_filter.reset(InitLzmaFilter(type_id, buffer_size));
+      break;
     default:
       break;
   }
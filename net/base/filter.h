@@ -125,6 +125,7 @@ class NET_EXPORT_PRIVATE Filter {
     FILTER_TYPE_GZIP_HELPING_SDCH,  // Gzip possible, but pass through allowed.
     FILTER_TYPE_SDCH,
     FILTER_TYPE_SDCH_POSSIBLE,  // Sdch possible, but pass through allowed.
+    FILTER_TYPE_LZMA,
     FILTER_TYPE_UNSUPPORTED,
   };
 
@@ -196,8 +197,15 @@ class NET_EXPORT_PRIVATE Filter {
   static void FixupEncodingTypes(const FilterContext& filter_context,
                                  std::vector<FilterType>* encoding_types);
 
+  // Enables or disables advertising "lzma" in Accept-Encoding.  Responses
+  // encoded with lzma are decoded either way.  Disabled by default.
+  static void EnableLzmaEncoding(bool enabled);
+
+  static bool lzma_encoding_enabled() { return g_lzma_encoding_enabled_; }
+
  protected:
   friend class GZipUnitTest;
+  friend class LzmaFilterTest;
   friend class SdchFilterChainingTest;
 
   Filter();
@@ -252,6 +260,7 @@ class NET_EXPORT_PRIVATE Filter {
   static Filter* InitSdchFilter(FilterType type_id,
                                 const FilterContext& filter_context,
                                 int buffer_size);
+  static Filter* InitLzmaFilter(FilterType type_id, int buffer_size);
 
   // Helper function to empty our output into the next filter's input.
   void PushDataIntoNextFilter();
@@ -268,6 +277,8 @@ class NET_EXPORT_PRIVATE Filter {
   // chained filters.
   FilterStatus last_status_;
 
+  static bool g_lzma_encoding_enabled_;
+
   DISALLOW_COPY_AND_ASSIGN(Filter);
 };
 
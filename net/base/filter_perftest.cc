@@ -0,0 +1,246 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/strings/stringprintf.h"
+#include "net/base/filter.h"
+#include "net/base/io_buffer.h"
+#include "net/base/lzma_filter.h"
+#include "net/base/mock_filter_context.h"
+#include "net/base/sdch_manager.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+extern "C" {
+#include "third_party/lzma_sdk/LzmaEnc.h"
+}
+
+namespace net {
+
+namespace {
+
+const int kResponseSizes[] = { 1024, 16 * 1024, 256 * 1024, 1024 * 1024 };
+const int kBytesPerSize = 64 * 1024 * 1024;
+const int kReadBufferSize = 32 * 1024;
+
+// Dictionary sizes for the SDCH setup benchmark, up to the largest the
+// SdchManager accepts.
+const size_t kSdchDictionarySizes[] = { 1024, 64 * 1024, 900 * 1024 };
+const int kSdchResponses = 20000;
+
+// A VCDIFF dictionary, and a response encoded against it which only refers to
+// its first 77 bytes, so that the dictionary can be padded to any size.  The
+// same data as in sdch_filter_unittest.cc.
+const char kVcdiffDictionary[] = "DictionaryFor"
+    "SdchCompression1SdchCompression2SdchCompression3SdchCompression\n";
+const char kVcdiffResponse[] =
+    "\326\303\304\0\0\001M\0\201S\202\004\0\201E\006\001"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000"
+    "TestData 00000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000\n\001S\023\077\001r\r";
+const int kVcdiffResponseDecodedSize = 260;
+
+void* LzmaAlloc(void* p, size_t size) {
+  return malloc(size);
+}
+
+void LzmaFree(void* p, void* address) {
+  free(address);
+}
+
+ISzAlloc g_lzma_alloc = { LzmaAlloc, LzmaFree };
+
+// Returns |size| bytes of text, compressible about as well as typical HTML.
+std::string MakeResponseBody(int size) {
+  static const char* const kWords[] = {
+    "<div", "class=", "\"item\">", "<a", "href=", "\"/index.html\"", "</a>",
+    "</div>", "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+  };
+  std::string body;
+  uint32 seed = 1;
+  while (static_cast<int>(body.size()) < size) {
+    seed = seed * 1103515245 + 12345;
+    body += kWords[(seed >> 16) % arraysize(kWords)];
+    body += ' ';
+  }
+  body.resize(size);
+  return body;
+}
+
+std::string GZipCompress(const std::string& input) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  // Adding 16 to the window bits writes a gzip header and trailer.
+  CHECK_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                              MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY));
+  std::string output(deflateBound(&stream, input.size()) + 32, '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream.avail_in = input.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  stream.avail_out = output.size();
+  CHECK_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+  return output;
+}
+
+// Returns |input| in the .lzma format, with its size in the header.
+std::string LzmaCompress(const std::string& input) {
+  CLzmaEncProps props;
+  LzmaEncProps_Init(&props);
+  props.dictSize = 1 << 20;
+
+  std::string output(input.size() + input.size() / 2 + 1024, '\0');
+  Byte* header = reinterpret_cast<Byte*>(&output[0]);
+  SizeT props_size = LZMA_PROPS_SIZE;
+  SizeT out_len = output.size() - LzmaFilter::kHeaderSize;
+  CHECK_EQ(SZ_OK, LzmaEncode(header + LzmaFilter::kHeaderSize, &out_len,
+                             reinterpret_cast<const Byte*>(input.data()),
+                             input.size(), &props, header, &props_size, 0,
+                             NULL, &g_lzma_alloc, &g_lzma_alloc));
+  uint64 size = input.size();
+  for (int i = LZMA_PROPS_SIZE; i < LzmaFilter::kHeaderSize; ++i) {
+    header[i] = static_cast<Byte>(size);
+    size >>= 8;
+  }
+  output.resize(LzmaFilter::kHeaderSize + out_len);
+  return output;
+}
+
+// Decodes |compressed| with a new filter, feeding it the way URLRequestJob
+// does, and returns the number of bytes decoded.
+int DecodeResponseWithContext(
+    const std::vector<Filter::FilterType>& filter_types,
+    const FilterContext& filter_context,
+    const std::string& compressed,
+    IOBuffer* read_buffer) {
+  scoped_ptr<Filter> filter(Filter::Factory(filter_types, filter_context));
+  int decoded = 0;
+  size_t offset = 0;
+  bool needs_more_output_space = false;
+  Filter::FilterStatus status = Filter::FILTER_NEED_MORE_DATA;
+  while (status != Filter::FILTER_DONE) {
+    if (status == Filter::FILTER_NEED_MORE_DATA && !needs_more_output_space) {
+      if (offset == compressed.size())
+        break;
+      int len = std::min(static_cast<int>(compressed.size() - offset),
+                         filter->stream_buffer_size());
+      memcpy(filter->stream_buffer()->data(), compressed.data() + offset, len);
+      filter->FlushStreamBuffer(len);
+      offset += len;
+    }
+    int read_len = kReadBufferSize;
+    status = filter->ReadData(read_buffer->data(), &read_len);
+    if (status == Filter::FILTER_ERROR)
+      return -1;
+    decoded += read_len;
+    needs_more_output_space = read_len == kReadBufferSize;
+  }
+  return decoded;
+}
+
+int DecodeResponse(const std::vector<Filter::FilterType>& filter_types,
+                   const std::string& compressed,
+                   IOBuffer* read_buffer) {
+  MockFilterContext filter_context;
+  return DecodeResponseWithContext(filter_types, filter_context, compressed,
+                                   read_buffer);
+}
+
+void RunDecodeBenchmark(const std::string& name,
+                        Filter::FilterType filter_type,
+                        std::string (*compress)(const std::string&)) {
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(filter_type);
+  scoped_refptr<IOBuffer> read_buffer(new IOBuffer(kReadBufferSize));
+  for (size_t i = 0; i < arraysize(kResponseSizes); ++i) {
+    const int size = kResponseSizes[i];
+    const std::string compressed = compress(MakeResponseBody(size));
+    const int responses = kBytesPerSize / size;
+
+    PerfTimer timer;
+    for (int j = 0; j < responses; ++j) {
+      ASSERT_EQ(size,
+                DecodeResponse(filter_types, compressed, read_buffer.get()));
+    }
+    double seconds = timer.Elapsed().InSecondsF();
+
+    LogPerfResult(
+        base::StringPrintf("%s_decode_%d_bytes", name.c_str(), size).c_str(),
+        static_cast<double>(responses) * size / seconds / 1048576, "MB/s");
+    LogPerfResult(
+        base::StringPrintf("%s_decode_%d_bytes_responses", name.c_str(),
+                           size).c_str(),
+        responses / seconds, "responses/s");
+    LogPerfResult(
+        base::StringPrintf("%s_%d_bytes_compressed_size", name.c_str(),
+                           size).c_str(),
+        compressed.size(), "bytes");
+  }
+}
+
+// Measures how many small SDCH responses can be set up and decoded per
+// second, for each dictionary size.  The responses are tiny, so this is
+// dominated by finding the dictionary and starting the VCDIFF decoder.
+void RunSdchSetupBenchmark() {
+  SdchManager sdch_manager;
+  const std::string kDomain = "sdchtest.com";
+  const GURL url("http://" + kDomain);
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(Filter::FILTER_TYPE_SDCH);
+  MockFilterContext filter_context;
+  filter_context.SetURL(url);
+  scoped_refptr<IOBuffer> read_buffer(new IOBuffer(kReadBufferSize));
+
+  for (size_t i = 0; i < arraysize(kSdchDictionarySizes); ++i) {
+    std::string dictionary("Domain: " + kDomain + "\n\n");
+    dictionary.append(kVcdiffDictionary);
+    dictionary.resize(kSdchDictionarySizes[i], ' ');
+    ASSERT_TRUE(sdch_manager.AddSdchDictionary(dictionary, url));
+
+    std::string client_hash;
+    std::string server_hash;
+    SdchManager::GenerateHash(dictionary, &client_hash, &server_hash);
+    std::string response(server_hash);
+    response.append("\0", 1);
+    response.append(kVcdiffResponse, sizeof(kVcdiffResponse) - 1);
+
+    PerfTimer timer;
+    for (int j = 0; j < kSdchResponses; ++j) {
+      ASSERT_EQ(kVcdiffResponseDecodedSize,
+                DecodeResponseWithContext(filter_types, filter_context,
+                                          response, read_buffer.get()));
+    }
+    double seconds = timer.Elapsed().InSecondsF();
+
+    LogPerfResult(
+        base::StringPrintf("sdch_setup_%d_byte_dictionary",
+                           static_cast<int>(dictionary.size())).c_str(),
+        seconds * 1000000 / kSdchResponses, "us/response");
+  }
+}
+
+}  // namespace
+
+TEST(FilterPerfTest, DecodeGZip) {
+  RunDecodeBenchmark("gzip", Filter::FILTER_TYPE_GZIP, &GZipCompress);
+}
+
+TEST(FilterPerfTest, DecodeLzma) {
+  RunDecodeBenchmark("lzma", Filter::FILTER_TYPE_LZMA, &LzmaCompress);
+}
+
+TEST(FilterPerfTest, SdchSetup) {
+  RunSdchSetupBenchmark();
+}
+
+}  // namespace net
@@ -29,6 +29,10 @@ TEST(FilterTest, ContentTypeId) {
             Filter::ConvertEncodingToType("sdch"));
   EXPECT_EQ(Filter::FILTER_TYPE_SDCH,
             Filter::ConvertEncodingToType("sDcH"));
+  EXPECT_EQ(Filter::FILTER_TYPE_LZMA,
+            Filter::ConvertEncodingToType("lzma"));
+  EXPECT_EQ(Filter::FILTER_TYPE_LZMA,
+            Filter::ConvertEncodingToType("LzMa"));
   EXPECT_EQ(Filter::FILTER_TYPE_UNSUPPORTED,
             Filter::ConvertEncodingToType("weird"));
   EXPECT_EQ(Filter::FILTER_TYPE_UNSUPPORTED,
@@ -4,10 +4,88 @@
 
 #include "net/base/gzip_filter.h"
 
+#include <vector>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "net/base/gzip_header.h"
 #include "third_party/zlib/zlib.h"
 
+namespace {
+
+// Maximum number of idle inflate states kept for reuse.  Each one holds on to
+// zlib's internal state and, once used, its 32K sliding window.
+const size_t kMaxIdleInflateStates = 8;
+
+// Keeps the z_streams of finished filters around, so that decoding a new
+// response resets an existing inflate state instead of allocating a new one
+// (and a new window on the first call to inflate).  Filters can be used on
+// several threads, so access is serialized by |lock_|.
+class InflateStatePool {
+ public:
+  InflateStatePool() {}
+
+  ~InflateStatePool() {
+    for (size_t i = 0; i < idle_states_.size(); ++i)
+      inflateEnd(idle_states_[i]);
+    STLDeleteElements(&idle_states_);
+  }
+
+  // Returns an inflate state initialized for |window_bits|, as inflateInit2
+  // would, or NULL on failure.
+  z_stream* Take(int window_bits) {
+    z_stream* state = NULL;
+    {
+      base::AutoLock lock(lock_);
+      if (!idle_states_.empty()) {
+        state = idle_states_.back();
+        idle_states_.pop_back();
+      }
+    }
+
+    if (state) {
+      if (inflateReset2(state, window_bits) == Z_OK)
+        return state;
+      inflateEnd(state);
+      delete state;
+    }
+
+    state = new z_stream;
+    memset(state, 0, sizeof(z_stream));
+    if (inflateInit2(state, window_bits) != Z_OK) {
+      delete state;
+      return NULL;
+    }
+    return state;
+  }
+
+  // Takes ownership of |state|, which must have come from Take().
+  void Return(z_stream* state) {
+    {
+      base::AutoLock lock(lock_);
+      if (idle_states_.size() < kMaxIdleInflateStates) {
+        idle_states_.push_back(state);
+        return;
+      }
+    }
+    inflateEnd(state);
+    delete state;
+  }
+
+ private:
+  base::Lock lock_;
+  std::vector<z_stream*> idle_states_;
+
+  DISALLOW_COPY_AND_ASSIGN(InflateStatePool);
+};
+
+base::LazyInstance<InflateStatePool>::Leaky g_inflate_state_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 namespace net {
 
 GZipFilter::GZipFilter()
@@ -16,29 +94,24 @@ GZipFilter::GZipFilter()
       gzip_header_status_(GZIP_CHECK_HEADER_IN_PROGRESS),
       zlib_header_added_(false),
       gzip_footer_bytes_(0),
+      zlib_stream_(NULL),
       possible_sdch_pass_through_(false) {
 }
 
 GZipFilter::~GZipFilter() {
-  if (decoding_status_ != DECODING_UNINITIALIZED) {
-    inflateEnd(zlib_stream_.get());
-  }
+  if (zlib_stream_)
+    g_inflate_state_pool.Get().Return(zlib_stream_);
 }
 
 bool GZipFilter::InitDecoding(Filter::FilterType filter_type) {
   if (decoding_status_ != DECODING_UNINITIALIZED)
     return false;
 
-  // Initialize zlib control block
-  zlib_stream_.reset(new z_stream);
-  if (!zlib_stream_.get())
-    return false;
-  memset(zlib_stream_.get(), 0, sizeof(z_stream));
-
   // Set decoding mode
   switch (filter_type) {
     case Filter::FILTER_TYPE_DEFLATE: {
-      if (inflateInit(zlib_stream_.get()) != Z_OK)
+      zlib_stream_ = g_inflate_state_pool.Get().Take(MAX_WBITS);
+      if (!zlib_stream_)
         return false;
       decoding_mode_ = DECODE_MODE_DEFLATE;
       break;
@@ -50,7 +123,8 @@ bool GZipFilter::InitDecoding(Filter::FilterType filter_type) {
       gzip_header_.reset(new GZipHeader());
       if (!gzip_header_.get())
         return false;
-      if (inflateInit2(zlib_stream_.get(), -MAX_WBITS) != Z_OK)
+      zlib_stream_ = g_inflate_state_pool.Get().Take(-MAX_WBITS);
+      if (!zlib_stream_)
         return false;
       decoding_mode_ = DECODE_MODE_GZIP;
       break;
@@ -204,13 +278,13 @@ Filter::FilterStatus GZipFilter::DoInflate(char* dest_buffer, int* dest_len) {
   }
 
   // Fill in zlib control block
-  zlib_stream_.get()->next_in = bit_cast<Bytef*>(next_stream_data_);
-  zlib_stream_.get()->avail_in = stream_data_len_;
-  zlib_stream_.get()->next_out = bit_cast<Bytef*>(dest_buffer);
-  zlib_stream_.get()->avail_out = *dest_len;
+  zlib_stream_->next_in = bit_cast<Bytef*>(next_stream_data_);
+  zlib_stream_->avail_in = stream_data_len_;
+  zlib_stream_->next_out = bit_cast<Bytef*>(dest_buffer);
+  zlib_stream_->avail_out = *dest_len;
 
-  int inflate_code = inflate(zlib_stream_.get(), Z_NO_FLUSH);
-  int bytesWritten = *dest_len - zlib_stream_.get()->avail_out;
+  int inflate_code = inflate(zlib_stream_, Z_NO_FLUSH);
+  int bytesWritten = *dest_len - zlib_stream_->avail_out;
 
   Filter::FilterStatus status;
 
@@ -218,8 +292,8 @@ Filter::FilterStatus GZipFilter::DoInflate(char* dest_buffer, int* dest_len) {
     case Z_STREAM_END: {
       *dest_len = bytesWritten;
 
-      stream_data_len_ = zlib_stream_.get()->avail_in;
-      next_stream_data_ = bit_cast<char*>(zlib_stream_.get()->next_in);
+      stream_data_len_ = zlib_stream_->avail_in;
+      next_stream_data_ = bit_cast<char*>(zlib_stream_->next_in);
 
       SkipGZipFooter();
 
@@ -241,12 +315,12 @@ Filter::FilterStatus GZipFilter::DoInflate(char* dest_buffer, int* dest_len) {
       *dest_len = bytesWritten;
 
       // Check whether we have consumed all input data.
-      stream_data_len_ = zlib_stream_.get()->avail_in;
+      stream_data_len_ = zlib_stream_->avail_in;
       if (stream_data_len_ == 0) {
         next_stream_data_ = NULL;
         status = Filter::FILTER_NEED_MORE_DATA;
       } else {
-        next_stream_data_ = bit_cast<char*>(zlib_stream_.get()->next_in);
+        next_stream_data_ = bit_cast<char*>(zlib_stream_->next_in);
         status = Filter::FILTER_OK;
       }
       break;
@@ -269,13 +343,13 @@ bool GZipFilter::InsertZlibHeader() {
   if (zlib_header_added_)
     return false;
 
-  inflateReset(zlib_stream_.get());
-  zlib_stream_.get()->next_in = bit_cast<Bytef*>(&dummy_head[0]);
-  zlib_stream_.get()->avail_in = sizeof(dummy_head);
-  zlib_stream_.get()->next_out = bit_cast<Bytef*>(&dummy_output[0]);
-  zlib_stream_.get()->avail_out = sizeof(dummy_output);
+  inflateReset(zlib_stream_);
+  zlib_stream_->next_in = bit_cast<Bytef*>(&dummy_head[0]);
+  zlib_stream_->avail_in = sizeof(dummy_head);
+  zlib_stream_->next_out = bit_cast<Bytef*>(&dummy_output[0]);
+  zlib_stream_->avail_out = sizeof(dummy_output);
 
-  int code = inflate(zlib_stream_.get(), Z_NO_FLUSH);
+  int code = inflate(zlib_stream_, Z_NO_FLUSH);
   zlib_header_added_ = true;
 
   return (code == Z_OK);
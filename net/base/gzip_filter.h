@@ -130,9 +130,10 @@ class GZipFilter : public Filter {
   int gzip_footer_bytes_;
 
   // The control block of zlib which actually does the decoding.
-  // This data structure is initialized by InitDecoding and updated only by
+  // This data structure is taken from a process wide pool of inflate states by
+  // InitDecoding, returned to it on destruction, and updated only by
   // DoInflate, with InsertZlibHeader being the exception as a workaround.
-  scoped_ptr<z_stream> zlib_stream_;
+  z_stream* zlib_stream_;
 
   // For robustness, when we see the solo sdch filter, we chain in a gzip filter
   // in front of it, with this flag to indicate that the gzip decoding might not
@@ -325,6 +325,31 @@ TEST_F(GZipUnitTest, DecodeWithOneByteInputAndOutputBuffer) {
                              gzip_encode_buffer_, gzip_encode_len_, 1);
 }
 
+// Tests that filters created one after another decode correctly, whichever
+// encoding the previous filter decoded, and whether or not it finished.
+TEST_F(GZipUnitTest, DecodeWithSequentialFilters) {
+  for (int i = 0; i < 3; ++i) {
+    InitFilterWithBufferSize(Filter::FILTER_TYPE_GZIP, kSmallBufferSize);
+    DecodeAndCompareWithFilter(filter_.get(), source_buffer(), source_len(),
+                               gzip_encode_buffer_, gzip_encode_len_,
+                               kSmallBufferSize);
+
+    InitFilterWithBufferSize(Filter::FILTER_TYPE_DEFLATE, kSmallBufferSize);
+    DecodeAndCompareWithFilter(filter_.get(), source_buffer(), source_len(),
+                               deflate_encode_buffer_, deflate_encode_len_,
+                               kSmallBufferSize);
+
+    // Abandon a filter part way through the stream.
+    InitFilter(Filter::FILTER_TYPE_DEFLATE);
+    char decode_buffer[kSmallBufferSize];
+    int decode_size = kSmallBufferSize;
+    EXPECT_EQ(Filter::FILTER_OK,
+              DecodeAllWithFilter(filter_.get(), deflate_encode_buffer_,
+                                  deflate_encode_len_, decode_buffer,
+                                  &decode_size));
+  }
+}
+
 // Decoding deflate stream with corrupted data.
 TEST_F(GZipUnitTest, DecodeCorruptedData) {
   char corrupt_data[kDefaultBufferSize];
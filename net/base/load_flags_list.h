@@ -119,3 +119,8 @@ LOAD_FLAG(DO_NOT_PROMPT_FOR_LOGIN, 1 << 26)
 // explicit user action. This can be used as a hint to treat the
 // request with higher priority.
 LOAD_FLAG(MAYBE_USER_GESTURE, 1 << 27)
+
+// Keep reading the response body from the network, up to a bounded number of
+// bytes, while the consumer is busy with the data it has already read, rather
+// than only when the consumer asks for more.
+LOAD_FLAG(READ_AHEAD, 1 << 28)
@@ -0,0 +1,181 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/lzma_filter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+extern "C" {
+#include "third_party/lzma_sdk/LzmaDec.h"
+}
+
+namespace {
+
+void* LzmaAlloc(void* p, size_t size) {
+  return malloc(size);
+}
+
+void LzmaFree(void* p, void* address) {
+  free(address);
+}
+
+ISzAlloc g_lzma_alloc = { LzmaAlloc, LzmaFree };
+
+}  // namespace
+
+namespace net {
+
+struct LzmaFilter::Decoder {
+  Decoder() {
+    LzmaDec_Construct(&state);
+  }
+
+  ~Decoder() {
+    LzmaDec_Free(&state, &g_lzma_alloc);
+  }
+
+  CLzmaDec state;
+};
+
+LzmaFilter::LzmaFilter()
+    : decoding_status_(DECODING_UNINITIALIZED),
+      header_bytes_(0),
+      size_known_(false),
+      remaining_size_(0) {
+}
+
+LzmaFilter::~LzmaFilter() {}
+
+bool LzmaFilter::InitDecoding(Filter::FilterType filter_type) {
+  if (decoding_status_ != DECODING_UNINITIALIZED)
+    return false;
+  if (filter_type != FILTER_TYPE_LZMA)
+    return false;
+  decoding_status_ = READING_HEADER;
+  return true;
+}
+
+Filter::FilterStatus LzmaFilter::ReadFilteredData(char* dest_buffer,
+                                                  int* dest_len) {
+  if (!dest_buffer || !dest_len || *dest_len <= 0)
+    return Filter::FILTER_ERROR;
+
+  if (decoding_status_ == DECODING_DONE) {
+    // Unlike gzip, nothing is expected after the end of an lzma stream, so
+    // anything there is dropped rather than passed through.
+    next_stream_data_ = NULL;
+    stream_data_len_ = 0;
+    *dest_len = 0;
+    return Filter::FILTER_DONE;
+  }
+
+  if (decoding_status_ == READING_HEADER) {
+    if (!ReadHeader()) {
+      decoding_status_ = DECODING_ERROR;
+      *dest_len = 0;
+      return Filter::FILTER_ERROR;
+    }
+    if (decoding_status_ == READING_HEADER) {
+      *dest_len = 0;
+      return Filter::FILTER_NEED_MORE_DATA;
+    }
+  }
+
+  if (decoding_status_ != DECODING_IN_PROGRESS)
+    return Filter::FILTER_ERROR;
+
+  Filter::FilterStatus status = DoDecode(dest_buffer, dest_len);
+  if (status == Filter::FILTER_DONE)
+    decoding_status_ = DECODING_DONE;
+  else if (status == Filter::FILTER_ERROR)
+    decoding_status_ = DECODING_ERROR;
+  return status;
+}
+
+bool LzmaFilter::ReadHeader() {
+  DCHECK_EQ(READING_HEADER, decoding_status_);
+
+  int header_len = std::min(kHeaderSize - header_bytes_, stream_data_len_);
+  if (header_len > 0) {
+    memcpy(header_ + header_bytes_, next_stream_data_, header_len);
+    header_bytes_ += header_len;
+    next_stream_data_ += header_len;
+    stream_data_len_ -= header_len;
+    if (stream_data_len_ == 0)
+      next_stream_data_ = NULL;
+  }
+  if (header_bytes_ < kHeaderSize)
+    return true;
+
+  CLzmaProps props;
+  if (LzmaProps_Decode(&props, header_, LZMA_PROPS_SIZE) != SZ_OK)
+    return false;
+  // The dictionary size is chosen by the server, and the decoder allocates a
+  // window of that size up front.
+  if (props.dicSize > kMaxDictionarySize)
+    return false;
+
+  uint64 size = 0;
+  for (int i = kHeaderSize - 1; i >= LZMA_PROPS_SIZE; --i)
+    size = (size << 8) | header_[i];
+  size_known_ = size != kuint64max;
+  remaining_size_ = size;
+
+  decoder_.reset(new Decoder());
+  if (LzmaDec_Allocate(&decoder_->state, header_, LZMA_PROPS_SIZE,
+                       &g_lzma_alloc) != SZ_OK) {
+    return false;
+  }
+  LzmaDec_Init(&decoder_->state);
+  decoding_status_ = DECODING_IN_PROGRESS;
+  return true;
+}
+
+Filter::FilterStatus LzmaFilter::DoDecode(char* dest_buffer, int* dest_len) {
+  if (size_known_ && remaining_size_ == 0) {
+    *dest_len = 0;
+    return Filter::FILTER_DONE;
+  }
+
+  SizeT out_len = *dest_len;
+  if (size_known_ && remaining_size_ < out_len)
+    out_len = static_cast<SizeT>(remaining_size_);
+  SizeT in_len = stream_data_len_;
+  ELzmaStatus lzma_status;
+  // The decoder may still have output to flush after all input has been
+  // consumed, so it is called even when there is no new input.
+  SRes result = LzmaDec_DecodeToBuf(
+      &decoder_->state, reinterpret_cast<Byte*>(dest_buffer), &out_len,
+      reinterpret_cast<const Byte*>(next_stream_data_), &in_len,
+      LZMA_FINISH_ANY, &lzma_status);
+  if (result != SZ_OK) {
+    *dest_len = 0;
+    return Filter::FILTER_ERROR;
+  }
+
+  *dest_len = static_cast<int>(out_len);
+  stream_data_len_ -= static_cast<int>(in_len);
+  next_stream_data_ = stream_data_len_ ? next_stream_data_ + in_len : NULL;
+
+  if (lzma_status == LZMA_STATUS_FINISHED_WITH_MARK) {
+    // A stream with a known size may not also end with a marker early.
+    if (size_known_ && remaining_size_ != out_len)
+      return Filter::FILTER_ERROR;
+    return Filter::FILTER_DONE;
+  }
+  if (size_known_) {
+    remaining_size_ -= out_len;
+    if (remaining_size_ == 0)
+      return Filter::FILTER_DONE;
+  }
+
+  return stream_data_len_ ? Filter::FILTER_OK : Filter::FILTER_NEED_MORE_DATA;
+}
+
+}  // namespace net
@@ -0,0 +1,94 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// LzmaFilter applies "lzma" content decoding to a data stream.  The content
+// is in the .lzma ("LZMA alone") format: a 5 byte LZMA properties block and an
+// 8 byte little endian uncompressed size, which is all ones when the size is
+// not known and the stream ends with an end marker instead, followed by the
+// compressed data.
+//
+// Internally LzmaFilter uses the LZMA SDK decoder, whose sliding window lets
+// it compress typical web content noticeably better than deflate.
+//
+// LzmaFilter is a subclass of Filter. See the latter's header file filter.h
+// for sample usage.
+
+#ifndef NET_BASE_LZMA_FILTER_H_
+#define NET_BASE_LZMA_FILTER_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "net/base/filter.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+class NET_EXPORT_PRIVATE LzmaFilter : public Filter {
+ public:
+  // Size of the .lzma header preceding the compressed data.
+  static const int kHeaderSize = 13;
+
+  // Largest dictionary, and so decoder window allocation, that a response may
+  // ask for.  Streams which need more are rejected.
+  static const uint32 kMaxDictionarySize = 16 * 1024 * 1024;
+
+  virtual ~LzmaFilter();
+
+  // Initializes filter decoding mode.  Returns false if |filter_type| is not
+  // FILTER_TYPE_LZMA.  The filter can only be initialized once.
+  bool InitDecoding(Filter::FilterType filter_type);
+
+  // Decodes the pre-filter data and writes the output into |dest_buffer|.
+  // The function returns FilterStatus. See filter.h for its description.
+  //
+  // Upon entry, *dest_len is the total size (in number of chars) of the
+  // destination buffer. Upon exit, *dest_len is the actual number of chars
+  // written into the destination buffer.
+  virtual FilterStatus ReadFilteredData(char* dest_buffer,
+                                        int* dest_len) OVERRIDE;
+
+ private:
+  enum DecodingStatus {
+    DECODING_UNINITIALIZED,
+    READING_HEADER,
+    DECODING_IN_PROGRESS,
+    DECODING_DONE,
+    DECODING_ERROR
+  };
+
+  // Wraps the LZMA SDK decoder state, so that its C headers stay out of this
+  // one.
+  struct Decoder;
+
+  // Only to be instantiated by Filter::Factory.
+  LzmaFilter();
+  friend class Filter;
+
+  // Consumes header bytes from the pre-filter buffer.  Once the header is
+  // complete, allocates the decoder and moves to DECODING_IN_PROGRESS.
+  // Returns false if the header is invalid.
+  bool ReadHeader();
+
+  // Decodes pre-filter data into |dest_buffer|, as ReadFilteredData.
+  FilterStatus DoDecode(char* dest_buffer, int* dest_len);
+
+  DecodingStatus decoding_status_;
+
+  // The .lzma header, and how much of it has been received.
+  unsigned char header_[kHeaderSize];
+  int header_bytes_;
+
+  // Number of bytes still to be decoded, when the header gives the size.
+  bool size_known_;
+  uint64 remaining_size_;
+
+  // Allocated once the header has been read.
+  scoped_ptr<Decoder> decoder_;
+
+  DISALLOW_COPY_AND_ASSIGN(LzmaFilter);
+};
+
+}  // namespace net
+
+#endif  // NET_BASE_LZMA_FILTER_H_
@@ -0,0 +1,213 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/lzma_filter.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "net/base/io_buffer.h"
+#include "net/base/mock_filter_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+extern "C" {
+#include "third_party/lzma_sdk/LzmaEnc.h"
+}
+
+namespace net {
+
+namespace {
+
+const int kSmallBufferSize = 128;
+
+void* LzmaAlloc(void* p, size_t size) {
+  return malloc(size);
+}
+
+void LzmaFree(void* p, void* address) {
+  free(address);
+}
+
+ISzAlloc g_lzma_alloc = { LzmaAlloc, LzmaFree };
+
+// Returns |source| in the .lzma format, with the uncompressed size in the
+// header, or with an unknown size and an end marker.
+std::string LzmaCompress(const std::string& source, bool known_size,
+                         uint32 dictionary_size) {
+  CLzmaEncProps props;
+  LzmaEncProps_Init(&props);
+  props.dictSize = dictionary_size;
+
+  std::string output(source.size() + source.size() / 2 + 1024, '\0');
+  Byte* header = reinterpret_cast<Byte*>(&output[0]);
+  SizeT props_size = LZMA_PROPS_SIZE;
+  SizeT out_len = output.size() - LzmaFilter::kHeaderSize;
+  EXPECT_EQ(SZ_OK, LzmaEncode(header + LzmaFilter::kHeaderSize, &out_len,
+                              reinterpret_cast<const Byte*>(source.data()),
+                              source.size(), &props, header, &props_size,
+                              known_size ? 0 : 1, NULL, &g_lzma_alloc,
+                              &g_lzma_alloc));
+  uint64 size = known_size ? source.size() : kuint64max;
+  for (int i = LZMA_PROPS_SIZE; i < LzmaFilter::kHeaderSize; ++i) {
+    header[i] = static_cast<Byte>(size);
+    size >>= 8;
+  }
+  output.resize(LzmaFilter::kHeaderSize + out_len);
+  return output;
+}
+
+}  // namespace
+
+class LzmaFilterTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    for (int i = 0; source_.size() < 64 * 1024; ++i) {
+      source_ += "<li><a href=\"/page";
+      source_ += static_cast<char>('0' + i % 10);
+      source_ += ".html\">The quick brown fox jumps over the lazy dog</a></li>";
+    }
+  }
+
+  void InitFilter(int buffer_size) {
+    std::vector<Filter::FilterType> filter_types;
+    filter_types.push_back(Filter::FILTER_TYPE_LZMA);
+    filter_.reset(Filter::FactoryForTests(filter_types, filter_context_,
+                                          buffer_size));
+    ASSERT_TRUE(filter_.get());
+  }
+
+  // Feeds |encoded| to the filter |filter_->stream_buffer_size()| bytes at a
+  // time, reading the output |output_buffer_size| bytes at a time into
+  // |output|, the way URLRequestJob does.  Returns the last status.
+  Filter::FilterStatus Decode(const std::string& encoded,
+                              int output_buffer_size,
+                              std::string* output) {
+    std::vector<char> read_buffer(output_buffer_size);
+    size_t offset = 0;
+    Filter::FilterStatus status = Filter::FILTER_NEED_MORE_DATA;
+    bool needs_more_output_space = false;
+    while (status != Filter::FILTER_DONE && status != Filter::FILTER_ERROR) {
+      if (status == Filter::FILTER_NEED_MORE_DATA &&
+          !needs_more_output_space) {
+        if (offset == encoded.size())
+          break;
+        int len = std::min(static_cast<int>(encoded.size() - offset),
+                           filter_->stream_buffer_size());
+        memcpy(filter_->stream_buffer()->data(), encoded.data() + offset, len);
+        filter_->FlushStreamBuffer(len);
+        offset += len;
+      }
+      int read_len = output_buffer_size;
+      status = filter_->ReadData(&read_buffer[0], &read_len);
+      output->append(&read_buffer[0], read_len);
+      needs_more_output_space = read_len == output_buffer_size;
+    }
+    return status;
+  }
+
+  std::string source_;
+  scoped_ptr<Filter> filter_;
+
+ private:
+  MockFilterContext filter_context_;
+};
+
+TEST_F(LzmaFilterTest, DecodeWithKnownSize) {
+  std::string encoded = LzmaCompress(source_, true, 1 << 16);
+  EXPECT_LT(encoded.size(), source_.size() / 10);
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_DONE, Decode(encoded, 32 * 1024, &output));
+  EXPECT_EQ(source_, output);
+}
+
+TEST_F(LzmaFilterTest, DecodeWithEndMarker) {
+  std::string encoded = LzmaCompress(source_, false, 1 << 16);
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_DONE, Decode(encoded, 32 * 1024, &output));
+  EXPECT_EQ(source_, output);
+}
+
+// Tests that the header and data can arrive in pieces, and that output the
+// decoder holds back is returned even when there is no new input.
+TEST_F(LzmaFilterTest, DecodeWithOneByteInputAndSmallOutputBuffer) {
+  std::string encoded = LzmaCompress(source_, false, 1 << 16);
+
+  InitFilter(1);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_DONE, Decode(encoded, kSmallBufferSize, &output));
+  EXPECT_EQ(source_, output);
+}
+
+TEST_F(LzmaFilterTest, DecodeWithSmallInputAndOneByteOutputBuffer) {
+  std::string encoded = LzmaCompress(source_, true, 1 << 16);
+
+  InitFilter(kSmallBufferSize);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_DONE, Decode(encoded, 1, &output));
+  EXPECT_EQ(source_, output);
+}
+
+// The decoder allocates the whole dictionary up front, so responses asking for
+// a huge one are rejected.
+TEST_F(LzmaFilterTest, RejectsLargeDictionary) {
+  std::string encoded = LzmaCompress(source_, true, 1 << 16);
+  uint32 dictionary_size = LzmaFilter::kMaxDictionarySize * 2;
+  for (int i = 1; i < LZMA_PROPS_SIZE; ++i) {
+    encoded[i] = static_cast<char>(dictionary_size);
+    dictionary_size >>= 8;
+  }
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_ERROR, Decode(encoded, 32 * 1024, &output));
+  EXPECT_TRUE(output.empty());
+}
+
+TEST_F(LzmaFilterTest, RejectsInvalidProperties) {
+  std::string encoded = LzmaCompress(source_, true, 1 << 16);
+  // lc, lp and pb are encoded as (pb * 5 + lp) * 9 + lc, so 225 and up are
+  // invalid.
+  encoded[0] = static_cast<char>(225);
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_ERROR, Decode(encoded, 32 * 1024, &output));
+}
+
+// A stream whose end marker comes before the size given in the header is
+// truncated.
+TEST_F(LzmaFilterTest, EndMarkerBeforeKnownSize) {
+  std::string encoded = LzmaCompress(source_, false, 1 << 16);
+  uint64 size = source_.size() + 1;
+  for (int i = LZMA_PROPS_SIZE; i < LzmaFilter::kHeaderSize; ++i) {
+    encoded[i] = static_cast<char>(size);
+    size >>= 8;
+  }
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_ERROR, Decode(encoded, 32 * 1024, &output));
+}
+
+TEST_F(LzmaFilterTest, IncompleteStream) {
+  std::string encoded = LzmaCompress(source_, true, 1 << 16);
+  encoded.resize(encoded.size() / 2);
+
+  InitFilter(32 * 1024);
+  std::string output;
+  EXPECT_EQ(Filter::FILTER_NEED_MORE_DATA,
+            Decode(encoded, 32 * 1024, &output));
+  EXPECT_LT(output.size(), source_.size());
+  EXPECT_EQ(source_.substr(0, output.size()), output);
+}
+
+}  // namespace net
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/logging.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
@@ -73,6 +74,70 @@ base::Value* NetLogString16Callback(const char* name,
 
 }  // namespace
 
+// An event added while buffering is enabled.  |parameters| are owned by
+// whichever buffer or list holds the event.
+struct NetLog::Entry::BufferedEntry {
+  BufferedEntry(EventType type,
+                const Source& source,
+                EventPhase phase,
+                base::TimeTicks time,
+                base::Value* parameters,
+                LogLevel log_level)
+      : type(type),
+        source(source),
+        phase(phase),
+        time(time),
+        parameters(parameters),
+        log_level(log_level) {
+  }
+
+  EventType type;
+  Source source;
+  EventPhase phase;
+  base::TimeTicks time;
+  base::Value* parameters;
+  LogLevel log_level;
+};
+
+// The events buffered by a single thread.  Only that thread adds events, so
+// |lock_| is only contended while another thread flushes the buffer.
+class NetLog::ThreadBuffer {
+ public:
+  explicit ThreadBuffer(NetLog* net_log) : net_log_(net_log) {}
+
+  ~ThreadBuffer() {
+    for (BufferedEntryList::iterator it = entries_.begin();
+         it != entries_.end(); ++it) {
+      delete it->parameters;
+    }
+  }
+
+  NetLog* net_log() const { return net_log_; }
+
+  // Appends |entry|, taking ownership of its parameters, and returns the
+  // number of buffered events.
+  size_t Add(const Entry::BufferedEntry& entry) {
+    base::AutoLock lock(lock_);
+    entries_.push_back(entry);
+    return entries_.size();
+  }
+
+  // Moves all buffered events to |entries|, which must be empty.
+  void TakeEntries(BufferedEntryList* entries) {
+    DCHECK(entries->empty());
+    base::AutoLock lock(lock_);
+    entries->swap(entries_);
+  }
+
+ private:
+  NetLog* const net_log_;
+
+  base::Lock lock_;
+  BufferedEntryList entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
 // LoadTimingInfo requires this be 0.
 const uint32 NetLog::Source::kInvalidId = 0;
 
@@ -140,6 +205,8 @@ base::Value* NetLog::Entry::ToValue() const {
     base::Value* value = parameters_callback_->Run(log_level_);
     if (value)
       entry_dict->Set("params", value);
+  } else if (parameters_) {
+    entry_dict->Set("params", parameters_->DeepCopy());
   }
 
   return entry_dict;
@@ -148,6 +215,8 @@ base::Value* NetLog::Entry::ToValue() const {
 base::Value* NetLog::Entry::ParametersToValue() const {
   if (parameters_callback_)
     return parameters_callback_->Run(log_level_);
+  if (parameters_)
+    return parameters_->DeepCopy();
   return NULL;
 }
 
@@ -163,9 +232,20 @@ NetLog::Entry::Entry(
       phase_(phase),
       time_(time),
       parameters_callback_(parameters_callback),
+      parameters_(NULL),
       log_level_(log_level) {
 };
 
+NetLog::Entry::Entry(const BufferedEntry& buffered_entry)
+    : type_(buffered_entry.type),
+      source_(buffered_entry.source),
+      phase_(buffered_entry.phase),
+      time_(buffered_entry.time),
+      parameters_callback_(NULL),
+      parameters_(buffered_entry.parameters),
+      log_level_(buffered_entry.log_level) {
+}
+
 NetLog::Entry::~Entry() {
 }
 
@@ -192,10 +272,16 @@ NetLog* NetLog::ThreadSafeObserver::net_log() const {
 NetLog::NetLog()
     : last_id_(0),
       base_log_level_(LOG_NONE),
-      effective_log_level_(LOG_NONE) {
+      effective_log_level_(LOG_NONE),
+      max_buffered_entries_(0) {
 }
 
 NetLog::~NetLog() {
+  // Freeing the slot keeps the buffers of threads which are still running
+  // from being passed to OnThreadExit(), so they are deleted here instead.
+  if (thread_buffer_slot_)
+    thread_buffer_slot_->Free();
+  STLDeleteElements(&thread_buffers_);
 }
 
 void NetLog::AddGlobalEntry(EventType type) {
@@ -220,6 +306,7 @@ uint32 NetLog::NextID() {
 
 void NetLog::SetBaseLogLevel(LogLevel log_level) {
   base::AutoLock lock(lock_);
+  FlushBufferedEntriesLocked();
   base_log_level_ = log_level;
 
   UpdateLogLevel();
@@ -235,6 +322,7 @@ void NetLog::AddThreadSafeObserver(
     net::NetLog::ThreadSafeObserver* observer,
     LogLevel log_level) {
   base::AutoLock lock(lock_);
+  FlushBufferedEntriesLocked();
 
   DCHECK(!observer->net_log_);
   observers_.AddObserver(observer);
@@ -247,6 +335,7 @@ void NetLog::SetObserverLogLevel(
     net::NetLog::ThreadSafeObserver* observer,
     LogLevel log_level) {
   base::AutoLock lock(lock_);
+  FlushBufferedEntriesLocked();
 
   DCHECK(observers_.HasObserver(observer));
   DCHECK_EQ(this, observer->net_log_);
@@ -257,6 +346,7 @@ void NetLog::SetObserverLogLevel(
 void NetLog::RemoveThreadSafeObserver(
     net::NetLog::ThreadSafeObserver* observer) {
   base::AutoLock lock(lock_);
+  FlushBufferedEntriesLocked();
 
   DCHECK(observers_.HasObserver(observer));
   DCHECK_EQ(this, observer->net_log_);
@@ -265,6 +355,19 @@ void NetLog::RemoveThreadSafeObserver(
   UpdateLogLevel();
 }
 
+void NetLog::EnableEventBuffering(size_t max_buffered_entries) {
+  DCHECK_GT(max_buffered_entries, 0u);
+  DCHECK(!thread_buffer_slot_);
+  thread_buffer_slot_.reset(
+      new base::ThreadLocalStorage::Slot(&NetLog::OnThreadExit));
+  max_buffered_entries_ = max_buffered_entries;
+}
+
+void NetLog::FlushBufferedEntries() {
+  base::AutoLock lock(lock_);
+  FlushBufferedEntriesLocked();
+}
+
 void NetLog::UpdateLogLevel() {
   lock_.AssertAcquired();
 
@@ -386,6 +489,10 @@ void NetLog::AddEntry(EventType type,
   LogLevel log_level = GetLogLevel();
   if (log_level == LOG_NONE)
     return;
+  if (max_buffered_entries_ > 0) {
+    AddBufferedEntry(type, source, phase, parameters_callback, log_level);
+    return;
+  }
   Entry entry(type, source, phase, base::TimeTicks::Now(),
               parameters_callback, log_level);
 
@@ -394,6 +501,71 @@ void NetLog::AddEntry(EventType type,
   FOR_EACH_OBSERVER(ThreadSafeObserver, observers_, OnAddEntry(entry));
 }
 
+void NetLog::AddBufferedEntry(
+    EventType type,
+    const Source& source,
+    EventPhase phase,
+    const NetLog::ParametersCallback* parameters_callback,
+    LogLevel log_level) {
+  ThreadBuffer* buffer =
+      static_cast<ThreadBuffer*>(thread_buffer_slot_->Get());
+  if (!buffer) {
+    buffer = new ThreadBuffer(this);
+    thread_buffer_slot_->Set(buffer);
+    base::AutoLock lock(lock_);
+    thread_buffers_.insert(buffer);
+  }
+
+  // |parameters_callback| may refer to objects that only live until this call
+  // returns, so the parameters must be evaluated now.
+  base::Value* parameters =
+      parameters_callback ? parameters_callback->Run(log_level) : NULL;
+  size_t buffered = buffer->Add(Entry::BufferedEntry(
+      type, source, phase, base::TimeTicks::Now(), parameters, log_level));
+  if (buffered < max_buffered_entries_)
+    return;
+
+  BufferedEntryList entries;
+  buffer->TakeEntries(&entries);
+  base::AutoLock lock(lock_);
+  DeliverBufferedEntries(&entries);
+}
+
+void NetLog::FlushBufferedEntriesLocked() {
+  lock_.AssertAcquired();
+  for (std::set<ThreadBuffer*>::iterator it = thread_buffers_.begin();
+       it != thread_buffers_.end(); ++it) {
+    BufferedEntryList entries;
+    (*it)->TakeEntries(&entries);
+    DeliverBufferedEntries(&entries);
+  }
+}
+
+void NetLog::DeliverBufferedEntries(BufferedEntryList* entries) {
+  lock_.AssertAcquired();
+  for (BufferedEntryList::iterator it = entries->begin();
+       it != entries->end(); ++it) {
+    Entry entry(*it);
+    FOR_EACH_OBSERVER(ThreadSafeObserver, observers_, OnAddEntry(entry));
+    delete it->parameters;
+  }
+  entries->clear();
+}
+
+// static
+void NetLog::OnThreadExit(void* thread_buffer) {
+  ThreadBuffer* buffer = static_cast<ThreadBuffer*>(thread_buffer);
+  NetLog* net_log = buffer->net_log();
+  {
+    base::AutoLock lock(net_log->lock_);
+    BufferedEntryList entries;
+    buffer->TakeEntries(&entries);
+    net_log->DeliverBufferedEntries(&entries);
+    net_log->thread_buffers_.erase(buffer);
+  }
+  delete buffer;
+}
+
 void BoundNetLog::AddEntry(NetLog::EventType type,
                            NetLog::EventPhase phase) const {
   if (!net_log_)
@@ -5,15 +5,19 @@
 #ifndef NET_BASE_NET_LOG_H_
 #define NET_BASE_NET_LOG_H_
 
+#include <set>
 #include <string>
+#include <vector>
 
 #include "base/atomicops.h"
 #include "base/basictypes.h"
 #include "base/callback_forward.h"
 #include "base/compiler_specific.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/observer_list.h"
 #include "base/strings/string16.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
 #include "base/time/time.h"
 #include "net/base/net_export.h"
 
@@ -37,6 +41,10 @@ namespace net {
 // NetLog::ThreadSafeObserver functions may be called by an observer's
 // OnAddEntry() method.  Doing so will result in a deadlock.
 //
+// By default, every event is passed to the observers while holding a lock
+// shared by all threads.  See EnableEventBuffering() for a mode which batches
+// events per thread instead.
+//
 // For a broader introduction see the design document:
 // https://sites.google.com/a/chromium.org/dev/developers/design-documents/network-stack/netlog
 class NET_EXPORT NetLog {
@@ -144,12 +152,22 @@ class NET_EXPORT NetLog {
     base::Value* ParametersToValue() const;
 
    private:
+    friend class NetLog;
+    struct BufferedEntry;
+
+    // Constructs an entry for an event whose parameters were evaluated when
+    // it was added.  See NetLog::EnableEventBuffering().
+    explicit Entry(const BufferedEntry& buffered_entry);
+
     const EventType type_;
     const Source source_;
     const EventPhase phase_;
     const base::TimeTicks time_;
     const ParametersCallback* parameters_callback_;
 
+    // Parameters of a buffered event, or NULL.  Not owned.
+    const base::Value* parameters_;
+
     // Log level when the event occurred.
     const LogLevel log_level_;
 
@@ -243,6 +261,28 @@ class NET_EXPORT NetLog {
   // an object's destructor.
   void RemoveThreadSafeObserver(ThreadSafeObserver* observer);
 
+  // Switches the NetLog to buffering events per thread.  AddEntry() then
+  // evaluates an event's parameters, at the current log level, and appends it
+  // to a buffer owned by the calling thread without taking the lock shared by
+  // all threads.  Events are only built when some observer wants them, as
+  // before.  A thread's buffer is passed to the observers as one batch when it
+  // holds |max_buffered_entries| events and when the thread exits.  All buffers
+  // are passed on by FlushBufferedEntries(), and before an observer is added,
+  // removed, or has its log level changed.
+  //
+  // Observers still see each thread's events in order, but events from
+  // different threads may be interleaved differently than they occurred, and
+  // an event may reach observers some time after it was added.  Entry::time()
+  // is always the time the event was added.
+  //
+  // Must be called at most once, before the NetLog is used on other threads.
+  // |max_buffered_entries| must be greater than 0.
+  void EnableEventBuffering(size_t max_buffered_entries);
+
+  // Passes the events buffered by every thread to the observers.  Does
+  // nothing if buffering is not enabled.
+  void FlushBufferedEntries();
+
   // Converts a time to the string format that the NetLog uses to represent
   // times.  Strings are used since integers may overflow.
   static std::string TickCountToString(const base::TimeTicks& time);
@@ -302,11 +342,33 @@ class NET_EXPORT NetLog {
  private:
   friend class BoundNetLog;
 
+  class ThreadBuffer;
+  typedef std::vector<Entry::BufferedEntry> BufferedEntryList;
+
   void AddEntry(EventType type,
                 const Source& source,
                 EventPhase phase,
                 const NetLog::ParametersCallback* parameters_callback);
 
+  // Appends an event to the calling thread's buffer, and passes the buffer to
+  // the observers if it is full.
+  void AddBufferedEntry(EventType type,
+                        const Source& source,
+                        EventPhase phase,
+                        const NetLog::ParametersCallback* parameters_callback,
+                        LogLevel log_level);
+
+  // Passes every thread's buffered events to the observers.  Must have
+  // acquired |lock_| prior to calling.
+  void FlushBufferedEntriesLocked();
+
+  // Passes |entries| to the observers and frees their parameters.  Must have
+  // acquired |lock_| prior to calling.
+  void DeliverBufferedEntries(BufferedEntryList* entries);
+
+  // Called with a thread's buffer when the thread exits.
+  static void OnThreadExit(void* thread_buffer);
+
   // Called whenever an observer is added or removed, or has its log level
   // changed.  Must have acquired |lock_| prior to calling.
   void UpdateLogLevel();
@@ -327,6 +389,18 @@ class NET_EXPORT NetLog {
   // |lock_| must be acquired whenever reading or writing to this.
   ObserverList<ThreadSafeObserver, true> observers_;
 
+  // Maximum number of events a thread buffers, or 0 if events are not
+  // buffered.  Only set by EnableEventBuffering().
+  size_t max_buffered_entries_;
+
+  // Holds the calling thread's ThreadBuffer.  NULL if events are not
+  // buffered.
+  scoped_ptr<base::ThreadLocalStorage::Slot> thread_buffer_slot_;
+
+  // Every live ThreadBuffer.  |lock_| must be acquired whenever reading or
+  // writing to this.
+  std::set<ThreadBuffer*> thread_buffers_;
+
   DISALLOW_COPY_AND_ASSIGN(NetLog);
 };
 
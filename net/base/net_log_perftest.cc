@@ -0,0 +1,114 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
+#include "base/values.h"
+#include "net/base/net_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kEventsPerThread = 200000;
+const size_t kMaxBufferedEntries = 256;
+
+// Observer which builds the Value of every entry, as a capturing observer
+// such as NetLogLogger would, and then discards it.
+class SerializingObserver : public NetLog::ThreadSafeObserver {
+ public:
+  SerializingObserver() {}
+
+  virtual ~SerializingObserver() {
+    if (net_log())
+      net_log()->RemoveThreadSafeObserver(this);
+  }
+
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE {
+    scoped_ptr<base::Value> value(entry.ToValue());
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SerializingObserver);
+};
+
+class AddEventsDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit AddEventsDelegate(NetLog* net_log)
+      : net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_SOCKET)) {
+  }
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < kEventsPerThread; ++i) {
+      net_log_.AddEvent(NetLog::TYPE_SOCKET_BYTES_RECEIVED,
+                        NetLog::IntegerCallback("byte_count", i));
+    }
+  }
+
+ private:
+  const BoundNetLog net_log_;
+};
+
+void RunAddEventsBenchmark(const std::string& name,
+                           NetLog* net_log,
+                           int num_threads) {
+  std::vector<AddEventsDelegate*> delegates;
+  std::vector<base::DelegateSimpleThread*> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    delegates.push_back(new AddEventsDelegate(net_log));
+    threads.push_back(
+        new base::DelegateSimpleThread(delegates.back(), "net_log"));
+  }
+
+  PerfTimer timer;
+  for (int i = 0; i < num_threads; ++i)
+    threads[i]->Start();
+  for (int i = 0; i < num_threads; ++i)
+    threads[i]->Join();
+  net_log->FlushBufferedEntries();
+  base::TimeDelta elapsed = timer.Elapsed();
+
+  LogPerfResult(
+      base::StringPrintf("%s_%d_threads", name.c_str(), num_threads).c_str(),
+      (num_threads * kEventsPerThread) / elapsed.InSecondsF(),
+      "events/s");
+
+  STLDeleteElements(&threads);
+  STLDeleteElements(&delegates);
+}
+
+}  // namespace
+
+TEST(NetLogPerfTest, AddEventWithCapture) {
+  const int max_threads = std::max(2, base::SysInfo::NumberOfProcessors());
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    {
+      NetLog net_log;
+      SerializingObserver observer;
+      net_log.AddThreadSafeObserver(&observer, NetLog::LOG_ALL_BUT_BYTES);
+      RunAddEventsBenchmark("net_log_add_event", &net_log, threads);
+    }
+
+    {
+      NetLog net_log;
+      net_log.EnableEventBuffering(kMaxBufferedEntries);
+      SerializingObserver observer;
+      net_log.AddThreadSafeObserver(&observer, NetLog::LOG_ALL_BUT_BYTES);
+      RunAddEventsBenchmark("net_log_add_buffered_event", &net_log, threads);
+    }
+  }
+}
+
+}  // namespace net
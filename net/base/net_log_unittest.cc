@@ -331,6 +331,75 @@ TEST(NetLogTest, NetLogAddRemoveObserverThreads) {
   RunTestThreads<AddRemoveObserverTestThread>(&net_log);
 }
 
+// Test that buffered events reach observers when the buffer fills up, when
+// flushed, and when an observer is removed.
+TEST(NetLogTest, BufferedEvents) {
+  NetLog net_log;
+  net_log.EnableEventBuffering(10);
+  CountingObserver observer;
+  net_log.AddThreadSafeObserver(&observer, NetLog::LOG_BASIC);
+
+  for (int i = 0; i < 5; ++i)
+    AddEvent(&net_log);
+  EXPECT_EQ(0, observer.count());
+  net_log.FlushBufferedEntries();
+  EXPECT_EQ(5, observer.count());
+
+  for (int i = 0; i < 9; ++i)
+    AddEvent(&net_log);
+  EXPECT_EQ(5, observer.count());
+  AddEvent(&net_log);
+  EXPECT_EQ(15, observer.count());
+
+  AddEvent(&net_log);
+  net_log.RemoveThreadSafeObserver(&observer);
+  EXPECT_EQ(16, observer.count());
+}
+
+// Test that the parameters of a buffered event are evaluated when the event
+// is added, at the log level in effect at that time.
+TEST(NetLogTest, BufferedEventParameters) {
+  CapturingNetLog net_log;
+  net_log.EnableEventBuffering(10);
+  net_log.SetLogLevel(NetLog::LOG_ALL_BUT_BYTES);
+
+  std::string value = "first";
+  net_log.AddGlobalEntry(NetLog::TYPE_CANCELLED,
+                         NetLog::StringCallback("value", &value));
+  net_log.AddGlobalEntry(NetLog::TYPE_SOCKET_ALIVE,
+                         base::Bind(NetLogLevelCallback));
+  value = "second";
+  EXPECT_EQ(0u, net_log.GetSize());
+
+  net_log.FlushBufferedEntries();
+  CapturingNetLog::CapturedEntryList entries;
+  net_log.GetEntries(&entries);
+  ASSERT_EQ(2u, entries.size());
+  std::string logged_value;
+  ASSERT_TRUE(entries[0].GetStringValue("value", &logged_value));
+  EXPECT_EQ("first", logged_value);
+  int logged_log_level;
+  ASSERT_TRUE(entries[1].GetIntegerValue("log_level", &logged_log_level));
+  EXPECT_EQ(NetLog::LOG_ALL_BUT_BYTES, logged_log_level);
+}
+
+// Makes sure that events buffered on other threads are dispatched to all
+// observers once the threads exit.
+TEST(NetLogTest, BufferedEventThreads) {
+  NetLog net_log;
+  net_log.EnableEventBuffering(7);
+
+  CountingObserver observers[3];
+  for (size_t i = 0; i < arraysize(observers); ++i)
+    net_log.AddThreadSafeObserver(&observers[i], NetLog::LOG_BASIC);
+
+  RunTestThreads<AddEventsTestThread>(&net_log);
+
+  const int kTotalEvents = kThreads * kEvents;
+  for (size_t i = 0; i < arraysize(observers); ++i)
+    EXPECT_EQ(kTotalEvents, observers[i].count());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -132,6 +132,17 @@ bool NetworkDelegate::OnCanEnablePrivacyMode(
   return false;
 }
 
+bool NetworkDelegate::CanPersistSdchDictionary(
+    const URLRequest& request) const {
+  DCHECK(CalledOnValidThread());
+  return OnCanPersistSdchDictionary(request);
+}
+
+bool NetworkDelegate::OnCanPersistSdchDictionary(
+    const URLRequest& request) const {
+  return true;
+}
+
 int NetworkDelegate::NotifyBeforeSocketStreamConnect(
     SocketStream* socket,
     const CompletionCallback& callback) {
@@ -99,6 +99,7 @@ class NET_EXPORT NetworkDelegate : public base::NonThreadSafe {
   bool CanThrottleRequest(const URLRequest& request) const;
   bool CanEnablePrivacyMode(const GURL& url,
                             const GURL& first_party_for_cookies) const;
+  bool CanPersistSdchDictionary(const URLRequest& request) const;
 
   int NotifyBeforeSocketStreamConnect(SocketStream* socket,
                                       const CompletionCallback& callback);
@@ -234,6 +235,10 @@ class NET_EXPORT NetworkDelegate : public base::NonThreadSafe {
       const GURL& url,
       const GURL& first_party_for_cookies) const;
 
+  // Returns true if an SDCH dictionary which |request| asked for may be saved
+  // to disk.  Usually is true, unless |request| is off the record.
+  virtual bool OnCanPersistSdchDictionary(const URLRequest& request) const;
+
   // Called before a SocketStream tries to connect.
   virtual int OnBeforeSocketStreamConnect(
       SocketStream* socket, const CompletionCallback& callback) = 0;
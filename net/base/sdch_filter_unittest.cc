@@ -10,6 +10,7 @@
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/threading/platform_thread.h"
 #include "net/base/filter.h"
 #include "net/base/io_buffer.h"
 #include "net/base/mock_filter_context.h"
@@ -1301,6 +1302,32 @@ TEST_F(SdchFilterTest, TooManyDictionaries) {
   EXPECT_EQ(SdchManager::kMaxDictionaryCount, count);
 }
 
+// Expired dictionaries give up their slots to new ones.
+TEST_F(SdchFilterTest, ExpiredDictionariesFreeSlots) {
+  std::string dictionary_domain(".google.com");
+  GURL url("http://www.google.com");
+
+  // Fill every slot with dictionaries which expire half a second from now.
+  SdchManager::SavedDictionary saved;
+  saved.text = "Max-Age: 1\n" + NewSdchDictionary(dictionary_domain);
+  saved.url = url;
+  saved.added = base::Time::Now() - base::TimeDelta::FromMilliseconds(500);
+  for (size_t i = 0; i < SdchManager::kMaxDictionaryCount; ++i) {
+    EXPECT_TRUE(sdch_manager_->RestoreSdchDictionary(saved));
+    saved.text += " ";  // Create dictionary with different SHA signature.
+  }
+
+  std::string dictionary_text(NewSdchDictionary(dictionary_domain));
+  EXPECT_FALSE(sdch_manager_->AddSdchDictionary(dictionary_text, url));
+
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(600));
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(dictionary_text, url));
+
+  SdchManager::SavedDictionaryList saved_list;
+  sdch_manager_->GetSavedDictionaries(&saved_list);
+  EXPECT_EQ(1u, saved_list.size());
+}
+
 TEST_F(SdchFilterTest, DictionaryNotTooLarge) {
   std::string dictionary_domain(".google.com");
   std::string dictionary_text(NewSdchDictionary(dictionary_domain));
@@ -1390,4 +1417,121 @@ TEST_F(SdchFilterTest, LatencyTestControls) {
   EXPECT_FALSE(sdch_manager_->AllowLatencyExperiment(url2));
 }
 
+class CountingSdchManagerDelegate : public SdchManager::Delegate {
+ public:
+  CountingSdchManagerDelegate() : changes_(0) {}
+
+  virtual void DictionariesChanged(SdchManager* manager) OVERRIDE {
+    ++changes_;
+  }
+
+  int changes() const { return changes_; }
+
+ private:
+  int changes_;
+};
+
+class NullSdchFetcher : public SdchFetcher {
+ public:
+  NullSdchFetcher() {}
+
+  virtual void Schedule(const GURL& dictionary_url) OVERRIDE {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullSdchFetcher);
+};
+
+TEST_F(SdchFilterTest, DontSaveUnpersistableDictionary) {
+  const std::string kSampleDomain = "sdchtest.com";
+  GURL page_url("http://" + kSampleDomain + "/page");
+  GURL url("http://" + kSampleDomain + "/dictionary");
+  sdch_manager_->set_sdch_fetcher(new NullSdchFetcher);
+
+  CountingSdchManagerDelegate delegate;
+  sdch_manager_->SetDelegate(&delegate);
+  sdch_manager_->FetchDictionary(page_url, url, false);
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(
+      NewSdchDictionary(kSampleDomain), url));
+  EXPECT_EQ(0, delegate.changes());
+  SdchManager::SavedDictionaryList saved;
+  sdch_manager_->GetSavedDictionaries(&saved);
+  EXPECT_TRUE(saved.empty());
+
+  // It is saved once a request which may save it asks for it too.
+  sdch_manager_->FetchDictionary(page_url, url, true);
+  EXPECT_EQ(1, delegate.changes());
+  sdch_manager_->GetSavedDictionaries(&saved);
+  EXPECT_EQ(1u, saved.size());
+  sdch_manager_->SetDelegate(NULL);
+}
+
+TEST_F(SdchFilterTest, RestoreSavedDictionary) {
+  const std::string kSampleDomain = "sdchtest.com";
+  std::string dictionary(NewSdchDictionary(kSampleDomain));
+  GURL url("http://" + kSampleDomain);
+
+  CountingSdchManagerDelegate delegate;
+  sdch_manager_->SetDelegate(&delegate);
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(dictionary, url));
+  EXPECT_EQ(1, delegate.changes());
+  sdch_manager_->SetDelegate(NULL);
+
+  SdchManager::SavedDictionaryList saved;
+  sdch_manager_->GetSavedDictionaries(&saved);
+  ASSERT_EQ(1u, saved.size());
+  EXPECT_EQ(dictionary, saved[0].text);
+  EXPECT_EQ(url, saved[0].url);
+
+  // Simulate a restart.
+  sdch_manager_.reset();
+  sdch_manager_.reset(new SdchManager);
+  sdch_manager_->SetDelegate(&delegate);
+  EXPECT_TRUE(sdch_manager_->RestoreSdchDictionary(saved[0]));
+  EXPECT_EQ(1, delegate.changes());
+  EXPECT_FALSE(sdch_manager_->RestoreSdchDictionary(saved[0]));
+  sdch_manager_->SetDelegate(NULL);
+
+  std::string client_hash;
+  std::string server_hash;
+  SdchManager::GenerateHash(dictionary, &client_hash, &server_hash);
+  std::string list;
+  sdch_manager_->GetAvailDictionaryList(url, &list);
+  EXPECT_EQ(client_hash, list);
+
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(Filter::FILTER_TYPE_SDCH);
+  MockFilterContext filter_context;
+  filter_context.SetURL(url);
+  scoped_ptr<Filter> filter(Filter::Factory(filter_types, filter_context));
+
+  std::string output;
+  EXPECT_TRUE(FilterTestData(NewSdchCompressedData(dictionary), 100, 100,
+                             filter.get(), &output));
+  EXPECT_EQ(expanded_, output);
+}
+
+TEST_F(SdchFilterTest, DontRestoreExpiredDictionary) {
+  const std::string kSampleDomain = "sdchtest.com";
+  GURL url("http://" + kSampleDomain);
+
+  SdchManager::SavedDictionary saved;
+  saved.text = "Max-Age: 3600\n" + NewSdchDictionary(kSampleDomain);
+  saved.url = url;
+  saved.added = base::Time::Now() - base::TimeDelta::FromHours(2);
+  EXPECT_FALSE(sdch_manager_->RestoreSdchDictionary(saved));
+
+  saved.added = base::Time::Now() - base::TimeDelta::FromMinutes(30);
+  EXPECT_TRUE(sdch_manager_->RestoreSdchDictionary(saved));
+
+  // It is saved again with the time it first arrived, not when restored.
+  SdchManager::SavedDictionaryList saved_list;
+  sdch_manager_->GetSavedDictionaries(&saved_list);
+  ASSERT_EQ(1u, saved_list.size());
+  EXPECT_EQ(saved.added, saved_list[0].added);
+
+  // Dictionaries which arrive already expired are not added either.
+  EXPECT_FALSE(sdch_manager_->AddSdchDictionary(
+      "Max-Age: 0\n" + NewSdchDictionary(kSampleDomain), url));
+}
+
 }  // namespace net
@@ -28,6 +28,11 @@ SdchManager* SdchManager::global_ = NULL;
 // static
 bool SdchManager::g_sdch_enabled_ = true;
 
+//------------------------------------------------------------------------------
+SdchManager::SavedDictionary::SavedDictionary() {}
+
+SdchManager::SavedDictionary::~SavedDictionary() {}
+
 //------------------------------------------------------------------------------
 SdchManager::Dictionary::Dictionary(const std::string& dictionary_text,
                                     size_t offset,
@@ -35,15 +40,19 @@ SdchManager::Dictionary::Dictionary(const std::string& dictionary_text,
                                     const GURL& gurl,
                                     const std::string& domain,
                                     const std::string& path,
+                                    const base::Time& added,
                                     const base::Time& expiration,
                                     const std::set<int>& ports)
-    : text_(dictionary_text, offset),
+    : headers_(dictionary_text, 0, offset),
+      text_(dictionary_text, offset),
       client_hash_(client_hash),
       url_(gurl),
       domain_(domain),
       path_(path),
+      added_(added),
       expiration_(expiration),
-      ports_(ports) {
+      ports_(ports),
+      persist_(true) {
 }
 
 SdchManager::Dictionary::~Dictionary() {
@@ -206,7 +215,7 @@ bool SdchManager::Dictionary::DomainMatch(const GURL& gurl,
 }
 
 //------------------------------------------------------------------------------
-SdchManager::SdchManager() {
+SdchManager::SdchManager() : delegate_(NULL) {
   DCHECK(!global_);
   DCHECK(CalledOnValidThread());
   global_ = this;
@@ -246,6 +255,11 @@ void SdchManager::set_sdch_fetcher(SdchFetcher* fetcher) {
   fetcher_.reset(fetcher);
 }
 
+void SdchManager::SetDelegate(Delegate* delegate) {
+  DCHECK(CalledOnValidThread());
+  delegate_ = delegate;
+}
+
 // static
 void SdchManager::EnableSdchSupport(bool enabled) {
   g_sdch_enabled_ = enabled;
@@ -332,11 +346,31 @@ bool SdchManager::IsInSupportedDomain(const GURL& url) {
 }
 
 void SdchManager::FetchDictionary(const GURL& request_url,
-                                  const GURL& dictionary_url) {
+                                  const GURL& dictionary_url,
+                                  bool can_persist) {
   DCHECK(CalledOnValidThread());
-  if (SdchManager::Global()->CanFetchDictionary(request_url, dictionary_url) &&
-      fetcher_.get())
-    fetcher_->Schedule(dictionary_url);
+  if (!SdchManager::Global()->CanFetchDictionary(request_url, dictionary_url) ||
+      !fetcher_.get()) {
+    return;
+  }
+
+  if (!can_persist) {
+    unpersisted_dictionary_urls_.insert(dictionary_url);
+  } else {
+    unpersisted_dictionary_urls_.erase(dictionary_url);
+    // The fetcher only loads each URL once, so a dictionary which was first
+    // asked for off the record becomes savable here.
+    for (DictionaryMap::iterator it = dictionaries_.begin();
+         it != dictionaries_.end(); ++it) {
+      Dictionary* dictionary = it->second;
+      if (dictionary->url_ != dictionary_url || dictionary->persist_)
+        continue;
+      dictionary->persist_ = true;
+      if (delegate_)
+        delegate_->DictionariesChanged(this);
+    }
+  }
+  fetcher_->Schedule(dictionary_url);
 }
 
 bool SdchManager::CanFetchDictionary(const GURL& referring_url,
@@ -375,6 +409,67 @@ bool SdchManager::CanFetchDictionary(const GURL& referring_url,
 bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
     const GURL& dictionary_url) {
   DCHECK(CalledOnValidThread());
+  bool persist = unpersisted_dictionary_urls_.erase(dictionary_url) == 0;
+  if (!AddSdchDictionaryInternal(dictionary_text, dictionary_url,
+                                 base::Time::Now(), persist)) {
+    return false;
+  }
+  if (persist && delegate_)
+    delegate_->DictionariesChanged(this);
+  return true;
+}
+
+void SdchManager::ClearDictionaries() {
+  DCHECK(CalledOnValidThread());
+  if (dictionaries_.empty())
+    return;
+  for (DictionaryMap::iterator it = dictionaries_.begin();
+       it != dictionaries_.end(); ++it) {
+    it->second->Release();
+  }
+  dictionaries_.clear();
+  if (delegate_)
+    delegate_->DictionariesChanged(this);
+}
+
+void SdchManager::GetSavedDictionaries(
+    SavedDictionaryList* dictionaries) const {
+  DCHECK(CalledOnValidThread());
+  base::Time now = base::Time::Now();
+  for (DictionaryMap::const_iterator it = dictionaries_.begin();
+       it != dictionaries_.end(); ++it) {
+    const Dictionary* dictionary = it->second;
+    if (!dictionary->persist_ || dictionary->expiration_ <= now)
+      continue;
+    dictionaries->push_back(SavedDictionary());
+    SavedDictionary& saved = dictionaries->back();
+    saved.text = dictionary->headers_ + dictionary->text_;
+    saved.url = dictionary->url_;
+    saved.added = dictionary->added_;
+  }
+}
+
+bool SdchManager::RestoreSdchDictionary(const SavedDictionary& dictionary) {
+  DCHECK(CalledOnValidThread());
+  // The dictionary may have been fetched again before the saved ones were
+  // read, which is not worth reporting as a problem.
+  std::string client_hash;
+  std::string server_hash;
+  GenerateHash(dictionary.text, &client_hash, &server_hash);
+  if (dictionaries_.find(server_hash) != dictionaries_.end())
+    return false;
+  // After the clock is set back, a saved time may be in the future, and the
+  // dictionary would outlive its max-age.
+  if (dictionary.added > base::Time::Now())
+    return false;
+  return AddSdchDictionaryInternal(dictionary.text, dictionary.url,
+                                   dictionary.added, true);
+}
+
+bool SdchManager::AddSdchDictionaryInternal(const std::string& dictionary_text,
+                                            const GURL& dictionary_url,
+                                            const base::Time& added,
+                                            bool persist) {
   std::string client_hash;
   std::string server_hash;
   GenerateHash(dictionary_text, &client_hash, &server_hash);
@@ -385,7 +480,7 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
 
   std::string domain, path;
   std::set<int> ports;
-  base::Time expiration(base::Time::Now() + base::TimeDelta::FromDays(30));
+  base::Time expiration(added + base::TimeDelta::FromDays(30));
 
   if (dictionary_text.empty()) {
     SdchErrorRecovery(DICTIONARY_HAS_NO_TEXT);
@@ -430,7 +525,7 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
       } else if (name == "max-age") {
         int64 seconds;
         base::StringToInt64(value, &seconds);
-        expiration = base::Time::Now() + base::TimeDelta::FromSeconds(seconds);
+        expiration = added + base::TimeDelta::FromSeconds(seconds);
       } else if (name == "port") {
         int port;
         base::StringToInt(value, &port);
@@ -447,6 +542,12 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
   if (!Dictionary::CanSet(domain, path, ports, dictionary_url))
     return false;
 
+  // A dictionary which has already expired, such as a restored one which
+  // expired while it was on disk, would never be advertised, so there is no
+  // point in it taking up a slot.
+  if (expiration <= base::Time::Now())
+    return false;
+
   // TODO(jar): Remove these hacks to preclude a DOS attack involving piles of
   // useless dictionaries.  We should probably have a cache eviction plan,
   // instead of just blocking additions.  For now, with the spec in flux, it
@@ -455,6 +556,8 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
     SdchErrorRecovery(DICTIONARY_IS_TOO_LARGE);
     return false;
   }
+  if (kMaxDictionaryCount <= dictionaries_.size())
+    EvictExpiredDictionaries();
   if (kMaxDictionaryCount <= dictionaries_.size()) {
     SdchErrorRecovery(DICTIONARY_COUNT_EXCEEDED);
     return false;
@@ -465,12 +568,26 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
            << " and server hash " << server_hash;
   Dictionary* dictionary =
       new Dictionary(dictionary_text, header_end + 2, client_hash,
-                     dictionary_url, domain, path, expiration, ports);
+                     dictionary_url, domain, path, added, expiration, ports);
+  dictionary->persist_ = persist;
   dictionary->AddRef();
   dictionaries_[server_hash] = dictionary;
   return true;
 }
 
+void SdchManager::EvictExpiredDictionaries() {
+  base::Time now = base::Time::Now();
+  DictionaryMap::iterator it = dictionaries_.begin();
+  while (it != dictionaries_.end()) {
+    if (it->second->expiration_ > now) {
+      ++it;
+      continue;
+    }
+    it->second->Release();
+    dictionaries_.erase(it++);
+  }
+}
+
 void SdchManager::GetVcdiffDictionary(const std::string& server_hash,
     const GURL& referring_url, Dictionary** dictionary) {
   DCHECK(CalledOnValidThread());
@@ -23,6 +23,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
@@ -160,6 +161,29 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   static const size_t kMaxDictionarySize;
   static const size_t kMaxDictionaryCount;
 
+  // An interface for persisting the dictionaries, so that they survive a
+  // restart instead of being fetched again.
+  class NET_EXPORT Delegate {
+   public:
+    // This function may not block and may not reenter the SdchManager object.
+    virtual void DictionariesChanged(SdchManager* manager) = 0;
+
+   protected:
+    virtual ~Delegate() {}
+  };
+
+  // A dictionary as it arrived over the net, along with the time it arrived,
+  // which its expiration is measured from.
+  struct NET_EXPORT SavedDictionary {
+    SavedDictionary();
+    ~SavedDictionary();
+
+    std::string text;  // Including the metadata headers.
+    GURL url;
+    base::Time added;
+  };
+  typedef std::vector<SavedDictionary> SavedDictionaryList;
+
   // There is one instance of |Dictionary| for each memory-cached SDCH
   // dictionary.
   class NET_EXPORT_PRIVATE Dictionary : public base::RefCounted<Dictionary> {
@@ -181,6 +205,7 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
                const GURL& url,
                const std::string& domain,
                const std::string& path,
+               const base::Time& added,
                const base::Time& expiration,
                const std::set<int>& ports);
     ~Dictionary();
@@ -209,6 +234,10 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
     static bool DomainMatch(const GURL& url, const std::string& restriction);
 
 
+    // The metadata headers that preceded text_, kept so that the dictionary
+    // can be saved as it arrived.
+    const std::string headers_;
+
     // The actual text of the dictionary.
     std::string text_;
 
@@ -225,9 +254,14 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
     // of the dictionary.  The following are the known headers.
     const std::string domain_;
     const std::string path_;
+    const base::Time added_;
     const base::Time expiration_;  // Implied by max-age.
     const std::set<int> ports_;
 
+    // False if the dictionary was only ever asked for by requests whose
+    // dictionaries may not be saved, such as off the record ones.
+    bool persist_;
+
     DISALLOW_COPY_AND_ASSIGN(Dictionary);
   };
 
@@ -246,6 +280,10 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   // Register a fetcher that this class can use to obtain dictionaries.
   void set_sdch_fetcher(SdchFetcher* fetcher);
 
+  // Sets the delegate that is told when a dictionary is added.  The delegate
+  // is not owned, and must outlive this object or be unset with NULL.
+  void SetDelegate(Delegate* delegate);
+
   // Enables or disables SDCH compression.
   static void EnableSdchSupport(bool enabled);
 
@@ -286,8 +324,11 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   // Schedule the URL fetching to load a dictionary. This will always return
   // before the dictionary is actually loaded and added.
   // After the implied task does completes, the dictionary will have been
-  // cached in memory.
-  void FetchDictionary(const GURL& request_url, const GURL& dictionary_url);
+  // cached in memory.  Unless |can_persist| is true for this or a later
+  // request for |dictionary_url|, it won't be passed to the delegate to save.
+  void FetchDictionary(const GURL& request_url,
+                       const GURL& dictionary_url,
+                       bool can_persist);
 
   // Security test function used before initiating a FetchDictionary.
   // Return true if fetch is legal.
@@ -300,6 +341,20 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   bool AddSdchDictionary(const std::string& dictionary_text,
                          const GURL& dictionary_url);
 
+  // Removes all dictionaries, such as when the user clears their cache.
+  // Filters which are still using one keep their own reference to it.
+  void ClearDictionaries();
+
+  // Appends each dictionary which has not yet expired, and which may be
+  // saved, to |dictionaries|, so that the delegate can save them.
+  void GetSavedDictionaries(SavedDictionaryList* dictionaries) const;
+
+  // Adds a dictionary that was saved by GetSavedDictionaries(), with the same
+  // checks as AddSdchDictionary().  Its max-age is measured from when it was
+  // first added.  Returns false, without telling the delegate, if it has since
+  // expired or is already loaded.
+  bool RestoreSdchDictionary(const SavedDictionary& dictionary);
+
   // Find the vcdiff dictionary (the body of the sdch dictionary that appears
   // after the meta-data headers like Domain:...) with the given |server_hash|
   // to use to decompreses data that arrived as SDCH encoded content.  Check to
@@ -347,8 +402,29 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   // A simple implementation of a RFC 3548 "URL safe" base64 encoder.
   static void UrlSafeBase64Encode(const std::string& input,
                                   std::string* output);
+
+  // Parses and adds a dictionary which arrived at |added|, which is saved by
+  // GetSavedDictionaries() only if |persist|.  Shared by AddSdchDictionary()
+  // and RestoreSdchDictionary().
+  bool AddSdchDictionaryInternal(const std::string& dictionary_text,
+                                 const GURL& dictionary_url,
+                                 const base::Time& added,
+                                 bool persist);
+
+  // Drops the dictionaries which have expired, freeing their slots under
+  // kMaxDictionaryCount.  Filters which are still using one keep their own
+  // reference to it.
+  void EvictExpiredDictionaries();
+
   DictionaryMap dictionaries_;
 
+  // Told when a dictionary is added or removed, if set.
+  Delegate* delegate_;
+
+  // Dictionary URLs which have been scheduled for fetching only by requests
+  // whose dictionaries may not be saved.
+  std::set<GURL> unpersisted_dictionary_urls_;
+
   // An instance that can fetch a dictionary given a URL.
   scoped_ptr<SdchFetcher> fetcher_;
 
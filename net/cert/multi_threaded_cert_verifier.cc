@@ -11,6 +11,7 @@
 #include "base/compiler_specific.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/worker_pool.h"
@@ -78,6 +79,21 @@ const unsigned kMaxCacheEntries = 256;
 // The number of seconds for which we'll cache a cache entry.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
+// How long a job runs before it is assumed to be waiting on the network, such
+// as for revocation information, and no longer counts towards
+// max_concurrent_jobs_.
+const int kSlowJobMs = 100;
+
+// The version of the format written by SaveCache().  Saved caches of any other
+// version are ignored.
+const int kSavedCacheVersion = 1;
+
+// Returns the sequence number of |crl_set|, which is part of the cache key so
+// that results checked against an older CRLSet are not used.
+uint32 CRLSetSequence(const CRLSet* crl_set) {
+  return crl_set ? crl_set->sequence() : 0;
+}
+
 }  // namespace
 
 MultiThreadedCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
@@ -257,6 +273,7 @@ class CertVerifierWorker {
         cert_verifier_->HandleResult(cert_.get(),
                                      hostname_,
                                      flags_,
+                                     CRLSetSequence(crl_set_.get()),
                                      additional_trust_anchors_,
                                      error_,
                                      verify_result_);
@@ -320,9 +337,16 @@ class CertVerifierWorker {
 class CertVerifierJob {
  public:
   CertVerifierJob(CertVerifierWorker* worker,
+                  const MultiThreadedCertVerifier::RequestParams& key,
                   const BoundNetLog& net_log)
-      : start_time_(base::TimeTicks::Now()),
+      : key_(key),
+        ca_fingerprint_(worker->certificate()->ca_fingerprint()),
+        has_intermediates_(
+            !worker->certificate()->GetIntermediateCertificates().empty()),
+        warming_(false),
+        created_time_(base::TimeTicks::Now()),
         worker_(worker),
+        started_(false),
         net_log_(net_log) {
     net_log_.BeginEvent(
         NetLog::TYPE_CERT_VERIFIER_JOB,
@@ -334,11 +358,49 @@ class CertVerifierJob {
     if (worker_) {
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEvent(NetLog::TYPE_CERT_VERIFIER_JOB);
-      worker_->Cancel();
+      // A worker which was never started won't delete itself.
+      if (started_)
+        worker_->Cancel();
+      else
+        delete worker_;
       DeleteAllCanceled();
     }
   }
 
+  const MultiThreadedCertVerifier::RequestParams& key() const { return key_; }
+  const SHA1HashValue& ca_fingerprint() const { return ca_fingerprint_; }
+  bool has_intermediates() const { return has_intermediates_; }
+
+  // Whether this job is the first to verify its chain's intermediates.
+  bool warming() const { return warming_; }
+  void set_warming(bool warming) { warming_ = warming; }
+
+  base::TimeTicks start_time() const { return start_time_; }
+
+  // Starts the worker.  Returns false if it couldn't be started.
+  bool Start() {
+    DCHECK(!started_);
+    start_time_ = base::TimeTicks::Now();
+    UMA_HISTOGRAM_CUSTOM_TIMES("Net.CertVerifier_Job_Queue_Time",
+                               start_time_ - created_time_,
+                               base::TimeDelta::FromMilliseconds(1),
+                               base::TimeDelta::FromMinutes(10),
+                               100);
+    started_ = worker_->Start();
+    return started_;
+  }
+
+  // Returns the number of requests which haven't been canceled.
+  size_t num_waiting_requests() const {
+    size_t waiting = 0;
+    for (std::vector<CertVerifierRequest*>::const_iterator
+         i = requests_.begin(); i != requests_.end(); ++i) {
+      if (!(*i)->canceled())
+        ++waiting;
+    }
+    return waiting;
+  }
+
   void AddRequest(CertVerifierRequest* request) {
     request->net_log().AddEvent(
         NetLog::TYPE_CERT_VERIFIER_REQUEST_BOUND_TO_JOB,
@@ -352,13 +414,24 @@ class CertVerifierJob {
     worker_ = NULL;
     net_log_.EndEvent(NetLog::TYPE_CERT_VERIFIER_JOB);
     UMA_HISTOGRAM_CUSTOM_TIMES("Net.CertVerifier_Job_Latency",
-                               base::TimeTicks::Now() - start_time_,
+                               verify_result.verification_duration,
                                base::TimeDelta::FromMilliseconds(1),
                                base::TimeDelta::FromMinutes(10),
                                100);
     PostAll(verify_result);
   }
 
+  // Fails the requests when the worker couldn't be started.
+  void HandleStartFailure() {
+    DCHECK(!started_);
+    delete worker_;
+    worker_ = NULL;
+    net_log_.EndEvent(NetLog::TYPE_CERT_VERIFIER_JOB);
+    MultiThreadedCertVerifier::CachedResult verify_result;
+    verify_result.error = ERR_INSUFFICIENT_RESOURCES;  // Just a guess.
+    PostAll(verify_result);
+  }
+
  private:
   void PostAll(const MultiThreadedCertVerifier::CachedResult& verify_result) {
     std::vector<CertVerifierRequest*> requests;
@@ -382,9 +455,15 @@ class CertVerifierJob {
     }
   }
 
-  const base::TimeTicks start_time_;
+  const MultiThreadedCertVerifier::RequestParams key_;
+  const SHA1HashValue ca_fingerprint_;
+  const bool has_intermediates_;
+  bool warming_;
+  const base::TimeTicks created_time_;
+  base::TimeTicks start_time_;
   std::vector<CertVerifierRequest*> requests_;
   CertVerifierWorker* worker_;
+  bool started_;
   const BoundNetLog net_log_;
 };
 
@@ -394,8 +473,10 @@ MultiThreadedCertVerifier::MultiThreadedCertVerifier(
       requests_(0),
       cache_hits_(0),
       inflight_joins_(0),
+      max_concurrent_jobs_(0),
       verify_proc_(verify_proc),
-      trust_anchor_provider_(NULL) {
+      trust_anchor_provider_(NULL),
+      delegate_(NULL) {
   CertDatabase::GetInstance()->AddObserver(this);
 }
 
@@ -404,6 +485,13 @@ MultiThreadedCertVerifier::~MultiThreadedCertVerifier() {
   CertDatabase::GetInstance()->RemoveObserver(this);
 }
 
+void MultiThreadedCertVerifier::SetMaxConcurrentJobs(
+    size_t max_concurrent_jobs) {
+  DCHECK(CalledOnValidThread());
+  max_concurrent_jobs_ = max_concurrent_jobs;
+  StartPendingJobs();
+}
+
 void MultiThreadedCertVerifier::SetCertTrustAnchorProvider(
     CertTrustAnchorProvider* trust_anchor_provider) {
   DCHECK(CalledOnValidThread());
@@ -433,11 +521,20 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
           trust_anchor_provider_->GetAdditionalTrustAnchors() : empty_cert_list;
 
   const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags, additional_trust_anchors);
+                          hostname, flags, CRLSetSequence(crl_set),
+                          additional_trust_anchors);
   const CertVerifierCache::value_type* cached_entry =
       cache_.Get(key, CacheValidityPeriod(base::Time::Now()));
   if (cached_entry) {
     ++cache_hits_;
+    if (restored_.erase(key)) {
+      // Without the restored result, this would have been a verification.
+      UMA_HISTOGRAM_CUSTOM_TIMES("Net.CertVerifier_Restored_Latency_Saved",
+                                 cached_entry->verification_duration,
+                                 base::TimeDelta::FromMilliseconds(1),
+                                 base::TimeDelta::FromMinutes(10),
+                                 100);
+    }
     *out_req = NULL;
     *verify_result = cached_entry->result;
     return cached_entry->error;
@@ -463,11 +560,16 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
                                additional_trust_anchors,
                                this);
     job = new CertVerifierJob(
-        worker,
+        worker, key,
         BoundNetLog::Make(net_log.net_log(), NetLog::SOURCE_CERT_VERIFIER_JOB));
-    if (!worker->Start()) {
+    if (!HasCapacity()) {
+      pending_jobs_.push_back(job);
+      StartSlowJobTimer();
+    } else if (IsWaitingForIntermediates(job)) {
+      pending_jobs_.push_back(job);
+      StartSlowJobTimer();
+    } else if (!StartJob(job)) {
       delete job;
-      delete worker;
       *out_req = NULL;
       // TODO(wtc): log to the NetLog.
       LOG(ERROR) << "CertVerifierWorker couldn't be started.";
@@ -494,9 +596,11 @@ MultiThreadedCertVerifier::RequestParams::RequestParams(
     const SHA1HashValue& ca_fingerprint_arg,
     const std::string& hostname_arg,
     int flags_arg,
+    uint32 crl_set_sequence_arg,
     const CertificateList& additional_trust_anchors)
     : hostname(hostname_arg),
-      flags(flags_arg) {
+      flags(flags_arg),
+      crl_set_sequence(crl_set_sequence_arg) {
   hash_values.reserve(2 + additional_trust_anchors.size());
   hash_values.push_back(cert_fingerprint_arg);
   hash_values.push_back(ca_fingerprint_arg);
@@ -513,6 +617,8 @@ bool MultiThreadedCertVerifier::RequestParams::operator<(
   // memory and string comparisons.
   if (flags != other.flags)
     return flags < other.flags;
+  if (crl_set_sequence != other.crl_set_sequence)
+    return crl_set_sequence < other.crl_set_sequence;
   if (hostname != other.hostname)
     return hostname < other.hostname;
   return std::lexicographical_compare(
@@ -527,21 +633,15 @@ void MultiThreadedCertVerifier::HandleResult(
     X509Certificate* cert,
     const std::string& hostname,
     int flags,
+    uint32 crl_set_sequence,
     const CertificateList& additional_trust_anchors,
     int error,
     const CertVerifyResult& verify_result) {
   DCHECK(CalledOnValidThread());
 
   const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags, additional_trust_anchors);
-
-  CachedResult cached_result;
-  cached_result.error = error;
-  cached_result.result = verify_result;
-  base::Time now = base::Time::Now();
-  cache_.Put(
-      key, cached_result, CacheValidityPeriod(now),
-      CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+                          hostname, flags, crl_set_sequence,
+                          additional_trust_anchors);
 
   std::map<RequestParams, CertVerifierJob*>::iterator j;
   j = inflight_.find(key);
@@ -551,16 +651,317 @@ void MultiThreadedCertVerifier::HandleResult(
   }
   CertVerifierJob* job = j->second;
   inflight_.erase(j);
+  running_jobs_.remove(job);
+  if (job->warming()) {
+    warming_chains_.erase(job->ca_fingerprint());
+    // This only needs to remember the chains in use recently.
+    if (warm_chains_.size() >= kMaxCacheEntries)
+      warm_chains_.clear();
+    warm_chains_.insert(job->ca_fingerprint());
+  }
+
+  CachedResult cached_result;
+  cached_result.error = error;
+  cached_result.result = verify_result;
+  cached_result.verification_duration =
+      base::TimeTicks::Now() - job->start_time();
+  base::Time now = base::Time::Now();
+  cache_.Put(
+      key, cached_result, CacheValidityPeriod(now),
+      CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+  restored_.erase(key);
+  if (delegate_)
+    delegate_->CacheChanged(this);
+
+  // This is done before the callbacks, which may delete this object.
+  StartPendingJobs();
 
   job->HandleResult(cached_result);
   delete job;
 }
 
+bool MultiThreadedCertVerifier::HasCapacity() const {
+  if (max_concurrent_jobs_ == 0 ||
+      running_jobs_.size() < max_concurrent_jobs_) {
+    return true;
+  }
+  // Jobs which have run for long are at the front.
+  const base::TimeTicks slow_start =
+      base::TimeTicks::Now() - base::TimeDelta::FromMilliseconds(kSlowJobMs);
+  size_t slow_jobs = 0;
+  for (std::list<CertVerifierJob*>::const_iterator i = running_jobs_.begin();
+       i != running_jobs_.end() && (*i)->start_time() <= slow_start; ++i) {
+    ++slow_jobs;
+  }
+  return running_jobs_.size() - slow_jobs < max_concurrent_jobs_;
+}
+
+void MultiThreadedCertVerifier::StartSlowJobTimer() {
+  if (slow_job_timer_.IsRunning())
+    return;
+  // The first job to become slow is the oldest one which isn't yet.
+  const base::TimeDelta slow_job_time =
+      base::TimeDelta::FromMilliseconds(kSlowJobMs);
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::list<CertVerifierJob*>::const_iterator i = running_jobs_.begin();
+  while (i != running_jobs_.end() && (*i)->start_time() + slow_job_time <= now)
+    ++i;
+  if (i == running_jobs_.end())
+    return;
+  slow_job_timer_.Start(FROM_HERE, (*i)->start_time() + slow_job_time - now,
+                        this, &MultiThreadedCertVerifier::StartPendingJobs);
+}
+
+bool MultiThreadedCertVerifier::IsWaitingForIntermediates(
+    const CertVerifierJob* job) const {
+  // Like the limit itself, waiting is opt-in.  Chains without intermediates
+  // have nothing to share.
+  if (max_concurrent_jobs_ == 0 || !job->has_intermediates())
+    return false;
+  std::map<SHA1HashValue, const CertVerifierJob*,
+           SHA1HashValueLessThan>::const_iterator i =
+      warming_chains_.find(job->ca_fingerprint());
+  if (i == warming_chains_.end())
+    return false;
+  const base::TimeTicks slow_start =
+      base::TimeTicks::Now() - base::TimeDelta::FromMilliseconds(kSlowJobMs);
+  return i->second->start_time() > slow_start;
+}
+
+bool MultiThreadedCertVerifier::StartJob(CertVerifierJob* job) {
+  if (!job->Start())
+    return false;
+  running_jobs_.push_back(job);
+  if (job->has_intermediates() &&
+      warm_chains_.find(job->ca_fingerprint()) == warm_chains_.end()) {
+    warming_chains_.insert(std::make_pair(job->ca_fingerprint(), job));
+    job->set_warming(true);
+  }
+  return true;
+}
+
+void MultiThreadedCertVerifier::StartPendingJobs() {
+  std::vector<CertVerifierJob*> failed_jobs;
+  while (HasCapacity() && !pending_jobs_.empty()) {
+    // Each request is a connection blocked on the job, so the job with the
+    // most requests goes first, and the oldest of those.
+    std::list<CertVerifierJob*>::iterator best = pending_jobs_.end();
+    size_t best_waiting = 0;
+    for (std::list<CertVerifierJob*>::iterator i = pending_jobs_.begin();
+         i != pending_jobs_.end();) {
+      CertVerifierJob* job = *i;
+      size_t waiting = job->num_waiting_requests();
+      if (waiting == 0) {
+        // Every request was canceled, so there is no need to verify.
+        i = pending_jobs_.erase(i);
+        inflight_.erase(job->key());
+        delete job;
+        continue;
+      }
+      if (waiting > best_waiting && !IsWaitingForIntermediates(job)) {
+        best = i;
+        best_waiting = waiting;
+      }
+      ++i;
+    }
+    if (best == pending_jobs_.end())
+      break;
+
+    CertVerifierJob* job = *best;
+    pending_jobs_.erase(best);
+    if (!StartJob(job)) {
+      LOG(ERROR) << "CertVerifierWorker couldn't be started.";
+      inflight_.erase(job->key());
+      failed_jobs.push_back(job);
+    }
+  }
+
+  // Jobs which are still pending wait for capacity or for intermediates,
+  // either of which may free up once a running job becomes slow.
+  if (!pending_jobs_.empty())
+    StartSlowJobTimer();
+
+  // The callbacks may delete this object, so they're run last.
+  for (size_t i = 0; i < failed_jobs.size(); ++i) {
+    failed_jobs[i]->HandleStartFailure();
+    delete failed_jobs[i];
+  }
+}
+
+void MultiThreadedCertVerifier::SetDelegate(Delegate* delegate) {
+  DCHECK(CalledOnValidThread());
+  delegate_ = delegate;
+}
+
+void MultiThreadedCertVerifier::SaveCache(std::string* data) {
+  DCHECK(CalledOnValidThread());
+
+  // Expired results are skipped, so the rest are collected first to write
+  // their count.
+  std::vector<const CertVerifierCache::value_type*> results;
+  std::vector<const RequestParams*> keys;
+  std::vector<CacheValidityPeriod> periods;
+  const CacheValidityPeriod now(base::Time::Now());
+  CacheExpirationFunctor expiration_comp;
+  for (CertVerifierCache::Iterator it(cache_); it.HasNext(); it.Advance()) {
+    if (!expiration_comp(now, it.expiration()))
+      continue;
+    keys.push_back(&it.key());
+    results.push_back(&it.value());
+    periods.push_back(it.expiration());
+  }
+
+  Pickle pickle;
+  pickle.WriteInt(kSavedCacheVersion);
+  pickle.WriteUInt64(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const RequestParams& key = *keys[i];
+    pickle.WriteString(key.hostname);
+    pickle.WriteInt(key.flags);
+    pickle.WriteUInt32(key.crl_set_sequence);
+    pickle.WriteUInt64(key.hash_values.size());
+    for (size_t j = 0; j < key.hash_values.size(); ++j) {
+      pickle.WriteBytes(key.hash_values[j].data,
+                        sizeof(key.hash_values[j].data));
+    }
+
+    const CachedResult& cached = *results[i];
+    const CertVerifyResult& result = cached.result;
+    pickle.WriteInt(cached.error);
+    pickle.WriteBool(result.verified_cert.get() != NULL);
+    if (result.verified_cert.get())
+      result.verified_cert->Persist(&pickle);
+    pickle.WriteUInt32(result.cert_status);
+    pickle.WriteBool(result.has_md5);
+    pickle.WriteBool(result.has_md2);
+    pickle.WriteBool(result.has_md4);
+    pickle.WriteBool(result.is_issued_by_known_root);
+    pickle.WriteBool(result.is_issued_by_additional_trust_anchor);
+    pickle.WriteUInt64(result.public_key_hashes.size());
+    for (size_t j = 0; j < result.public_key_hashes.size(); ++j)
+      pickle.WriteString(result.public_key_hashes[j].ToString());
+    pickle.WriteInt64(cached.verification_duration.ToInternalValue());
+
+    pickle.WriteInt64(periods[i].verification_time.ToInternalValue());
+    pickle.WriteInt64(periods[i].expiration_time.ToInternalValue());
+  }
+
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+bool MultiThreadedCertVerifier::RestoreCache(const std::string& data) {
+  DCHECK(CalledOnValidThread());
+
+  Pickle pickle(data.data(), data.size());
+  PickleIterator iter(pickle);
+  int version;
+  uint64 count;
+  if (!pickle.ReadInt(&iter, &version) || version != kSavedCacheVersion ||
+      !pickle.ReadUInt64(&iter, &count)) {
+    return false;
+  }
+
+  const base::Time now = base::Time::Now();
+  int restored = 0;
+  for (uint64 i = 0; i < count; ++i) {
+    std::string hostname;
+    int flags;
+    uint32 crl_set_sequence;
+    uint64 hash_count;
+    if (!pickle.ReadString(&iter, &hostname) ||
+        !pickle.ReadInt(&iter, &flags) ||
+        !pickle.ReadUInt32(&iter, &crl_set_sequence) ||
+        !pickle.ReadUInt64(&iter, &hash_count) ||
+        hash_count < 2) {
+      return false;
+    }
+    std::vector<SHA1HashValue> hash_values;
+    for (uint64 j = 0; j < hash_count; ++j) {
+      SHA1HashValue hash_value;
+      const char* bytes;
+      if (!pickle.ReadBytes(&iter, &bytes, sizeof(hash_value.data)))
+        return false;
+      memcpy(hash_value.data, bytes, sizeof(hash_value.data));
+      hash_values.push_back(hash_value);
+    }
+    RequestParams key(hash_values[0], hash_values[1], hostname, flags,
+                      crl_set_sequence, CertificateList());
+    key.hash_values.swap(hash_values);
+
+    CachedResult cached;
+    CertVerifyResult& result = cached.result;
+    bool has_verified_cert;
+    if (!pickle.ReadInt(&iter, &cached.error) ||
+        !pickle.ReadBool(&iter, &has_verified_cert)) {
+      return false;
+    }
+    if (has_verified_cert) {
+      result.verified_cert = X509Certificate::CreateFromPickle(
+          pickle, &iter, X509Certificate::PICKLETYPE_CERTIFICATE_CHAIN_V3);
+      if (!result.verified_cert.get())
+        return false;
+    }
+    uint64 public_key_hash_count;
+    if (!pickle.ReadUInt32(&iter, &result.cert_status) ||
+        !pickle.ReadBool(&iter, &result.has_md5) ||
+        !pickle.ReadBool(&iter, &result.has_md2) ||
+        !pickle.ReadBool(&iter, &result.has_md4) ||
+        !pickle.ReadBool(&iter, &result.is_issued_by_known_root) ||
+        !pickle.ReadBool(&iter, &result.is_issued_by_additional_trust_anchor) ||
+        !pickle.ReadUInt64(&iter, &public_key_hash_count)) {
+      return false;
+    }
+    for (uint64 j = 0; j < public_key_hash_count; ++j) {
+      std::string hash_string;
+      HashValue hash;
+      if (!pickle.ReadString(&iter, &hash_string) ||
+          !hash.FromString(hash_string)) {
+        return false;
+      }
+      result.public_key_hashes.push_back(hash);
+    }
+    int64 duration;
+    int64 verification_time;
+    int64 expiration_time;
+    if (!pickle.ReadInt64(&iter, &duration) ||
+        !pickle.ReadInt64(&iter, &verification_time) ||
+        !pickle.ReadInt64(&iter, &expiration_time)) {
+      return false;
+    }
+    cached.verification_duration = base::TimeDelta::FromInternalValue(duration);
+    const CacheValidityPeriod period(
+        base::Time::FromInternalValue(verification_time),
+        base::Time::FromInternalValue(expiration_time));
+
+    // Results which have expired since they were saved are dropped, as are
+    // ones already verified again in this session, which are newer.
+    if (!CacheExpirationFunctor()(CacheValidityPeriod(now), period) ||
+        cache_.Get(key, CacheValidityPeriod(now))) {
+      continue;
+    }
+    cache_.Put(key, cached, CacheValidityPeriod(now), period);
+    restored_.insert(key);
+    ++restored;
+  }
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Net.CertVerifier_Restored_Results", restored,
+                              1, kMaxCacheEntries, 50);
+  return true;
+}
+
+void MultiThreadedCertVerifier::ClearCache() {
+  cache_.Clear();
+  restored_.clear();
+  warm_chains_.clear();
+}
+
 void MultiThreadedCertVerifier::OnCertTrustChanged(
     const X509Certificate* cert) {
   DCHECK(CalledOnValidThread());
 
   ClearCache();
+  // The saved results were verified against the old trust settings too.
+  if (delegate_)
+    delegate_->CacheChanged(this);
 }
 
 }  // namespace net
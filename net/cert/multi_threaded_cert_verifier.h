@@ -5,7 +5,9 @@
 #ifndef NET_CERT_MULTI_THREADED_CERT_VERIFIER_H_
 #define NET_CERT_MULTI_THREADED_CERT_VERIFIER_H_
 
+#include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,8 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "net/base/completion_callback.h"
 #include "net/base/expiring_cache.h"
 #include "net/base/hash_value.h"
@@ -32,11 +36,35 @@ class CertVerifyProc;
 
 // MultiThreadedCertVerifier is a CertVerifier implementation that runs
 // synchronous CertVerifier implementations on worker threads.
-class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
+//
+// Only a few verifications run at once, so that a burst of new connections
+// doesn't start hundreds of worker threads which all compete for the CPU and
+// finish late together.  The others wait in a queue, and the ones which the
+// most requests are waiting for start first.  A verification
+// which has run for a while is probably waiting for the network rather than
+// using the CPU, so it stops counting towards the limit.  While a chain's
+// intermediates are being verified for the first time, other jobs for chains
+// with the same intermediates wait for it, so that the work of verifying the
+// intermediates (and of fetching any revocation information for them) is done
+// once, and the waiting jobs are served from the platform's caches.
+class NET_EXPORT MultiThreadedCertVerifier
     : public CertVerifier,
       NON_EXPORTED_BASE(public base::NonThreadSafe),
       public CertDatabase::Observer {
  public:
+  // An interface for persisting the cache of verification results, so that
+  // a restart doesn't have to verify every certificate chain again.
+  class NET_EXPORT Delegate {
+   public:
+    // Called when a result is added to the cache, or the cache is cleared.
+    // This function may not block and may not reenter the
+    // MultiThreadedCertVerifier object.
+    virtual void CacheChanged(MultiThreadedCertVerifier* verifier) = 0;
+
+   protected:
+    virtual ~Delegate() {}
+  };
+
   explicit MultiThreadedCertVerifier(CertVerifyProc* verify_proc);
 
   // When the verifier is destroyed, all certificate verifications requests are
@@ -53,6 +81,13 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   void SetCertTrustAnchorProvider(
       CertTrustAnchorProvider* trust_anchor_provider);
 
+  // Limits how many verifications may run at once; the others wait for one to
+  // finish, or to run for long enough that it is probably waiting on the
+  // network.  With a limit, a verification also waits while another one
+  // verifies the same intermediates for the first time.  0, the default,
+  // means no limit and no waiting.
+  void SetMaxConcurrentJobs(size_t max_concurrent_jobs);
+
   // CertVerifier implementation
   virtual int Verify(X509Certificate* cert,
                      const std::string& hostname,
@@ -65,6 +100,25 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
 
   virtual void CancelRequest(CertVerifier::RequestHandle req) OVERRIDE;
 
+  // Sets the delegate that is told when the cache changes.  The delegate is
+  // not owned, and must outlive this object or be unset with NULL.
+  void SetDelegate(Delegate* delegate);
+
+  // Serializes the cached results which have not yet expired into |data|.
+  void SaveCache(std::string* data);
+
+  // Adds the results in |data|, which was written by SaveCache(), to the
+  // cache.  Results which have expired since, or which are already cached, are
+  // skipped.  Returns false if |data| could not be parsed; results read before
+  // the error are kept.
+  //
+  // Since results are keyed by the CRLSet sequence and any additional trust
+  // anchors, a result restored from before a CRLSet update or a change to the
+  // additional trust anchors is never used.  A change to the trust settings
+  // while this object exists clears both the cache and, through the delegate,
+  // the saved results.
+  bool RestoreCache(const std::string& data);
+
  private:
   friend class CertVerifierWorker;  // Calls HandleResult.
   friend class CertVerifierRequest;
@@ -78,6 +132,17 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                            RequestParamsComparators);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            CertTrustAnchorProvider);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, SaveAndRestoreCache);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           SaveSkipsExpiredResults);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           LimitsConcurrentJobs);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           WaitsForSharedIntermediates);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           WaitingForIntermediatesIsOptIn);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           DoesntWaitForHungIntermediates);
 
   // Input parameters of a certificate verification request.
   struct NET_EXPORT_PRIVATE RequestParams {
@@ -85,6 +150,7 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                   const SHA1HashValue& ca_fingerprint_arg,
                   const std::string& hostname_arg,
                   int flags_arg,
+                  uint32 crl_set_sequence_arg,
                   const CertificateList& additional_trust_anchors);
     ~RequestParams();
 
@@ -92,6 +158,8 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
 
     std::string hostname;
     int flags;
+    // The sequence of the CRLSet the result was checked against, or 0.
+    uint32 crl_set_sequence;
     std::vector<SHA1HashValue> hash_values;
   };
 
@@ -102,6 +170,10 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
 
     int error;  // The return value of CertVerifier::Verify.
     CertVerifyResult result;  // The output of CertVerifier::Verify.
+
+    // How long the verification took, to measure the time saved by
+    // restoring the cache.
+    base::TimeDelta verification_duration;
   };
 
   // Rather than having a single validity point along a monotonically increasing
@@ -132,15 +204,38 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   void HandleResult(X509Certificate* cert,
                     const std::string& hostname,
                     int flags,
+                    uint32 crl_set_sequence,
                     const CertificateList& additional_trust_anchors,
                     int error,
                     const CertVerifyResult& verify_result);
 
+  // Returns true if there is no |max_concurrent_jobs_|, or if fewer than that
+  // many jobs have started recently and are still running.
+  bool HasCapacity() const;
+
+  // Returns true if there is a |max_concurrent_jobs_| and |job| should wait
+  // for another job to verify the intermediates it shares with |job|.  Like a
+  // slow job, one which has run for long is assumed to be waiting on the
+  // network, and isn't waited for.
+  bool IsWaitingForIntermediates(const CertVerifierJob* job) const;
+
+  // Starts |job| on a worker thread, and returns false if it couldn't be.
+  bool StartJob(CertVerifierJob* job);
+
+  // Starts the waiting jobs which may start, highest priority first.
+  void StartPendingJobs();
+
+  // Starts |slow_job_timer_| for when the next running job will have run for
+  // long enough to stop counting against |max_concurrent_jobs_|.
+  void StartSlowJobTimer();
+
   // CertDatabase::Observer methods:
   virtual void OnCertTrustChanged(const X509Certificate* cert) OVERRIDE;
 
   // For unit testing.
-  void ClearCache() { cache_.Clear(); }
+  size_t running_jobs() const { return running_jobs_.size(); }
+  size_t pending_jobs() const { return pending_jobs_.size(); }
+  void ClearCache();
   size_t GetCacheSize() const { return cache_.size(); }
   uint64 cache_hits() const { return cache_hits_; }
   uint64 requests() const { return requests_; }
@@ -149,10 +244,36 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   // cache_ maps from a request to a cached result.
   CertVerifierCache cache_;
 
+  // The keys of the results added by RestoreCache() which haven't been used
+  // yet.  The first use of each one is a verification saved by the restore.
+  std::set<RequestParams> restored_;
+
   // inflight_ maps from a request to an active verification which is taking
-  // place.
+  // place or waiting to.
   std::map<RequestParams, CertVerifierJob*> inflight_;
 
+  // The jobs in |inflight_| which haven't started yet, oldest first.
+  std::list<CertVerifierJob*> pending_jobs_;
+
+  // 0 if there is no limit.
+  size_t max_concurrent_jobs_;
+
+  // The jobs in |inflight_| which have started, oldest first.
+  std::list<CertVerifierJob*> running_jobs_;
+
+  // Calls StartPendingJobs() once a running job has run for long enough that
+  // it no longer counts against |max_concurrent_jobs_|.
+  base::OneShotTimer<MultiThreadedCertVerifier> slow_job_timer_;
+
+  // Maps the CA fingerprints of the chains whose intermediates are being
+  // verified for the first time to the jobs verifying them.
+  std::map<SHA1HashValue, const CertVerifierJob*, SHA1HashValueLessThan>
+      warming_chains_;
+
+  // The CA fingerprints of the chains whose intermediates have been verified
+  // since the trust settings last changed.
+  std::set<SHA1HashValue, SHA1HashValueLessThan> warm_chains_;
+
   uint64 requests_;
   uint64 cache_hits_;
   uint64 inflight_joins_;
@@ -161,6 +282,9 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
 
   CertTrustAnchorProvider* trust_anchor_provider_;
 
+  // Told when the cache changes, if set.
+  Delegate* delegate_;
+
   DISALLOW_COPY_AND_ASSIGN(MultiThreadedCertVerifier);
 };
 
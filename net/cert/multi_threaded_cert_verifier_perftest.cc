@@ -0,0 +1,203 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/message_loop/message_loop.h"
+#include "base/perftimer.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_data_directory.h"
+#include "net/cert/cert_verify_proc.h"
+#include "net/cert/cert_verify_result.h"
+#include "net/cert/multi_threaded_cert_verifier.h"
+#include "net/cert/x509_certificate.h"
+#include "net/test/cert_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// A connection storm: this many requests at once, for this many hosts, whose
+// certificates are issued by this many intermediates.
+const int kRequests = 2000;
+const int kHosts = 500;
+const char* const kIntermediateFiles[] = {
+  "verisign_intermediate_ca_2011.pem",
+  "verisign_intermediate_ca_2016.pem",
+  "thawte.single.pem",
+  "2029_globalsign_com_cert.pem",
+};
+
+// The simulated cost of checking the signatures, which takes CPU time, and of
+// the first check of a set of intermediates, which waits for revocation
+// information about them to be fetched.
+const int kSignatureCostMs = 1;
+const int kIntermediatesCostMs = 20;
+
+// Spins for |cost_ms| milliseconds of CPU time.
+void SpendCpuTime(int cost_ms) {
+  if (!base::TimeTicks::IsThreadNowSupported()) {
+    base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(cost_ms));
+    return;
+  }
+  const base::TimeTicks end =
+      base::TimeTicks::ThreadNow() + base::TimeDelta::FromMilliseconds(cost_ms);
+  while (base::TimeTicks::ThreadNow() < end) {
+  }
+}
+
+// Simulates the cost of verification, with the platform caching what it
+// learns about intermediates once a verification using them finishes.
+class SimulatedCertVerifyProc : public CertVerifyProc {
+ public:
+  SimulatedCertVerifyProc() {}
+
+ private:
+  virtual ~SimulatedCertVerifyProc() {}
+
+  // CertVerifyProc:
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    bool cached;
+    {
+      base::AutoLock lock(lock_);
+      cached = verified_chains_.count(cert->ca_fingerprint()) != 0;
+    }
+    if (!cached) {
+      base::PlatformThread::Sleep(
+          base::TimeDelta::FromMilliseconds(kIntermediatesCostMs));
+    }
+    SpendCpuTime(kSignatureCostMs);
+    {
+      base::AutoLock lock(lock_);
+      verified_chains_.insert(cert->ca_fingerprint());
+    }
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    return OK;
+  }
+
+  base::Lock lock_;
+  std::set<SHA1HashValue, SHA1HashValueLessThan> verified_chains_;
+};
+
+// Records how long each request took, and quits the message loop once they
+// are all done.
+class LatencyRecorder {
+ public:
+  explicit LatencyRecorder(int expected) : expected_(expected) {}
+
+  CompletionCallback callback() {
+    return base::Bind(&LatencyRecorder::OnComplete, base::Unretained(this),
+                      base::TimeTicks::Now());
+  }
+
+  void AddSynchronous() {
+    latencies_.push_back(base::TimeDelta());
+  }
+
+  bool done() const { return static_cast<int>(latencies_.size()) == expected_; }
+
+  // Returns the latency which |fraction| of the requests took no longer than.
+  base::TimeDelta Percentile(double fraction) {
+    std::sort(latencies_.begin(), latencies_.end());
+    size_t index = static_cast<size_t>(fraction * (latencies_.size() - 1));
+    return latencies_[index];
+  }
+
+ private:
+  void OnComplete(base::TimeTicks start_time, int result) {
+    EXPECT_EQ(OK, result);
+    latencies_.push_back(base::TimeTicks::Now() - start_time);
+    if (done())
+      base::MessageLoop::current()->Quit();
+  }
+
+  const int expected_;
+  std::vector<base::TimeDelta> latencies_;
+};
+
+// Starts |kRequests| verifications at once, at most |max_concurrent_jobs| at
+// a time (0 for no limit), and logs their throughput and latency as |name|.
+void RunConnectionStorm(const std::string& name, size_t max_concurrent_jobs) {
+  const base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> leaf(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_TRUE(leaf.get());
+  CertificateList chains;
+  for (size_t i = 0; i < arraysize(kIntermediateFiles); ++i) {
+    scoped_refptr<X509Certificate> intermediate(
+        ImportCertFromFile(certs_dir, kIntermediateFiles[i]));
+    ASSERT_TRUE(intermediate.get());
+    X509Certificate::OSCertHandles intermediates;
+    intermediates.push_back(intermediate->os_cert_handle());
+    chains.push_back(X509Certificate::CreateFromHandle(leaf->os_cert_handle(),
+                                                       intermediates));
+  }
+
+  MultiThreadedCertVerifier verifier(new SimulatedCertVerifyProc());
+  verifier.SetMaxConcurrentJobs(max_concurrent_jobs);
+  LatencyRecorder recorder(kRequests);
+  std::vector<CertVerifyResult> verify_results(kRequests);
+  PerfTimer timer;
+  for (int i = 0; i < kRequests; ++i) {
+    int host = i % kHosts;
+    CertVerifier::RequestHandle request_handle;
+    int rv = verifier.Verify(
+        chains[host % chains.size()].get(),
+        base::StringPrintf("host%d.example.com", host), 0, NULL,
+        &verify_results[i], recorder.callback(), &request_handle,
+        BoundNetLog());
+    if (rv != ERR_IO_PENDING) {
+      EXPECT_EQ(OK, rv);
+      recorder.AddSynchronous();
+    }
+  }
+  if (!recorder.done())
+    base::MessageLoop::current()->Run();
+  double seconds = timer.Elapsed().InSecondsF();
+
+  LogPerfResult((name + "_requests").c_str(), kRequests / seconds,
+                "requests/s");
+  LogPerfResult((name + "_verifications").c_str(), kHosts / seconds,
+                "verifications/s");
+  LogPerfResult((name + "_p50_latency").c_str(),
+                recorder.Percentile(0.5).InMillisecondsF(), "ms");
+  LogPerfResult((name + "_p99_latency").c_str(),
+                recorder.Percentile(0.99).InMillisecondsF(), "ms");
+}
+
+}  // namespace
+
+// Measures verifications per second and their tail latency when many new
+// connections need their certificates verified at once, with and without a
+// limit on concurrent verifications and the wait for shared intermediates
+// which comes with it.
+TEST(MultiThreadedCertVerifierPerfTest, ConnectionStorm) {
+  base::MessageLoopForIO message_loop;
+  RunConnectionStorm("cert_verifier_storm", 0);
+  RunConnectionStorm("cert_verifier_storm_limit_8", 8);
+}
+
+}  // namespace net
@@ -7,7 +7,9 @@
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/format_macros.h"
+#include "base/message_loop/message_loop.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
 #include "net/base/test_completion_callback.h"
@@ -15,6 +17,7 @@
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/crl_set.h"
 #include "net/cert/x509_certificate.h"
 #include "net/test/cert_test_util.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -35,7 +38,7 @@ class MockCertVerifyProc : public CertVerifyProc {
  public:
   MockCertVerifyProc() {}
 
- private:
+ protected:
   virtual ~MockCertVerifyProc() {}
 
   // CertVerifyProc implementation
@@ -56,6 +59,36 @@ class MockCertVerifyProc : public CertVerifyProc {
   }
 };
 
+// Like MockCertVerifyProc, but verifications for |hang_hostname| block until
+// |release| is signaled, as if waiting on a revocation server which doesn't
+// answer.
+class HangingCertVerifyProc : public MockCertVerifyProc {
+ public:
+  HangingCertVerifyProc(const std::string& hang_hostname,
+                        base::WaitableEvent* release)
+      : hang_hostname_(hang_hostname),
+        release_(release) {}
+
+ private:
+  virtual ~HangingCertVerifyProc() {}
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    if (hostname == hang_hostname_)
+      release_->Wait();
+    return MockCertVerifyProc::VerifyInternal(cert, hostname, flags, crl_set,
+                                              additional_trust_anchors,
+                                              verify_result);
+  }
+
+  const std::string hang_hostname_;
+  base::WaitableEvent* release_;
+};
+
 class MockCertTrustAnchorProvider : public CertTrustAnchorProvider {
  public:
   MockCertTrustAnchorProvider() {}
@@ -64,6 +97,46 @@ class MockCertTrustAnchorProvider : public CertTrustAnchorProvider {
   MOCK_METHOD0(GetAdditionalTrustAnchors, const CertificateList&());
 };
 
+// Records the order in which requests complete, and quits the message loop
+// once |expected| of them have.
+class CompletionRecorder {
+ public:
+  explicit CompletionRecorder(size_t expected) : expected_(expected) {}
+
+  CompletionCallback callback(int id) {
+    return base::Bind(&CompletionRecorder::OnComplete, base::Unretained(this),
+                      id);
+  }
+
+  const std::vector<int>& completed() const { return completed_; }
+
+ private:
+  void OnComplete(int id, int result) {
+    EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, result);
+    completed_.push_back(id);
+    if (completed_.size() == expected_)
+      base::MessageLoop::current()->Quit();
+  }
+
+  const size_t expected_;
+  std::vector<int> completed_;
+};
+
+class CountingDelegate : public MultiThreadedCertVerifier::Delegate {
+ public:
+  CountingDelegate() : changes_(0) {}
+  virtual ~CountingDelegate() {}
+
+  virtual void CacheChanged(MultiThreadedCertVerifier* verifier) OVERRIDE {
+    ++changes_;
+  }
+
+  int changes() const { return changes_; }
+
+ private:
+  int changes_;
+};
+
 }  // namespace
 
 class MultiThreadedCertVerifierTest : public ::testing::Test {
@@ -329,34 +402,34 @@ TEST_F(MultiThreadedCertVerifierTest, RequestParamsComparators) {
   } tests[] = {
     {  // Test for basic equivalence.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       0,
     },
     {  // Test that different certificates but with the same CA and for
        // the same host are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(z_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       -1,
     },
     {  // Test that the same EE certificate for the same host, but with
        // different chains are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, z_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       1,
     },
     {  // The same certificate, with the same chain, but for different
        // hosts are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www1.example.test", 0,
+                                               "www1.example.test", 0, 0,
                                                test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www2.example.test", 0,
+                                               "www2.example.test", 0, 0,
                                                test_list),
       -1,
     },
@@ -364,16 +437,24 @@ TEST_F(MultiThreadedCertVerifierTest, RequestParamsComparators) {
        // are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
                                                CertVerifier::VERIFY_EV_CERT,
-                                               test_list),
-      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
                                                0, test_list),
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 0, test_list),
+      1,
+    },
+    {  // The same certificate, chain, host and flags, but checked against
+       // different CRLSets are different validation keys.
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 2, test_list),
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 1, test_list),
       1,
     },
     {  // Different additional_trust_anchors.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, empty_list),
+                                               0, 0, empty_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       -1,
     },
   };
@@ -476,4 +557,289 @@ TEST_F(MultiThreadedCertVerifierTest, CertTrustAnchorProvider) {
   ASSERT_EQ(1u, verifier_.cache_hits());
 }
 
+// Tests that results saved by SaveCache() are used by another verifier after
+// RestoreCache(), without verifying again.
+TEST_F(MultiThreadedCertVerifierTest, SaveAndRestoreCache) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+
+  CountingDelegate delegate;
+  verifier_.SetDelegate(&delegate);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  error = verifier_.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback.WaitForResult());
+  EXPECT_EQ(1, delegate.changes());
+  verifier_.SetDelegate(NULL);
+
+  std::string data;
+  verifier_.SaveCache(&data);
+
+  MultiThreadedCertVerifier restored(new MockCertVerifyProc());
+  EXPECT_FALSE(restored.RestoreCache("not a saved cache"));
+  EXPECT_EQ(0u, restored.GetCacheSize());
+  EXPECT_TRUE(restored.RestoreCache(data));
+  ASSERT_EQ(1u, restored.GetCacheSize());
+
+  // Restoring the same results twice doesn't add them again.
+  EXPECT_TRUE(restored.RestoreCache(data));
+  EXPECT_EQ(1u, restored.GetCacheSize());
+
+  CertVerifyResult restored_result;
+  error = restored.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                          &restored_result, base::Bind(&FailTest),
+                          &request_handle, BoundNetLog());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, error);
+  EXPECT_FALSE(request_handle);
+  EXPECT_EQ(1u, restored.cache_hits());
+  EXPECT_EQ(verify_result.cert_status, restored_result.cert_status);
+  ASSERT_TRUE(restored_result.verified_cert.get());
+  EXPECT_TRUE(restored_result.verified_cert->Equals(test_cert.get()));
+
+  // A result restored from before a CRLSet update isn't used.
+  scoped_refptr<CRLSet> crl_set(CRLSet::EmptyCRLSetForTesting());
+  MultiThreadedCertVerifier::RequestParams key(
+      test_cert->fingerprint(), test_cert->ca_fingerprint(), "www.example.com",
+      0, crl_set->sequence() + 1, CertificateList());
+  EXPECT_FALSE(restored.cache_.Get(
+      key, MultiThreadedCertVerifier::CacheValidityPeriod(base::Time::Now())));
+
+  // Nor is one from before a change to the trust settings.
+  CountingDelegate restored_delegate;
+  restored.SetDelegate(&restored_delegate);
+  restored.OnCertTrustChanged(NULL);
+  EXPECT_EQ(0u, restored.GetCacheSize());
+  EXPECT_EQ(1, restored_delegate.changes());
+  restored.SetDelegate(NULL);
+}
+
+// Tests that results which have expired are not saved.
+TEST_F(MultiThreadedCertVerifierTest, SaveSkipsExpiredResults) {
+  SHA1HashValue a_key;
+  memset(a_key.data, 'a', sizeof(a_key.data));
+  SHA1HashValue z_key;
+  memset(z_key.data, 'z', sizeof(z_key.data));
+
+  MultiThreadedCertVerifier::CachedResult cached_result;
+  cached_result.error = OK;
+  const base::Time now = base::Time::Now();
+  const base::TimeDelta ttl = base::TimeDelta::FromMinutes(30);
+  verifier_.cache_.Put(
+      MultiThreadedCertVerifier::RequestParams(
+          a_key, a_key, "www.example.test", 0, 0, CertificateList()),
+      cached_result, MultiThreadedCertVerifier::CacheValidityPeriod(now),
+      MultiThreadedCertVerifier::CacheValidityPeriod(now, now + ttl));
+  verifier_.cache_.Put(
+      MultiThreadedCertVerifier::RequestParams(
+          z_key, a_key, "www.example.test", 0, 0, CertificateList()),
+      cached_result,
+      MultiThreadedCertVerifier::CacheValidityPeriod(now - ttl * 2),
+      MultiThreadedCertVerifier::CacheValidityPeriod(now - ttl * 2,
+                                                     now - ttl));
+  ASSERT_EQ(2u, verifier_.GetCacheSize());
+
+  std::string data;
+  verifier_.SaveCache(&data);
+
+  MultiThreadedCertVerifier restored(new MockCertVerifyProc());
+  EXPECT_TRUE(restored.RestoreCache(data));
+  EXPECT_EQ(1u, restored.GetCacheSize());
+}
+
+// Tests that no more than max_concurrent_jobs_ verifications run at once, and
+// that the waiting job with the most requests starts first.
+TEST_F(MultiThreadedCertVerifierTest, LimitsConcurrentJobs) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  verifier_.SetMaxConcurrentJobs(1);
+
+  const char* const kHostnames[] = {
+    "www1.example.com", "www2.example.com", "www3.example.com",
+    "www4.example.com",
+  };
+  CompletionRecorder recorder(4);
+  CertVerifyResult verify_results[arraysize(kHostnames) + 1];
+  CertVerifier::RequestHandle request_handles[arraysize(kHostnames) + 1];
+  for (size_t i = 0; i < arraysize(kHostnames); ++i) {
+    int error = verifier_.Verify(
+        test_cert.get(), kHostnames[i], 0, NULL, &verify_results[i],
+        recorder.callback(i), &request_handles[i], BoundNetLog());
+    ASSERT_EQ(ERR_IO_PENDING, error);
+  }
+  EXPECT_EQ(1u, verifier_.running_jobs());
+  EXPECT_EQ(3u, verifier_.pending_jobs());
+
+  // A second request for the third host moves it ahead of the second.
+  const size_t kJoined = arraysize(kHostnames);
+  int error = verifier_.Verify(
+      test_cert.get(), kHostnames[2], 0, NULL, &verify_results[kJoined],
+      recorder.callback(kJoined), &request_handles[kJoined], BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(1u, verifier_.inflight_joins());
+
+  // The fourth host's only request is canceled, so it is never verified.
+  verifier_.CancelRequest(request_handles[3]);
+
+  base::MessageLoop::current()->Run();
+  const std::vector<int>& completed = recorder.completed();
+  ASSERT_EQ(4u, completed.size());
+  EXPECT_EQ(0, completed[0]);
+  EXPECT_EQ(2, completed[1]);
+  EXPECT_EQ(static_cast<int>(kJoined), completed[2]);
+  EXPECT_EQ(1, completed[3]);
+  EXPECT_EQ(0u, verifier_.running_jobs());
+  EXPECT_EQ(0u, verifier_.pending_jobs());
+  EXPECT_EQ(3u, verifier_.GetCacheSize());
+}
+
+// Tests that a job waits while another job verifies the same intermediates
+// for the first time, but not once they have been verified.
+TEST_F(MultiThreadedCertVerifierTest, WaitsForSharedIntermediates) {
+  CertificateList certs = CreateCertificateListFromFile(
+      GetTestCertsDirectory(), "googlenew.chain.pem",
+      X509Certificate::FORMAT_PEM_CERT_SEQUENCE);
+  ASSERT_EQ(2u, certs.size());
+  X509Certificate::OSCertHandles intermediates;
+  intermediates.push_back(certs[1]->os_cert_handle());
+  scoped_refptr<X509Certificate> chain =
+      X509Certificate::CreateFromHandle(certs[0]->os_cert_handle(),
+                                        intermediates);
+
+  // The limit is high enough not to be what holds jobs up.
+  verifier_.SetMaxConcurrentJobs(10);
+
+  CertVerifyResult verify_result1;
+  TestCompletionCallback callback1;
+  CertVerifier::RequestHandle request_handle1;
+  int error = verifier_.Verify(chain.get(), "www1.example.com", 0, NULL,
+                               &verify_result1, callback1.callback(),
+                               &request_handle1, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+  error = verifier_.Verify(chain.get(), "www2.example.com", 0, NULL,
+                           &verify_result2, callback2.callback(),
+                           &request_handle2, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(1u, verifier_.running_jobs());
+  EXPECT_EQ(1u, verifier_.pending_jobs());
+
+  // The second job starts once the first is done.
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback1.WaitForResult());
+  EXPECT_EQ(0u, verifier_.pending_jobs());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback2.WaitForResult());
+
+  // Now that the intermediates have been verified, jobs sharing them run
+  // together.
+  CertVerifyResult verify_result3;
+  TestCompletionCallback callback3;
+  CertVerifier::RequestHandle request_handle3;
+  error = verifier_.Verify(chain.get(), "www3.example.com", 0, NULL,
+                           &verify_result3, callback3.callback(),
+                           &request_handle3, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  CertVerifyResult verify_result4;
+  TestCompletionCallback callback4;
+  CertVerifier::RequestHandle request_handle4;
+  error = verifier_.Verify(chain.get(), "www4.example.com", 0, NULL,
+                           &verify_result4, callback4.callback(),
+                           &request_handle4, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(2u, verifier_.running_jobs());
+  EXPECT_EQ(0u, verifier_.pending_jobs());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback3.WaitForResult());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback4.WaitForResult());
+}
+
+// Tests that without a limit, jobs sharing intermediates which haven't been
+// verified yet run together.
+TEST_F(MultiThreadedCertVerifierTest, WaitingForIntermediatesIsOptIn) {
+  CertificateList certs = CreateCertificateListFromFile(
+      GetTestCertsDirectory(), "googlenew.chain.pem",
+      X509Certificate::FORMAT_PEM_CERT_SEQUENCE);
+  ASSERT_EQ(2u, certs.size());
+  X509Certificate::OSCertHandles intermediates;
+  intermediates.push_back(certs[1]->os_cert_handle());
+  scoped_refptr<X509Certificate> chain =
+      X509Certificate::CreateFromHandle(certs[0]->os_cert_handle(),
+                                        intermediates);
+
+  CertVerifyResult verify_result1;
+  TestCompletionCallback callback1;
+  CertVerifier::RequestHandle request_handle1;
+  int error = verifier_.Verify(chain.get(), "www1.example.com", 0, NULL,
+                               &verify_result1, callback1.callback(),
+                               &request_handle1, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+  error = verifier_.Verify(chain.get(), "www2.example.com", 0, NULL,
+                           &verify_result2, callback2.callback(),
+                           &request_handle2, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(2u, verifier_.running_jobs());
+  EXPECT_EQ(0u, verifier_.pending_jobs());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback1.WaitForResult());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback2.WaitForResult());
+}
+
+// Tests that a job which takes long to verify a chain's intermediates for the
+// first time, such as one waiting on the network, doesn't hold up the other
+// jobs with the same intermediates.
+TEST_F(MultiThreadedCertVerifierTest, DoesntWaitForHungIntermediates) {
+  CertificateList certs = CreateCertificateListFromFile(
+      GetTestCertsDirectory(), "googlenew.chain.pem",
+      X509Certificate::FORMAT_PEM_CERT_SEQUENCE);
+  ASSERT_EQ(2u, certs.size());
+  X509Certificate::OSCertHandles intermediates;
+  intermediates.push_back(certs[1]->os_cert_handle());
+  scoped_refptr<X509Certificate> chain =
+      X509Certificate::CreateFromHandle(certs[0]->os_cert_handle(),
+                                        intermediates);
+
+  base::WaitableEvent release(true, false);
+  MultiThreadedCertVerifier verifier(
+      new HangingCertVerifyProc("www1.example.com", &release));
+  verifier.SetMaxConcurrentJobs(10);
+
+  CertVerifyResult verify_result1;
+  TestCompletionCallback callback1;
+  CertVerifier::RequestHandle request_handle1;
+  int error = verifier.Verify(chain.get(), "www1.example.com", 0, NULL,
+                              &verify_result1, callback1.callback(),
+                              &request_handle1, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+  error = verifier.Verify(chain.get(), "www2.example.com", 0, NULL,
+                          &verify_result2, callback2.callback(),
+                          &request_handle2, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(1u, verifier.running_jobs());
+  EXPECT_EQ(1u, verifier.pending_jobs());
+
+  // The second job starts once the first has run for long, and finishes
+  // while the first is still hung.
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback2.WaitForResult());
+  EXPECT_EQ(1u, verifier.running_jobs());
+  EXPECT_EQ(0u, verifier.pending_jobs());
+
+  release.Signal();
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback1.WaitForResult());
+}
+
 }  // namespace net
@@ -118,6 +118,10 @@ typedef std::vector<CanonicalCookie*> CanonicalCookieVector;
 // will update it again.
 const int kDefaultAccessUpdateThresholdSeconds = 60;
 
+// The number of hosts whose candidate cookies are cached at most; see
+// CookieMonster::host_cookies_.
+const size_t kMaxCachedHosts = 1000;
+
 // Comparator to sort cookies from highest creation date to lowest
 // creation date.
 struct OrderByCreationTimeDesc {
@@ -318,6 +322,7 @@ CookieMonster::CookieMonster(PersistentCookieStore* store, Delegate* delegate)
       last_access_threshold_(
           TimeDelta::FromSeconds(kDefaultAccessUpdateThresholdSeconds)),
       delegate_(delegate),
+      num_cached_hosts_(0),
       last_statistic_record_time_(Time::Now()),
       keep_expired_cookies_(false),
       persist_session_cookies_(false),
@@ -335,6 +340,7 @@ CookieMonster::CookieMonster(PersistentCookieStore* store,
       last_access_threshold_(base::TimeDelta::FromMilliseconds(
           last_access_threshold_milliseconds)),
       delegate_(delegate),
+      num_cached_hosts_(0),
       last_statistic_record_time_(base::Time::Now()),
       keep_expired_cookies_(false),
       persist_session_cookies_(false),
@@ -1314,8 +1320,7 @@ std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
   TimeTicks start_time(TimeTicks::Now());
 
   std::vector<CanonicalCookie*> cookies;
-  FindCookiesForHostAndDomain(url, options, true, &cookies);
-  std::sort(cookies.begin(), cookies.end(), CookieSorter);
+  FindSortedCookiesForHost(url, options, &cookies);
 
   std::string cookie_line = BuildCookieLine(cookies);
 
@@ -1702,6 +1707,67 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
   }
 }
 
+void CookieMonster::FindSortedCookiesForHost(
+    const GURL& url,
+    const CookieOptions& options,
+    std::vector<CanonicalCookie*>* cookies) {
+  lock_.AssertAcquired();
+
+  const Time current_time(CurrentTime());
+  RecordPeriodicStats(current_time);
+
+  const std::string host(url.host());
+  const std::string key(GetKey(host));
+  HostCookiesMap* key_hosts = &host_cookies_[key];
+  HostCookiesMap::iterator host_it = key_hosts->find(host);
+  if (host_it == key_hosts->end()) {
+    if (num_cached_hosts_ >= kMaxCachedHosts) {
+      host_cookies_.clear();
+      num_cached_hosts_ = 0;
+      key_hosts = &host_cookies_[key];
+    }
+    host_it = key_hosts->insert(
+        std::make_pair(host, std::vector<CanonicalCookie*>())).first;
+    ++num_cached_hosts_;
+    for (CookieMapItPair its = cookies_.equal_range(key);
+         its.first != its.second; ++its.first) {
+      if (its.first->second->IsDomainMatch(host))
+        host_it->second.push_back(its.first->second);
+    }
+    std::sort(host_it->second.begin(), host_it->second.end(), CookieSorter);
+  }
+
+  // Filtering keeps the candidates in order.  Access times don't affect the
+  // order either, so they can be updated as we go.
+  const std::vector<CanonicalCookie*>& candidates = host_it->second;
+  for (std::vector<CanonicalCookie*>::const_iterator it = candidates.begin();
+       it != candidates.end(); ++it) {
+    CanonicalCookie* cc = *it;
+    if (cc->IsExpired(current_time) && !keep_expired_cookies_) {
+      // Let FindCookiesForKey() delete the expired cookies, which also drops
+      // the cached candidates.
+      cookies->clear();
+      FindCookiesForKey(key, url, options, current_time, true, cookies);
+      std::sort(cookies->begin(), cookies->end(), CookieSorter);
+      return;
+    }
+    if (!cc->IncludeForRequestURL(url, options))
+      continue;
+    InternalUpdateCookieAccessTime(cc, current_time);
+    cookies->push_back(cc);
+  }
+}
+
+void CookieMonster::InvalidateHostCookies(const std::string& key) {
+  lock_.AssertAcquired();
+
+  std::map<std::string, HostCookiesMap>::iterator it = host_cookies_.find(key);
+  if (it == host_cookies_.end())
+    return;
+  num_cached_hosts_ -= it->second.size();
+  host_cookies_.erase(it);
+}
+
 bool CookieMonster::DeleteAnyEquivalentCookie(const std::string& key,
                                               const CanonicalCookie& ecc,
                                               bool skip_httponly,
@@ -1742,6 +1808,7 @@ void CookieMonster::InternalInsertCookie(const std::string& key,
       sync_to_store)
     store_->AddCookie(*cc);
   cookies_.insert(CookieMap::value_type(key, cc));
+  InvalidateHostCookies(key);
   if (delegate_.get()) {
     delegate_->OnCookieChanged(
         *cc, false, CookieMonster::Delegate::CHANGE_COOKIE_EXPLICIT);
@@ -1858,6 +1925,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
     if (mapping.notify)
       delegate_->OnCookieChanged(*cc, true, mapping.cause);
   }
+  InvalidateHostCookies(it->first);
   cookies_.erase(it);
   delete cc;
 }
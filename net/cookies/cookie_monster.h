@@ -506,6 +506,17 @@ class NET_EXPORT CookieMonster : public CookieStore {
                          bool update_access_time,
                          std::vector<CanonicalCookie*>* cookies);
 
+  // Like FindCookiesForHostAndDomain() with |update_access_time|, but returns
+  // the cookies already sorted for the cookie line, using the candidates
+  // cached in |host_cookies_| for the host of |url|.
+  void FindSortedCookiesForHost(const GURL& url,
+                                const CookieOptions& options,
+                                std::vector<CanonicalCookie*>* cookies);
+
+  // Drops the cached candidates of every host whose cookies are stored under
+  // CookieMap key |key|.  Called whenever such a cookie is added or deleted.
+  void InvalidateHostCookies(const std::string& key);
+
   // Delete any cookies that are equivalent to |ecc| (same path, domain, etc).
   // If |skip_httponly| is true, httponly cookies will not be deleted.  The
   // return value with be true if |skip_httponly| skipped an httponly cookie.
@@ -614,6 +625,16 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // For each CookieMap key, the hosts whose cookies have been asked for, and
+  // the cookies stored under the key which domain-match the host, sorted as
+  // in the cookie line.  Requests for a host only need to filter these by
+  // path, secure and httponly, rather than to scan and sort every cookie of
+  // the key.  |num_cached_hosts_| is the number of hosts in the cache, which
+  // is cleared rather than allowed to grow past kMaxCachedHosts.
+  typedef std::map<std::string, std::vector<CanonicalCookie*> > HostCookiesMap;
+  std::map<std::string, HostCookiesMap> host_cookies_;
+  size_t num_cached_hosts_;
+
   // Indicates whether the cookie store has been initialized. This happens
   // lazily in InitStoreIfNecessary().
   bool initialized_;
@@ -5,10 +5,12 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
 #include "base/perftimer.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_monster.h"
 #include "net/cookies/cookie_monster_store_test.h"
@@ -24,10 +26,59 @@ const int kNumCookies = 20000;
 const char kCookieLine[] = "A  = \"b=;\\\"\"  ;secure;;;";
 const char kGoogleURL[] = "http://www.google.izzle";
 
+// A large store: this many registrable domains, each with this many cookies
+// set by two hosts on two paths, some of them for the whole domain.
+const int kLargeStoreDomains = 500;
+const int kLargeStoreCookiesPerDomain = 20;
+const int kNumThreads = 4;
+
 int CountInString(const std::string& str, char c) {
   return std::count(str.begin(), str.end(), c);
 }
 
+// Creates a CookieMonster which imports the large store on first access, and
+// fills |urls| with a URL for each host of the store.
+CookieMonster* CreateLargeMonster(std::vector<GURL>* urls) {
+  scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
+  std::vector<CanonicalCookie*> initial_cookies;
+  // Creation times must be unique.
+  int64 time_tick(base::Time::Now().ToInternalValue());
+  for (int domain_num = 0; domain_num < kLargeStoreDomains; ++domain_num) {
+    std::string domain(base::StringPrintf("domain%d.com", domain_num));
+    for (int cookie_num = 0; cookie_num < kLargeStoreCookiesPerDomain;
+         ++cookie_num) {
+      // The cookie's domain: a host, or the whole domain.
+      std::string cookie_domain(cookie_num % 5 == 0 ? "." :
+                                cookie_num % 2 ? "www." : "mail.");
+      cookie_domain += domain;
+      std::string cookie_line(base::StringPrintf(
+          "Cookie%d=1; path=%s", cookie_num, cookie_num % 4 < 2 ? "/" : "/dir"));
+      AddCookieToList(cookie_domain, cookie_line,
+                      base::Time::FromInternalValue(time_tick++),
+                      &initial_cookies);
+    }
+    urls->push_back(GURL("http://www." + domain + "/dir/page.html"));
+    urls->push_back(GURL("http://mail." + domain + "/"));
+  }
+  store->SetLoadExpectation(true, initial_cookies);
+  return new CookieMonster(store.get(), NULL);
+}
+
+void IgnoreCookies(const std::string& cookies) {}
+
+// Gets the cookies for each of |urls|, |rounds| times over.
+void GetCookiesForURLs(CookieMonster* cm,
+                       const std::vector<GURL>* urls,
+                       int rounds) {
+  CookieOptions options;
+  for (int i = 0; i < rounds; ++i) {
+    for (std::vector<GURL>::const_iterator it = urls->begin();
+         it != urls->end(); ++it) {
+      cm->GetCookiesWithOptionsAsync(*it, options, base::Bind(&IgnoreCookies));
+    }
+  }
+}
+
 class CookieMonsterTest : public testing::Test {
  public:
   CookieMonsterTest() : message_loop_(new base::MessageLoopForIO()) {}
@@ -312,6 +363,51 @@ TEST_F(CookieMonsterTest, TestImport) {
   EXPECT_EQ("domain_1.com", cm->GetKey("www.Domain_1.com"));
 }
 
+TEST_F(CookieMonsterTest, TestQueryLargeStore) {
+  std::vector<GURL> urls;
+  scoped_refptr<CookieMonster> cm(CreateLargeMonster(&urls));
+  GetCookiesCallback getCookiesCallback;
+
+  // The first access imports the store.
+  EXPECT_EQ(12, CountInString(getCookiesCallback.GetCookies(cm.get(), urls[0]),
+                              '='));
+  EXPECT_EQ(6, CountInString(getCookiesCallback.GetCookies(cm.get(), urls[1]),
+                             '='));
+
+  const int rounds = kNumCookies / urls.size();
+  PerfTimeLogger timer("Cookie_monster_query_large_store");
+  GetCookiesForURLs(cm.get(), &urls, rounds);
+  timer.Done();
+}
+
+TEST_F(CookieMonsterTest, TestQueryLargeStoreThreaded) {
+  std::vector<GURL> urls;
+  scoped_refptr<CookieMonster> cm(CreateLargeMonster(&urls));
+  GetCookiesCallback getCookiesCallback;
+  getCookiesCallback.GetCookies(cm.get(), urls[0]);
+
+  ScopedVector<base::Thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(new base::Thread(
+        base::StringPrintf("CookieMonsterPerfTest%d", i).c_str()));
+    ASSERT_TRUE(threads.back()->Start());
+  }
+
+  // Each thread makes as many queries as TestQueryLargeStore.
+  const int rounds = kNumCookies / urls.size();
+  PerfTimeLogger timer(base::StringPrintf(
+      "Cookie_monster_query_large_store_%d_threads", kNumThreads).c_str());
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads[i]->message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&GetCookiesForURLs, base::Unretained(cm.get()), &urls,
+                   rounds));
+  }
+  for (int i = 0; i < kNumThreads; ++i)
+    threads[i]->Stop();
+  timer.Done();
+}
+
 TEST_F(CookieMonsterTest, TestGetKey) {
   scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
   PerfTimeLogger timer("Cookie_monster_get_key");
@@ -1387,6 +1387,39 @@ TEST_F(CookieMonsterTest, DeleteCookieByName) {
   }
 }
 
+// Cookie lines for a host are built from candidates cached per host, which
+// must follow every change to the cookies of its domain.
+TEST_F(CookieMonsterTest, GetCookiesFollowsChanges) {
+  scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
+  GURL url_www_foo(std::string(kUrlGoogle) + "/foo");
+  GURL url_mail("http://mail.google.izzle");
+
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "A=1"));
+  EXPECT_EQ("A=1", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("A=1", GetCookies(cm.get(), url_www_foo));
+  EXPECT_EQ(std::string(), GetCookies(cm.get(), url_mail));
+
+  // A longer path sorts first, and only applies to its own path.
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "B=2; path=/foo"));
+  EXPECT_EQ("A=1", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("B=2; A=1", GetCookies(cm.get(), url_www_foo));
+
+  // A domain cookie set from another host of the domain.
+  EXPECT_TRUE(SetCookie(cm.get(), url_mail, "C=3; domain=.google.izzle"));
+  EXPECT_EQ("A=1; C=3", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("C=3", GetCookies(cm.get(), url_mail));
+
+  // Overwriting a cookie replaces it.
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "A=4"));
+  EXPECT_EQ("B=2; C=3; A=4", GetCookies(cm.get(), url_www_foo));
+
+  DeleteCookie(cm.get(), url_www_foo, "B");
+  EXPECT_EQ("C=3; A=4", GetCookies(cm.get(), url_www_foo));
+  EXPECT_EQ(2, DeleteAll(cm.get()));
+  EXPECT_EQ(std::string(), GetCookies(cm.get(), url_www_foo));
+  EXPECT_EQ(std::string(), GetCookies(cm.get(), url_mail));
+}
+
 TEST_F(CookieMonsterTest, InitializeFromCookieMonster) {
   scoped_refptr<CookieMonster> cm_1(new CookieMonster(NULL, NULL));
   CookieOptions options;
@@ -5,6 +5,7 @@
 #include "net/dns/dns_test_util.h"
 
 #include <string>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/memory/weak_ptr.h"
@@ -31,23 +32,30 @@ class MockTransaction : public DnsTransaction,
                         public base::SupportsWeakPtr<MockTransaction> {
  public:
   MockTransaction(const MockDnsClientRuleList& rules,
+                  const std::vector<std::string>& search,
                   const std::string& hostname,
                   uint16 qtype,
                   const DnsTransactionFactory::CallbackType& callback)
       : result_(MockDnsClientRule::FAIL),
         hostname_(hostname),
+        qname_(hostname),
         qtype_(qtype),
         callback_(callback),
         started_(false) {
-    // Find the relevant rule which matches |qtype| and prefix of |hostname|.
-    for (size_t i = 0; i < rules.size(); ++i) {
-      const std::string& prefix = rules[i].prefix;
-      if ((rules[i].qtype == qtype) &&
-          (hostname.size() >= prefix.size()) &&
-          (hostname.compare(0, prefix.size(), prefix) == 0)) {
-        result_ = rules[i].result;
+    // Emulate the suffix search of DnsTransaction: unless |hostname| is
+    // fully-qualified, each suffix in |search| is tried in turn, then the name
+    // itself, and the first one whose rule does not FAIL is answered.
+    std::vector<std::string> names;
+    if (hostname.empty() || hostname[hostname.size() - 1] != '.') {
+      for (size_t i = 0; i < search.size(); ++i)
+        names.push_back(hostname + "." + search[i]);
+    }
+    names.push_back(hostname);
+    for (size_t i = 0; i < names.size(); ++i) {
+      qname_ = names[i];
+      result_ = FindResult(rules, names[i], qtype);
+      if (result_ != MockDnsClientRule::FAIL)
         break;
-      }
     }
   }
 
@@ -68,12 +76,29 @@ class MockTransaction : public DnsTransaction,
   }
 
  private:
+  // Returns the result of the first rule which matches |qtype| and a prefix
+  // of |name|, or FAIL if there is none.
+  static MockDnsClientRule::Result FindResult(
+      const MockDnsClientRuleList& rules,
+      const std::string& name,
+      uint16 qtype) {
+    for (size_t i = 0; i < rules.size(); ++i) {
+      const std::string& prefix = rules[i].prefix;
+      if ((rules[i].qtype == qtype) &&
+          (name.size() >= prefix.size()) &&
+          (name.compare(0, prefix.size(), prefix) == 0)) {
+        return rules[i].result;
+      }
+    }
+    return MockDnsClientRule::FAIL;
+  }
+
   void Finish() {
     switch (result_) {
       case MockDnsClientRule::EMPTY:
       case MockDnsClientRule::OK: {
         std::string qname;
-        DNSDomainFromDot(hostname_, &qname);
+        DNSDomainFromDot(qname_, &qname);
         DnsQuery query(0, qname, qtype_);
 
         DnsResponse response;
@@ -133,6 +158,8 @@ class MockTransaction : public DnsTransaction,
 
   MockDnsClientRule::Result result_;
   const std::string hostname_;
+  // The name which is answered, after the suffix search.
+  std::string qname_;
   const uint16 qtype_;
   DnsTransactionFactory::CallbackType callback_;
   bool started_;
@@ -142,8 +169,11 @@ class MockTransaction : public DnsTransaction,
 // A DnsTransactionFactory which creates MockTransaction.
 class MockTransactionFactory : public DnsTransactionFactory {
  public:
-  explicit MockTransactionFactory(const MockDnsClientRuleList& rules)
-      : rules_(rules) {}
+  // |config| must outlive the factory; its search list is applied to each
+  // new transaction.
+  MockTransactionFactory(const MockDnsClientRuleList& rules,
+                         const DnsConfig* config)
+      : rules_(rules), config_(config) {}
   virtual ~MockTransactionFactory() {}
 
   virtual scoped_ptr<DnsTransaction> CreateTransaction(
@@ -152,11 +182,13 @@ class MockTransactionFactory : public DnsTransactionFactory {
       const DnsTransactionFactory::CallbackType& callback,
       const BoundNetLog&) OVERRIDE {
     return scoped_ptr<DnsTransaction>(
-        new MockTransaction(rules_, hostname, qtype, callback));
+        new MockTransaction(rules_, config_->search, hostname, qtype,
+                            callback));
   }
 
  private:
   MockDnsClientRuleList rules_;
+  const DnsConfig* config_;
 };
 
 class MockAddressSorter : public AddressSorter {
@@ -174,7 +206,7 @@ class MockDnsClient : public DnsClient {
  public:
   MockDnsClient(const DnsConfig& config,
                 const MockDnsClientRuleList& rules)
-      : config_(config), factory_(rules) {}
+      : config_(config), factory_(rules, &config_) {}
   virtual ~MockDnsClient() {}
 
   virtual void SetConfig(const DnsConfig& config) OVERRIDE {
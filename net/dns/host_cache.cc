@@ -4,14 +4,38 @@
 
 #include "net/dns/host_cache.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 
 namespace net {
 
+namespace {
+
+// Keys of the dictionaries written by HostCache::GetAsListValue().
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kCanonicalNameKey[] = "canonical_name";
+const char kAddressesKey[] = "addresses";
+
+typedef std::pair<base::TimeTicks, const HostCache::Key*> ExpirationAndKey;
+
+bool LaterExpiration(const ExpirationAndKey& a, const ExpirationAndKey& b) {
+  return a.first > b.first;
+}
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -34,7 +58,8 @@ HostCache::Entry::~Entry() {
 //-----------------------------------------------------------------------------
 
 HostCache::HostCache(size_t max_entries)
-    : entries_(max_entries) {
+    : entries_(max_entries),
+      delegate_(NULL) {
 }
 
 HostCache::~HostCache() {
@@ -49,6 +74,29 @@ const HostCache::Entry* HostCache::Lookup(const Key& key,
   return entries_.Get(key, now);
 }
 
+const HostCache::Entry* HostCache::LookupStale(const Key& key,
+                                               base::TimeTicks now,
+                                               base::TimeDelta max_staleness,
+                                               bool* is_stale) {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return NULL;
+
+  base::TimeTicks expiration;
+  const Entry* entry = entries_.GetIgnoringExpiration(key, &expiration);
+  if (!entry)
+    return NULL;
+
+  *is_stale = now >= expiration;
+  if (!*is_stale)
+    return entry;
+
+  // Failures are never served stale, and are left for Lookup() to evict.
+  if (entry->error != OK || now - expiration >= max_staleness)
+    return NULL;
+  return entry;
+}
+
 void HostCache::Set(const Key& key,
                     const Entry& entry,
                     base::TimeTicks now,
@@ -58,11 +106,127 @@ void HostCache::Set(const Key& key,
     return;
 
   entries_.Put(key, entry, now, now + ttl);
+  if (delegate_)
+    delegate_->CacheChanged(this);
 }
 
 void HostCache::clear() {
   DCHECK(CalledOnValidThread());
   entries_.Clear();
+  if (delegate_)
+    delegate_->CacheChanged(this);
+}
+
+void HostCache::SetDelegate(Delegate* delegate) {
+  DCHECK(CalledOnValidThread());
+  delegate_ = delegate;
+}
+
+void HostCache::GetAsListValue(base::ListValue* entry_list) const {
+  DCHECK(CalledOnValidThread());
+  DCHECK(entry_list);
+
+  std::vector<ExpirationAndKey> successful_entries;
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    if (it.value().error == OK)
+      successful_entries.push_back(std::make_pair(it.expiration(), &it.key()));
+  }
+  std::sort(successful_entries.begin(), successful_entries.end(),
+            &LaterExpiration);
+
+  // Convert the expiration times to wall clock times relative to now.
+  base::Time wall_now = base::Time::Now();
+  base::TimeTicks ticks_now = base::TimeTicks::Now();
+  for (size_t i = 0; i < successful_entries.size(); ++i) {
+    const Key& key = *successful_entries[i].second;
+    base::TimeTicks expiration;
+    const Entry* entry = entries_.GetIgnoringExpiration(key, &expiration);
+    DCHECK(entry);
+
+    base::DictionaryValue* entry_dict = new base::DictionaryValue();
+    entry_dict->SetString(kHostnameKey, key.hostname);
+    entry_dict->SetInteger(kAddressFamilyKey, key.address_family);
+    entry_dict->SetInteger(kFlagsKey, key.host_resolver_flags);
+    // base::Value cannot hold an int64, so store it as a string.
+    entry_dict->SetString(
+        kExpirationKey,
+        base::Int64ToString(
+            (wall_now + (expiration - ticks_now)).ToInternalValue()));
+    if (!entry->addrlist.canonical_name().empty()) {
+      entry_dict->SetString(kCanonicalNameKey,
+                            entry->addrlist.canonical_name());
+    }
+    base::ListValue* address_list = new base::ListValue();
+    for (size_t j = 0; j < entry->addrlist.size(); ++j)
+      address_list->AppendString(entry->addrlist[j].ToStringWithoutPort());
+    entry_dict->Set(kAddressesKey, address_list);
+    entry_list->Append(entry_dict);
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& entry_list) {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return true;
+
+  base::Time wall_now = base::Time::Now();
+  base::TimeTicks ticks_now = base::TimeTicks::Now();
+  bool success = true;
+  for (size_t i = 0; i < entry_list.GetSize(); ++i) {
+    if (entries_.size() >= entries_.max_entries())
+      break;
+
+    const base::DictionaryValue* entry_dict = NULL;
+    std::string hostname;
+    int address_family = 0;
+    int flags = 0;
+    std::string expiration_string;
+    int64 expiration_value = 0;
+    const base::ListValue* address_list = NULL;
+    if (!entry_list.GetDictionary(i, &entry_dict) ||
+        !entry_dict->GetString(kHostnameKey, &hostname) ||
+        !entry_dict->GetInteger(kAddressFamilyKey, &address_family) ||
+        !entry_dict->GetInteger(kFlagsKey, &flags) ||
+        !entry_dict->GetString(kExpirationKey, &expiration_string) ||
+        !base::StringToInt64(expiration_string, &expiration_value) ||
+        !entry_dict->GetList(kAddressesKey, &address_list) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_IPV6) {
+      success = false;
+      continue;
+    }
+
+    AddressList addrlist;
+    bool valid_addresses = true;
+    for (size_t j = 0; j < address_list->GetSize(); ++j) {
+      std::string address_string;
+      IPAddressNumber address;
+      if (!address_list->GetString(j, &address_string) ||
+          !ParseIPLiteralToNumber(address_string, &address)) {
+        valid_addresses = false;
+        break;
+      }
+      addrlist.push_back(IPEndPoint(address, 0));
+    }
+    if (!valid_addresses || addrlist.empty()) {
+      success = false;
+      continue;
+    }
+    std::string canonical_name;
+    if (entry_dict->GetString(kCanonicalNameKey, &canonical_name))
+      addrlist.set_canonical_name(canonical_name);
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    base::TimeTicks unused;
+    if (entries_.GetIgnoringExpiration(key, &unused))
+      continue;
+
+    // The expiration may well be in the past, in which case the TTL passed to
+    // Set() is negative.
+    base::Time expiration = base::Time::FromInternalValue(expiration_value);
+    Set(key, Entry(OK, addrlist), ticks_now, expiration - wall_now);
+  }
+  return success;
 }
 
 size_t HostCache::size() const {
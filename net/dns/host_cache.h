@@ -17,6 +17,10 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -61,6 +65,18 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
     HostResolverFlags host_resolver_flags;
   };
 
+  // An interface for persisting the cache, so that a restart doesn't have to
+  // resolve every host again.
+  class NET_EXPORT Delegate {
+   public:
+    // Called when an entry is set, or the cache is cleared. This function may
+    // not block and may not reenter the HostCache.
+    virtual void CacheChanged(HostCache* cache) = 0;
+
+   protected:
+    virtual ~Delegate() {}
+  };
+
   struct EvictionHandler {
     void Handle(const Key& key,
                 const Entry& entry,
@@ -82,6 +98,14 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // |now|. If there is no such entry, returns NULL.
   const Entry* Lookup(const Key& key, base::TimeTicks now);
 
+  // Like Lookup(), but also returns a successful entry which expired less than
+  // |max_staleness| before |now|, and never removes expired entries. Sets
+  // |*is_stale| to whether the returned entry has expired.
+  const Entry* LookupStale(const Key& key,
+                           base::TimeTicks now,
+                           base::TimeDelta max_staleness,
+                           bool* is_stale);
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -93,6 +117,23 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // Empties the cache
   void clear();
 
+  // Sets the delegate that is told when the cache changes. The delegate is
+  // not owned, and must outlive this object or be unset with NULL.
+  void SetDelegate(Delegate* delegate);
+
+  // Appends a dictionary describing each successful entry to |entry_list|,
+  // latest expiration first, so that the cache can be saved to disk and
+  // restored in a later session. Expiration times are saved as wall clock
+  // times, since TimeTicks do not carry over across restarts.
+  void GetAsListValue(base::ListValue* entry_list) const;
+
+  // Adds the entries of |entry_list|, as written by GetAsListValue(), until
+  // the cache is full. Entries keep their original expiration time, so they
+  // are usually stale and only served through LookupStale(). Keys which are
+  // already cached are skipped. Returns false if any entry was malformed;
+  // the well-formed entries are added regardless.
+  bool RestoreFromListValue(const base::ListValue& entry_list);
+
   // Returns the number of entries in the cache.
   size_t size() const;
 
@@ -116,6 +157,8 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // a resolved result entry.
   EntryMap entries_;
 
+  Delegate* delegate_;
+
   DISALLOW_COPY_AND_ASSIGN(HostCache);
 };
 
@@ -4,11 +4,14 @@
 
 #include "net/dns/host_cache.h"
 
+#include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -17,11 +20,31 @@ namespace {
 
 const int kMaxCacheEntries = 10;
 
+// Counts the changes it is told about.
+class CountingDelegate : public HostCache::Delegate {
+ public:
+  CountingDelegate() : changes_(0) {}
+
+  int changes() const { return changes_; }
+
+  virtual void CacheChanged(HostCache* cache) OVERRIDE { ++changes_; }
+
+ private:
+  int changes_;
+};
+
 // Builds a key for |hostname|, defaulting the address family to unspecified.
 HostCache::Key Key(const std::string& hostname) {
   return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
 }
 
+// Builds an AddressList holding the single IP literal |address|.
+AddressList AddressListForIP(const std::string& address) {
+  IPAddressNumber ip;
+  EXPECT_TRUE(ParseIPLiteralToNumber(address, &ip));
+  return AddressList::CreateFromIPAddress(ip, 0);
+}
+
 }  // namespace
 
 TEST(HostCacheTest, Basic) {
@@ -296,6 +319,175 @@ TEST(HostCacheTest, Clear) {
   EXPECT_EQ(0u, cache.size());
 }
 
+// Make sure the delegate is told about new entries and clears, but not about
+// lookups.
+TEST(HostCacheTest, NotifiesDelegate) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+  CountingDelegate delegate;
+  cache.SetDelegate(&delegate);
+
+  base::TimeTicks now;
+  HostCache::Entry entry = HostCache::Entry(OK, AddressList());
+
+  cache.Set(Key("foobar1.com"), entry, now, kTTL);
+  cache.Set(Key("foobar2.com"), entry, now, kTTL);
+  EXPECT_EQ(2, delegate.changes());
+
+  EXPECT_TRUE(cache.Lookup(Key("foobar1.com"), now));
+  EXPECT_EQ(2, delegate.changes());
+
+  cache.clear();
+  EXPECT_EQ(3, delegate.changes());
+
+  cache.SetDelegate(NULL);
+  cache.Set(Key("foobar1.com"), entry, now, kTTL);
+  EXPECT_EQ(3, delegate.changes());
+}
+
+TEST(HostCacheTest, LookupStale) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  const base::TimeDelta kMaxStaleness = base::TimeDelta::FromSeconds(60);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Set t=0.
+  base::TimeTicks now;
+
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Key key2 = Key("foobar2.com");
+  cache.Set(key1, HostCache::Entry(OK, AddressList()), now, kTTL);
+  cache.Set(key2, HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now,
+            kTTL);
+
+  bool is_stale = true;
+  EXPECT_FALSE(cache.LookupStale(Key("foobar3.com"), now, kMaxStaleness,
+                                 &is_stale));
+
+  // Both entries are fresh at t=0.
+  ASSERT_TRUE(cache.LookupStale(key1, now, kMaxStaleness, &is_stale));
+  EXPECT_FALSE(is_stale);
+  ASSERT_TRUE(cache.LookupStale(key2, now, kMaxStaleness, &is_stale));
+  EXPECT_FALSE(is_stale);
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED,
+            cache.LookupStale(key2, now, kMaxStaleness, &is_stale)->error);
+
+  // Advance to t=10; only the successful entry is served stale.
+  now += kTTL;
+  ASSERT_TRUE(cache.LookupStale(key1, now, kMaxStaleness, &is_stale));
+  EXPECT_TRUE(is_stale);
+  EXPECT_FALSE(cache.LookupStale(key2, now, kMaxStaleness, &is_stale));
+
+  // Advance to t=70; the entry is too stale to be served, but is not evicted.
+  now += kMaxStaleness;
+  EXPECT_FALSE(cache.LookupStale(key1, now, kMaxStaleness, &is_stale));
+  EXPECT_EQ(2u, cache.size());
+
+  // Lookup() never serves stale entries, and evicts them.
+  EXPECT_FALSE(cache.Lookup(key1, now));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(HostCacheTest, SerializeAndRestore) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  // An expired entry, a fresh entry with a canonical name and a failure.
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Key key2 = HostCache::Key("foobar2.com", ADDRESS_FAMILY_IPV6,
+                                       HOST_RESOLVER_CANONNAME);
+  HostCache::Key key3 = Key("foobar3.com");
+  cache.Set(key1, HostCache::Entry(OK, AddressListForIP("1.2.3.4")),
+            now - kTTL, kTTL / 2);
+  AddressList addrlist2 = AddressListForIP("::1");
+  addrlist2.push_back(AddressListForIP("2001:db8::1").front());
+  addrlist2.set_canonical_name("canonical.foobar2.com");
+  cache.Set(key2, HostCache::Entry(OK, addrlist2), now, kTTL);
+  cache.Set(key3, HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now,
+            kTTL);
+
+  base::ListValue entry_list;
+  cache.GetAsListValue(&entry_list);
+
+  // Failures are not saved, and the latest expiration comes first.
+  ASSERT_EQ(2u, entry_list.GetSize());
+  const base::DictionaryValue* entry_dict = NULL;
+  std::string hostname;
+  ASSERT_TRUE(entry_list.GetDictionary(0, &entry_dict));
+  ASSERT_TRUE(entry_dict->GetString("hostname", &hostname));
+  EXPECT_EQ("foobar2.com", hostname);
+
+  HostCache restored_cache(kMaxCacheEntries);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(entry_list));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  // The expired entry is only available as a stale entry.
+  now = base::TimeTicks::Now();
+  bool is_stale = false;
+  const HostCache::Entry* entry = restored_cache.LookupStale(
+      key1, now, base::TimeDelta::FromHours(1), &is_stale);
+  ASSERT_TRUE(entry);
+  EXPECT_TRUE(is_stale);
+  ASSERT_EQ(1u, entry->addrlist.size());
+  EXPECT_EQ("1.2.3.4", entry->addrlist[0].ToStringWithoutPort());
+  EXPECT_FALSE(restored_cache.Lookup(key1, now));
+
+  entry = restored_cache.Lookup(key2, now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  ASSERT_EQ(2u, entry->addrlist.size());
+  EXPECT_EQ("::1", entry->addrlist[0].ToStringWithoutPort());
+  EXPECT_EQ("2001:db8::1", entry->addrlist[1].ToStringWithoutPort());
+  EXPECT_EQ("canonical.foobar2.com", entry->addrlist.canonical_name());
+
+  EXPECT_FALSE(restored_cache.Lookup(key3, now));
+}
+
+TEST(HostCacheTest, RestoreSkipsExistingAndMalformedEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+  base::TimeTicks now = base::TimeTicks::Now();
+  cache.Set(Key("foobar.com"),
+            HostCache::Entry(OK, AddressListForIP("1.1.1.1")), now, kTTL);
+  cache.Set(Key("foobar2.com"),
+            HostCache::Entry(OK, AddressListForIP("2.2.2.2")), now, kTTL);
+  base::ListValue entry_list;
+  cache.GetAsListValue(&entry_list);
+
+  // An entry with an invalid address.
+  base::DictionaryValue* bad_entry = new base::DictionaryValue();
+  bad_entry->SetString("hostname", "foobar3.com");
+  bad_entry->SetInteger("address_family", ADDRESS_FAMILY_UNSPECIFIED);
+  bad_entry->SetInteger("flags", 0);
+  bad_entry->SetString("expiration", "0");
+  base::ListValue* addresses = new base::ListValue();
+  addresses->AppendString("not an address");
+  bad_entry->Set("addresses", addresses);
+  entry_list.Append(bad_entry);
+
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.Set(Key("foobar.com"),
+                     HostCache::Entry(OK, AddressListForIP("3.3.3.3")), now,
+                     kTTL);
+  EXPECT_FALSE(restored_cache.RestoreFromListValue(entry_list));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  // The existing entry is not overwritten.
+  const HostCache::Entry* entry = restored_cache.Lookup(Key("foobar.com"), now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("3.3.3.3", entry->addrlist[0].ToStringWithoutPort());
+  EXPECT_TRUE(restored_cache.Lookup(Key("foobar2.com"), now));
+
+  // Restoring stops once the cache is full.
+  HostCache small_cache(1);
+  EXPECT_TRUE(small_cache.RestoreFromListValue(entry_list));
+  EXPECT_EQ(1u, small_cache.size());
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
@@ -116,6 +116,10 @@ HostCache* HostResolver::GetHostCache() {
   return NULL;
 }
 
+size_t HostResolver::RefreshStaleCacheEntries(size_t max_hosts) {
+  return 0;
+}
+
 base::Value* HostResolver::GetDnsConfigAsValue() const {
   return NULL;
 }
@@ -126,11 +130,13 @@ HostResolver::CreateSystemResolver(const Options& options, NetLog* net_log) {
   scoped_ptr<HostCache> cache;
   if (options.enable_caching)
     cache = HostCache::CreateDefaultCache();
-  return scoped_ptr<HostResolver>(new HostResolverImpl(
+  scoped_ptr<HostResolverImpl> resolver(new HostResolverImpl(
       cache.Pass(),
       GetDispatcherLimits(options),
       HostResolverImpl::ProcTaskParams(NULL, options.max_retry_attempts),
       net_log));
+  resolver->SetMaxStaleness(options.max_staleness);
+  return resolver.PassAs<HostResolver>();
 }
 
 // static
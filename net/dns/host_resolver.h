@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "net/base/address_family.h"
 #include "net/base/completion_callback.h"
 #include "net/base/host_port_pair.h"
@@ -45,12 +46,16 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |max_staleness| is how long successful cache entries may be served after
+  // they expire, while they are refreshed in the background. Zero, the
+  // default, disables serving stale entries.
   struct NET_EXPORT Options {
     Options();
 
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    base::TimeDelta max_staleness;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are required,
@@ -177,6 +182,11 @@ class NET_EXPORT HostResolver {
   // Used primarily to clear the cache and for getting debug information.
   virtual HostCache* GetHostCache();
 
+  // Starts refreshing up to |max_hosts| expired entries of the cache in the
+  // background, such as the entries of a cache restored at startup. Returns
+  // the number of refreshes started. Does nothing by default.
+  virtual size_t RefreshStaleCacheEntries(size_t max_hosts);
+
   // Returns the current DNS configuration |this| is using, as a Value, or NULL
   // if it's configured to always use the system host resolver.  Caller takes
   // ownership of the returned Value.
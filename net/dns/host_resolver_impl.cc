@@ -10,6 +10,7 @@
 #include <netdb.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -151,6 +152,19 @@ void UmaAsyncDnsResolveStatus(DnsResolveStatus result) {
                             RESOLVE_STATUS_MAX);
 }
 
+enum CacheLookupResult {
+  CACHE_LOOKUP_MISS = 0,
+  CACHE_LOOKUP_HIT,
+  CACHE_LOOKUP_STALE_HIT,
+  CACHE_LOOKUP_MAX
+};
+
+void UmaCacheLookupResult(CacheLookupResult result) {
+  UMA_HISTOGRAM_ENUMERATION("DNS.CacheLookupResult",
+                            result,
+                            CACHE_LOOKUP_MAX);
+}
+
 bool ResemblesNetBIOSName(const std::string& hostname) {
   return (hostname.size() < 16) && (hostname.find('.') == std::string::npos);
 }
@@ -978,38 +992,59 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
       : client_(client),
         family_(key.address_family),
         callback_(callback),
-        net_log_(job_net_log) {
+        net_log_(job_net_log),
+        num_pending_transactions_(0),
+        requeried_aaaa_(false) {
     DCHECK(client);
     DCHECK(!callback.is_null());
 
-    // If unspecified, do IPv4 first, because suffix search will be faster.
-    uint16 qtype = (family_ == ADDRESS_FAMILY_IPV6) ?
-                   dns_protocol::kTypeAAAA :
-                   dns_protocol::kTypeA;
-    transaction_ = client_->GetTransactionFactory()->CreateTransaction(
-        key.hostname,
-        qtype,
-        base::Bind(&DnsTask::OnTransactionComplete, base::Unretained(this),
-                   true /* first_query */, base::TimeTicks::Now()),
-        net_log_);
+    // If unspecified, both families are queried in parallel, so that the
+    // result is available after the slower of the two queries rather than
+    // after both of them in sequence.
+    if (family_ != ADDRESS_FAMILY_IPV6)
+      transaction_a_ = CreateTransaction(key.hostname, dns_protocol::kTypeA);
+    if (family_ != ADDRESS_FAMILY_IPV4) {
+      transaction_aaaa_ =
+          CreateTransaction(key.hostname, dns_protocol::kTypeAAAA);
+    }
   }
 
   void Start() {
     net_log_.BeginEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_DNS_TASK);
-    transaction_->Start();
+    // DnsTransaction always completes asynchronously, so neither callback
+    // can run before both transactions have been started.
+    if (transaction_a_) {
+      ++num_pending_transactions_;
+      transaction_a_->Start();
+    }
+    if (transaction_aaaa_) {
+      ++num_pending_transactions_;
+      transaction_aaaa_->Start();
+    }
   }
 
  private:
-  void OnTransactionComplete(bool first_query,
-                             const base::TimeTicks& start_time,
+  scoped_ptr<DnsTransaction> CreateTransaction(const std::string& hostname,
+                                               uint16 qtype) {
+    return client_->GetTransactionFactory()->CreateTransaction(
+        hostname,
+        qtype,
+        base::Bind(&DnsTask::OnTransactionComplete, base::Unretained(this),
+                   base::TimeTicks::Now()),
+        net_log_);
+  }
+
+  void OnTransactionComplete(const base::TimeTicks& start_time,
                              DnsTransaction* transaction,
                              int net_error,
                              const DnsResponse* response) {
     DCHECK(transaction);
+    DCHECK_GT(num_pending_transactions_, 0u);
     base::TimeDelta duration = base::TimeTicks::Now() - start_time;
     // Run |callback_| last since the owning Job will then delete this DnsTask.
     if (net_error != OK) {
       DNS_HISTOGRAM("AsyncDNS.TransactionFailure", duration);
+      // Fail even if the other query succeeds.
       OnFailure(net_error, DnsResponse::DNS_PARSE_OK);
       return;
     }
@@ -1036,37 +1071,45 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
       return;
     }
 
-    bool needs_sort = false;
-    if (first_query) {
-      DCHECK(client_->GetConfig()) <<
-          "Transaction should have been aborted when config changed!";
-      if (family_ == ADDRESS_FAMILY_IPV6) {
-        needs_sort = (addr_list.size() > 1);
-      } else if (family_ == ADDRESS_FAMILY_UNSPECIFIED) {
-        first_addr_list_ = addr_list;
-        first_ttl_ = ttl;
-        // Use fully-qualified domain name to avoid search.
-        transaction_ = client_->GetTransactionFactory()->CreateTransaction(
-            response->GetDottedName() + ".",
-            dns_protocol::kTypeAAAA,
-            base::Bind(&DnsTask::OnTransactionComplete, base::Unretained(this),
-                       false /* first_query */, base::TimeTicks::Now()),
-            net_log_);
-        transaction_->Start();
-        return;
-      }
+    if (transaction->GetType() == dns_protocol::kTypeAAAA) {
+      ipv6_addr_list_ = addr_list;
+      ipv6_ttl_ = ttl;
+      ipv6_name_ = response->GetDottedName();
     } else {
-      DCHECK_EQ(ADDRESS_FAMILY_UNSPECIFIED, family_);
-      bool has_ipv6_addresses = !addr_list.empty();
-      if (!first_addr_list_.empty()) {
-        ttl = std::min(ttl, first_ttl_);
-        // Place IPv4 addresses after IPv6.
-        addr_list.insert(addr_list.end(), first_addr_list_.begin(),
-                                          first_addr_list_.end());
+      ipv4_addr_list_ = addr_list;
+      ipv4_ttl_ = ttl;
+      ipv4_name_ = response->GetDottedName();
+    }
+    if (--num_pending_transactions_ > 0)
+      return;
+
+    DCHECK(client_->GetConfig()) <<
+        "Transaction should have been aborted when config changed!";
+
+    if (transaction_a_ && transaction_aaaa_) {
+      if (ipv4_name_ != ipv6_name_ && !requeried_aaaa_) {
+        // With a search list, the two queries may have been answered for
+        // different suffixes. Ask for AAAA again at the name which the A
+        // query resolved, fully-qualified to avoid the search, so that both
+        // families describe the same host.
+        requeried_aaaa_ = true;
+        ipv6_addr_list_ = AddressList();
+        transaction_aaaa_ =
+            CreateTransaction(ipv4_name_ + ".", dns_protocol::kTypeAAAA);
+        ++num_pending_transactions_;
+        transaction_aaaa_->Start();
+        return;
       }
-      needs_sort = (has_ipv6_addresses && addr_list.size() > 1);
+      // Use the smaller TTL of the two answers.
+      ttl = std::min(ipv4_ttl_, ipv6_ttl_);
     }
 
+    // Place IPv4 addresses after IPv6.
+    addr_list = ipv6_addr_list_;
+    addr_list.insert(addr_list.end(), ipv4_addr_list_.begin(),
+                                      ipv4_addr_list_.end());
+    bool needs_sort = (!ipv6_addr_list_.empty() && addr_list.size() > 1);
+
     if (addr_list.empty()) {
       // TODO(szym): Don't fallback to ProcTask in this case.
       OnFailure(ERR_NAME_NOT_RESOLVED, DnsResponse::DNS_PARSE_OK);
@@ -1130,11 +1173,20 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
   Callback callback_;
   const BoundNetLog net_log_;
 
-  scoped_ptr<DnsTransaction> transaction_;
-
-  // Results from the first transaction. Used only if |family_| is unspecified.
-  AddressList first_addr_list_;
-  base::TimeDelta first_ttl_;
+  // Either may be NULL if |family_| excludes it.
+  scoped_ptr<DnsTransaction> transaction_a_;
+  scoped_ptr<DnsTransaction> transaction_aaaa_;
+  size_t num_pending_transactions_;
+  // True once AAAA has been queried again at the name the A query resolved.
+  bool requeried_aaaa_;
+
+  // Results of the completed transactions, and the names they answered for.
+  AddressList ipv4_addr_list_;
+  AddressList ipv6_addr_list_;
+  base::TimeDelta ipv4_ttl_;
+  base::TimeDelta ipv6_ttl_;
+  std::string ipv4_name_;
+  std::string ipv6_name_;
 
   DISALLOW_COPY_AND_ASSIGN(DnsTask);
 };
@@ -1154,6 +1206,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
         key_(key),
         priority_tracker_(priority),
         had_non_speculative_request_(false),
+        is_background_refresh_(false),
         had_dns_config_(false),
         dns_task_error_(OK),
         creation_time_(base::TimeTicks::Now()),
@@ -1201,6 +1254,13 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
     }
   }
 
+  // Marks this job as refreshing a stale cache entry. Such a job is not
+  // cancelled when it has no active Requests, and keeps the stale entry if the
+  // refresh fails.
+  void MarkAsBackgroundRefresh() {
+    is_background_refresh_ = true;
+  }
+
   // Add this job to the dispatcher.
   void Schedule() {
     handle_ = resolver_->dispatcher_.Add(this, priority());
@@ -1252,7 +1312,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
                    req->request_net_log().source(),
                    priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || is_background_refresh_) {
       UpdatePriority();
     } else {
       // If we were called from a Request's callback within CompleteRequests,
@@ -1294,7 +1354,10 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
   // Attempts to serve the job from HOSTS. Returns true if succeeded and
   // this Job was destroyed.
   bool ServeFromHosts() {
-    DCHECK_GT(num_active_requests(), 0u);
+    DCHECK(num_active_requests() > 0 || is_background_refresh_);
+    // A background refresh without Requests has no RequestInfo to match.
+    if (requests_.empty())
+      return false;
     AddressList addr_list;
     if (resolver_->ServeFromHosts(key(),
                                   requests_.front()->info(),
@@ -1546,7 +1609,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
       handle_.Reset();
     }
 
-    if (num_active_requests() == 0) {
+    if (num_active_requests() == 0 && !is_background_refresh_) {
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1556,7 +1619,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
     net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                       entry.error);
 
-    DCHECK(!requests_.empty());
+    DCHECK(!requests_.empty() || is_background_refresh_);
 
     if (entry.error == OK) {
       // Record this histogram here, when we know the system has a valid DNS
@@ -1567,7 +1630,8 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
 
     bool did_complete = (entry.error != ERR_NETWORK_CHANGED) &&
                         (entry.error != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
-    if (did_complete)
+    // Keep serving the stale entry rather than a failed refresh.
+    if (did_complete && !(is_background_refresh_ && entry.error != OK))
       resolver_->CacheResult(key_, entry, ttl);
 
     // Complete all of the requests that were attached to the job.
@@ -1628,6 +1692,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job {
 
   bool had_non_speculative_request_;
 
+  // True if this job was started to refresh a stale cache entry.
+  bool is_background_refresh_;
+
   // Distinguishes measurements taken while DnsClient was fully configured.
   bool had_dns_config_;
 
@@ -1731,6 +1798,36 @@ void HostResolverImpl::SetMaxQueuedJobs(size_t value) {
   max_queued_jobs_ = value;
 }
 
+void HostResolverImpl::SetMaxStaleness(base::TimeDelta max_staleness) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(max_staleness >= base::TimeDelta());
+  max_staleness_ = max_staleness;
+}
+
+size_t HostResolverImpl::RefreshStaleCacheEntries(size_t max_hosts) {
+  DCHECK(CalledOnValidThread());
+  if (!cache_.get())
+    return 0;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<std::pair<base::TimeTicks, Key> > stale_entries;
+  for (HostCache::EntryMap::Iterator it(cache_->entries()); it.HasNext();
+       it.Advance()) {
+    if (it.value().error == OK && it.expiration() <= now)
+      stale_entries.push_back(std::make_pair(it.expiration(), it.key()));
+  }
+  // Refresh the most recently expired entries first.
+  std::sort(stale_entries.rbegin(), stale_entries.rend());
+
+  size_t num_started = 0;
+  for (size_t i = 0; i < stale_entries.size() && num_started < max_hosts;
+       ++i) {
+    if (StartBackgroundRefresh(stale_entries[i].second))
+      ++num_started;
+  }
+  return num_started;
+}
+
 int HostResolverImpl::Resolve(const RequestInfo& info,
                               AddressList* addresses,
                               const CompletionCallback& callback,
@@ -1932,17 +2029,29 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   if (!info.allow_cached_response() || !cache_.get())
     return false;
 
-  const HostCache::Entry* cache_entry = cache_->Lookup(
-      key, base::TimeTicks::Now());
-  if (!cache_entry)
+  const HostCache::Entry* cache_entry = NULL;
+  bool is_stale = false;
+  if (max_staleness_ > base::TimeDelta()) {
+    cache_entry = cache_->LookupStale(key, base::TimeTicks::Now(),
+                                      max_staleness_, &is_stale);
+  } else {
+    cache_entry = cache_->Lookup(key, base::TimeTicks::Now());
+  }
+  if (!cache_entry) {
+    UmaCacheLookupResult(CACHE_LOOKUP_MISS);
     return false;
+  }
 
+  UmaCacheLookupResult(is_stale ? CACHE_LOOKUP_STALE_HIT : CACHE_LOOKUP_HIT);
   *net_error = cache_entry->error;
   if (*net_error == OK) {
     if (cache_entry->has_ttl())
       RecordTTL(cache_entry->ttl);
     *addresses = EnsurePortOnAddressList(cache_entry->addrlist, info.port());
   }
+  // |cache_entry| may be invalidated by the refresh.
+  if (is_stale)
+    StartBackgroundRefresh(key);
   return true;
 }
 
@@ -1994,6 +2103,22 @@ bool HostResolverImpl::ServeFromHosts(const Key& key,
   return !addresses->empty();
 }
 
+bool HostResolverImpl::StartBackgroundRefresh(const Key& key) {
+  JobMap::iterator jobit = jobs_.find(key);
+  if (jobit != jobs_.end())
+    return false;
+  // Unlike a Job with Requests, a refresh never evicts another Job.
+  if (dispatcher_.num_queued_jobs() >= max_queued_jobs_)
+    return false;
+
+  Job* job = new Job(weak_ptr_factory_.GetWeakPtr(), key, IDLE,
+                     BoundNetLog::Make(net_log_, NetLog::SOURCE_NONE));
+  job->MarkAsBackgroundRefresh();
+  jobs_.insert(jobit, std::make_pair(key, job));
+  job->Schedule();
+  return true;
+}
+
 void HostResolverImpl::CacheResult(const Key& key,
                                    const HostCache::Entry& entry,
                                    base::TimeDelta ttl) {
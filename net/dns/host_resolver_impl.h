@@ -129,6 +129,12 @@ class NET_EXPORT HostResolverImpl
   // NetworkChangeNotifier.
   void SetDnsClient(scoped_ptr<DnsClient> dns_client);
 
+  // Allows successful cache entries to be served for up to |max_staleness|
+  // after they expire. A request served from such a stale entry completes
+  // synchronously and starts a background Job to refresh the entry. Zero, the
+  // default, disables serving stale entries.
+  void SetMaxStaleness(base::TimeDelta max_staleness);
+
   // HostResolver methods:
   virtual int Resolve(const RequestInfo& info,
                       AddressList* addresses,
@@ -143,6 +149,9 @@ class NET_EXPORT HostResolverImpl
   virtual AddressFamily GetDefaultAddressFamily() const OVERRIDE;
   virtual void SetDnsClientEnabled(bool enabled) OVERRIDE;
   virtual HostCache* GetHostCache() OVERRIDE;
+  // Starts background Jobs to refresh up to |max_hosts| expired successful
+  // entries of the cache, most recently expired first.
+  virtual size_t RefreshStaleCacheEntries(size_t max_hosts) OVERRIDE;
   virtual base::Value* GetDnsConfigAsValue() const OVERRIDE;
 
  private:
@@ -195,6 +204,11 @@ class NET_EXPORT HostResolverImpl
   Key GetEffectiveKeyForRequest(const RequestInfo& info,
                                 const BoundNetLog& net_log) const;
 
+  // Starts a Job without any Requests to refresh the cache entry for |key|,
+  // unless a Job for |key| already exists or the queue is full.
+  // Returns true if a Job was started.
+  bool StartBackgroundRefresh(const Key& key);
+
   // Records the result in cache if cache is present.
   void CacheResult(const Key& key,
                    const HostCache::Entry& entry,
@@ -241,6 +255,9 @@ class NET_EXPORT HostResolverImpl
   // Limit on the maximum number of jobs queued in |dispatcher_|.
   size_t max_queued_jobs_;
 
+  // How long after expiration a successful cache entry may still be served.
+  base::TimeDelta max_staleness_;
+
   // Parameters for ProcTask.
   ProcTaskParams proc_params_;
 
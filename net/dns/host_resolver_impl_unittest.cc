@@ -6,6 +6,8 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
@@ -514,6 +516,24 @@ class HostResolverImplTest : public testing::Test {
     resolver_->fallback_to_proctask_ = fallback_to_proctask;
   }
 
+  // Expires every entry in the cache without changing its contents. Entries
+  // are expired in key order, the first one most recently.
+  void ExpireCacheEntries() {
+    DCHECK(resolver_.get());
+    HostCache* cache = resolver_->GetHostCache();
+    std::vector<std::pair<HostCache::Key, HostCache::Entry> > entries;
+    for (HostCache::EntryMap::Iterator it(cache->entries()); it.HasNext();
+         it.Advance()) {
+      entries.push_back(std::make_pair(it.key(), it.value()));
+    }
+    base::TimeTicks now = base::TimeTicks::Now();
+    for (size_t i = 0; i < entries.size(); ++i) {
+      cache->Set(entries[i].first, entries[i].second,
+                 now - base::TimeDelta::FromMinutes(i + 1),
+                 base::TimeDelta::FromSeconds(1));
+    }
+  }
+
   scoped_refptr<MockHostResolverProc> proc_;
   scoped_ptr<HostResolverImpl> resolver_;
   ScopedVector<Request> requests_;
@@ -836,6 +856,85 @@ TEST_F(HostResolverImplTest, BypassCache) {
   EXPECT_EQ(2u, proc_->GetCaptureList().size());
 }
 
+// Test that a stale cache entry is served while it is refreshed.
+TEST_F(HostResolverImplTest, ServeStaleWhileRefreshing) {
+  resolver_->SetMaxStaleness(base::TimeDelta::FromHours(1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(2u);  // One for the lookup, one for the refresh.
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  ExpireCacheEntries();
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  // The stale entry is served synchronously.
+  req = CreateRequest("just.testing", 81);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 81));
+
+  // A request which bypasses the cache attaches to the refresh.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 82));
+  info.set_allow_cached_response(false);
+  req = CreateRequest(info);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 82));
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  // The refreshed entry is fresh.
+  req = CreateRequest("just.testing", 83);
+  EXPECT_EQ(OK, req->ResolveFromCache());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 83));
+}
+
+// Test that stale entries are not served without SetMaxStaleness().
+TEST_F(HostResolverImplTest, NoStaleEntriesByDefault) {
+  proc_->SignalMultiple(1u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  ExpireCacheEntries();
+  EXPECT_EQ(ERR_DNS_CACHE_MISS,
+            CreateRequest("just.testing", 80)->ResolveFromCache());
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+}
+
+// Test that RefreshStaleCacheEntries() refreshes the most recently expired
+// entries first.
+TEST_F(HostResolverImplTest, RefreshStaleCacheEntries) {
+  CreateSerialResolver();  // To guarantee order of resolutions.
+  proc_->SignalMultiple(5u);  // Three lookups and two refreshes.
+
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("a", 80)->Resolve());
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("b", 80)->Resolve());
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("c", 80)->Resolve());
+  for (size_t i = 0; i < requests_.size(); ++i)
+    EXPECT_EQ(OK, requests_[i]->WaitForResult()) << i;
+
+  ExpireCacheEntries();
+  EXPECT_EQ(2u, resolver_->RefreshStaleCacheEntries(2u));
+
+  // Wait for the second refresh by attaching a request to it.
+  HostResolver::RequestInfo info(HostPortPair("b", 80));
+  info.set_allow_cached_response(false);
+  Request* req = CreateRequest(info);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  MockHostResolverProc::CaptureList capture_list = proc_->GetCaptureList();
+  ASSERT_EQ(5u, capture_list.size());
+  EXPECT_EQ("a", capture_list[3].hostname);
+  EXPECT_EQ("b", capture_list[4].hostname);
+
+  EXPECT_EQ(OK, CreateRequest("a", 80)->ResolveFromCache());
+  EXPECT_EQ(OK, CreateRequest("b", 80)->ResolveFromCache());
+  EXPECT_EQ(ERR_DNS_CACHE_MISS, CreateRequest("c", 80)->ResolveFromCache());
+}
+
 // Test that IP address changes flush the cache.
 TEST_F(HostResolverImplTest, FlushCacheOnIPAddressChange) {
   proc_->SignalMultiple(2u);  // One before the flush, one after.
@@ -1433,6 +1532,29 @@ TEST_F(HostResolverImplDnsTest, DnsTaskUnspec) {
   EXPECT_TRUE(requests_[3]->HasAddress("192.168.1.101", 80));
 }
 
+// With a search list, the A and AAAA queries may be answered for different
+// suffixes. Only addresses of the name which the A query resolved are used.
+TEST_F(HostResolverImplDnsTest, DnsTaskUnspecSearchMismatch) {
+  // AAAA for "srch.a" fails during the search, which moves on to "srch.b".
+  // Asked again for the fully-qualified "srch.a.", it has no addresses.
+  AddDnsRule("srch.a.", dns_protocol::kTypeAAAA, MockDnsClientRule::EMPTY);
+  AddDnsRule("srch.a", dns_protocol::kTypeA, MockDnsClientRule::OK);
+  AddDnsRule("srch.a", dns_protocol::kTypeAAAA, MockDnsClientRule::FAIL);
+  AddDnsRule("srch.b", dns_protocol::kTypeAAAA, MockDnsClientRule::OK);
+  CreateResolver();
+
+  DnsConfig config = CreateValidDnsConfig();
+  config.search.push_back("a");
+  config.search.push_back("b");
+  ChangeDnsConfig(config);
+
+  Request* req = CreateRequest("srch", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_EQ(1u, req->NumberOfAddresses());
+  EXPECT_TRUE(req->HasAddress("127.0.0.1", 80));
+}
+
 TEST_F(HostResolverImplDnsTest, ServeFromHosts) {
   // Initially, use empty HOSTS file.
   DnsConfig config = CreateValidDnsConfig();
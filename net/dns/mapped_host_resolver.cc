@@ -50,6 +50,10 @@ HostCache* MappedHostResolver::GetHostCache() {
   return impl_->GetHostCache();
 }
 
+size_t MappedHostResolver::RefreshStaleCacheEntries(size_t max_hosts) {
+  return impl_->RefreshStaleCacheEntries(max_hosts);
+}
+
 int MappedHostResolver::ApplyRules(RequestInfo* info) const {
   HostPortPair host_port(info->host_port_pair());
   if (rules_.RewriteHost(&host_port)) {
@@ -55,6 +55,7 @@ class NET_EXPORT MappedHostResolver : public HostResolver {
                                const BoundNetLog& net_log) OVERRIDE;
   virtual void CancelRequest(RequestHandle req) OVERRIDE;
   virtual HostCache* GetHostCache() OVERRIDE;
+  virtual size_t RefreshStaleCacheEntries(size_t max_hosts) OVERRIDE;
 
  private:
   // Modify the request |info| according to |rules_|. Returns either OK or
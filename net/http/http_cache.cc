@@ -93,7 +93,9 @@ HttpCache::ActiveEntry::ActiveEntry(disk_cache::Entry* entry)
     : disk_entry(entry),
       writer(NULL),
       will_process_pending_queue(false),
-      doomed(false) {
+      doomed(false),
+      streaming(false),
+      written_body_size(0) {
 }
 
 HttpCache::ActiveEntry::~ActiveEntry() {
@@ -306,6 +308,8 @@ HttpCache::~HttpCache() {
     entry->will_process_pending_queue = false;
     entry->pending_queue.clear();
     entry->readers.clear();
+    entry->streaming_readers.clear();
+    entry->waiting_for_data.clear();
     entry->writer = NULL;
     DeactivateEntry(entry);
   }
@@ -612,6 +616,7 @@ void HttpCache::FinalizeDoomedEntry(ActiveEntry* entry) {
   DCHECK(entry->doomed);
   DCHECK(!entry->writer);
   DCHECK(entry->readers.empty());
+  DCHECK(entry->streaming_readers.empty());
   DCHECK(entry->pending_queue.empty());
 
   ActiveEntriesSet::iterator it = doomed_entries_.find(entry);
@@ -640,6 +645,7 @@ void HttpCache::DeactivateEntry(ActiveEntry* entry) {
   DCHECK(!entry->writer);
   DCHECK(entry->disk_entry);
   DCHECK(entry->readers.empty());
+  DCHECK(entry->streaming_readers.empty());
   DCHECK(entry->pending_queue.empty());
 
   std::string key = entry->disk_entry->GetKey();
@@ -780,6 +786,16 @@ int HttpCache::AddTransactionToEntry(ActiveEntry* entry, Transaction* trans) {
   //
   // NOTE: If the transaction can only write, then the entry should not be in
   // use (since any existing entry should have already been doomed).
+  //
+  // Once the writer is writing the body of a complete response, transactions
+  // which would use that response don't have to wait: they read the body as
+  // it is written.
+
+  if (entry->streaming &&
+      trans->ReadWhileWriting(*entry->writer->GetResponseInfo())) {
+    entry->streaming_readers.push_back(trans);
+    return OK;
+  }
 
   if (entry->writer || entry->will_process_pending_queue) {
     entry->pending_queue.push_back(trans);
@@ -812,16 +828,19 @@ void HttpCache::DoneWithEntry(ActiveEntry* entry, Transaction* trans,
                               bool cancel) {
   // If we already posted a task to move on to the next transaction and this was
   // the writer, there is nothing to cancel.
-  if (entry->will_process_pending_queue && entry->readers.empty())
+  if (entry->will_process_pending_queue && entry->readers.empty() &&
+      !entry->writer) {
     return;
+  }
 
-  if (entry->writer) {
-    DCHECK(trans == entry->writer);
-
+  if (entry->writer == trans) {
     // Assume there was a failure.
     bool success = false;
     if (cancel) {
       DCHECK(entry->disk_entry);
+      // Whatever happens to the entry, the readers streaming the body won't
+      // get the rest of it from there.
+      TruncateStreamedBody(entry);
       // This is a successful operation in the sense that we want to keep the
       // entry.
       success = trans->AddTruncatedFlag();
@@ -839,18 +858,32 @@ void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
   DCHECK(entry->readers.empty());
 
   entry->writer = NULL;
+  entry->streaming = false;
+
+  // The transactions streaming the body are now regular readers of what was
+  // written.
+  if (!success)
+    TruncateStreamedBody(entry);
+  entry->readers.swap(entry->streaming_readers);
+  NotifyWaitingReaders(entry);
 
   if (success) {
     ProcessPendingQueue(entry);
   } else {
-    DCHECK(!entry->will_process_pending_queue);
-
     // We failed to create this entry.
     TransactionList pending_queue;
     pending_queue.swap(entry->pending_queue);
 
     entry->disk_entry->Doom();
-    DestroyEntry(entry);
+    if (entry->readers.empty() && !entry->will_process_pending_queue) {
+      DestroyEntry(entry);
+    } else if (!entry->doomed) {
+      // The entry has to stay around for its readers (or for the pending task
+      // which will destroy it), but nobody else should find it.
+      active_entries_.erase(entry->disk_entry->GetKey());
+      doomed_entries_.insert(entry);
+      entry->doomed = true;
+    }
 
     // We need to do something about these pending entries, which now need to
     // be added to a new entry.
@@ -863,7 +896,16 @@ void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
 }
 
 void HttpCache::DoneReadingFromEntry(ActiveEntry* entry, Transaction* trans) {
-  DCHECK(!entry->writer);
+  if (entry->writer) {
+    // |trans| was streaming the body the writer is still writing.
+    TransactionList::iterator it =
+        std::find(entry->streaming_readers.begin(),
+                  entry->streaming_readers.end(), trans);
+    DCHECK(it != entry->streaming_readers.end());
+    entry->streaming_readers.erase(it);
+    entry->waiting_for_data.remove(trans);
+    return;
+  }
 
   TransactionList::iterator it =
       std::find(entry->readers.begin(), entry->readers.end(), trans);
@@ -887,6 +929,61 @@ void HttpCache::ConvertWriterToReader(ActiveEntry* entry) {
   ProcessPendingQueue(entry);
 }
 
+void HttpCache::StartStreaming(ActiveEntry* entry) {
+  DCHECK(entry->writer);
+  DCHECK(entry->readers.empty());
+
+  entry->streaming = true;
+  entry->written_body_size = 0;
+  if (!entry->pending_queue.empty())
+    ProcessPendingQueue(entry);
+}
+
+bool HttpCache::StopStreaming(ActiveEntry* entry) {
+  DCHECK(entry->writer);
+  if (!entry->streaming_readers.empty())
+    return false;
+
+  entry->streaming = false;
+  return true;
+}
+
+void HttpCache::DataWrittenToEntry(ActiveEntry* entry) {
+  if (!entry->streaming)
+    return;
+
+  entry->written_body_size =
+      entry->disk_entry->GetDataSize(kResponseContentIndex);
+  NotifyWaitingReaders(entry);
+}
+
+void HttpCache::WaitForStreamedData(ActiveEntry* entry, Transaction* trans) {
+  DCHECK(entry->writer);
+  DCHECK(std::find(entry->streaming_readers.begin(),
+                   entry->streaming_readers.end(), trans) !=
+         entry->streaming_readers.end());
+  entry->waiting_for_data.push_back(trans);
+}
+
+void HttpCache::TruncateStreamedBody(ActiveEntry* entry) {
+  for (TransactionList::iterator it = entry->streaming_readers.begin();
+       it != entry->streaming_readers.end(); ++it) {
+    (*it)->OnStreamedBodyTruncated();
+  }
+}
+
+void HttpCache::NotifyWaitingReaders(ActiveEntry* entry) {
+  // The readers are notified asynchronously, as they may do anything with the
+  // entry, including destroying the writer which is calling us.
+  TransactionList waiting_for_data;
+  waiting_for_data.swap(entry->waiting_for_data);
+  for (TransactionList::iterator it = waiting_for_data.begin();
+       it != waiting_for_data.end(); ++it) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind((*it)->io_callback(), OK));
+  }
+}
+
 LoadState HttpCache::GetLoadStateForPendingTransaction(
       const Transaction* trans) {
   ActiveEntriesMap::const_iterator i = active_entries_.find(trans->key());
@@ -980,7 +1077,29 @@ void HttpCache::ProcessPendingQueue(ActiveEntry* entry) {
 
 void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
   entry->will_process_pending_queue = false;
-  DCHECK(!entry->writer);
+
+  if (entry->writer) {
+    // The writer started streaming the body: let the next transaction which
+    // can read it as it is written do so.
+    if (!entry->streaming)
+      return;
+    TransactionList::iterator it = entry->pending_queue.begin();
+    while (it != entry->pending_queue.end() &&
+           !(*it)->ReadWhileWriting(*entry->writer->GetResponseInfo())) {
+      ++it;
+    }
+    if (it == entry->pending_queue.end())
+      return;
+
+    Transaction* next = *it;
+    entry->pending_queue.erase(it);
+    entry->streaming_readers.push_back(next);
+
+    // Look for more before |next| does anything with the entry.
+    ProcessPendingQueue(entry);
+    next->io_callback().Run(OK);
+    return;
+  }
 
   // If no one is interested in this entry, then we can deactivate it.
   if (entry->pending_queue.empty()) {
@@ -230,6 +230,15 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
     TransactionList    pending_queue;
     bool               will_process_pending_queue;
     bool               doomed;
+
+    // Set while |writer| is writing the body of a complete response, which
+    // |streaming_readers| read as it is written, up to |written_body_size|.
+    // Those of them which have caught up with the writer wait in
+    // |waiting_for_data|.
+    bool               streaming;
+    int                written_body_size;
+    TransactionList    streaming_readers;
+    TransactionList    waiting_for_data;
   };
 
   typedef base::hash_map<std::string, ActiveEntry*> ActiveEntriesMap;
@@ -332,6 +341,31 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // transactions can start reading from this entry.
   void ConvertWriterToReader(ActiveEntry* entry);
 
+  // Called by the writer of |entry| once it has written the headers of a
+  // complete response and starts writing the body, so that transactions
+  // which would use that response can read the body as it is written, instead
+  // of waiting for the writer to finish.
+  void StartStreaming(ActiveEntry* entry);
+
+  // Called by the writer of |entry| when it wants to stop writing the body.
+  // Returns false if it has to keep writing for the transactions streaming it.
+  bool StopStreaming(ActiveEntry* entry);
+
+  // Called by the writer of |entry| whenever it has written more of the body.
+  void DataWrittenToEntry(ActiveEntry* entry);
+
+  // Called by |trans|, which is streaming the body of |entry|, when it has read
+  // all that the writer has written so far. |trans| will be notified via its
+  // IO callback once there is more to read, or the writer is done.
+  void WaitForStreamedData(ActiveEntry* entry, Transaction* trans);
+
+  // Tells the transactions streaming the body of |entry| that its writer
+  // stopped before writing all of it.
+  void TruncateStreamedBody(ActiveEntry* entry);
+
+  // Notifies the transactions waiting for more of the body of |entry|.
+  void NotifyWaitingReaders(ActiveEntry* entry);
+
   // Returns the LoadState of the provided pending transaction.
   LoadState GetLoadStateForPendingTransaction(const Transaction* trans);
 
@@ -0,0 +1,186 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/perftimer.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/http/http_cache.h"
+#include "net/http/http_transaction.h"
+#include "net/http/http_transaction_unittest.h"
+#include "net/http/mock_http_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// The number of requests for the same resource made at once, its size, and
+// how long each read of the network takes.
+const int kConcurrentRequests[] = { 1, 2, 10, 50 };
+const int kBodySize = 1024 * 1024;
+const int kReadBufferSize = 32 * 1024;
+const int kNetworkReadDelayMs = 2;
+
+// Reads a whole response through an HttpCache transaction, recording when the
+// first byte of the body arrives.
+class Request {
+ public:
+  Request(HttpCache* cache, const HttpRequestInfo* request_info,
+          int* outstanding)
+      : request_info_(request_info),
+        outstanding_(outstanding),
+        read_buf_(new IOBuffer(kReadBufferSize)),
+        bytes_read_(0) {
+    EXPECT_EQ(OK, cache->CreateTransaction(DEFAULT_PRIORITY, &trans_, NULL));
+  }
+
+  void Start() {
+    start_time_ = base::TimeTicks::Now();
+    int rv = trans_->Start(
+        request_info_,
+        base::Bind(&Request::OnStartComplete, base::Unretained(this)),
+        BoundNetLog());
+    if (rv != ERR_IO_PENDING)
+      OnStartComplete(rv);
+  }
+
+  base::TimeDelta time_to_first_byte() const {
+    return first_byte_time_ - start_time_;
+  }
+  base::TimeDelta time_to_last_byte() const {
+    return last_byte_time_ - start_time_;
+  }
+  int bytes_read() const { return bytes_read_; }
+
+ private:
+  void OnStartComplete(int result) {
+    EXPECT_EQ(OK, result);
+    if (result == OK)
+      Read();
+    else
+      Done();
+  }
+
+  void Read() {
+    int rv;
+    do {
+      rv = trans_->Read(
+          read_buf_.get(), kReadBufferSize,
+          base::Bind(&Request::OnReadComplete, base::Unretained(this)));
+    } while (rv != ERR_IO_PENDING && DidRead(rv));
+  }
+
+  void OnReadComplete(int result) {
+    if (DidRead(result))
+      Read();
+  }
+
+  // Returns true if there is more to read.
+  bool DidRead(int result) {
+    if (result > 0) {
+      if (!bytes_read_)
+        first_byte_time_ = base::TimeTicks::Now();
+      bytes_read_ += result;
+      return true;
+    }
+    EXPECT_EQ(OK, result);
+    Done();
+    return false;
+  }
+
+  void Done() {
+    last_byte_time_ = base::TimeTicks::Now();
+    trans_.reset();
+    if (!--*outstanding_)
+      base::MessageLoop::current()->Quit();
+  }
+
+  const HttpRequestInfo* request_info_;
+  int* outstanding_;
+  scoped_ptr<HttpTransaction> trans_;
+  scoped_refptr<IOBuffer> read_buf_;
+  int bytes_read_;
+  base::TimeTicks start_time_;
+  base::TimeTicks first_byte_time_;
+  base::TimeTicks last_byte_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(Request);
+};
+
+double Percentile(std::vector<base::TimeDelta> times, double fraction) {
+  std::sort(times.begin(), times.end());
+  size_t index = static_cast<size_t>(fraction * (times.size() - 1));
+  return times[index].InMillisecondsF();
+}
+
+}  // namespace
+
+// Measures how long it takes for N requests for the same resource, made at
+// once against an empty cache, to get the first and the last byte of the body
+// when it arrives slowly from the network.
+TEST(HttpCachePerfTest, ConcurrentRequests) {
+  base::MessageLoopForIO message_loop;
+  const std::string body(kBodySize, 'x');
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.data = body.c_str();
+  MockHttpRequest request_info(transaction);
+
+  for (size_t i = 0; i < arraysize(kConcurrentRequests); ++i) {
+    const int num_requests = kConcurrentRequests[i];
+    MockHttpCache cache;
+    cache.network_layer()->set_read_delay(
+        base::TimeDelta::FromMilliseconds(kNetworkReadDelayMs));
+
+    int outstanding = num_requests;
+    ScopedVector<Request> requests;
+    for (int j = 0; j < num_requests; ++j)
+      requests.push_back(new Request(cache.http_cache(), &request_info,
+                                     &outstanding));
+    PerfTimer timer;
+    for (int j = 0; j < num_requests; ++j)
+      requests[j]->Start();
+    base::MessageLoop::current()->Run();
+    double seconds = timer.Elapsed().InSecondsF();
+
+    EXPECT_EQ(1, cache.network_layer()->transaction_count());
+    std::vector<base::TimeDelta> first_byte_times;
+    std::vector<base::TimeDelta> last_byte_times;
+    for (int j = 0; j < num_requests; ++j) {
+      EXPECT_EQ(kBodySize, requests[j]->bytes_read());
+      first_byte_times.push_back(requests[j]->time_to_first_byte());
+      last_byte_times.push_back(requests[j]->time_to_last_byte());
+    }
+
+    LogPerfResult(
+        base::StringPrintf("http_cache_%d_requests_ttfb_p50",
+                           num_requests).c_str(),
+        Percentile(first_byte_times, 0.5), "ms");
+    LogPerfResult(
+        base::StringPrintf("http_cache_%d_requests_ttfb_max",
+                           num_requests).c_str(),
+        Percentile(first_byte_times, 1.0), "ms");
+    LogPerfResult(
+        base::StringPrintf("http_cache_%d_requests_ttlb_max",
+                           num_requests).c_str(),
+        Percentile(last_byte_times, 1.0), "ms");
+    LogPerfResult(
+        base::StringPrintf("http_cache_%d_requests_total",
+                           num_requests).c_str(),
+        seconds * 1000, "ms");
+  }
+}
+
+}  // namespace net
@@ -22,6 +22,7 @@
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "net/base/completion_callback.h"
 #include "net/base/io_buffer.h"
@@ -188,6 +189,7 @@ HttpCache::Transaction::Transaction(
       done_reading_(false),
       vary_mismatch_(false),
       couldnt_conditionalize_request_(false),
+      streamed_body_truncated_(false),
       io_buf_len_(0),
       read_offset_(0),
       effective_load_flags_(0),
@@ -278,6 +280,27 @@ bool HttpCache::Transaction::AddTruncatedFlag() {
   return true;
 }
 
+bool HttpCache::Transaction::ReadWhileWriting(
+    const HttpResponseInfo& response) {
+  if (partial_.get() || request_->method != "GET")
+    return false;
+
+  if (mode_ != READ) {
+    bool vary_mismatch = false;
+    if (mode_ != READ_WRITE ||
+        ResponseRequiresValidation(response, &vary_mismatch)) {
+      return false;
+    }
+    mode_ = READ;
+  }
+  return true;
+}
+
+void HttpCache::Transaction::OnStreamedBodyTruncated() {
+  DCHECK_EQ(READ, mode_);
+  streamed_body_truncated_ = true;
+}
+
 LoadState HttpCache::Transaction::GetWriterLoadState() const {
   if (network_trans_.get())
     return network_trans_->GetLoadState();
@@ -406,6 +429,13 @@ int HttpCache::Transaction::Read(IOBuffer* buf, int buf_len,
     mode_ = NONE;
   }
 
+  // Once we start reading the body of a complete response, other transactions
+  // can read it as we write it to the entry.
+  if (!reading_ && entry_ && mode_ == WRITE && !partial_.get() &&
+      response_.headers->response_code() == 200) {
+    cache_->StartStreaming(entry_);
+  }
+
   reading_ = true;
   int rv;
 
@@ -448,7 +478,9 @@ void HttpCache::Transaction::StopCaching() {
   // from the net.
   if (cache_.get() && entry_ && (mode_ & WRITE) && network_trans_.get() &&
       !is_sparse_ && !range_requested_) {
-    mode_ = NONE;
+    // Other transactions may be reading the body as we write it.
+    if (cache_->StopStreaming(entry_))
+      mode_ = NONE;
   }
 }
 
@@ -481,6 +513,10 @@ const HttpResponseInfo* HttpCache::Transaction::GetResponseInfo() const {
 }
 
 LoadState HttpCache::Transaction::GetLoadState() const {
+  // While reading the body another transaction is writing, we wait for it.
+  if (entry_ && entry_->writer && entry_->writer != this)
+    return entry_->writer->GetWriterLoadState();
+
   LoadState state = GetWriterLoadState();
   if (state != LOAD_STATE_WAITING_FOR_CACHE)
     return state;
@@ -611,6 +647,20 @@ int HttpCache::Transaction::HandleResult(int rv) {
 //   SuccessfulSendRequest -> UpdateCachedResponse* -> OverwriteCachedResponse
 //   -> PartialHeadersReceived -> NetworkRead* -> CacheWriteData*
 //
+// Entry being written by another transaction, which stops before the end:
+//   Start():
+//   GetBackend* -> InitEntry -> OpenEntry* -> AddToEntry* -> CacheReadResponse*
+//   -> BeginPartialCacheValidation() -> BeginCacheValidation()
+//
+//   Read() 1:
+//   CacheReadData*
+//
+//   Read() 2:
+//   CacheReadData* -> ResumeStreamedBody* -> NetworkRead*
+//
+//   Read() 3:
+//   NetworkRead*
+//
 int HttpCache::Transaction::DoLoop(int result) {
   DCHECK(next_state_ != STATE_NONE);
 
@@ -754,6 +804,13 @@ int HttpCache::Transaction::DoLoop(int result) {
       case STATE_CACHE_READ_DATA_COMPLETE:
         rv = DoCacheReadDataComplete(rv);
         break;
+      case STATE_RESUME_STREAMED_BODY:
+        DCHECK_EQ(OK, rv);
+        rv = DoResumeStreamedBody();
+        break;
+      case STATE_RESUME_STREAMED_BODY_COMPLETE:
+        rv = DoResumeStreamedBodyComplete(rv);
+        break;
       case STATE_CACHE_WRITE_DATA:
         rv = DoCacheWriteData(rv);
         break;
@@ -1560,7 +1617,28 @@ int HttpCache::Transaction::DoCacheQueryDataComplete(int result) {
 }
 
 int HttpCache::Transaction::DoCacheReadData() {
+  // We may be back here after waiting for the writer, so the entry may be
+  // gone with the cache.
+  if (!cache_.get())
+    return ERR_UNEXPECTED;
   DCHECK(entry_);
+
+  int read_len = io_buf_len_;
+  if (entry_->writer && entry_->writer != this) {
+    // We are reading the body as the writer writes it, so we can't go past
+    // what it has written. If that is all of it, let the read find the end.
+    DCHECK(!partial_.get());
+    int available = entry_->written_body_size - read_offset_;
+    int64 body_size = response_.headers->GetContentLength();
+    if (!available && (body_size < 0 || read_offset_ < body_size)) {
+      next_state_ = STATE_CACHE_READ_DATA;
+      cache_->WaitForStreamedData(entry_, this);
+      return ERR_IO_PENDING;
+    }
+    if (available)
+      read_len = std::min(read_len, available);
+  }
+
   next_state_ = STATE_CACHE_READ_DATA_COMPLETE;
 
   if (net_log_.IsLoggingAllEvents())
@@ -1574,7 +1652,7 @@ int HttpCache::Transaction::DoCacheReadData() {
   return ResetCacheIOStart(entry_->disk_entry->ReadData(kResponseContentIndex,
                                                         read_offset_,
                                                         read_buf_.get(),
-                                                        io_buf_len_,
+                                                        read_len,
                                                         io_callback_));
 }
 
@@ -1598,6 +1676,16 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
   if (result > 0) {
     read_offset_ += result;
   } else if (result == 0) {  // End of file.
+    if (streamed_body_truncated_ &&
+        response_.headers->GetContentLength() != read_offset_) {
+      // We were reading the body as it was written, and the writer stopped
+      // before the end. Like a transaction that was waiting for that writer,
+      // we go to the network, but only for what we haven't read yet.
+      cache_->DoneReadingFromEntry(entry_, this);
+      entry_ = NULL;
+      next_state_ = STATE_RESUME_STREAMED_BODY;
+      return OK;
+    }
     RecordHistograms();
     cache_->DoneReadingFromEntry(entry_, this);
     entry_ = NULL;
@@ -1607,6 +1695,64 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
   return result;
 }
 
+int HttpCache::Transaction::DoResumeStreamedBody() {
+  DCHECK(!network_trans_.get());
+  DCHECK_GT(read_offset_, 0);
+
+  // The rest of the body has to be the rest of what we already returned.
+  if (response_.headers->HasHeaderValue("Accept-Ranges", "none") ||
+      !response_.headers->HasStrongValidators()) {
+    return ERR_CACHE_READ_FAILURE;
+  }
+
+  std::string validator;
+  if (!response_.headers->EnumerateHeader(NULL, "etag", &validator))
+    response_.headers->EnumerateHeader(NULL, "last-modified", &validator);
+
+  custom_request_.reset(new HttpRequestInfo(*request_));
+  request_ = custom_request_.get();
+  custom_request_->extra_headers.SetHeader(
+      HttpRequestHeaders::kRange,
+      base::StringPrintf("bytes=%d-", read_offset_));
+  custom_request_->extra_headers.SetHeader(HttpRequestHeaders::kIfRange,
+                                           validator);
+
+  // From now on, we just read from the network.
+  mode_ = NONE;
+
+  int rv = cache_->network_layer_->CreateTransaction(
+      priority_, &network_trans_, NULL);
+  if (rv != OK)
+    return rv;
+
+  ReportNetworkActionStart();
+  next_state_ = STATE_RESUME_STREAMED_BODY_COMPLETE;
+  return network_trans_->Start(request_, io_callback_, net_log_);
+}
+
+int HttpCache::Transaction::DoResumeStreamedBodyComplete(int result) {
+  ReportNetworkActionFinish();
+  if (result != OK)
+    return result;
+
+  // Anything but the rest of the same body is useless to our consumer.
+  const HttpResponseHeaders* headers =
+      network_trans_->GetResponseInfo()->headers.get();
+  int64 first_byte_position, last_byte_position, instance_length;
+  if (headers->response_code() != 206 ||
+      !headers->GetContentRange(&first_byte_position, &last_byte_position,
+                                &instance_length) ||
+      first_byte_position != read_offset_ ||
+      (response_.headers->GetContentLength() >= 0 &&
+       instance_length != response_.headers->GetContentLength())) {
+    ResetNetworkTransaction();
+    return ERR_CACHE_READ_FAILURE;
+  }
+
+  next_state_ = STATE_NETWORK_READ;
+  return OK;
+}
+
 int HttpCache::Transaction::DoCacheWriteData(int num_bytes) {
   next_state_ = STATE_CACHE_WRITE_DATA_COMPLETE;
   write_len_ = num_bytes;
@@ -1639,11 +1785,15 @@ int HttpCache::Transaction::DoCacheWriteDataComplete(int result) {
     // We want to ignore errors writing to disk and just keep reading from
     // the network.
     result = write_len_;
-  } else if (!done_reading_ && entry_) {
-    int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
-    int64 body_size = response_.headers->GetContentLength();
-    if (body_size >= 0 && body_size <= current_size)
-      done_reading_ = true;
+  } else if (entry_) {
+    if (!done_reading_) {
+      int current_size =
+          entry_->disk_entry->GetDataSize(kResponseContentIndex);
+      int64 body_size = response_.headers->GetContentLength();
+      if (body_size >= 0 && body_size <= current_size)
+        done_reading_ = true;
+    }
+    cache_->DataWrittenToEntry(entry_);
   }
 
   if (partial_.get()) {
@@ -1979,6 +2129,11 @@ int HttpCache::Transaction::RestartNetworkRequestWithAuth(
 }
 
 bool HttpCache::Transaction::RequiresValidation() {
+  return ResponseRequiresValidation(response_, &vary_mismatch_);
+}
+
+bool HttpCache::Transaction::ResponseRequiresValidation(
+    const HttpResponseInfo& response, bool* vary_mismatch) const {
   // TODO(darin): need to do more work here:
   //  - make sure we have a matching request method
   //  - watch out for cached responses that depend on authentication
@@ -1987,10 +2142,10 @@ bool HttpCache::Transaction::RequiresValidation() {
   if (cache_->mode() == net::HttpCache::PLAYBACK)
     return false;
 
-  if (response_.vary_data.is_valid() &&
-      !response_.vary_data.MatchesRequest(*request_,
-                                          *response_.headers.get())) {
-    vary_mismatch_ = true;
+  if (response.vary_data.is_valid() &&
+      !response.vary_data.MatchesRequest(*request_,
+                                         *response.headers.get())) {
+    *vary_mismatch = true;
     return true;
   }
 
@@ -2003,8 +2158,8 @@ bool HttpCache::Transaction::RequiresValidation() {
   if (request_->method == "PUT" || request_->method == "DELETE")
     return true;
 
-  if (response_.headers->RequiresValidation(
-          response_.request_time, response_.response_time, Time::Now())) {
+  if (response.headers->RequiresValidation(
+          response.request_time, response.response_time, Time::Now())) {
     return true;
   }
 
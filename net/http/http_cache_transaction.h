@@ -95,6 +95,18 @@ class HttpCache::Transaction : public HttpTransaction {
 
   HttpCache::ActiveEntry* entry() { return entry_; }
 
+  // Called while this transaction waits for an entry whose writer is writing
+  // |response|. Returns true if this transaction can use that response and
+  // read its body as it is written, in which case it switches to only reading
+  // the entry. Range requests, and requests which have to validate the
+  // response, keep waiting for the writer to finish.
+  bool ReadWhileWriting(const HttpResponseInfo& response);
+
+  // Called while this transaction reads the body of an entry as it is written,
+  // when the writer stops before writing all of it. Once this transaction has
+  // read what was written, it asks the server for the rest.
+  void OnStreamedBodyTruncated();
+
   // Returns the LoadState of the writer transaction of a given ActiveEntry. In
   // other words, returns the LoadState of this transaction without asking the
   // http cache, because this transaction should be the one currently writing
@@ -182,6 +194,8 @@ class HttpCache::Transaction : public HttpTransaction {
     STATE_CACHE_QUERY_DATA_COMPLETE,
     STATE_CACHE_READ_DATA,
     STATE_CACHE_READ_DATA_COMPLETE,
+    STATE_RESUME_STREAMED_BODY,
+    STATE_RESUME_STREAMED_BODY_COMPLETE,
     STATE_CACHE_WRITE_DATA,
     STATE_CACHE_WRITE_DATA_COMPLETE
   };
@@ -254,6 +268,8 @@ class HttpCache::Transaction : public HttpTransaction {
   int DoCacheQueryDataComplete(int result);
   int DoCacheReadData();
   int DoCacheReadDataComplete(int result);
+  int DoResumeStreamedBody();
+  int DoResumeStreamedBodyComplete(int result);
   int DoCacheWriteData(int num_bytes);
   int DoCacheWriteDataComplete(int result);
 
@@ -299,6 +315,12 @@ class HttpCache::Transaction : public HttpTransaction {
   // Called to determine if we need to validate the cache entry before using it.
   bool RequiresValidation();
 
+  // Called to determine if we need to validate |response| before using it.
+  // Sets |*vary_mismatch| if that is because the request doesn't match the
+  // Vary header of |response|.
+  bool ResponseRequiresValidation(const HttpResponseInfo& response,
+                                  bool* vary_mismatch) const;
+
   // Called to make the request conditional (to ask the server if the cached
   // copy is valid).  Returns true if able to make the request conditional.
   bool ConditionalizeRequest();
@@ -422,6 +444,7 @@ class HttpCache::Transaction : public HttpTransaction {
   bool done_reading_;
   bool vary_mismatch_;  // The request doesn't match the stored vary data.
   bool couldnt_conditionalize_request_;
+  bool streamed_body_truncated_;  // The writer we read from stopped early.
   scoped_refptr<IOBuffer> read_buf_;
   int io_buf_len_;
   int read_offset_;
@@ -1396,11 +1396,12 @@ TEST(HttpCache, SimpleGET_RacingReaders) {
   c->result = c->callback.WaitForResult();
   ReadAndVerifyTransaction(c->trans.get(), kSimpleGET_Transaction);
 
-  // Now we have 2 active readers and two queued transactions.
+  // The other transactions joined the entry while the body was being written,
+  // so now we have 4 active readers.
 
   EXPECT_EQ(net::LOAD_STATE_IDLE,
             context_list[2]->trans->GetLoadState());
-  EXPECT_EQ(net::LOAD_STATE_WAITING_FOR_CACHE,
+  EXPECT_EQ(net::LOAD_STATE_IDLE,
             context_list[3]->trans->GetLoadState());
 
   c = context_list[1];
@@ -1409,10 +1410,8 @@ TEST(HttpCache, SimpleGET_RacingReaders) {
   if (c->result == net::OK)
     ReadAndVerifyTransaction(c->trans.get(), kSimpleGET_Transaction);
 
-  // At this point we have one reader, two pending transactions and a task on
-  // the queue to move to the next transaction. Now we cancel the request that
-  // is the current reader, and expect the queued task to be able to start the
-  // next request.
+  // Now we cancel one of the remaining readers, and expect the others to be
+  // able to finish.
 
   c = context_list[2];
   c->trans.reset();
@@ -1437,6 +1436,254 @@ TEST(HttpCache, SimpleGET_RacingReaders) {
   }
 }
 
+// Tests that transactions which would use the response being written to an
+// entry read its body as it is written, instead of waiting for the writer.
+TEST(HttpCache, SimpleGET_StreamingReaders) {
+  MockHttpCache cache;
+  MockHttpRequest request(kSimpleGET_Transaction);
+  const std::string expected(kSimpleGET_Transaction.data);
+  const int kFirstReadSize = 10;
+
+  ScopedVector<Context> context_list;
+  const int kNumTransactions = 4;
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    context_list.push_back(new Context());
+    Context* c = context_list[i];
+
+    c->result = cache.http_cache()->CreateTransaction(
+        net::DEFAULT_PRIORITY, &c->trans, NULL);
+    EXPECT_EQ(net::OK, c->result);
+
+    c->result = c->trans->Start(
+        &request, c->callback.callback(), net::BoundNetLog());
+  }
+
+  base::MessageLoop::current()->RunUntilIdle();
+
+  // The writer has the headers, and the others wait for it to read the body.
+  Context* writer = context_list[0];
+  EXPECT_EQ(net::OK, writer->callback.WaitForResult());
+  for (int i = 1; i < kNumTransactions; ++i)
+    EXPECT_FALSE(context_list[i]->callback.have_result());
+
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(kFirstReadSize));
+  int rv = writer->trans->Read(buf.get(), kFirstReadSize,
+                               writer->callback.callback());
+  EXPECT_EQ(kFirstReadSize, writer->callback.GetResult(rv));
+  base::MessageLoop::current()->RunUntilIdle();
+
+  // Now the others can read what was written, and wait for the rest.
+  for (int i = 1; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    ASSERT_TRUE(c->callback.have_result());
+    EXPECT_EQ(net::OK, c->callback.WaitForResult());
+    // They wait for what the writer is waiting for.
+    EXPECT_EQ(net::LOAD_STATE_READING_RESPONSE, c->trans->GetLoadState());
+
+    scoped_refptr<net::IOBuffer> reader_buf(new net::IOBuffer(256));
+    rv = c->trans->Read(reader_buf.get(), 256, c->callback.callback());
+    EXPECT_EQ(kFirstReadSize, c->callback.GetResult(rv));
+    EXPECT_EQ(expected.substr(0, kFirstReadSize),
+              std::string(reader_buf->data(), kFirstReadSize));
+
+    c->result = c->trans->Read(reader_buf.get(), 256, c->callback.callback());
+    EXPECT_EQ(net::ERR_IO_PENDING, c->result);
+  }
+  base::MessageLoop::current()->RunUntilIdle();
+  for (int i = 1; i < kNumTransactions; ++i)
+    EXPECT_FALSE(context_list[i]->callback.have_result());
+
+  std::string content;
+  EXPECT_EQ(net::OK, ReadTransaction(writer->trans.get(), &content));
+  EXPECT_EQ(expected.substr(kFirstReadSize), content);
+
+  // The readers get the rest of the body, which is complete.
+  for (int i = 1; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    rv = c->callback.WaitForResult();
+    EXPECT_EQ(static_cast<int>(expected.size()) - kFirstReadSize, rv);
+    EXPECT_EQ(net::OK, ReadTransaction(c->trans.get(), &content));
+    EXPECT_EQ(std::string(), content);
+  }
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // The entry can be used as usual.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+}
+
+// Tests that transactions reading the body as it is written don't take it as
+// complete when the writer goes away before the end.
+TEST(HttpCache, SimpleGET_StreamingReadersWriterCancelled) {
+  MockHttpCache cache;
+  MockHttpRequest request(kSimpleGET_Transaction);
+  const int kFirstReadSize = 10;
+
+  Context writer;
+  Context reader;
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &writer.trans, NULL));
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &reader.trans, NULL));
+  writer.result = writer.trans->Start(
+      &request, writer.callback.callback(), net::BoundNetLog());
+  reader.result = reader.trans->Start(
+      &request, reader.callback.callback(), net::BoundNetLog());
+  EXPECT_EQ(net::OK, writer.callback.GetResult(writer.result));
+
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(256));
+  int rv = writer.trans->Read(buf.get(), kFirstReadSize,
+                              writer.callback.callback());
+  EXPECT_EQ(kFirstReadSize, writer.callback.GetResult(rv));
+  EXPECT_EQ(net::OK, reader.callback.GetResult(reader.result));
+
+  rv = reader.trans->Read(buf.get(), 256, reader.callback.callback());
+  EXPECT_EQ(kFirstReadSize, reader.callback.GetResult(rv));
+  rv = reader.trans->Read(buf.get(), 256, reader.callback.callback());
+  EXPECT_EQ(net::ERR_IO_PENDING, rv);
+
+  writer.trans.reset();
+  EXPECT_EQ(net::ERR_CACHE_READ_FAILURE, reader.callback.WaitForResult());
+  reader.trans.reset();
+
+  // The incomplete response was not kept.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->create_count());
+}
+
+// Serves the whole resource of kRangeGET_TransactionOK, or the requested range
+// of it.
+static void StreamedRangeHandler(const net::HttpRequestInfo* request,
+                                 std::string* response_status,
+                                 std::string* response_headers,
+                                 std::string* response_data) {
+  if (!request->extra_headers.HasHeader(net::HttpRequestHeaders::kRange))
+    return;
+
+  std::string if_range;
+  EXPECT_TRUE(request->extra_headers.GetHeader(
+      net::HttpRequestHeaders::kIfRange, &if_range));
+  EXPECT_EQ("\"foo\"", if_range);
+  response_status->assign("HTTP/1.1 206 Partial Content");
+  RangeTransactionServer::RangeHandler(request, response_status,
+                                       response_headers, response_data);
+}
+
+// Tests that transactions reading the body as it is written get the rest of it
+// from the server when the writer goes away before the end.
+TEST(HttpCache, SimpleGET_StreamingReadersWriterCancelledResume) {
+  MockHttpCache cache;
+  MockTransaction transaction(kRangeGET_TransactionOK);
+  transaction.request_headers = EXTRA_HEADER;
+  transaction.status = "HTTP/1.1 200 OK";
+  transaction.response_headers =
+      "Last-Modified: Sat, 18 Apr 2007 01:10:43 GMT\n"
+      "ETag: \"foo\"\n"
+      "Accept-Ranges: bytes\n"
+      "Content-Length: 80\n";
+  transaction.data = "rg: 00-09 rg: 10-19 rg: 20-29 rg: 30-39 rg: 40-49 "
+                     "rg: 50-59 rg: 60-69 rg: 70-79 ";
+  transaction.handler = &StreamedRangeHandler;
+  AddMockTransaction(&transaction);
+  MockHttpRequest request(transaction);
+  const std::string expected(transaction.data);
+  const int kFirstReadSize = 10;
+
+  Context writer;
+  Context reader;
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &writer.trans, NULL));
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &reader.trans, NULL));
+  writer.result = writer.trans->Start(
+      &request, writer.callback.callback(), net::BoundNetLog());
+  reader.result = reader.trans->Start(
+      &request, reader.callback.callback(), net::BoundNetLog());
+  EXPECT_EQ(net::OK, writer.callback.GetResult(writer.result));
+
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(256));
+  int rv = writer.trans->Read(buf.get(), kFirstReadSize,
+                              writer.callback.callback());
+  EXPECT_EQ(kFirstReadSize, writer.callback.GetResult(rv));
+  EXPECT_EQ(net::OK, reader.callback.GetResult(reader.result));
+
+  rv = reader.trans->Read(buf.get(), 256, reader.callback.callback());
+  EXPECT_EQ(kFirstReadSize, reader.callback.GetResult(rv));
+  rv = reader.trans->Read(buf.get(), 256, reader.callback.callback());
+  EXPECT_EQ(net::ERR_IO_PENDING, rv);
+
+  // The reader gets the rest of the body with a range request.
+  writer.trans.reset();
+  rv = reader.callback.WaitForResult();
+  ASSERT_EQ(static_cast<int>(expected.size()) - kFirstReadSize, rv);
+  EXPECT_EQ(expected.substr(kFirstReadSize), std::string(buf->data(), rv));
+  std::string content;
+  EXPECT_EQ(net::OK, ReadTransaction(reader.trans.get(), &content));
+  EXPECT_EQ(std::string(), content);
+  reader.trans.reset();
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+
+  // The truncated entry is completed by the next request, which validates
+  // what is stored and asks for the rest, and then used as usual.
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(4, cache.network_layer()->transaction_count());
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(4, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  RemoveMockTransaction(&transaction);
+}
+
+// Tests that a transaction which has to validate the response being written
+// waits for the writer to finish instead of reading the body as it is written.
+TEST(HttpCache, SimpleGET_StreamingValidationWaits) {
+  MockHttpCache cache;
+  MockHttpRequest request(kSimpleGET_Transaction);
+  MockHttpRequest validating_request(kSimpleGET_Transaction);
+  validating_request.load_flags = net::LOAD_VALIDATE_CACHE;
+
+  Context writer;
+  Context reader;
+  Context validator;
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &writer.trans, NULL));
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &validator.trans, NULL));
+  EXPECT_EQ(net::OK, cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &reader.trans, NULL));
+  writer.result = writer.trans->Start(
+      &request, writer.callback.callback(), net::BoundNetLog());
+  validator.result = validator.trans->Start(
+      &validating_request, validator.callback.callback(), net::BoundNetLog());
+  reader.result = reader.trans->Start(
+      &request, reader.callback.callback(), net::BoundNetLog());
+  EXPECT_EQ(net::OK, writer.callback.GetResult(writer.result));
+
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(256));
+  int rv = writer.trans->Read(buf.get(), 10, writer.callback.callback());
+  EXPECT_EQ(10, writer.callback.GetResult(rv));
+  base::MessageLoop::current()->RunUntilIdle();
+
+  // The reader got ahead of the validator, which is still waiting.
+  EXPECT_TRUE(reader.callback.have_result());
+  EXPECT_FALSE(validator.callback.have_result());
+
+  std::string content;
+  EXPECT_EQ(net::OK, ReadTransaction(writer.trans.get(), &content));
+  writer.trans.reset();
+  ReadAndVerifyTransaction(reader.trans.get(), kSimpleGET_Transaction);
+  reader.trans.reset();
+
+  EXPECT_EQ(net::OK, validator.callback.WaitForResult());
+  ReadAndVerifyTransaction(validator.trans.get(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+}
+
 // Tests that we can doom an entry with pending transactions and delete one of
 // the pending transactions before the first one completes.
 // See http://code.google.com/p/chromium/issues/detail?id=25588
@@ -441,7 +441,8 @@ int HttpProxyClientSocketPool::RequestSocket(
       static_cast<const scoped_refptr<HttpProxySocketParams>*>(socket_params);
 
   return base_.RequestSocket(group_name, *casted_socket_params, priority,
-                             handle, callback, net_log);
+                             handle, callback, true /* predict_demand */,
+                             net_log);
 }
 
 void HttpProxyClientSocketPool::RequestSockets(
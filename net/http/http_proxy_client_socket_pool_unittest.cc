@@ -68,6 +68,7 @@ class HttpProxyClientSocketPoolTest
                                       LOWEST,
                                       false,
                                       false,
+                                      true,
                                       OnHostResolutionCallback())),
         ignored_ssl_socket_params_(
             new SSLSocketParams(ignored_transport_socket_params_,
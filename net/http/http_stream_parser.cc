@@ -179,6 +179,7 @@ HttpStreamParser::HttpStreamParser(ClientSocketHandle* connection,
       read_buf_(read_buffer),
       read_buf_unused_offset_(0),
       response_header_start_offset_(-1),
+      end_of_header_search_offset_(0),
       response_body_length_(-1),
       response_body_read_(0),
       user_read_buf_(NULL),
@@ -505,9 +506,17 @@ int HttpStreamParser::DoSendRequestReadingBody(int result) {
 int HttpStreamParser::DoReadHeaders() {
   io_state_ = STATE_READ_HEADERS_COMPLETE;
 
-  // Grow the read buffer if necessary.
-  if (read_buf_->RemainingCapacity() == 0)
-    read_buf_->SetCapacity(read_buf_->capacity() + kHeaderBufInitialSize);
+  // Grow the read buffer if necessary. Doubling it, rather than growing it by
+  // a fixed amount, keeps the cost of copying large headers as they trickle
+  // in linear.
+  if (read_buf_->RemainingCapacity() == 0) {
+    int capacity = read_buf_->capacity() * 2;
+    if (capacity < kHeaderBufInitialSize)
+      capacity = kHeaderBufInitialSize;
+    if (capacity > kMaxHeaderBufSize)
+      capacity = kMaxHeaderBufSize;
+    read_buf_->SetCapacity(capacity);
+  }
 
   // http://crbug.com/16371: We're seeing |user_buf_->data()| return NULL.
   // See if the user is passing in an IOBuffer with a NULL |data_|.
@@ -609,6 +618,7 @@ int HttpStreamParser::DoReadHeadersComplete(int result) {
         // response and reject it in the event that we're setting up a CONNECT
         // tunnel.
         response_header_start_offset_ = -1;
+        end_of_header_search_offset_ = 0;
         response_body_length_ = -1;
         io_state_ = STATE_REQUEST_SENT;
       } else {
@@ -765,9 +775,15 @@ int HttpStreamParser::ParseResponseHeaders() {
   }
 
   if (response_header_start_offset_ >= 0) {
+    int search_offset = std::max(response_header_start_offset_,
+                                 end_of_header_search_offset_);
     end_offset = HttpUtil::LocateEndOfHeaders(read_buf_->StartOfBuffer(),
                                               read_buf_->offset(),
-                                              response_header_start_offset_);
+                                              search_offset);
+    // The longest end-of-headers marker, "\n\r\n", could start in the last
+    // two bytes searched, so the next search has to include them.
+    if (end_offset == -1)
+      end_of_header_search_offset_ = read_buf_->offset() - 2;
   } else if (read_buf_->offset() >= 8) {
     // Enough data to decide that this is an HTTP/0.9 response.
     // 8 bytes = (4 bytes of junk) + "http".length()
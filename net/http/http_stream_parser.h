@@ -124,8 +124,8 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
     STATE_DONE
   };
 
-  // The number of bytes by which the header buffer is grown when it reaches
-  // capacity.
+  // The initial size of the header buffer. Whenever it reaches capacity, its
+  // size is doubled, up to |kMaxHeaderBufSize|.
   static const int kHeaderBufInitialSize = 4 * 1024;  // 4K
 
   // |kMaxHeaderBufSize| is the number of bytes that the response headers can
@@ -186,6 +186,11 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   // -1 if not found yet.
   int response_header_start_offset_;
 
+  // The offset in |read_buf_| from which the search for the end of the
+  // headers resumes when more data arrives, so that the data already searched
+  // is not searched again.
+  int end_of_header_search_offset_;
+
   // The parsed response headers.  Owned by the caller.
   HttpResponseInfo* response_;
 
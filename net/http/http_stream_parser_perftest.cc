@@ -0,0 +1,111 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_stream_parser.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/strings/stringprintf.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/socket/client_socket_handle.h"
+#include "net/socket/socket_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kIterations = 200;
+
+// Returns a response whose headers are about |size| bytes long.
+std::string MakeResponse(size_t size) {
+  std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n";
+  for (int i = 0; response.size() < size; ++i) {
+    response += base::StringPrintf(
+        "X-Header-%d: a moderately long header value, like a cookie\r\n", i);
+  }
+  response += "\r\n";
+  return response;
+}
+
+// Reads the headers of |response| with an HttpStreamParser, with the socket
+// returning |segment_size| bytes on every read, as if the headers had arrived
+// in packets of that size.
+void ReadResponseHeaders(const std::string& response, size_t segment_size) {
+  MockWrite writes[] = {
+    MockWrite(SYNCHRONOUS, "GET / HTTP/1.1\r\n\r\n"),
+  };
+  std::vector<MockRead> reads;
+  for (size_t offset = 0; offset < response.size(); offset += segment_size) {
+    reads.push_back(MockRead(
+        SYNCHRONOUS, response.data() + offset,
+        std::min(segment_size, response.size() - offset)));
+  }
+  StaticSocketDataProvider data(&reads[0], reads.size(),
+                                writes, arraysize(writes));
+  data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+
+  scoped_ptr<MockTCPClientSocket> transport(
+      new MockTCPClientSocket(AddressList(), NULL, &data));
+  TestCompletionCallback callback;
+  ASSERT_EQ(OK, transport->Connect(callback.callback()));
+
+  ClientSocketHandle socket_handle;
+  socket_handle.set_socket(transport.release());
+
+  HttpRequestInfo request_info;
+  request_info.method = "GET";
+  request_info.url = GURL("http://localhost");
+
+  scoped_refptr<GrowableIOBuffer> read_buffer(new GrowableIOBuffer);
+  HttpStreamParser parser(&socket_handle, &request_info, read_buffer.get(),
+                          BoundNetLog());
+  HttpRequestHeaders request_headers;
+  HttpResponseInfo response_info;
+  ASSERT_EQ(OK, parser.SendRequest("GET / HTTP/1.1\r\n", request_headers,
+                                   &response_info, callback.callback()));
+  ASSERT_EQ(OK, parser.ReadResponseHeaders(callback.callback()));
+  ASSERT_EQ(200, response_info.headers->response_code());
+}
+
+}  // namespace
+
+// Measures how long it takes to read response headers of 1K to 64K, delivered
+// in small segments and in segments of a full Ethernet packet.
+TEST(HttpStreamParserPerfTest, ReadResponseHeaders) {
+  const size_t kHeaderSizes[] = { 1024, 4 * 1024, 16 * 1024, 64 * 1024 };
+  const size_t kSegmentSizes[] = { 100, 1460 };
+
+  for (size_t i = 0; i < arraysize(kHeaderSizes); ++i) {
+    const std::string response = MakeResponse(kHeaderSizes[i]);
+    for (size_t j = 0; j < arraysize(kSegmentSizes); ++j) {
+      PerfTimer timer;
+      for (int k = 0; k < kIterations; ++k)
+        ReadResponseHeaders(response, kSegmentSizes[j]);
+      double seconds = timer.Elapsed().InSecondsF();
+      std::string name = base::StringPrintf(
+          "http_stream_parser_headers_%dK_segments_%d",
+          static_cast<int>(kHeaderSizes[i] / 1024),
+          static_cast<int>(kSegmentSizes[j]));
+      LogPerfResult(name.c_str(), kIterations / seconds, "responses/s");
+    }
+  }
+}
+
+}  // namespace net
@@ -4,6 +4,9 @@
 
 #include "net/http/http_stream_parser.h"
 
+#include <string>
+#include <vector>
+
 #include "base/file_util.h"
 #include "base/files/file_path.h"
 #include "base/files/scoped_temp_dir.h"
@@ -18,6 +21,7 @@
 #include "net/base/upload_file_element_reader.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_request_info.h"
+#include "net/http/http_response_headers.h"
 #include "net/http/http_response_info.h"
 #include "net/socket/client_socket_handle.h"
 #include "net/socket/socket_test_util.h"
@@ -413,4 +417,66 @@ TEST(HttpStreamParser, TruncatedHeaders) {
   }
 }
 
+// Feeds large response headers to the parser one byte at a time, so that the
+// search for the end of the headers resumes after every byte and the header
+// buffer has to grow several times, for each kind of end-of-headers marker.
+TEST(HttpStreamParser, HeadersReadOneByteAtATime) {
+  const char* const kEndOfHeaders[] = { "\r\n\r\n", "\n\n", "\n\r\n" };
+
+  MockWrite writes[] = {
+    MockWrite(SYNCHRONOUS, 0, "GET / HTTP/1.1\r\n\r\n"),
+  };
+
+  for (size_t i = 0; i < arraysize(kEndOfHeaders); ++i) {
+    SCOPED_TRACE(i);
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n";
+    for (int j = 0; j < 500; ++j)
+      response += base::StringPrintf("X-Header-%d: value\r\n", j);
+    response += "X-Last: 1";
+    response += kEndOfHeaders[i];
+
+    std::vector<MockRead> reads;
+    for (size_t j = 0; j < response.size(); ++j)
+      reads.push_back(MockRead(SYNCHRONOUS, response.data() + j, 1, j + 1));
+    DeterministicSocketData data(&reads[0], reads.size(),
+                                 writes, arraysize(writes));
+    data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+    data.SetStop(reads.size() + 1);
+
+    scoped_ptr<DeterministicMockTCPClientSocket> transport(
+        new DeterministicMockTCPClientSocket(NULL, &data));
+    data.set_delegate(transport->AsWeakPtr());
+
+    TestCompletionCallback callback;
+    int rv = transport->Connect(callback.callback());
+    ASSERT_EQ(OK, callback.GetResult(rv));
+
+    scoped_ptr<ClientSocketHandle> socket_handle(new ClientSocketHandle);
+    socket_handle->set_socket(transport.release());
+
+    HttpRequestInfo request_info;
+    request_info.method = "GET";
+    request_info.url = GURL("http://localhost");
+    request_info.load_flags = LOAD_NORMAL;
+
+    scoped_refptr<GrowableIOBuffer> read_buffer(new GrowableIOBuffer);
+    HttpStreamParser parser(
+        socket_handle.get(), &request_info, read_buffer.get(), BoundNetLog());
+
+    HttpRequestHeaders request_headers;
+    HttpResponseInfo response_info;
+    rv = parser.SendRequest("GET / HTTP/1.1\r\n", request_headers,
+                            &response_info, callback.callback());
+    ASSERT_EQ(OK, rv);
+
+    rv = parser.ReadResponseHeaders(callback.callback());
+    ASSERT_EQ(OK, rv);
+    ASSERT_TRUE(response_info.headers.get());
+    EXPECT_EQ(200, response_info.headers->response_code());
+    EXPECT_TRUE(response_info.headers->HasHeaderValue("X-Last", "1"));
+    EXPECT_TRUE(
+        response_info.headers->HasHeaderValue("X-Header-499", "value"));
+  }
+}
+
 }  // namespace net
@@ -319,6 +319,15 @@ int MockNetworkTransaction::Read(net::IOBuffer* buf, int buf_len,
   if (test_mode_ & TEST_MODE_SYNC_NET_READ)
     return num;
 
+  if (transaction_factory_.get() &&
+      transaction_factory_->read_delay() > base::TimeDelta()) {
+    base::MessageLoop::current()->PostDelayedTask(
+        FROM_HERE, base::Bind(&MockNetworkTransaction::RunCallback,
+                              weak_factory_.GetWeakPtr(), callback, num),
+        transaction_factory_->read_delay());
+    return net::ERR_IO_PENDING;
+  }
+
   CallbackLater(callback, num);
   return net::ERR_IO_PENDING;
 }
@@ -13,6 +13,7 @@
 #include "base/compiler_specific.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
 #include "net/base/io_buffer.h"
 #include "net/base/load_flags.h"
 #include "net/base/net_errors.h"
@@ -207,6 +208,9 @@ class MockNetworkTransaction
 
   net::RequestPriority priority() const { return priority_; }
 
+  // How much of the response body has been read.
+  int data_cursor() const { return data_cursor_; }
+
  private:
   void CallbackLater(const net::CompletionCallback& callback, int result);
   void RunCallback(const net::CompletionCallback& callback, int result);
@@ -256,6 +260,11 @@ class MockNetworkLayer : public net::HttpTransactionFactory,
     last_transaction_.reset();
   }
 
+  // Makes asynchronous reads of the transactions take |delay|, as if the
+  // data was arriving over the network.
+  base::TimeDelta read_delay() const { return read_delay_; }
+  void set_read_delay(base::TimeDelta delay) { read_delay_ = delay; }
+
   // net::HttpTransactionFactory:
   virtual int CreateTransaction(
       net::RequestPriority priority,
@@ -269,6 +278,7 @@ class MockNetworkLayer : public net::HttpTransactionFactory,
   bool done_reading_called_;
   net::RequestPriority last_create_transaction_priority_;
   base::WeakPtr<MockNetworkTransaction> last_transaction_;
+  base::TimeDelta read_delay_;
 };
 
 //-----------------------------------------------------------------------------
@@ -7,6 +7,8 @@
 
 #include "net/http/http_util.h"
 
+#include <string.h>
+
 #include <algorithm>
 
 #include "base/basictypes.h"
@@ -521,18 +523,18 @@ int HttpUtil::LocateStartOfStatusLine(const char* buf, int buf_len) {
 }
 
 int HttpUtil::LocateEndOfHeaders(const char* buf, int buf_len, int i) {
-  bool was_lf = false;
-  char last_c = '\0';
-  for (; i < buf_len; ++i) {
-    char c = buf[i];
-    if (c == '\n') {
-      if (was_lf)
-        return i + 1;
-      was_lf = true;
-    } else if (c != '\r' || last_c != '\n') {
-      was_lf = false;
-    }
-    last_c = c;
+  // Skip from one LF to the next with memchr(), which is much faster than
+  // looking at every character of long header lines, and check what follows.
+  while (i < buf_len) {
+    const char* lf = static_cast<const char*>(memchr(buf + i, '\n',
+                                                     buf_len - i));
+    if (!lf)
+      return -1;
+    i = lf - buf + 1;
+    if (i < buf_len && buf[i] == '\n')
+      return i + 1;
+    if (i + 1 < buf_len && buf[i] == '\r' && buf[i + 1] == '\n')
+      return i + 2;
   }
   return -1;
 }
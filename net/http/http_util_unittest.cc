@@ -271,6 +271,10 @@ TEST(HttpUtilTest, LocateEndOfHeaders) {
     { "foo\nbar\n\njunk", 9 },
     { "foo\nbar\n\r\njunk", 10 },
     { "foo\nbar\r\n\njunk", 10 },
+    { "\n\n", 2 },
+    { "foo\r\nbar\r\n\r", -1 },
+    { "foo\nbar\n", -1 },
+    { "foo\n\r\r\nbar\n\njunk", 12 },
   };
   for (size_t i = 0; i < ARRAYSIZE_UNSAFE(tests); ++i) {
     int input_len = static_cast<int>(strlen(tests[i].input));
@@ -544,67 +544,190 @@ struct HSTSPreload {
   SecondLevelDomainName second_level_domain_name;
 };
 
-static bool HasPreload(const struct HSTSPreload* entries, size_t num_entries,
-                       const std::string& canonicalized_host, size_t i,
-                       TransportSecurityState::DomainState* out, bool* ret) {
-  for (size_t j = 0; j < num_entries; j++) {
-    if (entries[j].length == canonicalized_host.size() - i &&
-        memcmp(entries[j].dns_name, &canonicalized_host[i],
-               entries[j].length) == 0) {
-      if (!entries[j].include_subdomains && i != 0) {
-        *ret = false;
-      } else {
-        out->sts_include_subdomains = entries[j].include_subdomains;
-        out->pkp_include_subdomains = entries[j].include_subdomains;
-        *ret = true;
-        if (!entries[j].https_required)
-          out->upgrade_mode = TransportSecurityState::DomainState::MODE_DEFAULT;
-        if (entries[j].pins.required_hashes) {
-          const char* const* sha1_hash = entries[j].pins.required_hashes;
-          while (*sha1_hash) {
-            AddHash(*sha1_hash, &out->static_spki_hashes);
-            sha1_hash++;
-          }
-        }
-        if (entries[j].pins.excluded_hashes) {
-          const char* const* sha1_hash = entries[j].pins.excluded_hashes;
-          while (*sha1_hash) {
-            AddHash(*sha1_hash, &out->bad_static_spki_hashes);
-            sha1_hash++;
-          }
-        }
-      }
-      return true;
+// Applies |entry| to |out|, returning false if it does not apply because
+// |is_subdomain| is true and the entry does not include subdomains.
+static bool ApplyPreload(const struct HSTSPreload& entry, bool is_subdomain,
+                         TransportSecurityState::DomainState* out) {
+  if (!entry.include_subdomains && is_subdomain)
+    return false;
+
+  out->sts_include_subdomains = entry.include_subdomains;
+  out->pkp_include_subdomains = entry.include_subdomains;
+  if (!entry.https_required)
+    out->upgrade_mode = TransportSecurityState::DomainState::MODE_DEFAULT;
+  if (entry.pins.required_hashes) {
+    const char* const* sha1_hash = entry.pins.required_hashes;
+    while (*sha1_hash) {
+      AddHash(*sha1_hash, &out->static_spki_hashes);
+      sha1_hash++;
     }
   }
-  return false;
+  if (entry.pins.excluded_hashes) {
+    const char* const* sha1_hash = entry.pins.excluded_hashes;
+    while (*sha1_hash) {
+      AddHash(*sha1_hash, &out->bad_static_spki_hashes);
+      sha1_hash++;
+    }
+  }
+  return true;
 }
 
 #include "net/http/transport_security_state_static.h"
+#include "net/http/transport_security_state_static_trie.h"
 
-// Returns the HSTSPreload entry for the |canonicalized_host| in |entries|,
-// or NULL if there is none. Prefers exact hostname matches to those that
-// match only because HSTSPreload.include_subdomains is true.
+// The flags of a node in kPreloadTrie.
+enum {
+  PRELOAD_TRIE_HAS_STS = 1 << 0,
+  PRELOAD_TRIE_HAS_SNISTS = 1 << 1,
+};
+
+// A suffix of a host which has preloaded entries, given as indices into
+// kPreloadedSTS and kPreloadedSNISTS, or -1 if there is none in that table.
+struct PreloadMatch {
+  size_t offset;  // Of the suffix in the canonicalized host.
+  int sts_index;
+  int sni_sts_index;
+};
+
+// The position of a lookup in kPreloadTrie: either at the node at |node|, if
+// |label_left| is zero, or with |label_left| characters at |label| left before
+// reaching the node at |node|.
+struct PreloadTrieCursor {
+  size_t node;
+  size_t label;
+  size_t label_left;
+};
+
+static size_t ReadPreloadTrieUint16(size_t offset) {
+  return (kPreloadTrie[offset] << 8) | kPreloadTrie[offset + 1];
+}
+
+// Moves |cursor| along the character |c|, returning false if the trie has no
+// name with that character there.
+static bool AdvancePreloadTrieCursor(char c, PreloadTrieCursor* cursor) {
+  if (!cursor->label_left) {
+    size_t offset = cursor->node;
+    const uint8 flags = kPreloadTrie[offset++];
+    if (flags & PRELOAD_TRIE_HAS_STS)
+      offset += 2;
+    if (flags & PRELOAD_TRIE_HAS_SNISTS)
+      offset += 2;
+    const uint8 num_children = kPreloadTrie[offset++];
+    size_t i = 0;
+    for (; i < num_children; ++i) {
+      const uint8 length = kPreloadTrie[offset];
+      if (kPreloadTrie[offset + 1] == static_cast<uint8>(c))
+        break;
+      offset += 1 + length + 2;
+    }
+    if (i == num_children)
+      return false;
+    cursor->label = offset + 1;
+    cursor->label_left = kPreloadTrie[offset];
+    cursor->node = ReadPreloadTrieUint16(offset + 1 + cursor->label_left);
+  }
+
+  if (kPreloadTrie[cursor->label] != static_cast<uint8>(c))
+    return false;
+  cursor->label++;
+  cursor->label_left--;
+  return true;
+}
+
+// Looks up the suffixes of |canonicalized_host| in kPreloadTrie, which takes
+// time proportional to its length. Fills |matches| from the shortest suffix
+// and returns their number.
 //
 // |canonicalized_host| should be the hostname as canonicalized by
 // CanonicalizeHost.
-static const struct HSTSPreload* GetHSTSPreload(
-    const std::string& canonicalized_host,
-    const struct HSTSPreload* entries,
-    size_t num_entries) {
+static size_t FindPreloads(const std::string& canonicalized_host,
+                           PreloadMatch matches[kPreloadTrieMaxDepth]) {
+  // The trie has the labels in reverse order, so find where they start.
+  // CanonicalizeHost limits hosts to 255 bytes, and so to 127 labels.
+  size_t label_offsets[128];
+  size_t num_labels = 0;
   for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    for (size_t j = 0; j < num_entries; j++) {
-      const struct HSTSPreload* entry = entries + j;
+    if (num_labels == arraysize(label_offsets))
+      return 0;
+    label_offsets[num_labels++] = i;
+  }
 
-      if (i != 0 && !entry->include_subdomains)
-        continue;
+  PreloadTrieCursor cursor = { 0, 0, 0 };
+  size_t num_matches = 0;
+  for (size_t i = num_labels; i-- > 0; ) {
+    const size_t offset = label_offsets[i];
+    if (i != num_labels - 1 && !AdvancePreloadTrieCursor('.', &cursor))
+      break;
+    const size_t label_length = static_cast<uint8>(canonicalized_host[offset]);
+    size_t j = 1;
+    for (; j <= label_length; ++j) {
+      if (!AdvancePreloadTrieCursor(canonicalized_host[offset + j], &cursor))
+        break;
+    }
+    if (j <= label_length)
+      break;
+    if (cursor.label_left)
+      continue;
 
-      if (entry->length == canonicalized_host.size() - i &&
-          memcmp(entry->dns_name, &canonicalized_host[i], entry->length) == 0) {
-        return entry;
-      }
+    size_t node = cursor.node;
+    const uint8 flags = kPreloadTrie[node++];
+    if (!flags)
+      continue;
+    DCHECK_LT(num_matches, kPreloadTrieMaxDepth);
+    PreloadMatch* match = &matches[num_matches++];
+    match->offset = offset;
+    match->sts_index = -1;
+    match->sni_sts_index = -1;
+    if (flags & PRELOAD_TRIE_HAS_STS) {
+      match->sts_index = ReadPreloadTrieUint16(node);
+      DCHECK_LT(static_cast<size_t>(match->sts_index), kNumPreloadedSTS);
+      node += 2;
+    }
+    if (flags & PRELOAD_TRIE_HAS_SNISTS) {
+      match->sni_sts_index = ReadPreloadTrieUint16(node);
+      DCHECK_LT(static_cast<size_t>(match->sni_sts_index),
+                kNumPreloadedSNISTS);
     }
   }
+  return num_matches;
+}
+
+// Returns true if |entry| is for the suffix of |canonicalized_host| which
+// starts at |offset|. The trie only says which entry to look at, so this
+// keeps a trie which is out of step with the tables from applying the wrong
+// entry.
+static bool PreloadMatchesSuffix(const struct HSTSPreload& entry,
+                                 const std::string& canonicalized_host,
+                                 size_t offset) {
+  return entry.length == canonicalized_host.size() - offset &&
+         memcmp(entry.dns_name, &canonicalized_host[offset],
+                entry.length) == 0;
+}
+
+// Returns the HSTSPreload entry for the |canonicalized_host| in
+// kPreloadedSNISTS if |sni_entries| is true and in kPreloadedSTS otherwise,
+// or NULL if there is none. Prefers exact hostname matches to those that
+// match only because HSTSPreload.include_subdomains is true.
+//
+// |canonicalized_host| should be the hostname as canonicalized by
+// CanonicalizeHost.
+static const struct HSTSPreload* GetHSTSPreload(
+    const std::string& canonicalized_host,
+    bool sni_entries) {
+  PreloadMatch matches[kPreloadTrieMaxDepth];
+  for (size_t i = FindPreloads(canonicalized_host, matches); i-- > 0; ) {
+    const int index =
+        sni_entries ? matches[i].sni_sts_index : matches[i].sts_index;
+    if (index < 0)
+      continue;
+    const struct HSTSPreload* entry =
+        sni_entries ? &kPreloadedSNISTS[index] : &kPreloadedSTS[index];
+    if (!PreloadMatchesSuffix(*entry, canonicalized_host, matches[i].offset))
+      continue;
+    if (matches[i].offset != 0 && !entry->include_subdomains)
+      continue;
+    return entry;
+  }
 
   return NULL;
 }
@@ -701,15 +824,13 @@ bool TransportSecurityState::AddHPKP(const std::string& host,
 bool TransportSecurityState::IsGooglePinnedProperty(const std::string& host,
                                                     bool sni_enabled) {
   std::string canonicalized_host = CanonicalizeHost(host);
-  const struct HSTSPreload* entry =
-      GetHSTSPreload(canonicalized_host, kPreloadedSTS, kNumPreloadedSTS);
+  const struct HSTSPreload* entry = GetHSTSPreload(canonicalized_host, false);
 
   if (entry && entry->pins.required_hashes == kGoogleAcceptableCerts)
     return true;
 
   if (sni_enabled) {
-    entry = GetHSTSPreload(canonicalized_host, kPreloadedSNISTS,
-                           kNumPreloadedSNISTS);
+    entry = GetHSTSPreload(canonicalized_host, true);
     if (entry && entry->pins.required_hashes == kGoogleAcceptableCerts)
       return true;
   }
@@ -721,13 +842,10 @@ bool TransportSecurityState::IsGooglePinnedProperty(const std::string& host,
 void TransportSecurityState::ReportUMAOnPinFailure(const std::string& host) {
   std::string canonicalized_host = CanonicalizeHost(host);
 
-  const struct HSTSPreload* entry =
-      GetHSTSPreload(canonicalized_host, kPreloadedSTS, kNumPreloadedSTS);
+  const struct HSTSPreload* entry = GetHSTSPreload(canonicalized_host, false);
 
-  if (!entry) {
-    entry = GetHSTSPreload(canonicalized_host, kPreloadedSNISTS,
-                           kNumPreloadedSNISTS);
-  }
+  if (!entry)
+    entry = GetHSTSPreload(canonicalized_host, true);
 
   if (!entry) {
     // We don't care to report pin failures for dynamic pins.
@@ -759,24 +877,26 @@ bool TransportSecurityState::GetStaticDomainState(
   out->sts_include_subdomains = false;
   out->pkp_include_subdomains = false;
 
-  const bool is_build_timely = IsBuildTimely();
+  if (!IsBuildTimely())
+    return false;
 
-  for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    std::string host_sub_chunk(&canonicalized_host[i],
-                               canonicalized_host.size() - i);
-    out->domain = DNSDomainToString(host_sub_chunk);
-    bool ret;
-    if (is_build_timely &&
-        HasPreload(kPreloadedSTS, kNumPreloadedSTS, canonicalized_host, i, out,
-                   &ret)) {
-      return ret;
-    }
-    if (sni_enabled &&
-        is_build_timely &&
-        HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host, i,
-                   out, &ret)) {
-      return ret;
+  // The longest suffix with an entry determines the result, with the entries
+  // in kPreloadedSTS taking precedence.
+  PreloadMatch matches[kPreloadTrieMaxDepth];
+  for (size_t i = FindPreloads(canonicalized_host, matches); i-- > 0; ) {
+    const struct HSTSPreload* entry = NULL;
+    if (matches[i].sts_index >= 0)
+      entry = &kPreloadedSTS[matches[i].sts_index];
+    else if (sni_enabled && matches[i].sni_sts_index >= 0)
+      entry = &kPreloadedSNISTS[matches[i].sni_sts_index];
+    if (!entry ||
+        !PreloadMatchesSuffix(*entry, canonicalized_host, matches[i].offset)) {
+      continue;
     }
+
+    out->domain = DNSDomainToString(
+        canonicalized_host.substr(matches[i].offset));
+    return ApplyPreload(*entry, matches[i].offset != 0, out);
   }
 
   return false;
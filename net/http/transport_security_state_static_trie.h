@@ -0,0 +1,673 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is generated by net/tools/transport_security_state_generator/.
+// DO NOT MANUALLY EDIT!
+
+#ifndef NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_
+#define NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_
+
+// The names of the entries in kPreloadedSTS and kPreloadedSNISTS, as a trie.
+// See net/tools/transport_security_state_generator/preload_trie_util.h
+// for its format.
+
+static const size_t kPreloadTrieMaxDepth = 4;
+
+static const uint8 kPreloadTrie[] = {
+  0x00, 0x18, 0x01, 0x61, 0x00, 0x76, 0x01, 0x62, 0x01, 0xb5, 0x01, 0x63,
+  0x03, 0x12, 0x01, 0x64, 0x0d, 0xea, 0x01, 0x65, 0x0e, 0xe9, 0x01, 0x66,
+  0x0f, 0x58, 0x01, 0x67, 0x0f, 0xac, 0x01, 0x68, 0x10, 0x92, 0x01, 0x69,
+  0x11, 0x0a, 0x01, 0x6a, 0x12, 0x6a, 0x01, 0x6b, 0x13, 0x11, 0x01, 0x6c,
+  0x13, 0x8a, 0x01, 0x6d, 0x14, 0x1e, 0x01, 0x6e, 0x15, 0x62, 0x01, 0x6f,
+  0x17, 0x8d, 0x01, 0x70, 0x19, 0xa5, 0x0d, 0x71, 0x61, 0x2e, 0x63, 0x6f,
+  0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x93, 0x01, 0x72,
+  0x1a, 0x97, 0x01, 0x73, 0x1a, 0xeb, 0x01, 0x74, 0x1c, 0x06, 0x01, 0x75,
+  0x1d, 0x02, 0x01, 0x76, 0x1d, 0xbb, 0x09, 0x77, 0x73, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1e, 0x5a, 0x01, 0x7a, 0x1e, 0x5e, 0x00, 0x0d,
+  0x08, 0x63, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x00, 0xf1, 0x08,
+  0x64, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x00, 0xf5, 0x08, 0x65,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x00, 0xf9, 0x02, 0x66, 0x2e,
+  0x00, 0xfd, 0x02, 0x67, 0x2e, 0x01, 0x1d, 0x02, 0x69, 0x2e, 0x01, 0x3d,
+  0x08, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x61, 0x02,
+  0x6f, 0x2e, 0x01, 0x65, 0x0c, 0x72, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x87, 0x08, 0x73, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x01, 0x8b, 0x08, 0x74, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x01, 0x8f, 0x06, 0x75, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x01, 0x93, 0x08, 0x7a, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01,
+  0xb1, 0x01, 0x00, 0x32, 0x00, 0x01, 0x00, 0x33, 0x00, 0x01, 0x00, 0x34,
+  0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x01, 0x15, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01,
+  0x19, 0x01, 0x00, 0x69, 0x00, 0x01, 0x00, 0x35, 0x00, 0x00, 0x02, 0x0a,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x35,
+  0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x39, 0x01, 0x00, 0x6a,
+  0x00, 0x01, 0x00, 0x36, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x59, 0x0a, 0x6f, 0x66, 0x66,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x5d, 0x01, 0x00, 0x6b,
+  0x00, 0x01, 0x00, 0xea, 0x00, 0x01, 0x00, 0x37, 0x00, 0x00, 0x02, 0x09,
+  0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x7f, 0x09,
+  0x69, 0x74, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x01, 0x83, 0x01,
+  0x00, 0x4e, 0x00, 0x01, 0x00, 0xcb, 0x00, 0x01, 0x00, 0x6c, 0x00, 0x01,
+  0x00, 0x38, 0x00, 0x01, 0x00, 0x39, 0x00, 0x00, 0x02, 0x08, 0x66, 0x61,
+  0x74, 0x7a, 0x65, 0x62, 0x72, 0x61, 0x01, 0xa9, 0x06, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x01, 0xad, 0x01, 0x01, 0x74, 0x00, 0x01, 0x00, 0x6d,
+  0x00, 0x01, 0x00, 0x3a, 0x00, 0x00, 0x0f, 0x08, 0x61, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x02, 0x5e, 0x0c, 0x64, 0x2e, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0x62, 0x02, 0x65, 0x2e,
+  0x02, 0x66, 0x08, 0x66, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02,
+  0x81, 0x08, 0x67, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0x85,
+  0x0c, 0x68, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x02, 0x89, 0x01, 0x69, 0x02, 0x8d, 0x08, 0x6a, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x02, 0xbf, 0x0c, 0x6e, 0x2e, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0xc3, 0x0c, 0x6f, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0xc7,
+  0x06, 0x72, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x02, 0xcb, 0x08, 0x73, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0xe6, 0x0b, 0x77, 0x2e, 0x63,
+  0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02, 0xea, 0x02, 0x79,
+  0x2e, 0x02, 0xee, 0x0c, 0x7a, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x03, 0x0e, 0x01, 0x00, 0x3b, 0x00, 0x01, 0x00,
+  0x6e, 0x00, 0x00, 0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x02,
+  0x79, 0x05, 0x79, 0x6f, 0x75, 0x74, 0x75, 0x02, 0x7d, 0x01, 0x00, 0x3c,
+  0x00, 0x01, 0x00, 0x2c, 0x00, 0x01, 0x00, 0x3d, 0x00, 0x01, 0x00, 0x3e,
+  0x00, 0x01, 0x00, 0x6f, 0x00, 0x00, 0x02, 0x07, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x02, 0x9e, 0x02, 0x7a, 0x2e, 0x02, 0xa2, 0x01, 0x00,
+  0x3f, 0x00, 0x00, 0x02, 0x0a, 0x65, 0x6c, 0x61, 0x6e, 0x65, 0x78, 0x2e,
+  0x77, 0x77, 0x77, 0x02, 0xb7, 0x03, 0x77, 0x69, 0x7a, 0x02, 0xbb, 0x01,
+  0x01, 0x0e, 0x00, 0x01, 0x01, 0x87, 0x00, 0x01, 0x00, 0x40, 0x00, 0x01,
+  0x00, 0x70, 0x00, 0x01, 0x00, 0x71, 0x00, 0x00, 0x02, 0x05, 0x61, 0x72,
+  0x69, 0x76, 0x6f, 0x02, 0xde, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x02, 0xe2, 0x01, 0x01, 0x5f, 0x00, 0x01, 0x00, 0x72, 0x00, 0x01, 0x00,
+  0x41, 0x00, 0x01, 0x00, 0x4f, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x03, 0x06, 0x06, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x03, 0x0a, 0x01, 0x00, 0x73, 0x00, 0x01, 0x00,
+  0x42, 0x00, 0x01, 0x00, 0x74, 0x00, 0x00, 0x11, 0x01, 0x61, 0x03, 0xbd,
+  0x02, 0x63, 0x2e, 0x03, 0xee, 0x08, 0x64, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x04, 0x0a, 0x08, 0x66, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x04, 0x0e, 0x08, 0x67, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x04, 0x12, 0x02, 0x68, 0x2e, 0x04, 0x16, 0x08, 0x69, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x04, 0x5e, 0x0b, 0x6b, 0x2e, 0x63, 0x6f, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x04, 0x62, 0x08, 0x6c, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x04, 0x66, 0x08, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x04, 0x6a, 0x02, 0x6e, 0x2e, 0x04, 0x6e, 0x01,
+  0x6f, 0x04, 0x8e, 0x0b, 0x72, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x0d, 0xd6, 0x0c, 0x75, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0d, 0xda, 0x08, 0x76, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0d, 0xde, 0x0c, 0x79, 0x2e, 0x63, 0x6f,
+  0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0d, 0xe2, 0x08, 0x7a,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0d, 0xe6, 0x00, 0x02, 0x07,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x03, 0xce, 0x02, 0x74, 0x2e,
+  0x03, 0xd2, 0x01, 0x00, 0x43, 0x00, 0x00, 0x02, 0x06, 0x63, 0x72, 0x79,
+  0x70, 0x74, 0x6f, 0x03, 0xe6, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x03, 0xea, 0x01, 0x01, 0x4c, 0x00, 0x01, 0x00, 0x44, 0x00, 0x00, 0x02,
+  0x06, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x04, 0x02, 0x06, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x04, 0x06, 0x01, 0x01, 0x14, 0x00, 0x01, 0x00,
+  0x45, 0x00, 0x01, 0x00, 0x46, 0x00, 0x01, 0x00, 0x47, 0x00, 0x01, 0x00,
+  0x48, 0x00, 0x00, 0x03, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x04,
+  0x33, 0x05, 0x68, 0x61, 0x73, 0x74, 0x65, 0x04, 0x37, 0x07, 0x6f, 0x6e,
+  0x6c, 0x69, 0x6d, 0x65, 0x2e, 0x04, 0x3b, 0x01, 0x00, 0x49, 0x00, 0x01,
+  0x01, 0xc3, 0x00, 0x00, 0x03, 0x03, 0x63, 0x72, 0x6d, 0x04, 0x52, 0x02,
+  0x6d, 0x79, 0x04, 0x56, 0x07, 0x77, 0x65, 0x62, 0x6d, 0x61, 0x69, 0x6c,
+  0x04, 0x5a, 0x01, 0x01, 0x8a, 0x00, 0x01, 0x01, 0x88, 0x00, 0x01, 0x01,
+  0x89, 0x00, 0x01, 0x00, 0x4a, 0x00, 0x01, 0x00, 0x50, 0x00, 0x01, 0x00,
+  0x4b, 0x00, 0x01, 0x00, 0x4c, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x04, 0x86, 0x06, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x04, 0x8a, 0x01, 0x00, 0x75, 0x00, 0x01, 0x00,
+  0x4d, 0x00, 0x00, 0x02, 0x01, 0x2e, 0x04, 0x99, 0x02, 0x6d, 0x2e, 0x04,
+  0xc3, 0x00, 0x03, 0x08, 0x62, 0x6c, 0x75, 0x65, 0x73, 0x65, 0x65, 0x64,
+  0x04, 0xb7, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x04, 0xbb, 0x01, 0x67, 0x04, 0xbf, 0x01, 0x01, 0xbd, 0x00, 0x01,
+  0x00, 0x76, 0x00, 0x01, 0x00, 0x31, 0x00, 0x00, 0x13, 0x01, 0x61, 0x05,
+  0x36, 0x01, 0x62, 0x06, 0x04, 0x01, 0x63, 0x06, 0x45, 0x07, 0x64, 0x72,
+  0x6f, 0x70, 0x63, 0x61, 0x6d, 0x06, 0xac, 0x01, 0x65, 0x06, 0xbb, 0x01,
+  0x67, 0x06, 0xed, 0x01, 0x69, 0x09, 0x98, 0x06, 0x6a, 0x6f, 0x74, 0x74,
+  0x69, 0x74, 0x09, 0xfc, 0x01, 0x6b, 0x0a, 0x00, 0x01, 0x6c, 0x0a, 0x1d,
+  0x01, 0x6d, 0x0b, 0x08, 0x02, 0x6e, 0x65, 0x0b, 0xa0, 0x02, 0x70, 0x61,
+  0x0b, 0xe4, 0x14, 0x71, 0x75, 0x61, 0x6e, 0x74, 0x69, 0x66, 0x69, 0x65,
+  0x64, 0x73, 0x65, 0x6c, 0x66, 0x2e, 0x66, 0x6f, 0x72, 0x75, 0x6d, 0x0c,
+  0x35, 0x01, 0x72, 0x0c, 0x39, 0x01, 0x73, 0x0c, 0x7e, 0x01, 0x74, 0x0d,
+  0x1f, 0x06, 0x75, 0x72, 0x63, 0x68, 0x69, 0x6e, 0x0d, 0xb8, 0x01, 0x79,
+  0x0d, 0xbc, 0x00, 0x03, 0x0a, 0x6c, 0x66, 0x72, 0x65, 0x73, 0x63, 0x6f,
+  0x2e, 0x6d, 0x79, 0x05, 0x52, 0x06, 0x6e, 0x64, 0x72, 0x6f, 0x69, 0x64,
+  0x05, 0x56, 0x01, 0x70, 0x05, 0x68, 0x01, 0x01, 0x8f, 0x00, 0x01, 0x00,
+  0x2d, 0x01, 0x07, 0x2e, 0x6d, 0x61, 0x72, 0x6b, 0x65, 0x74, 0x05, 0x64,
+  0x01, 0x00, 0x15, 0x00, 0x00, 0x02, 0x0d, 0x6f, 0x6c, 0x6c, 0x6f, 0x2d,
+  0x61, 0x75, 0x74, 0x6f, 0x2e, 0x77, 0x77, 0x77, 0x05, 0x82, 0x05, 0x70,
+  0x73, 0x70, 0x6f, 0x74, 0x05, 0x86, 0x01, 0x01, 0x60, 0x00, 0x01, 0x00,
+  0x28, 0x01, 0x01, 0x2e, 0x05, 0x8e, 0x00, 0x03, 0x0e, 0x61, 0x6c, 0x61,
+  0x64, 0x64, 0x69, 0x6e, 0x73, 0x63, 0x68, 0x6f, 0x6f, 0x6c, 0x73, 0x05,
+  0xb3, 0x01, 0x63, 0x05, 0xb7, 0x0b, 0x70, 0x69, 0x6e, 0x6e, 0x69, 0x6e,
+  0x67, 0x74, 0x65, 0x73, 0x74, 0x06, 0x00, 0x01, 0x01, 0x1b, 0x00, 0x00,
+  0x02, 0x04, 0x68, 0x72, 0x6f, 0x6d, 0x05, 0xcc, 0x09, 0x6f, 0x64, 0x65,
+  0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x05, 0xfc, 0x00, 0x02, 0x13, 0x65,
+  0x2d, 0x64, 0x65, 0x76, 0x74, 0x6f, 0x6f, 0x6c, 0x73, 0x2d, 0x66, 0x72,
+  0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x64, 0x05, 0xf4, 0x0d, 0x69, 0x75, 0x6d,
+  0x63, 0x6f, 0x64, 0x65, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x05, 0xf8,
+  0x01, 0x00, 0x1c, 0x00, 0x01, 0x00, 0x1b, 0x00, 0x01, 0x00, 0x1d, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x63, 0x63, 0x78, 0x06, 0x17,
+  0x08, 0x72, 0x61, 0x69, 0x6e, 0x74, 0x72, 0x65, 0x65, 0x06, 0x1b, 0x01,
+  0x01, 0xb7, 0x00, 0x00, 0x02, 0x07, 0x67, 0x61, 0x74, 0x65, 0x77, 0x61,
+  0x79, 0x06, 0x32, 0x08, 0x70, 0x61, 0x79, 0x6d, 0x65, 0x6e, 0x74, 0x73,
+  0x06, 0x36, 0x01, 0x01, 0x59, 0x00, 0x01, 0x01, 0x5a, 0x01, 0x04, 0x2e,
+  0x77, 0x77, 0x77, 0x06, 0x41, 0x01, 0x01, 0x5b, 0x00, 0x00, 0x04, 0x07,
+  0x61, 0x72, 0x65, 0x7a, 0x6f, 0x6e, 0x65, 0x06, 0x6b, 0x08, 0x6f, 0x6e,
+  0x66, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x06, 0x6f, 0x08, 0x75, 0x65, 0x75,
+  0x70, 0x2e, 0x77, 0x77, 0x77, 0x06, 0x73, 0x01, 0x79, 0x06, 0x77, 0x01,
+  0x01, 0xb3, 0x00, 0x01, 0x01, 0xb4, 0x00, 0x01, 0x01, 0x61, 0x00, 0x00,
+  0x02, 0x08, 0x70, 0x68, 0x65, 0x72, 0x74, 0x69, 0x74, 0x65, 0x06, 0x91,
+  0x0a, 0x76, 0x65, 0x69, 0x6c, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2e, 0x06,
+  0x95, 0x01, 0x01, 0xb5, 0x00, 0x00, 0x02, 0x04, 0x62, 0x6c, 0x6f, 0x67,
+  0x06, 0xa4, 0x03, 0x77, 0x77, 0x77, 0x06, 0xa8, 0x01, 0x01, 0xbb, 0x00,
+  0x01, 0x01, 0xba, 0x00, 0x01, 0x01, 0x32, 0x01, 0x04, 0x2e, 0x77, 0x77,
+  0x77, 0x06, 0xb7, 0x01, 0x01, 0x33, 0x00, 0x00, 0x03, 0x11, 0x6d, 0x61,
+  0x69, 0x6c, 0x70, 0x72, 0x69, 0x76, 0x61, 0x63, 0x79, 0x74, 0x65, 0x73,
+  0x74, 0x65, 0x72, 0x06, 0xe1, 0x06, 0x70, 0x6f, 0x78, 0x61, 0x74, 0x65,
+  0x06, 0xe5, 0x04, 0x73, 0x70, 0x72, 0x61, 0x06, 0xe9, 0x01, 0x01, 0x5c,
+  0x00, 0x01, 0x01, 0x35, 0x00, 0x01, 0x01, 0x94, 0x00, 0x00, 0x04, 0x04,
+  0x6d, 0x61, 0x69, 0x6c, 0x07, 0x0b, 0x01, 0x6f, 0x07, 0x1a, 0x01, 0x72,
+  0x09, 0x58, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x2e, 0x73, 0x73,
+  0x6c, 0x09, 0x94, 0x02, 0x00, 0x00, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77,
+  0x07, 0x16, 0x02, 0x00, 0x02, 0x00, 0x00, 0x02, 0x08, 0x63, 0x61, 0x72,
+  0x64, 0x6c, 0x65, 0x73, 0x73, 0x07, 0x2e, 0x04, 0x6f, 0x67, 0x6c, 0x65,
+  0x07, 0x32, 0x01, 0x01, 0x93, 0x00, 0x01, 0x00, 0x01, 0x09, 0x0a, 0x2d,
+  0x61, 0x6e, 0x61, 0x6c, 0x79, 0x74, 0x69, 0x63, 0x73, 0x07, 0x83, 0x01,
+  0x2e, 0x07, 0x92, 0x01, 0x61, 0x09, 0x05, 0x02, 0x63, 0x6f, 0x09, 0x21,
+  0x06, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x73, 0x09, 0x39, 0x04, 0x6d, 0x61,
+  0x69, 0x6c, 0x09, 0x3d, 0x04, 0x70, 0x6c, 0x65, 0x78, 0x09, 0x4c, 0x0b,
+  0x73, 0x79, 0x6e, 0x64, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x09,
+  0x50, 0x0b, 0x75, 0x73, 0x65, 0x72, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e,
+  0x74, 0x09, 0x54, 0x02, 0x00, 0x04, 0x01, 0x04, 0x2e, 0x73, 0x73, 0x6c,
+  0x07, 0x8e, 0x01, 0x00, 0x16, 0x00, 0x00, 0x0a, 0x01, 0x61, 0x07, 0xcf,
+  0x01, 0x63, 0x08, 0x09, 0x01, 0x64, 0x08, 0x33, 0x09, 0x65, 0x6e, 0x63,
+  0x72, 0x79, 0x70, 0x74, 0x65, 0x64, 0x08, 0x52, 0x06, 0x67, 0x72, 0x6f,
+  0x75, 0x70, 0x73, 0x08, 0x56, 0x01, 0x68, 0x08, 0x5a, 0x04, 0x6d, 0x61,
+  0x69, 0x6c, 0x08, 0x8b, 0x01, 0x70, 0x08, 0x8f, 0x01, 0x73, 0x08, 0xa9,
+  0x04, 0x74, 0x61, 0x6c, 0x6b, 0x08, 0xf4, 0x00, 0x02, 0x07, 0x63, 0x63,
+  0x6f, 0x75, 0x6e, 0x74, 0x73, 0x07, 0xdf, 0x01, 0x70, 0x07, 0xe3, 0x01,
+  0x00, 0x0a, 0x00, 0x00, 0x02, 0x02, 0x69, 0x73, 0x07, 0xf4, 0x07, 0x70,
+  0x65, 0x6e, 0x67, 0x69, 0x6e, 0x65, 0x08, 0x05, 0x01, 0x00, 0x1a, 0x01,
+  0x06, 0x2e, 0x63, 0x68, 0x61, 0x72, 0x74, 0x08, 0x01, 0x01, 0x00, 0x22,
+  0x00, 0x01, 0x00, 0x08, 0x00, 0x00, 0x02, 0x01, 0x68, 0x08, 0x15, 0x03,
+  0x6f, 0x64, 0x65, 0x08, 0x2f, 0x00, 0x02, 0x06, 0x65, 0x63, 0x6b, 0x6f,
+  0x75, 0x74, 0x08, 0x27, 0x04, 0x72, 0x6f, 0x6d, 0x65, 0x08, 0x2b, 0x01,
+  0x00, 0x03, 0x00, 0x01, 0x00, 0x04, 0x00, 0x01, 0x00, 0x1f, 0x00, 0x00,
+  0x03, 0x01, 0x6c, 0x08, 0x46, 0x03, 0x6f, 0x63, 0x73, 0x08, 0x4a, 0x04,
+  0x72, 0x69, 0x76, 0x65, 0x08, 0x4e, 0x01, 0x00, 0x21, 0x00, 0x01, 0x00,
+  0x05, 0x00, 0x01, 0x00, 0x17, 0x00, 0x01, 0x00, 0x09, 0x00, 0x01, 0x00,
+  0x19, 0x00, 0x00, 0x03, 0x05, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x08, 0x7f,
+  0x06, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x79, 0x08, 0x83, 0x0f, 0x6f, 0x73,
+  0x74, 0x65, 0x64, 0x74, 0x61, 0x6c, 0x6b, 0x67, 0x61, 0x64, 0x67, 0x65,
+  0x74, 0x08, 0x87, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x13, 0x00, 0x01,
+  0x00, 0x0f, 0x00, 0x01, 0x00, 0x0c, 0x00, 0x00, 0x02, 0x03, 0x6c, 0x75,
+  0x73, 0x08, 0xa1, 0x07, 0x72, 0x6f, 0x66, 0x69, 0x6c, 0x65, 0x73, 0x08,
+  0xa5, 0x01, 0x00, 0x10, 0x00, 0x01, 0x00, 0x0b, 0x00, 0x00, 0x05, 0x0b,
+  0x61, 0x6e, 0x64, 0x62, 0x6f, 0x78, 0x2e, 0x70, 0x6c, 0x75, 0x73, 0x08,
+  0xe0, 0x05, 0x63, 0x72, 0x69, 0x70, 0x74, 0x08, 0xe4, 0x07, 0x65, 0x63,
+  0x75, 0x72, 0x69, 0x74, 0x79, 0x08, 0xe8, 0x04, 0x69, 0x74, 0x65, 0x73,
+  0x08, 0xec, 0x0b, 0x70, 0x72, 0x65, 0x61, 0x64, 0x73, 0x68, 0x65, 0x65,
+  0x74, 0x73, 0x08, 0xf0, 0x01, 0x00, 0x11, 0x00, 0x01, 0x00, 0x12, 0x00,
+  0x01, 0x00, 0x14, 0x00, 0x01, 0x00, 0x06, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x01, 0x00, 0x0e, 0x01, 0x06, 0x67, 0x61, 0x64, 0x67, 0x65, 0x74, 0x09,
+  0x01, 0x01, 0x00, 0x0d, 0x00, 0x00, 0x02, 0x09, 0x64, 0x73, 0x65, 0x72,
+  0x76, 0x69, 0x63, 0x65, 0x73, 0x09, 0x19, 0x03, 0x70, 0x69, 0x73, 0x09,
+  0x1d, 0x01, 0x00, 0x27, 0x00, 0x01, 0x00, 0x26, 0x00, 0x00, 0x02, 0x02,
+  0x64, 0x65, 0x09, 0x31, 0x06, 0x6d, 0x6d, 0x65, 0x72, 0x63, 0x65, 0x09,
+  0x35, 0x01, 0x00, 0x20, 0x00, 0x01, 0x00, 0x2e, 0x00, 0x02, 0x00, 0x05,
+  0x00, 0x02, 0x00, 0x01, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x09, 0x48,
+  0x02, 0x00, 0x03, 0x00, 0x01, 0x00, 0x18, 0x00, 0x01, 0x00, 0x29, 0x00,
+  0x01, 0x00, 0x24, 0x00, 0x00, 0x02, 0x01, 0x63, 0x09, 0x63, 0x02, 0x65,
+  0x70, 0x09, 0x72, 0x01, 0x01, 0xa7, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77,
+  0x09, 0x6e, 0x01, 0x01, 0xa8, 0x00, 0x00, 0x02, 0x03, 0x6c, 0x69, 0x6e,
+  0x09, 0x81, 0x04, 0x75, 0x6c, 0x61, 0x72, 0x09, 0x90, 0x01, 0x01, 0x40,
+  0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x09, 0x8c, 0x01, 0x01, 0x41, 0x00,
+  0x01, 0x01, 0x45, 0x00, 0x01, 0x00, 0x2b, 0x00, 0x00, 0x03, 0x01, 0x6e,
+  0x09, 0xb3, 0x07, 0x72, 0x63, 0x63, 0x6c, 0x6f, 0x75, 0x64, 0x09, 0xd8,
+  0x08, 0x74, 0x72, 0x69, 0x73, 0x6b, 0x6c, 0x74, 0x64, 0x09, 0xf8, 0x00,
+  0x02, 0x0d, 0x65, 0x72, 0x74, 0x69, 0x61, 0x6e, 0x65, 0x74, 0x77, 0x6f,
+  0x72, 0x6b, 0x73, 0x09, 0xd0, 0x08, 0x74, 0x75, 0x69, 0x74, 0x2e, 0x69,
+  0x6f, 0x70, 0x09, 0xd4, 0x01, 0x01, 0xb2, 0x00, 0x01, 0x01, 0x78, 0x00,
+  0x01, 0x01, 0x66, 0x01, 0x01, 0x2e, 0x09, 0xe0, 0x00, 0x02, 0x05, 0x61,
+  0x6c, 0x70, 0x68, 0x61, 0x09, 0xf0, 0x03, 0x77, 0x77, 0x77, 0x09, 0xf4,
+  0x01, 0x01, 0x68, 0x00, 0x01, 0x01, 0x67, 0x00, 0x01, 0x01, 0x82, 0x00,
+  0x01, 0x01, 0x0f, 0x00, 0x00, 0x02, 0x07, 0x65, 0x79, 0x65, 0x72, 0x72,
+  0x6f, 0x72, 0x0a, 0x15, 0x06, 0x69, 0x77, 0x69, 0x69, 0x72, 0x63, 0x0a,
+  0x19, 0x01, 0x01, 0x20, 0x00, 0x01, 0x01, 0x9d, 0x00, 0x00, 0x03, 0x01,
+  0x61, 0x0a, 0x2f, 0x05, 0x69, 0x6e, 0x6f, 0x64, 0x65, 0x0a, 0x57, 0x01,
+  0x6f, 0x0a, 0xbb, 0x00, 0x02, 0x06, 0x73, 0x74, 0x70, 0x61, 0x73, 0x73,
+  0x0a, 0x44, 0x07, 0x75, 0x6e, 0x63, 0x68, 0x6b, 0x65, 0x79, 0x0a, 0x53,
+  0x01, 0x01, 0x1e, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x0a, 0x4f, 0x01,
+  0x01, 0x1f, 0x00, 0x01, 0x01, 0xb8, 0x00, 0x01, 0x01, 0xa9, 0x01, 0x01,
+  0x2e, 0x0a, 0x5f, 0x00, 0x06, 0x04, 0x62, 0x6c, 0x6f, 0x67, 0x0a, 0x8e,
+  0x05, 0x66, 0x6f, 0x72, 0x75, 0x6d, 0x0a, 0x92, 0x07, 0x6c, 0x69, 0x62,
+  0x72, 0x61, 0x72, 0x79, 0x0a, 0x96, 0x07, 0x6d, 0x61, 0x6e, 0x61, 0x67,
+  0x65, 0x72, 0x0a, 0x9a, 0x01, 0x70, 0x0a, 0x9e, 0x03, 0x77, 0x77, 0x77,
+  0x0a, 0xb7, 0x01, 0x01, 0xac, 0x00, 0x01, 0x01, 0xae, 0x00, 0x01, 0x01,
+  0xad, 0x00, 0x01, 0x01, 0xab, 0x00, 0x01, 0x01, 0xaf, 0x01, 0x04, 0x61,
+  0x73, 0x74, 0x65, 0x0a, 0xa9, 0x01, 0x01, 0xb0, 0x01, 0x03, 0x62, 0x69,
+  0x6e, 0x0a, 0xb3, 0x01, 0x01, 0xb1, 0x00, 0x01, 0x01, 0xaa, 0x00, 0x00,
+  0x03, 0x05, 0x63, 0x6b, 0x69, 0x66, 0x79, 0x0a, 0xd8, 0x08, 0x67, 0x65,
+  0x6e, 0x74, 0x72, 0x69, 0x65, 0x73, 0x0a, 0xdc, 0x05, 0x6f, 0x6b, 0x6f,
+  0x75, 0x74, 0x0a, 0xeb, 0x01, 0x01, 0x98, 0x00, 0x01, 0x01, 0x24, 0x01,
+  0x04, 0x2e, 0x77, 0x77, 0x77, 0x0a, 0xe7, 0x01, 0x01, 0x25, 0x00, 0x01,
+  0x01, 0x7c, 0x01, 0x01, 0x2e, 0x0a, 0xf3, 0x00, 0x02, 0x02, 0x64, 0x6d,
+  0x0b, 0x00, 0x03, 0x77, 0x77, 0x77, 0x0b, 0x04, 0x01, 0x01, 0x80, 0x00,
+  0x01, 0x01, 0x7d, 0x00, 0x00, 0x02, 0x0f, 0x6f, 0x6e, 0x65, 0x79, 0x62,
+  0x6f, 0x6f, 0x6b, 0x65, 0x72, 0x73, 0x2e, 0x77, 0x77, 0x77, 0x0b, 0x20,
+  0x01, 0x79, 0x0b, 0x24, 0x01, 0x01, 0x3b, 0x00, 0x00, 0x02, 0x08, 0x64,
+  0x69, 0x67, 0x69, 0x70, 0x61, 0x73, 0x73, 0x0b, 0x3b, 0x07, 0x6c, 0x6f,
+  0x6f, 0x6b, 0x6f, 0x75, 0x74, 0x0b, 0x83, 0x01, 0x01, 0x46, 0x01, 0x01,
+  0x2e, 0x0b, 0x43, 0x00, 0x03, 0x09, 0x64, 0x65, 0x76, 0x65, 0x6c, 0x6f,
+  0x70, 0x65, 0x72, 0x0b, 0x61, 0x07, 0x73, 0x61, 0x6e, 0x64, 0x62, 0x6f,
+  0x78, 0x0b, 0x70, 0x03, 0x77, 0x77, 0x77, 0x0b, 0x7f, 0x01, 0x01, 0x48,
+  0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x0b, 0x6c, 0x01, 0x01, 0x49, 0x00,
+  0x01, 0x01, 0x4a, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x0b, 0x7b, 0x01,
+  0x01, 0x4b, 0x00, 0x01, 0x01, 0x47, 0x00, 0x01, 0x01, 0x7e, 0x01, 0x01,
+  0x2e, 0x0b, 0x8b, 0x00, 0x02, 0x02, 0x64, 0x6d, 0x0b, 0x98, 0x03, 0x77,
+  0x77, 0x77, 0x0b, 0x9c, 0x01, 0x01, 0x81, 0x00, 0x01, 0x01, 0x7f, 0x00,
+  0x00, 0x02, 0x13, 0x61, 0x72, 0x62, 0x75, 0x79, 0x73, 0x79, 0x73, 0x74,
+  0x65, 0x6d, 0x73, 0x2e, 0x6c, 0x75, 0x6e, 0x65, 0x74, 0x61, 0x0b, 0xc0,
+  0x05, 0x6f, 0x6e, 0x69, 0x73, 0x69, 0x0b, 0xc4, 0x01, 0x01, 0x42, 0x00,
+  0x01, 0x01, 0x6c, 0x01, 0x01, 0x2e, 0x0b, 0xcc, 0x00, 0x02, 0x05, 0x73,
+  0x68, 0x6f, 0x70, 0x73, 0x0b, 0xdc, 0x03, 0x77, 0x77, 0x77, 0x0b, 0xe0,
+  0x01, 0x01, 0x6e, 0x00, 0x01, 0x01, 0x6d, 0x00, 0x00, 0x02, 0x0b, 0x6e,
+  0x6f, 0x72, 0x61, 0x6d, 0x69, 0x6f, 0x2e, 0x73, 0x73, 0x6c, 0x0b, 0xf8,
+  0x01, 0x79, 0x0b, 0xfc, 0x01, 0x01, 0x9c, 0x00, 0x00, 0x03, 0x10, 0x63,
+  0x68, 0x65, 0x63, 0x6b, 0x72, 0x65, 0x63, 0x6f, 0x72, 0x64, 0x73, 0x2e,
+  0x77, 0x77, 0x77, 0x0c, 0x1e, 0x04, 0x6d, 0x69, 0x6c, 0x6c, 0x0c, 0x22,
+  0x03, 0x70, 0x61, 0x6c, 0x0c, 0x26, 0x01, 0x01, 0x1d, 0x00, 0x01, 0x01,
+  0x91, 0x00, 0x01, 0x01, 0x0d, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x0c,
+  0x31, 0x01, 0x01, 0x0c, 0x00, 0x01, 0x01, 0xbe, 0x00, 0x00, 0x02, 0x01,
+  0x65, 0x0c, 0x46, 0x04, 0x6f, 0x6d, 0x61, 0x62, 0x0c, 0x7a, 0x00, 0x02,
+  0x08, 0x63, 0x75, 0x72, 0x6c, 0x79, 0x2e, 0x61, 0x70, 0x0c, 0x64, 0x0e,
+  0x64, 0x68, 0x61, 0x74, 0x2e, 0x6f, 0x70, 0x65, 0x6e, 0x73, 0x68, 0x69,
+  0x66, 0x74, 0x0c, 0x76, 0x00, 0x02, 0x01, 0x69, 0x0c, 0x6e, 0x01, 0x70,
+  0x0c, 0x72, 0x01, 0x01, 0x3f, 0x00, 0x01, 0x01, 0x3e, 0x00, 0x01, 0x01,
+  0x84, 0x00, 0x01, 0x01, 0x23, 0x00, 0x00, 0x05, 0x0e, 0x65, 0x63, 0x75,
+  0x72, 0x69, 0x74, 0x79, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x73, 0x0c,
+  0xaf, 0x01, 0x69, 0x0c, 0xb3, 0x05, 0x71, 0x75, 0x61, 0x72, 0x65, 0x0c,
+  0xff, 0x05, 0x74, 0x72, 0x69, 0x70, 0x65, 0x0d, 0x0c, 0x07, 0x75, 0x72,
+  0x66, 0x65, 0x61, 0x73, 0x79, 0x0d, 0x10, 0x01, 0x01, 0xc2, 0x00, 0x00,
+  0x02, 0x0a, 0x6c, 0x65, 0x6e, 0x74, 0x63, 0x69, 0x72, 0x63, 0x6c, 0x65,
+  0x0c, 0xc9, 0x04, 0x6d, 0x70, 0x6c, 0x65, 0x0c, 0xcd, 0x01, 0x01, 0x8c,
+  0x00, 0x01, 0x01, 0xa0, 0x01, 0x01, 0x2e, 0x0c, 0xd5, 0x00, 0x04, 0x03,
+  0x61, 0x70, 0x69, 0x0c, 0xef, 0x04, 0x62, 0x61, 0x6e, 0x6b, 0x0c, 0xf3,
+  0x02, 0x66, 0x6a, 0x0c, 0xf7, 0x03, 0x77, 0x77, 0x77, 0x0c, 0xfb, 0x01,
+  0x01, 0xa3, 0x00, 0x01, 0x01, 0xa4, 0x00, 0x01, 0x01, 0xa2, 0x00, 0x01,
+  0x01, 0xa1, 0x00, 0x01, 0x01, 0x2d, 0x01, 0x02, 0x75, 0x70, 0x0d, 0x08,
+  0x01, 0x01, 0x2c, 0x00, 0x01, 0x01, 0x26, 0x00, 0x01, 0x01, 0x79, 0x01,
+  0x04, 0x2e, 0x77, 0x77, 0x77, 0x0d, 0x1b, 0x01, 0x01, 0x7a, 0x00, 0x00,
+  0x02, 0x0b, 0x68, 0x65, 0x72, 0x61, 0x70, 0x79, 0x6e, 0x6f, 0x74, 0x65,
+  0x73, 0x0d, 0x34, 0x02, 0x77, 0x69, 0x0d, 0x43, 0x01, 0x01, 0x85, 0x01,
+  0x04, 0x2e, 0x77, 0x77, 0x77, 0x0d, 0x3f, 0x01, 0x01, 0x86, 0x00, 0x00,
+  0x02, 0x06, 0x6d, 0x67, 0x2e, 0x73, 0x69, 0x30, 0x0d, 0x55, 0x04, 0x74,
+  0x74, 0x65, 0x72, 0x0d, 0x59, 0x01, 0x01, 0x57, 0x00, 0x01, 0x01, 0x4f,
+  0x01, 0x01, 0x2e, 0x0d, 0x61, 0x00, 0x07, 0x03, 0x61, 0x70, 0x69, 0x0d,
+  0x9c, 0x08, 0x62, 0x75, 0x73, 0x69, 0x6e, 0x65, 0x73, 0x73, 0x0d, 0xa0,
+  0x03, 0x64, 0x65, 0x76, 0x0d, 0xa4, 0x06, 0x6d, 0x6f, 0x62, 0x69, 0x6c,
+  0x65, 0x0d, 0xa8, 0x05, 0x6f, 0x61, 0x75, 0x74, 0x68, 0x0d, 0xac, 0x08,
+  0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x0d, 0xb0, 0x03, 0x77,
+  0x77, 0x77, 0x0d, 0xb4, 0x01, 0x01, 0x51, 0x00, 0x01, 0x01, 0x55, 0x00,
+  0x01, 0x01, 0x54, 0x00, 0x01, 0x01, 0x53, 0x00, 0x01, 0x01, 0x52, 0x00,
+  0x01, 0x01, 0x56, 0x00, 0x01, 0x01, 0x50, 0x00, 0x01, 0x00, 0x2f, 0x00,
+  0x00, 0x02, 0x06, 0x6f, 0x75, 0x74, 0x75, 0x62, 0x65, 0x0d, 0xce, 0x04,
+  0x74, 0x69, 0x6d, 0x67, 0x0d, 0xd2, 0x01, 0x00, 0x25, 0x00, 0x01, 0x00,
+  0x23, 0x00, 0x01, 0x00, 0x51, 0x00, 0x01, 0x00, 0x77, 0x00, 0x01, 0x00,
+  0xac, 0x00, 0x01, 0x00, 0x78, 0x00, 0x01, 0x00, 0xad, 0x00, 0x00, 0x06,
+  0x02, 0x65, 0x2e, 0x0e, 0x27, 0x08, 0x6a, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x0e, 0x92, 0x03, 0x6b, 0x2e, 0x67, 0x0e, 0x96, 0x08, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0e, 0xdd, 0x0c, 0x6f, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0e, 0xe1,
+  0x08, 0x7a, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0e, 0xe5, 0x00,
+  0x05, 0x08, 0x65, 0x6e, 0x74, 0x72, 0x6f, 0x70, 0x69, 0x61, 0x0e, 0x56,
+  0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0e, 0x65, 0x01, 0x70, 0x0e,
+  0x69, 0x0a, 0x73, 0x74, 0x6f, 0x63, 0x6b, 0x74, 0x72, 0x61, 0x64, 0x65,
+  0x0e, 0x8a, 0x05, 0x7a, 0x6f, 0x6f, 0x32, 0x34, 0x0e, 0x8e, 0x01, 0x01,
+  0x21, 0x01, 0x04, 0x2e, 0x77, 0x77, 0x77, 0x0e, 0x61, 0x01, 0x01, 0x22,
+  0x00, 0x01, 0x00, 0xae, 0x00, 0x00, 0x02, 0x06, 0x61, 0x79, 0x6d, 0x69,
+  0x6c, 0x6c, 0x0e, 0x82, 0x0b, 0x69, 0x72, 0x61, 0x74, 0x65, 0x6e, 0x6c,
+  0x6f, 0x67, 0x69, 0x6e, 0x0e, 0x86, 0x01, 0x01, 0x92, 0x00, 0x01, 0x01,
+  0x6f, 0x00, 0x01, 0x01, 0x83, 0x00, 0x01, 0x01, 0x95, 0x00, 0x01, 0x00,
+  0xaf, 0x00, 0x00, 0x02, 0x08, 0x69, 0x67, 0x61, 0x68, 0x6f, 0x73, 0x74,
+  0x2e, 0x0e, 0xab, 0x05, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0e, 0xd9, 0x00,
+  0x03, 0x0d, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x63, 0x65, 0x6e,
+  0x74, 0x65, 0x72, 0x0e, 0xcd, 0x03, 0x70, 0x61, 0x79, 0x0e, 0xd1, 0x07,
+  0x77, 0x65, 0x62, 0x6d, 0x61, 0x69, 0x6c, 0x0e, 0xd5, 0x01, 0x01, 0x9f,
+  0x00, 0x01, 0x01, 0x9e, 0x00, 0x01, 0x01, 0x90, 0x00, 0x01, 0x00, 0xb0,
+  0x00, 0x01, 0x00, 0xb1, 0x00, 0x01, 0x00, 0x79, 0x00, 0x01, 0x00, 0xb2,
+  0x00, 0x00, 0x06, 0x0c, 0x63, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x0f, 0x40, 0x0f, 0x64, 0x75, 0x2e, 0x70, 0x6f,
+  0x6c, 0x79, 0x2e, 0x63, 0x73, 0x61, 0x77, 0x63, 0x74, 0x66, 0x0f, 0x44,
+  0x08, 0x65, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0f, 0x48, 0x0c,
+  0x67, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x0f, 0x4c, 0x08, 0x73, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0f,
+  0x50, 0x0c, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x0f, 0x54, 0x01, 0x00, 0x7a, 0x00, 0x01, 0x01, 0x75, 0x00,
+  0x01, 0x00, 0xb3, 0x00, 0x01, 0x00, 0x7b, 0x00, 0x01, 0x00, 0xb4, 0x00,
+  0x01, 0x00, 0x7c, 0x00, 0x00, 0x04, 0x08, 0x69, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x0f, 0x84, 0x0c, 0x6a, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0f, 0x88, 0x08, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0f, 0x8c, 0x02, 0x72, 0x2e, 0x0f, 0x90,
+  0x01, 0x00, 0xb5, 0x00, 0x01, 0x00, 0x7d, 0x00, 0x01, 0x00, 0xb6, 0x00,
+  0x00, 0x02, 0x06, 0x62, 0x65, 0x74, 0x6e, 0x65, 0x74, 0x0f, 0xa4, 0x06,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x0f, 0xa8, 0x01, 0x01, 0x2a, 0x00,
+  0x01, 0x00, 0xb7, 0x00, 0x00, 0x0b, 0x08, 0x61, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x10, 0x24, 0x02, 0x65, 0x2e, 0x10, 0x28, 0x08, 0x67,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x48, 0x0c, 0x68, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x4c,
+  0x0c, 0x69, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x10, 0x50, 0x05, 0x6c, 0x2e, 0x67, 0x6f, 0x6f, 0x10, 0x54, 0x08,
+  0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x62, 0x08, 0x70,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x66, 0x02, 0x72, 0x2e,
+  0x10, 0x6a, 0x0c, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x10, 0x8a, 0x08, 0x79, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x10, 0x8e, 0x01, 0x00, 0xb8, 0x00, 0x00, 0x02, 0x0a, 0x63,
+  0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x40, 0x06,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0x44, 0x01, 0x00, 0x7e, 0x00,
+  0x01, 0x00, 0xb9, 0x00, 0x01, 0x00, 0xba, 0x00, 0x01, 0x00, 0x7f, 0x00,
+  0x01, 0x00, 0x80, 0x00, 0x01, 0x00, 0x30, 0x01, 0x03, 0x67, 0x6c, 0x65,
+  0x10, 0x5e, 0x01, 0x00, 0xbb, 0x00, 0x01, 0x00, 0xbc, 0x00, 0x01, 0x00,
+  0xbd, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x10, 0x82, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x10, 0x86, 0x01, 0x00, 0x81, 0x00, 0x01, 0x00, 0xbe, 0x00, 0x01, 0x00,
+  0x82, 0x00, 0x01, 0x00, 0xbf, 0x00, 0x00, 0x05, 0x02, 0x6b, 0x2e, 0x10,
+  0xbf, 0x08, 0x6e, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0xdf,
+  0x08, 0x72, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0xe3, 0x08,
+  0x74, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x10, 0xe7, 0x02, 0x75,
+  0x2e, 0x10, 0xeb, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x10, 0xd7, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x10, 0xdb, 0x01, 0x00, 0x83, 0x00, 0x01, 0x00, 0xc0, 0x00, 0x01,
+  0x00, 0xc1, 0x00, 0x01, 0x00, 0xc2, 0x00, 0x01, 0x00, 0xc3, 0x00, 0x00,
+  0x02, 0x09, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x11,
+  0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x11, 0x06, 0x01, 0x00,
+  0x52, 0x00, 0x01, 0x00, 0xc4, 0x00, 0x00, 0x09, 0x0b, 0x64, 0x2e, 0x63,
+  0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x11, 0x50, 0x08, 0x65,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x11, 0x54, 0x0b, 0x6c, 0x2e,
+  0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x11, 0x58, 0x02,
+  0x6d, 0x2e, 0x11, 0x5c, 0x01, 0x6e, 0x11, 0x7b, 0x02, 0x6f, 0x2e, 0x11,
+  0x9e, 0x02, 0x71, 0x2e, 0x12, 0x10, 0x02, 0x73, 0x2e, 0x12, 0x30, 0x02,
+  0x74, 0x2e, 0x12, 0x4c, 0x01, 0x00, 0x53, 0x00, 0x01, 0x00, 0xc5, 0x00,
+  0x01, 0x00, 0x54, 0x00, 0x00, 0x02, 0x09, 0x63, 0x6f, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x11, 0x73, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x11, 0x77, 0x01, 0x00, 0x55, 0x00, 0x01, 0x00, 0xc6, 0x00, 0x00,
+  0x02, 0x0a, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x11, 0x96, 0x09, 0x66, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x11, 0x9a, 0x01, 0x00, 0x56, 0x00, 0x01, 0x00, 0xc7, 0x00, 0x00, 0x04,
+  0x05, 0x63, 0x72, 0x61, 0x74, 0x65, 0x11, 0xc0, 0x08, 0x69, 0x6e, 0x74,
+  0x65, 0x72, 0x63, 0x6f, 0x6d, 0x11, 0xc4, 0x06, 0x70, 0x61, 0x73, 0x73,
+  0x77, 0x64, 0x11, 0xe2, 0x01, 0x73, 0x11, 0xe6, 0x01, 0x01, 0x4e, 0x00,
+  0x01, 0x01, 0x71, 0x01, 0x01, 0x2e, 0x11, 0xcc, 0x00, 0x02, 0x03, 0x61,
+  0x70, 0x69, 0x11, 0xda, 0x03, 0x77, 0x77, 0x77, 0x11, 0xde, 0x01, 0x01,
+  0x72, 0x00, 0x01, 0x01, 0x73, 0x00, 0x01, 0x01, 0x69, 0x00, 0x00, 0x03,
+  0x0c, 0x65, 0x72, 0x76, 0x65, 0x72, 0x64, 0x65, 0x6e, 0x73, 0x69, 0x74,
+  0x79, 0x12, 0x04, 0x05, 0x68, 0x6f, 0x64, 0x61, 0x6e, 0x12, 0x08, 0x02,
+  0x6f, 0x6c, 0x12, 0x0c, 0x01, 0x01, 0x8e, 0x00, 0x01, 0x01, 0xbf, 0x00,
+  0x01, 0x01, 0x65, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0x28, 0x06, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x12, 0x2c, 0x01, 0x00, 0x84, 0x00, 0x01, 0x00, 0xc8, 0x00,
+  0x00, 0x02, 0x06, 0x63, 0x72, 0x79, 0x70, 0x74, 0x6f, 0x12, 0x44, 0x06,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0x48, 0x01, 0x01, 0x2f, 0x00,
+  0x01, 0x00, 0xc9, 0x00, 0x00, 0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x12, 0x62, 0x08, 0x75, 0x70, 0x72, 0x6f, 0x74, 0x65, 0x63, 0x74,
+  0x12, 0x66, 0x01, 0x00, 0xca, 0x00, 0x01, 0x01, 0x2b, 0x00, 0x00, 0x04,
+  0x02, 0x65, 0x2e, 0x12, 0x89, 0x0c, 0x6d, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0xa8, 0x01, 0x6f, 0x12, 0xac,
+  0x02, 0x70, 0x2e, 0x12, 0xe2, 0x00, 0x02, 0x09, 0x63, 0x6f, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0xa0, 0x06, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x12, 0xa4, 0x01, 0x00, 0x57, 0x00, 0x01, 0x00, 0xcc, 0x00,
+  0x01, 0x00, 0x85, 0x00, 0x00, 0x02, 0x01, 0x2e, 0x12, 0xbe, 0x09, 0x62,
+  0x73, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0xde, 0x00, 0x02,
+  0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12,
+  0xd6, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x12, 0xda, 0x01, 0x00,
+  0x86, 0x00, 0x01, 0x00, 0xcd, 0x00, 0x01, 0x00, 0xce, 0x00, 0x00, 0x03,
+  0x09, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0x05,
+  0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0x09, 0x09, 0x6e, 0x65,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0x0d, 0x01, 0x00, 0x58,
+  0x00, 0x01, 0x00, 0xcf, 0x00, 0x01, 0x00, 0xe4, 0x00, 0x00, 0x07, 0x0b,
+  0x65, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13,
+  0x6e, 0x08, 0x67, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0x72,
+  0x0c, 0x68, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x13, 0x76, 0x08, 0x69, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x13, 0x7a, 0x0b, 0x72, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x13, 0x7e, 0x0c, 0x77, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0x82, 0x08, 0x7a, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x13, 0x86, 0x01, 0x00, 0x59, 0x00, 0x01, 0x00,
+  0xd0, 0x00, 0x01, 0x00, 0x87, 0x00, 0x01, 0x00, 0xd1, 0x00, 0x01, 0x00,
+  0x5a, 0x00, 0x01, 0x00, 0x88, 0x00, 0x01, 0x00, 0xd2, 0x00, 0x00, 0x09,
+  0x08, 0x61, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x13, 0xfa, 0x0c,
+  0x62, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x13, 0xfe, 0x08, 0x69, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x14,
+  0x02, 0x08, 0x6b, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x14, 0x06,
+  0x0b, 0x73, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x14, 0x0a, 0x08, 0x74, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x14,
+  0x0e, 0x08, 0x75, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x14, 0x12,
+  0x08, 0x76, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x14, 0x16, 0x0c,
+  0x79, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x14, 0x1a, 0x01, 0x00, 0xd3, 0x00, 0x01, 0x00, 0x89, 0x00, 0x01, 0x00,
+  0xd4, 0x00, 0x01, 0x00, 0xd5, 0x00, 0x01, 0x00, 0x5b, 0x00, 0x01, 0x00,
+  0xd6, 0x00, 0x01, 0x00, 0xd7, 0x00, 0x01, 0x00, 0xd8, 0x00, 0x01, 0x00,
+  0x8a, 0x00, 0x00, 0x0f, 0x0b, 0x61, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x14, 0xcb, 0x08, 0x64, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x14, 0xcf, 0x02, 0x65, 0x2e, 0x14, 0xd3, 0x08, 0x67,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x10, 0x08, 0x6b, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x14, 0x08, 0x6c, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x18, 0x08, 0x6e, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x15, 0x1c, 0x08, 0x73, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x15, 0x20, 0x06, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x15, 0x24, 0x08, 0x75, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15,
+  0x4a, 0x08, 0x76, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x4e,
+  0x08, 0x77, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x52, 0x0c,
+  0x78, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x15, 0x56, 0x0c, 0x79, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x15, 0x5a, 0x0b, 0x7a, 0x2e, 0x63, 0x6f, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x5e, 0x01, 0x00, 0x5c, 0x00, 0x01,
+  0x00, 0xd9, 0x00, 0x00, 0x04, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x15, 0x00, 0x04, 0x70, 0x69, 0x78, 0x69, 0x15, 0x04, 0x0d, 0x72, 0x61,
+  0x70, 0x69, 0x64, 0x72, 0x65, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68, 0x15,
+  0x08, 0x08, 0x77, 0x72, 0x69, 0x74, 0x65, 0x61, 0x70, 0x70, 0x15, 0x0c,
+  0x01, 0x00, 0xda, 0x00, 0x01, 0x01, 0x44, 0x00, 0x01, 0x01, 0xc0, 0x00,
+  0x01, 0x01, 0x99, 0x00, 0x01, 0x00, 0xdb, 0x00, 0x01, 0x00, 0xdc, 0x00,
+  0x01, 0x00, 0xdd, 0x00, 0x01, 0x00, 0xde, 0x00, 0x01, 0x00, 0xdf, 0x00,
+  0x00, 0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0x42, 0x10,
+  0x6d, 0x65, 0x64, 0x62, 0x61, 0x6e, 0x6b, 0x2e, 0x62, 0x75, 0x73, 0x69,
+  0x6e, 0x65, 0x73, 0x73, 0x15, 0x46, 0x01, 0x00, 0x8b, 0x00, 0x01, 0x01,
+  0x5e, 0x00, 0x01, 0x00, 0xe0, 0x00, 0x01, 0x00, 0xe1, 0x00, 0x01, 0x00,
+  0xe2, 0x00, 0x01, 0x00, 0x8c, 0x00, 0x01, 0x00, 0x8d, 0x00, 0x01, 0x00,
+  0x5d, 0x00, 0x00, 0x0b, 0x01, 0x61, 0x15, 0xd0, 0x01, 0x65, 0x15, 0xfb,
+  0x0c, 0x66, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x17, 0x11, 0x0c, 0x67, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x17, 0x15, 0x0c, 0x69, 0x2e, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17, 0x19, 0x02, 0x6c, 0x2e,
+  0x17, 0x1d, 0x08, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17,
+  0x3c, 0x0c, 0x70, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x17, 0x40, 0x02, 0x72, 0x2e, 0x17, 0x44, 0x08, 0x75, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17, 0x64, 0x05, 0x7a, 0x2e, 0x63,
+  0x6f, 0x2e, 0x17, 0x68, 0x00, 0x02, 0x0b, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x15, 0xf3, 0x10, 0x6d, 0x65, 0x2e,
+  0x62, 0x75, 0x74, 0x63, 0x68, 0x65, 0x72, 0x2e, 0x73, 0x69, 0x6d, 0x6f,
+  0x6e, 0x15, 0xf7, 0x01, 0x00, 0x8e, 0x00, 0x01, 0x01, 0x30, 0x00, 0x00,
+  0x02, 0x07, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x16, 0x0c, 0x02,
+  0x74, 0x2e, 0x16, 0x10, 0x01, 0x00, 0xe3, 0x00, 0x00, 0x09, 0x11, 0x61,
+  0x6b, 0x61, 0x6d, 0x61, 0x69, 0x68, 0x64, 0x2e, 0x74, 0x77, 0x69, 0x6d,
+  0x67, 0x30, 0x2d, 0x61, 0x16, 0x61, 0x05, 0x62, 0x61, 0x73, 0x73, 0x68,
+  0x16, 0x65, 0x0b, 0x64, 0x6f, 0x75, 0x62, 0x6c, 0x65, 0x63, 0x6c, 0x69,
+  0x63, 0x6b, 0x16, 0x69, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x16,
+  0x7a, 0x01, 0x6c, 0x16, 0x7e, 0x01, 0x6d, 0x16, 0xa6, 0x01, 0x6e, 0x16,
+  0xd4, 0x06, 0x72, 0x69, 0x73, 0x65, 0x75, 0x70, 0x17, 0x09, 0x04, 0x73,
+  0x61, 0x68, 0x33, 0x17, 0x0d, 0x01, 0x01, 0x58, 0x00, 0x01, 0x01, 0xa5,
+  0x00, 0x01, 0x00, 0x2a, 0x01, 0x06, 0x2e, 0x6c, 0x65, 0x61, 0x72, 0x6e,
+  0x16, 0x76, 0x01, 0x01, 0x0b, 0x00, 0x01, 0x00, 0xe5, 0x00, 0x00, 0x02,
+  0x0a, 0x65, 0x64, 0x67, 0x65, 0x72, 0x73, 0x63, 0x6f, 0x70, 0x65, 0x16,
+  0x93, 0x03, 0x69, 0x6e, 0x78, 0x16, 0xa2, 0x01, 0x01, 0x3c, 0x01, 0x04,
+  0x2e, 0x77, 0x77, 0x77, 0x16, 0x9e, 0x01, 0x01, 0x3d, 0x00, 0x01, 0x01,
+  0x31, 0x00, 0x00, 0x02, 0x0c, 0x61, 0x74, 0x74, 0x6d, 0x63, 0x63, 0x75,
+  0x74, 0x63, 0x68, 0x65, 0x6e, 0x16, 0xcc, 0x12, 0x69, 0x6e, 0x61, 0x7a,
+  0x6f, 0x2e, 0x62, 0x69, 0x67, 0x73, 0x68, 0x69, 0x6e, 0x79, 0x6c, 0x6f,
+  0x63, 0x6b, 0x16, 0xd0, 0x01, 0x01, 0x29, 0x00, 0x01, 0x01, 0x4d, 0x00,
+  0x00, 0x02, 0x17, 0x65, 0x61, 0x72, 0x6c, 0x79, 0x66, 0x72, 0x65, 0x65,
+  0x73, 0x70, 0x65, 0x65, 0x63, 0x68, 0x2e, 0x6d, 0x65, 0x6d, 0x62, 0x65,
+  0x72, 0x73, 0x17, 0x01, 0x0e, 0x6f, 0x69, 0x73, 0x65, 0x62, 0x72, 0x69,
+  0x64, 0x67, 0x65, 0x2e, 0x77, 0x77, 0x77, 0x17, 0x05, 0x01, 0x01, 0x9b,
+  0x00, 0x01, 0x01, 0x11, 0x00, 0x01, 0x01, 0x13, 0x00, 0x01, 0x01, 0xa6,
+  0x00, 0x01, 0x00, 0x8f, 0x00, 0x01, 0x00, 0x90, 0x00, 0x01, 0x00, 0x91,
+  0x00, 0x00, 0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17, 0x34,
+  0x09, 0x6f, 0x74, 0x74, 0x6f, 0x73, 0x70, 0x6f, 0x72, 0x61, 0x17, 0x38,
+  0x01, 0x00, 0xe6, 0x00, 0x01, 0x01, 0x1c, 0x00, 0x01, 0x00, 0xe7, 0x00,
+  0x01, 0x00, 0x92, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17, 0x5c, 0x06, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x17, 0x60, 0x01, 0x00, 0x93, 0x00, 0x01, 0x00, 0xe8, 0x00,
+  0x01, 0x00, 0xe9, 0x00, 0x00, 0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x17, 0x7a, 0x04, 0x6d, 0x65, 0x67, 0x61, 0x17, 0x7e, 0x01, 0x00,
+  0x5e, 0x00, 0x01, 0x01, 0x96, 0x01, 0x04, 0x2e, 0x61, 0x70, 0x69, 0x17,
+  0x89, 0x01, 0x01, 0x97, 0x00, 0x00, 0x02, 0x0c, 0x6d, 0x2e, 0x63, 0x6f,
+  0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x17, 0xa4, 0x03, 0x72,
+  0x67, 0x2e, 0x17, 0xa8, 0x01, 0x00, 0x94, 0x00, 0x00, 0x0b, 0x09, 0x62,
+  0x72, 0x6f, 0x77, 0x73, 0x65, 0x72, 0x69, 0x64, 0x17, 0xf9, 0x01, 0x63,
+  0x17, 0xfd, 0x09, 0x68, 0x6f, 0x77, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d,
+  0x18, 0x33, 0x05, 0x6a, 0x69, 0x74, 0x73, 0x69, 0x18, 0x37, 0x01, 0x6d,
+  0x18, 0x5a, 0x04, 0x6e, 0x65, 0x67, 0x39, 0x18, 0xef, 0x01, 0x70, 0x18,
+  0xf3, 0x01, 0x73, 0x19, 0x17, 0x03, 0x74, 0x6f, 0x72, 0x19, 0x50, 0x06,
+  0x75, 0x62, 0x65, 0x72, 0x74, 0x74, 0x19, 0x9d, 0x06, 0x77, 0x68, 0x6f,
+  0x6e, 0x69, 0x78, 0x19, 0xa1, 0x01, 0x01, 0x6a, 0x00, 0x00, 0x02, 0x12,
+  0x68, 0x72, 0x6f, 0x6d, 0x69, 0x75, 0x6d, 0x2e, 0x63, 0x6f, 0x64, 0x65,
+  0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x18, 0x2b, 0x14, 0x6c, 0x6f, 0x75,
+  0x64, 0x73, 0x65, 0x63, 0x75, 0x72, 0x69, 0x74, 0x79, 0x61, 0x6c, 0x6c,
+  0x69, 0x61, 0x6e, 0x63, 0x65, 0x18, 0x2f, 0x01, 0x00, 0x1e, 0x00, 0x01,
+  0x01, 0x27, 0x00, 0x01, 0x01, 0x70, 0x00, 0x01, 0x01, 0x62, 0x01, 0x01,
+  0x2e, 0x18, 0x3f, 0x00, 0x02, 0x08, 0x64, 0x6f, 0x77, 0x6e, 0x6c, 0x6f,
+  0x61, 0x64, 0x18, 0x52, 0x03, 0x77, 0x77, 0x77, 0x18, 0x56, 0x01, 0x01,
+  0x64, 0x00, 0x01, 0x01, 0x63, 0x00, 0x00, 0x02, 0x01, 0x61, 0x18, 0x72,
+  0x0f, 0x6f, 0x7a, 0x69, 0x6c, 0x6c, 0x61, 0x2e, 0x62, 0x75, 0x67, 0x7a,
+  0x69, 0x6c, 0x6c, 0x61, 0x18, 0xeb, 0x00, 0x02, 0x0a, 0x6b, 0x65, 0x79,
+  0x6f, 0x75, 0x72, 0x6c, 0x61, 0x77, 0x73, 0x18, 0x8b, 0x07, 0x79, 0x66,
+  0x69, 0x72, 0x73, 0x74, 0x2e, 0x18, 0x9a, 0x01, 0x01, 0x76, 0x01, 0x04,
+  0x2e, 0x77, 0x77, 0x77, 0x18, 0x96, 0x01, 0x01, 0x77, 0x00, 0x00, 0x06,
+  0x02, 0x69, 0x64, 0x18, 0xd3, 0x05, 0x6c, 0x69, 0x73, 0x74, 0x73, 0x18,
+  0xd7, 0x07, 0x6d, 0x65, 0x6d, 0x62, 0x65, 0x72, 0x73, 0x18, 0xdb, 0x09,
+  0x72, 0x6f, 0x75, 0x6e, 0x64, 0x63, 0x75, 0x62, 0x65, 0x18, 0xdf, 0x07,
+  0x73, 0x75, 0x70, 0x70, 0x6f, 0x72, 0x74, 0x18, 0xe3, 0x07, 0x77, 0x65,
+  0x62, 0x6d, 0x61, 0x69, 0x6c, 0x18, 0xe7, 0x01, 0x01, 0x17, 0x00, 0x01,
+  0x01, 0x18, 0x00, 0x01, 0x01, 0x15, 0x00, 0x01, 0x01, 0x1a, 0x00, 0x01,
+  0x01, 0x16, 0x00, 0x01, 0x01, 0x19, 0x00, 0x01, 0x01, 0x9a, 0x00, 0x01,
+  0x01, 0x12, 0x00, 0x00, 0x02, 0x08, 0x61, 0x63, 0x6b, 0x61, 0x67, 0x69,
+  0x73, 0x74, 0x19, 0x0f, 0x0c, 0x65, 0x72, 0x73, 0x6f, 0x6e, 0x61, 0x2e,
+  0x6c, 0x6f, 0x67, 0x69, 0x6e, 0x19, 0x13, 0x01, 0x01, 0x7b, 0x00, 0x01,
+  0x01, 0x6b, 0x00, 0x00, 0x02, 0x0b, 0x69, 0x6c, 0x65, 0x6e, 0x74, 0x63,
+  0x69, 0x72, 0x63, 0x6c, 0x65, 0x19, 0x2b, 0x01, 0x75, 0x19, 0x2f, 0x01,
+  0x01, 0x8d, 0x00, 0x00, 0x02, 0x0b, 0x6e, 0x73, 0x68, 0x69, 0x6e, 0x65,
+  0x70, 0x72, 0x65, 0x73, 0x73, 0x19, 0x48, 0x06, 0x72, 0x6b, 0x61, 0x74,
+  0x74, 0x79, 0x19, 0x4c, 0x01, 0x01, 0x10, 0x00, 0x01, 0x01, 0xc1, 0x00,
+  0x00, 0x02, 0x04, 0x32, 0x77, 0x65, 0x62, 0x19, 0x63, 0x07, 0x70, 0x72,
+  0x6f, 0x6a, 0x65, 0x63, 0x74, 0x19, 0x67, 0x01, 0x01, 0x5d, 0x00, 0x01,
+  0x01, 0x36, 0x01, 0x01, 0x2e, 0x19, 0x6f, 0x00, 0x04, 0x04, 0x62, 0x6c,
+  0x6f, 0x67, 0x19, 0x8d, 0x05, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x19, 0x91,
+  0x04, 0x64, 0x69, 0x73, 0x74, 0x19, 0x95, 0x03, 0x77, 0x77, 0x77, 0x19,
+  0x99, 0x01, 0x01, 0x37, 0x00, 0x01, 0x01, 0x38, 0x00, 0x01, 0x01, 0x3a,
+  0x00, 0x01, 0x01, 0x39, 0x00, 0x01, 0x01, 0x43, 0x00, 0x01, 0x01, 0xbc,
+  0x00, 0x00, 0x0a, 0x0c, 0x61, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x17, 0x0c, 0x65, 0x2e, 0x63, 0x6f, 0x6d,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x1b, 0x0c, 0x68, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x1f,
+  0x02, 0x6b, 0x2e, 0x1a, 0x23, 0x02, 0x6c, 0x2e, 0x1a, 0x43, 0x08, 0x6e,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x63, 0x0c, 0x72, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x67,
+  0x08, 0x73, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x6b, 0x02,
+  0x74, 0x2e, 0x1a, 0x6f, 0x0c, 0x79, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x8f, 0x01, 0x00, 0x95, 0x00, 0x01,
+  0x00, 0x96, 0x00, 0x01, 0x00, 0x97, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f,
+  0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x3b, 0x06, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x3f, 0x01, 0x00, 0x98, 0x00, 0x01,
+  0x00, 0xeb, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x5b, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1a, 0x5f, 0x01, 0x00, 0x99, 0x00, 0x01, 0x00, 0xec, 0x00, 0x01,
+  0x00, 0xed, 0x00, 0x01, 0x00, 0x9a, 0x00, 0x01, 0x00, 0xee, 0x00, 0x00,
+  0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0x87, 0x0a, 0x73,
+  0x61, 0x70, 0x6f, 0x2e, 0x6c, 0x6f, 0x67, 0x69, 0x6e, 0x1a, 0x8b, 0x01,
+  0x00, 0xef, 0x00, 0x01, 0x01, 0x28, 0x00, 0x01, 0x00, 0x9b, 0x00, 0x01,
+  0x00, 0x9c, 0x00, 0x00, 0x04, 0x08, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x1a, 0xbf, 0x08, 0x73, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1a, 0xc3, 0x02, 0x75, 0x2e, 0x1a, 0xc7, 0x08, 0x77, 0x2e, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1a, 0xe7, 0x01, 0x00, 0xf0, 0x00, 0x01,
+  0x00, 0xf1, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1a, 0xdf, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1a, 0xe3, 0x01, 0x00, 0x9d, 0x00, 0x01, 0x00, 0xf2, 0x00, 0x01,
+  0x00, 0xf3, 0x00, 0x00, 0x0e, 0x0c, 0x61, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0x8f, 0x0c, 0x62, 0x2e, 0x63,
+  0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0x93, 0x08,
+  0x63, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0x97, 0x02, 0x65,
+  0x2e, 0x1b, 0x9b, 0x0c, 0x67, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xc4, 0x02, 0x68, 0x2e, 0x1b, 0xc8, 0x08,
+  0x69, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xe6, 0x08, 0x6b,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xea, 0x0c, 0x6c, 0x2e,
+  0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xee,
+  0x08, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xf2, 0x08,
+  0x6e, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xf6, 0x08, 0x6f,
+  0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xfa, 0x08, 0x74, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xfe, 0x0c, 0x76, 0x2e, 0x63,
+  0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0x02, 0x01,
+  0x00, 0x9e, 0x00, 0x01, 0x00, 0x9f, 0x00, 0x01, 0x00, 0xf4, 0x00, 0x00,
+  0x03, 0x04, 0x63, 0x65, 0x72, 0x74, 0x1b, 0xb8, 0x06, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x1b, 0xbc, 0x08, 0x6c, 0x6f, 0x67, 0x6f, 0x74, 0x79,
+  0x70, 0x65, 0x1b, 0xc0, 0x01, 0x01, 0x2e, 0x00, 0x01, 0x00, 0xf5, 0x00,
+  0x01, 0x01, 0xb6, 0x00, 0x01, 0x00, 0xa0, 0x00, 0x00, 0x02, 0x06, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1b, 0xde, 0x08, 0x6d, 0x65, 0x64, 0x69,
+  0x61, 0x63, 0x72, 0x75, 0x1b, 0xe2, 0x01, 0x00, 0xf6, 0x00, 0x01, 0x01,
+  0xc5, 0x00, 0x01, 0x00, 0xf7, 0x00, 0x01, 0x00, 0xf8, 0x00, 0x01, 0x00,
+  0xa1, 0x00, 0x01, 0x00, 0xf9, 0x00, 0x01, 0x00, 0xfa, 0x00, 0x01, 0x00,
+  0xfb, 0x00, 0x01, 0x00, 0xfc, 0x00, 0x01, 0x00, 0xa2, 0x00, 0x00, 0x0e,
+  0x08, 0x64, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xae, 0x08,
+  0x67, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xb2, 0x0b, 0x68,
+  0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xb6,
+  0x0c, 0x6a, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1c, 0xba, 0x08, 0x6b, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x1c, 0xbe, 0x08, 0x6c, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c,
+  0xc2, 0x08, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xc6,
+  0x02, 0x6e, 0x2e, 0x1c, 0xca, 0x08, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x1c, 0xea, 0x08, 0x70, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1c, 0xee, 0x0c, 0x72, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xf2, 0x08, 0x74, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x1c, 0xf6, 0x0c, 0x77, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xfa, 0x0b, 0x7a, 0x2e, 0x63,
+  0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1c, 0xfe, 0x01, 0x00,
+  0xfd, 0x00, 0x01, 0x00, 0xfe, 0x00, 0x01, 0x00, 0x5f, 0x00, 0x01, 0x00,
+  0xa3, 0x00, 0x01, 0x00, 0xff, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01,
+  0x01, 0x00, 0x00, 0x02, 0x0a, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x1c, 0xe2, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x1c, 0xe6, 0x01, 0x00, 0xa4, 0x00, 0x01, 0x01, 0x02, 0x00, 0x01, 0x01,
+  0x03, 0x00, 0x01, 0x01, 0x04, 0x00, 0x01, 0x00, 0xa5, 0x00, 0x01, 0x01,
+  0x05, 0x00, 0x01, 0x00, 0xa6, 0x00, 0x01, 0x00, 0x60, 0x00, 0x00, 0x06,
+  0x0c, 0x61, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1d, 0x3f, 0x0b, 0x67, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f,
+  0x67, 0x6c, 0x65, 0x1d, 0x43, 0x02, 0x6b, 0x2e, 0x1d, 0x47, 0x02, 0x73,
+  0x2e, 0x1d, 0x7b, 0x0c, 0x79, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1d, 0x98, 0x02, 0x7a, 0x2e, 0x1d, 0x9c, 0x01,
+  0x00, 0xa7, 0x00, 0x01, 0x00, 0x61, 0x00, 0x00, 0x02, 0x03, 0x63, 0x6f,
+  0x2e, 0x1d, 0x59, 0x07, 0x67, 0x6f, 0x76, 0x2e, 0x77, 0x77, 0x77, 0x1d,
+  0x77, 0x00, 0x02, 0x08, 0x63, 0x61, 0x72, 0x6c, 0x6f, 0x6c, 0x6c, 0x79,
+  0x1d, 0x6f, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1d, 0x73, 0x01,
+  0x01, 0xb9, 0x00, 0x01, 0x00, 0x62, 0x00, 0x01, 0x01, 0x8b, 0x00, 0x00,
+  0x02, 0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1d, 0x90, 0x07, 0x6d,
+  0x75, 0x64, 0x63, 0x72, 0x61, 0x62, 0x1d, 0x94, 0x01, 0x01, 0x06, 0x00,
+  0x01, 0x01, 0xc4, 0x00, 0x01, 0x00, 0xa8, 0x00, 0x00, 0x02, 0x09, 0x63,
+  0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1d, 0xb3, 0x06, 0x67,
+  0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1d, 0xb7, 0x01, 0x00, 0x63, 0x00, 0x01,
+  0x01, 0x07, 0x00, 0x00, 0x06, 0x0c, 0x63, 0x2e, 0x63, 0x6f, 0x6d, 0x2e,
+  0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1e, 0x00, 0x04, 0x65, 0x2e, 0x63,
+  0x6f, 0x1e, 0x04, 0x08, 0x67, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x1e, 0x23, 0x0b, 0x69, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x1e, 0x27, 0x06, 0x6e, 0x2e, 0x63, 0x6f, 0x6d, 0x2e, 0x1e,
+  0x2b, 0x08, 0x75, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, 0x1e, 0x56,
+  0x01, 0x00, 0xa9, 0x00, 0x00, 0x02, 0x07, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x1e, 0x1b, 0x08, 0x6d, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c,
+  0x65, 0x1e, 0x1f, 0x01, 0x00, 0x64, 0x00, 0x01, 0x00, 0xaa, 0x00, 0x01,
+  0x01, 0x08, 0x00, 0x01, 0x00, 0x65, 0x00, 0x00, 0x02, 0x06, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1e, 0x4e, 0x15, 0x69, 0x6e, 0x64, 0x6f, 0x76,
+  0x69, 0x6e, 0x61, 0x62, 0x61, 0x6e, 0x6b, 0x2e, 0x65, 0x62, 0x61, 0x6e,
+  0x6b, 0x69, 0x6e, 0x67, 0x1e, 0x52, 0x01, 0x00, 0xab, 0x00, 0x01, 0x01,
+  0x34, 0x00, 0x01, 0x01, 0x09, 0x00, 0x01, 0x01, 0x0a, 0x00, 0x00, 0x03,
+  0x0b, 0x61, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65,
+  0x1e, 0x8a, 0x0b, 0x6d, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f, 0x6f, 0x67,
+  0x6c, 0x65, 0x1e, 0x8e, 0x0b, 0x77, 0x2e, 0x63, 0x6f, 0x2e, 0x67, 0x6f,
+  0x6f, 0x67, 0x6c, 0x65, 0x1e, 0x92, 0x01, 0x00, 0x66, 0x00, 0x01, 0x00,
+  0x67, 0x00, 0x01, 0x00, 0x68, 0x00,
+};
+
+#endif  // NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_
@@ -55,6 +55,7 @@
         '../sdch/sdch.gyp:sdch',
         '../third_party/icu/icu.gyp:icui18n',
         '../third_party/icu/icu.gyp:icuuc',
+        '../third_party/lzma_sdk/lzma_sdk.gyp:lzma_sdk',
         '../third_party/zlib/zlib.gyp:zlib',
         '../url/url.gyp:url_lib',
         'net_resources',
@@ -154,6 +155,8 @@
         'base/load_states_list.h',
         'base/load_timing_info.cc',
         'base/load_timing_info.h',
+        'base/lzma_filter.cc',
+        'base/lzma_filter.h',
         'base/mime_sniffer.cc',
         'base/mime_sniffer.h',
         'base/mime_util.cc',
@@ -621,6 +624,7 @@
         'http/transport_security_state.cc',
         'http/transport_security_state.h',
         'http/transport_security_state_static.h',
+        'http/transport_security_state_static_trie.h',
         'http/url_security_manager.cc',
         'http/url_security_manager.h',
         'http/url_security_manager_posix.cc',
@@ -780,6 +784,8 @@
         'quic/crypto/quic_random.h',
         'quic/crypto/scoped_evp_cipher_ctx.cc',
         'quic/crypto/scoped_evp_cipher_ctx.h',
+        'quic/crypto/sharded_strike_register.cc',
+        'quic/crypto/sharded_strike_register.h',
         'quic/crypto/strike_register.cc',
         'quic/crypto/strike_register.h',
         'quic/crypto/source_address_token.cc',
@@ -925,6 +931,16 @@
         'socket_stream/socket_stream_metrics.h',
         'spdy/buffered_spdy_framer.cc',
         'spdy/buffered_spdy_framer.h',
+        'spdy/hpack_constants.cc',
+        'spdy/hpack_constants.h',
+        'spdy/hpack_decoder.cc',
+        'spdy/hpack_decoder.h',
+        'spdy/hpack_encoder.cc',
+        'spdy/hpack_encoder.h',
+        'spdy/hpack_header_table.cc',
+        'spdy/hpack_header_table.h',
+        'spdy/hpack_huffman.cc',
+        'spdy/hpack_huffman.h',
         'spdy/spdy_bitmasks.h',
         'spdy/spdy_buffer.cc',
         'spdy/spdy_buffer.h',
@@ -934,6 +950,8 @@
         'spdy/spdy_credential_builder.h',
         'spdy/spdy_credential_state.cc',
         'spdy/spdy_credential_state.h',
+        'spdy/spdy_flat_header_block.cc',
+        'spdy/spdy_flat_header_block.h',
         'spdy/spdy_frame_builder.cc',
         'spdy/spdy_frame_builder.h',
         'spdy/spdy_frame_reader.cc',
@@ -1487,6 +1505,7 @@
         '../crypto/crypto.gyp:crypto',
         '../testing/gmock.gyp:gmock',
         '../testing/gtest.gyp:gtest',
+        '../third_party/lzma_sdk/lzma_sdk.gyp:lzma_sdk',
         '../third_party/zlib/zlib.gyp:zlib',
         '../url/url.gyp:url_lib',
         'http_server',
@@ -1513,6 +1532,7 @@
         'base/host_port_pair_unittest.cc',
         'base/ip_endpoint_unittest.cc',
         'base/keygen_handler_unittest.cc',
+        'base/lzma_filter_unittest.cc',
         'base/mime_sniffer_unittest.cc',
         'base/mime_util_unittest.cc',
         'base/mock_filter_context.cc',
@@ -1704,6 +1724,7 @@
         'quic/crypto/p256_key_exchange_test.cc',
         'quic/crypto/proof_test.cc',
         'quic/crypto/quic_random_test.cc',
+        'quic/crypto/sharded_strike_register_test.cc',
         'quic/crypto/strike_register_test.cc',
         'quic/test_tools/crypto_test_utils.cc',
         'quic/test_tools/crypto_test_utils.h',
@@ -1791,9 +1812,14 @@
         'socket_stream/socket_stream_metrics_unittest.cc',
         'socket_stream/socket_stream_unittest.cc',
         'spdy/buffered_spdy_framer_unittest.cc',
+        'spdy/hpack_decoder_test.cc',
+        'spdy/hpack_encoder_test.cc',
+        'spdy/hpack_header_table_test.cc',
+        'spdy/hpack_huffman_test.cc',
         'spdy/spdy_credential_builder_unittest.cc',
         'spdy/spdy_buffer_unittest.cc',
         'spdy/spdy_credential_state_unittest.cc',
+        'spdy/spdy_flat_header_block_test.cc',
         'spdy/spdy_frame_builder_test.cc',
         'spdy/spdy_frame_reader_test.cc',
         'spdy/spdy_framer_test.cc',
@@ -1840,6 +1866,7 @@
         'tools/dump_cache/url_utilities.cc',
         'tools/dump_cache/url_utilities_unittest.cc',
         'tools/tld_cleanup/tld_cleanup_util_unittest.cc',
+        'tools/transport_security_state_generator/preload_trie_util_unittest.cc',
         'udp/udp_socket_unittest.cc',
         'url_request/url_fetcher_impl_unittest.cc',
         'url_request/url_request_context_builder_unittest.cc',
@@ -2150,14 +2177,34 @@
         '../base/base.gyp:base_i18n',
         '../base/base.gyp:test_support_perf',
         '../testing/gtest.gyp:gtest',
+        '../third_party/lzma_sdk/lzma_sdk.gyp:lzma_sdk',
+        '../third_party/zlib/zlib.gyp:zlib',
         '../url/url.gyp:url_lib',
+        'http_server',
         'net',
         'net_test_support',
       ],
       'sources': [
+        'base/filter_perftest.cc',
+        'base/net_log_perftest.cc',
+        'cert/multi_threaded_cert_verifier_perftest.cc',
         'cookies/cookie_monster_perftest.cc',
         'disk_cache/disk_cache_perftest.cc',
+        'http/http_cache_perftest.cc',
+        'http/http_stream_parser_perftest.cc',
+        'http/transport_security_state_perftest.cc',
+        'http/http_transaction_unittest.cc',
+        'http/http_transaction_unittest.h',
+        'http/mock_http_cache.cc',
+        'http/mock_http_cache.h',
         'proxy/proxy_resolver_perftest.cc',
+        'quic/crypto/strike_register_perftest.cc',
+        'server/http_server_perftest.cc',
+        'socket/client_socket_pool_base_perftest.cc',
+        'spdy/spdy_header_compression_perftest.cc',
+        'spdy/spdy_write_queue_perftest.cc',
+        'udp/udp_socket_perftest.cc',
+        'url_request/url_request_http_job_perftest.cc',
       ],
       'conditions': [
         [ 'use_v8_in_net==1', {
@@ -2176,6 +2223,10 @@
             'dependencies': [
               '../third_party/icu/icu.gyp:icudata',
             ],
+            # RecvMultiple() is only implemented by UDPSocketLibevent.
+            'sources!': [
+              'udp/udp_socket_perftest.cc',
+            ],
             # TODO(jschuh): crbug.com/167187 fix size_t to int truncations.
             'msvs_disabled_warnings': [4267, ],
           },
@@ -2189,6 +2240,7 @@
         '../base/base.gyp:base',
         '../base/base.gyp:test_support_base',
         '../net/tools/tld_cleanup/tld_cleanup.gyp:tld_cleanup_util',
+        '../net/tools/transport_security_state_generator/transport_security_state_generator.gyp:preload_trie_util',
         '../testing/gtest.gyp:gtest',
         '../testing/gmock.gyp:gmock',
         '../url/url.gyp:url_lib',
@@ -2598,6 +2650,17 @@
           # TODO(jschuh): crbug.com/167187 fix size_t to int truncations.
           'msvs_disabled_warnings': [4267, ],
         },
+        {
+          'target_name': 'transport_security_state_generator',
+          'type': 'executable',
+          'dependencies': [
+            '../base/base.gyp:base',
+            '../net/tools/transport_security_state_generator/transport_security_state_generator.gyp:preload_trie_util',
+          ],
+          'sources': [
+            'tools/transport_security_state_generator/transport_security_state_generator.cc',
+          ],
+        },
       ],
     }],
     ['os_posix == 1 and OS != "mac" and OS != "ios" and OS != "android"', {
@@ -2692,6 +2755,18 @@
             'tools/flip_server/flip_in_mem_edsm_server.cc',
           ],
         },
+        {
+          'target_name': 'flip_load_generator',
+          'type': 'executable',
+          'dependencies': [
+            '../base/base.gyp:base',
+            'flip_balsa_and_epoll_library',
+            'flip_in_mem_edsm_server_library',
+          ],
+          'sources': [
+            'tools/flip_server/flip_load_generator.cc',
+          ],
+        },
         {
           'target_name': 'quic_library',
           'type': 'static_library',
@@ -65,6 +65,7 @@ LOCAL_SRC_FILES := \
 	net/base/keygen_handler.cc \
 	net/base/keygen_handler_openssl.cc \
 	net/base/load_timing_info.cc \
+	net/base/lzma_filter.cc \
 	net/base/mime_sniffer.cc \
 	net/base/mime_util.cc \
 	net/base/net_errors.cc \
@@ -307,6 +308,7 @@ LOCAL_SRC_FILES := \
 	net/quic/crypto/quic_encrypter.cc \
 	net/quic/crypto/quic_random.cc \
 	net/quic/crypto/scoped_evp_cipher_ctx.cc \
+	net/quic/crypto/sharded_strike_register.cc \
 	net/quic/crypto/strike_register.cc \
 	net/quic/crypto/source_address_token.cc \
 	net/quic/quic_alarm.cc \
@@ -371,10 +373,16 @@ LOCAL_SRC_FILES := \
 	net/socket_stream/socket_stream_job_manager.cc \
 	net/socket_stream/socket_stream_metrics.cc \
 	net/spdy/buffered_spdy_framer.cc \
+	net/spdy/hpack_constants.cc \
+	net/spdy/hpack_decoder.cc \
+	net/spdy/hpack_encoder.cc \
+	net/spdy/hpack_header_table.cc \
+	net/spdy/hpack_huffman.cc \
 	net/spdy/spdy_buffer.cc \
 	net/spdy/spdy_buffer_producer.cc \
 	net/spdy/spdy_credential_builder.cc \
 	net/spdy/spdy_credential_state.cc \
+	net/spdy/spdy_flat_header_block.cc \
 	net/spdy/spdy_frame_builder.cc \
 	net/spdy/spdy_frame_reader.cc \
 	net/spdy/spdy_framer.cc \
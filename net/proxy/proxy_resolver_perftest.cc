@@ -3,13 +3,19 @@
 // found in the LICENSE file.
 
 #include "base/base_paths.h"
+#include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/file_util.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
 #include "base/perftimer.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/proxy/multi_threaded_proxy_resolver.h"
 #include "net/proxy/proxy_info.h"
 #include "net/proxy/proxy_resolver_v8.h"
 #include "net/test/spawned_test_server/spawned_test_server.h"
@@ -227,3 +233,168 @@ TEST(ProxyResolverPerfTest, ProxyResolverV8) {
   PacPerfSuiteRunner runner(&resolver, "ProxyResolverV8");
   runner.RunAllTests();
 }
+
+// Answers myIpAddress() and dnsResolve() with the loopback address, without
+// blocking. Safe to use from several threads at once.
+class LoopbackJSBindings : public net::ProxyResolverV8::JSBindings {
+ public:
+  LoopbackJSBindings() {}
+
+  virtual void Alert(const base::string16& message) OVERRIDE {}
+
+  virtual bool ResolveDns(const std::string& host,
+                          ResolveDnsOperation op,
+                          std::string* output,
+                          bool* terminate) OVERRIDE {
+    *output = "127.0.0.1";
+    return true;
+  }
+
+  virtual void OnError(int line_number,
+                       const base::string16& message) OVERRIDE {
+    CHECK(false);
+  }
+};
+
+// Creates the ProxyResolverV8s run on the threads of a
+// MultiThreadedProxyResolver.
+class ProxyResolverFactoryForV8 : public net::ProxyResolverFactory {
+ public:
+  explicit ProxyResolverFactoryForV8(
+      net::ProxyResolverV8::JSBindings* js_bindings)
+      : ProxyResolverFactory(true /*expects_pac_bytes*/),
+        js_bindings_(js_bindings) {}
+
+  virtual net::ProxyResolver* CreateProxyResolver() OVERRIDE {
+    net::ProxyResolverV8* resolver = new net::ProxyResolverV8;
+    resolver->set_js_bindings(js_bindings_);
+    return resolver;
+  }
+
+ private:
+  net::ProxyResolverV8::JSBindings* js_bindings_;
+};
+
+// The number of host rules in the generated PAC script. Managed networks
+// commonly use PAC scripts with thousands of rules like these, most of which
+// are never reached, but all of which have to be parsed on every load.
+const int kNumLargePacRules = 5000;
+
+// Returns a PAC script which sends hosts in "siteN.example" to "proxyN:80",
+// for N in [0, |num_rules|), and everything else to "fallback:80" if
+// myIpAddress() is on the loopback network.
+std::string MakeLargePacScript(int num_rules) {
+  std::string script = "function FindProxyForURL(url, host) {\n"
+                       "  if (isPlainHostName(host))\n"
+                       "    return \"DIRECT\";\n";
+  for (int i = 0; i < num_rules; ++i) {
+    base::StringAppendF(
+        &script,
+        "  if (dnsDomainIs(host, \".site%d.example\") ||\n"
+        "      shExpMatch(url, \"*://site%d.example/*\"))\n"
+        "    return \"PROXY proxy%d:80\";\n",
+        i, i, i);
+  }
+  script += "  if (isInNet(myIpAddress(), \"127.0.0.0\", \"255.0.0.0\"))\n"
+            "    return \"PROXY fallback:80\";\n"
+            "  return \"DIRECT\";\n"
+            "}\n";
+  return script;
+}
+
+// Counts the requests issued to a resolver, and stops the message loop once
+// they have all completed.
+class RequestCounter {
+ public:
+  RequestCounter() : num_pending_(0) {}
+
+  net::CompletionCallback Add() {
+    ++num_pending_;
+    return base::Bind(&RequestCounter::OnComplete, base::Unretained(this));
+  }
+
+ private:
+  void OnComplete(int result) {
+    EXPECT_EQ(net::OK, result);
+    if (--num_pending_ == 0)
+      base::MessageLoop::current()->Quit();
+  }
+
+  int num_pending_;
+};
+
+// Measures how long a MultiThreadedProxyResolver running ProxyResolverV8s
+// takes to load a large PAC script, to bring up a resolver on each of its
+// threads, and how many URLs per second it then resolves.
+TEST(ProxyResolverPerfTest, MultiThreadedProxyResolverV8) {
+  const int kNumThreads = 4;
+
+  net::ProxyResolverV8::RememberDefaultIsolate();
+  base::MessageLoop message_loop;
+
+  LoopbackJSBindings js_bindings;
+  net::MultiThreadedProxyResolver resolver(
+      new ProxyResolverFactoryForV8(&js_bindings), kNumThreads);
+
+  {
+    PerfTimeLogger timer("MultiThreadedProxyResolverV8_large_pac_load");
+    net::TestCompletionCallback callback;
+    int rv = resolver.SetPacScript(
+        net::ProxyResolverScriptData::FromUTF8(
+            MakeLargePacScript(kNumLargePacRules)),
+        callback.callback());
+    ASSERT_EQ(net::OK, callback.GetResult(rv));
+    timer.Done();
+  }
+
+  const char* const kHosts[] = {
+    "www.site0.example",
+    "www.site2500.example",
+    "www.site4999.example",
+    "www.unlisted.example",
+  };
+  const char* const kExpectedResults[] = {
+    "PROXY proxy0:80",
+    "PROXY proxy2500:80",
+    "PROXY proxy4999:80",
+    "PROXY fallback:80",
+  };
+  COMPILE_ASSERT(arraysize(kHosts) == arraysize(kExpectedResults),
+                 hosts_and_expected_results_mismatch);
+
+  // Issues the requests of each round at once, so that they are spread over all
+  // of the threads, and checks their results once they have all completed.
+  const int kNumRequests = 2000;
+  for (int round = 0; round < 2; ++round) {
+    // The first round also creates the threads, each of which loads the PAC
+    // script into its own resolver.
+    const int num_requests = round == 0 ? kNumThreads : kNumRequests;
+    ScopedVector<net::ProxyInfo> results;
+    RequestCounter counter;
+    PerfTimer timer;
+    for (int i = 0; i < num_requests; ++i) {
+      results.push_back(new net::ProxyInfo);
+      int rv = resolver.GetProxyForURL(
+          GURL(base::StringPrintf("http://%s/%d",
+                                  kHosts[i % arraysize(kHosts)], i)),
+          results.back(), counter.Add(), NULL, net::BoundNetLog());
+      ASSERT_EQ(net::ERR_IO_PENDING, rv);
+    }
+    base::MessageLoop::current()->Run();
+    double seconds = timer.Elapsed().InSecondsF();
+
+    for (int i = 0; i < num_requests; ++i) {
+      ASSERT_EQ(kExpectedResults[i % arraysize(kExpectedResults)],
+                results[i]->ToPacString());
+    }
+
+    if (round == 0) {
+      LogPerfResult("MultiThreadedProxyResolverV8_large_pac_thread_startup",
+                    seconds * 1000, "ms");
+    } else {
+      std::string name = base::StringPrintf(
+          "MultiThreadedProxyResolverV8_large_pac_%d_threads", kNumThreads);
+      LogPerfResult(name.c_str(), num_requests / seconds, "resolutions/s");
+    }
+  }
+}
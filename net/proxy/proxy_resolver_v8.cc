@@ -9,6 +9,7 @@
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
@@ -327,6 +328,62 @@ bool IsInNetEx(const std::string& ip_address, const std::string& ip_prefix) {
   return IPNumberMatchesPrefix(address, prefix, prefix_length_in_bits);
 }
 
+// Holds context-independent compilations of the PAC utility functions and
+// of the most recently loaded PAC script. All of the contexts live in the
+// default isolate, so a script compiled once can be run in each of them; this
+// spares every resolver of a MultiThreadedProxyResolver, and every restart of
+// a SetPacScript() by ProxyResolverV8Tracing, from parsing the same (possibly
+// very large) script again. Must only be used while holding a v8::Locker for
+// the default isolate.
+class CompiledScriptCache {
+ public:
+  CompiledScriptCache() {}
+
+  // Returns the compiled utility functions, or an empty handle if they have
+  // not been compiled yet.
+  v8::Local<v8::Script> GetUtilityScript(v8::Isolate* isolate) {
+    return v8::Local<v8::Script>::New(isolate, utility_script_);
+  }
+
+  void SetUtilityScript(v8::Isolate* isolate, v8::Handle<v8::Script> script) {
+    utility_script_.Reset(isolate, script);
+  }
+
+  // Returns the compiled |pac_script|, or an empty handle if a different
+  // script (or none) was last compiled.
+  v8::Local<v8::Script> GetPacScript(
+      v8::Isolate* isolate,
+      const scoped_refptr<ProxyResolverScriptData>& pac_script) {
+    if (!pac_script_data_.get() || !pac_script_data_->Equals(pac_script.get()))
+      return v8::Local<v8::Script>();
+    return v8::Local<v8::Script>::New(isolate, pac_script_);
+  }
+
+  void SetPacScript(v8::Isolate* isolate,
+                    const scoped_refptr<ProxyResolverScriptData>& pac_script,
+                    v8::Handle<v8::Script> script) {
+    pac_script_data_ = pac_script;
+    pac_script_.Reset(isolate, script);
+  }
+
+  // Drops the compiled scripts, so that their code can be collected.
+  void Clear(v8::Isolate* isolate) {
+    utility_script_.Reset(isolate, v8::Handle<v8::Script>());
+    pac_script_.Reset(isolate, v8::Handle<v8::Script>());
+    pac_script_data_ = NULL;
+  }
+
+ private:
+  v8::Persistent<v8::Script> utility_script_;
+  scoped_refptr<ProxyResolverScriptData> pac_script_data_;
+  v8::Persistent<v8::Script> pac_script_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledScriptCache);
+};
+
+base::LazyInstance<CompiledScriptCache>::Leaky g_compiled_script_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 // ProxyResolverV8::Context ---------------------------------------------------
@@ -456,21 +513,41 @@ class ProxyResolverV8::Context {
         v8::Local<v8::Context>::New(isolate_, v8_context_);
     v8::Context::Scope ctx(context);
 
+    CompiledScriptCache* cache = g_compiled_script_cache.Pointer();
+
     // Add the PAC utility functions to the environment.
     // (This script should never fail, as it is a string literal!)
     // Note that the two string literals are concatenated.
-    int rv = RunScript(
-        ASCIILiteralToV8String(
-            PROXY_RESOLVER_SCRIPT
-            PROXY_RESOLVER_SCRIPT_EX),
-        kPacUtilityResourceName);
+    v8::Local<v8::Script> utility_script = cache->GetUtilityScript(isolate_);
+    if (utility_script.IsEmpty()) {
+      utility_script = CompileScript(
+          ASCIILiteralToV8String(
+              PROXY_RESOLVER_SCRIPT
+              PROXY_RESOLVER_SCRIPT_EX),
+          kPacUtilityResourceName);
+      if (utility_script.IsEmpty()) {
+        NOTREACHED();
+        return ERR_PAC_SCRIPT_FAILED;
+      }
+      cache->SetUtilityScript(isolate_, utility_script);
+    }
+    int rv = RunScript(utility_script);
     if (rv != OK) {
       NOTREACHED();
       return rv;
     }
 
-    // Add the user's PAC code to the environment.
-    rv = RunScript(ScriptDataToV8String(pac_script), kPacResourceName);
+    // Add the user's PAC code to the environment. Scripts which fail to
+    // compile are not cached, so that each attempt reports the error.
+    v8::Local<v8::Script> script = cache->GetPacScript(isolate_, pac_script);
+    if (script.IsEmpty()) {
+      script = CompileScript(ScriptDataToV8String(pac_script),
+                             kPacResourceName);
+      if (script.IsEmpty())
+        return ERR_PAC_SCRIPT_FAILED;
+      cache->SetPacScript(isolate_, pac_script, script);
+    }
+    rv = RunScript(script);
     if (rv != OK)
       return rv;
 
@@ -488,6 +565,7 @@ class ProxyResolverV8::Context {
 
   void PurgeMemory() {
     v8::Locker locked(isolate_);
+    g_compiled_script_cache.Get().Clear(isolate_);
     v8::V8::LowMemoryNotification();
   }
 
@@ -513,19 +591,32 @@ class ProxyResolverV8::Context {
     js_bindings()->OnError(line_number, error_message);
   }
 
-  // Compiles and runs |script| in the current V8 context.
-  // Returns OK on success, otherwise an error code.
-  int RunScript(v8::Handle<v8::String> script, const char* script_name) {
+  // Compiles |script| without binding it to a context, so that it can be
+  // run in any context of the isolate. Returns an empty handle on failure,
+  // after reporting the error.
+  v8::Local<v8::Script> CompileScript(v8::Handle<v8::String> script,
+                                      const char* script_name) {
     v8::TryCatch try_catch;
 
-    // Compile the script.
     v8::ScriptOrigin origin =
         v8::ScriptOrigin(ASCIILiteralToV8String(script_name));
-    v8::Local<v8::Script> code = v8::Script::Compile(script, &origin);
+    v8::Local<v8::Script> code = v8::Script::New(script, &origin);
+
+    if (try_catch.HasCaught()) {
+      HandleError(try_catch.Message());
+      return v8::Local<v8::Script>();
+    }
+
+    return code;
+  }
+
+  // Runs the compiled |code| in the current V8 context.
+  // Returns OK on success, otherwise an error code.
+  int RunScript(v8::Handle<v8::Script> code) {
+    v8::TryCatch try_catch;
 
     // Execute.
-    if (!code.IsEmpty())
-      code->Run();
+    code->Run();
 
     // Check for errors.
     if (try_catch.HasCaught()) {
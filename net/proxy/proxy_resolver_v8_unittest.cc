@@ -314,6 +314,44 @@ TEST(ProxyResolverV8Test, SideEffects) {
   }
 }
 
+// Load the same PAC script into two resolvers. The compiled script is shared
+// between them, but each should still run it in its own environment.
+TEST(ProxyResolverV8Test, SameScriptInSeveralResolvers) {
+  ProxyResolverV8WithMockBindings resolver1;
+  ProxyResolverV8WithMockBindings resolver2;
+  EXPECT_EQ(OK, resolver1.SetPacScriptFromDisk("side_effects.js"));
+  EXPECT_EQ(OK, resolver2.SetPacScriptFromDisk("side_effects.js"));
+
+  for (int i = 0; i < 3; ++i) {
+    ProxyInfo proxy_info;
+    int result = resolver1.GetProxyForURL(
+        kQueryUrl, &proxy_info, CompletionCallback(), NULL, BoundNetLog());
+    EXPECT_EQ(OK, result);
+    EXPECT_EQ(base::StringPrintf("sideffect_%d:80", i),
+              proxy_info.proxy_server().ToURI());
+  }
+
+  // The counter of the second resolver was not incremented by the first.
+  ProxyInfo proxy_info;
+  int result = resolver2.GetProxyForURL(
+      kQueryUrl, &proxy_info, CompletionCallback(), NULL, BoundNetLog());
+  EXPECT_EQ(OK, result);
+  EXPECT_EQ("sideffect_0:80", proxy_info.proxy_server().ToURI());
+
+  // A malformed script is reported by every resolver which loads it.
+  ProxyResolverV8WithMockBindings resolver3;
+  ProxyResolverV8WithMockBindings resolver4;
+  EXPECT_EQ(ERR_PAC_SCRIPT_FAILED,
+            resolver3.SetPacScriptFromDisk("missing_close_brace.js"));
+  EXPECT_EQ(ERR_PAC_SCRIPT_FAILED,
+            resolver4.SetPacScriptFromDisk("missing_close_brace.js"));
+  EXPECT_EQ(1U, resolver3.mock_js_bindings()->errors.size());
+  EXPECT_EQ(1U, resolver4.mock_js_bindings()->errors.size());
+
+  EXPECT_EQ(0U, resolver1.mock_js_bindings()->errors.size());
+  EXPECT_EQ(0U, resolver2.mock_js_bindings()->errors.size());
+}
+
 // Execute a PAC script which throws an exception in FindProxyForURL.
 TEST(ProxyResolverV8Test, UnhandledException) {
   ProxyResolverV8WithMockBindings resolver;
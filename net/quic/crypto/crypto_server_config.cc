@@ -27,6 +27,7 @@
 #include "net/quic/crypto/quic_encrypter.h"
 #include "net/quic/crypto/quic_random.h"
 #include "net/quic/crypto/source_address_token.h"
+#include "net/quic/crypto/sharded_strike_register.h"
 #include "net/quic/crypto/strike_register.h"
 #include "net/quic/quic_clock.h"
 #include "net/quic/quic_protocol.h"
@@ -58,6 +59,7 @@ QuicCryptoServerConfig::QuicCryptoServerConfig(
       server_nonce_strike_register_lock_(),
       strike_register_max_entries_(1 << 10),
       strike_register_window_secs_(600),
+      strike_register_num_shards_(1),
       source_address_token_future_secs_(3600),
       source_address_token_lifetime_secs_(86400),
       server_nonce_strike_register_max_entries_(1 << 10),
@@ -628,18 +630,25 @@ QuicErrorCode QuicCryptoServerConfig::EvaluateClientHello(
       info->client_nonce.size() == kNonceSize) {
     info->client_nonce_well_formed = true;
     if (replay_protection_) {
-      base::AutoLock auto_lock(strike_register_lock_);
-
-      if (strike_register_.get() == NULL) {
-        strike_register_.reset(new StrikeRegister(
-            strike_register_max_entries_,
-            static_cast<uint32>(info->now.ToUNIXSeconds()),
-            strike_register_window_secs_,
-            orbit,
-            StrikeRegister::DENY_REQUESTS_AT_STARTUP));
+      ShardedStrikeRegister* strike_register = NULL;
+      {
+        base::AutoLock auto_lock(strike_register_lock_);
+
+        if (strike_register_.get() == NULL) {
+          strike_register_.reset(new ShardedStrikeRegister(
+              strike_register_num_shards_,
+              strike_register_max_entries_,
+              static_cast<uint32>(info->now.ToUNIXSeconds()),
+              strike_register_window_secs_,
+              orbit,
+              StrikeRegister::DENY_REQUESTS_AT_STARTUP));
+        }
+        strike_register = strike_register_.get();
       }
 
-      unique_by_strike_register = strike_register_->Insert(
+      // The strike register is never destroyed once created and only locks
+      // the shard that owns this nonce.
+      unique_by_strike_register = strike_register->Insert(
           reinterpret_cast<const uint8*>(info->client_nonce.data()),
           static_cast<uint32>(info->now.ToUNIXSeconds()));
     }
@@ -922,6 +931,14 @@ void QuicCryptoServerConfig::set_strike_register_window_secs(
   strike_register_window_secs_ = window_secs;
 }
 
+void QuicCryptoServerConfig::set_strike_register_num_shards(
+    uint32 num_shards) {
+  base::AutoLock locker(strike_register_lock_);
+  DCHECK(!strike_register_.get());
+  DCHECK_GT(num_shards, 0u);
+  strike_register_num_shards_ = num_shards;
+}
+
 void QuicCryptoServerConfig::set_source_address_token_future_secs(
     uint32 future_secs) {
   source_address_token_future_secs_ = future_secs;
@@ -30,6 +30,7 @@ class QuicDecrypter;
 class QuicEncrypter;
 class QuicRandom;
 class QuicServerConfigProtobuf;
+class ShardedStrikeRegister;
 class StrikeRegister;
 
 struct ClientHelloInfo;
@@ -166,6 +167,13 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // means that the quiescent startup period must be longer.
   void set_strike_register_window_secs(uint32 window_secs);
 
+  // set_strike_register_num_shards sets the number of independent shards that
+  // the internal strike register is split into. Client nonces are validated
+  // under a per-shard lock, so using more than one shard allows handshakes to
+  // be validated concurrently on several threads. The entries set by
+  // |set_strike_register_max_entries| are divided evenly between the shards.
+  void set_strike_register_num_shards(uint32 num_shards);
+
   // set_source_address_token_future_secs sets the number of seconds into the
   // future that source-address tokens will be accepted from. Since
   // source-address tokens are authenticated, this should only happen if
@@ -317,10 +325,12 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // active config will be promoted to primary.
   mutable QuicWallTime next_config_promotion_time_;
 
+  // strike_register_lock_ protects the lazy creation of |strike_register_|.
+  // The strike register itself is thread-safe.
   mutable base::Lock strike_register_lock_;
   // strike_register_ contains a data structure that keeps track of previously
   // observed client nonces in order to prevent replay attacks.
-  mutable scoped_ptr<StrikeRegister> strike_register_;
+  mutable scoped_ptr<ShardedStrikeRegister> strike_register_;
 
   // source_address_token_boxer_ is used to protect the source-address tokens
   // that are given to clients.
@@ -353,6 +363,7 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // respective setter functions.
   uint32 strike_register_max_entries_;
   uint32 strike_register_window_secs_;
+  uint32 strike_register_num_shards_;
   uint32 source_address_token_future_secs_;
   uint32 source_address_token_lifetime_secs_;
   uint32 server_nonce_strike_register_max_entries_;
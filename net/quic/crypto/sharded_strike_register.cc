@@ -0,0 +1,107 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/crypto/sharded_strike_register.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/rand_util.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "crypto/sha2.h"
+
+namespace net {
+
+namespace {
+
+// Nonces are 4 bytes of time, 8 bytes of orbit and then 20 random bytes. Only
+// the random bytes are used to select a shard.
+const size_t kNonceRandomOffset = 12;
+const size_t kNonceRandomSize = 20;
+
+}  // namespace
+
+class ShardedStrikeRegister::Shard {
+ public:
+  Shard(unsigned max_entries,
+        uint32 current_time_external,
+        uint32 window_secs,
+        const uint8 orbit[8],
+        StrikeRegister::StartupType startup)
+      : strike_register_(max_entries, current_time_external, window_secs,
+                         orbit, startup) {
+  }
+
+  bool Insert(const uint8 nonce[32], const uint32 current_time) {
+    base::AutoLock locked(lock_);
+    return strike_register_.Insert(nonce, current_time);
+  }
+
+  void Validate() {
+    base::AutoLock locked(lock_);
+    strike_register_.Validate();
+  }
+
+ private:
+  base::Lock lock_;
+  StrikeRegister strike_register_;
+
+  DISALLOW_COPY_AND_ASSIGN(Shard);
+};
+
+ShardedStrikeRegister::ShardedStrikeRegister(
+    unsigned num_shards,
+    unsigned max_entries,
+    uint32 current_time_external,
+    uint32 window_secs,
+    const uint8 orbit[8],
+    StrikeRegister::StartupType startup) {
+  CHECK_GT(num_shards, 0u);
+  memcpy(orbit_, orbit, sizeof(orbit_));
+  base::RandBytes(shard_key_, sizeof(shard_key_));
+
+  // StrikeRegister requires at least two entries.
+  unsigned entries_per_shard = std::max(2u, max_entries / num_shards);
+  shards_.reserve(num_shards);
+  for (unsigned i = 0; i < num_shards; ++i) {
+    shards_.push_back(new Shard(entries_per_shard, current_time_external,
+                                window_secs, orbit, startup));
+  }
+}
+
+ShardedStrikeRegister::~ShardedStrikeRegister() {
+  STLDeleteElements(&shards_);
+}
+
+bool ShardedStrikeRegister::Insert(const uint8 nonce[32],
+                                   const uint32 current_time) {
+  return shards_[ShardForNonce(nonce)]->Insert(nonce, current_time);
+}
+
+const uint8* ShardedStrikeRegister::orbit() const {
+  return orbit_;
+}
+
+size_t ShardedStrikeRegister::ShardForNonce(const uint8 nonce[32]) const {
+  if (shards_.size() == 1)
+    return 0;
+  uint8 input[sizeof(shard_key_) + kNonceRandomSize];
+  memcpy(input, shard_key_, sizeof(shard_key_));
+  memcpy(input + sizeof(shard_key_), nonce + kNonceRandomOffset,
+         kNonceRandomSize);
+  uint32 hash;
+  crypto::SHA256HashString(
+      base::StringPiece(reinterpret_cast<const char*>(input), sizeof(input)),
+      &hash, sizeof(hash));
+  return hash % shards_.size();
+}
+
+void ShardedStrikeRegister::Validate() {
+  for (size_t i = 0; i < shards_.size(); ++i)
+    shards_[i]->Validate();
+}
+
+}  // namespace net
@@ -0,0 +1,75 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
+#define NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+#include "net/quic/crypto/strike_register.h"
+
+namespace net {
+
+// A ShardedStrikeRegister partitions the set of observed nonces across a
+// number of independent StrikeRegisters, each guarded by its own lock, so that
+// several threads can validate client nonces concurrently.
+//
+// A nonce is assigned to a shard by hashing its random bytes. Since the
+// assignment is a pure function of the nonce, a replayed nonce is always
+// checked against the shard that recorded it and the replay guarantees of
+// StrikeRegister hold for each nonce. Each shard has its own horizon, which
+// only advances when that shard drops its oldest entry, so a busy shard never
+// causes nonces in a quiet shard to be rejected.
+//
+// The random bytes of a nonce are chosen by the client, so they are hashed
+// together with a secret key, picked at random for each register, to keep an
+// attacker from aiming all of its nonces at a single shard and filling it
+// |num_shards| times as fast as an unsharded StrikeRegister.
+class NET_EXPORT_PRIVATE ShardedStrikeRegister {
+ public:
+  // Constructs |num_shards| StrikeRegisters which, between them, hold at most
+  // |max_entries| nonces. Each shard holds at least two entries. See
+  // StrikeRegister for the meaning of the remaining arguments.
+  ShardedStrikeRegister(unsigned num_shards,
+                        unsigned max_entries,
+                        uint32 current_time_external,
+                        uint32 window_secs,
+                        const uint8 orbit[8],
+                        StrikeRegister::StartupType startup);
+
+  ~ShardedStrikeRegister();
+
+  // Insert has the same semantics as |StrikeRegister::Insert|. It may be
+  // called concurrently from any number of threads.
+  bool Insert(const uint8 nonce[32], const uint32 current_time);
+
+  // orbit returns a pointer to the 8-byte orbit value shared by all shards.
+  const uint8* orbit() const;
+
+  size_t num_shards() const { return shards_.size(); }
+
+  // ShardForNonce returns the index of the shard responsible for |nonce|.
+  size_t ShardForNonce(const uint8 nonce[32]) const;
+
+  // This is a debugging aid which checks every shard for sanity. It must not
+  // be called concurrently with |Insert|.
+  void Validate();
+
+ private:
+  class Shard;
+
+  uint8 orbit_[8];
+  // shard_key_ is the secret mixed into the hash which selects a shard.
+  uint8 shard_key_[16];
+  // shards_ owns the per-shard StrikeRegisters and their locks.
+  std::vector<Shard*> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedStrikeRegister);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
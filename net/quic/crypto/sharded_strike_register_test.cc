@@ -0,0 +1,205 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/crypto/sharded_strike_register.h"
+
+#include <set>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stl_util.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+const uint8 kOrbit[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+// SetNonce builds a nonce with the given time and orbit. |random| is written
+// into the start of the random bytes so that distinct values of |random| may
+// land in different shards.
+void SetNonce(uint8 nonce[32], unsigned time, const uint8 orbit[8],
+              uint32 random) {
+  nonce[0] = time >> 24;
+  nonce[1] = time >> 16;
+  nonce[2] = time >> 8;
+  nonce[3] = time;
+  memcpy(nonce + 4, orbit, 8);
+  memset(nonce + 12, 0, 20);
+  memcpy(nonce + 12, &random, sizeof(random));
+}
+
+TEST(ShardedStrikeRegisterTest, SimpleHorizon) {
+  // Every shard must reject values created on or before its creation time.
+  ShardedStrikeRegister set(4 /* shards */, 40 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  uint8 nonce[32];
+  for (uint32 i = 0; i < 64; ++i) {
+    SetNonce(nonce, 999, kOrbit, i);
+    EXPECT_FALSE(set.Insert(nonce, 1000));
+    SetNonce(nonce, 1000, kOrbit, i);
+    EXPECT_FALSE(set.Insert(nonce, 1000));
+  }
+}
+
+TEST(ShardedStrikeRegisterTest, BadOrbit) {
+  ShardedStrikeRegister set(4 /* shards */, 40 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  static const uint8 kBadOrbit[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+  uint8 nonce[32];
+  for (uint32 i = 0; i < 64; ++i) {
+    SetNonce(nonce, 1101, kBadOrbit, i);
+    EXPECT_FALSE(set.Insert(nonce, 1100));
+  }
+}
+
+TEST(ShardedStrikeRegisterTest, RejectDuplicate) {
+  ShardedStrikeRegister set(4 /* shards */, 400 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  uint8 nonce[32];
+  for (uint32 i = 0; i < 64; ++i) {
+    SetNonce(nonce, 1101, kOrbit, i);
+    EXPECT_TRUE(set.Insert(nonce, 1100));
+    EXPECT_FALSE(set.Insert(nonce, 1100));
+  }
+  set.Validate();
+}
+
+TEST(ShardedStrikeRegisterTest, ShardsAreUsed) {
+  ShardedStrikeRegister set(8 /* shards */, 800 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  EXPECT_EQ(8u, set.num_shards());
+
+  uint8 nonce[32];
+  std::set<size_t> shards;
+  for (uint32 i = 0; i < 256; ++i) {
+    SetNonce(nonce, 1101, kOrbit, i);
+    shards.insert(set.ShardForNonce(nonce));
+    // The shard must not depend on the time or orbit.
+    size_t shard = set.ShardForNonce(nonce);
+    SetNonce(nonce, 1200, kOrbit, i);
+    EXPECT_EQ(shard, set.ShardForNonce(nonce));
+  }
+  EXPECT_EQ(8u, shards.size());
+}
+
+TEST(ShardedStrikeRegisterTest, ShardsDependOnSecretKey) {
+  ShardedStrikeRegister set1(8 /* shards */, 800 /* max size */,
+                             1000 /* current time */, 100 /* window secs */,
+                             kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  ShardedStrikeRegister set2(8 /* shards */, 800 /* max size */,
+                             1000 /* current time */, 100 /* window secs */,
+                             kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+
+  // Without knowing the key a client cannot tell which shard a nonce goes
+  // to, so two registers disagree on at least some of the nonces.
+  uint8 nonce[32];
+  int differences = 0;
+  for (uint32 i = 0; i < 64; ++i) {
+    SetNonce(nonce, 1101, kOrbit, i);
+    if (set1.ShardForNonce(nonce) != set2.ShardForNonce(nonce))
+      ++differences;
+  }
+  EXPECT_GT(differences, 0);
+}
+
+TEST(ShardedStrikeRegisterTest, IndependentHorizons) {
+  // Two shards of two entries each.
+  ShardedStrikeRegister set(2 /* shards */, 4 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  uint8 nonce[32];
+
+  // Find nonces that land in each of the two shards.
+  uint32 in_shard[2][4];
+  size_t found[2] = { 0, 0 };
+  for (uint32 i = 0; found[0] < 4 || found[1] < 4; ++i) {
+    SetNonce(nonce, 1101, kOrbit, i);
+    size_t shard = set.ShardForNonce(nonce);
+    if (found[shard] < 4)
+      in_shard[shard][found[shard]++] = i;
+  }
+
+  // Overflow shard zero so that its horizon moves forward to 1101.
+  for (size_t i = 0; i < 3; ++i) {
+    SetNonce(nonce, 1101 + i, kOrbit, in_shard[0][i]);
+    ASSERT_TRUE(set.Insert(nonce, 1100));
+  }
+  SetNonce(nonce, 1101, kOrbit, in_shard[0][3]);
+  EXPECT_FALSE(set.Insert(nonce, 1100));
+
+  // Shard one still accepts nonces at 1101.
+  SetNonce(nonce, 1101, kOrbit, in_shard[1][0]);
+  EXPECT_TRUE(set.Insert(nonce, 1100));
+  set.Validate();
+}
+
+// InsertDelegate inserts a fixed range of nonces, each one twice, and counts
+// how many insertions succeeded.
+class InsertDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  InsertDelegate(ShardedStrikeRegister* set, uint32 first, uint32 count)
+      : set_(set), first_(first), count_(count), accepted_(0) {
+  }
+
+  virtual void Run() OVERRIDE {
+    uint8 nonce[32];
+    for (uint32 i = first_; i < first_ + count_; ++i) {
+      SetNonce(nonce, 1101, kOrbit, i);
+      if (set_->Insert(nonce, 1100))
+        ++accepted_;
+      if (set_->Insert(nonce, 1100))
+        ++accepted_;
+    }
+  }
+
+  uint32 accepted() const { return accepted_; }
+
+ private:
+  ShardedStrikeRegister* const set_;
+  const uint32 first_;
+  const uint32 count_;
+  uint32 accepted_;
+};
+
+TEST(ShardedStrikeRegisterTest, ConcurrentInsert) {
+  const uint32 kThreads = 4;
+  const uint32 kNoncesPerThread = 1000;
+  ShardedStrikeRegister set(8 /* shards */,
+                            2 * kThreads * kNoncesPerThread /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+
+  std::vector<InsertDelegate*> delegates;
+  std::vector<base::DelegateSimpleThread*> threads;
+  for (uint32 i = 0; i < kThreads; ++i) {
+    delegates.push_back(
+        new InsertDelegate(&set, i * kNoncesPerThread, kNoncesPerThread));
+    threads.push_back(
+        new base::DelegateSimpleThread(delegates.back(), "strike_register"));
+    threads.back()->Start();
+  }
+  uint32 accepted = 0;
+  for (uint32 i = 0; i < kThreads; ++i) {
+    threads[i]->Join();
+    accepted += delegates[i]->accepted();
+  }
+
+  // Every nonce is accepted exactly once.
+  EXPECT_EQ(kThreads * kNoncesPerThread, accepted);
+  set.Validate();
+
+  STLDeleteElements(&threads);
+  STLDeleteElements(&delegates);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -0,0 +1,119 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/perftimer.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
+#include "net/quic/crypto/sharded_strike_register.h"
+#include "net/quic/crypto/strike_register.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const uint8 kOrbit[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+const uint32 kMaxEntries = 1 << 16;
+const uint32 kInsertsPerThread = 200000;
+
+// LockedStrikeRegister mirrors the way QuicCryptoServerConfig used a single
+// StrikeRegister: every Insert is serialized through one lock.
+class LockedStrikeRegister {
+ public:
+  LockedStrikeRegister()
+      : strike_register_(kMaxEntries, 1000, 600, kOrbit,
+                         StrikeRegister::NO_STARTUP_PERIOD_NEEDED) {
+  }
+
+  bool Insert(const uint8 nonce[32], uint32 current_time) {
+    base::AutoLock locked(lock_);
+    return strike_register_.Insert(nonce, current_time);
+  }
+
+ private:
+  base::Lock lock_;
+  StrikeRegister strike_register_;
+};
+
+template <class Register>
+class InsertDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  InsertDelegate(Register* strike_register, uint32 thread_id)
+      : strike_register_(strike_register),
+        thread_id_(thread_id) {
+  }
+
+  virtual void Run() OVERRIDE {
+    uint8 nonce[32];
+    const uint32 kTime = 1000;
+    nonce[0] = kTime >> 24;
+    nonce[1] = kTime >> 16;
+    nonce[2] = kTime >> 8;
+    nonce[3] = kTime;
+    memcpy(nonce + 4, kOrbit, sizeof(kOrbit));
+    memset(nonce + 12, 0, 20);
+    memcpy(nonce + 16, &thread_id_, sizeof(thread_id_));
+    for (uint32 i = 0; i < kInsertsPerThread; ++i) {
+      memcpy(nonce + 12, &i, sizeof(i));
+      strike_register_->Insert(nonce, kTime);
+    }
+  }
+
+ private:
+  Register* const strike_register_;
+  const uint32 thread_id_;
+};
+
+template <class Register>
+void RunInsertBenchmark(const std::string& name,
+                        Register* strike_register,
+                        uint32 num_threads) {
+  std::vector<InsertDelegate<Register>*> delegates;
+  std::vector<base::DelegateSimpleThread*> threads;
+  for (uint32 i = 0; i < num_threads; ++i) {
+    delegates.push_back(new InsertDelegate<Register>(strike_register, i));
+    threads.push_back(
+        new base::DelegateSimpleThread(delegates.back(), "strike_register"));
+  }
+
+  PerfTimer timer;
+  for (uint32 i = 0; i < num_threads; ++i)
+    threads[i]->Start();
+  for (uint32 i = 0; i < num_threads; ++i)
+    threads[i]->Join();
+  base::TimeDelta elapsed = timer.Elapsed();
+
+  LogPerfResult(
+      base::StringPrintf("%s_%u_threads", name.c_str(), num_threads).c_str(),
+      (num_threads * kInsertsPerThread) / elapsed.InSecondsF(),
+      "inserts/s");
+
+  STLDeleteElements(&threads);
+  STLDeleteElements(&delegates);
+}
+
+}  // namespace
+
+TEST(StrikeRegisterPerfTest, Insert) {
+  const uint32 max_threads =
+      std::max(2, base::SysInfo::NumberOfProcessors());
+  for (uint32 threads = 1; threads <= max_threads; threads *= 2) {
+    LockedStrikeRegister locked;
+    RunInsertBenchmark("locked_strike_register_insert", &locked, threads);
+
+    ShardedStrikeRegister sharded(
+        4 * max_threads, kMaxEntries, 1000, 600, kOrbit,
+        StrikeRegister::NO_STARTUP_PERIOD_NEEDED);
+    RunInsertBenchmark("sharded_strike_register_insert", &sharded, threads);
+  }
+}
+
+}  // namespace net
@@ -4,6 +4,8 @@
 
 #include "net/server/http_connection.h"
 
+#include "base/memory/ref_counted_memory.h"
+#include "net/http/http_chunked_decoder.h"
 #include "net/server/http_server.h"
 #include "net/server/http_server_response_info.h"
 #include "net/server/web_socket.h"
@@ -11,6 +13,14 @@
 
 namespace net {
 
+namespace {
+
+// Bodies up to this size are copied after the headers, so that the whole
+// response goes out in one send() rather than two.
+const size_t kMaxCopiedBodySize = 16 * 1024;
+
+}  // namespace
+
 int HttpConnection::last_id_ = 0;
 
 void HttpConnection::Send(const std::string& data) {
@@ -29,9 +39,24 @@ void HttpConnection::Send(const HttpServerResponseInfo& response) {
   Send(response.Serialize());
 }
 
+void HttpConnection::Send(const HttpServerResponseInfo& response,
+                          const base::RefCountedMemory& body) {
+  std::string headers = response.SerializeHeaders();
+  const char* data = reinterpret_cast<const char*>(body.front());
+  if (body.size() <= kMaxCopiedBodySize) {
+    headers.append(data, body.size());
+    Send(headers);
+    return;
+  }
+  Send(headers);
+  Send(data, static_cast<int>(body.size()));
+}
+
 HttpConnection::HttpConnection(HttpServer* server, StreamListenSocket* sock)
     : server_(server),
-      socket_(sock) {
+      socket_(sock),
+      request_body_length_(0),
+      waiting_for_response_(false) {
   id_ = last_id_++;
 }
 
@@ -45,7 +70,7 @@ void HttpConnection::DetachSocket() {
 }
 
 void HttpConnection::Shift(int num_bytes) {
-  recv_data_ = recv_data_.substr(num_bytes);
+  recv_data_.erase(0, num_bytes);
 }
 
 }  // namespace net
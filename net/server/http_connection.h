@@ -5,15 +5,22 @@
 #ifndef NET_SERVER_HTTP_CONNECTION_H_
 #define NET_SERVER_HTTP_CONNECTION_H_
 
+#include <queue>
 #include <string>
 
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "net/http/http_status_code.h"
+#include "net/server/http_server_request_info.h"
+
+namespace base {
+class RefCountedMemory;
+}
 
 namespace net {
 
+class HttpChunkedDecoder;
 class HttpServer;
 class HttpServerResponseInfo;
 class StreamListenSocket;
@@ -26,6 +33,10 @@ class HttpConnection {
   void Send(const std::string& data);
   void Send(const char* bytes, int len);
   void Send(const HttpServerResponseInfo& response);
+  // Sends |response|, whose body is |body|. Large bodies are sent from |body|
+  // directly rather than copied after the headers.
+  void Send(const HttpServerResponseInfo& response,
+            const base::RefCountedMemory& body);
 
   void Shift(int num_bytes);
 
@@ -45,6 +56,22 @@ class HttpConnection {
   scoped_ptr<WebSocket> web_socket_;
   std::string recv_data_;
   int id_;
+
+  // The request whose headers have been parsed but whose body has not been
+  // received in full yet, if any.
+  scoped_ptr<HttpServerRequestInfo> request_;
+  // The length of the body of |request_|, if it is not chunked.
+  size_t request_body_length_;
+  // Decodes the body of |request_|, if it is chunked.
+  scoped_ptr<HttpChunkedDecoder> chunked_decoder_;
+
+  // Only used when the server hands requests to a handler task runner. The
+  // requests received that have not been handed to the delegate yet, and
+  // whether the delegate is handling one and the server is waiting for its
+  // response.
+  std::queue<HttpServerRequestInfo> pending_requests_;
+  bool waiting_for_response_;
+
   DISALLOW_COPY_AND_ASSIGN(HttpConnection);
 };
 
@@ -4,15 +4,22 @@
 
 #include "net/server/http_server.h"
 
+#include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/message_loop/message_loop_proxy.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/sys_byteorder.h"
+#include "base/task_runner.h"
 #include "build/build_config.h"
 #include "net/base/net_errors.h"
+#include "net/http/http_chunked_decoder.h"
+#include "net/http/http_util.h"
 #include "net/server/http_connection.h"
 #include "net/server/http_server_request_info.h"
 #include "net/server/http_server_response_info.h"
@@ -21,9 +28,29 @@
 
 namespace net {
 
+namespace {
+
+const char kContentLength[] = "content-length";
+
+// The largest request body accepted.
+const size_t kMaxBodySize = 100 << 20;
+
+}  // namespace
+
 HttpServer::HttpServer(const StreamListenSocketFactory& factory,
                        HttpServer::Delegate* delegate)
     : delegate_(delegate),
+      message_loop_proxy_(base::MessageLoopProxy::current()),
+      server_(factory.CreateAndListen(this)) {
+}
+
+HttpServer::HttpServer(
+    const StreamListenSocketFactory& factory,
+    HttpServer::Delegate* delegate,
+    const scoped_refptr<base::TaskRunner>& handler_task_runner)
+    : delegate_(delegate),
+      handler_task_runner_(handler_task_runner),
+      message_loop_proxy_(base::MessageLoopProxy::current()),
       server_(factory.CreateAndListen(this)) {
 }
 
@@ -49,10 +76,18 @@ void HttpServer::SendOverWebSocket(int connection_id,
 
 void HttpServer::SendResponse(int connection_id,
                               const HttpServerResponseInfo& response) {
+  if (!message_loop_proxy_->BelongsToCurrentThread()) {
+    message_loop_proxy_->PostTask(
+        FROM_HERE,
+        base::Bind(&HttpServer::SendResponse, this, connection_id, response));
+    return;
+  }
+
   HttpConnection* connection = FindConnection(connection_id);
   if (connection == NULL)
     return;
   connection->Send(response);
+  DidSendResponse(connection);
 }
 
 void HttpServer::Send(int connection_id,
@@ -64,6 +99,27 @@ void HttpServer::Send(int connection_id,
   SendResponse(connection_id, response);
 }
 
+void HttpServer::SendMemory(int connection_id,
+                            HttpStatusCode status_code,
+                            const scoped_refptr<base::RefCountedMemory>& data,
+                            const std::string& content_type) {
+  if (!message_loop_proxy_->BelongsToCurrentThread()) {
+    message_loop_proxy_->PostTask(
+        FROM_HERE,
+        base::Bind(&HttpServer::SendMemory, this, connection_id, status_code,
+                   data, content_type));
+    return;
+  }
+
+  HttpConnection* connection = FindConnection(connection_id);
+  if (connection == NULL)
+    return;
+  HttpServerResponseInfo response(status_code);
+  response.SetContentHeaders(data->size(), content_type);
+  connection->Send(response, *data.get());
+  DidSendResponse(connection);
+}
+
 void HttpServer::Send200(int connection_id,
                          const std::string& data,
                          const std::string& content_type) {
@@ -79,6 +135,12 @@ void HttpServer::Send500(int connection_id, const std::string& message) {
 }
 
 void HttpServer::Close(int connection_id) {
+  if (!message_loop_proxy_->BelongsToCurrentThread()) {
+    message_loop_proxy_->PostTask(
+        FROM_HERE, base::Bind(&HttpServer::Close, this, connection_id));
+    return;
+  }
+
   HttpConnection* connection = FindConnection(connection_id);
   if (connection == NULL)
     return;
@@ -126,46 +188,69 @@ void HttpServer::DidRead(StreamListenSocket* socket,
       continue;
     }
 
-    HttpServerRequestInfo request;
-    size_t pos = 0;
-    if (!ParseHeaders(connection, &request, &pos))
-      break;
-
-    std::string connection_header = request.GetHeaderValue("connection");
-    if (connection_header == "Upgrade") {
-      connection->web_socket_.reset(WebSocket::CreateWebSocket(connection,
-                                                               request,
-                                                               &pos));
-
-      if (!connection->web_socket_.get())  // Not enough data was received.
+    if (!connection->request_.get()) {
+      // The headers are parsed from the start every time, so wait for all of
+      // them to arrive first.
+      if (HttpUtil::LocateEndOfHeaders(
+              connection->recv_data_.data(),
+              static_cast<int>(connection->recv_data_.length()), 0) == -1) {
         break;
-      delegate_->OnWebSocketRequest(connection->id(), request);
-      connection->Shift(pos);
-      continue;
-    }
+      }
 
-    const char kContentLength[] = "content-length";
-    if (request.headers.count(kContentLength)) {
-      size_t content_length = 0;
-      const size_t kMaxBodySize = 100 << 20;
-      if (!base::StringToSizeT(request.GetHeaderValue(kContentLength),
-                               &content_length) ||
-          content_length > kMaxBodySize) {
-        connection->Send(HttpServerResponseInfo::CreateFor500(
-            "request content-length too big or unknown: " +
-            request.GetHeaderValue(kContentLength)));
-        DidClose(socket);
+      scoped_ptr<HttpServerRequestInfo> request(new HttpServerRequestInfo);
+      size_t pos = 0;
+      if (!ParseHeaders(connection, request.get(), &pos))
         break;
+
+      std::string connection_header = request->GetHeaderValue("connection");
+      if (connection_header == "Upgrade") {
+        connection->web_socket_.reset(WebSocket::CreateWebSocket(connection,
+                                                                 *request,
+                                                                 &pos));
+
+        if (!connection->web_socket_.get())  // Not enough data was received.
+          break;
+        delegate_->OnWebSocketRequest(connection->id(), *request);
+        connection->Shift(pos);
+        continue;
+      }
+
+      connection->request_body_length_ = 0;
+      if (LowerCaseEqualsASCII(request->GetHeaderValue("transfer-encoding"),
+                               "chunked")) {
+        connection->chunked_decoder_.reset(new HttpChunkedDecoder);
+      } else if (request->headers.count(kContentLength)) {
+        size_t content_length = 0;
+        if (!base::StringToSizeT(request->GetHeaderValue(kContentLength),
+                                 &content_length) ||
+            content_length > kMaxBodySize) {
+          connection->Send(HttpServerResponseInfo::CreateFor500(
+              "request content-length too big or unknown: " +
+              request->GetHeaderValue(kContentLength)));
+          DidClose(socket);
+          break;
+        }
+        connection->request_body_length_ = content_length;
       }
+      connection->Shift(pos);
+      connection->request_.reset(request.release());
+    }
 
-      if (connection->recv_data_.length() - pos < content_length)
-        break;  // Not enough data was received yet.
-      request.data = connection->recv_data_.substr(pos, content_length);
-      pos += content_length;
+    int rv = ReadRequestBody(connection);
+    if (rv == ERR_IO_PENDING)
+      break;  // Not enough data was received yet.
+    if (rv != OK) {
+      connection->Send(HttpServerResponseInfo::CreateFor500(
+          std::string("invalid request body: ") + ErrorToString(rv)));
+      DidClose(socket);
+      break;
     }
 
-    delegate_->OnHttpRequest(connection->id(), request);
-    connection->Shift(pos);
+    scoped_ptr<HttpServerRequestInfo> request(connection->request_.release());
+    DispatchRequest(connection, *request);
+    // The delegate may have closed the connection.
+    if (!FindConnection(socket))
+      break;
   }
 }
 
@@ -178,11 +263,23 @@ void HttpServer::DidClose(StreamListenSocket* socket) {
 }
 
 HttpServer::~HttpServer() {
+  DCHECK(message_loop_proxy_->BelongsToCurrentThread());
   STLDeleteContainerPairSecondPointers(
       id_to_connection_.begin(), id_to_connection_.end());
   server_ = NULL;
 }
 
+void HttpServer::OnDestruct() const {
+  // The last reference may be released on the handler task runner, or by a
+  // thread sending a response, but the sockets belong to the server's thread.
+  if (message_loop_proxy_->BelongsToCurrentThread()) {
+    delete this;
+  } else if (!message_loop_proxy_->DeleteSoon(FROM_HERE, this)) {
+    // The server's thread is gone, and with it the sockets' loop.
+    DLOG(WARNING) << "HttpServer leaking due to no owning thread.";
+  }
+}
+
 //
 // HTTP Request Parser
 // This HTTP request parser uses a simple state machine to quickly parse
@@ -313,6 +410,76 @@ bool HttpServer::ParseHeaders(HttpConnection* connection,
   return false;
 }
 
+int HttpServer::ReadRequestBody(HttpConnection* connection) {
+  HttpServerRequestInfo* request = connection->request_.get();
+  std::string& recv_data = connection->recv_data_;
+
+  if (!connection->chunked_decoder_.get()) {
+    size_t length = connection->request_body_length_;
+    if (recv_data.length() < length)
+      return ERR_IO_PENDING;
+    request->data = recv_data.substr(0, length);
+    connection->Shift(length);
+    return OK;
+  }
+
+  // Decode the chunks received so far in place, and keep anything after the
+  // end of the body, which belongs to the next request.
+  if (recv_data.empty())
+    return ERR_IO_PENDING;
+  HttpChunkedDecoder* decoder = connection->chunked_decoder_.get();
+  int rv = decoder->FilterBuf(&recv_data[0],
+                              static_cast<int>(recv_data.length()));
+  if (rv < 0)
+    return rv;
+  if (request->data.length() + rv > kMaxBodySize)
+    return ERR_MSG_TOO_BIG;
+  request->data.append(recv_data.data(), rv);
+  if (!decoder->reached_eof()) {
+    recv_data.clear();
+    return ERR_IO_PENDING;
+  }
+  recv_data.erase(0, rv);
+  recv_data.resize(decoder->bytes_after_eof());
+  connection->chunked_decoder_.reset();
+  return OK;
+}
+
+void HttpServer::DispatchRequest(HttpConnection* connection,
+                                 const HttpServerRequestInfo& request) {
+  if (!handler_task_runner_.get()) {
+    delegate_->OnHttpRequest(connection->id(), request);
+    return;
+  }
+  connection->pending_requests_.push(request);
+  DispatchNextPendingRequest(connection);
+}
+
+void HttpServer::DispatchNextPendingRequest(HttpConnection* connection) {
+  if (connection->waiting_for_response_ ||
+      connection->pending_requests_.empty()) {
+    return;
+  }
+  connection->waiting_for_response_ = true;
+  handler_task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&HttpServer::HandleRequest, this, connection->id(),
+                 connection->pending_requests_.front()));
+  connection->pending_requests_.pop();
+}
+
+void HttpServer::HandleRequest(int connection_id,
+                               const HttpServerRequestInfo& request) {
+  delegate_->OnHttpRequest(connection_id, request);
+}
+
+void HttpServer::DidSendResponse(HttpConnection* connection) {
+  if (!handler_task_runner_.get() || !connection->waiting_for_response_)
+    return;
+  connection->waiting_for_response_ = false;
+  DispatchNextPendingRequest(connection);
+}
+
 HttpConnection* HttpServer::FindConnection(int connection_id) {
   IdToConnectionMap::iterator it = id_to_connection_.find(connection_id);
   if (it == id_to_connection_.end())
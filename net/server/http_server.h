@@ -10,9 +10,16 @@
 
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner_helpers.h"
 #include "net/http/http_status_code.h"
 #include "net/socket/stream_listen_socket.h"
 
+namespace base {
+class MessageLoopProxy;
+class RefCountedMemory;
+class TaskRunner;
+}
+
 namespace net {
 
 class HttpConnection;
@@ -20,10 +27,20 @@ class HttpServerRequestInfo;
 class HttpServerResponseInfo;
 class IPEndPoint;
 class WebSocket;
+struct HttpServerTraits;
 
+// A simple HTTP server, which runs on the thread it is created on. That thread
+// must have a MessageLoopForIO. The server is always destroyed on that thread,
+// whichever thread releases the last reference to it.
 class HttpServer : public StreamListenSocket::Delegate,
-                   public base::RefCountedThreadSafe<HttpServer> {
+                   public base::RefCountedThreadSafe<HttpServer,
+                                                     HttpServerTraits> {
  public:
+  // The delegate is called on the thread the server runs on, except for
+  // OnHttpRequest() when the server has a handler task runner. It must
+  // outlive the server. With a handler task runner, the tasks calling
+  // OnHttpRequest() hold references to the server, so that it may outlive
+  // the last reference its owner releases until they have run.
   class Delegate {
    public:
     virtual void OnHttpRequest(int connection_id,
@@ -44,6 +61,19 @@ class HttpServer : public StreamListenSocket::Delegate,
   HttpServer(const StreamListenSocketFactory& socket_factory,
              HttpServer::Delegate* delegate);
 
+  // Like the above, but calls the delegate's OnHttpRequest() on
+  // |handler_task_runner|, e.g. a base::SequencedWorkerPool, rather than on
+  // the thread the server runs on, so that slow handlers do not hold up the
+  // other connections. The requests pipelined on a connection are handed to
+  // the delegate one at a time, each once the previous one has been answered,
+  // so that the responses go out in order: every request must be answered
+  // with one of the Send methods, or its connection closed.
+  HttpServer(const StreamListenSocketFactory& socket_factory,
+             HttpServer::Delegate* delegate,
+             const scoped_refptr<base::TaskRunner>& handler_task_runner);
+
+  // The methods which send responses and Close() may be called on any thread.
+
   void AcceptWebSocket(int connection_id,
                        const HttpServerRequestInfo& request);
   void SendOverWebSocket(int connection_id, const std::string& data);
@@ -52,6 +82,11 @@ class HttpServer : public StreamListenSocket::Delegate,
             HttpStatusCode status_code,
             const std::string& data,
             const std::string& mime_type);
+  // Sends a response whose body is |data|, without copying it if it is large.
+  void SendMemory(int connection_id,
+                  HttpStatusCode status_code,
+                  const scoped_refptr<base::RefCountedMemory>& data,
+                  const std::string& mime_type);
   void Send200(int connection_id,
                const std::string& data,
                const std::string& mime_type);
@@ -75,9 +110,14 @@ class HttpServer : public StreamListenSocket::Delegate,
   virtual ~HttpServer();
 
  private:
-  friend class base::RefCountedThreadSafe<HttpServer>;
+  friend class base::RefCountedThreadSafe<HttpServer, HttpServerTraits>;
+  friend class base::DeleteHelper<HttpServer>;
+  friend struct HttpServerTraits;
   friend class HttpConnection;
 
+  // Deletes the server on |message_loop_proxy_|.
+  void OnDestruct() const;
+
   // Expects the raw data to be stored in recv_data_. If parsing is successful,
   // will remove the data parsed from recv_data_, leaving only the unused
   // recv data.
@@ -85,10 +125,28 @@ class HttpServer : public StreamListenSocket::Delegate,
                     HttpServerRequestInfo* info,
                     size_t* pos);
 
+  // Reads the body of the request of |connection| whose headers have been
+  // parsed from the data received. Returns OK once it has been read in full,
+  // ERR_IO_PENDING if more data is needed, or another network error if it is
+  // invalid or too large.
+  int ReadRequestBody(HttpConnection* connection);
+
+  // Hands |request| to the delegate, directly or on |handler_task_runner_|.
+  void DispatchRequest(HttpConnection* connection,
+                       const HttpServerRequestInfo& request);
+  void DispatchNextPendingRequest(HttpConnection* connection);
+  void HandleRequest(int connection_id, const HttpServerRequestInfo& request);
+
+  // Called once a response has been sent on |connection|.
+  void DidSendResponse(HttpConnection* connection);
+
   HttpConnection* FindConnection(int connection_id);
   HttpConnection* FindConnection(StreamListenSocket* socket);
 
   HttpServer::Delegate* delegate_;
+  scoped_refptr<base::TaskRunner> handler_task_runner_;
+  // The loop the server runs on.
+  scoped_refptr<base::MessageLoopProxy> message_loop_proxy_;
   scoped_refptr<StreamListenSocket> server_;
   typedef std::map<int, HttpConnection*> IdToConnectionMap;
   IdToConnectionMap id_to_connection_;
@@ -98,6 +156,12 @@ class HttpServer : public StreamListenSocket::Delegate,
   DISALLOW_COPY_AND_ASSIGN(HttpServer);
 };
 
+struct HttpServerTraits {
+  static void Destruct(const HttpServer* server) {
+    server->OnDestruct();
+  }
+};
+
 }  // namespace net
 
 #endif // NET_SERVER_HTTP_SERVER_H_
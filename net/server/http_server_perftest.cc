@@ -0,0 +1,249 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/server/http_server.h"
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/compiler_specific.h"
+#include "base/location.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/perftimer.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "base/threading/thread.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/server/http_server_request_info.h"
+#include "net/server/http_server_response_info.h"
+#include "net/socket/tcp_client_socket.h"
+#include "net/socket/tcp_listen_socket.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumConnections = 8;
+const int kNumRequestsPerConnection = 2000;
+const int kNumHandlerThreads = 4;
+
+// Answers every request with the same body.
+class PerfDelegate : public HttpServer::Delegate {
+ public:
+  explicit PerfDelegate(const scoped_refptr<base::RefCountedMemory>& body)
+      : server_(NULL),
+        body_(body) {}
+
+  void set_server(HttpServer* server) { server_ = server; }
+
+  virtual void OnHttpRequest(int connection_id,
+                             const HttpServerRequestInfo& info) OVERRIDE {
+    server_->SendMemory(connection_id, HTTP_OK, body_, "text/plain");
+  }
+  virtual void OnWebSocketRequest(int connection_id,
+                                  const HttpServerRequestInfo& info) OVERRIDE {}
+  virtual void OnWebSocketMessage(int connection_id,
+                                  const std::string& data) OVERRIDE {}
+  virtual void OnClose(int connection_id) OVERRIDE {}
+
+ private:
+  HttpServer* server_;
+  scoped_refptr<base::RefCountedMemory> body_;
+};
+
+// Sends requests on one keep-alive connection, |pipeline_depth| at a time,
+// and reads their responses, until it has sent |num_requests|.
+class LoadClient {
+ public:
+  LoadClient(const IPEndPoint& address,
+             int num_requests,
+             int pipeline_depth,
+             size_t response_size,
+             const base::Closure& done_callback)
+      : address_(address),
+        num_requests_left_(num_requests),
+        pipeline_depth_(pipeline_depth),
+        response_size_(response_size),
+        bytes_to_read_(0),
+        done_callback_(done_callback),
+        read_buffer_(new IOBufferWithSize(64 * 1024)) {
+    for (int i = 0; i < pipeline_depth_; ++i)
+      requests_ += "GET /test HTTP/1.1\r\n\r\n";
+  }
+
+  void Start() {
+    socket_.reset(new TCPClientSocket(AddressList(address_), NULL,
+                                      NetLog::Source()));
+    int rv = socket_->Connect(
+        base::Bind(&LoadClient::OnConnect, base::Unretained(this)));
+    if (rv != ERR_IO_PENDING)
+      OnConnect(rv);
+  }
+
+ private:
+  void OnConnect(int result) {
+    ASSERT_EQ(OK, result);
+    SendRequests();
+  }
+
+  void SendRequests() {
+    if (num_requests_left_ == 0) {
+      socket_.reset();
+      done_callback_.Run();
+      return;
+    }
+    num_requests_left_ -= pipeline_depth_;
+    bytes_to_read_ = static_cast<int>(response_size_ * pipeline_depth_);
+    write_buffer_ = new DrainableIOBuffer(new StringIOBuffer(requests_),
+                                          requests_.length());
+    Write();
+  }
+
+  void Write() {
+    while (write_buffer_->BytesRemaining()) {
+      int rv = socket_->Write(
+          write_buffer_.get(), write_buffer_->BytesRemaining(),
+          base::Bind(&LoadClient::OnWrite, base::Unretained(this)));
+      if (rv == ERR_IO_PENDING)
+        return;
+      ASSERT_GT(rv, 0);
+      write_buffer_->DidConsume(rv);
+    }
+    Read();
+  }
+
+  void OnWrite(int result) {
+    ASSERT_GT(result, 0);
+    write_buffer_->DidConsume(result);
+    Write();
+  }
+
+  void Read() {
+    while (bytes_to_read_ > 0) {
+      int rv = socket_->Read(
+          read_buffer_.get(), read_buffer_->size(),
+          base::Bind(&LoadClient::OnRead, base::Unretained(this)));
+      if (rv == ERR_IO_PENDING)
+        return;
+      ASSERT_GT(rv, 0);
+      bytes_to_read_ -= rv;
+    }
+    SendRequests();
+  }
+
+  void OnRead(int result) {
+    ASSERT_GT(result, 0);
+    bytes_to_read_ -= result;
+    Read();
+  }
+
+  const IPEndPoint address_;
+  int num_requests_left_;
+  const int pipeline_depth_;
+  const size_t response_size_;
+  std::string requests_;
+  int bytes_to_read_;
+  base::Closure done_callback_;
+  scoped_ptr<TCPClientSocket> socket_;
+  scoped_refptr<DrainableIOBuffer> write_buffer_;
+  scoped_refptr<IOBufferWithSize> read_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClient);
+};
+
+void StartClients(ScopedVector<LoadClient>* clients) {
+  for (size_t i = 0; i < clients->size(); ++i)
+    (*clients)[i]->Start();
+}
+
+void OnClientDone(int* clients_left,
+                  scoped_refptr<base::MessageLoopProxy> server_loop,
+                  const base::Closure& quit_closure) {
+  if (--*clients_left == 0)
+    server_loop->PostTask(FROM_HERE, quit_closure);
+}
+
+// Runs kNumConnections clients against a server answering with |body_size|
+// byte bodies, on |handler_task_runner| if it is not NULL, and logs the
+// requests/s as |name|.
+void RunLoadTest(const std::string& name,
+                 size_t body_size,
+                 int pipeline_depth,
+                 const scoped_refptr<base::TaskRunner>& handler_task_runner) {
+  std::string body(body_size, 'x');
+  HttpServerResponseInfo response(HTTP_OK);
+  response.SetBody(body, "text/plain");
+  const size_t response_size = response.Serialize().length();
+
+  PerfDelegate delegate(base::RefCountedString::TakeString(&body));
+  TCPListenSocketFactory socket_factory("127.0.0.1", 0);
+  scoped_refptr<HttpServer> server(
+      handler_task_runner.get() ?
+          new HttpServer(socket_factory, &delegate, handler_task_runner) :
+          new HttpServer(socket_factory, &delegate));
+  delegate.set_server(server.get());
+  IPEndPoint address;
+  ASSERT_EQ(OK, server->GetLocalAddress(&address));
+
+  // The clients run on their own thread, as the server blocks while sending
+  // responses that do not fit in the socket buffers.
+  base::Thread client_thread("LoadClients");
+  ASSERT_TRUE(client_thread.StartWithOptions(
+      base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
+
+  base::RunLoop run_loop;
+  int clients_left = kNumConnections;
+  ScopedVector<LoadClient> clients;
+  for (int i = 0; i < kNumConnections; ++i) {
+    clients.push_back(new LoadClient(
+        address, kNumRequestsPerConnection, pipeline_depth, response_size,
+        base::Bind(&OnClientDone, &clients_left,
+                   base::MessageLoopProxy::current(),
+                   run_loop.QuitClosure())));
+  }
+
+  PerfTimer timer;
+  client_thread.message_loop_proxy()->PostTask(
+      FROM_HERE, base::Bind(&StartClients, &clients));
+  run_loop.Run();
+  double seconds = timer.Elapsed().InSecondsF();
+  client_thread.Stop();
+
+  LogPerfResult(name.c_str(),
+                kNumConnections * kNumRequestsPerConnection / seconds,
+                "requests/s");
+}
+
+}  // namespace
+
+// Measures how many requests/s HttpServer answers over keep-alive
+// connections, with and without pipelining, with the delegate on the server
+// thread or on a pool of handler threads, and with small and large bodies.
+TEST(HttpServerPerfTest, Requests) {
+  base::MessageLoopForIO message_loop;
+  RunLoadTest("http_server_small_body", 100, 1, NULL);
+  RunLoadTest("http_server_small_body_pipelined", 100, 16, NULL);
+  RunLoadTest("http_server_large_body", 64 * 1024, 1, NULL);
+
+  scoped_refptr<base::SequencedWorkerPool> pool(
+      new base::SequencedWorkerPool(kNumHandlerThreads, "HttpServerHandler"));
+  RunLoadTest("http_server_small_body_handler_pool", 100, 1, pool);
+  RunLoadTest("http_server_small_body_pipelined_handler_pool", 100, 16, pool);
+  pool->Shutdown();
+}
+
+}  // namespace net
@@ -29,7 +29,7 @@ class HttpServerRequestInfo {
   // Request line.
   std::string path;
 
-  // Request data.
+  // Request data, with any chunked transfer coding removed.
   std::string data;
 
   // A map of the names -> values for HTTP headers. These should always
@@ -41,19 +41,29 @@ void HttpServerResponseInfo::SetBody(const std::string& body,
                                      const std::string& content_type) {
   DCHECK(body_.empty());
   body_ = body;
+  SetContentHeaders(body.length(), content_type);
+}
+
+void HttpServerResponseInfo::SetContentHeaders(
+    size_t content_length,
+    const std::string& content_type) {
   AddHeader(HttpRequestHeaders::kContentLength,
-            base::StringPrintf("%" PRIuS, body.length()));
+            base::StringPrintf("%" PRIuS, content_length));
   AddHeader(HttpRequestHeaders::kContentType, content_type);
 }
 
 std::string HttpServerResponseInfo::Serialize() const {
+  return SerializeHeaders() + body_;
+}
+
+std::string HttpServerResponseInfo::SerializeHeaders() const {
   std::string response = base::StringPrintf(
       "HTTP/1.1 %d %s\r\n", status_code_, GetHttpReasonPhrase(status_code_));
   Headers::const_iterator header;
   for (header = headers_.begin(); header != headers_.end(); ++header)
     response += header->first + ":" + header->second + "\r\n";
 
-  return response + "\r\n" + body_;
+  return response + "\r\n";
 }
 
 HttpStatusCode HttpServerResponseInfo::status_code() const {
@@ -28,8 +28,16 @@ class HttpServerResponseInfo {
   // This also adds an appropriate Content-Length header.
   void SetBody(const std::string& body, const std::string& content_type);
 
+  // Adds the Content-Length and Content-Type headers for a body which is sent
+  // separately from this response.
+  void SetContentHeaders(size_t content_length,
+                         const std::string& content_type);
+
   std::string Serialize() const;
 
+  // Returns the status line and the headers, without the body.
+  std::string SerializeHeaders() const;
+
   HttpStatusCode status_code() const;
   const std::string& body() const;
 
@@ -31,6 +31,16 @@ TEST(HttpServerResponseInfoTest, Body) {
       response.Serialize());
 }
 
+TEST(HttpServerResponseInfoTest, ContentHeaders) {
+  HttpServerResponseInfo response;
+  response.SetContentHeaders(4, "type");
+  ASSERT_EQ(std::string(), response.body());
+  ASSERT_EQ(
+      "HTTP/1.1 200 OK\r\nContent-Length:4\r\nContent-Type:type\r\n\r\n",
+      response.SerializeHeaders());
+  ASSERT_EQ(response.SerializeHeaders(), response.Serialize());
+}
+
 TEST(HttpServerResponseInfoTest, CreateFor404) {
   HttpServerResponseInfo response = HttpServerResponseInfo::CreateFor404();
   ASSERT_EQ(
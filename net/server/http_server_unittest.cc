@@ -9,6 +9,7 @@
 #include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
@@ -17,14 +18,17 @@
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
 #include "base/time/time.h"
 #include "net/base/address_list.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
 #include "net/server/http_server.h"
 #include "net/server/http_server_request_info.h"
+#include "net/server/http_server_response_info.h"
 #include "net/socket/tcp_client_socket.h"
 #include "net/socket/tcp_listen_socket.h"
 #include "net/url_request/url_fetcher.h"
@@ -86,6 +90,22 @@ class TestHttpClient {
     Write();
   }
 
+  // Reads until |message| holds |num_bytes| bytes. Returns false if the
+  // connection is closed or fails before that.
+  bool Read(std::string* message, size_t num_bytes) {
+    while (message->length() < num_bytes) {
+      scoped_refptr<IOBufferWithSize> read_buffer(new IOBufferWithSize(4096));
+      TestCompletionCallback callback;
+      int rv = socket_->Read(read_buffer.get(), read_buffer->size(),
+                             callback.callback());
+      rv = callback.GetResult(rv);
+      if (rv <= 0)
+        return false;
+      message->append(read_buffer->data(), rv);
+    }
+    return true;
+  }
+
  private:
   void OnConnect(const base::Closure& quit_loop, int result) {
     connect_result_ = result;
@@ -129,6 +149,7 @@ class HttpServerTest : public testing::Test,
   virtual void OnHttpRequest(int connection_id,
                              const HttpServerRequestInfo& info) OVERRIDE {
     requests_.push_back(info);
+    connection_ids_.push_back(connection_id);
     if (requests_.size() == quit_after_request_count_)
       run_loop_quit_func_.Run();
   }
@@ -162,6 +183,7 @@ class HttpServerTest : public testing::Test,
   IPEndPoint server_address_;
   base::Closure run_loop_quit_func_;
   std::vector<HttpServerRequestInfo> requests_;
+  std::vector<int> connection_ids_;
 
  private:
   size_t quit_after_request_count_;
@@ -293,6 +315,171 @@ TEST_F(HttpServerTest, RequestWithBodySplitAcrossPackets) {
   ASSERT_EQ(body, requests_[0].data);
 }
 
+TEST_F(HttpServerTest, PipelinedRequests) {
+  scoped_refptr<StreamListenSocket> socket(
+      new MockStreamListenSocket(server_.get()));
+  server_->DidAccept(NULL, socket.get());
+  std::string requests =
+      "GET /test1 HTTP/1.1\r\n\r\n"
+      "POST /test2 HTTP/1.1\r\n"
+      "Content-Length: 4\r\n\r\nbody"
+      "GET /test3 HTTP/1.1\r\n\r\n";
+  server_->DidRead(socket.get(), requests.c_str(), requests.length());
+  ASSERT_EQ(3u, requests_.size());
+  ASSERT_EQ("/test1", requests_[0].path);
+  ASSERT_EQ("/test2", requests_[1].path);
+  ASSERT_EQ("body", requests_[1].data);
+  ASSERT_EQ("/test3", requests_[2].path);
+  ASSERT_EQ("", requests_[2].data);
+}
+
+TEST_F(HttpServerTest, ChunkedRequestBody) {
+  scoped_refptr<StreamListenSocket> socket(
+      new MockStreamListenSocket(server_.get()));
+  server_->DidAccept(NULL, socket.get());
+  std::string requests =
+      "POST /test1 HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n\r\n"
+      "4\r\nbody\r\n"
+      "b;ext=1\r\n split body\r\n"
+      "0\r\n\r\n"
+      "GET /test2 HTTP/1.1\r\n\r\n";
+  // Deliver the requests one byte at a time, so that the chunk markers are
+  // split in every possible way.
+  for (size_t i = 0; i < requests.length(); ++i)
+    server_->DidRead(socket.get(), requests.c_str() + i, 1);
+  ASSERT_EQ(2u, requests_.size());
+  ASSERT_EQ("/test1", requests_[0].path);
+  ASSERT_EQ("body split body", requests_[0].data);
+  ASSERT_EQ("/test2", requests_[1].path);
+  ASSERT_EQ("", requests_[1].data);
+}
+
+TEST_F(HttpServerTest, SendMemory) {
+  TestHttpClient client;
+  ASSERT_EQ(OK, client.ConnectAndWait(server_address_));
+  client.Send("GET /test HTTP/1.1\r\n\r\n");
+  ASSERT_TRUE(RunUntilRequestsReceived(1));
+
+  // Send both a body which is copied after the headers and one which is not.
+  const size_t kBodySizes[] = { 4, 100 * 1024 };
+  std::string expected;
+  for (size_t i = 0; i < arraysize(kBodySizes); ++i) {
+    std::string body(kBodySizes[i], 'a' + i);
+    HttpServerResponseInfo response(HTTP_OK);
+    response.SetBody(body, "text/plain");
+    expected += response.Serialize();
+    server_->SendMemory(connection_ids_[0], HTTP_OK,
+                        base::RefCountedString::TakeString(&body),
+                        "text/plain");
+  }
+
+  std::string received;
+  ASSERT_TRUE(client.Read(&received, expected.length()));
+  ASSERT_EQ(expected, received);
+}
+
+namespace {
+
+// Answers every request on the thread it is handed to, with its path.
+class EchoDelegate : public HttpServer::Delegate {
+ public:
+  EchoDelegate() : server_(NULL) {}
+
+  void set_server(HttpServer* server) { server_ = server; }
+
+  virtual void OnHttpRequest(int connection_id,
+                             const HttpServerRequestInfo& info) OVERRIDE {
+    server_->Send200(connection_id, info.path, "text/plain");
+  }
+  virtual void OnWebSocketRequest(int connection_id,
+                                  const HttpServerRequestInfo& info) OVERRIDE {
+    NOTREACHED();
+  }
+  virtual void OnWebSocketMessage(int connection_id,
+                                  const std::string& data) OVERRIDE {
+    NOTREACHED();
+  }
+  virtual void OnClose(int connection_id) OVERRIDE {}
+
+ private:
+  HttpServer* server_;
+};
+
+}  // namespace
+
+TEST_F(HttpServerTest, PipelinedRequestsOnHandlerThread) {
+  base::Thread handler_thread("HttpServerHandler");
+  ASSERT_TRUE(handler_thread.Start());
+  EchoDelegate delegate;
+  TCPListenSocketFactory socket_factory("127.0.0.1", 0);
+  scoped_refptr<HttpServer> server(new HttpServer(
+      socket_factory, &delegate, handler_thread.message_loop_proxy()));
+  delegate.set_server(server.get());
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server->GetLocalAddress(&server_address));
+
+  TestHttpClient client;
+  ASSERT_EQ(OK, client.ConnectAndWait(server_address));
+  std::string requests;
+  std::string expected;
+  for (int i = 0; i < 10; ++i) {
+    std::string path = base::StringPrintf("/test%d", i);
+    requests += "GET " + path + " HTTP/1.1\r\n\r\n";
+    HttpServerResponseInfo response(HTTP_OK);
+    response.SetBody(path, "text/plain");
+    expected += response.Serialize();
+  }
+  client.Send(requests);
+
+  std::string received;
+  ASSERT_TRUE(client.Read(&received, expected.length()));
+  ASSERT_EQ(expected, received);
+  handler_thread.Stop();
+}
+
+namespace {
+
+// Records the loop it is destroyed on.
+class DestructionLoopHttpServer : public HttpServer {
+ public:
+  DestructionLoopHttpServer(const StreamListenSocketFactory& socket_factory,
+                            HttpServer::Delegate* delegate,
+                            base::MessageLoop** destruction_loop)
+      : HttpServer(socket_factory, delegate),
+        destruction_loop_(destruction_loop) {}
+
+ private:
+  virtual ~DestructionLoopHttpServer() {
+    *destruction_loop_ = base::MessageLoop::current();
+  }
+
+  base::MessageLoop** destruction_loop_;
+};
+
+}  // namespace
+
+TEST_F(HttpServerTest, DestroyedOnServerThread) {
+  base::Thread other_thread("HttpServerRelease");
+  ASSERT_TRUE(other_thread.Start());
+  base::MessageLoop* destruction_loop = NULL;
+  TCPListenSocketFactory socket_factory("127.0.0.1", 0);
+  scoped_refptr<HttpServer> server(
+      new DestructionLoopHttpServer(socket_factory, this, &destruction_loop));
+
+  // The last reference is released on |other_thread|, as it would be by a
+  // handler task.
+  HttpServer* raw_server = server.get();
+  raw_server->AddRef();
+  server = NULL;
+  other_thread.message_loop_proxy()->ReleaseSoon(FROM_HERE, raw_server);
+  other_thread.Stop();
+  EXPECT_TRUE(destruction_loop == NULL);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(base::MessageLoop::current(), destruction_loop);
+}
+
 TEST_F(HttpServerTest, MultipleRequestsOnSameConnection) {
   // The idea behind this test is that requests with or without bodies should
   // not break parsing of the next request.
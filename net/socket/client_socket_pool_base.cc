@@ -4,6 +4,8 @@
 
 #include "net/socket/client_socket_pool_base.h"
 
+#include <algorithm>
+
 #include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
@@ -39,6 +41,16 @@ const int kCleanupInterval = 10;  // DO NOT INCREASE THIS TIMEOUT.
 // after a certain timeout has passed without receiving an ACK.
 bool g_connect_backup_jobs_enabled = true;
 
+// Indicate whether pools that enable it should preconnect the sockets that a
+// group is expected to need when a new burst of requests starts.
+bool g_preconnect_prediction_enabled = true;
+
+// The number of groups whose socket demand history is kept.
+const size_t kMaxDemandHistoryEntries = 256;
+
+// The number of bursts a group must have had before its demand is predicted.
+const int kMinBurstsForPrediction = 2;
+
 // Compares the effective priority of two results, and returns 1 if |request1|
 // has greater effective priority than |request2|, 0 if they have the same
 // effective priority, and -1 if |request2| has the greater effective priority.
@@ -176,6 +188,8 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
       used_idle_socket_timeout_(used_idle_socket_timeout),
       connect_job_factory_(connect_job_factory),
       connect_backup_jobs_enabled_(false),
+      preconnect_prediction_enabled_(false),
+      demand_history_(kMaxDemandHistoryEntries),
       pool_generation_number_(0),
       weak_factory_(this) {
   DCHECK_LE(0, max_sockets_per_group);
@@ -209,6 +223,17 @@ ClientSocketPoolBaseHelper::CallbackResultPair::CallbackResultPair(
 
 ClientSocketPoolBaseHelper::CallbackResultPair::~CallbackResultPair() {}
 
+ClientSocketPoolBaseHelper::PendingGroupKey::PendingGroupKey(
+    RequestPriority priority, GroupMap::iterator group_it)
+    : priority(priority), group_it(group_it) {}
+
+bool ClientSocketPoolBaseHelper::PendingGroupKey::operator<(
+    const PendingGroupKey& other) const {
+  if (priority != other.priority)
+    return priority > other.priority;
+  return group_it->first < other.group_it->first;
+}
+
 // static
 void ClientSocketPoolBaseHelper::InsertRequestIntoQueue(
     const Request* r, RequestQueue* pending_requests) {
@@ -222,18 +247,44 @@ void ClientSocketPoolBaseHelper::InsertRequestIntoQueue(
   pending_requests->insert(it, r);
 }
 
-// static
 const ClientSocketPoolBaseHelper::Request*
 ClientSocketPoolBaseHelper::RemoveRequestFromQueue(
-    const RequestQueue::iterator& it, Group* group) {
+    const std::string& group_name,
+    const RequestQueue::iterator& it,
+    Group* group) {
+  GroupMap::iterator group_it = group_map_.find(group_name);
+  DCHECK(group_it != group_map_.end());
+  DCHECK_EQ(group, group_it->second);
+  RemoveFromPendingGroupIndex(group_it);
   const Request* req = *it;
   group->mutable_pending_requests()->erase(it);
+  AddToPendingGroupIndex(group_it);
   // If there are no more requests, we kill the backup timer.
   if (group->pending_requests().empty())
     group->CleanupBackupJob();
   return req;
 }
 
+void ClientSocketPoolBaseHelper::RemoveFromPendingGroupIndex(
+    GroupMap::iterator group_it) {
+  const Group* group = group_it->second;
+  if (group->pending_requests().empty())
+    return;
+  size_t erased = pending_group_index_.erase(
+      PendingGroupKey(group->TopPendingPriority(), group_it));
+  DCHECK_EQ(1u, erased);
+}
+
+void ClientSocketPoolBaseHelper::AddToPendingGroupIndex(
+    GroupMap::iterator group_it) {
+  const Group* group = group_it->second;
+  if (group->pending_requests().empty())
+    return;
+  bool inserted = pending_group_index_.insert(
+      PendingGroupKey(group->TopPendingPriority(), group_it)).second;
+  DCHECK(inserted);
+}
+
 void ClientSocketPoolBaseHelper::AddLayeredPool(LayeredPool* pool) {
   CHECK(pool);
   CHECK(!ContainsKey(higher_layer_pools_, pool));
@@ -265,7 +316,10 @@ int ClientSocketPoolBaseHelper::RequestSocket(
     CHECK(!request->handle()->is_initialized());
     delete request;
   } else {
+    GroupMap::iterator group_it = group_map_.find(group_name);
+    RemoveFromPendingGroupIndex(group_it);
     InsertRequestIntoQueue(request, group->mutable_pending_requests());
+    AddToPendingGroupIndex(group_it);
     // Have to do this asynchronously, as closing sockets in higher level pools
     // call back in to |this|, which will cause all sorts of fun and exciting
     // re-entrancy issues if the socket pool is doing something else at the
@@ -396,7 +450,7 @@ int ClientSocketPoolBaseHelper::RequestSocketInternal(
                     connect_job->connect_timing(), handle, base::TimeDelta(),
                     group, request->net_log());
     } else {
-      AddIdleSocket(connect_job->ReleaseSocket(), group);
+      AddIdleSocket(connect_job->ReleaseSocket(), group_name, group);
     }
   } else if (rv == ERR_IO_PENDING) {
     // If we don't have any sockets in this group, set a timer for potentially
@@ -442,9 +496,8 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
   for (std::list<IdleSocket>::iterator it = idle_sockets->begin();
        it != idle_sockets->end();) {
     if (!it->socket->IsConnectedAndIdle()) {
-      DecrementIdleCount();
       delete it->socket;
-      it = idle_sockets->erase(it);
+      it = RemoveIdleSocket(it, group);
       continue;
     }
 
@@ -463,11 +516,10 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
     idle_socket_it = idle_sockets->begin();
 
   if (idle_socket_it != idle_sockets->end()) {
-    DecrementIdleCount();
     base::TimeDelta idle_time =
         base::TimeTicks::Now() - idle_socket_it->start_time;
     IdleSocket idle_socket = *idle_socket_it;
-    idle_sockets->erase(idle_socket_it);
+    RemoveIdleSocket(idle_socket_it, group);
     HandOutSocket(
         idle_socket.socket,
         idle_socket.socket->WasEverUsed(),
@@ -512,7 +564,8 @@ void ClientSocketPoolBaseHelper::CancelRequest(
   RequestQueue::iterator it = group->mutable_pending_requests()->begin();
   for (; it != group->pending_requests().end(); ++it) {
     if ((*it)->handle() == handle) {
-      scoped_ptr<const Request> req(RemoveRequestFromQueue(it, group));
+      scoped_ptr<const Request> req(
+          RemoveRequestFromQueue(group_name, it, group));
       req->net_log().AddEvent(NetLog::TYPE_CANCELLED);
       req->net_log().EndEvent(NetLog::TYPE_SOCKET_POOL);
 
@@ -674,8 +727,7 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
           used_idle_socket_timeout_ : unused_idle_socket_timeout_;
       if (force || j->ShouldCleanup(now, timeout)) {
         delete j->socket;
-        j = group->mutable_idle_sockets()->erase(j);
-        DecrementIdleCount();
+        j = RemoveIdleSocket(j, group);
       } else {
         ++j;
       }
@@ -708,6 +760,10 @@ void ClientSocketPoolBaseHelper::RemoveGroup(const std::string& group_name) {
 }
 
 void ClientSocketPoolBaseHelper::RemoveGroup(GroupMap::iterator it) {
+  // Groups in |pending_group_index_| or |idle_socket_index_| must outlive
+  // their entries.
+  DCHECK(it->second->pending_requests().empty());
+  DCHECK(it->second->idle_sockets().empty());
   delete it->second;
   group_map_.erase(it);
 }
@@ -728,6 +784,59 @@ void ClientSocketPoolBaseHelper::EnableConnectBackupJobs() {
   connect_backup_jobs_enabled_ = g_connect_backup_jobs_enabled;
 }
 
+// static
+bool ClientSocketPoolBaseHelper::preconnect_prediction_enabled() {
+  return g_preconnect_prediction_enabled;
+}
+
+// static
+bool ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(
+    bool enabled) {
+  bool old_value = g_preconnect_prediction_enabled;
+  g_preconnect_prediction_enabled = enabled;
+  return old_value;
+}
+
+void ClientSocketPoolBaseHelper::EnablePreconnectPrediction() {
+  preconnect_prediction_enabled_ = g_preconnect_prediction_enabled;
+}
+
+int ClientSocketPoolBaseHelper::PredictSocketDemand(
+    const std::string& group_name) {
+  if (!preconnect_prediction_enabled_)
+    return 0;
+
+  GroupMap::const_iterator group_it = group_map_.find(group_name);
+  const Group* group =
+      group_it == group_map_.end() ? NULL : group_it->second;
+
+  DemandHistoryMap::iterator history_it = demand_history_.Get(group_name);
+  if (history_it == demand_history_.end())
+    history_it = demand_history_.Put(group_name, DemandHistory());
+  DemandHistory* history = &history_it->second;
+
+  if (group && (group->active_socket_count() > 0 ||
+                !group->pending_requests().empty())) {
+    history->RecordDemand(group->active_socket_count() +
+                          static_cast<int>(group->pending_requests().size()) +
+                          1);
+    return 0;
+  }
+
+  history->StartBurst();
+  int num_sockets = std::min(history->PredictedDemand(),
+                             max_sockets_per_group_);
+  // Only use free slots, so that warming up this group never closes idle
+  // sockets of other groups.
+  int free_slots = max_sockets_ - (handed_out_socket_count_ +
+                                   connecting_socket_count_ +
+                                   idle_socket_count());
+  if (group)
+    free_slots += group->NumActiveSocketSlots();
+  num_sockets = std::min(num_sockets, free_slots);
+  return num_sockets > 1 ? num_sockets : 0;
+}
+
 void ClientSocketPoolBaseHelper::IncrementIdleCount() {
   if (++idle_socket_count_ == 1 && use_cleanup_timer_)
     StartIdleSocketTimer();
@@ -773,7 +882,7 @@ void ClientSocketPoolBaseHelper::ReleaseSocket(const std::string& group_name,
       id == pool_generation_number_;
   if (can_reuse) {
     // Add it to the idle list.
-    AddIdleSocket(socket, group);
+    AddIdleSocket(socket, group_name, group);
     OnAvailableSocketSlot(group_name, group);
   } else {
     delete socket;
@@ -808,42 +917,26 @@ void ClientSocketPoolBaseHelper::CheckForStalledSocketGroups() {
 
 // Search for the highest priority pending request, amongst the groups that
 // are not at the |max_sockets_per_group_| limit. Note: for requests with
-// the same priority, the winner is based on group hash ordering (and not
-// insertion order).
+// the same priority, the winner is based on group name ordering (and not
+// insertion order).  Groups at their limit are usually few, so this only
+// looks at a handful of entries of |pending_group_index_|.
 bool ClientSocketPoolBaseHelper::FindTopStalledGroup(
     Group** group,
     std::string* group_name) const {
   CHECK((group && group_name) || (!group && !group_name));
-  Group* top_group = NULL;
-  const std::string* top_group_name = NULL;
-  bool has_stalled_group = false;
-  for (GroupMap::const_iterator i = group_map_.begin();
-       i != group_map_.end(); ++i) {
-    Group* curr_group = i->second;
-    const RequestQueue& queue = curr_group->pending_requests();
-    if (queue.empty())
-      continue;
+  for (PendingGroupIndex::const_iterator i = pending_group_index_.begin();
+       i != pending_group_index_.end(); ++i) {
+    Group* curr_group = i->group_it->second;
+    DCHECK(!curr_group->pending_requests().empty());
     if (curr_group->IsStalledOnPoolMaxSockets(max_sockets_per_group_)) {
-      if (!group)
-        return true;
-      has_stalled_group = true;
-      bool has_higher_priority = !top_group ||
-          curr_group->TopPendingPriority() > top_group->TopPendingPriority();
-      if (has_higher_priority) {
-        top_group = curr_group;
-        top_group_name = &i->first;
+      if (group) {
+        *group = curr_group;
+        *group_name = i->group_it->first;
       }
+      return true;
     }
   }
-
-  if (top_group) {
-    CHECK(group);
-    *group = top_group;
-    *group_name = *top_group_name;
-  } else {
-    CHECK(!has_stalled_group);
-  }
-  return has_stalled_group;
+  return false;
 }
 
 void ClientSocketPoolBaseHelper::OnConnectJobComplete(
@@ -866,7 +959,7 @@ void ClientSocketPoolBaseHelper::OnConnectJobComplete(
     RemoveConnectJob(job, group);
     if (!group->pending_requests().empty()) {
       scoped_ptr<const Request> r(RemoveRequestFromQueue(
-          group->mutable_pending_requests()->begin(), group));
+          group_name, group->mutable_pending_requests()->begin(), group));
       LogBoundConnectJobToRequest(job_log.source(), r.get());
       HandOutSocket(
           socket.release(), false /* unused socket */, connect_timing,
@@ -874,7 +967,7 @@ void ClientSocketPoolBaseHelper::OnConnectJobComplete(
       r->net_log().EndEvent(NetLog::TYPE_SOCKET_POOL);
       InvokeUserCallbackLater(r->handle(), r->callback(), result);
     } else {
-      AddIdleSocket(socket.release(), group);
+      AddIdleSocket(socket.release(), group_name, group);
       OnAvailableSocketSlot(group_name, group);
       CheckForStalledSocketGroups();
     }
@@ -884,7 +977,7 @@ void ClientSocketPoolBaseHelper::OnConnectJobComplete(
     bool handed_out_socket = false;
     if (!group->pending_requests().empty()) {
       scoped_ptr<const Request> r(RemoveRequestFromQueue(
-          group->mutable_pending_requests()->begin(), group));
+          group_name, group->mutable_pending_requests()->begin(), group));
       LogBoundConnectJobToRequest(job_log.source(), r.get());
       job->GetAdditionalErrorState(r->handle());
       RemoveConnectJob(job, group);
@@ -969,7 +1062,7 @@ void ClientSocketPoolBaseHelper::ProcessPendingRequest(
                                  *group->pending_requests().begin());
   if (rv != ERR_IO_PENDING) {
     scoped_ptr<const Request> request(RemoveRequestFromQueue(
-          group->mutable_pending_requests()->begin(), group));
+          group_name, group->mutable_pending_requests()->begin(), group));
     if (group->IsEmpty())
       RemoveGroup(group_name);
 
@@ -1008,16 +1101,33 @@ void ClientSocketPoolBaseHelper::HandOutSocket(
 }
 
 void ClientSocketPoolBaseHelper::AddIdleSocket(
-    StreamSocket* socket, Group* group) {
+    StreamSocket* socket, const std::string& group_name, Group* group) {
   DCHECK(socket);
+  GroupMap::iterator group_it = group_map_.find(group_name);
+  DCHECK(group_it != group_map_.end());
+  DCHECK_EQ(group, group_it->second);
+
   IdleSocket idle_socket;
   idle_socket.socket = socket;
   idle_socket.start_time = base::TimeTicks::Now();
+  base::TimeDelta timeout = socket->WasEverUsed() ?
+      used_idle_socket_timeout_ : unused_idle_socket_timeout_;
+  idle_socket.index_entry = idle_socket_index_.insert(
+      std::make_pair(idle_socket.start_time + timeout, group_it));
 
   group->mutable_idle_sockets()->push_back(idle_socket);
   IncrementIdleCount();
 }
 
+std::list<ClientSocketPoolBaseHelper::IdleSocket>::iterator
+ClientSocketPoolBaseHelper::RemoveIdleSocket(
+    std::list<IdleSocket>::iterator it, Group* group) {
+  DCHECK_EQ(group, it->index_entry->second->second);
+  idle_socket_index_.erase(it->index_entry);
+  DecrementIdleCount();
+  return group->mutable_idle_sockets()->erase(it);
+}
+
 void ClientSocketPoolBaseHelper::CancelAllConnectJobs() {
   for (GroupMap::iterator i = group_map_.begin(); i != group_map_.end();) {
     Group* group = i->second;
@@ -1041,6 +1151,7 @@ void ClientSocketPoolBaseHelper::CancelAllRequestsWithError(int error) {
   for (GroupMap::iterator i = group_map_.begin(); i != group_map_.end();) {
     Group* group = i->second;
 
+    RemoveFromPendingGroupIndex(i);
     RequestQueue pending_requests;
     pending_requests.swap(*group->mutable_pending_requests());
     for (RequestQueue::iterator it2 = pending_requests.begin();
@@ -1083,21 +1194,26 @@ bool ClientSocketPoolBaseHelper::CloseOneIdleSocketExceptInGroup(
     const Group* exception_group) {
   CHECK_GT(idle_socket_count(), 0);
 
-  for (GroupMap::iterator i = group_map_.begin(); i != group_map_.end(); ++i) {
-    Group* group = i->second;
+  for (IdleSocketIndex::iterator i = idle_socket_index_.begin();
+       i != idle_socket_index_.end(); ++i) {
+    GroupMap::iterator group_it = i->second;
+    Group* group = group_it->second;
     if (exception_group == group)
       continue;
+
     std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
+    std::list<IdleSocket>::iterator idle_socket_it = idle_sockets->begin();
+    while (idle_socket_it->index_entry != i) {
+      ++idle_socket_it;
+      DCHECK(idle_socket_it != idle_sockets->end());
+    }
 
-    if (!idle_sockets->empty()) {
-      delete idle_sockets->front().socket;
-      idle_sockets->pop_front();
-      DecrementIdleCount();
-      if (group->IsEmpty())
-        RemoveGroup(i);
+    delete idle_socket_it->socket;
+    RemoveIdleSocket(idle_socket_it, group);
+    if (group->IsEmpty())
+      RemoveGroup(group_it);
 
-      return true;
-    }
+    return true;
   }
 
   return false;
@@ -1159,6 +1275,37 @@ ClientSocketPoolBaseHelper::Group::~Group() {
   DCHECK_EQ(0u, unassigned_job_count_);
 }
 
+ClientSocketPoolBaseHelper::DemandHistory::DemandHistory()
+    : current_peak_(0),
+      num_bursts_(0),
+      next_burst_(0) {
+}
+
+void ClientSocketPoolBaseHelper::DemandHistory::StartBurst() {
+  if (current_peak_ > 0) {
+    burst_peaks_[next_burst_] = current_peak_;
+    next_burst_ = (next_burst_ + 1) % kMaxBursts;
+    if (num_bursts_ < kMaxBursts)
+      num_bursts_++;
+  }
+  current_peak_ = 1;
+}
+
+void ClientSocketPoolBaseHelper::DemandHistory::RecordDemand(int demand) {
+  demand = std::min(demand, static_cast<int>(kuint8max));
+  if (demand > current_peak_)
+    current_peak_ = static_cast<uint8>(demand);
+}
+
+int ClientSocketPoolBaseHelper::DemandHistory::PredictedDemand() const {
+  if (num_bursts_ < kMinBurstsForPrediction)
+    return 0;
+  int total = 0;
+  for (int i = 0; i < num_bursts_; ++i)
+    total += burst_peaks_[i];
+  return total / num_bursts_;
+}
+
 void ClientSocketPoolBaseHelper::Group::StartBackupSocketTimer(
     const std::string& group_name,
     ClientSocketPoolBaseHelper* pool) {
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -310,6 +311,20 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   void EnableConnectBackupJobs();
 
+  static bool preconnect_prediction_enabled();
+  static bool set_preconnect_prediction_enabled(bool enabled);
+
+  // When enabled, the pool remembers how many sockets each group needed at
+  // once during its recent bursts of requests, so that PredictSocketDemand()
+  // can warm up sockets when a new burst starts.
+  void EnablePreconnectPrediction();
+
+  // Records a socket request for |group_name|. If the request starts a new
+  // burst for the group, returns the number of sockets the burst is expected
+  // to need, bounded by the per-group limit and by the free socket slots in
+  // the pool.  Returns 0 if nothing should be preconnected.
+  int PredictSocketDemand(const std::string& group_name);
+
   // ConnectJob::Delegate methods:
   virtual void OnConnectJobComplete(int result, ConnectJob* job) OVERRIDE;
 
@@ -319,6 +334,15 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
  private:
   friend class base::RefCounted<ClientSocketPoolBaseHelper>;
 
+  class Group;
+
+  typedef std::map<std::string, Group*> GroupMap;
+
+  // Idle sockets of every group, keyed by the time at which each one would be
+  // timed out.  Sockets which were never used have a shorter timeout, so the
+  // first entry is the idle socket which is least worth keeping.
+  typedef std::multimap<base::TimeTicks, GroupMap::iterator> IdleSocketIndex;
+
   // Entry for a persistent socket which became idle at time |start_time|.
   struct IdleSocket {
     IdleSocket() : socket(NULL) {}
@@ -335,6 +359,37 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
     StreamSocket* socket;
     base::TimeTicks start_time;
+    // Entry of |socket| in |idle_socket_index_|.
+    IdleSocketIndex::iterator index_entry;
+  };
+
+  // Compact history of the number of sockets a group needed at once. A burst
+  // starts with a request made while the group has no active sockets and no
+  // pending requests, and its peak is the largest number of sockets that were
+  // active or requested at once before the next burst started.
+  class DemandHistory {
+   public:
+    DemandHistory();
+
+    // Ends the current burst, if any, and starts a new one with a demand of
+    // one socket.
+    void StartBurst();
+
+    // Records that |demand| sockets are needed at once in the current burst.
+    void RecordDemand(int demand);
+
+    // Returns the average peak of the recent bursts, or 0 if too few bursts
+    // have been seen to make a prediction.
+    int PredictedDemand() const;
+
+   private:
+    enum { kMaxBursts = 4 };
+
+    uint8 current_peak_;
+    // Ring buffer of the peaks of the last |num_bursts_| bursts.
+    uint8 burst_peaks_[kMaxBursts];
+    uint8 num_bursts_;
+    uint8 next_burst_;
   };
 
   typedef std::deque<const Request* > RequestQueue;
@@ -427,7 +482,20 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     base::WeakPtrFactory<Group> weak_factory_;
   };
 
-  typedef std::map<std::string, Group*> GroupMap;
+  // Key of a group in |pending_group_index_|.  Groups are ordered by the
+  // priority of their top pending request, highest first, and then by name.
+  struct PendingGroupKey {
+    PendingGroupKey(RequestPriority priority, GroupMap::iterator group_it);
+
+    bool operator<(const PendingGroupKey& other) const;
+
+    RequestPriority priority;
+    GroupMap::iterator group_it;
+  };
+
+  typedef std::set<PendingGroupKey> PendingGroupIndex;
+
+  typedef base::MRUCache<std::string, DemandHistory> DemandHistoryMap;
 
   typedef std::set<ConnectJob*> ConnectJobSet;
 
@@ -449,8 +517,15 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // front. Older requests are prioritized over requests of equal priority.
   static void InsertRequestIntoQueue(const Request* r,
                                      RequestQueue* pending_requests);
-  static const Request* RemoveRequestFromQueue(const RequestQueue::iterator& it,
-                                               Group* group);
+  const Request* RemoveRequestFromQueue(const std::string& group_name,
+                                        const RequestQueue::iterator& it,
+                                        Group* group);
+
+  // Remove the group from, and add it back to, |pending_group_index_|.  Every
+  // change to a group's pending requests must be bracketed by these calls.
+  // Groups without pending requests are not indexed.
+  void RemoveFromPendingGroupIndex(GroupMap::iterator group_it);
+  void AddToPendingGroupIndex(GroupMap::iterator group_it);
 
   Group* GetOrCreateGroup(const std::string& group_name);
   void RemoveGroup(const std::string& group_name);
@@ -463,10 +538,17 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // Start cleanup timer for idle sockets.
   void StartIdleSocketTimer();
 
-  // Scans the group map for groups which have an available socket slot and
-  // at least one pending request. Returns true if any groups are stalled, and
-  // if so (and if both |group| and |group_name| are not NULL), fills |group|
-  // and |group_name| with data of the stalled group having highest priority.
+  // Removes the idle socket at |it| from |group| and from
+  // |idle_socket_index_|, without deleting it.  Returns the iterator
+  // following |it|.
+  std::list<IdleSocket>::iterator RemoveIdleSocket(
+      std::list<IdleSocket>::iterator it, Group* group);
+
+  // Walks |pending_group_index_| for groups which have an available socket
+  // slot and at least one pending request. Returns true if any groups are
+  // stalled, and if so (and if both |group| and |group_name| are not NULL),
+  // fills |group| and |group_name| with data of the stalled group having
+  // highest priority.
   bool FindTopStalledGroup(Group** group, std::string* group_name) const;
 
   // Called when timer_ fires.  This method scans the idle sockets removing
@@ -494,7 +576,9 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
                      const BoundNetLog& net_log);
 
   // Adds |socket| to the list of idle sockets for |group|.
-  void AddIdleSocket(StreamSocket* socket, Group* group);
+  void AddIdleSocket(StreamSocket* socket,
+                     const std::string& group_name,
+                     Group* group);
 
   // Iterates through |group_map_|, canceling all ConnectJobs and deleting
   // groups if they are no longer needed.
@@ -522,7 +606,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   // Same as CloseOneIdleSocket() except it won't close an idle socket in
   // |group|.  If |group| is NULL, it is ignored.  Returns true if it closed a
-  // socket.
+  // socket.  The socket closed is the one which would be timed out first.
   bool CloseOneIdleSocketExceptInGroup(const Group* group);
 
   // Checks if there are stalled socket groups that should be notified
@@ -547,6 +631,12 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   GroupMap group_map_;
 
+  // Indexes into |group_map_| of the groups with pending requests, and of
+  // the idle sockets of all groups, so that stalled groups and idle sockets
+  // to close are found without scanning every group.
+  PendingGroupIndex pending_group_index_;
+  IdleSocketIndex idle_socket_index_;
+
   // Map of the ClientSocketHandles for which we have a pending Task to invoke a
   // callback.  This is necessary since, before we invoke said callback, it's
   // possible that the request is cancelled.
@@ -583,6 +673,12 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // TODO(vandebo) Remove when backup jobs move to TransportClientSocketPool
   bool connect_backup_jobs_enabled_;
 
+  bool preconnect_prediction_enabled_;
+
+  // Socket demand history of recently used groups. Unlike |group_map_|, it
+  // outlives the groups themselves.
+  DemandHistoryMap demand_history_;
+
   // A unique id for the pool.  It gets incremented every time we
   // FlushWithError() the pool.  This is so that when sockets get released back
   // to the pool, we can make sure that they are discarded rather than reused.
@@ -665,19 +761,28 @@ class ClientSocketPoolBase {
   }
 
   // RequestSocket bundles up the parameters into a Request and then forwards to
-  // ClientSocketPoolBaseHelper::RequestSocket().
+  // ClientSocketPoolBaseHelper::RequestSocket(). If preconnect prediction is
+  // enabled, |predict_demand| is true and the request does not ignore limits,
+  // the sockets the rest of the burst is expected to need are preconnected.
   int RequestSocket(const std::string& group_name,
                     const scoped_refptr<SocketParams>& params,
                     RequestPriority priority,
                     ClientSocketHandle* handle,
                     const CompletionCallback& callback,
+                    bool predict_demand,
                     const BoundNetLog& net_log) {
     Request* request =
         new Request(handle, callback, priority,
                     internal::ClientSocketPoolBaseHelper::NORMAL,
                     params->ignore_limits(),
                     params, net_log);
-    return helper_.RequestSocket(group_name, request);
+    int num_predicted_sockets = (!predict_demand || params->ignore_limits()) ?
+        0 : helper_.PredictSocketDemand(group_name);
+    int rv = helper_.RequestSocket(group_name, request);
+    // Warm up the rest of the sockets the burst is expected to need.
+    if (num_predicted_sockets > 0 && (rv == OK || rv == ERR_IO_PENDING))
+      RequestSockets(group_name, params, num_predicted_sockets, net_log);
+    return rv;
   }
 
   // RequestSockets bundles up the parameters into a Request and then forwards
@@ -763,6 +868,8 @@ class ClientSocketPoolBase {
 
   void EnableConnectBackupJobs() { helper_.EnableConnectBackupJobs(); }
 
+  void EnablePreconnectPrediction() { helper_.EnablePreconnectPrediction(); }
+
   bool CloseOneIdleSocket() { return helper_.CloseOneIdleSocket(); }
 
   bool CloseOneIdleConnectionInLayeredPool() {
@@ -0,0 +1,356 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <deque>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/perftimer.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/request_priority.h"
+#include "net/socket/client_socket_handle.h"
+#include "net/socket/client_socket_pool.h"
+#include "net/socket/client_socket_pool_base.h"
+#include "net/socket/client_socket_pool_histograms.h"
+#include "net/socket/stream_socket.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumGroups = 10000;
+const int kMaxSocketsPerGroup = 6;
+const int kIterations = 100000;
+
+class NullSocketParams : public base::RefCounted<NullSocketParams> {
+ public:
+  NullSocketParams() {}
+
+  bool ignore_limits() const { return false; }
+
+ private:
+  friend class base::RefCounted<NullSocketParams>;
+  ~NullSocketParams() {}
+};
+typedef ClientSocketPoolBase<NullSocketParams> NullClientSocketPoolBase;
+
+// Socket which is always connected and idle, so that only the cost of the
+// pool's bookkeeping is measured.
+class NullSocket : public StreamSocket {
+ public:
+  NullSocket() {}
+  virtual ~NullSocket() {}
+
+  // Socket implementation.
+  virtual int Read(IOBuffer* buf, int buf_len,
+                   const CompletionCallback& callback) OVERRIDE {
+    return ERR_UNEXPECTED;
+  }
+  virtual int Write(IOBuffer* buf, int buf_len,
+                    const CompletionCallback& callback) OVERRIDE {
+    return ERR_UNEXPECTED;
+  }
+  virtual bool SetReceiveBufferSize(int32 size) OVERRIDE { return true; }
+  virtual bool SetSendBufferSize(int32 size) OVERRIDE { return true; }
+
+  // StreamSocket implementation.
+  virtual int Connect(const CompletionCallback& callback) OVERRIDE {
+    return OK;
+  }
+  virtual void Disconnect() OVERRIDE {}
+  virtual bool IsConnected() const OVERRIDE { return true; }
+  virtual bool IsConnectedAndIdle() const OVERRIDE { return true; }
+  virtual int GetPeerAddress(IPEndPoint* address) const OVERRIDE {
+    return ERR_UNEXPECTED;
+  }
+  virtual int GetLocalAddress(IPEndPoint* address) const OVERRIDE {
+    return ERR_UNEXPECTED;
+  }
+  virtual const BoundNetLog& NetLog() const OVERRIDE { return net_log_; }
+  virtual void SetSubresourceSpeculation() OVERRIDE {}
+  virtual void SetOmniboxSpeculation() OVERRIDE {}
+  virtual bool WasEverUsed() const OVERRIDE { return false; }
+  virtual bool UsingTCPFastOpen() const OVERRIDE { return false; }
+  virtual bool WasNpnNegotiated() const OVERRIDE { return false; }
+  virtual NextProto GetNegotiatedProtocol() const OVERRIDE {
+    return kProtoUnknown;
+  }
+  virtual bool GetSSLInfo(SSLInfo* ssl_info) OVERRIDE { return false; }
+
+ private:
+  BoundNetLog net_log_;
+
+  DISALLOW_COPY_AND_ASSIGN(NullSocket);
+};
+
+// ConnectJob which connects a NullSocket synchronously.
+class NullConnectJob : public ConnectJob {
+ public:
+  NullConnectJob(const std::string& group_name, Delegate* delegate)
+      : ConnectJob(group_name, base::TimeDelta(), delegate, BoundNetLog()) {}
+  virtual ~NullConnectJob() {}
+
+  virtual LoadState GetLoadState() const OVERRIDE { return LOAD_STATE_IDLE; }
+
+ private:
+  virtual int ConnectInternal() OVERRIDE {
+    set_socket(new NullSocket());
+    return OK;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(NullConnectJob);
+};
+
+class NullConnectJobFactory
+    : public NullClientSocketPoolBase::ConnectJobFactory {
+ public:
+  NullConnectJobFactory() {}
+  virtual ~NullConnectJobFactory() {}
+
+  virtual ConnectJob* NewConnectJob(
+      const std::string& group_name,
+      const NullClientSocketPoolBase::Request& request,
+      ConnectJob::Delegate* delegate) const OVERRIDE {
+    return new NullConnectJob(group_name, delegate);
+  }
+
+  virtual base::TimeDelta ConnectionTimeout() const OVERRIDE {
+    return base::TimeDelta();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullConnectJobFactory);
+};
+
+class NullClientSocketPool : public ClientSocketPool {
+ public:
+  NullClientSocketPool(int max_sockets,
+                       ClientSocketPoolHistograms* histograms)
+      : base_(max_sockets, kMaxSocketsPerGroup, histograms,
+              base::TimeDelta::FromSeconds(10),
+              base::TimeDelta::FromSeconds(300),
+              new NullConnectJobFactory()) {}
+  virtual ~NullClientSocketPool() {}
+
+  virtual int RequestSocket(const std::string& group_name,
+                            const void* params,
+                            RequestPriority priority,
+                            ClientSocketHandle* handle,
+                            const CompletionCallback& callback,
+                            const BoundNetLog& net_log) OVERRIDE {
+    const scoped_refptr<NullSocketParams>* casted_params =
+        static_cast<const scoped_refptr<NullSocketParams>*>(params);
+    return base_.RequestSocket(group_name, *casted_params, priority, handle,
+                               callback, true /* predict_demand */, net_log);
+  }
+
+  virtual void RequestSockets(const std::string& group_name,
+                              const void* params,
+                              int num_sockets,
+                              const BoundNetLog& net_log) OVERRIDE {
+    const scoped_refptr<NullSocketParams>* casted_params =
+        static_cast<const scoped_refptr<NullSocketParams>*>(params);
+    base_.RequestSockets(group_name, *casted_params, num_sockets, net_log);
+  }
+
+  virtual void CancelRequest(const std::string& group_name,
+                             ClientSocketHandle* handle) OVERRIDE {
+    base_.CancelRequest(group_name, handle);
+  }
+
+  virtual void ReleaseSocket(const std::string& group_name,
+                             StreamSocket* socket,
+                             int id) OVERRIDE {
+    base_.ReleaseSocket(group_name, socket, id);
+  }
+
+  virtual void FlushWithError(int error) OVERRIDE {
+    base_.FlushWithError(error);
+  }
+
+  virtual bool IsStalled() const OVERRIDE { return base_.IsStalled(); }
+
+  virtual void CloseIdleSockets() OVERRIDE { base_.CloseIdleSockets(); }
+
+  virtual int IdleSocketCount() const OVERRIDE {
+    return base_.idle_socket_count();
+  }
+
+  virtual int IdleSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE {
+    return base_.IdleSocketCountInGroup(group_name);
+  }
+
+  virtual LoadState GetLoadState(
+      const std::string& group_name,
+      const ClientSocketHandle* handle) const OVERRIDE {
+    return base_.GetLoadState(group_name, handle);
+  }
+
+  virtual void AddLayeredPool(LayeredPool* pool) OVERRIDE {
+    base_.AddLayeredPool(pool);
+  }
+
+  virtual void RemoveLayeredPool(LayeredPool* pool) OVERRIDE {
+    base_.RemoveLayeredPool(pool);
+  }
+
+  virtual base::DictionaryValue* GetInfoAsValue(
+      const std::string& name,
+      const std::string& type,
+      bool include_nested_pools) const OVERRIDE {
+    return base_.GetInfoAsValue(name, type);
+  }
+
+  virtual base::TimeDelta ConnectionTimeout() const OVERRIDE {
+    return base_.ConnectionTimeout();
+  }
+
+  virtual ClientSocketPoolHistograms* histograms() const OVERRIDE {
+    return base_.histograms();
+  }
+
+ private:
+  NullClientSocketPoolBase base_;
+
+  DISALLOW_COPY_AND_ASSIGN(NullClientSocketPool);
+};
+
+}  // namespace
+
+REGISTER_SOCKET_PARAMS_FOR_POOL(NullClientSocketPool, NullSocketParams);
+
+namespace {
+
+// A client of the pool which keeps requesting a socket for its group and
+// queues itself on |connected| whenever it gets one.
+class Client {
+ public:
+  Client(const std::string& group_name,
+         RequestPriority priority,
+         NullClientSocketPool* pool,
+         std::deque<Client*>* connected)
+      : group_name_(group_name),
+        priority_(priority),
+        pool_(pool),
+        connected_(connected),
+        params_(new NullSocketParams()) {}
+
+  void RequestSocket() {
+    int rv = handle_.Init(group_name_, params_, priority_,
+                          base::Bind(&Client::OnComplete,
+                                     base::Unretained(this)),
+                          pool_, BoundNetLog());
+    if (rv != ERR_IO_PENDING)
+      OnComplete(rv);
+  }
+
+  // Returns the socket to the pool, where it is kept alive as an idle socket.
+  void ReleaseSocket() { handle_.Reset(); }
+
+ private:
+  void OnComplete(int result) {
+    ASSERT_EQ(OK, result);
+    connected_->push_back(this);
+  }
+
+  const std::string group_name_;
+  const RequestPriority priority_;
+  NullClientSocketPool* const pool_;
+  std::deque<Client*>* const connected_;
+  const scoped_refptr<NullSocketParams> params_;
+  ClientSocketHandle handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(Client);
+};
+
+void CreateClients(NullClientSocketPool* pool,
+                   std::deque<Client*>* connected,
+                   ScopedVector<Client>* clients) {
+  for (int i = 0; i < kNumGroups; ++i) {
+    RequestPriority priority =
+        static_cast<RequestPriority>(MINIMUM_PRIORITY + i % NUM_PRIORITIES);
+    clients->push_back(
+        new Client(base::IntToString(i), priority, pool, connected));
+  }
+}
+
+// Gives every group a client, so that most of them are stalled waiting for
+// one of |max_sockets| sockets, and then repeatedly releases the socket of
+// the client which connected first and requests a new one for it.
+void RunStalledGroupsBenchmark(const std::string& name, int max_sockets) {
+  base::MessageLoopForIO message_loop;
+  ClientSocketPoolHistograms histograms("PerfTest");
+  NullClientSocketPool pool(max_sockets, &histograms);
+  std::deque<Client*> connected;
+  ScopedVector<Client> clients;
+  CreateClients(&pool, &connected, &clients);
+
+  for (size_t i = 0; i < clients.size(); ++i)
+    clients[i]->RequestSocket();
+  message_loop.RunUntilIdle();
+
+  PerfTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    if (connected.empty())
+      message_loop.RunUntilIdle();
+    ASSERT_FALSE(connected.empty());
+    Client* client = connected.front();
+    connected.pop_front();
+    client->ReleaseSocket();
+    client->RequestSocket();
+  }
+  LogPerfResult(name.c_str(), kIterations / timer.Elapsed().InSecondsF(),
+                "cycles/s");
+
+  clients.clear();
+  message_loop.RunUntilIdle();
+}
+
+// Requests and immediately releases a socket for each group in turn, so that
+// once |max_sockets| sockets are idle, every request for a group without an
+// idle socket has to close an idle socket of another group.
+void RunIdleSocketsBenchmark(const std::string& name, int max_sockets) {
+  base::MessageLoopForIO message_loop;
+  ClientSocketPoolHistograms histograms("PerfTest");
+  NullClientSocketPool pool(max_sockets, &histograms);
+  std::deque<Client*> connected;
+  ScopedVector<Client> clients;
+  CreateClients(&pool, &connected, &clients);
+
+  PerfTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    Client* client = clients[i % clients.size()];
+    client->RequestSocket();
+    ASSERT_EQ(1u, connected.size());
+    connected.pop_front();
+    client->ReleaseSocket();
+  }
+  LogPerfResult(name.c_str(), kIterations / timer.Elapsed().InSecondsF(),
+                "cycles/s");
+
+  clients.clear();
+  message_loop.RunUntilIdle();
+}
+
+}  // namespace
+
+TEST(ClientSocketPoolBasePerfTest, StalledGroups) {
+  RunStalledGroupsBenchmark("client_socket_pool_stalled_10000_groups", 256);
+}
+
+TEST(ClientSocketPoolBasePerfTest, IdleSockets) {
+  RunIdleSocketsBenchmark("client_socket_pool_idle_10000_groups",
+                          kNumGroups / 2);
+}
+
+}  // namespace net
@@ -488,7 +488,8 @@ class TestClientSocketPool : public ClientSocketPool {
     const scoped_refptr<TestSocketParams>* casted_socket_params =
         static_cast<const scoped_refptr<TestSocketParams>*>(params);
     return base_.RequestSocket(group_name, *casted_socket_params, priority,
-                               handle, callback, net_log);
+                               handle, callback, true /* predict_demand */,
+                               net_log);
   }
 
   virtual void RequestSockets(const std::string& group_name,
@@ -586,6 +587,8 @@ class TestClientSocketPool : public ClientSocketPool {
 
   void EnableConnectBackupJobs() { base_.EnableConnectBackupJobs(); }
 
+  void EnablePreconnectPrediction() { base_.EnablePreconnectPrediction(); }
+
   bool CloseOneIdleConnectionInLayeredPool() {
     return base_.CloseOneIdleConnectionInLayeredPool();
   }
@@ -666,6 +669,8 @@ class ClientSocketPoolBaseTest : public testing::Test {
     internal::ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(true);
     cleanup_timer_enabled_ =
         internal::ClientSocketPoolBaseHelper::cleanup_timer_enabled();
+    preconnect_prediction_enabled_ =
+        internal::ClientSocketPoolBaseHelper::preconnect_prediction_enabled();
   }
 
   virtual ~ClientSocketPoolBaseTest() {
@@ -673,6 +678,8 @@ class ClientSocketPoolBaseTest : public testing::Test {
         connect_backup_jobs_enabled_);
     internal::ClientSocketPoolBaseHelper::set_cleanup_timer_enabled(
         cleanup_timer_enabled_);
+    internal::ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(
+        preconnect_prediction_enabled_);
   }
 
   void CreatePool(int max_sockets, int max_sockets_per_group) {
@@ -731,6 +738,7 @@ class ClientSocketPoolBaseTest : public testing::Test {
   CapturingNetLog net_log_;
   bool connect_backup_jobs_enabled_;
   bool cleanup_timer_enabled_;
+  bool preconnect_prediction_enabled_;
   MockClientSocketFactory client_socket_factory_;
   TestConnectJobFactory* connect_job_factory_;
   scoped_refptr<TestSocketParams> params_;
@@ -1281,9 +1289,9 @@ TEST_F(ClientSocketPoolBaseTest, CloseIdleSocketAtSocketLimitDeleteGroup) {
   ClientSocketHandle handle;
   TestCompletionCallback callback;
 
-  // "0" is special here, since it should be the first entry in the sorted map,
-  // which is the one which we would close an idle socket for.  We shouldn't
-  // close an idle socket though, since we should reuse the idle socket.
+  // "0" is special here, since its idle socket is the oldest one, which is the
+  // one which we would close.  We shouldn't close an idle socket though,
+  // since we should reuse the idle socket.
   EXPECT_EQ(OK, handle.Init("0",
                             params_,
                             kDefaultPriority,
@@ -1295,6 +1303,50 @@ TEST_F(ClientSocketPoolBaseTest, CloseIdleSocketAtSocketLimitDeleteGroup) {
   EXPECT_EQ(kDefaultMaxSockets - 1, pool_->IdleSocketCount());
 }
 
+// When an idle socket has to be closed to make room, the one closed should be
+// the one which would time out first, rather than one picked by group name.
+TEST_F(ClientSocketPoolBaseTest, CloseIdleSocketAtSocketLimitPrefersUnused) {
+  CreatePool(2, 2);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  ClientSocketHandle handle_a;
+  TestCompletionCallback callback_a;
+  EXPECT_EQ(OK, handle_a.Init("a",
+                              params_,
+                              kDefaultPriority,
+                              callback_a.callback(),
+                              pool_.get(),
+                              BoundNetLog()));
+  EXPECT_EQ(1, handle_a.socket()->Write(NULL, 1, CompletionCallback()));
+
+  ClientSocketHandle handle_b;
+  TestCompletionCallback callback_b;
+  EXPECT_EQ(OK, handle_b.Init("b",
+                              params_,
+                              kDefaultPriority,
+                              callback_b.callback(),
+                              pool_.get(),
+                              BoundNetLog()));
+
+  handle_a.Reset();
+  handle_b.Reset();
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(2, pool_->IdleSocketCount());
+
+  // The pool is full, so a request for a new group has to close an idle
+  // socket.  The unused one in "b" has the shorter timeout.
+  ClientSocketHandle handle_c;
+  TestCompletionCallback callback_c;
+  EXPECT_EQ(OK, handle_c.Init("c",
+                              params_,
+                              kDefaultPriority,
+                              callback_c.callback(),
+                              pool_.get(),
+                              BoundNetLog()));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_FALSE(pool_->HasGroup("b"));
+}
+
 TEST_F(ClientSocketPoolBaseTest, PendingRequests) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
 
@@ -3716,6 +3768,115 @@ TEST_F(ClientSocketPoolBaseTest, PreconnectWithBackupJob) {
   EXPECT_EQ(1, pool_->NumActiveSocketsInGroup("a"));
 }
 
+// Test that once a group has repeatedly needed two sockets at once, the first
+// request of its next burst warms up a second socket.
+TEST_F(ClientSocketPoolBaseTest, PreconnectPredictionWarmsSocketsForBurst) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  internal::ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(true);
+  pool_->EnablePreconnectPrediction();
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+    EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+    ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+  }
+  EXPECT_EQ(4, client_socket_factory_.allocation_count());
+
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(2, pool_->NumActiveSocketsInGroup("a"));
+  EXPECT_EQ(6, client_socket_factory_.allocation_count());
+}
+
+// Test that predicted preconnects only use free slots, rather than closing
+// idle sockets of other groups to make room.
+TEST_F(ClientSocketPoolBaseTest, PreconnectPredictionRespectsMaxSockets) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  internal::ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(true);
+  pool_->EnablePreconnectPrediction();
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+    ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+  }
+
+  // Leave a single free slot in the pool, next to an idle socket in "c".
+  EXPECT_EQ(OK, StartRequest("c", kDefaultPriority));
+  EXPECT_EQ(OK, StartRequest("b", kDefaultPriority));
+  EXPECT_EQ(OK, StartRequest("b", kDefaultPriority));
+  EXPECT_TRUE(ReleaseOneConnection(ClientSocketPoolTest::KEEP_ALIVE));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("c"));
+
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(0, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("c"));
+}
+
+// Replays a trace of request bursts, as recorded from page loads, against
+// pools with and without preconnect prediction. Each burst starts with one
+// request, and issues the rest once it has completed. Requests that find a
+// warm socket avoid waiting for a connect.
+TEST_F(ClientSocketPoolBaseTest, PreconnectPredictionTraceReplay) {
+  const struct {
+    const char* group_name;
+    int num_requests;
+  } kTrace[] = {
+    { "a", 2 }, { "b", 1 }, { "a", 2 }, { "c", 2 }, { "b", 1 },
+    { "a", 2 }, { "c", 2 }, { "a", 2 }, { "b", 1 }, { "c", 2 },
+  };
+
+  int avoided_connects[2];
+  for (int predict = 0; predict < 2; ++predict) {
+    pool_.reset();
+    CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+    internal::ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(
+        predict != 0);
+    pool_->EnablePreconnectPrediction();
+    connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+
+    avoided_connects[predict] = 0;
+    for (size_t i = 0; i < arraysize(kTrace); ++i) {
+      EXPECT_EQ(ERR_IO_PENDING,
+                StartRequest(kTrace[i].group_name, kDefaultPriority));
+      EXPECT_EQ(OK, request(requests_size() - 1)->WaitForResult());
+
+      // Give preconnects started by the first request time to complete.
+      base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(
+          2 * TestConnectJob::kPendingConnectDelay));
+      base::MessageLoop::current()->RunUntilIdle();
+
+      for (int j = 1; j < kTrace[i].num_requests; ++j) {
+        int rv = StartRequest(kTrace[i].group_name, kDefaultPriority);
+        if (rv == OK) {
+          ++avoided_connects[predict];
+        } else {
+          EXPECT_EQ(ERR_IO_PENDING, rv);
+          EXPECT_EQ(OK, request(requests_size() - 1)->WaitForResult());
+        }
+      }
+
+      // Bursts are far enough apart for idle sockets to time out.
+      ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+      pool_->CloseIdleSockets();
+    }
+  }
+
+  EXPECT_EQ(0, avoided_connects[0]);
+  // "a" is predicted from its third burst on, and so is "c". "b" never needs
+  // more than one socket.
+  EXPECT_EQ(3, avoided_connects[1]);
+  VLOG(1) << "Avoided connect latency: "
+          << avoided_connects[1] * TestConnectJob::kPendingConnectDelay
+          << "ms";
+}
+
 class MockLayeredPool : public LayeredPool {
  public:
   MockLayeredPool(TestClientSocketPool* pool,
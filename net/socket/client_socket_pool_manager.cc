@@ -156,11 +156,15 @@ int InitSocketPoolHelper(const GURL& request_url,
   }
 
   bool ignore_limits = (request_load_flags & LOAD_IGNORE_LIMITS) != 0;
+  // The SSL pool for the origin predicts socket demand itself, so the
+  // transport pool below it must not preconnect the same burst again.
+  bool predict_transport_demand = !using_ssl;
   if (proxy_info.is_direct()) {
     tcp_params = new TransportSocketParams(origin_host_port,
                                            request_priority,
                                            disable_resolver_cache,
                                            ignore_limits,
+                                           predict_transport_demand,
                                            resolution_callback);
   } else {
     ProxyServer proxy_server = proxy_info.proxy_server();
@@ -170,6 +174,7 @@ int InitSocketPoolHelper(const GURL& request_url,
                                   request_priority,
                                   disable_resolver_cache,
                                   ignore_limits,
+                                  predict_transport_demand,
                                   resolution_callback));
 
     if (proxy_info.is_http() || proxy_info.is_https()) {
@@ -83,6 +83,9 @@ ClientSocketPoolManagerImpl::ClientSocketPoolManagerImpl(
       ssl_for_https_proxy_pool_histograms_("SSLforHTTPSProxy"),
       http_proxy_pool_histograms_("HTTPProxy"),
       ssl_socket_pool_for_proxies_histograms_("SSLForProxies") {
+  // The SSL pools for HTTPS proxies are always layered below another pool, so
+  // only the pools for origin servers predict demand.
+  ssl_socket_pool_->EnablePreconnectPrediction();
   CertDatabase::GetInstance()->AddObserver(this);
 }
 
@@ -333,6 +336,7 @@ SSLClientSocketPool* ClientSocketPoolManagerImpl::GetSocketPoolForSSLWithProxy(
       GetSocketPoolForHTTPProxy(proxy_server),
       ssl_config_service_.get(),
       net_log_);
+  new_pool->EnablePreconnectPrediction();
 
   std::pair<SSLSocketPoolMap::iterator, bool> ret =
       ssl_socket_pools_for_proxies_.insert(std::make_pair(proxy_server,
@@ -75,6 +75,7 @@ DeterministicSocketDataTest::DeterministicSocketDataTest()
                                             LOWEST,
                                             false,
                                             false,
+                                            true,
                                             OnHostResolutionCallback())),
       histograms_(std::string()),
       socket_pool_(10, 10, &histograms_, &socket_factory_) {}
@@ -218,7 +218,8 @@ int SOCKSClientSocketPool::RequestSocket(
       static_cast<const scoped_refptr<SOCKSSocketParams>*>(socket_params);
 
   return base_.RequestSocket(group_name, *casted_socket_params, priority,
-                             handle, callback, net_log);
+                             handle, callback, true /* predict_demand */,
+                             net_log);
 }
 
 void SOCKSClientSocketPool::RequestSockets(
@@ -72,7 +72,7 @@ class SOCKSClientSocketPoolTest : public testing::Test {
 
   SOCKSClientSocketPoolTest()
       : ignored_transport_socket_params_(new TransportSocketParams(
-          HostPortPair("proxy", 80), MEDIUM, false, false,
+          HostPortPair("proxy", 80), MEDIUM, false, false, true,
           OnHostResolutionCallback())),
         transport_histograms_("MockTCP"),
         transport_socket_pool_(
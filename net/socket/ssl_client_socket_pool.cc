@@ -542,6 +542,10 @@ SSLClientSocketPool::SSLConnectJobFactory::ConnectionTimeout() const {
   return timeout_;
 }
 
+void SSLClientSocketPool::EnablePreconnectPrediction() {
+  base_.EnablePreconnectPrediction();
+}
+
 int SSLClientSocketPool::RequestSocket(const std::string& group_name,
                                        const void* socket_params,
                                        RequestPriority priority,
@@ -552,7 +556,8 @@ int SSLClientSocketPool::RequestSocket(const std::string& group_name,
       static_cast<const scoped_refptr<SSLSocketParams>*>(socket_params);
 
   return base_.RequestSocket(group_name, *casted_socket_params, priority,
-                             handle, callback, net_log);
+                             handle, callback, true /* predict_demand */,
+                             net_log);
 }
 
 void SSLClientSocketPool::RequestSockets(
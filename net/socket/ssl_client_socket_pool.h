@@ -187,6 +187,11 @@ class NET_EXPORT_PRIVATE SSLClientSocketPool
 
   virtual ~SSLClientSocketPool();
 
+  // Lets the pool preconnect the sockets a group is expected to need when a
+  // new burst of requests starts. Only enable this on pools which are not
+  // layered below another pool, so that a burst is predicted in one layer.
+  void EnablePreconnectPrediction();
+
   // ClientSocketPool implementation.
   virtual int RequestSocket(const std::string& group_name,
                             const void* connect_params,
@@ -88,6 +88,7 @@ class SSLClientSocketPoolTest
                                       MEDIUM,
                                       false,
                                       false,
+                                      false,
                                       OnHostResolutionCallback())),
         transport_histograms_("MockTCP"),
         transport_socket_pool_(kMaxSockets,
@@ -99,6 +100,7 @@ class SSLClientSocketPoolTest
                                       MEDIUM,
                                       false,
                                       false,
+                                      false,
                                       OnHostResolutionCallback())),
         socks_socket_params_(
             new SOCKSSocketParams(proxy_transport_socket_params_,
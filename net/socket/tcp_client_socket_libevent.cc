@@ -13,12 +13,15 @@
 #include <netinet/in.h>
 #endif
 
+#include "base/containers/mru_cache.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/stats_counters.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "net/base/connection_type_histograms.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
@@ -33,6 +36,11 @@
 #define TCPI_OPT_SYN_DATA 32
 #endif
 
+// Likewise for MSG_FASTOPEN, which older C libraries don't define.
+#if defined(OS_LINUX) && !defined(MSG_FASTOPEN)
+#define MSG_FASTOPEN 0x20000000
+#endif
+
 namespace net {
 
 namespace {
@@ -40,6 +48,101 @@ namespace {
 const int kInvalidSocket = -1;
 const int kTCPKeepAliveSeconds = 45;
 
+// Maximum number of destinations whose TCP FastOpen results are remembered.
+const size_t kMaxFastOpenDestinations = 256;
+
+// Number of TCP FastOpen connections in a row to a destination which fail to
+// connect, after which TCP FastOpen is no longer attempted to it. A single
+// connection whose data in the SYN isn't acked is enough. Connections which
+// don't send data in the SYN, e.g. the first one to a server, since the kernel
+// doesn't have a cookie for it yet, don't count.
+const int kMaxFastOpenMisses = 2;
+
+// How long TCP FastOpen stays disabled for a destination before it is tried
+// again.
+const int kFastOpenRetryIntervalMinutes = 60;
+
+// Remembers the destinations for which TCP FastOpen didn't save a round trip,
+// so that connections to them don't keep paying for the fallback, e.g. when a
+// middlebox drops SYNs which carry data.
+class FastOpenDestinationCache {
+ public:
+  FastOpenDestinationCache() : entries_(kMaxFastOpenDestinations) {}
+
+  // Returns false if TCP FastOpen should not be attempted to |destination|.
+  bool ShouldAttempt(const IPEndPoint& destination) {
+    base::AutoLock lock(lock_);
+    EntryMap::iterator it = entries_.Peek(destination);
+    if (it == entries_.end() || it->second.misses < kMaxFastOpenMisses)
+      return true;
+    if (base::TimeTicks::Now() - it->second.last_miss <
+        base::TimeDelta::FromMinutes(kFastOpenRetryIntervalMinutes)) {
+      return false;
+    }
+    entries_.Erase(it);
+    return true;
+  }
+
+  // Records the outcome of a TCP FastOpen connection to |destination| which
+  // has connected. |sent_syn_data| is true if the kernel had a cookie and sent
+  // data in the SYN, and |syn_data_acked| is true if the server acked that
+  // data.
+  void RecordResult(const IPEndPoint& destination,
+                    bool sent_syn_data,
+                    bool syn_data_acked) {
+    base::AutoLock lock(lock_);
+    EntryMap::iterator it = entries_.Get(destination);
+    if (syn_data_acked) {
+      if (it != entries_.end())
+        entries_.Erase(it);
+      return;
+    }
+    // Without a cookie, the connection is a plain three-way handshake, which
+    // says nothing about whether TCP FastOpen works to |destination|.
+    if (!sent_syn_data)
+      return;
+    // Data sent in the SYN but not acked means that something on the path
+    // doesn't handle it, so don't wait for another miss.
+    if (it == entries_.end())
+      it = entries_.Put(destination, Entry());
+    it->second.misses = kMaxFastOpenMisses;
+    it->second.last_miss = base::TimeTicks::Now();
+  }
+
+  // Records that a TCP FastOpen connection to |destination| failed to
+  // connect, e.g. because a middlebox dropped or reset its SYN.
+  void RecordConnectFailure(const IPEndPoint& destination) {
+    base::AutoLock lock(lock_);
+    EntryMap::iterator it = entries_.Get(destination);
+    if (it == entries_.end())
+      it = entries_.Put(destination, Entry());
+    ++it->second.misses;
+    it->second.last_miss = base::TimeTicks::Now();
+  }
+
+  void ResetForTesting() {
+    base::AutoLock lock(lock_);
+    entries_.Clear();
+  }
+
+ private:
+  struct Entry {
+    Entry() : misses(0) {}
+
+    int misses;
+    base::TimeTicks last_miss;
+  };
+  typedef base::MRUCache<IPEndPoint, Entry> EntryMap;
+
+  base::Lock lock_;
+  EntryMap entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(FastOpenDestinationCache);
+};
+
+base::LazyInstance<FastOpenDestinationCache>::Leaky
+    g_fast_open_destination_cache = LAZY_INSTANCE_INITIALIZER;
+
 // SetTCPNoDelay turns on/off buffering in the kernel. By default, TCP sockets
 // will wait up to 200ms for more data to complete a packet before transmitting.
 // After calling this function, the kernel will not wait. See TCP_NODELAY in
@@ -142,7 +245,7 @@ TCPClientSocketLibevent::TCPClientSocketLibevent(
       connect_os_error_(0),
       net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_SOCKET)),
       previously_disconnected_(false),
-      use_tcp_fastopen_(IsTCPFastOpenEnabled()),
+      use_tcp_fastopen_(false),
       tcp_fastopen_connected_(false),
       fast_open_status_(FAST_OPEN_STATUS_UNKNOWN) {
   net_log_.BeginEvent(NetLog::TYPE_SOCKET_ALIVE,
@@ -152,12 +255,18 @@ TCPClientSocketLibevent::TCPClientSocketLibevent(
 TCPClientSocketLibevent::~TCPClientSocketLibevent() {
   Disconnect();
   net_log_.EndEvent(NetLog::TYPE_SOCKET_ALIVE);
-  if (tcp_fastopen_connected_) {
+  if (tcp_fastopen_connected_ ||
+      fast_open_status_ == FAST_OPEN_DISABLED_FOR_DESTINATION) {
     UMA_HISTOGRAM_ENUMERATION("Net.TcpFastOpenSocketConnection",
                               fast_open_status_, FAST_OPEN_MAX_VALUE);
   }
 }
 
+// static
+void TCPClientSocketLibevent::ResetFastOpenDestinationCacheForTesting() {
+  g_fast_open_destination_cache.Get().ResetForTesting();
+}
+
 int TCPClientSocketLibevent::AdoptSocket(int socket) {
   DCHECK_EQ(socket_, kInvalidSocket);
 
@@ -298,6 +407,16 @@ int TCPClientSocketLibevent::DoConnect() {
     }
   }
 
+  // TCP FastOpen is only attempted to destinations where it hasn't been
+  // failing.
+  use_tcp_fastopen_ = false;
+  if (IsTCPFastOpenEnabled()) {
+    if (g_fast_open_destination_cache.Get().ShouldAttempt(endpoint))
+      use_tcp_fastopen_ = true;
+    else
+      fast_open_status_ = FAST_OPEN_DISABLED_FOR_DESTINATION;
+  }
+
   // Connect the socket.
   if (!use_tcp_fastopen_) {
     SockaddrStorage storage;
@@ -417,8 +536,11 @@ bool TCPClientSocketLibevent::IsConnectedAndIdle() const {
   if (socket_ == kInvalidSocket || waiting_connect())
     return false;
 
-  // TODO(wtc): should we also handle the TCP FastOpen case here,
-  // as we do in IsConnected()?
+  // With TCP FastOpen, the connection isn't made until the first write, so
+  // there can't be any unexpected data yet.  Treating the socket as idle
+  // lets socket pools keep it until it is needed.
+  if (use_tcp_fastopen_ && !tcp_fastopen_connected_)
+    return true;
 
   // Check if connection is alive and we haven't received any data
   // unexpectedly.
@@ -458,6 +580,7 @@ int TCPClientSocketLibevent::Read(IOBuffer* buf,
     int net_error = MapSystemError(errno);
     net_log_.AddEvent(NetLog::TYPE_SOCKET_READ_ERROR,
                       CreateNetLogSocketErrorCallback(net_error, errno));
+    RecordFastOpenReadError();
     return net_error;
   }
 
@@ -525,8 +648,11 @@ int TCPClientSocketLibevent::InternalWrite(IOBuffer* buf, int buf_len) {
       return -1;
     }
 
-    int flags = 0x20000000; // Magic flag to enable TCP_FASTOPEN.
+    int flags = 0;
 #if defined(OS_LINUX)
+    // MSG_FASTOPEN makes sendto() connect the socket, sending the data in the
+    // SYN if the kernel has a cookie for the server.
+    flags |= MSG_FASTOPEN;
     // sendto() will fail with EPIPE when the system doesn't support TCP Fast
     // Open. Theoretically that shouldn't happen since the caller should check
     // for system support on startup, but users may dynamically disable TCP Fast
@@ -554,6 +680,8 @@ int TCPClientSocketLibevent::InternalWrite(IOBuffer* buf, int buf_len) {
         fast_open_status_ = FAST_OPEN_SLOW_CONNECT_RETURN;
       } else {
         fast_open_status_ = FAST_OPEN_ERROR;
+        g_fast_open_destination_cache.Get().RecordConnectFailure(
+            addresses_[current_address_index_]);
       }
     } else {
       fast_open_status_ = FAST_OPEN_FAST_CONNECT_RETURN;
@@ -691,6 +819,7 @@ void TCPClientSocketLibevent::DidCompleteRead() {
     if (result != ERR_IO_PENDING) {
       net_log_.AddEvent(NetLog::TYPE_SOCKET_READ_ERROR,
                         CreateNetLogSocketErrorCallback(result, errno));
+      RecordFastOpenReadError();
     }
   }
 
@@ -722,6 +851,14 @@ void TCPClientSocketLibevent::DidCompleteWrite() {
     if (result != ERR_IO_PENDING) {
       net_log_.AddEvent(NetLog::TYPE_SOCKET_WRITE_ERROR,
                         CreateNetLogSocketErrorCallback(result, errno));
+      // The first write of a TCP FastOpen connection without a cookie is what
+      // connects the socket, so an error here means the connect failed.
+      if (use_tcp_fastopen_ &&
+          fast_open_status_ == FAST_OPEN_SLOW_CONNECT_RETURN &&
+          !use_history_.was_used_to_convey_data()) {
+        g_fast_open_destination_cache.Get().RecordConnectFailure(
+            addresses_[current_address_index_]);
+      }
     }
   }
 
@@ -780,13 +917,17 @@ void TCPClientSocketLibevent::RecordFastOpenStatus() {
         (info.tcpi_options & TCPI_OPT_SYN_DATA);
 #endif
     if (getsockopt_success) {
-      if (fast_open_status_ == FAST_OPEN_FAST_CONNECT_RETURN) {
+      bool sent_syn_data = fast_open_status_ == FAST_OPEN_FAST_CONNECT_RETURN;
+      if (sent_syn_data) {
         fast_open_status_ = (server_acked_data ? FAST_OPEN_SYN_DATA_ACK :
                              FAST_OPEN_SYN_DATA_NACK);
       } else {
         fast_open_status_ = (server_acked_data ? FAST_OPEN_NO_SYN_DATA_ACK :
                              FAST_OPEN_NO_SYN_DATA_NACK);
       }
+      g_fast_open_destination_cache.Get().RecordResult(
+          addresses_[current_address_index_], sent_syn_data,
+          server_acked_data);
     } else {
       fast_open_status_ = (fast_open_status_ == FAST_OPEN_FAST_CONNECT_RETURN ?
                            FAST_OPEN_SYN_DATA_FAILED :
@@ -795,6 +936,14 @@ void TCPClientSocketLibevent::RecordFastOpenStatus() {
   }
 }
 
+void TCPClientSocketLibevent::RecordFastOpenReadError() {
+  // A request sent in the SYN is written without waiting for the handshake,
+  // so if the connect fails, e.g. because a middlebox resets SYNs which carry
+  // data, the first read is what finds out.
+  if (use_tcp_fastopen_ && fast_open_status_ == FAST_OPEN_FAST_CONNECT_RETURN)
+    RecordFastOpenStatus();
+}
+
 const BoundNetLog& TCPClientSocketLibevent::NetLog() const {
   return net_log_;
 }
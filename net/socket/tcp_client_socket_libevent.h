@@ -31,6 +31,10 @@ class NET_EXPORT_PRIVATE TCPClientSocketLibevent : public StreamSocket,
 
   virtual ~TCPClientSocketLibevent();
 
+  // Forgets the destinations for which TCP FastOpen has been disabled, so that
+  // tests don't depend on each other's connections.
+  static void ResetFastOpenDestinationCacheForTesting();
+
   // AdoptSocket causes the given, connected socket to be adopted as a TCP
   // socket. This object must not be connected. This object takes ownership of
   // the given socket and then acts as if Connect() had been called. This
@@ -126,6 +130,10 @@ class NET_EXPORT_PRIVATE TCPClientSocketLibevent : public StreamSocket,
     // and our later probe for ack/nack state failed.
     FAST_OPEN_NO_SYN_DATA_FAILED,
 
+    // Fast open was enabled, but not attempted because recent connections to
+    // the same destination didn't get their data acked in the SYN.
+    FAST_OPEN_DISABLED_FOR_DESTINATION,
+
     FAST_OPEN_MAX_VALUE
   };
 
@@ -185,9 +193,14 @@ class NET_EXPORT_PRIVATE TCPClientSocketLibevent : public StreamSocket,
   // Internal function to write to a socket.
   int InternalWrite(IOBuffer* buf, int buf_len);
 
-  // Called when the socket is known to be in a connected state.
+  // Called when the socket is known to be in a connected state, or when it
+  // failed to connect after sending data in the SYN.
   void RecordFastOpenStatus();
 
+  // Called when a read fails, to find out whether data sent in the SYN was
+  // acked.
+  void RecordFastOpenReadError();
+
   int socket_;
 
   // Local IP address and port we are bound to. Set to NULL if Bind()
@@ -240,8 +253,9 @@ class NET_EXPORT_PRIVATE TCPClientSocketLibevent : public StreamSocket,
   // histograms.
   UseHistory use_history_;
 
-  // Enables experimental TCP FastOpen option.
-  const bool use_tcp_fastopen_;
+  // True when the experimental TCP FastOpen option is enabled and is being
+  // used for the current connection.
+  bool use_tcp_fastopen_;
 
   // True when TCP FastOpen is in use and we have done the connect.
   bool tcp_fastopen_connected_;
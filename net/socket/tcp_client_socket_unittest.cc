@@ -8,6 +8,24 @@
 
 #include "net/socket/tcp_client_socket.h"
 
+#if defined(OS_LINUX)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef TCP_FASTOPEN
+#define TCP_FASTOPEN 23
+#endif
+#endif
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/posix/eintr_wrapper.h"
+
+#include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_util.h"
@@ -19,6 +37,149 @@ namespace net {
 
 namespace {
 
+const char kRequest[] = "request";
+const char kResponse[] = "response";
+
+// Enables TCP FastOpen for the lifetime of the object, if the system supports
+// it.
+class ScopedTCPFastOpen {
+ public:
+  ScopedTCPFastOpen() {
+    SetTCPFastOpenEnabled(true);
+    ResetFastOpenDestinations();
+  }
+  ~ScopedTCPFastOpen() {
+    SetTCPFastOpenEnabled(false);
+    ResetFastOpenDestinations();
+  }
+
+ private:
+  static void ResetFastOpenDestinations() {
+#if defined(OS_POSIX)
+    TCPClientSocket::ResetFastOpenDestinationCacheForTesting();
+#endif
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedTCPFastOpen);
+};
+
+#if defined(OS_LINUX)
+// Loopback listening socket with TCP FastOpen enabled, which TCPServerSocket
+// has no option for.
+class FastOpenServer {
+ public:
+  FastOpenServer() : socket_(-1) {}
+  ~FastOpenServer() {
+    if (socket_ >= 0)
+      close(socket_);
+  }
+
+  // Returns false if the system doesn't let servers use TCP FastOpen.
+  bool Listen(IPEndPoint* address) {
+    // TFO_SERVER_ENABLE is the second bit, see SystemSupportsTCPFastOpen().
+    std::string system_enabled_tcp_fastopen;
+    if (!file_util::ReadFileToString(
+            base::FilePath("/proc/sys/net/ipv4/tcp_fastopen"),
+            &system_enabled_tcp_fastopen) ||
+        system_enabled_tcp_fastopen.empty() ||
+        (system_enabled_tcp_fastopen[0] & 0x2) == 0) {
+      return false;
+    }
+
+    socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (socket_ < 0)
+      return false;
+    int queue_length = 5;
+    if (setsockopt(socket_, IPPROTO_TCP, TCP_FASTOPEN, &queue_length,
+                   sizeof(queue_length))) {
+      return false;
+    }
+    IPAddressNumber lo_address;
+    ParseIPLiteralToNumber("127.0.0.1", &lo_address);
+    SockaddrStorage storage;
+    IPEndPoint(lo_address, 0).ToSockAddr(storage.addr, &storage.addr_len);
+    if (bind(socket_, storage.addr, storage.addr_len) || listen(socket_, 1))
+      return false;
+    if (getsockname(socket_, storage.addr, &storage.addr_len))
+      return false;
+    return address->FromSockAddr(storage.addr, storage.addr_len);
+  }
+
+  // Blocks until a connection is accepted.  The kernel completes the
+  // handshake on its own, so this doesn't need the client to make progress.
+  int Accept(scoped_ptr<StreamSocket>* accepted_socket,
+             const CompletionCallback& /* callback */) {
+    int accepted = HANDLE_EINTR(accept(socket_, NULL, NULL));
+    if (accepted < 0)
+      return ERR_FAILED;
+    scoped_ptr<TCPClientSocket> tcp_socket(
+        new TCPClientSocket(AddressList(), NULL, NetLog::Source()));
+    int result = tcp_socket->AdoptSocket(accepted);
+    if (result == OK)
+      accepted_socket->reset(tcp_socket.release());
+    return result;
+  }
+
+ private:
+  int socket_;
+
+  DISALLOW_COPY_AND_ASSIGN(FastOpenServer);
+};
+#endif  // defined(OS_LINUX)
+
+// Connects |socket| to |server|, sends a request and reads back a response,
+// so that |socket| finds out whether its request was sent in the SYN.
+// Returns the result of the request's Write().
+template <typename Server>
+int ExchangeData(Server* server, TCPClientSocket* socket) {
+  TestCompletionCallback connect_callback;
+  int result = socket->Connect(connect_callback.callback());
+  if (result == ERR_IO_PENDING)
+    result = connect_callback.WaitForResult();
+  EXPECT_EQ(OK, result);
+
+  scoped_refptr<IOBuffer> request(new StringIOBuffer(kRequest));
+  TestCompletionCallback write_callback;
+  int write_result = socket->Write(request.get(), arraysize(kRequest) - 1,
+                                   write_callback.callback());
+
+  TestCompletionCallback accept_callback;
+  scoped_ptr<StreamSocket> accepted_socket;
+  result = server->Accept(&accepted_socket, accept_callback.callback());
+  if (result == ERR_IO_PENDING)
+    result = accept_callback.WaitForResult();
+  EXPECT_EQ(OK, result);
+  if (result != OK)
+    return result;
+
+  if (write_result == ERR_IO_PENDING)
+    EXPECT_EQ(static_cast<int>(arraysize(kRequest) - 1),
+              write_callback.WaitForResult());
+
+  scoped_refptr<IOBuffer> buf(new IOBuffer(arraysize(kResponse)));
+  TestCompletionCallback read_callback;
+  result = accepted_socket->Read(buf.get(), arraysize(kResponse),
+                                 read_callback.callback());
+  if (result == ERR_IO_PENDING)
+    result = read_callback.WaitForResult();
+  EXPECT_EQ(static_cast<int>(arraysize(kRequest) - 1), result);
+
+  scoped_refptr<IOBuffer> response(new StringIOBuffer(kResponse));
+  result = accepted_socket->Write(response.get(), arraysize(kResponse) - 1,
+                                  write_callback.callback());
+  if (result == ERR_IO_PENDING)
+    result = write_callback.WaitForResult();
+  EXPECT_EQ(static_cast<int>(arraysize(kResponse) - 1), result);
+
+  result = socket->Read(buf.get(), arraysize(kResponse),
+                        read_callback.callback());
+  if (result == ERR_IO_PENDING)
+    result = read_callback.WaitForResult();
+  EXPECT_EQ(static_cast<int>(arraysize(kResponse) - 1), result);
+
+  return write_result;
+}
+
 // Try binding a socket to loopback interface and verify that we can
 // still connect to a server on the same interface.
 TEST(TCPClientSocketTest, BindLoopbackToLoopback) {
@@ -108,6 +269,127 @@ TEST(TCPClientSocketTest, BindLoopbackToIPv6) {
   EXPECT_NE(OK, result);
 }
 
+// Connect to a loopback server which doesn't enable TCP FastOpen, and verify
+// that once a request has been sent in a SYN which the server ignores, later
+// connections don't attempt TCP FastOpen, while connections which only fall
+// back to a regular handshake for lack of a cookie keep attempting it.
+TEST(TCPClientSocketTest, FastOpenFallbackIsRemembered) {
+  ScopedTCPFastOpen scoped_tcp_fastopen;
+  if (!IsTCPFastOpenEnabled()) {
+    LOG(ERROR) << "TCP FastOpen is not supported. Skipping the test";
+    return;
+  }
+
+  IPAddressNumber lo_address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &lo_address));
+  TCPServerSocket server(NULL, NetLog::Source());
+  ASSERT_EQ(OK, server.Listen(IPEndPoint(lo_address, 0), 1));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  // Whether the request is sent in the SYN depends on whether the kernel still
+  // has a cookie for the loopback address from an earlier connection.
+  bool sent_syn_data = false;
+  for (int i = 0; i < 4; ++i) {
+    TCPClientSocket socket(AddressList(server_address), NULL,
+                           NetLog::Source());
+    int write_result = ExchangeData(&server, &socket);
+    EXPECT_EQ(!sent_syn_data, socket.UsingTCPFastOpen());
+    if (socket.UsingTCPFastOpen() && write_result != ERR_IO_PENDING)
+      sent_syn_data = true;
+  }
+}
+
+// Verify that TCP FastOpen is no longer attempted to a destination once
+// connections to it have failed.
+TEST(TCPClientSocketTest, FastOpenConnectFailuresAreRemembered) {
+  ScopedTCPFastOpen scoped_tcp_fastopen;
+  if (!IsTCPFastOpenEnabled()) {
+    LOG(ERROR) << "TCP FastOpen is not supported. Skipping the test";
+    return;
+  }
+
+  // Find a loopback port which nothing listens on.
+  IPAddressNumber lo_address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &lo_address));
+  IPEndPoint closed_address;
+  {
+    TCPServerSocket server(NULL, NetLog::Source());
+    ASSERT_EQ(OK, server.Listen(IPEndPoint(lo_address, 0), 1));
+    ASSERT_EQ(OK, server.GetLocalAddress(&closed_address));
+  }
+
+  // A connection whose request is sent in the SYN fails on the first read,
+  // and one which waits for the handshake fails writing the request.  Either
+  // way, TCP FastOpen should be given up on within two connections.
+  int fast_open_connections = 0;
+  for (int i = 0; i < 3; ++i) {
+    TCPClientSocket socket(AddressList(closed_address), NULL,
+                           NetLog::Source());
+    TestCompletionCallback connect_callback;
+    int result = socket.Connect(connect_callback.callback());
+    if (result == ERR_IO_PENDING)
+      result = connect_callback.WaitForResult();
+    if (!socket.UsingTCPFastOpen()) {
+      EXPECT_NE(OK, result);
+      continue;
+    }
+
+    // With TCP FastOpen, connecting is deferred until the request is written.
+    ++fast_open_connections;
+    EXPECT_EQ(OK, result);
+    scoped_refptr<IOBuffer> request(new StringIOBuffer(kRequest));
+    TestCompletionCallback write_callback;
+    result = socket.Write(request.get(), arraysize(kRequest) - 1,
+                          write_callback.callback());
+    if (result == ERR_IO_PENDING)
+      result = write_callback.WaitForResult();
+    if (result >= 0) {
+      scoped_refptr<IOBuffer> buf(new IOBuffer(arraysize(kResponse)));
+      TestCompletionCallback read_callback;
+      result = socket.Read(buf.get(), arraysize(kResponse),
+                           read_callback.callback());
+      if (result == ERR_IO_PENDING)
+        result = read_callback.WaitForResult();
+    }
+    EXPECT_LT(result, 0);
+  }
+  EXPECT_GE(fast_open_connections, 1);
+  EXPECT_LE(fast_open_connections, 2);
+}
+
+#if defined(OS_LINUX)
+// Connect twice to a loopback server which enables TCP FastOpen.  The first
+// connection gets a cookie if the kernel doesn't have one yet, which lets the
+// second one send its request in the SYN instead of waiting a round trip for
+// the handshake.
+TEST(TCPClientSocketTest, FastOpenSavesRoundTrip) {
+  ScopedTCPFastOpen scoped_tcp_fastopen;
+  if (!IsTCPFastOpenEnabled()) {
+    LOG(ERROR) << "TCP FastOpen is not supported. Skipping the test";
+    return;
+  }
+
+  FastOpenServer server;
+  IPEndPoint server_address;
+  if (!server.Listen(&server_address)) {
+    LOG(ERROR) << "Server side TCP FastOpen is not supported. Skipping the test";
+    return;
+  }
+
+  TCPClientSocket first_socket(AddressList(server_address), NULL,
+                               NetLog::Source());
+  ExchangeData(&server, &first_socket);
+  EXPECT_TRUE(first_socket.UsingTCPFastOpen());
+
+  // The request is written without waiting for the handshake.
+  TCPClientSocket socket(AddressList(server_address), NULL, NetLog::Source());
+  EXPECT_EQ(static_cast<int>(arraysize(kRequest) - 1),
+            ExchangeData(&server, &socket));
+  EXPECT_TRUE(socket.UsingTCPFastOpen());
+}
+#endif  // defined(OS_LINUX)
+
 }  // namespace
 
 }  // namespace net
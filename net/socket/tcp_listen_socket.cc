@@ -12,6 +12,7 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include "net/base/net_errors.h"
@@ -104,6 +105,12 @@ void TCPListenSocket::Accept() {
   SocketDescriptor conn = AcceptSocket();
   if (conn == kInvalidSocket)
     return;
+  // The connections carry requests and responses, which should not wait for
+  // the acknowledgement of the previous data to be sent, as Nagle's algorithm
+  // would have them do.
+  int on = 1;
+  setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&on),
+             sizeof(on));
   scoped_refptr<TCPListenSocket> sock(
       new TCPListenSocket(conn, socket_delegate_));
   // It's up to the delegate to AddRef if it wants to keep it around.
@@ -51,9 +51,11 @@ TransportSocketParams::TransportSocketParams(
     RequestPriority priority,
     bool disable_resolver_cache,
     bool ignore_limits,
+    bool predict_demand,
     const OnHostResolutionCallback& host_resolution_callback)
     : destination_(host_port_pair),
       ignore_limits_(ignore_limits),
+      predict_demand_(predict_demand),
       host_resolution_callback_(host_resolution_callback) {
   Initialize(priority, disable_resolver_cache);
 }
@@ -91,7 +93,10 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
-      next_state_(STATE_NONE) {
+      next_state_(STATE_NONE),
+      num_pending_attempts_(0),
+      last_attempt_error_(ERR_UNEXPECTED),
+      winning_attempt_(0) {
 }
 
 TransportConnectJob::~TransportConnectJob() {
@@ -190,23 +195,17 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
 
 int TransportConnectJob::DoTransportConnect() {
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
-  transport_socket_.reset(client_socket_factory_->CreateTransportClientSocket(
-        addresses_, net_log().net_log(), net_log().source()));
-  int rv = transport_socket_->Connect(
-      base::Bind(&TransportConnectJob::OnIOComplete, base::Unretained(this)));
-  if (rv == ERR_IO_PENDING &&
-      addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
-      !AddressListOnlyContainsIPv6(addresses_)) {
-    fallback_timer_.Start(FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
-  }
-  return rv;
+  attempt_addresses_ = addresses_;
+  attempt_addresses_.InterleaveAddressFamilies();
+  return StartConnectAttempts();
 }
 
 int TransportConnectJob::DoTransportConnectComplete(int result) {
+  attempt_timer_.Stop();
   if (result == OK) {
-    bool is_ipv4 = addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV4;
+    DCHECK_LT(winning_attempt_, attempt_sockets_.size());
+    bool is_ipv4 =
+        attempt_addresses_[winning_attempt_].GetFamily() == ADDRESS_FAMILY_IPV4;
     DCHECK(!connect_timing_.connect_start.is_null());
     DCHECK(!connect_timing_.dns_start.is_null());
     base::TimeTicks now = base::TimeTicks::Now();
@@ -218,7 +217,8 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
         base::TimeDelta::FromMinutes(10),
         100);
 
-    base::TimeDelta connect_duration = now - connect_timing_.connect_start;
+    base::TimeDelta connect_duration =
+        now - attempt_start_times_[winning_attempt_];
     UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency",
         connect_duration,
         base::TimeDelta::FromMilliseconds(1),
@@ -226,11 +226,20 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
         100);
 
     if (is_ipv4) {
-      UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_No_Race",
-                                 connect_duration,
-                                 base::TimeDelta::FromMilliseconds(1),
-                                 base::TimeDelta::FromMinutes(10),
-                                 100);
+      if (winning_attempt_ > 0 &&
+          attempt_addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6) {
+        UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_Wins_Race",
+                                   connect_duration,
+                                   base::TimeDelta::FromMilliseconds(1),
+                                   base::TimeDelta::FromMinutes(10),
+                                   100);
+      } else {
+        UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_No_Race",
+                                   connect_duration,
+                                   base::TimeDelta::FromMilliseconds(1),
+                                   base::TimeDelta::FromMinutes(10),
+                                   100);
+      }
     } else {
       if (AddressListOnlyContainsIPv6(addresses_)) {
         UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv6_Solo",
@@ -246,86 +255,85 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
                                    100);
       }
     }
-    set_socket(transport_socket_.release());
-    fallback_timer_.Stop();
-  } else {
-    // Be a bit paranoid and kill off the fallback members to prevent reuse.
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
+    StreamSocket* socket = attempt_sockets_[winning_attempt_];
+    attempt_sockets_[winning_attempt_] = NULL;
+    set_socket(socket);
   }
 
+  // Be a bit paranoid and kill off the remaining attempts to prevent reuse.
+  attempt_sockets_.clear();
+  num_pending_attempts_ = 0;
   return result;
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnect() {
-  // The timer should only fire while we're waiting for the main connect to
-  // succeed.
+int TransportConnectJob::StartConnectAttempts() {
+  attempt_timer_.Stop();
+  while (attempt_sockets_.size() < attempt_addresses_.size()) {
+    size_t index = attempt_sockets_.size();
+    attempt_sockets_.push_back(
+        client_socket_factory_->CreateTransportClientSocket(
+            AddressList(attempt_addresses_[index]),
+            net_log().net_log(), net_log().source()));
+    attempt_start_times_.push_back(base::TimeTicks::Now());
+    int rv = attempt_sockets_[index]->Connect(
+        base::Bind(&TransportConnectJob::OnAttemptComplete,
+                   base::Unretained(this), index));
+    if (rv == OK) {
+      winning_attempt_ = index;
+      return OK;
+    }
+    if (rv == ERR_IO_PENDING) {
+      ++num_pending_attempts_;
+      break;
+    }
+    // Failed synchronously, so try the next address right away.
+    last_attempt_error_ = rv;
+  }
+
+  if (num_pending_attempts_ == 0)
+    return last_attempt_error_;
+
+  if (attempt_sockets_.size() < attempt_addresses_.size()) {
+    attempt_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
+        this, &TransportConnectJob::OnAttemptTimer);
+  }
+  return ERR_IO_PENDING;
+}
+
+void TransportConnectJob::OnAttemptTimer() {
+  // The timer should only fire while we're waiting for an attempt to succeed.
   if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
     NOTREACHED();
     return;
   }
 
-  DCHECK(!fallback_transport_socket_.get());
-  DCHECK(!fallback_addresses_.get());
-
-  fallback_addresses_.reset(new AddressList(addresses_));
-  MakeAddressListStartWithIPv4(fallback_addresses_.get());
-  fallback_transport_socket_.reset(
-      client_socket_factory_->CreateTransportClientSocket(
-          *fallback_addresses_, net_log().net_log(), net_log().source()));
-  fallback_connect_start_time_ = base::TimeTicks::Now();
-  int rv = fallback_transport_socket_->Connect(
-      base::Bind(
-          &TransportConnectJob::DoIPv6FallbackTransportConnectComplete,
-          base::Unretained(this)));
+  int rv = StartConnectAttempts();
   if (rv != ERR_IO_PENDING)
-    DoIPv6FallbackTransportConnectComplete(rv);
+    OnIOComplete(rv);  // Deletes |this|
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
-  // This should only happen when we're waiting for the main connect to succeed.
+void TransportConnectJob::OnAttemptComplete(size_t index, int result) {
+  // This should only happen while we're waiting for an attempt to succeed.
   if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
     NOTREACHED();
     return;
   }
 
   DCHECK_NE(ERR_IO_PENDING, result);
-  DCHECK(fallback_transport_socket_.get());
-  DCHECK(fallback_addresses_.get());
+  DCHECK_GT(num_pending_attempts_, 0u);
+  --num_pending_attempts_;
 
+  int rv = result;
   if (result == OK) {
-    DCHECK(!fallback_connect_start_time_.is_null());
-    DCHECK(!connect_timing_.dns_start.is_null());
-    base::TimeTicks now = base::TimeTicks::Now();
-    base::TimeDelta total_duration = now - connect_timing_.dns_start;
-    UMA_HISTOGRAM_CUSTOM_TIMES(
-        "Net.DNS_Resolution_And_TCP_Connection_Latency2",
-        total_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
-
-    base::TimeDelta connect_duration = now - fallback_connect_start_time_;
-    UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency",
-        connect_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
-
-    UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_Wins_Race",
-        connect_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
-    set_socket(fallback_transport_socket_.release());
-    next_state_ = STATE_NONE;
-    transport_socket_.reset();
+    winning_attempt_ = index;
   } else {
-    // Be a bit paranoid and kill off the fallback members to prevent reuse.
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
+    // Don't wait for the timer before trying the next address.
+    last_attempt_error_ = result;
+    rv = StartConnectAttempts();
   }
-  NotifyDelegateOfCompletion(result);  // Deletes |this|
+  if (rv != ERR_IO_PENDING)
+    OnIOComplete(rv);  // Deletes |this|
 }
 
 int TransportConnectJob::ConnectInternal() {
@@ -366,6 +374,7 @@ TransportClientSocketPool::TransportClientSocketPool(
             new TransportConnectJobFactory(client_socket_factory,
                                      host_resolver, net_log)) {
   base_.EnableConnectBackupJobs();
+  base_.EnablePreconnectPrediction();
 }
 
 TransportClientSocketPool::~TransportClientSocketPool() {}
@@ -389,7 +398,8 @@ int TransportClientSocketPool::RequestSocket(
   }
 
   return base_.RequestSocket(group_name, *casted_params, priority, handle,
-                             callback, net_log);
+                             callback, casted_params->get()->predict_demand(),
+                             net_log);
 }
 
 void TransportClientSocketPool::RequestSockets(
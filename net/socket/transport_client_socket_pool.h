@@ -6,10 +6,12 @@
 #define NET_SOCKET_TRANSPORT_CLIENT_SOCKET_POOL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
@@ -31,16 +33,20 @@ class NET_EXPORT_PRIVATE TransportSocketParams
  public:
   // |host_resolution_callback| will be invoked after the the hostname is
   // resolved.  If |host_resolution_callback| does not return OK, then the
-  // connection will be aborted with that value.
+  // connection will be aborted with that value.  |predict_demand| should be
+  // false when a higher-layer pool which predicts socket demand will wrap the
+  // connection, so that a burst is not preconnected in both layers.
   TransportSocketParams(
       const HostPortPair& host_port_pair,
       RequestPriority priority,
       bool disable_resolver_cache,
       bool ignore_limits,
+      bool predict_demand,
       const OnHostResolutionCallback& host_resolution_callback);
 
   const HostResolver::RequestInfo& destination() const { return destination_; }
   bool ignore_limits() const { return ignore_limits_; }
+  bool predict_demand() const { return predict_demand_; }
   const OnHostResolutionCallback& host_resolution_callback() const {
     return host_resolution_callback_;
   }
@@ -53,19 +59,22 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 
   HostResolver::RequestInfo destination_;
   bool ignore_limits_;
+  bool predict_demand_;
   const OnHostResolutionCallback host_resolution_callback_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportSocketParams);
 };
 
 // TransportConnectJob handles the host resolution necessary for socket creation
-// and the transport (likely TCP) connect. TransportConnectJob also has fallback
-// logic for IPv6 connect() timeouts (which may happen due to networks / routers
-// with broken IPv6 support). Those timeouts take 20s, so rather than make the
-// user wait 20s for the timeout to fire, we use a fallback timer
-// (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
-// fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
-// a headstart) and return the one that completes first to the socket pool.
+// and the transport (likely TCP) connect. When the host resolves to several
+// addresses, TransportConnectJob races connects to them in the style of
+// RFC 6555 ("Happy Eyeballs"): the addresses are tried in order with their
+// families interleaved, and a new connect() is started every
+// kIPv6FallbackTimerInMs, or as soon as the previous one fails, while the
+// earlier ones are still pending. This matters because connect() timeouts,
+// e.g. on networks / routers with broken IPv6 support, take 20s. The first
+// connect() to complete is returned to the socket pool and the others are
+// abandoned.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   TransportConnectJob(const std::string& group_name,
@@ -84,6 +93,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
+  // The delay between the start of consecutive connect attempts.
   static const int kIPv6FallbackTimerInMs;
 
  private:
@@ -106,8 +116,14 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   int DoTransportConnectComplete(int result);
 
   // Not part of the state machine.
-  void DoIPv6FallbackTransportConnect();
-  void DoIPv6FallbackTransportConnectComplete(int result);
+  // Starts connect attempts to the remaining addresses in
+  // |attempt_addresses_| until one of them is pending, and arms
+  // |attempt_timer_| if addresses remain after that. Returns OK if an attempt
+  // connected synchronously, ERR_IO_PENDING if any attempt is pending, or the
+  // error of the last attempt if all of them have failed.
+  int StartConnectAttempts();
+  void OnAttemptTimer();
+  void OnAttemptComplete(size_t index, int result);
 
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
@@ -120,12 +136,16 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   AddressList addresses_;
   State next_state_;
 
-  scoped_ptr<StreamSocket> transport_socket_;
-
-  scoped_ptr<StreamSocket> fallback_transport_socket_;
-  scoped_ptr<AddressList> fallback_addresses_;
-  base::TimeTicks fallback_connect_start_time_;
-  base::OneShotTimer<TransportConnectJob> fallback_timer_;
+  // |addresses_| with the address families interleaved. The socket at index i
+  // of |attempt_sockets_| connects to the address at index i, and was started
+  // at |attempt_start_times_[i]|.
+  AddressList attempt_addresses_;
+  ScopedVector<StreamSocket> attempt_sockets_;
+  std::vector<base::TimeTicks> attempt_start_times_;
+  size_t num_pending_attempts_;
+  int last_attempt_error_;
+  size_t winning_attempt_;
+  base::OneShotTimer<TransportConnectJob> attempt_timer_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportConnectJob);
 };
@@ -431,11 +431,11 @@ class TransportClientSocketPoolTest : public testing::Test {
             ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(true)),
         params_(
             new TransportSocketParams(HostPortPair("www.google.com", 80),
-                                      kDefaultPriority, false, false,
+                                      kDefaultPriority, false, false, true,
                                       OnHostResolutionCallback())),
         low_params_(
             new TransportSocketParams(HostPortPair("www.google.com", 80),
-                                      LOW, false, false,
+                                      LOW, false, false, true,
                                       OnHostResolutionCallback())),
         histograms_(new ClientSocketPoolHistograms("TCPUnitTest")),
         host_resolver_(new MockHostResolver),
@@ -455,7 +455,7 @@ class TransportClientSocketPoolTest : public testing::Test {
 
   int StartRequest(const std::string& group_name, RequestPriority priority) {
     scoped_refptr<TransportSocketParams> params(new TransportSocketParams(
-        HostPortPair("www.google.com", 80), MEDIUM, false, false,
+        HostPortPair("www.google.com", 80), MEDIUM, false, false, true,
         OnHostResolutionCallback()));
     return test_base_.StartRequestUsingPool(
         &pool_, group_name, priority, params);
@@ -579,7 +579,7 @@ TEST_F(TransportClientSocketPoolTest, InitHostResolutionFailure) {
   ClientSocketHandle handle;
   HostPortPair host_port_pair("unresolvable.host.name", 80);
   scoped_refptr<TransportSocketParams> dest(new TransportSocketParams(
-      host_port_pair, kDefaultPriority, false, false,
+      host_port_pair, kDefaultPriority, false, false, true,
       OnHostResolutionCallback()));
   EXPECT_EQ(ERR_IO_PENDING,
             handle.Init("a", dest, kDefaultPriority, callback.callback(),
@@ -854,7 +854,7 @@ class RequestSocketCallback : public TestCompletionCallbackBase {
       }
       within_callback_ = true;
       scoped_refptr<TransportSocketParams> dest(new TransportSocketParams(
-          HostPortPair("www.google.com", 80), LOWEST, false, false,
+          HostPortPair("www.google.com", 80), LOWEST, false, false, true,
           OnHostResolutionCallback()));
       int rv = handle_->Init("a", dest, LOWEST, callback(), pool_,
                              BoundNetLog());
@@ -874,7 +874,7 @@ TEST_F(TransportClientSocketPoolTest, RequestTwice) {
   ClientSocketHandle handle;
   RequestSocketCallback callback(&handle, &pool_);
   scoped_refptr<TransportSocketParams> dest(new TransportSocketParams(
-      HostPortPair("www.google.com", 80), LOWEST, false, false,
+      HostPortPair("www.google.com", 80), LOWEST, false, false, true,
       OnHostResolutionCallback()));
   int rv = handle.Init("a", dest, LOWEST, callback.callback(), &pool_,
                        BoundNetLog());
@@ -1342,6 +1342,161 @@ TEST_F(TransportClientSocketPoolTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// Test that connect attempts to several addresses are staggered, with the
+// address families interleaved, and that the first attempt to connect wins.
+TEST_F(TransportClientSocketPoolTest, StaggeredAttemptsFirstConnectedWins) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    // This is the first IPv6 socket.
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+    // This is the IPv4 socket, which is tried before the second IPv6 address.
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+    // This is the second IPv6 socket.
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 3);
+
+  host_resolver_->rules()->AddIPLiteralRule(
+      "*", "2:abcd::3:4:ff,3:abcd::3:4:ff,2.2.2.2", std::string());
+
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", low_params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  base::TimeDelta time_to_first_socket = base::TimeTicks::Now() - start_time;
+  EXPECT_TRUE(handle.is_initialized());
+  EXPECT_TRUE(handle.socket());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv6AddressSize, endpoint.address().size());
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+
+  // The winning attempt is started after two stagger delays.
+  EXPECT_GE(time_to_first_socket, base::TimeDelta::FromMilliseconds(
+      2 * TransportConnectJob::kIPv6FallbackTimerInMs));
+  VLOG(1) << "Time to first connected socket: "
+          << time_to_first_socket.InMilliseconds() << "ms";
+}
+
+// Test that a failed attempt starts the next one without waiting for the
+// stagger delay.
+TEST_F(TransportClientSocketPoolTest, FailedAttemptStartsNextAttempt) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    // This is the IPv6 socket.
+    MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET,
+    // This is the IPv4 socket.
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 2);
+
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", low_params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  base::TimeDelta time_to_first_socket = base::TimeTicks::Now() - start_time;
+  EXPECT_TRUE(handle.socket());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv4AddressSize, endpoint.address().size());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+  EXPECT_LT(time_to_first_socket, base::TimeDelta::FromMilliseconds(
+      TransportConnectJob::kIPv6FallbackTimerInMs));
+}
+
+// Test that the error of the last attempt is returned when all attempts fail.
+TEST_F(TransportClientSocketPoolTest, AllAttemptsFail) {
+  client_socket_factory_.set_client_socket_type(
+      MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET);
+
+  host_resolver_->rules()->AddIPLiteralRule(
+      "*", "2:abcd::3:4:ff,2.2.2.2,3.3.3.3", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  EXPECT_EQ(ERR_IO_PENDING,
+            handle.Init("a", low_params_, LOW, callback.callback(), &pool_,
+                        BoundNetLog()));
+  EXPECT_EQ(ERR_CONNECTION_FAILED, callback.WaitForResult());
+  EXPECT_FALSE(handle.socket());
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+}
+
+// Test that the pool only preconnects for requests whose params ask for demand
+// prediction, and not for those made on behalf of a higher-layer pool which
+// predicts the same burst itself.
+TEST_F(TransportClientSocketPoolTest, PreconnectPredictionOnlyWhenRequested) {
+  host_resolver_->set_synchronous_mode(true);
+  bool prediction_enabled =
+      ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(true);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+  ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(
+      prediction_enabled);
+
+  scoped_refptr<TransportSocketParams> layered_params(
+      new TransportSocketParams(HostPortPair("www.google.com", 80),
+                                kDefaultPriority, false, false, false,
+                                OnHostResolutionCallback()));
+
+  // Both groups need two sockets at once in each of their first two bursts.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+        &pool, "a", kDefaultPriority, params_));
+    EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+        &pool, "a", kDefaultPriority, params_));
+    EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+        &pool, "b", kDefaultPriority, layered_params));
+    EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+        &pool, "b", kDefaultPriority, layered_params));
+    ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+  }
+  EXPECT_EQ(8, client_socket_factory_.allocation_count());
+
+  // The first request of the next burst warms up a second socket in "a" only.
+  EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+      &pool, "a", kDefaultPriority, params_));
+  EXPECT_EQ(1, pool.IdleSocketCountInGroup("a"));
+  EXPECT_EQ(OK, test_base_.StartRequestUsingPool(
+      &pool, "b", kDefaultPriority, layered_params));
+  EXPECT_EQ(0, pool.IdleSocketCountInGroup("b"));
+  EXPECT_EQ(11, client_socket_factory_.allocation_count());
+  ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+}
+
 }  // namespace
 
 }  // namespace net
@@ -0,0 +1,206 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_constants.h"
+
+#include "base/basictypes.h"
+
+namespace net {
+
+// The canonical Huffman code of the HPACK draft, indexed by symbol. Symbol
+// 256 is EOS.
+const uint32 kHpackHuffmanCodes[kHpackHuffmanSymbolCount] = {
+  0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5,
+  0xfffffe6, 0xfffffe7, 0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9,
+  0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec, 0xfffffed, 0xfffffee,
+  0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+  0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9,
+  0xffffffa, 0xffffffb, 0x14, 0x3f8, 0x3f9, 0xffa,
+  0x1ff9, 0x15, 0xf8, 0x7fa, 0x3fa, 0x3fb,
+  0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+  0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b,
+  0x1c, 0x1d, 0x1e, 0x1f, 0x5c, 0xfb,
+  0x7ffc, 0x20, 0xffb, 0x3fc, 0x1ffa, 0x21,
+  0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+  0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+  0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e,
+  0x6f, 0x70, 0x71, 0x72, 0xfc, 0x73,
+  0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+  0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5,
+  0x25, 0x26, 0x27, 0x6, 0x74, 0x75,
+  0x28, 0x29, 0x2a, 0x7, 0x2b, 0x76,
+  0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+  0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd,
+  0x1ffd, 0xffffffc, 0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8,
+  0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9, 0x3fffd6, 0x7fffda,
+  0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+  0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1,
+  0x7fffe2, 0x7fffe3, 0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5,
+  0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef, 0x3fffda, 0x1fffdd,
+  0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+  0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf,
+  0x7fffeb, 0x7fffec, 0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2,
+  0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef, 0xfffea, 0x3fffe2,
+  0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+  0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2,
+  0x3fffe8, 0x1ffffec, 0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde,
+  0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed, 0x7fff2, 0x1fffe3,
+  0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+  0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3,
+  0x7ffffe4, 0x7ffffe5, 0xfffec, 0xfffff3, 0xfffed, 0x1fffe6,
+  0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3, 0x3fffea, 0x3fffeb,
+  0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+  0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8,
+  0x7ffffe9, 0x7ffffea, 0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed,
+  0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee, 0x3fffffff,
+};
+
+const uint8 kHpackHuffmanCodeLengths[kHpackHuffmanSymbolCount] = {
+  13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+  28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+  6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+  5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+  13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+  15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+  6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+  20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+  24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+  22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+  21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+  26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+  19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+  20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+  26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+  30,
+};
+
+// Symbols ordered by (code length, symbol). Since the code is canonical, the
+// codes of a given length are consecutive, starting at
+// |kHpackHuffmanDecodeTable[length].first_code|.
+const uint16 kHpackHuffmanSortedSymbols[kHpackHuffmanSymbolCount] = {
+  48, 49, 50, 97, 99, 101, 105, 111, 115, 116, 32, 37,
+  45, 46, 47, 51, 52, 53, 54, 55, 56, 57, 61, 65,
+  95, 98, 100, 102, 103, 104, 108, 109, 110, 112, 114, 117,
+  58, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76,
+  77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 89,
+  106, 107, 113, 118, 119, 120, 121, 122, 38, 42, 44, 59,
+  88, 90, 33, 34, 40, 41, 63, 39, 43, 124, 35, 62,
+  0, 36, 64, 91, 93, 126, 94, 125, 60, 96, 123, 92,
+  195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161,
+  167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, 129,
+  132, 133, 134, 136, 146, 154, 156, 160, 163, 164, 169, 170,
+  173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+  233, 1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150,
+  151, 152, 155, 157, 158, 165, 166, 168, 174, 175, 180, 182,
+  183, 188, 191, 197, 231, 239, 9, 142, 144, 145, 148, 159,
+  171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+  200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243,
+  255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245,
+  246, 247, 248, 250, 251, 252, 253, 254, 2, 3, 4, 5,
+  6, 7, 8, 11, 12, 14, 15, 16, 17, 18, 19, 20,
+  21, 23, 24, 25, 26, 27, 28, 29, 30, 31, 127, 220,
+  249, 10, 13, 22, 256,
+};
+
+const HpackHuffmanLengthInfo
+    kHpackHuffmanDecodeTable[kHpackHuffmanMaxCodeLength + 1] = {
+  { 0x0, 0, 0 },  // 0-bit codes
+  { 0x0, 0, 0 },  // 1-bit codes
+  { 0x0, 0, 0 },  // 2-bit codes
+  { 0x0, 0, 0 },  // 3-bit codes
+  { 0x0, 0, 0 },  // 4-bit codes
+  { 0x0, 0, 10 },  // 5-bit codes
+  { 0x14, 10, 26 },  // 6-bit codes
+  { 0x5c, 36, 32 },  // 7-bit codes
+  { 0xf8, 68, 6 },  // 8-bit codes
+  { 0x0, 0, 0 },  // 9-bit codes
+  { 0x3f8, 74, 5 },  // 10-bit codes
+  { 0x7fa, 79, 3 },  // 11-bit codes
+  { 0xffa, 82, 2 },  // 12-bit codes
+  { 0x1ff8, 84, 6 },  // 13-bit codes
+  { 0x3ffc, 90, 2 },  // 14-bit codes
+  { 0x7ffc, 92, 3 },  // 15-bit codes
+  { 0x0, 0, 0 },  // 16-bit codes
+  { 0x0, 0, 0 },  // 17-bit codes
+  { 0x0, 0, 0 },  // 18-bit codes
+  { 0x7fff0, 95, 3 },  // 19-bit codes
+  { 0xfffe6, 98, 8 },  // 20-bit codes
+  { 0x1fffdc, 106, 13 },  // 21-bit codes
+  { 0x3fffd2, 119, 26 },  // 22-bit codes
+  { 0x7fffd8, 145, 29 },  // 23-bit codes
+  { 0xffffea, 174, 12 },  // 24-bit codes
+  { 0x1ffffec, 186, 4 },  // 25-bit codes
+  { 0x3ffffe0, 190, 15 },  // 26-bit codes
+  { 0x7ffffde, 205, 19 },  // 27-bit codes
+  { 0xfffffe2, 224, 29 },  // 28-bit codes
+  { 0x0, 0, 0 },  // 29-bit codes
+  { 0x3ffffffc, 253, 4 },  // 30-bit codes
+};
+
+const HpackStaticEntry kHpackStaticTable[kHpackStaticTableSize] = {
+  { ":authority", 10, "", 0 },
+  { ":method", 7, "GET", 3 },
+  { ":method", 7, "POST", 4 },
+  { ":path", 5, "/", 1 },
+  { ":path", 5, "/index.html", 11 },
+  { ":scheme", 7, "http", 4 },
+  { ":scheme", 7, "https", 5 },
+  { ":status", 7, "200", 3 },
+  { ":status", 7, "204", 3 },
+  { ":status", 7, "206", 3 },
+  { ":status", 7, "304", 3 },
+  { ":status", 7, "400", 3 },
+  { ":status", 7, "404", 3 },
+  { ":status", 7, "500", 3 },
+  { "accept-charset", 14, "", 0 },
+  { "accept-encoding", 15, "gzip, deflate", 13 },
+  { "accept-language", 15, "", 0 },
+  { "accept-ranges", 13, "", 0 },
+  { "accept", 6, "", 0 },
+  { "access-control-allow-origin", 27, "", 0 },
+  { "age", 3, "", 0 },
+  { "allow", 5, "", 0 },
+  { "authorization", 13, "", 0 },
+  { "cache-control", 13, "", 0 },
+  { "content-disposition", 19, "", 0 },
+  { "content-encoding", 16, "", 0 },
+  { "content-language", 16, "", 0 },
+  { "content-length", 14, "", 0 },
+  { "content-location", 16, "", 0 },
+  { "content-range", 13, "", 0 },
+  { "content-type", 12, "", 0 },
+  { "cookie", 6, "", 0 },
+  { "date", 4, "", 0 },
+  { "etag", 4, "", 0 },
+  { "expect", 6, "", 0 },
+  { "expires", 7, "", 0 },
+  { "from", 4, "", 0 },
+  { "host", 4, "", 0 },
+  { "if-match", 8, "", 0 },
+  { "if-modified-since", 17, "", 0 },
+  { "if-none-match", 13, "", 0 },
+  { "if-range", 8, "", 0 },
+  { "if-unmodified-since", 19, "", 0 },
+  { "last-modified", 13, "", 0 },
+  { "link", 4, "", 0 },
+  { "location", 8, "", 0 },
+  { "max-forwards", 12, "", 0 },
+  { "proxy-authenticate", 18, "", 0 },
+  { "proxy-authorization", 19, "", 0 },
+  { "range", 5, "", 0 },
+  { "referer", 7, "", 0 },
+  { "refresh", 7, "", 0 },
+  { "retry-after", 11, "", 0 },
+  { "server", 6, "", 0 },
+  { "set-cookie", 10, "", 0 },
+  { "strict-transport-security", 25, "", 0 },
+  { "transfer-encoding", 17, "", 0 },
+  { "user-agent", 10, "", 0 },
+  { "vary", 4, "", 0 },
+  { "via", 3, "", 0 },
+  { "www-authenticate", 16, "", 0 },
+};
+
+}  // namespace net
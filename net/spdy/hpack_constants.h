@@ -0,0 +1,65 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_CONSTANTS_H_
+#define NET_SPDY_HPACK_CONSTANTS_H_
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+
+// Constants shared by the HPACK header compression encoder and decoder. See
+// http://tools.ietf.org/html/draft-ietf-httpbis-header-compression for the
+// format.
+
+namespace net {
+
+// The size of the header table that both endpoints start out with.
+const size_t kHpackDefaultHeaderTableSize = 4096;
+
+// The per-entry overhead added to name and value lengths when accounting for
+// the size of a header table entry.
+const size_t kHpackEntrySizeOverhead = 32;
+
+// Huffman code parameters. There are 256 octet symbols plus EOS.
+const size_t kHpackHuffmanSymbolCount = 257;
+const uint16 kHpackHuffmanEos = 256;
+const size_t kHpackHuffmanMinCodeLength = 5;
+const size_t kHpackHuffmanMaxCodeLength = 30;
+
+// Describes the block of consecutive canonical codes of one length.
+struct HpackHuffmanLengthInfo {
+  // The numerically smallest code of this length.
+  uint32 first_code;
+  // The index in |kHpackHuffmanSortedSymbols| of the symbol for |first_code|.
+  uint16 first_index;
+  // The number of codes of this length.
+  uint16 count;
+};
+
+NET_EXPORT_PRIVATE extern const uint32
+    kHpackHuffmanCodes[kHpackHuffmanSymbolCount];
+NET_EXPORT_PRIVATE extern const uint8
+    kHpackHuffmanCodeLengths[kHpackHuffmanSymbolCount];
+NET_EXPORT_PRIVATE extern const uint16
+    kHpackHuffmanSortedSymbols[kHpackHuffmanSymbolCount];
+NET_EXPORT_PRIVATE extern const HpackHuffmanLengthInfo
+    kHpackHuffmanDecodeTable[kHpackHuffmanMaxCodeLength + 1];
+
+// An entry of the static header table.
+struct HpackStaticEntry {
+  const char* name;
+  size_t name_length;
+  const char* value;
+  size_t value_length;
+};
+
+const size_t kHpackStaticTableSize = 61;
+
+// The static header table. HPACK index 1 refers to element 0.
+NET_EXPORT_PRIVATE extern const HpackStaticEntry
+    kHpackStaticTable[kHpackStaticTableSize];
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_CONSTANTS_H_
@@ -0,0 +1,173 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include "base/logging.h"
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_huffman.h"
+
+using base::StringPiece;
+
+namespace net {
+
+namespace {
+
+const size_t kIndexedPrefixLength = 7;
+const size_t kLiteralIncrementalIndexingPrefixLength = 6;
+const size_t kTableSizeUpdatePrefixLength = 5;
+const size_t kLiteralWithoutIndexingPrefixLength = 4;
+const size_t kStringPrefixLength = 7;
+const uint8 kHuffmanFlag = 0x80;
+
+}  // namespace
+
+bool HpackDecodeInteger(StringPiece* input,
+                        size_t prefix_length,
+                        size_t* value) {
+  DCHECK_GE(prefix_length, 1u);
+  DCHECK_LE(prefix_length, 8u);
+  if (input->empty())
+    return false;
+  const uint32 max_prefix_value = (1 << prefix_length) - 1;
+  uint32 result = static_cast<uint8>((*input)[0]) & max_prefix_value;
+  input->remove_prefix(1);
+  if (result < max_prefix_value) {
+    *value = result;
+    return true;
+  }
+
+  // Four continuation bytes carry 28 bits. A fifth may only carry the top
+  // bits of a 32-bit value.
+  for (size_t shift = 0; shift <= 28; shift += 7) {
+    if (input->empty())
+      return false;
+    uint8 byte = (*input)[0];
+    input->remove_prefix(1);
+    uint64 addend = static_cast<uint64>(byte & 0x7f) << shift;
+    if (addend > kuint32max - result)
+      return false;
+    result += static_cast<uint32>(addend);
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+HpackDecoder::HpackDecoder()
+    : header_table_(kHpackDefaultHeaderTableSize),
+      max_header_table_size_limit_(kHpackDefaultHeaderTableSize) {
+}
+
+HpackDecoder::~HpackDecoder() {}
+
+bool HpackDecoder::DecodeHeaderBlock(StringPiece input,
+                                     SpdyFlatHeaderBlock* headers) {
+  bool at_block_start = true;
+  while (!input.empty()) {
+    uint8 first_byte = input[0];
+    if (first_byte & 0x80) {
+      // Indexed header field.
+      size_t index = 0;
+      StringPiece name, value;
+      if (!HpackDecodeInteger(&input, kIndexedPrefixLength, &index) ||
+          !header_table_.GetEntry(index, &name, &value)) {
+        return false;
+      }
+      headers->AppendHeader(name, value);
+    } else if (first_byte & 0x40) {
+      if (!DecodeLiteral(&input, kLiteralIncrementalIndexingPrefixLength,
+                         true, headers)) {
+        return false;
+      }
+    } else if (first_byte & 0x20) {
+      // Header table size updates are only allowed before the first header.
+      size_t max_size = 0;
+      if (!at_block_start ||
+          !HpackDecodeInteger(&input, kTableSizeUpdatePrefixLength,
+                              &max_size) ||
+          max_size > max_header_table_size_limit_) {
+        return false;
+      }
+      header_table_.SetMaxSize(max_size);
+      continue;
+    } else {
+      // Literal without indexing (0000) or never indexed (0001). Neither
+      // changes the header table.
+      if (!DecodeLiteral(&input, kLiteralWithoutIndexingPrefixLength, false,
+                         headers)) {
+        return false;
+      }
+    }
+    at_block_start = false;
+  }
+  return true;
+}
+
+bool HpackDecoder::DecodeHeaderBlock(StringPiece input,
+                                     SpdyHeaderBlock* headers) {
+  flat_headers_.Clear();
+  if (!DecodeHeaderBlock(input, &flat_headers_))
+    return false;
+  flat_headers_.CopyTo(headers);
+  return true;
+}
+
+bool HpackDecoder::DecodeLiteral(StringPiece* input,
+                                 size_t prefix_length,
+                                 bool add_to_table,
+                                 SpdyFlatHeaderBlock* headers) {
+  size_t name_index = 0;
+  if (!HpackDecodeInteger(input, prefix_length, &name_index))
+    return false;
+
+  StringPiece name, value;
+  if (name_index == 0) {
+    if (!DecodeString(input, &name_buffer_, &name))
+      return false;
+  } else {
+    StringPiece unused_value;
+    if (!header_table_.GetEntry(name_index, &name, &unused_value))
+      return false;
+  }
+  if (!DecodeString(input, &value_buffer_, &value))
+    return false;
+
+  // |name| may point into the header table, which Add() can modify, so add
+  // the copy held by |headers| instead.
+  headers->AppendHeader(name, value);
+  if (add_to_table) {
+    size_t last = headers->size() - 1;
+    header_table_.Add(headers->name(last), headers->value(last));
+  }
+  return true;
+}
+
+bool HpackDecoder::DecodeString(StringPiece* input,
+                                std::string* buffer,
+                                StringPiece* str) {
+  if (input->empty())
+    return false;
+  bool huffman = (static_cast<uint8>((*input)[0]) & kHuffmanFlag) != 0;
+  size_t length = 0;
+  if (!HpackDecodeInteger(input, kStringPrefixLength, &length) ||
+      length > input->size()) {
+    return false;
+  }
+  StringPiece encoded(input->data(), length);
+  input->remove_prefix(length);
+  if (!huffman) {
+    *str = encoded;
+    return true;
+  }
+  buffer->clear();
+  if (!HpackHuffmanDecode(encoded, buffer))
+    return false;
+  *str = StringPiece(*buffer);
+  return true;
+}
+
+}  // namespace net
@@ -0,0 +1,82 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_DECODER_H_
+#define NET_SPDY_HPACK_DECODER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+#include "net/spdy/spdy_flat_header_block.h"
+#include "net/spdy/spdy_header_block.h"
+
+namespace net {
+
+// Decodes header blocks produced by an HpackEncoder. Decoded headers are
+// appended to a SpdyFlatHeaderBlock, so that once the decoder's scratch
+// buffers and the output block have grown to fit a typical header block,
+// decoding does not allocate.
+//
+// Each HpackDecoder keeps the header table state of one direction of a
+// connection. After a decoding error that state is undefined and the
+// connection must be torn down.
+class NET_EXPORT_PRIVATE HpackDecoder {
+ public:
+  HpackDecoder();
+  ~HpackDecoder();
+
+  // Decodes the complete header block in |input| and appends its headers to
+  // |headers|. Returns false if |input| is malformed.
+  bool DecodeHeaderBlock(base::StringPiece input,
+                         SpdyFlatHeaderBlock* headers);
+
+  // As above, but replaces the contents of |headers|.
+  bool DecodeHeaderBlock(base::StringPiece input, SpdyHeaderBlock* headers);
+
+  // Sets the largest header table size the encoder may switch to. This is the
+  // value advertised to the peer.
+  void set_max_header_table_size_limit(size_t limit) {
+    max_header_table_size_limit_ = limit;
+  }
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  // Decoding helpers. Each consumes from the front of |*input| and returns
+  // false on malformed input.
+  bool DecodeLiteral(base::StringPiece* input,
+                     size_t prefix_length,
+                     bool add_to_table,
+                     SpdyFlatHeaderBlock* headers);
+  bool DecodeString(base::StringPiece* input,
+                    std::string* buffer,
+                    base::StringPiece* str);
+
+  HpackHeaderTable header_table_;
+  size_t max_header_table_size_limit_;
+
+  // Scratch space for Huffman decoded names and values.
+  std::string name_buffer_;
+  std::string value_buffer_;
+
+  // Used by the SpdyHeaderBlock variant of DecodeHeaderBlock.
+  SpdyFlatHeaderBlock flat_headers_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackDecoder);
+};
+
+// Decodes an integer with a |prefix_length|-bit prefix from the front of
+// |*input|, ignoring the bits of the first byte above the prefix. Returns
+// false if |*input| is truncated or the value does not fit in 32 bits.
+// Exposed for testing.
+NET_EXPORT_PRIVATE bool HpackDecodeInteger(base::StringPiece* input,
+                                           size_t prefix_length,
+                                           size_t* value);
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_DECODER_H_
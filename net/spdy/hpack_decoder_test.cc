@@ -0,0 +1,152 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/spdy/hpack_encoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::StringPiece;
+
+namespace net {
+
+namespace {
+
+std::string HexToString(const std::string& hex) {
+  std::vector<uint8> bytes;
+  CHECK(base::HexStringToBytes(hex, &bytes));
+  return std::string(bytes.begin(), bytes.end());
+}
+
+TEST(HpackDecoderTest, DecodeInteger) {
+  std::string input = HexToString("1f9a0a");
+  StringPiece piece(input);
+  size_t value = 0;
+  EXPECT_TRUE(HpackDecodeInteger(&piece, 5, &value));
+  EXPECT_EQ(1337u, value);
+  EXPECT_TRUE(piece.empty());
+
+  // Truncated.
+  input = HexToString("1f9a");
+  piece = input;
+  EXPECT_FALSE(HpackDecodeInteger(&piece, 5, &value));
+
+  // Larger than 32 bits.
+  input = HexToString("1fffffffff7f");
+  piece = input;
+  EXPECT_FALSE(HpackDecodeInteger(&piece, 5, &value));
+}
+
+// The response examples with Huffman coding from the HPACK specification,
+// using a 256 byte header table to exercise eviction.
+TEST(HpackDecoderTest, SpecResponseExamples) {
+  HpackDecoder decoder;
+  SpdyFlatHeaderBlock headers;
+  StringPiece value;
+
+  // Starts with a table size update to 256.
+  EXPECT_TRUE(decoder.DecodeHeaderBlock(
+      HexToString("3fe101"
+                  "488264025885aec3771a4b6196d07abe941054d444a8200595040b81"
+                  "66e082a62d1bff6e919d29ad171863c78f0b97c8e9ae82ae43d3"),
+      &headers));
+  EXPECT_EQ(4u, headers.size());
+  ASSERT_TRUE(headers.GetHeader(":status", &value));
+  EXPECT_EQ("302", value);
+  ASSERT_TRUE(headers.GetHeader("location", &value));
+  EXPECT_EQ("https://www.example.com", value);
+  EXPECT_EQ(222u, decoder.header_table().size());
+
+  headers.Clear();
+  EXPECT_TRUE(decoder.DecodeHeaderBlock(
+      HexToString("4883640effc1c0bf"), &headers));
+  EXPECT_EQ(4u, headers.size());
+  ASSERT_TRUE(headers.GetHeader(":status", &value));
+  EXPECT_EQ("307", value);
+  ASSERT_TRUE(headers.GetHeader("cache-control", &value));
+  EXPECT_EQ("private", value);
+  EXPECT_EQ(222u, decoder.header_table().size());
+  EXPECT_EQ(4u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackDecoderTest, RejectsTableSizeAboveLimit) {
+  HpackDecoder decoder;
+  SpdyFlatHeaderBlock headers;
+  // 4097 exceeds the default limit.
+  EXPECT_FALSE(decoder.DecodeHeaderBlock(HexToString("3fe21f"), &headers));
+
+  decoder.set_max_header_table_size_limit(8192);
+  EXPECT_TRUE(decoder.DecodeHeaderBlock(HexToString("3fe21f"), &headers));
+  EXPECT_EQ(4097u, decoder.header_table().max_size());
+}
+
+TEST(HpackDecoderTest, RejectsLateTableSizeUpdate) {
+  HpackDecoder decoder;
+  SpdyFlatHeaderBlock headers;
+  EXPECT_FALSE(decoder.DecodeHeaderBlock(HexToString("823f01"), &headers));
+}
+
+TEST(HpackDecoderTest, RejectsMalformedInput) {
+  const char* kInputs[] = {
+    "80",        // Index zero.
+    "c0",        // Index past the end of the table.
+    "4003",      // Literal name without a value.
+    "400161",    // Truncated value length.
+    "40016101",  // Truncated value.
+    "008106",    // Invalid Huffman padding.
+  };
+  for (size_t i = 0; i < arraysize(kInputs); ++i) {
+    HpackDecoder decoder;
+    SpdyFlatHeaderBlock headers;
+    EXPECT_FALSE(decoder.DecodeHeaderBlock(HexToString(kInputs[i]), &headers))
+        << kInputs[i];
+  }
+}
+
+TEST(HpackDecoderTest, LiteralWithoutIndexing) {
+  HpackDecoder decoder;
+  SpdyFlatHeaderBlock headers;
+  // Not indexed and never indexed literals with new names.
+  EXPECT_TRUE(decoder.DecodeHeaderBlock(
+      HexToString("000161016200016301641001650166"), &headers));
+  ASSERT_EQ(3u, headers.size());
+  EXPECT_EQ("a", headers.name(0));
+  EXPECT_EQ("b", headers.value(0));
+  EXPECT_EQ("c", headers.name(1));
+  EXPECT_EQ("e", headers.name(2));
+  EXPECT_EQ(0u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackDecoderTest, RoundTrip) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+
+  SpdyHeaderBlock headers;
+  headers[":host"] = "www.example.com";
+  headers[":method"] = "GET";
+  headers[":path"] = "/";
+  headers["accept-encoding"] = "gzip, deflate";
+  headers["cookie"] = std::string("a=b\0c=d", 7);
+  headers["x-binary"] = std::string("\x00\x01\xfe\xff", 4);
+
+  for (int i = 0; i < 3; ++i) {
+    headers["x-counter"] = base::IntToString(i);
+    std::string encoded;
+    encoder.EncodeHeaderBlock(headers, &encoded);
+    SpdyHeaderBlock decoded;
+    ASSERT_TRUE(decoder.DecodeHeaderBlock(encoded, &decoded));
+    EXPECT_EQ(headers, decoded);
+    EXPECT_EQ(encoder.header_table().size(), decoder.header_table().size());
+  }
+}
+
+}  // namespace
+
+}  // namespace net
@@ -0,0 +1,146 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include "base/logging.h"
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_huffman.h"
+#include "net/spdy/spdy_flat_header_block.h"
+
+using base::StringPiece;
+
+namespace net {
+
+namespace {
+
+// First byte patterns and prefix lengths of the representations we emit.
+const uint8 kIndexedFlag = 0x80;
+const size_t kIndexedPrefixLength = 7;
+const uint8 kLiteralIncrementalIndexingFlag = 0x40;
+const size_t kLiteralIncrementalIndexingPrefixLength = 6;
+const uint8 kLiteralWithoutIndexingFlag = 0x00;
+const size_t kLiteralWithoutIndexingPrefixLength = 4;
+const uint8 kTableSizeUpdateFlag = 0x20;
+const size_t kTableSizeUpdatePrefixLength = 5;
+const uint8 kHuffmanFlag = 0x80;
+const size_t kStringPrefixLength = 7;
+
+// An integer of up to 32 bits takes at most one prefix byte and five
+// continuation bytes.
+const size_t kMaxIntegerSize = 6;
+
+void EncodeString(StringPiece str, std::string* output) {
+  size_t huffman_size = HpackHuffmanEncodedSize(str);
+  if (huffman_size < str.size()) {
+    HpackEncodeInteger(kHuffmanFlag, kStringPrefixLength, huffman_size,
+                       output);
+    HpackHuffmanEncode(str, output);
+  } else {
+    HpackEncodeInteger(0, kStringPrefixLength, str.size(), output);
+    output->append(str.data(), str.size());
+  }
+}
+
+}  // namespace
+
+void HpackEncodeInteger(uint8 first_byte_flags,
+                        size_t prefix_length,
+                        size_t value,
+                        std::string* output) {
+  DCHECK_GE(prefix_length, 1u);
+  DCHECK_LE(prefix_length, 8u);
+  const size_t max_prefix_value = (1 << prefix_length) - 1;
+  if (value < max_prefix_value) {
+    output->push_back(static_cast<char>(first_byte_flags | value));
+    return;
+  }
+  output->push_back(static_cast<char>(first_byte_flags | max_prefix_value));
+  value -= max_prefix_value;
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+HpackEncoder::HpackEncoder()
+    : header_table_(kHpackDefaultHeaderTableSize),
+      pending_table_size_update_(false) {
+}
+
+HpackEncoder::~HpackEncoder() {}
+
+void HpackEncoder::EncodeHeaderBlock(const SpdyHeaderBlock& headers,
+                                     std::string* output) {
+  if (pending_table_size_update_) {
+    HpackEncodeInteger(kTableSizeUpdateFlag, kTableSizeUpdatePrefixLength,
+                       header_table_.max_size(), output);
+    pending_table_size_update_ = false;
+  }
+  for (SpdyHeaderBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    EncodeHeader(it->first, it->second, output);
+  }
+}
+
+void HpackEncoder::EncodeFlatHeaderBlock(const SpdyFlatHeaderBlock& headers,
+                                         std::string* output) {
+  if (pending_table_size_update_) {
+    HpackEncodeInteger(kTableSizeUpdateFlag, kTableSizeUpdatePrefixLength,
+                       header_table_.max_size(), output);
+    pending_table_size_update_ = false;
+  }
+  for (size_t i = 0; i < headers.size(); ++i)
+    EncodeHeader(headers.name(i), headers.value(i), output);
+}
+
+void HpackEncoder::SetMaxHeaderTableSize(size_t max_size) {
+  header_table_.SetMaxSize(max_size);
+  pending_table_size_update_ = true;
+}
+
+// static
+size_t HpackEncoder::GetMaxEncodedSize(const SpdyHeaderBlock& headers) {
+  // Room for a table size update, then for each header a representation
+  // prefix and two string length prefixes. Strings are never Huffman coded
+  // if that would make them longer.
+  size_t size = kMaxIntegerSize;
+  for (SpdyHeaderBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    size += 3 * kMaxIntegerSize + it->first.size() + it->second.size();
+  }
+  return size;
+}
+
+void HpackEncoder::EncodeHeader(StringPiece name,
+                                StringPiece value,
+                                std::string* output) {
+  size_t name_index = 0;
+  size_t index = header_table_.Find(name, value, &name_index);
+  if (index != 0) {
+    HpackEncodeInteger(kIndexedFlag, kIndexedPrefixLength, index, output);
+    return;
+  }
+
+  // Entries that do not fit would flush the whole table, so send them
+  // without indexing.
+  if (HpackHeaderTable::EntrySize(name, value) > header_table_.max_size()) {
+    HpackEncodeInteger(kLiteralWithoutIndexingFlag,
+                       kLiteralWithoutIndexingPrefixLength, name_index,
+                       output);
+  } else {
+    HpackEncodeInteger(kLiteralIncrementalIndexingFlag,
+                       kLiteralIncrementalIndexingPrefixLength, name_index,
+                       output);
+  }
+  if (name_index == 0)
+    EncodeString(name, output);
+  EncodeString(value, output);
+
+  if (HpackHeaderTable::EntrySize(name, value) <= header_table_.max_size())
+    header_table_.Add(name, value);
+}
+
+}  // namespace net
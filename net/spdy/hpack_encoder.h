@@ -0,0 +1,67 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_ENCODER_H_
+#define NET_SPDY_HPACK_ENCODER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+#include "net/spdy/spdy_header_block.h"
+
+namespace net {
+
+class SpdyFlatHeaderBlock;
+
+// Encodes header blocks with HPACK: headers found in the header table are
+// sent as an index, other headers are sent as literals and added to the
+// table, and literal strings are Huffman coded when that makes them shorter.
+//
+// An HpackEncoder keeps the header table state of one direction of a
+// connection, so every header block it produces must be delivered, in order,
+// to a single HpackDecoder.
+class NET_EXPORT_PRIVATE HpackEncoder {
+ public:
+  HpackEncoder();
+  ~HpackEncoder();
+
+  // Appends the encoding of |headers| to |output|.
+  void EncodeHeaderBlock(const SpdyHeaderBlock& headers, std::string* output);
+  void EncodeFlatHeaderBlock(const SpdyFlatHeaderBlock& headers,
+                             std::string* output);
+
+  // Changes the size of the header table. The change is signalled to the
+  // decoder at the start of the next header block.
+  void SetMaxHeaderTableSize(size_t max_size);
+
+  // Returns an upper bound on the size of the encoding of |headers|.
+  static size_t GetMaxEncodedSize(const SpdyHeaderBlock& headers);
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  void EncodeHeader(base::StringPiece name,
+                    base::StringPiece value,
+                    std::string* output);
+
+  HpackHeaderTable header_table_;
+  bool pending_table_size_update_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackEncoder);
+};
+
+// Appends the HPACK encoding of |value| with a |prefix_length|-bit prefix to
+// |output|. The bits of the first byte above the prefix are taken from
+// |first_byte_flags|. Exposed for testing.
+NET_EXPORT_PRIVATE void HpackEncodeInteger(uint8 first_byte_flags,
+                                           size_t prefix_length,
+                                           size_t value,
+                                           std::string* output);
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_ENCODER_H_
@@ -0,0 +1,109 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/spdy_flat_header_block.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+std::string HexToString(const std::string& hex) {
+  std::vector<uint8> bytes;
+  CHECK(base::HexStringToBytes(hex, &bytes));
+  return std::string(bytes.begin(), bytes.end());
+}
+
+TEST(HpackEncoderTest, EncodeInteger) {
+  std::string output;
+  HpackEncodeInteger(0, 5, 10, &output);
+  EXPECT_EQ(HexToString("0a"), output);
+
+  output.clear();
+  HpackEncodeInteger(0, 5, 1337, &output);
+  EXPECT_EQ(HexToString("1f9a0a"), output);
+
+  output.clear();
+  HpackEncodeInteger(0x80, 7, 127, &output);
+  EXPECT_EQ(HexToString("ff00"), output);
+}
+
+// The request examples with Huffman coding from the HPACK specification.
+TEST(HpackEncoderTest, SpecRequestExamples) {
+  HpackEncoder encoder;
+  SpdyFlatHeaderBlock headers;
+  std::string output;
+
+  headers.AppendHeader(":method", "GET");
+  headers.AppendHeader(":scheme", "http");
+  headers.AppendHeader(":path", "/");
+  headers.AppendHeader(":authority", "www.example.com");
+  encoder.EncodeFlatHeaderBlock(headers, &output);
+  EXPECT_EQ(HexToString("828684418cf1e3c2e5f23a6ba0ab90f4ff"), output);
+  EXPECT_EQ(57u, encoder.header_table().size());
+
+  headers.AppendHeader("cache-control", "no-cache");
+  output.clear();
+  encoder.EncodeFlatHeaderBlock(headers, &output);
+  EXPECT_EQ(HexToString("828684be5886a8eb10649cbf"), output);
+  EXPECT_EQ(110u, encoder.header_table().size());
+
+  headers.Clear();
+  headers.AppendHeader(":method", "GET");
+  headers.AppendHeader(":scheme", "https");
+  headers.AppendHeader(":path", "/index.html");
+  headers.AppendHeader(":authority", "www.example.com");
+  headers.AppendHeader("custom-key", "custom-value");
+  output.clear();
+  encoder.EncodeFlatHeaderBlock(headers, &output);
+  EXPECT_EQ(HexToString("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"),
+            output);
+  EXPECT_EQ(164u, encoder.header_table().size());
+}
+
+TEST(HpackEncoderTest, OversizedEntryIsNotIndexed) {
+  HpackEncoder encoder;
+  encoder.SetMaxHeaderTableSize(64);
+  SpdyHeaderBlock headers;
+  headers["x-small"] = "1";
+  headers["x-large"] = std::string(64, '\xff');
+
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  // A table size update of 64 leads the block.
+  EXPECT_EQ('\x3f', output[0]);
+  EXPECT_EQ('\x21', output[1]);
+  EXPECT_EQ(1u, encoder.header_table().dynamic_entry_count());
+  EXPECT_LE(output.size(), HpackEncoder::GetMaxEncodedSize(headers));
+
+  // The size update is only sent once.
+  output.clear();
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_NE('\x3f', output[0]);
+}
+
+TEST(HpackEncoderTest, MaxEncodedSize) {
+  HpackEncoder encoder;
+  SpdyHeaderBlock headers;
+  // Octets with long Huffman codes are sent as raw literals.
+  headers[std::string(200, '\x01')] = std::string(5000, '\xfe');
+  headers["x-header"] = "value";
+
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_LE(output.size(), HpackEncoder::GetMaxEncodedSize(headers));
+}
+
+}  // namespace
+
+}  // namespace net
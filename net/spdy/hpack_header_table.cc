@@ -0,0 +1,100 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_header_table.h"
+
+#include "base/logging.h"
+#include "net/spdy/hpack_constants.h"
+
+using base::StringPiece;
+
+namespace net {
+
+HpackHeaderTable::HpackHeaderTable(size_t max_size)
+    : size_(0),
+      max_size_(max_size) {
+}
+
+HpackHeaderTable::~HpackHeaderTable() {}
+
+size_t HpackHeaderTable::GetLastIndex() const {
+  return kHpackStaticTableSize + dynamic_entries_.size();
+}
+
+bool HpackHeaderTable::GetEntry(size_t index,
+                                StringPiece* name,
+                                StringPiece* value) const {
+  if (index == 0 || index > GetLastIndex())
+    return false;
+  if (index <= kHpackStaticTableSize) {
+    const HpackStaticEntry& entry = kHpackStaticTable[index - 1];
+    name->set(entry.name, entry.name_length);
+    value->set(entry.value, entry.value_length);
+    return true;
+  }
+  const Entry& entry = dynamic_entries_[index - kHpackStaticTableSize - 1];
+  *name = entry.name;
+  *value = entry.value;
+  return true;
+}
+
+size_t HpackHeaderTable::Find(StringPiece name,
+                              StringPiece value,
+                              size_t* name_index) const {
+  *name_index = 0;
+  for (size_t i = 0; i < kHpackStaticTableSize; ++i) {
+    const HpackStaticEntry& entry = kHpackStaticTable[i];
+    if (name != StringPiece(entry.name, entry.name_length))
+      continue;
+    if (value == StringPiece(entry.value, entry.value_length))
+      return i + 1;
+    if (*name_index == 0)
+      *name_index = i + 1;
+  }
+  for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
+    const Entry& entry = dynamic_entries_[i];
+    if (name != entry.name)
+      continue;
+    if (value == entry.value)
+      return kHpackStaticTableSize + i + 1;
+    if (*name_index == 0)
+      *name_index = kHpackStaticTableSize + i + 1;
+  }
+  return 0;
+}
+
+// static
+size_t HpackHeaderTable::EntrySize(StringPiece name, StringPiece value) {
+  return name.size() + value.size() + kHpackEntrySizeOverhead;
+}
+
+void HpackHeaderTable::Add(StringPiece name, StringPiece value) {
+  size_t entry_size = EntrySize(name, value);
+  if (entry_size > max_size_) {
+    Evict(0);
+    return;
+  }
+  Evict(max_size_ - entry_size);
+  dynamic_entries_.push_front(Entry());
+  Entry& entry = dynamic_entries_.front();
+  name.CopyToString(&entry.name);
+  value.CopyToString(&entry.value);
+  size_ += entry_size;
+}
+
+void HpackHeaderTable::SetMaxSize(size_t max_size) {
+  max_size_ = max_size;
+  Evict(max_size_);
+}
+
+void HpackHeaderTable::Evict(size_t target_size) {
+  while (size_ > target_size) {
+    DCHECK(!dynamic_entries_.empty());
+    const Entry& oldest = dynamic_entries_.back();
+    size_ -= EntrySize(oldest.name, oldest.value);
+    dynamic_entries_.pop_back();
+  }
+}
+
+}  // namespace net
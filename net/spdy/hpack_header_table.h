@@ -0,0 +1,81 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_HEADER_TABLE_H_
+#define NET_SPDY_HPACK_HEADER_TABLE_H_
+
+#include <deque>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// The HPACK header table: the static table followed by a dynamic table of
+// recently seen headers, addressed together by 1-based index. Index 1 is the
+// first static entry and the first dynamic entry, which is the most recently
+// added, follows the last static entry.
+//
+// The encoder and the decoder of a connection each keep a table and must
+// apply the same sequence of Add() and SetMaxSize() calls to stay in sync.
+class NET_EXPORT_PRIVATE HpackHeaderTable {
+ public:
+  explicit HpackHeaderTable(size_t max_size);
+  ~HpackHeaderTable();
+
+  // Returns the number of entries in the dynamic table.
+  size_t dynamic_entry_count() const { return dynamic_entries_.size(); }
+
+  // Returns the sum of the sizes of the dynamic entries, as defined by HPACK.
+  size_t size() const { return size_; }
+  size_t max_size() const { return max_size_; }
+
+  // Returns the largest valid index.
+  size_t GetLastIndex() const;
+
+  // Looks up the entry at |index|. Returns false if |index| is invalid. The
+  // returned pieces are valid until the next call to Add() or SetMaxSize().
+  bool GetEntry(size_t index,
+                base::StringPiece* name,
+                base::StringPiece* value) const;
+
+  // Returns the index of an entry equal to |name| and |value|, or 0 if there
+  // is none. If no exact match is found, |*name_index| is set to the index of
+  // an entry with the same name, or 0.
+  size_t Find(base::StringPiece name,
+              base::StringPiece value,
+              size_t* name_index) const;
+
+  // Returns the size of an entry, as defined by HPACK.
+  static size_t EntrySize(base::StringPiece name, base::StringPiece value);
+
+  // Adds an entry to the front of the dynamic table, evicting the oldest
+  // entries as needed. An entry larger than |max_size()| empties the table
+  // and is not added.
+  void Add(base::StringPiece name, base::StringPiece value);
+
+  // Changes the maximum size of the dynamic table, evicting entries as needed.
+  void SetMaxSize(size_t max_size);
+
+ private:
+  struct Entry {
+    std::string name;
+    std::string value;
+  };
+
+  void Evict(size_t target_size);
+
+  // Newest entries are at the front.
+  std::deque<Entry> dynamic_entries_;
+  size_t size_;
+  size_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackHeaderTable);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_HEADER_TABLE_H_
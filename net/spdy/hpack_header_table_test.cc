@@ -0,0 +1,88 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_header_table.h"
+
+#include <string>
+
+#include "net/spdy/hpack_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::StringPiece;
+
+namespace net {
+
+namespace {
+
+TEST(HpackHeaderTableTest, StaticTable) {
+  HpackHeaderTable table(kHpackDefaultHeaderTableSize);
+  EXPECT_EQ(kHpackStaticTableSize, table.GetLastIndex());
+
+  StringPiece name, value;
+  EXPECT_FALSE(table.GetEntry(0, &name, &value));
+  ASSERT_TRUE(table.GetEntry(2, &name, &value));
+  EXPECT_EQ(":method", name);
+  EXPECT_EQ("GET", value);
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize, &name, &value));
+  EXPECT_EQ("www-authenticate", name);
+  EXPECT_EQ("", value);
+  EXPECT_FALSE(table.GetEntry(kHpackStaticTableSize + 1, &name, &value));
+
+  size_t name_index = 0;
+  EXPECT_EQ(3u, table.Find(":method", "POST", &name_index));
+  EXPECT_EQ(0u, table.Find(":method", "PUT", &name_index));
+  EXPECT_EQ(2u, name_index);
+  EXPECT_EQ(0u, table.Find("x-custom", "value", &name_index));
+  EXPECT_EQ(0u, name_index);
+}
+
+TEST(HpackHeaderTableTest, AddAndFind) {
+  HpackHeaderTable table(kHpackDefaultHeaderTableSize);
+  table.Add("x-first", "1");
+  table.Add("x-second", "2");
+  EXPECT_EQ(2u, table.dynamic_entry_count());
+  EXPECT_EQ(HpackHeaderTable::EntrySize("x-first", "1") +
+                HpackHeaderTable::EntrySize("x-second", "2"),
+            table.size());
+
+  // The newest entry has the lowest dynamic index.
+  StringPiece name, value;
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 1, &name, &value));
+  EXPECT_EQ("x-second", name);
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 2, &name, &value));
+  EXPECT_EQ("x-first", name);
+
+  size_t name_index = 0;
+  EXPECT_EQ(kHpackStaticTableSize + 2,
+            table.Find("x-first", "1", &name_index));
+  EXPECT_EQ(0u, table.Find("x-first", "3", &name_index));
+  EXPECT_EQ(kHpackStaticTableSize + 2, name_index);
+}
+
+TEST(HpackHeaderTableTest, Eviction) {
+  // Room for exactly two entries of this size.
+  const size_t kEntrySize = HpackHeaderTable::EntrySize("x-a", "1");
+  HpackHeaderTable table(2 * kEntrySize);
+  table.Add("x-a", "1");
+  table.Add("x-b", "2");
+  table.Add("x-c", "3");
+  EXPECT_EQ(2u, table.dynamic_entry_count());
+  EXPECT_EQ(2 * kEntrySize, table.size());
+  size_t name_index = 0;
+  EXPECT_EQ(0u, table.Find("x-a", "1", &name_index));
+  EXPECT_NE(0u, table.Find("x-c", "3", &name_index));
+
+  table.SetMaxSize(kEntrySize);
+  EXPECT_EQ(1u, table.dynamic_entry_count());
+  EXPECT_EQ(0u, table.Find("x-b", "2", &name_index));
+
+  // An entry larger than the table empties it.
+  table.Add("x-d", std::string(2 * kEntrySize, 'x'));
+  EXPECT_EQ(0u, table.dynamic_entry_count());
+  EXPECT_EQ(0u, table.size());
+}
+
+}  // namespace
+
+}  // namespace net
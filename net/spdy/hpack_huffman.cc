@@ -0,0 +1,90 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_huffman.h"
+
+#include "base/logging.h"
+#include "net/spdy/hpack_constants.h"
+
+namespace net {
+
+size_t HpackHuffmanEncodedSize(base::StringPiece input) {
+  size_t bit_count = 0;
+  for (size_t i = 0; i < input.size(); ++i)
+    bit_count += kHpackHuffmanCodeLengths[static_cast<uint8>(input[i])];
+  return (bit_count + 7) / 8;
+}
+
+void HpackHuffmanEncode(base::StringPiece input, std::string* output) {
+  output->reserve(output->size() + HpackHuffmanEncodedSize(input));
+
+  // Codes are at most 30 bits long, and fewer than 8 bits are left in
+  // |bits| after each flush, so 64 bits never overflow.
+  uint64 bits = 0;
+  size_t bit_count = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    uint8 symbol = static_cast<uint8>(input[i]);
+    size_t length = kHpackHuffmanCodeLengths[symbol];
+    bits = (bits << length) | kHpackHuffmanCodes[symbol];
+    bit_count += length;
+    while (bit_count >= 8) {
+      bit_count -= 8;
+      output->push_back(static_cast<char>(bits >> bit_count));
+    }
+  }
+  if (bit_count > 0) {
+    // Pad with the high bits of EOS, which are all ones.
+    size_t padding = 8 - bit_count;
+    bits = (bits << padding) | ((1 << padding) - 1);
+    output->push_back(static_cast<char>(bits));
+  }
+}
+
+bool HpackHuffmanDecode(base::StringPiece input, std::string* output) {
+  uint64 bits = 0;
+  size_t bit_count = 0;
+  size_t next_byte = 0;
+  while (true) {
+    // Keep at least |kHpackHuffmanMaxCodeLength| bits buffered while input
+    // remains.
+    while (bit_count <= 56 && next_byte < input.size()) {
+      bits = (bits << 8) | static_cast<uint8>(input[next_byte++]);
+      bit_count += 8;
+    }
+
+    // Find the length of the code at the head of |bits|. Codes of each
+    // length are consecutive, so a code matches if it falls inside the
+    // range for its length.
+    bool matched = false;
+    for (size_t length = kHpackHuffmanMinCodeLength;
+         length <= kHpackHuffmanMaxCodeLength && length <= bit_count;
+         ++length) {
+      const HpackHuffmanLengthInfo& info = kHpackHuffmanDecodeTable[length];
+      uint32 code = static_cast<uint32>(
+          (bits >> (bit_count - length)) & ((GG_UINT64_C(1) << length) - 1));
+      if (code - info.first_code < info.count) {
+        uint16 symbol =
+            kHpackHuffmanSortedSymbols[info.first_index + code -
+                                       info.first_code];
+        if (symbol == kHpackHuffmanEos)
+          return false;
+        output->push_back(static_cast<char>(symbol));
+        bit_count -= length;
+        matched = true;
+        break;
+      }
+    }
+    if (matched)
+      continue;
+
+    // No complete code remains. This is only valid at the end of the input,
+    // and the leftover bits must be padding: fewer than eight ones.
+    if (next_byte < input.size() || bit_count > 7)
+      return false;
+    uint64 padding_mask = (GG_UINT64_C(1) << bit_count) - 1;
+    return (bits & padding_mask) == padding_mask;
+  }
+}
+
+}  // namespace net
@@ -0,0 +1,34 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_HUFFMAN_H_
+#define NET_SPDY_HPACK_HUFFMAN_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// Returns the number of bytes |input| occupies once Huffman encoded with the
+// HPACK code, including padding.
+NET_EXPORT_PRIVATE size_t HpackHuffmanEncodedSize(base::StringPiece input);
+
+// Appends the Huffman encoding of |input| to |output|. The final byte is
+// padded with the most significant bits of EOS.
+NET_EXPORT_PRIVATE void HpackHuffmanEncode(base::StringPiece input,
+                                           std::string* output);
+
+// Appends the decoding of the Huffman encoded |input| to |output|. Returns
+// false if |input| contains an invalid code, an explicit EOS, or padding
+// which is longer than seven bits or not a prefix of EOS. |output| may have
+// been partially appended to on failure.
+NET_EXPORT_PRIVATE bool HpackHuffmanDecode(base::StringPiece input,
+                                           std::string* output);
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_HUFFMAN_H_
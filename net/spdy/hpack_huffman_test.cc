@@ -0,0 +1,92 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_huffman.h"
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+std::string HexToString(const std::string& hex) {
+  std::vector<uint8> bytes;
+  CHECK(base::HexStringToBytes(hex, &bytes));
+  return std::string(bytes.begin(), bytes.end());
+}
+
+// Examples from the HPACK specification.
+TEST(HpackHuffmanTest, SpecExamples) {
+  struct {
+    const char* plain;
+    const char* encoded;
+  } kExamples[] = {
+    { "www.example.com", "f1e3c2e5f23a6ba0ab90f4ff" },
+    { "no-cache", "a8eb10649cbf" },
+    { "custom-key", "25a849e95ba97d7f" },
+    { "custom-value", "25a849e95bb8e8b4bf" },
+    { "302", "6402" },
+    { "private", "aec3771a4b" },
+    { "Mon, 21 Oct 2013 20:13:21 GMT",
+      "d07abe941054d444a8200595040b8166e082a62d1bff" },
+  };
+  for (size_t i = 0; i < arraysize(kExamples); ++i) {
+    std::string expected = HexToString(kExamples[i].encoded);
+    EXPECT_EQ(expected.size(), HpackHuffmanEncodedSize(kExamples[i].plain));
+
+    std::string encoded;
+    HpackHuffmanEncode(kExamples[i].plain, &encoded);
+    EXPECT_EQ(expected, encoded) << kExamples[i].plain;
+
+    std::string decoded;
+    EXPECT_TRUE(HpackHuffmanDecode(expected, &decoded));
+    EXPECT_EQ(kExamples[i].plain, decoded);
+  }
+}
+
+TEST(HpackHuffmanTest, RoundTripAllOctets) {
+  std::string plain;
+  for (int i = 0; i < 256; ++i)
+    plain.push_back(static_cast<char>(i));
+  plain.append(plain.rbegin(), plain.rend());
+
+  std::string encoded;
+  HpackHuffmanEncode(plain, &encoded);
+  EXPECT_EQ(HpackHuffmanEncodedSize(plain), encoded.size());
+
+  std::string decoded;
+  EXPECT_TRUE(HpackHuffmanDecode(encoded, &decoded));
+  EXPECT_EQ(plain, decoded);
+}
+
+TEST(HpackHuffmanTest, Empty) {
+  EXPECT_EQ(0u, HpackHuffmanEncodedSize(""));
+  std::string decoded;
+  EXPECT_TRUE(HpackHuffmanDecode("", &decoded));
+  EXPECT_TRUE(decoded.empty());
+}
+
+TEST(HpackHuffmanTest, InvalidPadding) {
+  std::string decoded;
+  // "0" is the five bit code 00000. Padding must be all ones.
+  EXPECT_TRUE(HpackHuffmanDecode(HexToString("07"), &decoded));
+  EXPECT_EQ("0", decoded);
+  EXPECT_FALSE(HpackHuffmanDecode(HexToString("06"), &decoded));
+
+  // Padding longer than seven bits is rejected.
+  EXPECT_FALSE(HpackHuffmanDecode(HexToString("07ff"), &decoded));
+
+  // An explicit EOS symbol is rejected.
+  EXPECT_FALSE(HpackHuffmanDecode(HexToString("fffffffc"), &decoded));
+}
+
+}  // namespace
+
+}  // namespace net
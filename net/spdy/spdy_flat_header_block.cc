@@ -0,0 +1,88 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_flat_header_block.h"
+
+#include "base/logging.h"
+
+using base::StringPiece;
+
+namespace net {
+
+SpdyFlatHeaderBlock::SpdyFlatHeaderBlock() {}
+
+SpdyFlatHeaderBlock::~SpdyFlatHeaderBlock() {}
+
+StringPiece SpdyFlatHeaderBlock::name(size_t i) const {
+  DCHECK_LT(i, entries_.size());
+  const Entry& entry = entries_[i];
+  return StringPiece(arena_.data() + entry.offset, entry.name_length);
+}
+
+StringPiece SpdyFlatHeaderBlock::value(size_t i) const {
+  DCHECK_LT(i, entries_.size());
+  const Entry& entry = entries_[i];
+  return StringPiece(arena_.data() + entry.offset + entry.name_length,
+                     entry.value_length);
+}
+
+void SpdyFlatHeaderBlock::AppendHeader(StringPiece name, StringPiece value) {
+  Entry entry;
+  entry.offset = arena_.size();
+  entry.name_length = name.size();
+  entry.value_length = value.size();
+  arena_.append(name.data(), name.size());
+  arena_.append(value.data(), value.size());
+  entries_.push_back(entry);
+}
+
+bool SpdyFlatHeaderBlock::GetHeader(StringPiece name,
+                                    StringPiece* value) const {
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (this->name(i) == name) {
+      *value = this->value(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+void SpdyFlatHeaderBlock::Clear() {
+  // clear() keeps the capacity of both containers.
+  arena_.clear();
+  entries_.clear();
+}
+
+void SpdyFlatHeaderBlock::Reserve(size_t header_count, size_t arena_bytes) {
+  entries_.reserve(header_count);
+  arena_.reserve(arena_bytes);
+}
+
+void SpdyFlatHeaderBlock::CopyFrom(const SpdyHeaderBlock& headers) {
+  Clear();
+  size_t arena_bytes = 0;
+  for (SpdyHeaderBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    arena_bytes += it->first.size() + it->second.size();
+  }
+  Reserve(headers.size(), arena_bytes);
+  for (SpdyHeaderBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    AppendHeader(it->first, it->second);
+  }
+}
+
+void SpdyFlatHeaderBlock::CopyTo(SpdyHeaderBlock* headers) const {
+  headers->clear();
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    std::pair<SpdyHeaderBlock::iterator, bool> result = headers->insert(
+        std::make_pair(name(i).as_string(), std::string()));
+    std::string* stored_value = &result.first->second;
+    if (!result.second)
+      stored_value->push_back('\0');
+    value(i).AppendToString(stored_value);
+  }
+}
+
+}  // namespace net
@@ -0,0 +1,78 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_SPDY_FLAT_HEADER_BLOCK_H_
+#define NET_SPDY_SPDY_FLAT_HEADER_BLOCK_H_
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/spdy_header_block.h"
+
+namespace net {
+
+// A list of header name/value pairs stored back to back in a single arena.
+// Unlike SpdyHeaderBlock, appending a header does not allocate a node or
+// strings of its own, and Clear() keeps the arena so that a block which is
+// reused for each frame stops allocating once it has grown to its working
+// size.
+//
+// Headers are kept in insertion order and names may repeat. Lookup by name is
+// a linear scan, which is cheap for the handful of headers in a typical
+// block.
+class NET_EXPORT_PRIVATE SpdyFlatHeaderBlock {
+ public:
+  SpdyFlatHeaderBlock();
+  ~SpdyFlatHeaderBlock();
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  // Returns the number of bytes of names and values stored.
+  size_t arena_size() const { return arena_.size(); }
+
+  // The returned pieces are valid until the block is next modified.
+  base::StringPiece name(size_t i) const;
+  base::StringPiece value(size_t i) const;
+
+  void AppendHeader(base::StringPiece name, base::StringPiece value);
+
+  // Sets |*value| to the value of the first header named |name|. Returns false
+  // if there is no such header.
+  bool GetHeader(base::StringPiece name, base::StringPiece* value) const;
+
+  // Removes all headers without releasing memory.
+  void Clear();
+
+  // Preallocates room for |header_count| headers with |arena_bytes| bytes of
+  // names and values.
+  void Reserve(size_t header_count, size_t arena_bytes);
+
+  // Replaces the contents of this block with the headers of |headers|.
+  void CopyFrom(const SpdyHeaderBlock& headers);
+
+  // Replaces the contents of |headers| with the headers of this block.
+  // Values of repeated names are joined with '\0', as in SPDY header blocks.
+  void CopyTo(SpdyHeaderBlock* headers) const;
+
+ private:
+  struct Entry {
+    size_t offset;
+    size_t name_length;
+    size_t value_length;
+  };
+
+  // Names and values, with each value immediately following its name.
+  std::string arena_;
+  std::vector<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpdyFlatHeaderBlock);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_SPDY_FLAT_HEADER_BLOCK_H_
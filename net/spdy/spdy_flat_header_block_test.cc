@@ -0,0 +1,76 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_flat_header_block.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::StringPiece;
+
+namespace net {
+
+namespace {
+
+TEST(SpdyFlatHeaderBlockTest, AppendAndGet) {
+  SpdyFlatHeaderBlock block;
+  EXPECT_TRUE(block.empty());
+  block.AppendHeader(":status", "200");
+  block.AppendHeader("content-type", "text/html");
+  EXPECT_EQ(2u, block.size());
+  EXPECT_EQ(":status", block.name(0));
+  EXPECT_EQ("200", block.value(0));
+  EXPECT_EQ("content-type", block.name(1));
+  EXPECT_EQ("text/html", block.value(1));
+
+  StringPiece value;
+  EXPECT_TRUE(block.GetHeader("content-type", &value));
+  EXPECT_EQ("text/html", value);
+  EXPECT_FALSE(block.GetHeader("content-length", &value));
+}
+
+TEST(SpdyFlatHeaderBlockTest, ClearKeepsCapacity) {
+  SpdyFlatHeaderBlock block;
+  block.Reserve(4, 64);
+  block.AppendHeader("a", "b");
+  block.Clear();
+  EXPECT_TRUE(block.empty());
+  EXPECT_EQ(0u, block.arena_size());
+  block.AppendHeader("c", "d");
+  EXPECT_EQ("c", block.name(0));
+  EXPECT_EQ("d", block.value(0));
+}
+
+TEST(SpdyFlatHeaderBlockTest, ConvertToAndFromSpdyHeaderBlock) {
+  SpdyHeaderBlock headers;
+  headers["alpha"] = "beta";
+  headers["gamma"] = std::string("x\0y", 3);
+
+  SpdyFlatHeaderBlock block;
+  block.CopyFrom(headers);
+  EXPECT_EQ(2u, block.size());
+
+  SpdyHeaderBlock copy;
+  block.CopyTo(&copy);
+  EXPECT_EQ(headers, copy);
+}
+
+TEST(SpdyFlatHeaderBlockTest, CopyToJoinsRepeatedNames) {
+  SpdyFlatHeaderBlock block;
+  block.AppendHeader("cookie", "a=b");
+  block.AppendHeader("accept", "*/*");
+  block.AppendHeader("cookie", "c=d");
+
+  SpdyHeaderBlock headers;
+  headers["stale"] = "value";
+  block.CopyTo(&headers);
+  EXPECT_EQ(2u, headers.size());
+  EXPECT_EQ(std::string("a=b\0c=d", 7), headers["cookie"]);
+  EXPECT_EQ("*/*", headers["accept"]);
+}
+
+}  // namespace
+
+}  // namespace net
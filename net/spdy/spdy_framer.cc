@@ -12,6 +12,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/stats_counters.h"
 #include "base/third_party/valgrind/memcheck.h"
+#include "net/spdy/hpack_decoder.h"
+#include "net/spdy/hpack_encoder.h"
 #include "net/spdy/spdy_frame_builder.h"
 #include "net/spdy/spdy_frame_reader.h"
 #include "net/spdy/spdy_bitmasks.h"
@@ -117,6 +119,7 @@ SpdyCredential::~SpdyCredential() {}
 SpdyFramer::SpdyFramer(SpdyMajorVersion version)
     : current_frame_buffer_(new char[kControlFrameBufferSize]),
       enable_compression_(true),
+      header_encoding_(HEADER_ENCODING_ZLIB),
       visitor_(NULL),
       debug_visitor_(NULL),
       display_protocol_("SPDY"),
@@ -149,6 +152,7 @@ void SpdyFramer::Reset() {
   current_frame_length_ = 0;
   current_frame_stream_id_ = kInvalidStream;
   settings_scratch_.Reset();
+  hpack_header_block_.clear();
 }
 
 size_t SpdyFramer::GetDataFrameMinimumSize() const {
@@ -1231,7 +1235,13 @@ size_t SpdyFramer::ProcessControlFrameHeaderBlock(const char* data,
   }
   size_t process_bytes = std::min(data_len, remaining_data_length_);
   if (process_bytes > 0) {
-    if (enable_compression_) {
+    if (UsesHpack()) {
+      hpack_header_block_.append(data, process_bytes);
+      if (process_bytes == remaining_data_length_) {
+        processed_successfully =
+            DeliverHpackControlFrameHeaderData(current_frame_stream_id_);
+      }
+    } else if (enable_compression_) {
       processed_successfully = IncrementallyDecompressControlFrameHeaderData(
           current_frame_stream_id_, data, process_bytes);
     } else {
@@ -2108,6 +2118,8 @@ size_t SpdyFramer::GetSerializedLength(const SpdyHeaderBlock& headers) {
   if (!enable_compression_) {
     return uncompressed_length;
   }
+  if (UsesHpack())
+    return HpackEncoder::GetMaxEncodedSize(headers);
   z_stream* compressor = GetHeaderCompressor();
   // Since we'll be performing lots of flushes when compressing the data,
   // zlib's lower bounds may be insufficient.
@@ -2174,6 +2186,43 @@ z_stream* SpdyFramer::GetHeaderDecompressor() {
   return header_decompressor_.get();
 }
 
+bool SpdyFramer::UsesHpack() const {
+  return enable_compression_ && header_encoding_ == HEADER_ENCODING_HPACK &&
+      spdy_version_ >= SPDY4;
+}
+
+HpackEncoder* SpdyFramer::GetHpackEncoder() {
+  if (!hpack_encoder_.get())
+    hpack_encoder_.reset(new HpackEncoder);
+  return hpack_encoder_.get();
+}
+
+HpackDecoder* SpdyFramer::GetHpackDecoder() {
+  if (!hpack_decoder_.get())
+    hpack_decoder_.reset(new HpackDecoder);
+  return hpack_decoder_.get();
+}
+
+bool SpdyFramer::DeliverHpackControlFrameHeaderData(SpdyStreamId stream_id) {
+  SpdyHeaderBlock headers;
+  bool decoded =
+      GetHpackDecoder()->DecodeHeaderBlock(hpack_header_block_, &headers);
+  hpack_header_block_.clear();
+  if (!decoded) {
+    DLOG(WARNING) << "Failed to decode HPACK header block.";
+    set_error(SPDY_DECOMPRESS_FAILURE);
+    return false;
+  }
+
+  // Visitors parse header blocks in the uncompressed SPDY format.
+  SpdyFrameBuilder builder(GetSerializedLength(protocol_version(), &headers));
+  SerializeNameValueBlockWithoutCompression(&builder, headers);
+  scoped_ptr<SpdyFrame> block(builder.take());
+  return IncrementallyDeliverControlFrameHeaderData(stream_id,
+                                                    block->data(),
+                                                    block->size());
+}
+
 // Incrementally decompress the control frame's header block, feeding the
 // result to the visitor in chunks. Continue this until the visitor
 // indicates that it cannot process any more data, or (more commonly) we
@@ -2297,6 +2346,16 @@ void SpdyFramer::SerializeNameValueBlock(
                                                      frame.name_value_block());
   }
 
+  if (UsesHpack()) {
+    hpack_encode_buffer_.clear();
+    GetHpackEncoder()->EncodeHeaderBlock(frame.name_value_block(),
+                                         &hpack_encode_buffer_);
+    builder->WriteBytes(hpack_encode_buffer_.data(),
+                        hpack_encode_buffer_.size());
+    builder->RewriteLength(*this);
+    return;
+  }
+
   // First build an uncompressed version to be fed into the compressor.
   const size_t uncompressed_len = GetSerializedLength(
       protocol_version(), &(frame.name_value_block()));
@@ -34,6 +34,8 @@ class SpdyStreamTest;
 class SpdyWebSocketStreamTest;
 class WebSocketJobTest;
 
+class HpackDecoder;
+class HpackEncoder;
 class SpdyFramer;
 class SpdyFrameBuilder;
 class SpdyFramerTest;
@@ -292,6 +294,12 @@ class NET_EXPORT_PRIVATE SpdyFramer {
     LAST_ERROR,  // Must be the last entry in the enum.
   };
 
+  // Header block compression schemes.
+  enum HeaderEncoding {
+    HEADER_ENCODING_ZLIB,   // zlib with the SPDY dictionary.
+    HEADER_ENCODING_HPACK,  // HPACK. Only used for SPDY4 and later.
+  };
+
   // Constant for invalid (or unknown) stream IDs.
   static const SpdyStreamId kInvalidStream;
 
@@ -490,6 +498,13 @@ class NET_EXPORT_PRIVATE SpdyFramer {
     enable_compression_ = value;
   }
 
+  // Selects how header blocks are compressed when compression is enabled.
+  // Both endpoints must agree; versions before SPDY4 always use zlib.
+  void set_header_encoding(HeaderEncoding value) {
+    header_encoding_ = value;
+  }
+  HeaderEncoding header_encoding() const { return header_encoding_; }
+
   // Used only in log messages.
   void set_display_protocol(const std::string& protocol) {
     display_protocol_ = protocol;
@@ -592,6 +607,13 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   z_stream* GetHeaderCompressor();
   z_stream* GetHeaderDecompressor();
 
+  // Returns true if header blocks are HPACK encoded.
+  bool UsesHpack() const;
+
+  // Get (and lazily initialize) the HPACK state.
+  HpackEncoder* GetHpackEncoder();
+  HpackDecoder* GetHpackDecoder();
+
  private:
   // Deliver the given control frame's uncompressed headers block to the
   // visitor in chunks. Returns true if the visitor has accepted all of the
@@ -600,6 +622,11 @@ class NET_EXPORT_PRIVATE SpdyFramer {
                                                   const char* data,
                                                   size_t len);
 
+  // Decode the HPACK header block buffered in hpack_header_block_ and deliver
+  // it to the visitor in the uncompressed SPDY format. Returns true if the
+  // visitor has accepted all of the chunks.
+  bool DeliverHpackControlFrameHeaderData(SpdyStreamId stream_id);
+
   // Utility to copy the given data block to the current frame buffer, up
   // to the given maximum number of bytes, and update the buffer
   // data (pointer and length). Returns the number of bytes
@@ -687,6 +714,15 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   scoped_ptr<z_stream> header_compressor_;
   scoped_ptr<z_stream> header_decompressor_;
 
+  HeaderEncoding header_encoding_;
+  scoped_ptr<HpackEncoder> hpack_encoder_;
+  scoped_ptr<HpackDecoder> hpack_decoder_;
+  // An HPACK block can only be decoded once it is complete, so the header
+  // block of the current frame is collected here.
+  std::string hpack_header_block_;
+  // Reused to avoid an allocation per serialized header block.
+  std::string hpack_encode_buffer_;
+
   SpdyFramerVisitorInterface* visitor_;
   SpdyFramerDebugVisitorInterface* debug_visitor_;
 
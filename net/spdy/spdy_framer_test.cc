@@ -3195,6 +3195,72 @@ TEST_P(SpdyFramerTest, ReadCompressedSynReplyHeaderBlock) {
   EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
 }
 
+TEST_P(SpdyFramerTest, ReadHpackSynStreamHeaderBlocks) {
+  if (!IsSpdy4()) {
+    return;
+  }
+  SpdyHeaderBlock headers;
+  headers[":method"] = "GET";
+  headers[":path"] = "/index.html";
+  headers["user-agent"] = "Mozilla/5.0 (X11; Linux x86_64)";
+  headers["cookie"] = std::string("a=b\0c=d", 7);
+  SpdyFramer framer(spdy_version_);
+  framer.set_header_encoding(SpdyFramer::HEADER_ENCODING_HPACK);
+  scoped_ptr<SpdyFrame> frame1(
+      framer.CreateSynStream(1,                     // stream_id
+                             0,                     // associated_stream_id
+                             1,                     // priority
+                             0,                     // credential_slot
+                             CONTROL_FLAG_NONE,
+                             true,                  // compress
+                             &headers));
+  scoped_ptr<SpdyFrame> frame2(
+      framer.CreateSynStream(3,                     // stream_id
+                             0,                     // associated_stream_id
+                             1,                     // priority
+                             0,                     // credential_slot
+                             CONTROL_FLAG_NONE,
+                             true,                  // compress
+                             &headers));
+  ASSERT_TRUE(frame1.get() != NULL);
+  ASSERT_TRUE(frame2.get() != NULL);
+  // The second block is sent entirely as header table indices.
+  EXPECT_EQ(framer.GetSynStreamMinimumSize() + headers.size(),
+            frame2->size());
+
+  TestSpdyVisitor visitor(spdy_version_);
+  visitor.use_compression_ = true;
+  visitor.framer_.set_header_encoding(SpdyFramer::HEADER_ENCODING_HPACK);
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(frame1->data()), frame1->size());
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+  visitor.headers_.clear();
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(frame2->data()), frame2->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(2, visitor.syn_frame_count_);
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+}
+
+TEST_P(SpdyFramerTest, ReadCorruptHpackHeaderBlock) {
+  if (!IsSpdy4()) {
+    return;
+  }
+  const unsigned char kInput[] = {
+    0x00, 0x14, 0x01, 0x00,           // SYN_STREAM #1
+    0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0x7f,           // Index out of range.
+  };
+  TestSpdyVisitor visitor(spdy_version_);
+  visitor.use_compression_ = true;
+  visitor.framer_.set_header_encoding(SpdyFramer::HEADER_ENCODING_HPACK);
+  visitor.SimulateInFramer(kInput, sizeof(kInput));
+  EXPECT_EQ(1, visitor.error_count_);
+  EXPECT_EQ(SpdyFramer::SPDY_DECOMPRESS_FAILURE, visitor.framer_.error_code());
+}
+
 TEST_P(SpdyFramerTest, ReadCompressedHeadersHeaderBlock) {
   SpdyHeaderBlock headers;
   headers["alpha"] = "beta";
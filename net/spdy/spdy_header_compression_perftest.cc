@@ -0,0 +1,159 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/spdy/hpack_decoder.h"
+#include "net/spdy/hpack_encoder.h"
+#include "net/spdy/spdy_flat_header_block.h"
+#include "net/spdy/spdy_framer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kIterations = 20000;
+
+// A typical browser request, with a path that changes on every iteration.
+void MakeRequestHeaders(int i, SpdyHeaderBlock* headers) {
+  (*headers)[":host"] = "www.example.com";
+  (*headers)[":method"] = "GET";
+  (*headers)[":path"] = "/static/image" + base::IntToString(i) + ".png";
+  (*headers)[":scheme"] = "https";
+  (*headers)[":version"] = "HTTP/1.1";
+  (*headers)["accept"] = "image/webp,*/*;q=0.8";
+  (*headers)["accept-encoding"] = "gzip,deflate,sdch";
+  (*headers)["accept-language"] = "en-US,en;q=0.8";
+  (*headers)["cookie"] = "PREF=ID=0123456789abcdef:FF=0:TM=1380000000; "
+                         "NID=67=abcdefghijklmnopqrstuvwxyz0123456789";
+  (*headers)["referer"] = "https://www.example.com/index.html";
+  (*headers)["user-agent"] =
+      "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like "
+      "Gecko) Chrome/31.0.1650.0 Safari/537.36";
+}
+
+// Visitor which discards everything it is given.
+class NullVisitor : public SpdyFramerVisitorInterface {
+ public:
+  virtual void OnError(SpdyFramer* framer) OVERRIDE {}
+  virtual void OnSynStream(SpdyStreamId stream_id,
+                           SpdyStreamId associated_stream_id,
+                           SpdyPriority priority,
+                           uint8 credential_slot,
+                           bool fin,
+                           bool unidirectional) OVERRIDE {}
+  virtual void OnSynReply(SpdyStreamId stream_id, bool fin) OVERRIDE {}
+  virtual void OnHeaders(SpdyStreamId stream_id, bool fin) OVERRIDE {}
+  virtual bool OnControlFrameHeaderData(SpdyStreamId stream_id,
+                                        const char* header_data,
+                                        size_t len) OVERRIDE {
+    return true;
+  }
+  virtual bool OnCredentialFrameData(const char* credential_data,
+                                     size_t len) OVERRIDE {
+    return true;
+  }
+  virtual void OnDataFrameHeader(SpdyStreamId stream_id,
+                                 size_t length,
+                                 bool fin) OVERRIDE {}
+  virtual void OnStreamFrameData(SpdyStreamId stream_id,
+                                 const char* data,
+                                 size_t len,
+                                 bool fin) OVERRIDE {}
+  virtual void OnSetting(SpdySettingsIds id,
+                         uint8 flags,
+                         uint32 value) OVERRIDE {}
+  virtual void OnPing(uint32 unique_id) OVERRIDE {}
+  virtual void OnRstStream(SpdyStreamId stream_id,
+                           SpdyRstStreamStatus status) OVERRIDE {}
+  virtual void OnGoAway(SpdyStreamId last_accepted_stream_id,
+                        SpdyGoAwayStatus status) OVERRIDE {}
+  virtual void OnWindowUpdate(SpdyStreamId stream_id,
+                              uint32 delta_window_size) OVERRIDE {}
+  virtual void OnPushPromise(SpdyStreamId stream_id,
+                             SpdyStreamId promised_stream_id) OVERRIDE {}
+};
+
+void RunFramerBenchmark(const char* name,
+                        SpdyFramer::HeaderEncoding encoding) {
+  SpdyFramer send_framer(SPDY4);
+  SpdyFramer recv_framer(SPDY4);
+  send_framer.set_header_encoding(encoding);
+  recv_framer.set_header_encoding(encoding);
+  NullVisitor visitor;
+  recv_framer.set_visitor(&visitor);
+
+  size_t header_count = 0;
+  size_t compressed_bytes = 0;
+  base::TimeDelta encode_time;
+  base::TimeDelta decode_time;
+  for (int i = 0; i < kIterations; ++i) {
+    SpdyHeaderBlock headers;
+    MakeRequestHeaders(i, &headers);
+    header_count += headers.size();
+
+    PerfTimer encode_timer;
+    scoped_ptr<SpdyFrame> frame(send_framer.CreateSynStream(
+        2 * i + 1, 0, 0, 0, CONTROL_FLAG_NONE, true, &headers));
+    encode_time += encode_timer.Elapsed();
+    compressed_bytes += frame->size() - send_framer.GetSynStreamMinimumSize();
+
+    PerfTimer decode_timer;
+    recv_framer.ProcessInput(frame->data(), frame->size());
+    decode_time += decode_timer.Elapsed();
+    ASSERT_FALSE(recv_framer.HasError());
+  }
+
+  LogPerfResult((std::string(name) + "_encode").c_str(),
+                encode_time.InMicroseconds() * 1000.0 / header_count,
+                "ns/header");
+  LogPerfResult((std::string(name) + "_decode").c_str(),
+                decode_time.InMicroseconds() * 1000.0 / header_count,
+                "ns/header");
+  LogPerfResult((std::string(name) + "_block_size").c_str(),
+                static_cast<double>(compressed_bytes) / kIterations,
+                "bytes");
+}
+
+}  // namespace
+
+TEST(SpdyHeaderCompressionPerfTest, Zlib) {
+  RunFramerBenchmark("spdy_zlib_headers", SpdyFramer::HEADER_ENCODING_ZLIB);
+}
+
+TEST(SpdyHeaderCompressionPerfTest, Hpack) {
+  RunFramerBenchmark("spdy_hpack_headers", SpdyFramer::HEADER_ENCODING_HPACK);
+}
+
+// Decoding into a reused SpdyFlatHeaderBlock does not allocate per header.
+TEST(SpdyHeaderCompressionPerfTest, HpackFlatDecode) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  SpdyFlatHeaderBlock flat_headers;
+  std::string encoded;
+  size_t header_count = 0;
+  base::TimeDelta decode_time;
+  for (int i = 0; i < kIterations; ++i) {
+    SpdyHeaderBlock headers;
+    MakeRequestHeaders(i, &headers);
+    header_count += headers.size();
+    encoded.clear();
+    encoder.EncodeHeaderBlock(headers, &encoded);
+
+    PerfTimer decode_timer;
+    flat_headers.Clear();
+    ASSERT_TRUE(decoder.DecodeHeaderBlock(encoded, &flat_headers));
+    decode_time += decode_timer.Elapsed();
+  }
+  LogPerfResult("spdy_hpack_flat_decode",
+                decode_time.InMicroseconds() * 1000.0 / header_count,
+                "ns/header");
+}
+
+}  // namespace net
@@ -2670,6 +2670,7 @@ TEST_P(SpdySessionTest, CloseOneIdleConnection) {
   HostPortPair host_port2("2.com", 80);
   scoped_refptr<TransportSocketParams> params2(
       new TransportSocketParams(host_port2, DEFAULT_PRIORITY, false, false,
+                                true,
                                 OnHostResolutionCallback()));
   scoped_ptr<ClientSocketHandle> connection2(new ClientSocketHandle);
   EXPECT_EQ(ERR_IO_PENDING,
@@ -2745,6 +2746,7 @@ TEST_P(SpdySessionTest, CloseOneIdleConnectionWithAlias) {
   HostPortPair host_port3("3.com", 80);
   scoped_refptr<TransportSocketParams> params3(
       new TransportSocketParams(host_port3, DEFAULT_PRIORITY, false, false,
+                                true,
                                 OnHostResolutionCallback()));
   scoped_ptr<ClientSocketHandle> connection3(new ClientSocketHandle);
   EXPECT_EQ(ERR_IO_PENDING,
@@ -2825,6 +2827,7 @@ TEST_P(SpdySessionTest, CloseOneIdleConnectionFailsWhenSessionInUse) {
   HostPortPair host_port2("2.com", 80);
   scoped_refptr<TransportSocketParams> params2(
       new TransportSocketParams(host_port2, DEFAULT_PRIORITY, false, false,
+                                true,
                                 OnHostResolutionCallback()));
   scoped_ptr<ClientSocketHandle> connection2(new ClientSocketHandle);
   EXPECT_EQ(ERR_IO_PENDING,
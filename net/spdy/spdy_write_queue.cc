@@ -4,7 +4,9 @@
 
 #include "net/spdy/spdy_write_queue.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <vector>
 
 #include "base/logging.h"
 #include "net/spdy/spdy_buffer.h"
@@ -13,20 +15,64 @@
 
 namespace net {
 
-SpdyWriteQueue::PendingWrite::PendingWrite() : frame_producer(NULL) {}
+namespace {
+
+// Each dequeued frame advances its stream's virtual time by
+// kVirtualTimePerFrame / weight. This is a multiple of every weight up
+// to SpdyWriteQueue::kMaxWeight that is a power of two, so those
+// streams share the connection exactly.
+const uint64 kVirtualTimePerFrame = 1 << 16;
+
+}  // namespace
+
+SpdyWriteQueue::PendingWrite::PendingWrite()
+    : frame_producer(NULL), sequence_number(0) {}
 
 SpdyWriteQueue::PendingWrite::PendingWrite(
     SpdyFrameType frame_type,
     SpdyBufferProducer* frame_producer,
-    const base::WeakPtr<SpdyStream>& stream)
+    const base::WeakPtr<SpdyStream>& stream,
+    uint64 sequence_number)
     : frame_type(frame_type),
       frame_producer(frame_producer),
       stream(stream),
-      has_stream(stream.get() != NULL) {}
+      has_stream(stream.get() != NULL),
+      sequence_number(sequence_number) {}
 
 SpdyWriteQueue::PendingWrite::~PendingWrite() {}
 
-SpdyWriteQueue::SpdyWriteQueue() {}
+SpdyWriteQueue::StreamQueue::StreamQueue()
+    : stream(NULL),
+      node_id(0),
+      priority(IDLE),
+      weight(kDefaultWeight),
+      next_start(0),
+      scheduled(false),
+      scheduled_start(0),
+      scheduled_sequence_number(0),
+      configured(false) {}
+
+SpdyWriteQueue::StreamQueue::~StreamQueue() {}
+
+SpdyWriteQueue::ScheduleKey::ScheduleKey(uint64 start,
+                                         uint64 sequence_number,
+                                         StreamQueue* queue)
+    : start(start), sequence_number(sequence_number), queue(queue) {}
+
+bool SpdyWriteQueue::ScheduleKey::operator<(const ScheduleKey& other) const {
+  if (start != other.start)
+    return start < other.start;
+  return sequence_number < other.sequence_number;
+}
+
+SpdyWriteQueue::SpdyWriteQueue()
+    : next_node_id_(1),
+      next_sequence_number_(0) {
+  for (int i = 0; i < NUM_PRIORITIES; ++i) {
+    session_queues_[i].priority = static_cast<RequestPriority>(i);
+    virtual_time_[i] = 0;
+  }
+}
 
 SpdyWriteQueue::~SpdyWriteQueue() {
   Clear();
@@ -34,7 +80,7 @@ SpdyWriteQueue::~SpdyWriteQueue() {
 
 bool SpdyWriteQueue::IsEmpty() const {
   for (int i = 0; i < NUM_PRIORITIES; i++) {
-    if (!queue_[i].empty())
+    if (!ready_[i].empty())
       return false;
   }
   return true;
@@ -46,87 +92,249 @@ void SpdyWriteQueue::Enqueue(RequestPriority priority,
                              const base::WeakPtr<SpdyStream>& stream) {
   if (stream.get())
     DCHECK_EQ(stream->priority(), priority);
-  queue_[priority].push_back(
-      PendingWrite(frame_type, frame_producer.release(), stream));
+  PendingWrite pending_write(frame_type, frame_producer.release(), stream,
+                             next_sequence_number_++);
+  if (!stream.get()) {
+    StreamQueue* queue = &session_queues_[priority];
+    queue->writes.push_back(pending_write);
+    UpdateSchedule(queue, true);
+    return;
+  }
+
+  StreamQueue* queue = GetOrCreateStreamQueue(stream.get(), priority);
+  queue->writes.push_back(pending_write);
+  if (queue->writes.size() == 1)
+    UpdateScheduleForChain(queue);
 }
 
 bool SpdyWriteQueue::Dequeue(SpdyFrameType* frame_type,
                              scoped_ptr<SpdyBufferProducer>* frame_producer,
                              base::WeakPtr<SpdyStream>* stream) {
   for (int i = NUM_PRIORITIES - 1; i >= 0; --i) {
-    if (!queue_[i].empty()) {
-      PendingWrite pending_write = queue_[i].front();
-      queue_[i].pop_front();
-      *frame_type = pending_write.frame_type;
-      frame_producer->reset(pending_write.frame_producer);
-      *stream = pending_write.stream;
-      if (pending_write.has_stream)
-        DCHECK(stream->get());
-      return true;
+    if (ready_[i].empty())
+      continue;
+
+    StreamQueue* queue = ready_[i].begin()->queue;
+    virtual_time_[i] = queue->scheduled_start;
+    queue->next_start =
+        queue->scheduled_start + kVirtualTimePerFrame / queue->weight;
+
+    PendingWrite pending_write = queue->writes.front();
+    queue->writes.pop_front();
+    *frame_type = pending_write.frame_type;
+    frame_producer->reset(pending_write.frame_producer);
+    *stream = pending_write.stream;
+    if (pending_write.has_stream)
+      DCHECK(stream->get());
+
+    // Reschedule the queue with the start time of its next write.
+    UpdateSchedule(queue, false);
+    if (!queue->stream) {
+      UpdateSchedule(queue, !queue->writes.empty());
+    } else if (!queue->writes.empty()) {
+      UpdateSchedule(queue, true);
+    } else {
+      // The streams which depend on this one may now be eligible.
+      UpdateScheduleForChain(queue);
+      if (!queue->configured)
+        DeleteStreamQueue(queue);
     }
+    return true;
   }
   return false;
 }
 
+void SpdyWriteQueue::SetStreamWeight(const base::WeakPtr<SpdyStream>& stream,
+                                     int weight) {
+  DCHECK(stream.get());
+  DCHECK_GE(weight, kMinWeight);
+  DCHECK_LE(weight, kMaxWeight);
+  StreamQueue* queue =
+      GetOrCreateStreamQueue(stream.get(), stream->priority());
+  queue->configured = true;
+  queue->weight = weight;
+}
+
+bool SpdyWriteQueue::SetStreamDependency(
+    const base::WeakPtr<SpdyStream>& stream,
+    const base::WeakPtr<SpdyStream>& parent,
+    bool unordered) {
+  DCHECK(stream.get());
+  DCHECK(parent.get());
+  StreamQueue* queue =
+      GetOrCreateStreamQueue(stream.get(), stream->priority());
+  StreamQueue* parent_queue =
+      GetOrCreateStreamQueue(parent.get(), parent->priority());
+  queue->configured = true;
+  parent_queue->configured = true;
+  if (!dependencies_.SetParent(queue->node_id, parent_queue->node_id,
+                               unordered)) {
+    return false;
+  }
+  UpdateScheduleForChain(queue);
+  return true;
+}
+
 void SpdyWriteQueue::RemovePendingWritesForStream(
     const base::WeakPtr<SpdyStream>& stream) {
   DCHECK(stream.get());
-  if (DCHECK_IS_ON()) {
-    // |stream| should not have pending writes in a queue not matching
-    // its priority.
-    for (int i = 0; i < NUM_PRIORITIES; ++i) {
-      if (stream->priority() == i)
-        continue;
-      for (std::deque<PendingWrite>::const_iterator it = queue_[i].begin();
-           it != queue_[i].end(); ++it) {
-        DCHECK_NE(it->stream.get(), stream.get());
-      }
-    }
-  }
+  StreamQueueMap::iterator it = stream_queues_.find(stream.get());
+  if (it == stream_queues_.end())
+    return;
 
-  // Do the actual deletion and removal, preserving FIFO-ness.
-  std::deque<PendingWrite>* queue = &queue_[stream->priority()];
-  std::deque<PendingWrite>::iterator out_it = queue->begin();
-  for (std::deque<PendingWrite>::const_iterator it = queue->begin();
-       it != queue->end(); ++it) {
-    if (it->stream.get() == stream.get()) {
-      delete it->frame_producer;
-    } else {
-      *out_it = *it;
-      ++out_it;
-    }
-  }
-  queue->erase(out_it, queue->end());
+  // |stream| should not have pending writes in a queue not matching
+  // its priority.
+  StreamQueue* queue = it->second;
+  DCHECK_EQ(stream->priority(), queue->priority);
+  UpdateSchedule(queue, false);
+  DeleteWrites(queue);
+
+  // Its dependent, if any, takes its place in the chain.
+  uint32 child_id = dependencies_.GetChild(queue->node_id);
+  DeleteStreamQueue(queue);
+  if (child_id != 0)
+    UpdateScheduleForChain(queues_by_node_id_[child_id]);
 }
 
 void SpdyWriteQueue::RemovePendingWritesForStreamsAfter(
     SpdyStreamId last_good_stream_id) {
-  for (int i = 0; i < NUM_PRIORITIES; ++i) {
-    // Do the actual deletion and removal, preserving FIFO-ness.
-    std::deque<PendingWrite>* queue = &queue_[i];
-    std::deque<PendingWrite>::iterator out_it = queue->begin();
-    for (std::deque<PendingWrite>::const_iterator it = queue->begin();
-         it != queue->end(); ++it) {
-      if (it->stream.get() && (it->stream->stream_id() > last_good_stream_id ||
-                               it->stream->stream_id() == 0)) {
-        delete it->frame_producer;
-      } else {
-        *out_it = *it;
-        ++out_it;
-      }
+  std::vector<StreamQueue*> queues_to_clear;
+  for (StreamQueueMap::const_iterator it = stream_queues_.begin();
+       it != stream_queues_.end(); ++it) {
+    // A stream's writes all share its weak pointer, so the first one
+    // tells whether the stream is still alive.
+    StreamQueue* queue = it->second;
+    if (queue->writes.empty())
+      continue;
+    SpdyStream* stream = queue->writes.front().stream.get();
+    if (stream && (stream->stream_id() > last_good_stream_id ||
+                   stream->stream_id() == 0)) {
+      queues_to_clear.push_back(queue);
     }
-    queue->erase(out_it, queue->end());
+  }
+
+  for (size_t i = 0; i < queues_to_clear.size(); ++i) {
+    StreamQueue* queue = queues_to_clear[i];
+    UpdateSchedule(queue, false);
+    DeleteWrites(queue);
+    UpdateScheduleForChain(queue);
+    if (!queue->configured)
+      DeleteStreamQueue(queue);
   }
 }
 
 void SpdyWriteQueue::Clear() {
   for (int i = 0; i < NUM_PRIORITIES; ++i) {
-    for (std::deque<PendingWrite>::iterator it = queue_[i].begin();
-         it != queue_[i].end(); ++it) {
-      delete it->frame_producer;
+    DeleteWrites(&session_queues_[i]);
+    session_queues_[i].scheduled = false;
+    ready_[i].clear();
+  }
+  for (StreamQueueMap::iterator it = stream_queues_.begin();
+       it != stream_queues_.end(); ++it) {
+    dependencies_.RemoveNode(it->second->node_id);
+    DeleteWrites(it->second);
+    delete it->second;
+  }
+  stream_queues_.clear();
+  queues_by_node_id_.clear();
+  DCHECK_EQ(0, dependencies_.num_nodes());
+}
+
+SpdyWriteQueue::StreamQueue* SpdyWriteQueue::GetOrCreateStreamQueue(
+    SpdyStream* stream,
+    RequestPriority priority) {
+  std::pair<StreamQueueMap::iterator, bool> result = stream_queues_.insert(
+      std::make_pair(stream, static_cast<StreamQueue*>(NULL)));
+  if (result.second) {
+    StreamQueue* queue = new StreamQueue();
+    queue->stream = stream;
+    queue->node_id = next_node_id_++;
+    queue->priority = priority;
+    result.first->second = queue;
+    queues_by_node_id_[queue->node_id] = queue;
+    // Weights are kept in the StreamQueue; the forest only tracks
+    // dependencies.
+    dependencies_.AddRootNode(queue->node_id, 0);
+  }
+  DCHECK_EQ(priority, result.first->second->priority);
+  return result.first->second;
+}
+
+bool SpdyWriteQueue::IsEligible(uint32 node_id) const {
+  if (!dependencies_.IsMarkedReadyToWrite(node_id))
+    return false;
+  // Walk up the dependency chain. Once an ordered dependency has been
+  // crossed, any ancestor with pending writes blocks this stream.
+  bool crossed_ordered_dependency = false;
+  for (uint32 node = node_id;;) {
+    uint32 parent = dependencies_.GetParent(node);
+    if (parent == 0)
+      return true;
+    if (!dependencies_.IsNodeUnordered(node))
+      crossed_ordered_dependency = true;
+    if (crossed_ordered_dependency &&
+        dependencies_.IsMarkedReadyToWrite(parent)) {
+      return false;
     }
-    queue_[i].clear();
+    node = parent;
   }
 }
 
+void SpdyWriteQueue::UpdateSchedule(StreamQueue* queue, bool eligible) {
+  DCHECK(!eligible || !queue->writes.empty());
+  if (queue->scheduled == eligible)
+    return;
+
+  std::set<ScheduleKey>* ready = &ready_[queue->priority];
+  if (queue->scheduled) {
+    ready->erase(ScheduleKey(queue->scheduled_start,
+                             queue->scheduled_sequence_number, queue));
+    queue->scheduled = false;
+    return;
+  }
+
+  // A queue which was idle starts at the current virtual time, so it
+  // cannot claim the share it did not use while idle.
+  queue->scheduled_start =
+      std::max(virtual_time_[queue->priority], queue->next_start);
+  queue->scheduled_sequence_number = queue->writes.front().sequence_number;
+  ready->insert(ScheduleKey(queue->scheduled_start,
+                            queue->scheduled_sequence_number, queue));
+  queue->scheduled = true;
+}
+
+void SpdyWriteQueue::UpdateScheduleForChain(StreamQueue* queue) {
+  DCHECK(queue->stream);
+  for (uint32 node = queue->node_id; node != 0;
+       node = dependencies_.GetChild(node)) {
+    if (queues_by_node_id_[node]->writes.empty())
+      dependencies_.MarkNoLongerReadyToWrite(node);
+    else
+      dependencies_.MarkReadyToWrite(node);
+  }
+  for (uint32 node = queue->node_id; node != 0;
+       node = dependencies_.GetChild(node)) {
+    UpdateSchedule(queues_by_node_id_[node], IsEligible(node));
+  }
+}
+
+// static
+void SpdyWriteQueue::DeleteWrites(StreamQueue* queue) {
+  for (std::deque<PendingWrite>::iterator it = queue->writes.begin();
+       it != queue->writes.end(); ++it) {
+    delete it->frame_producer;
+  }
+  queue->writes.clear();
+}
+
+void SpdyWriteQueue::DeleteStreamQueue(StreamQueue* queue) {
+  DCHECK(queue->stream);
+  DCHECK(queue->writes.empty());
+  DCHECK(!queue->scheduled);
+  dependencies_.RemoveNode(queue->node_id);
+  queues_by_node_id_.erase(queue->node_id);
+  stream_queues_.erase(queue->stream);
+  delete queue;
+}
+
 }  // namespace net
@@ -6,12 +6,16 @@
 #define NET_SPDY_SPDY_WRITE_QUEUE_H_
 
 #include <deque>
+#include <map>
+#include <set>
 
 #include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/net_export.h"
 #include "net/base/request_priority.h"
+#include "net/spdy/spdy_priority_forest.h"
 #include "net/spdy/spdy_protocol.h"
 
 namespace net {
@@ -20,10 +24,30 @@ class SpdyBuffer;
 class SpdyBufferProducer;
 class SpdyStream;
 
-// A queue of SpdyBufferProducers to produce frames to write. Ordered
-// by priority, and then FIFO.
+// A queue of SpdyBufferProducers to produce frames to write.
+//
+// Writes are ordered strictly by priority. Within a priority, each
+// stream's writes are FIFO, and the streams with pending writes share
+// the connection by weighted fair queueing: each stream gets a number
+// of frames proportional to its weight, and streams with one pending
+// write each are served in the order they were enqueued. Writes not
+// associated with a stream are queued FIFO as a stream of their own.
+//
+// Streams may also depend on one another, as in the SPDY4
+// prioritization scheme implemented by SpdyPriorityForest: a stream
+// that depends on another does not write while the other has pending
+// writes, unless the dependency is unordered.
+//
+// Enqueue() and Dequeue() take O(log n) time in the number of streams
+// with pending writes, plus the length of the stream's dependency chain.
 class NET_EXPORT_PRIVATE SpdyWriteQueue {
  public:
+  // The range of stream weights, and the weight of a stream which has
+  // not been given one.
+  static const int kMinWeight = 1;
+  static const int kMaxWeight = 256;
+  static const int kDefaultWeight = 16;
+
   SpdyWriteQueue();
   ~SpdyWriteQueue();
 
@@ -49,8 +73,23 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
                scoped_ptr<SpdyBufferProducer>* frame_producer,
                base::WeakPtr<SpdyStream>* stream);
 
+  // Sets the share of the connection |stream| gets relative to other
+  // streams of its priority. |weight| must be in [kMinWeight,
+  // kMaxWeight].
+  void SetStreamWeight(const base::WeakPtr<SpdyStream>& stream, int weight);
+
+  // Makes writes for |stream| wait until |parent| has no pending
+  // writes or, if |unordered| is true, lets them be interleaved with
+  // those of |parent|. A stream has at most one dependent stream.
+  // Returns false and has no effect if |parent| already has a
+  // different dependent or if the dependency would create a cycle.
+  bool SetStreamDependency(const base::WeakPtr<SpdyStream>& stream,
+                           const base::WeakPtr<SpdyStream>& parent,
+                           bool unordered);
+
   // Removes all pending writes for the given stream, which must be
-  // non-NULL.
+  // non-NULL, along with its weight and dependencies. Streams which
+  // depended on |stream| now depend on its parent, if any.
   void RemovePendingWritesForStream(const base::WeakPtr<SpdyStream>& stream);
 
   // Removes all pending writes for streams after |last_good_stream_id|
@@ -70,16 +109,100 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
     base::WeakPtr<SpdyStream> stream;
     // Whether |stream| was non-NULL when enqueued.
     bool has_stream;
+    // Breaks ties between streams with equal virtual start times, so
+    // that they are served in the order their writes were enqueued.
+    uint64 sequence_number;
 
     PendingWrite();
     PendingWrite(SpdyFrameType frame_type,
                  SpdyBufferProducer* frame_producer,
-                 const base::WeakPtr<SpdyStream>& stream);
+                 const base::WeakPtr<SpdyStream>& stream,
+                 uint64 sequence_number);
     ~PendingWrite();
   };
 
-  // The actual write queue, binned by priority.
-  std::deque<PendingWrite> queue_[NUM_PRIORITIES];
+  // The pending writes of one stream, or the writes of one priority
+  // not associated with any stream, and their scheduling state.
+  struct StreamQueue {
+    StreamQueue();
+    ~StreamQueue();
+
+    // The stream whose writes these are, or NULL. Only used as a key;
+    // the stream may have been destroyed.
+    SpdyStream* stream;
+    // The node of the stream in |dependencies_|, or 0.
+    uint32 node_id;
+    std::deque<PendingWrite> writes;
+    RequestPriority priority;
+    int weight;
+    // The virtual time at which the next write may start.
+    uint64 next_start;
+    // Whether this queue is in |ready_[priority]|, and if so, under
+    // which key.
+    bool scheduled;
+    uint64 scheduled_start;
+    uint64 scheduled_sequence_number;
+    // Whether a weight or dependency has been set, in which case the
+    // queue is kept even when it has no pending writes.
+    bool configured;
+  };
+
+  // An entry in the ready set of a priority, ordered by virtual start
+  // time and then by sequence number.
+  struct ScheduleKey {
+    ScheduleKey(uint64 start, uint64 sequence_number, StreamQueue* queue);
+    bool operator<(const ScheduleKey& other) const;
+
+    uint64 start;
+    uint64 sequence_number;
+    StreamQueue* queue;
+  };
+
+  typedef std::map<SpdyStream*, StreamQueue*> StreamQueueMap;
+  typedef base::hash_map<uint32, StreamQueue*> NodeMap;
+  typedef SpdyPriorityForest<uint32, int> DependencyForest;
+
+  // Returns the queue for |stream|, creating it if needed.
+  StreamQueue* GetOrCreateStreamQueue(SpdyStream* stream,
+                                      RequestPriority priority);
+
+  // Returns true if the stream of |node_id| has pending writes and no
+  // stream it depends on through an ordered dependency does.
+  bool IsEligible(uint32 node_id) const;
+
+  // Adds |queue| to or removes it from its ready set. A queue added
+  // to its ready set is keyed by the virtual start time and sequence
+  // number of its first write. |eligible| must be false if |queue| has
+  // no pending writes.
+  void UpdateSchedule(StreamQueue* queue, bool eligible);
+
+  // Reschedules the stream of |queue| and every stream which depends
+  // on it, after its pending writes or dependencies changed.
+  void UpdateScheduleForChain(StreamQueue* queue);
+
+  // Deletes the frame producers of all pending writes in |queue|.
+  static void DeleteWrites(StreamQueue* queue);
+
+  // Deletes |queue|, which must belong to a stream and have no pending
+  // writes.
+  void DeleteStreamQueue(StreamQueue* queue);
+
+  // Queues of writes not associated with a stream, by priority.
+  StreamQueue session_queues_[NUM_PRIORITIES];
+  // Queues of streams with pending writes or configured scheduling.
+  StreamQueueMap stream_queues_;
+  // Stream dependencies, with one node for each queue in
+  // |stream_queues_|. A node is marked ready to write while its queue
+  // has pending writes.
+  DependencyForest dependencies_;
+  NodeMap queues_by_node_id_;
+  uint32 next_node_id_;
+
+  // Queues eligible to write, binned by priority.
+  std::set<ScheduleKey> ready_[NUM_PRIORITIES];
+  // The virtual start time of the last write dequeued, by priority.
+  uint64 virtual_time_[NUM_PRIORITIES];
+  uint64 next_sequence_number_;
 
   DISALLOW_COPY_AND_ASSIGN(SpdyWriteQueue);
 };
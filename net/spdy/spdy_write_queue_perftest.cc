@@ -0,0 +1,123 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/perftimer.h"
+#include "base/stl_util.h"
+#include "net/base/net_log.h"
+#include "net/base/request_priority.h"
+#include "net/spdy/spdy_buffer.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_write_queue.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kActiveStreams = 1000;
+const int kWritesPerStream = 4;
+const int kIterations = 200000;
+
+// Producer which produces nothing, so that only the cost of scheduling is
+// measured.
+class NullProducer : public SpdyBufferProducer {
+ public:
+  NullProducer() {}
+  virtual ~NullProducer() {}
+
+  virtual scoped_ptr<SpdyBuffer> ProduceBuffer() OVERRIDE {
+    return scoped_ptr<SpdyBuffer>();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullProducer);
+};
+
+void Enqueue(SpdyWriteQueue* write_queue, SpdyStream* stream) {
+  write_queue->Enqueue(stream->priority(), DATA,
+                       scoped_ptr<SpdyBufferProducer>(new NullProducer()),
+                       stream->GetWeakPtr());
+}
+
+// Keeps every stream in |streams| active by enqueueing a new write for each
+// frame dequeued, and logs the rate at which frames are scheduled.
+void RunDequeueBenchmark(const std::string& name,
+                         SpdyWriteQueue* write_queue,
+                         const std::vector<SpdyStream*>& streams) {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    for (int j = 0; j < kWritesPerStream; ++j)
+      Enqueue(write_queue, streams[i]);
+  }
+
+  SpdyFrameType frame_type = DATA;
+  scoped_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  PerfTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    ASSERT_TRUE(write_queue->Dequeue(&frame_type, &frame_producer, &stream));
+    Enqueue(write_queue, stream.get());
+  }
+  LogPerfResult(name.c_str(), kIterations / timer.Elapsed().InSecondsF(),
+                "frames/s");
+
+  write_queue->Clear();
+}
+
+}  // namespace
+
+TEST(SpdyWriteQueuePerfTest, Dequeue) {
+  std::vector<SpdyStream*> streams;
+  for (int i = 0; i < kActiveStreams; ++i) {
+    RequestPriority priority =
+        static_cast<RequestPriority>(MINIMUM_PRIORITY + i % NUM_PRIORITIES);
+    streams.push_back(new SpdyStream(
+        SPDY_BIDIRECTIONAL_STREAM, base::WeakPtr<SpdySession>(), GURL(),
+        priority, 0, 0, BoundNetLog()));
+  }
+
+  {
+    SpdyWriteQueue write_queue;
+    RunDequeueBenchmark("spdy_write_queue_1000_streams", &write_queue,
+                        streams);
+  }
+
+  {
+    // Give the streams varying weights.
+    SpdyWriteQueue write_queue;
+    for (size_t i = 0; i < streams.size(); ++i) {
+      write_queue.SetStreamWeight(
+          streams[i]->GetWeakPtr(),
+          SpdyWriteQueue::kMinWeight + i % SpdyWriteQueue::kMaxWeight);
+    }
+    RunDequeueBenchmark("spdy_write_queue_1000_weighted_streams",
+                        &write_queue, streams);
+  }
+
+  {
+    // Arrange the streams of each priority in chains of ten, alternating
+    // between ordered and unordered dependencies.
+    SpdyWriteQueue write_queue;
+    for (size_t i = NUM_PRIORITIES; i < streams.size(); ++i) {
+      if ((i / NUM_PRIORITIES) % 10 == 0)
+        continue;
+      ASSERT_TRUE(write_queue.SetStreamDependency(
+          streams[i]->GetWeakPtr(), streams[i - NUM_PRIORITIES]->GetWeakPtr(),
+          i % 2 == 0));
+    }
+    RunDequeueBenchmark("spdy_write_queue_1000_dependent_streams",
+                        &write_queue, streams);
+  }
+
+  STLDeleteElements(&streams);
+}
+
+}  // namespace net
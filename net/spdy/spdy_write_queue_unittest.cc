@@ -68,6 +68,26 @@ SpdyStream* MakeTestStream(RequestPriority priority) {
       GURL(), priority, 0, 0, BoundNetLog());
 }
 
+// Dequeues the next write and returns the value of its producer, or -1
+// if the queue is empty.
+int DequeueInt(SpdyWriteQueue* write_queue) {
+  SpdyFrameType frame_type = DATA;
+  scoped_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  if (!write_queue->Dequeue(&frame_type, &frame_producer, &stream))
+    return -1;
+  return ProducerToInt(frame_producer.Pass());
+}
+
+// Enqueues writes with the values [first, first + count) for |stream|.
+void EnqueueInts(SpdyWriteQueue* write_queue, SpdyStream* stream,
+                 int first, int count) {
+  for (int i = first; i < first + count; ++i) {
+    write_queue->Enqueue(stream->priority(), DATA, IntToProducer(i),
+                         stream->GetWeakPtr());
+  }
+}
+
 // Add some frame producers of different priority. The producers
 // should be dequeued in priority order with their associated stream.
 TEST_F(SpdyWriteQueueTest, DequeuesByPriority) {
@@ -228,6 +248,105 @@ TEST_F(SpdyWriteQueueTest, RemovePendingWritesForStreamsAfter) {
   EXPECT_FALSE(write_queue.Dequeue(&frame_type, &frame_producer, &stream));
 }
 
+// Streams of the same priority with several pending writes each should
+// take turns instead of being served FIFO.
+TEST_F(SpdyWriteQueueTest, StreamsShareFairly) {
+  SpdyWriteQueue write_queue;
+  scoped_ptr<SpdyStream> stream1(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> stream2(MakeTestStream(DEFAULT_PRIORITY));
+
+  EnqueueInts(&write_queue, stream1.get(), 10, 3);
+  EnqueueInts(&write_queue, stream2.get(), 20, 3);
+  // A session write is scheduled like a stream of its own.
+  write_queue.Enqueue(DEFAULT_PRIORITY, SETTINGS, IntToProducer(30),
+                      base::WeakPtr<SpdyStream>());
+
+  const int kExpected[] = { 10, 20, 30, 11, 21, 12, 22 };
+  for (size_t i = 0; i < arraysize(kExpected); ++i)
+    EXPECT_EQ(kExpected[i], DequeueInt(&write_queue));
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
+// A stream with twice the weight of another should get twice as many
+// writes while both have writes pending.
+TEST_F(SpdyWriteQueueTest, StreamWeights) {
+  SpdyWriteQueue write_queue;
+  scoped_ptr<SpdyStream> stream1(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> stream2(MakeTestStream(DEFAULT_PRIORITY));
+  write_queue.SetStreamWeight(stream1->GetWeakPtr(),
+                              2 * SpdyWriteQueue::kDefaultWeight);
+
+  EnqueueInts(&write_queue, stream1.get(), 100, 20);
+  EnqueueInts(&write_queue, stream2.get(), 200, 20);
+
+  int stream1_writes = 0;
+  for (int i = 0; i < 15; ++i) {
+    if (DequeueInt(&write_queue) < 200)
+      ++stream1_writes;
+  }
+  EXPECT_EQ(10, stream1_writes);
+}
+
+// A stream which depends on another should not write while the other
+// has pending writes.
+TEST_F(SpdyWriteQueueTest, OrderedDependency) {
+  SpdyWriteQueue write_queue;
+  scoped_ptr<SpdyStream> parent(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> child(MakeTestStream(DEFAULT_PRIORITY));
+  EXPECT_TRUE(write_queue.SetStreamDependency(
+      child->GetWeakPtr(), parent->GetWeakPtr(), false));
+  EXPECT_FALSE(write_queue.SetStreamDependency(
+      parent->GetWeakPtr(), child->GetWeakPtr(), false));
+
+  EnqueueInts(&write_queue, child.get(), 20, 2);
+  EXPECT_EQ(20, DequeueInt(&write_queue));
+  EnqueueInts(&write_queue, parent.get(), 10, 2);
+
+  const int kExpected[] = { 10, 11, 21 };
+  for (size_t i = 0; i < arraysize(kExpected); ++i)
+    EXPECT_EQ(kExpected[i], DequeueInt(&write_queue));
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
+// A stream with an unordered dependency shares the connection with the
+// stream it depends on.
+TEST_F(SpdyWriteQueueTest, UnorderedDependency) {
+  SpdyWriteQueue write_queue;
+  scoped_ptr<SpdyStream> parent(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> child(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> grandchild(MakeTestStream(DEFAULT_PRIORITY));
+  EXPECT_TRUE(write_queue.SetStreamDependency(
+      child->GetWeakPtr(), parent->GetWeakPtr(), true));
+  EXPECT_TRUE(write_queue.SetStreamDependency(
+      grandchild->GetWeakPtr(), child->GetWeakPtr(), false));
+
+  EnqueueInts(&write_queue, parent.get(), 10, 2);
+  EnqueueInts(&write_queue, child.get(), 20, 2);
+  EnqueueInts(&write_queue, grandchild.get(), 30, 1);
+
+  const int kExpected[] = { 10, 20, 11, 21, 30 };
+  for (size_t i = 0; i < arraysize(kExpected); ++i)
+    EXPECT_EQ(kExpected[i], DequeueInt(&write_queue));
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
+// Removing a stream should unblock the streams which depend on it.
+TEST_F(SpdyWriteQueueTest, RemoveStreamWithDependent) {
+  SpdyWriteQueue write_queue;
+  scoped_ptr<SpdyStream> parent(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> child(MakeTestStream(DEFAULT_PRIORITY));
+  EXPECT_TRUE(write_queue.SetStreamDependency(
+      child->GetWeakPtr(), parent->GetWeakPtr(), false));
+
+  EnqueueInts(&write_queue, parent.get(), 10, 2);
+  EnqueueInts(&write_queue, child.get(), 20, 2);
+  write_queue.RemovePendingWritesForStream(parent->GetWeakPtr());
+
+  EXPECT_EQ(20, DequeueInt(&write_queue));
+  EXPECT_EQ(21, DequeueInt(&write_queue));
+  EXPECT_EQ(-1, DequeueInt(&write_queue));
+}
+
 // Enqueue a bunch of writes and then call Clear(). The write queue
 // should clean up the memory properly, and Dequeue() should return
 // false.
@@ -34,6 +34,7 @@ int main(int argc, char** argv) {
 
   NetTestSuite test_suite(argc, argv);
   ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  ClientSocketPoolBaseHelper::set_preconnect_prediction_enabled(false);
 
 #if defined(OS_WIN)
   // We want to be sure to init NSPR on the main thread.
@@ -21,12 +21,15 @@
 namespace net {
 
 SMAcceptorThread::SMAcceptorThread(FlipAcceptor *acceptor,
+                                   int listen_fd,
                                    MemoryCache* memory_cache)
     : SimpleThread("SMAcceptorThread"),
       acceptor_(acceptor),
+      listen_fd_(listen_fd),
       ssl_state_(NULL),
       use_ssl_(false),
       idle_socket_timeout_s_(acceptor->idle_socket_timeout_s_),
+      oldest_active_time_(time(NULL)),
       quitting_(false),
       memory_cache_(memory_cache) {
   if (!acceptor->ssl_cert_filename_.empty() &&
@@ -77,7 +80,7 @@ SMConnection* SMAcceptorThread::FindOrMakeNewSMConnection() {
 }
 
 void SMAcceptorThread::InitWorker() {
-  epoll_server_.RegisterFD(acceptor_->listen_fd_, this, EPOLLIN | EPOLLET);
+  epoll_server_.RegisterFD(listen_fd_, this, EPOLLIN | EPOLLET);
 }
 
 void SMAcceptorThread::HandleConnection(int server_fd,
@@ -118,11 +121,11 @@ void SMAcceptorThread::AcceptFromListenFD() {
     for (int i = 0; i < acceptor_->accepts_per_wake_; ++i) {
       struct sockaddr address;
       socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
+      int fd = accept(listen_fd_, &address, &socklen);
       if (fd == -1) {
         if (errno != 11) {
           VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
+                  << listen_fd_ << "): " << errno << ": "
                   << strerror(errno);
         }
         break;
@@ -134,11 +137,11 @@ void SMAcceptorThread::AcceptFromListenFD() {
     while (true) {
       struct sockaddr address;
       socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
+      int fd = accept(listen_fd_, &address, &socklen);
       if (fd == -1) {
         if (errno != 11) {
           VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
+                  << listen_fd_ << "): " << errno << ": "
                   << strerror(errno);
         }
         break;
@@ -150,12 +153,10 @@ void SMAcceptorThread::AcceptFromListenFD() {
 }
 
 void SMAcceptorThread::HandleConnectionIdleTimeout() {
-  static time_t oldest_time = time(NULL);
-
   int cur_time = time(NULL);
   // Only iterate the list if we speculate that a connection is ready to be
   // expired
-  if ((cur_time - oldest_time) < idle_socket_timeout_s_)
+  if ((cur_time - oldest_active_time_) < idle_socket_timeout_s_)
     return;
 
   // TODO(mbelshe): This code could be optimized, active_server_connections_
@@ -169,12 +170,12 @@ void SMAcceptorThread::HandleConnectionIdleTimeout() {
       iter = active_server_connections_.erase(iter);
       continue;
     }
-    if (conn->last_read_time_ < oldest_time)
-      oldest_time = conn->last_read_time_;
+    if (conn->last_read_time_ < oldest_active_time_)
+      oldest_active_time_ = conn->last_read_time_;
     iter++;
   }
-  if ((cur_time - oldest_time) >= idle_socket_timeout_s_)
-    oldest_time = cur_time;
+  if ((cur_time - oldest_active_time_) >= idle_socket_timeout_s_)
+    oldest_active_time_ = cur_time;
 }
 
 void SMAcceptorThread::Run() {
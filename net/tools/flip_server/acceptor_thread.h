@@ -46,7 +46,12 @@ class SMAcceptorThread : public base::SimpleThread,
                          public EpollCallbackInterface,
                          public SMConnectionPoolInterface {
  public:
-  SMAcceptorThread(FlipAcceptor *acceptor, MemoryCache* memory_cache);
+  // Accepts connections from |listen_fd|, which is either the acceptor's
+  // |listen_fd_| or, if several threads serve the acceptor, one more socket
+  // from FlipAcceptor::OpenListenSocket().
+  SMAcceptorThread(FlipAcceptor *acceptor,
+                   int listen_fd,
+                   MemoryCache* memory_cache);
   virtual ~SMAcceptorThread();
 
   // EpollCallbackInteface interface
@@ -80,9 +85,11 @@ class SMAcceptorThread : public base::SimpleThread,
  private:
   EpollServer epoll_server_;
   FlipAcceptor* acceptor_;
+  int listen_fd_;
   SSLState* ssl_state_;
   bool use_ssl_;
   int idle_socket_timeout_s_;
+  time_t oldest_active_time_;
 
   std::vector<SMConnection*> unused_server_connections_;
   std::vector<SMConnection*> tmp_unused_server_connections_;
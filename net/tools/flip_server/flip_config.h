@@ -41,6 +41,12 @@ class FlipAcceptor {
                void *memory_cache);
   ~FlipAcceptor();
 
+  // Opens a socket listening on the acceptor's address. Once |listen_fd_| is
+  // open, further sockets can only be opened if the acceptor was created with
+  // |reuseport|, in which case the kernel spreads incoming connections over
+  // all of them. Returns the non-blocking socket, or -1 on failure.
+  int OpenListenSocket();
+
   enum FlipHandlerType flip_handler_type_;
   std::string listen_ip_;
   std::string listen_port_;
@@ -54,6 +60,8 @@ class FlipAcceptor {
   int accept_backlog_size_;
   bool disable_nagle_;
   int accepts_per_wake_;
+  bool reuseport_;
+  bool wait_for_iface_;
   int listen_fd_;
   void* memory_cache_;
   int ssl_session_expiry_;
@@ -13,7 +13,9 @@
 
 #include "base/command_line.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/synchronization/lock.h"
+#include "base/sys_info.h"
 #include "base/timer/timer.h"
 #include "net/tools/flip_server/acceptor_thread.h"
 #include "net/tools/flip_server/constants.h"
@@ -46,6 +48,12 @@ int32 FLAGS_accept_backlog_size = 1024;
 //  SO_REUSEPORT);
 bool FLAGS_reuseport = false;
 
+// The number of threads, each with its own EpollServer, which accept and
+//  serve the connections of each acceptor. If set to 0, one thread per
+//  processor is used. Unless FLAGS_reuseport is set, the threads of an
+//  acceptor share its listening socket);
+int32 FLAGS_acceptor_threads = 1;
+
 // Flag to force spdy, even if NPN is not negotiated.
 bool FLAGS_force_spdy = false;
 
@@ -204,6 +212,12 @@ int main (int argc, char**argv)
     cout << "\t--ssl-session-expiry=<seconds> (default is 300)\n";
     cout << "\t--ssl-disable-compression\n";
     cout << "\t--idle-timeout=<seconds> (default is 300)\n";
+    cout << "\t--acceptor-threads=<n> (default is 1, 0 is one per processor)"
+         << "\n";
+    cout << "\t--reuseport\n";
+    cout << "\t  * Each acceptor thread listens on its own socket, and the"
+         << " kernel spreads\n"
+         << "\t    connections over them. Requires SO_REUSEPORT support.\n";
     cout << "\t--pidfile=<filepath> (default /var/run/flip-server.pid)\n";
     cout << "\t--help\n";
     exit(0);
@@ -269,6 +283,20 @@ int main (int argc, char**argv)
   if (cl.HasSwitch("force_spdy"))
     net::SMConnection::set_force_spdy(true);
 
+  if (cl.HasSwitch("acceptor-threads")) {
+    if (!base::StringToInt(cl.GetSwitchValueASCII("acceptor-threads"),
+                           &FLAGS_acceptor_threads) ||
+        FLAGS_acceptor_threads < 0) {
+      LOG(FATAL) << "Invalid number of acceptor threads: "
+                 << cl.GetSwitchValueASCII("acceptor-threads");
+    }
+  }
+  if (FLAGS_acceptor_threads == 0)
+    FLAGS_acceptor_threads = base::SysInfo::NumberOfProcessors();
+
+  if (cl.HasSwitch("reuseport"))
+    FLAGS_reuseport = true;
+
   logging::LoggingSettings settings;
   settings.logging_dest = g_proxy_config.log_destination_;
   settings.log_file = g_proxy_config.log_filename_.c_str();
@@ -288,6 +316,7 @@ int main (int argc, char**argv)
             << (FLAGS_disable_nagle?"true":"false");
   LOG(INFO) << "Reuseport               : "
             << (FLAGS_reuseport?"true":"false");
+  LOG(INFO) << "Acceptor threads        : " << FLAGS_acceptor_threads;
   LOG(INFO) << "Force SPDY              : "
             << (FLAGS_force_spdy?"true":"false");
   LOG(INFO) << "SSL session expiry      : "
@@ -382,19 +411,26 @@ int main (int argc, char**argv)
   for (i = 0; i < g_proxy_config.acceptors_.size(); i++) {
     net::FlipAcceptor *acceptor = g_proxy_config.acceptors_[i];
 
-    sm_worker_threads_.push_back(
-        new net::SMAcceptorThread(acceptor,
-                                  (net::MemoryCache *)acceptor->memory_cache_));
-    // Note that spdy_memory_cache is not threadsafe, it is merely
-    // thread compatible. Thus, if ever we are to spawn multiple threads,
-    // we either must make the MemoryCache threadsafe, or use
-    // a separate MemoryCache for each thread.
-    //
-    // The latter is what is currently being done as we spawn
-    // a separate thread for each http and spdy server acceptor.
-
-    sm_worker_threads_.back()->InitWorker();
-    sm_worker_threads_.back()->Start();
+    for (int thread = 0; thread < FLAGS_acceptor_threads; ++thread) {
+      int listen_fd = acceptor->listen_fd_;
+      if (thread > 0 && FLAGS_reuseport) {
+        listen_fd = acceptor->OpenListenSocket();
+        if (listen_fd == -1)
+          break;
+      }
+
+      // Note that the memory caches are only read once they have been filled
+      // by AddFiles() above, so all of the threads of an acceptor share its
+      // cache without locking.
+      sm_worker_threads_.push_back(
+          new net::SMAcceptorThread(
+              acceptor,
+              listen_fd,
+              (net::MemoryCache *)acceptor->memory_cache_));
+
+      sm_worker_threads_.back()->InitWorker();
+      sm_worker_threads_.back()->Start();
+    }
   }
 
   while (!wantExit) {
@@ -0,0 +1,271 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A load generator for the HTTP server of flip_in_mem_edsm_server, meant to
+// be run on the same machine. Each thread opens connections to the server one
+// after another, issues a number of GETs on each of them, one at a time, and
+// records how long every request took. Once all of the threads are done the
+// connections/s, requests/s and request latency percentiles are reported.
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/compiler_specific.h"
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "net/tools/flip_server/balsa_frame.h"
+#include "net/tools/flip_server/create_listener.h"
+#include "net/tools/flip_server/mem_cache.h"
+
+using std::cout;
+
+namespace {
+
+// How long to wait for the server to accept, read or answer before giving up
+// on a connection.
+const int kTimeoutMs = 10 * 1000;
+
+struct LoadOptions {
+  std::string server_ip;
+  std::string server_port;
+  std::string host;
+  std::string path;
+  int connections_per_thread;
+  int requests_per_connection;
+};
+
+// Waits until |fd| is ready for |events|. Returns false on timeout or error.
+bool WaitForSocket(int fd, short events) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = events;
+  pfd.revents = 0;
+  int rv = HANDLE_EINTR(poll(&pfd, 1, kTimeoutMs));
+  return rv == 1 && !(pfd.revents & (POLLERR | POLLNVAL));
+}
+
+class LoadThread : public base::SimpleThread {
+ public:
+  explicit LoadThread(const LoadOptions& options)
+      : SimpleThread("LoadThread"),
+        options_(options),
+        num_connections_(0),
+        num_errors_(0),
+        num_non_200_responses_(0) {
+    request_ = "GET " + options_.path + " HTTP/1.1\r\n"
+               "Host: " + options_.host + "\r\n"
+               "Connection: keep-alive\r\n"
+               "\r\n";
+    framer_.set_balsa_visitor(&visitor_);
+    framer_.set_balsa_headers(&visitor_.headers);
+    framer_.set_is_request(false);
+  }
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < options_.connections_per_thread; ++i) {
+      if (RunConnection())
+        ++num_connections_;
+      else
+        ++num_errors_;
+    }
+  }
+
+  const std::vector<base::TimeDelta>& latencies() const { return latencies_; }
+  int num_connections() const { return num_connections_; }
+  int num_errors() const { return num_errors_; }
+  int num_non_200_responses() const { return num_non_200_responses_; }
+
+ private:
+  // Connects to the server and issues all of the requests of one connection.
+  // Returns false if any of them fails.
+  bool RunConnection() {
+    int fd;
+    if (net::CreateConnectedSocket(&fd, options_.server_ip,
+                                   options_.server_port, true, true) < 0) {
+      return false;
+    }
+    file_util::ScopedFD scoped_fd(&fd);
+
+    int error = 0;
+    socklen_t error_size = sizeof(error);
+    if (!WaitForSocket(fd, POLLOUT) ||
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_size) != 0 ||
+        error != 0) {
+      LOG(ERROR) << "Unable to connect: " << strerror(error);
+      return false;
+    }
+
+    for (int i = 0; i < options_.requests_per_connection; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      if (!SendRequest(fd) || !ReadResponse(fd))
+        return false;
+      latencies_.push_back(base::TimeTicks::Now() - start);
+    }
+    return true;
+  }
+
+  bool SendRequest(int fd) {
+    size_t written = 0;
+    while (written < request_.size()) {
+      ssize_t rv = HANDLE_EINTR(write(fd, request_.data() + written,
+                                      request_.size() - written));
+      if (rv < 0 && errno == EAGAIN && WaitForSocket(fd, POLLOUT))
+        continue;
+      if (rv <= 0) {
+        LOG(ERROR) << "Unable to send request: " << strerror(errno);
+        return false;
+      }
+      written += rv;
+    }
+    return true;
+  }
+
+  bool ReadResponse(int fd) {
+    framer_.Reset();
+    visitor_.body.clear();
+    char buf[16 * 1024];
+    while (!framer_.MessageFullyRead()) {
+      ssize_t rv = HANDLE_EINTR(read(fd, buf, sizeof(buf)));
+      if (rv < 0 && errno == EAGAIN && WaitForSocket(fd, POLLIN))
+        continue;
+      if (rv <= 0) {
+        LOG(ERROR) << "Connection closed before the response was read: "
+                   << (rv == 0 ? "EOF" : strerror(errno));
+        return false;
+      }
+      // Requests are not pipelined, so all of the data is for this response.
+      size_t consumed = 0;
+      while (consumed < static_cast<size_t>(rv) &&
+             !framer_.MessageFullyRead()) {
+        size_t processed = framer_.ProcessInput(buf + consumed, rv - consumed);
+        if (framer_.Error() || processed == 0) {
+          LOG(ERROR) << "Unable to parse the response: "
+                     << net::BalsaFrameEnums::ErrorCodeToString(
+                            framer_.ErrorCode());
+          return false;
+        }
+        consumed += processed;
+      }
+    }
+    if (visitor_.headers.parsed_response_code() != 200)
+      ++num_non_200_responses_;
+    return true;
+  }
+
+  const LoadOptions options_;
+  std::string request_;
+  net::BalsaFrame framer_;
+  net::StoreBodyAndHeadersVisitor visitor_;
+
+  std::vector<base::TimeDelta> latencies_;
+  int num_connections_;
+  int num_errors_;
+  int num_non_200_responses_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadThread);
+};
+
+// Returns the |percentile|th of the sorted |latencies|, in milliseconds.
+double Percentile(const std::vector<base::TimeDelta>& latencies,
+                  int percentile) {
+  if (latencies.empty())
+    return 0;
+  size_t index = (latencies.size() - 1) * percentile / 100;
+  return latencies[index].InMillisecondsF();
+}
+
+// Parses the integer switch |name| of |cl| into |value|, leaving it alone if
+// the switch is missing.
+bool GetIntSwitch(const CommandLine& cl, const char* name, int* value) {
+  if (!cl.HasSwitch(name))
+    return true;
+  return base::StringToInt(cl.GetSwitchValueASCII(name), value) && *value > 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CommandLine::Init(argc, argv);
+  const CommandLine& cl = *CommandLine::ForCurrentProcess();
+
+  if (cl.HasSwitch("help") || !cl.HasSwitch("server-port")) {
+    cout << argv[0] << " <options>\n";
+    cout << "\t--server-port=<port>\n";
+    cout << "\t--server-ip=<ip> (default is 127.0.0.1)\n";
+    cout << "\t--host=<host header> (default is the server ip)\n";
+    cout << "\t--path=<path> (default is /)\n";
+    cout << "\t--threads=<n> (default is 1)\n";
+    cout << "\t--connections=<n> per thread (default is 1000)\n";
+    cout << "\t--requests-per-connection=<n> (default is 1)\n";
+    cout << "\t--help\n";
+    return cl.HasSwitch("help") ? 0 : 1;
+  }
+
+  LoadOptions options;
+  options.server_ip = cl.HasSwitch("server-ip") ?
+      cl.GetSwitchValueASCII("server-ip") : "127.0.0.1";
+  options.server_port = cl.GetSwitchValueASCII("server-port");
+  options.host = cl.HasSwitch("host") ?
+      cl.GetSwitchValueASCII("host") : options.server_ip;
+  options.path = cl.HasSwitch("path") ? cl.GetSwitchValueASCII("path") : "/";
+  options.connections_per_thread = 1000;
+  options.requests_per_connection = 1;
+  int num_threads = 1;
+  if (!GetIntSwitch(cl, "threads", &num_threads) ||
+      !GetIntSwitch(cl, "connections", &options.connections_per_thread) ||
+      !GetIntSwitch(cl, "requests-per-connection",
+                    &options.requests_per_connection)) {
+    LOG(ERROR) << "Counts must be positive integers.";
+    return 1;
+  }
+
+  ScopedVector<LoadThread> threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.push_back(new LoadThread(options));
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i]->Start();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i]->Join();
+  double seconds = (base::TimeTicks::Now() - start).InSecondsF();
+
+  std::vector<base::TimeDelta> latencies;
+  int num_connections = 0;
+  int num_errors = 0;
+  int num_non_200_responses = 0;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    latencies.insert(latencies.end(), threads[i]->latencies().begin(),
+                     threads[i]->latencies().end());
+    num_connections += threads[i]->num_connections();
+    num_errors += threads[i]->num_errors();
+    num_non_200_responses += threads[i]->num_non_200_responses();
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  cout << "Connections         : " << num_connections << " ("
+       << num_errors << " failed)\n";
+  cout << "Requests            : " << latencies.size() << " ("
+       << num_non_200_responses << " not 200)\n";
+  cout << "Elapsed             : " << seconds << " s\n";
+  cout << "Connections/s       : " << num_connections / seconds << "\n";
+  cout << "Requests/s          : " << latencies.size() / seconds << "\n";
+  cout << "Latency p50         : " << Percentile(latencies, 50) << " ms\n";
+  cout << "Latency p90         : " << Percentile(latencies, 90) << " ms\n";
+  cout << "Latency p99         : " << Percentile(latencies, 99) << " ms\n";
+  cout << "Latency max         : " << Percentile(latencies, 100) << " ms\n";
+  return num_errors ? 1 : 0;
+}
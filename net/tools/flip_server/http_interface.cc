@@ -172,8 +172,9 @@ void HttpSM::ResetForNewConnection() {
       << connection_->server_port_ << " ";
   }
   // Message has not been fully read, either it is incomplete or the
-  // server is closing the connection to signal message end.
-  if (!MessageFullyRead()) {
+  // server is closing the connection to signal message end. There is no
+  // spdy stream to end when serving from the memory cache.
+  if (!MessageFullyRead() && sm_spdy_interface_) {
     VLOG(2) << "HTTP response closed before end of file detected. "
             << "Sending EOF to spdy.";
     sm_spdy_interface_->SendEOF(stream_id_);
@@ -114,6 +114,9 @@ class MemCacheIter {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// The cache is filled before the server starts, and GetFileData() and
+// AssignFileData() do not modify it, so it may be read from several threads
+// at once as long as no files are added.
 class MemoryCache {
  public:
   typedef std::map<std::string, FileData*> Files;
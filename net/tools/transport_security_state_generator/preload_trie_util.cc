@@ -0,0 +1,324 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/transport_security_state_generator/preload_trie_util.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stl_util.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/values.h"
+
+namespace {
+
+// The longest DNS name, and the longest label in one.
+const size_t kMaxNameLength = 253;
+const size_t kMaxLabelLength = 63;
+
+struct Node {
+  Node() : sts_index(-1), sni_sts_index(-1) {}
+  ~Node() { STLDeleteValues(&children); }
+
+  bool has_value() const { return sts_index >= 0 || sni_sts_index >= 0; }
+
+  int sts_index;
+  int sni_sts_index;
+  std::map<char, Node*> children;
+};
+
+// Converts |name| ("www.google.com") to the key used in the trie
+// ("com.google.www"). Returns false if |name| is not a lowercase DNS name.
+bool NameToKey(const std::string& name, std::string* key, size_t* depth) {
+  if (name.empty() || name.size() > kMaxNameLength)
+    return false;
+
+  std::vector<std::string> labels;
+  Tokenize(name, ".", &labels);
+  if (labels.empty() ||
+      std::count(name.begin(), name.end(), '.') + 1 !=
+          static_cast<int>(labels.size())) {
+    // There is an empty label.
+    return false;
+  }
+  for (size_t i = 0; i < labels.size(); ++i) {
+    const std::string& label = labels[i];
+    if (label.size() > kMaxLabelLength)
+      return false;
+    for (size_t j = 0; j < label.size(); ++j) {
+      const char c = label[j];
+      if (!IsAsciiDigit(c) && !(c >= 'a' && c <= 'z') && c != '-' && c != '_')
+        return false;
+    }
+  }
+
+  std::reverse(labels.begin(), labels.end());
+  *key = JoinString(labels, '.');
+  *depth = labels.size();
+  return true;
+}
+
+bool AddName(const std::string& name, bool sni_only, int index, Node* root,
+             size_t* max_depth) {
+  std::string key;
+  size_t depth;
+  if (!NameToKey(name, &key, &depth)) {
+    LOG(ERROR) << "Invalid name: " << name;
+    return false;
+  }
+  *max_depth = std::max(*max_depth, depth);
+
+  Node* node = root;
+  for (size_t i = 0; i < key.size(); ++i) {
+    Node*& child = node->children[key[i]];
+    if (!child)
+      child = new Node;
+    node = child;
+  }
+
+  int* value = sni_only ? &node->sni_sts_index : &node->sts_index;
+  if (*value >= 0) {
+    LOG(ERROR) << "Repeated name: " << name;
+    return false;
+  }
+  *value = index;
+  return true;
+}
+
+size_t ReadUint16(const uint8* trie, size_t offset) {
+  return (trie[offset] << 8) | trie[offset + 1];
+}
+
+void AppendUint16(size_t value, std::vector<uint8>* trie) {
+  trie->push_back(static_cast<uint8>(value >> 8));
+  trie->push_back(static_cast<uint8>(value));
+}
+
+// Appends |node| and, after it, its descendants to |trie|. Returns the offset
+// of |node|.
+size_t AppendNode(const Node& node, std::vector<uint8>* trie) {
+  const size_t offset = trie->size();
+  uint8 flags = 0;
+  if (node.sts_index >= 0)
+    flags |= net::preload_trie::kHasSTS;
+  if (node.sni_sts_index >= 0)
+    flags |= net::preload_trie::kHasSNISTS;
+  trie->push_back(flags);
+  if (node.sts_index >= 0)
+    AppendUint16(node.sts_index, trie);
+  if (node.sni_sts_index >= 0)
+    AppendUint16(node.sni_sts_index, trie);
+  trie->push_back(static_cast<uint8>(node.children.size()));
+
+  // Follow each child down to the next node which has a value or more than one
+  // child, so that the label leading to it covers as many characters as
+  // possible. The offsets of the nodes are filled in once they are appended.
+  std::vector<std::pair<size_t, const Node*> > children;
+  for (std::map<char, Node*>::const_iterator it = node.children.begin();
+       it != node.children.end(); ++it) {
+    std::string label(1, it->first);
+    const Node* child = it->second;
+    while (!child->has_value() && child->children.size() == 1) {
+      label.push_back(child->children.begin()->first);
+      child = child->children.begin()->second;
+    }
+    trie->push_back(static_cast<uint8>(label.size()));
+    trie->insert(trie->end(), label.begin(), label.end());
+    children.push_back(std::make_pair(trie->size(), child));
+    AppendUint16(0, trie);
+  }
+
+  for (size_t i = 0; i < children.size(); ++i) {
+    const size_t child_offset = AppendNode(*children[i].second, trie);
+    (*trie)[children[i].first] = static_cast<uint8>(child_offset >> 8);
+    (*trie)[children[i].first + 1] = static_cast<uint8>(child_offset);
+  }
+  return offset;
+}
+
+std::string FormatTrie(const std::vector<uint8>& trie, size_t max_depth) {
+  std::string data;
+  data.append("// Copyright 2013 The Chromium Authors. All rights reserved.\n"
+              "// Use of this source code is governed by a BSD-style license "
+              "that can be\n"
+              "// found in the LICENSE file.\n\n"
+              "// This file is generated by "
+              "net/tools/transport_security_state_generator/.\n"
+              "// DO NOT MANUALLY EDIT!\n\n"
+              "#ifndef NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_\n"
+              "#define NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_\n\n"
+              "// The names of the entries in kPreloadedSTS and "
+              "kPreloadedSNISTS, as a trie.\n"
+              "// See net/tools/transport_security_state_generator/"
+              "preload_trie_util.h\n"
+              "// for its format.\n\n");
+  data.append(base::StringPrintf(
+      "static const size_t kPreloadTrieMaxDepth = %d;\n\n",
+      static_cast<int>(max_depth)));
+  data.append("static const uint8 kPreloadTrie[] = {");
+  for (size_t i = 0; i < trie.size(); ++i) {
+    data.append(i % 12 ? " " : "\n  ");
+    data.append(base::StringPrintf("0x%02x,", trie[i]));
+  }
+  data.append("\n};\n\n"
+              "#endif  // NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_TRIE_H_\n");
+  return data;
+}
+
+}  // namespace
+
+namespace net {
+namespace preload_trie {
+
+bool ParsePreloads(const std::string& json,
+                   std::vector<std::string>* sts_names,
+                   std::vector<std::string>* sni_sts_names) {
+  scoped_ptr<base::Value> value(base::JSONReader::Read(json));
+  base::DictionaryValue* dict;
+  base::ListValue* entries;
+  if (!value.get() || !value->GetAsDictionary(&dict) ||
+      !dict->GetList("entries", &entries)) {
+    LOG(ERROR) << "No list of entries found.";
+    return false;
+  }
+
+  for (size_t i = 0; i < entries->GetSize(); ++i) {
+    base::DictionaryValue* entry;
+    std::string name;
+    if (!entries->GetDictionary(i, &entry) ||
+        !entry->GetString("name", &name)) {
+      LOG(ERROR) << "Entry " << i << " has no name.";
+      return false;
+    }
+    bool sni_only = false;
+    entry->GetBoolean("snionly", &sni_only);
+    (sni_only ? sni_sts_names : sts_names)->push_back(name);
+  }
+  return true;
+}
+
+bool BuildPreloadTrie(const std::vector<std::string>& sts_names,
+                      const std::vector<std::string>& sni_sts_names,
+                      std::vector<uint8>* trie,
+                      size_t* max_depth) {
+  if (std::max(sts_names.size(), sni_sts_names.size()) > 0xffff) {
+    LOG(ERROR) << "Too many entries.";
+    return false;
+  }
+
+  Node root;
+  *max_depth = 0;
+  for (size_t i = 0; i < sts_names.size(); ++i) {
+    if (!AddName(sts_names[i], false, i, &root, max_depth))
+      return false;
+  }
+  for (size_t i = 0; i < sni_sts_names.size(); ++i) {
+    if (!AddName(sni_sts_names[i], true, i, &root, max_depth))
+      return false;
+  }
+
+  trie->clear();
+  AppendNode(root, trie);
+  // The last node appended has the largest offset.
+  if (trie->size() > 0xffff) {
+    LOG(ERROR) << "The trie is too large for 16 bit offsets.";
+    return false;
+  }
+  return true;
+}
+
+bool LookupPreloadTrie(const uint8* trie,
+                       size_t trie_size,
+                       const std::string& name,
+                       int* sts_index,
+                       int* sni_sts_index) {
+  std::string key;
+  size_t depth;
+  if (!NameToKey(name, &key, &depth))
+    return false;
+
+  size_t node = 0;
+  size_t matched = 0;
+  while (true) {
+    size_t offset = node;
+    if (offset >= trie_size)
+      return false;
+    const uint8 flags = trie[offset++];
+    const size_t value_size = ((flags & kHasSTS) ? 2 : 0) +
+                              ((flags & kHasSNISTS) ? 2 : 0);
+    if (offset + value_size >= trie_size)
+      return false;
+
+    if (matched == key.size()) {
+      if (!flags)
+        return false;
+      *sts_index = -1;
+      *sni_sts_index = -1;
+      if (flags & kHasSTS) {
+        *sts_index = ReadUint16(trie, offset);
+        offset += 2;
+      }
+      if (flags & kHasSNISTS)
+        *sni_sts_index = ReadUint16(trie, offset);
+      return true;
+    }
+
+    offset += value_size;
+    const uint8 num_children = trie[offset++];
+    size_t i = 0;
+    for (; i < num_children; ++i) {
+      if (offset >= trie_size || offset + 1 + trie[offset] + 2 > trie_size)
+        return false;
+      if (trie[offset + 1] == static_cast<uint8>(key[matched]))
+        break;
+      offset += 1 + trie[offset] + 2;
+    }
+    if (i == num_children)
+      return false;
+
+    const size_t length = trie[offset];
+    if (key.compare(matched, length,
+                    reinterpret_cast<const char*>(&trie[offset + 1]),
+                    length) != 0) {
+      return false;
+    }
+    matched += length;
+    node = ReadUint16(trie, offset + 1 + length);
+  }
+}
+
+bool GenerateFile(const base::FilePath& in_filename,
+                  const base::FilePath& out_filename) {
+  std::string json;
+  if (!file_util::ReadFileToString(in_filename, &json)) {
+    LOG(ERROR) << "Unable to read " << in_filename.value();
+    return false;
+  }
+
+  std::vector<std::string> sts_names;
+  std::vector<std::string> sni_sts_names;
+  std::vector<uint8> trie;
+  size_t max_depth;
+  if (!ParsePreloads(json, &sts_names, &sni_sts_names) ||
+      !BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth)) {
+    return false;
+  }
+
+  const std::string data = FormatTrie(trie, max_depth);
+  if (file_util::WriteFile(out_filename, data.data(), data.size()) !=
+      static_cast<int>(data.size())) {
+    LOG(ERROR) << "Error writing " << out_filename.value();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace preload_trie
+}  // namespace net
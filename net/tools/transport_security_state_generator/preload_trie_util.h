@@ -0,0 +1,74 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_TOOLS_TRANSPORT_SECURITY_STATE_GENERATOR_PRELOAD_TRIE_UTIL_H_
+#define NET_TOOLS_TRANSPORT_SECURITY_STATE_GENERATOR_PRELOAD_TRIE_UTIL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace net {
+namespace preload_trie {
+
+// The trie maps the names of the preloaded entries, with their labels in
+// reverse order and separated by dots ("com.google.www"), to their indices in
+// kPreloadedSTS and kPreloadedSNISTS. Each node of the trie is laid out as
+//
+//   uint8 flags               kHasSTS | kHasSNISTS
+//   uint16 sts_index          only if flags has kHasSTS
+//   uint16 sni_sts_index      only if flags has kHasSNISTS
+//   uint8 num_children
+//   num_children times:
+//     uint8 length
+//     char label[length]      the characters leading to the child
+//     uint16 child_offset     from the start of the trie
+//
+// with integers in big-endian order. The root is at offset 0. The labels of
+// the children of a node start with distinct characters, and nodes other than
+// the root which have no value have at least two children.
+enum NodeFlags {
+  kHasSTS = 1 << 0,
+  kHasSNISTS = 1 << 1,
+};
+
+// Reads the names of the entries in |json|, which has the format of
+// transport_security_state_static.json, into |sts_names| and
+// |sni_sts_names| in the order of kPreloadedSTS and kPreloadedSNISTS.
+bool ParsePreloads(const std::string& json,
+                   std::vector<std::string>* sts_names,
+                   std::vector<std::string>* sni_sts_names);
+
+// Builds the trie for the given names into |trie|, and sets |max_depth| to
+// the largest number of labels in any of them. Returns false if a name is
+// invalid or repeated, or if the trie does not fit the format.
+bool BuildPreloadTrie(const std::vector<std::string>& sts_names,
+                      const std::vector<std::string>& sni_sts_names,
+                      std::vector<uint8>* trie,
+                      size_t* max_depth);
+
+// Looks up |name| in |trie|, of |trie_size| bytes, and sets |sts_index| and
+// |sni_sts_index| to its indices in kPreloadedSTS and kPreloadedSNISTS, or to
+// -1 if it has no entry in that table. Returns false if it has no entry in
+// either of them.
+bool LookupPreloadTrie(const uint8* trie,
+                       size_t trie_size,
+                       const std::string& name,
+                       int* sts_index,
+                       int* sni_sts_index);
+
+// Loads the file described by |in_filename|, builds the trie for it and saves
+// it, as C++ source, into |out_filename|.
+bool GenerateFile(const base::FilePath& in_filename,
+                  const base::FilePath& out_filename);
+
+}  // namespace preload_trie
+}  // namespace net
+
+#endif  // NET_TOOLS_TRANSPORT_SECURITY_STATE_GENERATOR_PRELOAD_TRIE_UTIL_H_
@@ -0,0 +1,201 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/transport_security_state_generator/preload_trie_util.h"
+
+#include "base/basictypes.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "net/http/transport_security_state_static_trie.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace preload_trie {
+
+TEST(PreloadTrieUtilTest, ParsePreloads) {
+  std::string json =
+      "// A comment.\n"
+      "{\n"
+      "  \"pinsets\": [],\n"
+      "  \"entries\": [\n"
+      "    { \"name\": \"a.com\", \"include_subdomains\": true },\n"
+      "    { \"name\": \"b.com\", \"snionly\": true },\n"
+      "    { \"name\": \"c.com\", \"mode\": \"force-https\" }\n"
+      "  ]\n"
+      "}\n";
+  std::vector<std::string> sts_names;
+  std::vector<std::string> sni_sts_names;
+  ASSERT_TRUE(ParsePreloads(json, &sts_names, &sni_sts_names));
+  ASSERT_EQ(2U, sts_names.size());
+  EXPECT_EQ("a.com", sts_names[0]);
+  EXPECT_EQ("c.com", sts_names[1]);
+  ASSERT_EQ(1U, sni_sts_names.size());
+  EXPECT_EQ("b.com", sni_sts_names[0]);
+
+  EXPECT_FALSE(ParsePreloads("{}", &sts_names, &sni_sts_names));
+  EXPECT_FALSE(ParsePreloads("{ \"entries\": [ {} ] }", &sts_names,
+                             &sni_sts_names));
+}
+
+TEST(PreloadTrieUtilTest, SingleName) {
+  std::vector<std::string> sts_names(1, "a.b");
+  std::vector<std::string> sni_sts_names;
+  std::vector<uint8> trie;
+  size_t max_depth;
+  ASSERT_TRUE(BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth));
+  EXPECT_EQ(2U, max_depth);
+
+  const uint8 kExpected[] = {
+    // The root: no value, one child labelled "b.a" at offset 8.
+    0x00, 0x01, 0x03, 'b', '.', 'a', 0x00, 0x08,
+    // The child: index 0 in kPreloadedSTS, no children.
+    kHasSTS, 0x00, 0x00, 0x00,
+  };
+  EXPECT_EQ(std::vector<uint8>(kExpected, kExpected + arraysize(kExpected)),
+            trie);
+}
+
+TEST(PreloadTrieUtilTest, SharedSuffixes) {
+  std::vector<std::string> sts_names;
+  sts_names.push_back("a.com");
+  sts_names.push_back("b.com");
+  std::vector<std::string> sni_sts_names(1, "a.com");
+  std::vector<uint8> trie;
+  size_t max_depth;
+  ASSERT_TRUE(BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth));
+  EXPECT_EQ(2U, max_depth);
+
+  const uint8 kExpected[] = {
+    // The root: no value, one child labelled "com." at offset 9.
+    0x00, 0x01, 0x04, 'c', 'o', 'm', '.', 0x00, 0x09,
+    // "com.": no value, children "a" at offset 19 and "b" at offset 25.
+    0x00, 0x02, 0x01, 'a', 0x00, 0x13, 0x01, 'b', 0x00, 0x19,
+    // "com.a": index 0 in both tables.
+    kHasSTS | kHasSNISTS, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // "com.b": index 1 in kPreloadedSTS.
+    kHasSTS, 0x00, 0x01, 0x00,
+  };
+  EXPECT_EQ(std::vector<uint8>(kExpected, kExpected + arraysize(kExpected)),
+            trie);
+}
+
+TEST(PreloadTrieUtilTest, InvalidNames) {
+  const char* const kInvalidNames[] = {
+    "", ".", "a..com", ".a.com", "a.com.", "A.com", "a b.com", "a/b.com",
+  };
+  for (size_t i = 0; i < arraysize(kInvalidNames); ++i) {
+    std::vector<std::string> sts_names(1, kInvalidNames[i]);
+    std::vector<std::string> sni_sts_names;
+    std::vector<uint8> trie;
+    size_t max_depth;
+    EXPECT_FALSE(BuildPreloadTrie(sts_names, sni_sts_names, &trie,
+                                  &max_depth)) << kInvalidNames[i];
+  }
+}
+
+TEST(PreloadTrieUtilTest, RepeatedName) {
+  std::vector<std::string> sts_names(2, "a.com");
+  std::vector<std::string> sni_sts_names;
+  std::vector<uint8> trie;
+  size_t max_depth;
+  EXPECT_FALSE(BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth));
+}
+
+TEST(PreloadTrieUtilTest, Lookup) {
+  std::vector<std::string> sts_names;
+  sts_names.push_back("a.com");
+  sts_names.push_back("b.com");
+  sts_names.push_back("www.b.com");
+  std::vector<std::string> sni_sts_names(1, "a.com");
+  std::vector<uint8> trie;
+  size_t max_depth;
+  ASSERT_TRUE(BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth));
+
+  int sts_index;
+  int sni_sts_index;
+  ASSERT_TRUE(LookupPreloadTrie(&trie[0], trie.size(), "a.com", &sts_index,
+                                &sni_sts_index));
+  EXPECT_EQ(0, sts_index);
+  EXPECT_EQ(0, sni_sts_index);
+  ASSERT_TRUE(LookupPreloadTrie(&trie[0], trie.size(), "www.b.com",
+                                &sts_index, &sni_sts_index));
+  EXPECT_EQ(2, sts_index);
+  EXPECT_EQ(-1, sni_sts_index);
+
+  const char* const kMissingNames[] = {
+    "com", "c.com", "ww.b.com", "www.a.com", "b.co", "a.com.b",
+  };
+  for (size_t i = 0; i < arraysize(kMissingNames); ++i) {
+    EXPECT_FALSE(LookupPreloadTrie(&trie[0], trie.size(), kMissingNames[i],
+                                   &sts_index, &sni_sts_index))
+        << kMissingNames[i];
+  }
+}
+
+namespace {
+
+// Reads the names in transport_security_state_static.json, in the order of
+// kPreloadedSTS and kPreloadedSNISTS.
+void ReadCheckedInPreloads(std::vector<std::string>* sts_names,
+                           std::vector<std::string>* sni_sts_names) {
+  base::FilePath json_file;
+  ASSERT_TRUE(PathService::Get(base::DIR_SOURCE_ROOT, &json_file));
+  json_file = json_file.Append(FILE_PATH_LITERAL("net"))
+                       .Append(FILE_PATH_LITERAL("http"))
+                       .Append(FILE_PATH_LITERAL(
+                           "transport_security_state_static.json"));
+  std::string json;
+  ASSERT_TRUE(file_util::ReadFileToString(json_file, &json));
+  ASSERT_TRUE(ParsePreloads(json, sts_names, sni_sts_names));
+}
+
+}  // namespace
+
+// transport_security_state_static_trie.h must be regenerated whenever
+// transport_security_state_static.json changes.
+TEST(PreloadTrieUtilTest, CheckedInTrieIsUpToDate) {
+  std::vector<std::string> sts_names;
+  std::vector<std::string> sni_sts_names;
+  ASSERT_NO_FATAL_FAILURE(ReadCheckedInPreloads(&sts_names, &sni_sts_names));
+  std::vector<uint8> trie;
+  size_t max_depth;
+  ASSERT_TRUE(BuildPreloadTrie(sts_names, sni_sts_names, &trie, &max_depth));
+
+  EXPECT_EQ(kPreloadTrieMaxDepth, max_depth);
+  EXPECT_TRUE(std::vector<uint8>(kPreloadTrie,
+                                 kPreloadTrie + arraysize(kPreloadTrie)) ==
+              trie);
+}
+
+// Every name in kPreloadedSTS and kPreloadedSNISTS leads to its own index in
+// the checked-in trie.
+TEST(PreloadTrieUtilTest, CheckedInTrieFindsEveryName) {
+  std::vector<std::string> sts_names;
+  std::vector<std::string> sni_sts_names;
+  ASSERT_NO_FATAL_FAILURE(ReadCheckedInPreloads(&sts_names, &sni_sts_names));
+  ASSERT_FALSE(sts_names.empty());
+  ASSERT_FALSE(sni_sts_names.empty());
+
+  for (size_t i = 0; i < sts_names.size(); ++i) {
+    int sts_index;
+    int sni_sts_index;
+    ASSERT_TRUE(LookupPreloadTrie(kPreloadTrie, arraysize(kPreloadTrie),
+                                  sts_names[i], &sts_index, &sni_sts_index))
+        << sts_names[i];
+    EXPECT_EQ(static_cast<int>(i), sts_index) << sts_names[i];
+  }
+  for (size_t i = 0; i < sni_sts_names.size(); ++i) {
+    int sts_index;
+    int sni_sts_index;
+    ASSERT_TRUE(LookupPreloadTrie(kPreloadTrie, arraysize(kPreloadTrie),
+                                  sni_sts_names[i], &sts_index,
+                                  &sni_sts_index))
+        << sni_sts_names[i];
+    EXPECT_EQ(static_cast<int>(i), sni_sts_index) << sni_sts_names[i];
+  }
+}
+
+}  // namespace preload_trie
+}  // namespace net
@@ -0,0 +1,54 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This command-line program builds the trie which TransportSecurityState
+// uses to look up the preloaded HSTS and pinning entries for a host, so that
+// the lookup takes time proportional to the length of the host rather than
+// to the number of entries, and no time is spent on program initialization.
+//
+// Running this program finds "transport_security_state_static.json" in the
+// expected location in the source checkout and generates
+// "transport_security_state_static_trie.h" next to it.
+
+#include <stdio.h>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/process/memory.h"
+#include "net/tools/transport_security_state_generator/preload_trie_util.h"
+
+int main(int argc, const char* argv[]) {
+  base::EnableTerminationOnHeapCorruption();
+  if (argc != 1) {
+    fprintf(stderr, "Generates the trie of preloaded HSTS entries\n");
+    fprintf(stderr, "Usage: %s\n", argv[0]);
+    return 1;
+  }
+
+  // Manages the destruction of singletons.
+  base::AtExitManager exit_manager;
+
+  CommandLine::Init(argc, argv);
+
+  base::FilePath input_file;
+  PathService::Get(base::DIR_SOURCE_ROOT, &input_file);
+  input_file = input_file.Append(FILE_PATH_LITERAL("net"))
+                         .Append(FILE_PATH_LITERAL("http"))
+                         .Append(FILE_PATH_LITERAL(
+                             "transport_security_state_static.json"));
+  base::FilePath output_file;
+  PathService::Get(base::DIR_SOURCE_ROOT, &output_file);
+  output_file = output_file.Append(FILE_PATH_LITERAL("net"))
+                           .Append(FILE_PATH_LITERAL("http"))
+                           .Append(FILE_PATH_LITERAL(
+                               "transport_security_state_static_trie.h"));
+  if (!net::preload_trie::GenerateFile(input_file, output_file)) {
+    fprintf(stderr, "Error generating the trie.\n");
+    return 1;
+  }
+  return 0;
+}
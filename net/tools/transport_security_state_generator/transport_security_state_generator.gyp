@@ -0,0 +1,22 @@
+# Copyright 2013 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+{
+  'variables': {
+    'chromium_code': 1,
+  },
+  'targets': [
+    {
+      'target_name': 'preload_trie_util',
+      'type': 'static_library',
+      'dependencies': [
+        '../../../base/base.gyp:base',
+      ],
+      'sources': [
+        'preload_trie_util.h',
+        'preload_trie_util.cc',
+      ],
+    },
+  ],
+}
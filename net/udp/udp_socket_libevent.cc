@@ -7,7 +7,9 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netdb.h>
+#include <string.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <netinet/in.h>
 
 #include "base/callback.h"
@@ -29,10 +31,68 @@ const int kBindRetries = 10;
 const int kPortStart = 1024;
 const int kPortEnd = 65535;
 
+// Room for the receive timestamp control message of one datagram.
+#if defined(SO_TIMESTAMPNS)
+const int kTimestampOption = SO_TIMESTAMPNS;
+const int kTimestampControlSize = CMSG_SPACE(sizeof(struct timespec));
+#else
+const int kTimestampOption = SO_TIMESTAMP;
+const int kTimestampControlSize = CMSG_SPACE(sizeof(struct timeval));
+#endif
+
+// Returns the kernel receive timestamp carried by |msg|, if any.
+base::Time GetReceiveTimestamp(struct msghdr* msg) {
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+#if defined(SO_TIMESTAMPNS)
+    if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      struct timespec ts;
+      memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+      return base::Time::FromTimeSpec(ts);
+    }
+#endif
+    if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+      struct timeval tv;
+      memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+      return base::Time::FromTimeVal(tv);
+    }
+  }
+  return base::Time();
+}
+
 }  // namespace
 
 namespace net {
 
+UDPDatagramBatch::UDPDatagramBatch(int max_datagrams, int max_datagram_size)
+    : max_datagrams_(max_datagrams),
+      max_datagram_size_(max_datagram_size),
+      buffer_(new IOBuffer(max_datagrams * max_datagram_size)),
+      lengths_(max_datagrams),
+      addresses_(max_datagrams),
+      timestamps_(max_datagrams),
+      size_(0),
+      headers_(max_datagrams),
+      iovs_(max_datagrams),
+      names_(max_datagrams),
+      control_(max_datagrams * kTimestampControlSize) {
+  DCHECK_GT(max_datagrams, 0);
+  DCHECK_GT(max_datagram_size, 0);
+  for (int i = 0; i < max_datagrams; ++i) {
+    struct msghdr* msg = header(i);
+    iovs_[i].iov_base = slot(i);
+    iovs_[i].iov_len = max_datagram_size;
+    msg->msg_name = &names_[i];
+    msg->msg_iov = &iovs_[i];
+    msg->msg_iovlen = 1;
+    msg->msg_control = &control_[i * kTimestampControlSize];
+  }
+}
+
+UDPDatagramBatch::~UDPDatagramBatch() {}
+
 UDPSocketLibevent::UDPSocketLibevent(
     DatagramSocket::BindType bind_type,
     const RandIntCallback& rand_int_cb,
@@ -49,6 +109,9 @@ UDPSocketLibevent::UDPSocketLibevent(
           read_buf_len_(0),
           recv_from_address_(NULL),
           write_buf_len_(0),
+#if defined(OS_LINUX)
+          recvmmsg_unavailable_(false),
+#endif
           net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_UDP_SOCKET)) {
   net_log_.BeginEvent(NetLog::TYPE_SOCKET_ALIVE,
                       source.ToEventParametersCallback());
@@ -72,6 +135,7 @@ void UDPSocketLibevent::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_batch_ = NULL;
   write_buf_ = NULL;
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -168,6 +232,32 @@ int UDPSocketLibevent::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketLibevent::RecvMultiple(UDPDatagramBatch* batch,
+                                    const CompletionCallback& callback) {
+  DCHECK(CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_);
+  DCHECK(read_callback_.is_null());
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK(batch);
+
+  int result = InternalRecvMultiple(batch);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!base::MessageLoopForIO::current()->WatchFileDescriptor(
+          socket_, true, base::MessageLoopForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    int result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_batch_ = batch;
+  read_callback_ = callback;
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketLibevent::Write(IOBuffer* buf,
                              int buf_len,
                              const CompletionCallback& callback) {
@@ -288,6 +378,16 @@ bool UDPSocketLibevent::SetReceiveBufferSize(int32 size) {
   return rv == 0;
 }
 
+bool UDPSocketLibevent::GetReceiveBufferSize(int32* size) const {
+  DCHECK(CalledOnValidThread());
+  DCHECK(size);
+  socklen_t size_len = sizeof(*size);
+  int rv = getsockopt(socket_, SOL_SOCKET, SO_RCVBUF,
+                      reinterpret_cast<char*>(size), &size_len);
+  DCHECK(!rv) << "Could not get socket receive buffer size: " << errno;
+  return rv == 0;
+}
+
 bool UDPSocketLibevent::SetSendBufferSize(int32 size) {
   DCHECK(CalledOnValidThread());
   int rv = setsockopt(socket_, SOL_SOCKET, SO_SNDBUF,
@@ -341,12 +441,14 @@ void UDPSocketLibevent::DoWriteCallback(int rv) {
 }
 
 void UDPSocketLibevent::DidCompleteRead() {
-  int result =
+  int result = read_batch_.get() ?
+      InternalRecvMultiple(read_batch_.get()) :
       InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_batch_ = NULL;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -450,6 +552,69 @@ int UDPSocketLibevent::InternalRecvFrom(IOBuffer* buf, int buf_len,
   return result;
 }
 
+int UDPSocketLibevent::InternalRecvMultiple(UDPDatagramBatch* batch) {
+  const int max_datagrams = batch->max_datagrams();
+  // The kernel updates the lengths of the names and control messages.
+  for (int i = 0; i < max_datagrams; ++i) {
+    struct msghdr* msg = batch->header(i);
+    msg->msg_namelen = sizeof(batch->names_[i]);
+    msg->msg_controllen = kTimestampControlSize;
+  }
+
+  // A non-blocking recvmmsg() returns the datagrams which are queued, up to
+  // |max_datagrams|, and only fails if there are none. Where it is not
+  // available, do the same with one recvmsg() per datagram.
+  int count = -1;
+  bool read_each_datagram = true;
+#if defined(OS_LINUX)
+  if (!recvmmsg_unavailable_) {
+    count = HANDLE_EINTR(recvmmsg(socket_, &batch->headers_[0], max_datagrams,
+                                  MSG_DONTWAIT, NULL));
+    // Kernels older than 2.6.33 don't have it.
+    if (count < 0 && errno == ENOSYS) {
+      recvmmsg_unavailable_ = true;
+    } else {
+      read_each_datagram = false;
+      for (int i = 0; i < count; ++i)
+        batch->lengths_[i] = batch->headers_[i].msg_len;
+    }
+  }
+#endif
+  if (read_each_datagram) {
+    count = 0;
+    while (count < max_datagrams) {
+      ssize_t rv = HANDLE_EINTR(recvmsg(socket_, batch->header(count),
+                                        MSG_DONTWAIT));
+      if (rv < 0) {
+        if (count == 0)
+          count = -1;
+        break;
+      }
+      batch->lengths_[count++] = rv;
+    }
+  }
+  if (count < 0) {
+    int result = MapSystemError(errno);
+    if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    struct msghdr* msg = batch->header(i);
+    const struct sockaddr* addr =
+        reinterpret_cast<const struct sockaddr*>(&batch->names_[i]);
+    if (!batch->addresses_[i].FromSockAddr(addr, msg->msg_namelen)) {
+      LogRead(ERR_FAILED, NULL, 0, NULL);
+      return ERR_FAILED;
+    }
+    batch->timestamps_[i] = GetReceiveTimestamp(msg);
+    LogRead(batch->lengths_[i], batch->data(i), msg->msg_namelen, addr);
+  }
+  batch->size_ = count;
+  return count;
+}
+
 int UDPSocketLibevent::InternalSendTo(IOBuffer* buf, int buf_len,
                                       const IPEndPoint* address) {
   SockaddrStorage storage;
@@ -556,6 +721,19 @@ int UDPSocketLibevent::RandomBind(const IPEndPoint& address) {
   return DoBind(IPEndPoint(ip, 0));
 }
 
+int UDPSocketLibevent::SetReceiveTimestamps(bool enabled) {
+  DCHECK(CalledOnValidThread());
+  if (!is_connected())
+    return ERR_SOCKET_NOT_CONNECTED;
+
+  int value = enabled ? 1 : 0;
+  int rv = setsockopt(socket_, SOL_SOCKET, kTimestampOption, &value,
+                      sizeof(value));
+  if (rv < 0)
+    return MapSystemError(errno);
+  return OK;
+}
+
 int UDPSocketLibevent::JoinGroup(const IPAddressNumber& group_address) const {
   DCHECK(CalledOnValidThread());
   if (!is_connected())
@@ -5,10 +5,18 @@
 #ifndef NET_UDP_UDP_SOCKET_LIBEVENT_H_
 #define NET_UDP_UDP_SOCKET_LIBEVENT_H_
 
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <vector>
+
+#include "base/logging.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
 #include "net/base/completion_callback.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
@@ -19,6 +27,73 @@
 
 namespace net {
 
+// The buffers for the datagrams read by UDPSocketLibevent::RecvMultiple(): up
+// to |max_datagrams| datagrams of up to |max_datagram_size| bytes each, with
+// their senders and kernel receive timestamps. Larger datagrams are truncated.
+class NET_EXPORT UDPDatagramBatch
+    : public base::RefCounted<UDPDatagramBatch> {
+ public:
+  UDPDatagramBatch(int max_datagrams, int max_datagram_size);
+
+  int max_datagrams() const { return max_datagrams_; }
+  int max_datagram_size() const { return max_datagram_size_; }
+
+  // The number of datagrams read by the last RecvMultiple().
+  int size() const { return size_; }
+
+  // The contents, length and sender of the |i|th datagram read.
+  const char* data(int i) const { return buffer_->data() + Offset(i); }
+  int length(int i) const { return lengths_[i]; }
+  const IPEndPoint& address(int i) const { return addresses_[i]; }
+
+  // When the kernel received the |i|th datagram, or a null Time if receive
+  // timestamps are not enabled on the socket.
+  base::Time timestamp(int i) const { return timestamps_[i]; }
+
+ private:
+  friend class base::RefCounted<UDPDatagramBatch>;
+  friend class UDPSocketLibevent;
+
+  ~UDPDatagramBatch();
+
+  int Offset(int i) const {
+    DCHECK_GE(i, 0);
+    DCHECK_LT(i, max_datagrams_);
+    return i * max_datagram_size_;
+  }
+  char* slot(int i) { return buffer_->data() + Offset(i); }
+
+  // The message header that receives the |i|th datagram.
+  struct msghdr* header(int i) {
+#if defined(OS_LINUX)
+    return &headers_[i].msg_hdr;
+#else
+    return &headers_[i];
+#endif
+  }
+
+  const int max_datagrams_;
+  const int max_datagram_size_;
+  scoped_refptr<IOBuffer> buffer_;
+  std::vector<int> lengths_;
+  std::vector<IPEndPoint> addresses_;
+  std::vector<base::Time> timestamps_;
+  int size_;
+
+  // The message headers pointing into |buffer_|, set up once so that reading
+  // a batch doesn't allocate.
+#if defined(OS_LINUX)
+  std::vector<struct mmsghdr> headers_;
+#else
+  std::vector<struct msghdr> headers_;
+#endif
+  std::vector<struct iovec> iovs_;
+  std::vector<struct sockaddr_storage> names_;
+  std::vector<char> control_;
+
+  DISALLOW_COPY_AND_ASSIGN(UDPDatagramBatch);
+};
+
 class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
  public:
   UDPSocketLibevent(DatagramSocket::BindType bind_type,
@@ -78,6 +153,16 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
                IPEndPoint* address,
                const CompletionCallback& callback);
 
+  // Reads into |batch| as many of the datagrams queued on the socket as it
+  // holds, with a single recvmmsg() where it is available, so that a burst of
+  // datagrams costs one wakeup rather than one per datagram. Waits for the
+  // first datagram if none is queued.
+  // Returns the number of datagrams read, a net error code, or ERR_IO_PENDING
+  // if the IO is in progress, in which case the caller must keep |batch| alive
+  // until |callback| is called with the number of datagrams or an error.
+  // Cannot be outstanding at the same time as RecvFrom() or Read().
+  int RecvMultiple(UDPDatagramBatch* batch, const CompletionCallback& callback);
+
   // Send to a socket with a particular destination.
   // |buf| is the buffer to send
   // |buf_len| is the number of bytes to send
@@ -95,6 +180,10 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
   // Set the receive buffer size (in bytes) for the socket.
   bool SetReceiveBufferSize(int32 size);
 
+  // Gets the receive buffer size (in bytes) the socket ended up with, which
+  // the kernel may have rounded or capped after SetReceiveBufferSize().
+  bool GetReceiveBufferSize(int32* size) const;
+
   // Set the send buffer size (in bytes) for the socket.
   bool SetSendBufferSize(int32 size);
 
@@ -113,6 +202,12 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
   // called before Bind().
   void AllowBroadcast();
 
+  // Enables or disables the kernel receive timestamps reported by
+  // RecvMultiple(), with nanosecond resolution where SO_TIMESTAMPNS is
+  // available and microseconds elsewhere. Should be called after Bind() or
+  // Connect(). Return a network error code.
+  int SetReceiveTimestamps(bool enabled);
+
   // Join the multicast group.
   // |group_address| is the group address to join, could be either
   // an IPv4 or IPv6 address.
@@ -218,6 +313,7 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
 
   int InternalConnect(const IPEndPoint& address);
   int InternalRecvFrom(IOBuffer* buf, int buf_len, IPEndPoint* address);
+  int InternalRecvMultiple(UDPDatagramBatch* batch);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -262,6 +358,15 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+  // The batch used by InternalRecvMultiple() to retry RecvMultiple requests.
+  scoped_refptr<UDPDatagramBatch> read_batch_;
+
+#if defined(OS_LINUX)
+  // Set once recvmmsg() fails with ENOSYS, after which InternalRecvMultiple()
+  // reads one datagram at a time.
+  bool recvmmsg_unavailable_;
+#endif
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
@@ -0,0 +1,121 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/udp/udp_socket.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/perftimer.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/base/test_completion_callback.h"
+#include "net/udp/udp_client_socket.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Bursts of QUIC sized datagrams, which the receive buffer is large enough to
+// hold so that none of them are dropped on loopback.
+const int kDatagramSize = 1350;
+const int kBurstSize = 64;
+const int kNumBursts = 2000;
+const int32 kReceiveBufferSize = 1024 * 1024;
+
+enum ReadMode {
+  READ_RECV_FROM,
+  READ_RECV_MULTIPLE,
+};
+
+// Sends bursts of datagrams to a socket on loopback and reads each burst back
+// with |mode|, from batches of |batch_size| datagrams when reading with
+// RecvMultiple(). Logs the datagrams/s read as |name|.
+void RunLoopbackTest(const std::string& name,
+                     ReadMode mode,
+                     int batch_size,
+                     bool timestamps) {
+  IPAddressNumber localhost;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &localhost));
+  UDPSocket server(DatagramSocket::DEFAULT_BIND, RandIntCallback(), NULL,
+                   NetLog::Source());
+  ASSERT_EQ(OK, server.Bind(IPEndPoint(localhost, 0)));
+  ASSERT_TRUE(server.SetReceiveBufferSize(kReceiveBufferSize));
+  if (timestamps)
+    ASSERT_EQ(OK, server.SetReceiveTimestamps(true));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, RandIntCallback(),
+                         NULL, NetLog::Source());
+  ASSERT_EQ(OK, client.Connect(server_address));
+
+  scoped_refptr<IOBufferWithSize> write_buf(
+      new IOBufferWithSize(kDatagramSize));
+  memset(write_buf->data(), 'x', kDatagramSize);
+  scoped_refptr<IOBufferWithSize> read_buf(
+      new IOBufferWithSize(kDatagramSize));
+  IPEndPoint from;
+  scoped_refptr<UDPDatagramBatch> batch(
+      new UDPDatagramBatch(batch_size, kDatagramSize));
+
+  // Only the reads are timed.
+  base::TimeDelta elapsed;
+  for (int i = 0; i < kNumBursts; ++i) {
+    for (int j = 0; j < kBurstSize; ++j) {
+      TestCompletionCallback callback;
+      int rv = client.Write(write_buf.get(), kDatagramSize,
+                            callback.callback());
+      ASSERT_EQ(kDatagramSize, callback.GetResult(rv));
+    }
+
+    PerfTimer timer;
+    int left = kBurstSize;
+    while (left > 0) {
+      TestCompletionCallback callback;
+      int rv;
+      if (mode == READ_RECV_FROM) {
+        rv = callback.GetResult(server.RecvFrom(
+            read_buf.get(), kDatagramSize, &from, callback.callback()));
+        ASSERT_EQ(kDatagramSize, rv);
+        rv = 1;
+      } else {
+        rv = callback.GetResult(server.RecvMultiple(batch.get(),
+                                                    callback.callback()));
+        ASSERT_GT(rv, 0);
+      }
+      left -= rv;
+    }
+    elapsed += timer.Elapsed();
+  }
+
+  LogPerfResult(name.c_str(),
+                kBurstSize * kNumBursts / elapsed.InSecondsF(),
+                "datagrams/s");
+}
+
+}  // namespace
+
+// Measures how many datagrams/s UDPSocket reads on loopback, one per
+// RecvFrom() and in batches with RecvMultiple(), with and without receive
+// timestamps.
+TEST(UDPSocketPerfTest, LoopbackReceive) {
+  base::MessageLoopForIO message_loop;
+  RunLoopbackTest("udp_recv_from", READ_RECV_FROM, 1, false);
+  RunLoopbackTest("udp_recv_multiple_8", READ_RECV_MULTIPLE, 8, false);
+  RunLoopbackTest("udp_recv_multiple_32", READ_RECV_MULTIPLE, 32, false);
+  RunLoopbackTest("udp_recv_multiple_32_timestamps", READ_RECV_MULTIPLE, 32,
+                  true);
+}
+
+}  // namespace net
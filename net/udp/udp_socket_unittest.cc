@@ -9,6 +9,8 @@
 #include "base/bind.h"
 #include "base/metrics/histogram.h"
 #include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -580,6 +582,125 @@ TEST_F(UDPSocketTest, MulticastOptions) {
   socket.Close();
 }
 
+#if defined(OS_POSIX)
+// Reads with RecvMultiple() until |count| datagrams have been read into
+// |datagrams|, with batches of up to |batch_size|.
+void RecvMultipleFromSocket(UDPSocket* socket,
+                            int count,
+                            int batch_size,
+                            std::vector<std::string>* datagrams,
+                            std::vector<IPEndPoint>* addresses) {
+  scoped_refptr<UDPDatagramBatch> batch(
+      new UDPDatagramBatch(batch_size, 1024));
+  while (static_cast<int>(datagrams->size()) < count) {
+    TestCompletionCallback callback;
+    int rv = socket->RecvMultiple(batch.get(), callback.callback());
+    if (rv == ERR_IO_PENDING)
+      rv = callback.WaitForResult();
+    ASSERT_GT(rv, 0);
+    ASSERT_LE(rv, batch_size);
+    ASSERT_EQ(rv, batch->size());
+    for (int i = 0; i < rv; ++i) {
+      datagrams->push_back(std::string(batch->data(i), batch->length(i)));
+      addresses->push_back(batch->address(i));
+    }
+  }
+}
+
+TEST_F(UDPSocketTest, RecvMultiple) {
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPSocket server(DatagramSocket::DEFAULT_BIND, RandIntCallback(), NULL,
+                   NetLog::Source());
+  ASSERT_EQ(OK, server.Bind(bind_address));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, RandIntCallback(),
+                         NULL, NetLog::Source());
+  ASSERT_EQ(OK, client.Connect(server_address));
+  IPEndPoint client_address;
+  ASSERT_EQ(OK, client.GetLocalAddress(&client_address));
+
+  // Nothing is queued yet, so the first read waits for a datagram.
+  scoped_refptr<UDPDatagramBatch> batch(new UDPDatagramBatch(3, 1024));
+  TestCompletionCallback callback;
+  int rv = server.RecvMultiple(batch.get(), callback.callback());
+  ASSERT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(5, WriteSocket(&client, "first"));
+  EXPECT_EQ(1, callback.WaitForResult());
+  EXPECT_EQ("first", std::string(batch->data(0), batch->length(0)));
+  EXPECT_TRUE(client_address == batch->address(0));
+  // Timestamps were not asked for.
+  EXPECT_TRUE(batch->timestamp(0).is_null());
+
+  // A burst is read a batch at a time, in order.
+  const int kNumDatagrams = 7;
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    std::string message = base::StringPrintf("datagram %d", i);
+    EXPECT_EQ(static_cast<int>(message.size()), WriteSocket(&client, message));
+  }
+  std::vector<std::string> datagrams;
+  std::vector<IPEndPoint> addresses;
+  RecvMultipleFromSocket(&server, kNumDatagrams, 3, &datagrams, &addresses);
+  ASSERT_EQ(static_cast<size_t>(kNumDatagrams), datagrams.size());
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    EXPECT_EQ(base::StringPrintf("datagram %d", i), datagrams[i]);
+    EXPECT_TRUE(client_address == addresses[i]);
+  }
+}
+
+TEST_F(UDPSocketTest, RecvMultipleTimestamps) {
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPSocket server(DatagramSocket::DEFAULT_BIND, RandIntCallback(), NULL,
+                   NetLog::Source());
+  EXPECT_EQ(ERR_SOCKET_NOT_CONNECTED, server.SetReceiveTimestamps(true));
+  ASSERT_EQ(OK, server.Bind(bind_address));
+  ASSERT_EQ(OK, server.SetReceiveTimestamps(true));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, RandIntCallback(),
+                         NULL, NetLog::Source());
+  ASSERT_EQ(OK, client.Connect(server_address));
+
+  base::Time before = base::Time::Now();
+  EXPECT_EQ(5, WriteSocket(&client, "hello"));
+  EXPECT_EQ(5, WriteSocket(&client, "world"));
+  std::vector<std::string> datagrams;
+  std::vector<IPEndPoint> addresses;
+  scoped_refptr<UDPDatagramBatch> batch(new UDPDatagramBatch(1, 1024));
+  for (int i = 0; i < 2; ++i) {
+    TestCompletionCallback callback;
+    int rv = server.RecvMultiple(batch.get(), callback.callback());
+    if (rv == ERR_IO_PENDING)
+      rv = callback.WaitForResult();
+    ASSERT_EQ(1, rv);
+    // Allow for the clock the kernel uses being slightly coarser.
+    EXPECT_FALSE(batch->timestamp(0).is_null());
+    EXPECT_LE(before - base::TimeDelta::FromMilliseconds(10),
+              batch->timestamp(0));
+    EXPECT_GE(base::Time::Now(), batch->timestamp(0));
+  }
+}
+
+TEST_F(UDPSocketTest, ReceiveBufferSize) {
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPSocket socket(DatagramSocket::DEFAULT_BIND, RandIntCallback(), NULL,
+                   NetLog::Source());
+  ASSERT_EQ(OK, socket.Bind(bind_address));
+
+  const int32 kSize = 64 * 1024;
+  EXPECT_TRUE(socket.SetReceiveBufferSize(kSize));
+  int32 size = 0;
+  EXPECT_TRUE(socket.GetReceiveBufferSize(&size));
+  // Linux reserves twice the requested size for its bookkeeping.
+  EXPECT_GE(size, kSize);
+}
+#endif  // defined(OS_POSIX)
+
 }  // namespace
 
 }  // namespace net
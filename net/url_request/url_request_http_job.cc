@@ -4,6 +4,10 @@
 
 #include "net/url_request/url_request_http_job.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include "base/base_switches.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
@@ -18,6 +22,7 @@
 #include "base/time/time.h"
 #include "net/base/filter.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/io_buffer.h"
 #include "net/base/load_flags.h"
 #include "net/base/mime_util.h"
 #include "net/base/net_errors.h"
@@ -51,6 +56,9 @@ static const char kAvailDictionaryHeader[] = "Avail-Dictionary";
 
 namespace net {
 
+const int URLRequestHttpJob::kReadAheadBufferSize = 32 * 1024;
+const int URLRequestHttpJob::kMaxReadAheadBytes = 256 * 1024;
+
 class URLRequestHttpJob::HttpFilterContext : public FilterContext {
  public:
   explicit HttpFilterContext(URLRequestHttpJob* job);
@@ -250,6 +258,10 @@ URLRequestHttpJob::URLRequestHttpJob(
           base::Bind(&URLRequestHttpJob::NotifyBeforeSendHeadersCallback,
                      base::Unretained(this))),
       read_in_progress_(false),
+      read_ahead_done_(false),
+      read_ahead_result_(OK),
+      read_buf_size_(0),
+      sdch_dictionary_can_persist_(false),
       throttling_entry_(NULL),
       sdch_dictionary_advertised_(false),
       sdch_test_activated_(false),
@@ -303,7 +315,8 @@ URLRequestHttpJob::~URLRequestHttpJob() {
     // coding to assure that IF the system is shutting down, we don't have any
     // problem if the manager was deleted ahead of time.
     if (manager)  // Defensive programming.
-      manager->FetchDictionary(request_info_.url, sdch_dictionary_url_);
+      manager->FetchDictionary(request_info_.url, sdch_dictionary_url_,
+                               sdch_dictionary_can_persist_);
   }
   DoneWithRequest(ABORTED);
 }
@@ -405,6 +418,9 @@ void URLRequestHttpJob::NotifyHeadersComplete() {
       DCHECK_EQ(request_->url(), request_info_.url);
       // Resolve suggested URL relative to request url.
       sdch_dictionary_url_ = request_info_.url.Resolve(url_text);
+      sdch_dictionary_can_persist_ =
+          !network_delegate() ||
+          network_delegate()->CanPersistSdchDictionary(*request_);
     }
   }
 
@@ -434,6 +450,7 @@ void URLRequestHttpJob::DestroyTransaction() {
 
   DoneWithRequest(ABORTED);
   transaction_.reset();
+  ResetReadAhead();
   response_info_ = NULL;
   receive_headers_end_ = base::TimeTicks();
 }
@@ -562,14 +579,16 @@ void URLRequestHttpJob::AddExtraHeaders() {
     // easier to filter and analyze the streams to assure that a proxy has not
     // damaged these headers.  Some proxies deliberately corrupt Accept-Encoding
     // headers.
-    if (!advertise_sdch) {
-      // Tell the server what compression formats we support (other than SDCH).
-      request_info_.extra_headers.SetHeader(
-          HttpRequestHeaders::kAcceptEncoding, "gzip,deflate");
-    } else {
+    std::string accept_encoding = "gzip,deflate";
+    if (Filter::lzma_encoding_enabled())
+      accept_encoding += ",lzma";
+    if (advertise_sdch) {
       // Include SDCH in acceptable list.
-      request_info_.extra_headers.SetHeader(
-          HttpRequestHeaders::kAcceptEncoding, "gzip,deflate,sdch");
+      accept_encoding += ",sdch";
+    }
+    request_info_.extra_headers.SetHeader(
+        HttpRequestHeaders::kAcceptEncoding, accept_encoding);
+    if (advertise_sdch) {
       if (!avail_dictionaries.empty()) {
         request_info_.extra_headers.SetHeader(
             kAvailDictionaryHeader,
@@ -938,6 +957,79 @@ void URLRequestHttpJob::OnReadCompleted(int result) {
   NotifyReadComplete(result);
 }
 
+void URLRequestHttpJob::ReadAhead() {
+  // Reads which come back short still hold on to a whole buffer, so the
+  // budget is counted in buffers rather than in bytes of the body.
+  while (!read_ahead_buf_.get() && !read_ahead_done_ &&
+         static_cast<int>(read_ahead_data_.size()) * kReadAheadBufferSize <
+             kMaxReadAheadBytes) {
+    read_ahead_buf_ = new IOBuffer(kReadAheadBufferSize);
+    int rv = transaction_->Read(
+        read_ahead_buf_.get(), kReadAheadBufferSize,
+        base::Bind(&URLRequestHttpJob::OnReadAheadCompleted,
+                   base::Unretained(this)));
+    if (rv == ERR_IO_PENDING)
+      return;
+    DidReadAhead(rv);
+  }
+}
+
+void URLRequestHttpJob::OnReadAheadCompleted(int result) {
+  DidReadAhead(result);
+  if (!read_in_progress_) {
+    ReadAhead();
+    return;
+  }
+
+  int rv = TakeReadAheadData(read_buf_.get(), read_buf_size_);
+  DCHECK_NE(ERR_IO_PENDING, rv);
+  read_buf_ = NULL;
+  read_buf_size_ = 0;
+  // Start the next read before handing the data over, as the consumer may
+  // take a while with it.
+  ReadAhead();
+  OnReadCompleted(rv);
+}
+
+void URLRequestHttpJob::DidReadAhead(int result) {
+  DCHECK(read_ahead_buf_.get());
+  DCHECK_NE(ERR_IO_PENDING, result);
+  scoped_refptr<IOBuffer> buf;
+  buf.swap(read_ahead_buf_);
+  if (result <= 0) {
+    read_ahead_done_ = true;
+    read_ahead_result_ = result;
+    return;
+  }
+  read_ahead_data_.push_back(new DrainableIOBuffer(buf.get(), result));
+}
+
+int URLRequestHttpJob::TakeReadAheadData(IOBuffer* buf, int buf_size) {
+  if (read_ahead_data_.empty())
+    return read_ahead_done_ ? read_ahead_result_ : ERR_IO_PENDING;
+
+  int bytes_taken = 0;
+  while (bytes_taken < buf_size && !read_ahead_data_.empty()) {
+    DrainableIOBuffer* data = read_ahead_data_.front().get();
+    int bytes = std::min(data->BytesRemaining(), buf_size - bytes_taken);
+    memcpy(buf->data() + bytes_taken, data->data(), bytes);
+    data->DidConsume(bytes);
+    if (!data->BytesRemaining())
+      read_ahead_data_.pop_front();
+    bytes_taken += bytes;
+  }
+  return bytes_taken;
+}
+
+void URLRequestHttpJob::ResetReadAhead() {
+  read_ahead_data_.clear();
+  read_ahead_buf_ = NULL;
+  read_ahead_done_ = false;
+  read_ahead_result_ = OK;
+  read_buf_ = NULL;
+  read_buf_size_ = 0;
+}
+
 void URLRequestHttpJob::RestartTransactionWithAuth(
     const AuthCredentials& credentials) {
   auth_credentials_ = credentials;
@@ -1254,9 +1346,26 @@ bool URLRequestHttpJob::ReadRawData(IOBuffer* buf, int buf_size,
   DCHECK(bytes_read);
   DCHECK(!read_in_progress_);
 
-  int rv = transaction_->Read(
-      buf, buf_size,
-      base::Bind(&URLRequestHttpJob::OnReadCompleted, base::Unretained(this)));
+  int rv;
+  if (request_info_.load_flags & LOAD_READ_AHEAD) {
+    // The body is read from |transaction_| into buffers of its own, which
+    // keeps going while the consumer is busy with the data it has taken.
+    // HttpTransaction only supports one read at a time, so the read-ahead
+    // stops when the consumer falls kMaxReadAheadBytes behind.
+    ReadAhead();
+    rv = TakeReadAheadData(buf, buf_size);
+    if (rv > 0)
+      ReadAhead();
+    if (rv == ERR_IO_PENDING) {
+      read_buf_ = buf;
+      read_buf_size_ = buf_size;
+    }
+  } else {
+    rv = transaction_->Read(
+        buf, buf_size,
+        base::Bind(&URLRequestHttpJob::OnReadCompleted,
+                   base::Unretained(this)));
+  }
 
   if (ShouldFixMismatchedContentLength(rv))
     rv = 0;
@@ -5,6 +5,7 @@
 #ifndef NET_URL_REQUEST_URL_REQUEST_HTTP_JOB_H_
 #define NET_URL_REQUEST_URL_REQUEST_HTTP_JOB_H_
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -22,6 +23,7 @@
 
 namespace net {
 
+class DrainableIOBuffer;
 class HttpResponseHeaders;
 class HttpResponseInfo;
 class HttpTransaction;
@@ -37,6 +39,12 @@ class NET_EXPORT_PRIVATE URLRequestHttpJob : public URLRequestJob {
                                 NetworkDelegate* network_delegate,
                                 const std::string& scheme);
 
+  // With LOAD_READ_AHEAD, the size of the buffers the body is read into, and
+  // how much buffer space may be held for the consumer before the read-ahead
+  // stops. Every buffer counts in full, however little of it was filled.
+  static const int kReadAheadBufferSize;
+  static const int kMaxReadAheadBytes;
+
  protected:
   URLRequestHttpJob(URLRequest* request,
                     NetworkDelegate* network_delegate,
@@ -90,6 +98,18 @@ class NET_EXPORT_PRIVATE URLRequestHttpJob : public URLRequestJob {
   void OnReadCompleted(int result);
   void NotifyBeforeSendHeadersCallback(int result);
 
+  // With LOAD_READ_AHEAD, reads from |transaction_| into |read_ahead_data_|
+  // until the read-ahead budget is used up, the body has been read, or a read
+  // is pending.
+  void ReadAhead();
+  void OnReadAheadCompleted(int result);
+  void DidReadAhead(int result);
+  // Moves up to |buf_size| bytes of |read_ahead_data_| into |buf|. Returns the
+  // number of bytes moved, or if there are none the final result of the
+  // read-ahead (0 or an error), or ERR_IO_PENDING if it has yet to finish.
+  int TakeReadAheadData(IOBuffer* buf, int buf_size);
+  void ResetReadAhead();
+
   void RestartTransactionWithAuth(const AuthCredentials& credentials);
 
   // Overridden from URLRequestJob:
@@ -187,8 +207,23 @@ class NET_EXPORT_PRIVATE URLRequestHttpJob : public URLRequestJob {
 
   bool read_in_progress_;
 
+  // With LOAD_READ_AHEAD, the part of the body read from |transaction_| which
+  // has yet to be passed to ReadRawData().
+  std::deque<scoped_refptr<DrainableIOBuffer> > read_ahead_data_;
+  // The buffer of the pending read-ahead, if any.
+  scoped_refptr<IOBuffer> read_ahead_buf_;
+  // Whether |transaction_| has returned the end of the body or an error, and
+  // which, to be returned once |read_ahead_data_| has been taken.
+  bool read_ahead_done_;
+  int read_ahead_result_;
+  // The buffer passed to ReadRawData() while it waits for the read-ahead.
+  scoped_refptr<IOBuffer> read_buf_;
+  int read_buf_size_;
+
   // An URL for an SDCH dictionary as suggested in a Get-Dictionary HTTP header.
   GURL sdch_dictionary_url_;
+  // Whether the dictionary at |sdch_dictionary_url_| may be saved to disk.
+  bool sdch_dictionary_can_persist_;
 
   scoped_ptr<HttpTransaction> transaction_;
 
@@ -0,0 +1,127 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/url_request/url_request_http_job.h"
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/location.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/perftimer.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_transaction_unittest.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kBodySize = 4 * 1024 * 1024;
+const int kReadSize = 32 * 1024;
+
+// Reads the body |kReadSize| bytes at a time, spending |delay| on each
+// buffer before asking for the next one, as a consumer which has to pass the
+// data on to another process would.
+class ThrottledDelegate : public URLRequest::Delegate {
+ public:
+  ThrottledDelegate(base::TimeDelta delay, const base::Closure& done_callback)
+      : delay_(delay),
+        done_callback_(done_callback),
+        buf_(new IOBuffer(kReadSize)),
+        bytes_received_(0),
+        weak_factory_(this) {}
+
+  int bytes_received() const { return bytes_received_; }
+
+  virtual void OnResponseStarted(URLRequest* request) OVERRIDE {
+    Read(request);
+  }
+
+  virtual void OnReadCompleted(URLRequest* request, int bytes_read) OVERRIDE {
+    if (bytes_read <= 0) {
+      done_callback_.Run();
+      return;
+    }
+    bytes_received_ += bytes_read;
+    base::MessageLoop::current()->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&ThrottledDelegate::Read, weak_factory_.GetWeakPtr(),
+                   request),
+        delay_);
+  }
+
+ private:
+  void Read(URLRequest* request) {
+    int bytes_read = 0;
+    if (request->Read(buf_.get(), kReadSize, &bytes_read))
+      OnReadCompleted(request, bytes_read);
+    else if (!request->status().is_io_pending())
+      done_callback_.Run();
+  }
+
+  const base::TimeDelta delay_;
+  base::Closure done_callback_;
+  scoped_refptr<IOBuffer> buf_;
+  int bytes_received_;
+  base::WeakPtrFactory<ThrottledDelegate> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThrottledDelegate);
+};
+
+// Downloads a |kBodySize| byte body over a network which takes |read_delay|
+// for every read, through a consumer which takes |consumer_delay| for every
+// buffer, and logs the throughput as |name|.
+void RunDownloadTest(const std::string& name,
+                     int load_flags,
+                     base::TimeDelta read_delay,
+                     base::TimeDelta consumer_delay) {
+  std::string body(kBodySize, 'x');
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.data = body.c_str();
+
+  MockNetworkLayer network_layer;
+  network_layer.set_read_delay(read_delay);
+  TestURLRequestContext context(true);
+  context.set_http_transaction_factory(&network_layer);
+  context.Init();
+
+  base::RunLoop run_loop;
+  ThrottledDelegate delegate(consumer_delay, run_loop.QuitClosure());
+  URLRequest request(GURL(transaction.url), &delegate, &context, NULL);
+  request.set_load_flags(load_flags);
+
+  PerfTimer timer;
+  request.Start();
+  run_loop.Run();
+  double seconds = timer.Elapsed().InSecondsF();
+
+  EXPECT_TRUE(request.status().is_success());
+  EXPECT_EQ(kBodySize, delegate.bytes_received());
+  LogPerfResult(name.c_str(), kBodySize / seconds / (1024 * 1024), "MB/s");
+}
+
+}  // namespace
+
+// Measures the throughput of a large download through a consumer which is
+// about as slow as the network, with and without LOAD_READ_AHEAD.
+TEST(URLRequestHttpJobPerfTest, ThrottledConsumer) {
+  base::MessageLoopForIO message_loop;
+  const base::TimeDelta kDelay = base::TimeDelta::FromMilliseconds(1);
+  RunDownloadTest("url_request_http_job_throttled", 0, kDelay, kDelay);
+  RunDownloadTest("url_request_http_job_throttled_read_ahead",
+                  LOAD_READ_AHEAD, kDelay, kDelay);
+}
+
+}  // namespace net
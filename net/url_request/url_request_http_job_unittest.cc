@@ -5,10 +5,16 @@
 #include "net/url_request/url_request_http_job.h"
 
 #include <cstddef>
+#include <string>
 
+#include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/memory/ref_counted.h"
+#include "base/run_loop.h"
 #include "net/base/auth.h"
+#include "net/base/io_buffer.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
 #include "net/http/http_transaction_factory.h"
 #include "net/http/http_transaction_unittest.h"
 #include "net/url_request/url_request_status.h"
@@ -50,6 +56,40 @@ class URLRequestHttpJobTest : public ::testing::Test {
   TestURLRequest req_;
 };
 
+// A body several times larger than the read-ahead budget.
+std::string MakeLargeBody() {
+  std::string body(2 * 1024 * 1024, 0);
+  for (size_t i = 0; i < body.size(); ++i)
+    body[i] = 'a' + i % 26;
+  return body;
+}
+
+const int kReadOnceBufferSize = 4096;
+
+// Reads the first |kReadOnceBufferSize| bytes of the body and then leaves the
+// request alone.
+class ReadOnceDelegate : public URLRequest::Delegate {
+ public:
+  ReadOnceDelegate()
+      : buf_(new IOBuffer(kReadOnceBufferSize)), bytes_read_(0) {}
+
+  int bytes_read() const { return bytes_read_; }
+
+  virtual void OnResponseStarted(URLRequest* request) OVERRIDE {
+    int bytes_read = 0;
+    if (request->Read(buf_.get(), kReadOnceBufferSize, &bytes_read))
+      OnReadCompleted(request, bytes_read);
+  }
+
+  virtual void OnReadCompleted(URLRequest* request, int bytes_read) OVERRIDE {
+    bytes_read_ = bytes_read;
+  }
+
+ private:
+  scoped_refptr<IOBuffer> buf_;
+  int bytes_read_;
+};
+
 // Make sure that SetPriority actually sets the URLRequestHttpJob's
 // priority, both before and after start.
 TEST_F(URLRequestHttpJobTest, SetPriorityBasic) {
@@ -115,6 +155,74 @@ TEST_F(URLRequestHttpJobTest, SetSubsequentTransactionPriority) {
   EXPECT_EQ(LOW, network_layer_.last_transaction()->priority());
 }
 
+// Make sure that the whole body is passed on with LOAD_READ_AHEAD, whether
+// the transaction reads complete synchronously or not.
+TEST_F(URLRequestHttpJobTest, ReadAhead) {
+  const std::string body = MakeLargeBody();
+  const int kTestModes[] = { TEST_MODE_NORMAL, TEST_MODE_SYNC_NET_READ };
+  for (size_t i = 0; i < arraysize(kTestModes); ++i) {
+    ScopedMockTransaction transaction(kSimpleGET_Transaction);
+    transaction.data = body.c_str();
+    transaction.test_mode = kTestModes[i];
+
+    TestDelegate delegate;
+    TestURLRequest request(GURL(transaction.url), &delegate, &context_, NULL);
+    request.set_load_flags(LOAD_READ_AHEAD);
+    request.Start();
+    base::RunLoop().Run();
+
+    EXPECT_TRUE(request.status().is_success());
+    EXPECT_EQ(1, delegate.response_started_count());
+    EXPECT_TRUE(body == delegate.data_received());
+  }
+}
+
+// Make sure that the read-ahead stops once the consumer is far enough behind,
+// and that cancelling the request with a read-ahead in progress is safe.
+TEST_F(URLRequestHttpJobTest, ReadAheadStopsWhenConsumerIsBehind) {
+  const std::string body = MakeLargeBody();
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.data = body.c_str();
+
+  ReadOnceDelegate delegate;
+  TestURLRequest request(GURL(transaction.url), &delegate, &context_, NULL);
+  request.set_load_flags(LOAD_READ_AHEAD);
+  request.Start();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(kReadOnceBufferSize, delegate.bytes_read());
+  ASSERT_TRUE(network_layer_.last_transaction());
+  // Besides what the consumer took, the job holds at most
+  // kMaxReadAheadBytes of buffers, and may have one more read pending.
+  int data_cursor = network_layer_.last_transaction()->data_cursor();
+  EXPECT_GT(data_cursor, kReadOnceBufferSize);
+  EXPECT_LE(data_cursor, kReadOnceBufferSize +
+                             URLRequestHttpJob::kMaxReadAheadBytes +
+                             URLRequestHttpJob::kReadAheadBufferSize);
+
+  request.Cancel();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(URLRequestStatus::CANCELED, request.status().status());
+}
+
+// Make sure that the body is only read when the consumer asks for it without
+// LOAD_READ_AHEAD.
+TEST_F(URLRequestHttpJobTest, NoReadAhead) {
+  const std::string body = MakeLargeBody();
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.data = body.c_str();
+
+  ReadOnceDelegate delegate;
+  TestURLRequest request(GURL(transaction.url), &delegate, &context_, NULL);
+  request.Start();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(kReadOnceBufferSize, delegate.bytes_read());
+  ASSERT_TRUE(network_layer_.last_transaction());
+  EXPECT_EQ(kReadOnceBufferSize,
+            network_layer_.last_transaction()->data_cursor());
+}
+
 }  // namespace
 
 }  // namespace net
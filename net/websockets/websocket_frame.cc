@@ -9,10 +9,19 @@
 #include "base/basictypes.h"
 #include "base/logging.h"
 #include "base/rand_util.h"
+#include "build/build_config.h"
 #include "net/base/big_endian.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#define WEBSOCKET_MASK_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define WEBSOCKET_MASK_USE_NEON
+#endif
+
 namespace {
 
 const uint8 kFinalBit = 0x80;
@@ -162,13 +171,17 @@ void MaskWebSocketFramePayload(const WebSocketMaskingKey& masking_key,
 
   DCHECK_GE(data_size, 0);
 
-  // Most of the masking is done one word at a time, except for the beginning
-  // and the end of the buffer which may be unaligned. We use size_t to get the
-  // word size for this architecture. We require it be a multiple of
-  // kMaskingKeyLength in size.
+  // Most of the masking is done one block at a time, except for the beginning
+  // and the end of the buffer which may be unaligned. Where SSE2 or NEON is
+  // available a block is a 16-byte vector register, otherwise we use size_t to
+  // get the word size for this architecture. We require the block size be a
+  // multiple of kMaskingKeyLength.
+#if defined(WEBSOCKET_MASK_USE_SSE2) || defined(WEBSOCKET_MASK_USE_NEON)
+  static const size_t kPackedMaskKeySize = 16;
+#else
   typedef size_t PackedMaskType;
-  PackedMaskType packed_mask_key = 0;
-  static const size_t kPackedMaskKeySize = sizeof(packed_mask_key);
+  static const size_t kPackedMaskKeySize = sizeof(PackedMaskType);
+#endif
   COMPILE_ASSERT((kPackedMaskKeySize >= kMaskingKeyLength &&
                   kPackedMaskKeySize % kMaskingKeyLength == 0),
                  word_size_is_not_multiple_of_mask_length);
@@ -202,6 +215,31 @@ void MaskWebSocketFramePayload(const WebSocketMaskingKey& masking_key,
       realigned_mask,
       realigned_mask + kMaskingKeyLength);
 
+#if defined(WEBSOCKET_MASK_USE_SSE2) || defined(WEBSOCKET_MASK_USE_NEON)
+  // Broadcasting the 32-bit mask to every lane preserves its byte order in
+  // memory, whatever the endianness of the machine.
+  uint32 mask32;
+  COMPILE_ASSERT(sizeof(mask32) == kMaskingKeyLength, mask_is_not_32_bits);
+  memcpy(&mask32, realigned_mask, sizeof(mask32));
+#endif
+
+#if defined(WEBSOCKET_MASK_USE_SSE2)
+  const __m128i packed_mask_key = _mm_set1_epi32(static_cast<int>(mask32));
+  for (char* merged = aligned_begin; merged != aligned_end;
+       merged += kPackedMaskKeySize) {
+    __m128i* block = reinterpret_cast<__m128i*>(merged);
+    _mm_store_si128(block,
+                    _mm_xor_si128(_mm_load_si128(block), packed_mask_key));
+  }
+#elif defined(WEBSOCKET_MASK_USE_NEON)
+  const uint8x16_t packed_mask_key = vreinterpretq_u8_u32(vdupq_n_u32(mask32));
+  for (char* merged = aligned_begin; merged != aligned_end;
+       merged += kPackedMaskKeySize) {
+    uint8* block = reinterpret_cast<uint8*>(merged);
+    vst1q_u8(block, veorq_u8(vld1q_u8(block), packed_mask_key));
+  }
+#else
+  PackedMaskType packed_mask_key = 0;
   for (size_t i = 0; i < kPackedMaskKeySize; i += kMaskingKeyLength) {
     // memcpy() is allegedly blessed by the C++ standard for type-punning.
     memcpy(reinterpret_cast<char*>(&packed_mask_key) + i,
@@ -219,6 +257,7 @@ void MaskWebSocketFramePayload(const WebSocketMaskingKey& masking_key,
     // future compiler/architecture breaks it.
     *reinterpret_cast<PackedMaskType*>(merged) ^= packed_mask_key;
   }
+#endif
 
   MaskWebSocketFramePayloadByBytes(
       masking_key,
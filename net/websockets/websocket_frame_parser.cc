@@ -28,14 +28,34 @@ const uint8 kPayloadLengthMask = 0x7F;
 const uint64 kMaxPayloadLengthWithoutExtendedLengthField = 125;
 const uint64 kPayloadLengthWithTwoByteExtendedLengthField = 126;
 const uint64 kPayloadLengthWithEightByteExtendedLengthField = 127;
+const size_t kMaximumFrameHeaderSize =
+    net::WebSocketFrameHeader::kBaseHeaderSize +
+    net::WebSocketFrameHeader::kMaximumExtendedLengthSize +
+    net::WebSocketFrameHeader::kMaskingKeyLength;
+
+// An IOBufferWithSize which refers to part of the payload data inside another
+// IOBuffer, and keeps that buffer alive.
+class WebSocketPayloadSlice : public net::IOBufferWithSize {
+ public:
+  WebSocketPayloadSlice(net::IOBuffer* backing, char* data, int size)
+      : net::IOBufferWithSize(data, size),
+        backing_(backing) {}
+
+ private:
+  virtual ~WebSocketPayloadSlice() {
+    // |data_| is owned by |backing_|.
+    data_ = NULL;
+  }
+
+  scoped_refptr<net::IOBuffer> backing_;
+};
 
 }  // Unnamed namespace.
 
 namespace net {
 
 WebSocketFrameParser::WebSocketFrameParser()
-    : current_read_pos_(0),
-      frame_offset_(0),
+    : frame_offset_(0),
       websocket_error_(kWebSocketNormalClosure) {
   std::fill(masking_key_.key,
             masking_key_.key + WebSocketFrameHeader::kMaskingKeyLength,
@@ -48,66 +68,99 @@ bool WebSocketFrameParser::Decode(
     const char* data,
     size_t length,
     ScopedVector<WebSocketFrameChunk>* frame_chunks) {
+  return DecodeInternal(data, length, NULL, frame_chunks);
+}
+
+bool WebSocketFrameParser::DecodeInPlace(
+    IOBuffer* buffer,
+    size_t length,
+    ScopedVector<WebSocketFrameChunk>* frame_chunks) {
+  DCHECK(buffer);
+  return DecodeInternal(buffer->data(), length, buffer, frame_chunks);
+}
+
+bool WebSocketFrameParser::DecodeInternal(
+    const char* data,
+    size_t length,
+    IOBuffer* backing,
+    ScopedVector<WebSocketFrameChunk>* frame_chunks) {
   if (websocket_error_ != kWebSocketNormalClosure)
     return false;
   if (!length)
     return true;
 
-  // TODO(yutak): Remove copy.
-  buffer_.insert(buffer_.end(), data, data + length);
-
-  while (current_read_pos_ < buffer_.size()) {
+  const char* current = data;
+  const char* const end = data + length;
+  while (current < end) {
     bool first_chunk = false;
     if (!current_frame_header_.get()) {
-      DecodeFrameHeader();
-      if (websocket_error_ != kWebSocketNormalClosure)
-        return false;
-      // If frame header is incomplete, then carry over the remaining
-      // data to the next round of Decode().
-      if (!current_frame_header_.get())
-        break;
+      if (buffer_.empty()) {
+        size_t header_size = DecodeFrameHeader(current, end - current);
+        if (websocket_error_ != kWebSocketNormalClosure)
+          return false;
+        // If frame header is incomplete, then carry over the remaining
+        // data to the next round of Decode().
+        if (!header_size) {
+          buffer_.assign(current, end);
+          break;
+        }
+        current += header_size;
+      } else {
+        // Complete the header carried over from the previous round. Copying
+        // enough bytes for the largest possible header is sufficient.
+        size_t carried_size = buffer_.size();
+        size_t copy_size = std::min<size_t>(
+            end - current, kMaximumFrameHeaderSize - carried_size);
+        buffer_.insert(buffer_.end(), current, current + copy_size);
+        size_t header_size =
+            DecodeFrameHeader(&buffer_.front(), buffer_.size());
+        if (websocket_error_ != kWebSocketNormalClosure)
+          return false;
+        if (!header_size) {
+          DCHECK_EQ(static_cast<size_t>(end - current), copy_size);
+          break;
+        }
+        DCHECK_GT(header_size, carried_size);
+        current += header_size - carried_size;
+        buffer_.clear();
+      }
       first_chunk = true;
     }
 
-    scoped_ptr<WebSocketFrameChunk> frame_chunk =
-        DecodeFramePayload(first_chunk);
+    size_t consumed = 0;
+    scoped_ptr<WebSocketFrameChunk> frame_chunk = DecodeFramePayload(
+        first_chunk, current, end - current, backing, &consumed);
     DCHECK(frame_chunk.get());
     frame_chunks->push_back(frame_chunk.release());
+    current += consumed;
 
     if (current_frame_header_.get()) {
-      DCHECK(current_read_pos_ == buffer_.size());
+      DCHECK(current == end);
       break;
     }
   }
 
-  // Drain unnecessary data. TODO(yutak): Remove copy. (but how?)
-  buffer_.erase(buffer_.begin(), buffer_.begin() + current_read_pos_);
-  current_read_pos_ = 0;
-
   // Sanity check: the size of carried-over data should not exceed
   // the maximum possible length of a frame header.
-  static const size_t kMaximumFrameHeaderSize =
-      WebSocketFrameHeader::kBaseHeaderSize +
-      WebSocketFrameHeader::kMaximumExtendedLengthSize +
-      WebSocketFrameHeader::kMaskingKeyLength;
   DCHECK_LT(buffer_.size(), kMaximumFrameHeaderSize);
 
   return true;
 }
 
-void WebSocketFrameParser::DecodeFrameHeader() {
+size_t WebSocketFrameParser::DecodeFrameHeader(const char* data,
+                                               size_t length) {
   typedef WebSocketFrameHeader::OpCode OpCode;
   static const int kMaskingKeyLength = WebSocketFrameHeader::kMaskingKeyLength;
 
   DCHECK(!current_frame_header_.get());
 
-  const char* start = &buffer_.front() + current_read_pos_;
+  const char* start = data;
   const char* current = start;
-  const char* end = &buffer_.front() + buffer_.size();
+  const char* end = data + length;
 
   // Header needs 2 bytes at minimum.
   if (end - current < 2)
-    return;
+    return 0;
 
   uint8 first_byte = *current++;
   uint8 second_byte = *current++;
@@ -122,7 +175,7 @@ void WebSocketFrameParser::DecodeFrameHeader() {
   uint64 payload_length = second_byte & kPayloadLengthMask;
   if (payload_length == kPayloadLengthWithTwoByteExtendedLengthField) {
     if (end - current < 2)
-      return;
+      return 0;
     uint16 payload_length_16;
     ReadBigEndian(current, &payload_length_16);
     current += 2;
@@ -131,7 +184,7 @@ void WebSocketFrameParser::DecodeFrameHeader() {
       websocket_error_ = kWebSocketErrorProtocolError;
   } else if (payload_length == kPayloadLengthWithEightByteExtendedLengthField) {
     if (end - current < 8)
-      return;
+      return 0;
     ReadBigEndian(current, &payload_length);
     current += 8;
     if (payload_length <= kuint16max ||
@@ -143,15 +196,14 @@ void WebSocketFrameParser::DecodeFrameHeader() {
   }
   if (websocket_error_ != kWebSocketNormalClosure) {
     buffer_.clear();
-    current_read_pos_ = 0;
     current_frame_header_.reset();
     frame_offset_ = 0;
-    return;
+    return 0;
   }
 
   if (masked) {
     if (end - current < kMaskingKeyLength)
-      return;
+      return 0;
     std::copy(current, current + kMaskingKeyLength, masking_key_.key);
     current += kMaskingKeyLength;
   } else {
@@ -165,16 +217,18 @@ void WebSocketFrameParser::DecodeFrameHeader() {
   current_frame_header_->reserved3 = reserved3;
   current_frame_header_->masked = masked;
   current_frame_header_->payload_length = payload_length;
-  current_read_pos_ += current - start;
   DCHECK_EQ(0u, frame_offset_);
+  return current - start;
 }
 
 scoped_ptr<WebSocketFrameChunk> WebSocketFrameParser::DecodeFramePayload(
-    bool first_chunk) {
-  const char* current = &buffer_.front() + current_read_pos_;
-  const char* end = &buffer_.front() + buffer_.size();
+    bool first_chunk,
+    const char* data,
+    size_t length,
+    IOBuffer* backing,
+    size_t* consumed) {
   uint64 next_size = std::min<uint64>(
-      end - current, current_frame_header_->payload_length - frame_offset_);
+      length, current_frame_header_->payload_length - frame_offset_);
   // This check must pass because |payload_length| is already checked to be
   // less than std::numeric_limits<int>::max() when the header is parsed.
   DCHECK_LE(next_size, static_cast<uint64>(kint32max));
@@ -185,19 +239,24 @@ scoped_ptr<WebSocketFrameChunk> WebSocketFrameParser::DecodeFramePayload(
   }
   frame_chunk->final_chunk = false;
   if (next_size) {
-    frame_chunk->data = new IOBufferWithSize(static_cast<int>(next_size));
-    char* io_data = frame_chunk->data->data();
-    memcpy(io_data, current, next_size);
+    if (backing) {
+      char* payload = backing->data() + (data - backing->data());
+      frame_chunk->data = new WebSocketPayloadSlice(
+          backing, payload, static_cast<int>(next_size));
+    } else {
+      frame_chunk->data = new IOBufferWithSize(static_cast<int>(next_size));
+      memcpy(frame_chunk->data->data(), data, next_size);
+    }
     if (current_frame_header_->masked) {
       // The masking function is its own inverse, so we use the same function to
       // unmask as to mask.
       MaskWebSocketFramePayload(
-          masking_key_, frame_offset_, io_data, next_size);
+          masking_key_, frame_offset_, frame_chunk->data->data(), next_size);
     }
 
-    current_read_pos_ += next_size;
     frame_offset_ += next_size;
   }
+  *consumed = static_cast<size_t>(next_size);
 
   DCHECK_LE(frame_offset_, current_frame_header_->payload_length);
   if (frame_offset_ == current_frame_header_->payload_length) {
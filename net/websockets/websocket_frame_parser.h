@@ -17,6 +17,8 @@
 
 namespace net {
 
+class IOBuffer;
+
 // Parses WebSocket frames from byte stream.
 //
 // Specification of WebSocket frame format is available at
@@ -28,7 +30,8 @@ class NET_EXPORT WebSocketFrameParser {
   ~WebSocketFrameParser();
 
   // Decodes the given byte stream and stores parsed WebSocket frames in
-  // |frame_chunks|.
+  // |frame_chunks|. Payload data is copied into new buffers owned by the
+  // returned chunks.
   //
   // If the parser encounters invalid payload length format, Decode() fails
   // and returns false. Once Decode() has failed, the parser refuses to decode
@@ -40,6 +43,18 @@ class NET_EXPORT WebSocketFrameParser {
               size_t length,
               ScopedVector<WebSocketFrameChunk>* frame_chunks);
 
+  // Like Decode(), but the |data| member of each returned chunk refers
+  // directly to the payload bytes inside |buffer| and keeps |buffer| alive,
+  // so no payload data is copied. Masked payloads are unmasked in place,
+  // which means the contents of |buffer| are modified. The caller must not
+  // reuse |buffer| while any of the returned chunks are alive.
+  //
+  // Only the bytes of a frame header which is split across two calls are
+  // copied; they are carried over to the next call.
+  bool DecodeInPlace(IOBuffer* buffer,
+                     size_t length,
+                     ScopedVector<WebSocketFrameChunk>* frame_chunks);
+
   // Returns kWebSocketNormalClosure if the parser has not failed to decode
   // WebSocket frames. Otherwise returns WebSocketError which is defined in
   // websocket_errors.h. We can convert net::WebSocketError to net::Error by
@@ -47,28 +62,40 @@ class NET_EXPORT WebSocketFrameParser {
   WebSocketError websocket_error() const { return websocket_error_; }
 
  private:
-  // Tries to decode a frame header from |current_read_pos_|.
-  // If successful, this function updates |current_read_pos_|,
-  // |current_frame_header_|, and |masking_key_| (if available).
-  // This function may set |failed_| to true if it observes a corrupt frame.
-  // If there is not enough data in the remaining buffer to parse a frame
-  // header, this function returns without doing anything.
-  void DecodeFrameHeader();
-
-  // Decodes frame payload and creates a WebSocketFrameChunk object.
-  // This function updates |current_read_pos_| and |frame_offset_| after
-  // parsing. This function returns a frame object even if no payload data is
-  // available at this moment, so the receiver could make use of frame header
-  // information. If the end of frame is reached, this function clears
+  // Shared implementation of Decode() and DecodeInPlace(). If |backing| is
+  // non-NULL, |data| points into it and payload chunks are created as slices
+  // of |backing|. Otherwise payload data is copied.
+  bool DecodeInternal(const char* data,
+                      size_t length,
+                      IOBuffer* backing,
+                      ScopedVector<WebSocketFrameChunk>* frame_chunks);
+
+  // Tries to decode a frame header from the |length| bytes at |data|.
+  // If successful, this function sets |current_frame_header_| and
+  // |masking_key_| (if available), and returns the size of the header.
+  // This function may set |websocket_error_| if it observes a corrupt frame.
+  // If there is not enough data to parse a complete frame header, this
+  // function returns 0 without doing anything.
+  size_t DecodeFrameHeader(const char* data, size_t length);
+
+  // Decodes frame payload from the |length| bytes at |data| and creates a
+  // WebSocketFrameChunk object. |*consumed| is set to the number of bytes
+  // used. If |backing| is non-NULL the chunk refers to the payload inside it,
+  // otherwise the payload is copied. This function updates |frame_offset_|
+  // after parsing. This function returns a frame object even if no payload
+  // data is available at this moment, so the receiver could make use of frame
+  // header information. If the end of frame is reached, this function clears
   // |current_frame_header_|, |frame_offset_| and |masking_key_|.
-  scoped_ptr<WebSocketFrameChunk> DecodeFramePayload(bool first_chunk);
-
-  // Internal buffer to store the data to parse.
+  scoped_ptr<WebSocketFrameChunk> DecodeFramePayload(bool first_chunk,
+                                                     const char* data,
+                                                     size_t length,
+                                                     IOBuffer* backing,
+                                                     size_t* consumed);
+
+  // Bytes of an incomplete frame header carried over from the previous call
+  // to Decode() or DecodeInPlace(). Payload data is never stored here.
   std::vector<char> buffer_;
 
-  // Position in |buffer_| where the next round of parsing starts.
-  size_t current_read_pos_;
-
   // Frame header and masking key of the current frame.
   // |masking_key_| is filled with zeros if the current frame is not masked.
   scoped_ptr<WebSocketFrameHeader> current_frame_header_;
@@ -5,6 +5,7 @@
 #include "net/websockets/websocket_frame_parser.h"
 
 #include <algorithm>
+#include <string>
 #include <vector>
 
 #include "base/basictypes.h"
@@ -571,6 +572,93 @@ TEST(WebSocketFrameParserTest, FinalBitAndReservedBits) {
   }
 }
 
+TEST(WebSocketFrameParserTest, DecodeInPlaceMaskedFrame) {
+  WebSocketFrameParser parser;
+
+  scoped_refptr<IOBuffer> buffer(new IOBuffer(kMaskedHelloFrameLength));
+  memcpy(buffer->data(), kMaskedHelloFrame, kMaskedHelloFrameLength);
+  ScopedVector<WebSocketFrameChunk> frames;
+  EXPECT_TRUE(parser.DecodeInPlace(buffer.get(), kMaskedHelloFrameLength,
+                                   &frames));
+  EXPECT_EQ(kWebSocketNormalClosure, parser.websocket_error());
+  ASSERT_EQ(1u, frames.size());
+  WebSocketFrameChunk* frame = frames[0];
+  ASSERT_TRUE(frame->header.get() != NULL);
+  EXPECT_TRUE(frame->header->masked);
+  EXPECT_TRUE(frame->final_chunk);
+
+  // The payload refers to the input buffer, which has been unmasked in place.
+  ASSERT_EQ(static_cast<int>(kHelloLength), frame->data->size());
+  EXPECT_EQ(buffer->data() + kMaskedHelloFrameLength - kHelloLength,
+            frame->data->data());
+  EXPECT_TRUE(std::equal(kHello, kHello + kHelloLength, frame->data->data()));
+
+  // The chunk keeps the input buffer alive.
+  buffer = NULL;
+  EXPECT_TRUE(std::equal(kHello, kHello + kHelloLength, frame->data->data()));
+}
+
+TEST(WebSocketFrameParserTest, DecodeInPlaceMatchesDecode) {
+  // Feed the same stream of frames to both modes, split at every possible
+  // position, and check that the payloads agree.
+  static const char kFrames[] =
+      "\x81\x05" "First"
+      "\x81\x8D\xDE\xAD\xBE\xEF"
+      "\x96\xC8\xD2\x83\xB1\x81\x9E\x98\xB1\xDF\xD2\x8B\xFF"
+      "\x82\x7E\x00\x80" "0123456789abcdef0123456789abcdef"
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+      "0123456789abcdef0123456789abcdef";
+  static const size_t kFramesLength = arraysize(kFrames) - 1;
+
+  for (size_t split = 0; split <= kFramesLength; ++split) {
+    WebSocketFrameParser copying_parser;
+    WebSocketFrameParser in_place_parser;
+    std::string copied_payload;
+    std::string in_place_payload;
+    size_t copied_frames = 0;
+    size_t in_place_frames = 0;
+
+    const size_t kPieces[2][2] = { { 0, split },
+                                   { split, kFramesLength - split } };
+    for (size_t i = 0; i < 2; ++i) {
+      const char* piece = kFrames + kPieces[i][0];
+      size_t piece_length = kPieces[i][1];
+
+      ScopedVector<WebSocketFrameChunk> frames;
+      ASSERT_TRUE(copying_parser.Decode(piece, piece_length, &frames));
+      for (size_t j = 0; j < frames.size(); ++j) {
+        if (frames[j]->header.get())
+          ++copied_frames;
+        if (frames[j]->data.get()) {
+          copied_payload.append(frames[j]->data->data(),
+                                frames[j]->data->size());
+        }
+      }
+
+      scoped_refptr<IOBuffer> buffer(new IOBuffer(piece_length + 1));
+      memcpy(buffer->data(), piece, piece_length);
+      frames.clear();
+      ASSERT_TRUE(in_place_parser.DecodeInPlace(buffer.get(), piece_length,
+                                                &frames));
+      for (size_t j = 0; j < frames.size(); ++j) {
+        if (frames[j]->header.get())
+          ++in_place_frames;
+        if (frames[j]->data.get()) {
+          in_place_payload.append(frames[j]->data->data(),
+                                  frames[j]->data->size());
+        }
+      }
+    }
+
+    EXPECT_EQ(3u, copied_frames) << "split=" << split;
+    EXPECT_EQ(copied_frames, in_place_frames) << "split=" << split;
+    EXPECT_EQ(5u + kHelloLength + 128u, copied_payload.size());
+    EXPECT_EQ(copied_payload, in_place_payload) << "split=" << split;
+    EXPECT_EQ(std::string(kHello, kHelloLength),
+              copied_payload.substr(5, kHelloLength));
+  }
+}
+
 }  // Unnamed namespace
 
 }  // namespace net
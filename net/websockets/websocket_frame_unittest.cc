@@ -400,6 +400,18 @@ TEST_F(WebSocketFrameTestMaskBenchmark, BenchmarkMaskLongPayload) {
   Benchmark(payload.get(), kLongPayloadSize);
 }
 
+TEST_F(WebSocketFrameTestMaskBenchmark, BenchmarkMaskPayloadSizes) {
+  // Frame sizes from the smallest interesting payload up to 1 MB.
+  static const size_t kPayloadSizes[] = {
+    2, 16, 128, 1 << 10, 1 << 13, 1 << 16, 1 << 20
+  };
+  static const size_t kMaxPayloadSize = 1 << 20;
+  scoped_ptr<char[]> payload(new char[kMaxPayloadSize]);
+  std::fill(payload.get(), payload.get() + kMaxPayloadSize, 'a');
+  for (size_t i = 0; i < arraysize(kPayloadSizes); ++i)
+    Benchmark(payload.get(), kPayloadSizes[i]);
+}
+
 // "IsKnownDataOpCode" is currently implemented in an "obviously correct"
 // manner, but we test is anyway in case it changes to a more complex
 // implementation in future.